@@ -78,6 +78,7 @@ EXPERIMENTAL=
 OPERATIONS=
 CLEAN="false"
 MINIFIER="false"
+GRAPHBENCH="false"
 TESTS="false"
 VERBOSE="false"
 VERBOSE_ARG="VERBOSE=1"
@@ -155,6 +156,9 @@ case $key in
     -m|--minifier)
     MINIFIER="true"
     ;;
+    --graphbench)
+    GRAPHBENCH="true"
+    ;;
     -t|--tests)
     TESTS="true"
     ;;
@@ -478,6 +482,7 @@ fi
 
 EXPERIMENTAL_ARG="";
 MINIFIER_ARG="-DSD_BUILD_MINIFIER=false"
+GRAPHBENCH_ARG="-DSD_BUILD_GRAPHBENCH=OFF"
 TESTS_ARG="-DSD_BUILD_TESTS=OFF"
 NAME_ARG="-DSD_LIBRARY_NAME=$NAME"
 
@@ -489,6 +494,10 @@ if [ "$MINIFIER" == "true" ]; then
     MINIFIER_ARG="-DSD_BUILD_MINIFIER=true"
 fi
 
+if [ "$GRAPHBENCH" == "true" ]; then
+    GRAPHBENCH_ARG="-DSD_BUILD_GRAPHBENCH=ON"
+fi
+
 if [ "$TESTS" == "true" ]; then
     MINIFIER_ARG="-DSD_BUILD_MINIFIER=true"
     TESTS_ARG="-DSD_BUILD_TESTS=ON"
@@ -580,6 +589,7 @@ echo EXPERIMENTAL = ${EXPERIMENTAL}
 echo LIBRARY TYPE    = "${LIBTYPE}"
 echo OPERATIONS = "${OPERATIONS_ARG}"
 echo MINIFIER = "${MINIFIER_ARG}"
+echo GRAPHBENCH = "${GRAPHBENCH_ARG}"
 echo TESTS = "${TESTS_ARG}"
 echo NAME = "${NAME_ARG}"
 echo OPENBLAS_PATH = "$OPENBLAS_PATH"
@@ -587,7 +597,7 @@ echo CHECK_VECTORIZATION = "$CHECK_VECTORIZATION"
 echo HELPERS = "$HELPERS"
 mkbuilddir
 pwd
-eval "$CMAKE_COMMAND"  "$BLAS_ARG" "$ARCH_ARG" "$NAME_ARG" -DSD_CHECK_VECTORIZATION="${CHECK_VECTORIZATION}"  "$HELPERS" "$SHARED_LIBS_ARG" "$MINIFIER_ARG" "$OPERATIONS_ARG" "$BUILD_TYPE" "$PACKAGING_ARG" "$EXPERIMENTAL_ARG" "$TESTS_ARG" "$CUDA_COMPUTE" -DOPENBLAS_PATH="$OPENBLAS_PATH" -DDEV=FALSE -DCMAKE_NEED_RESPONSE=YES -DMKL_MULTI_THREADED=TRUE ../..
+eval "$CMAKE_COMMAND"  "$BLAS_ARG" "$ARCH_ARG" "$NAME_ARG" -DSD_CHECK_VECTORIZATION="${CHECK_VECTORIZATION}"  "$HELPERS" "$SHARED_LIBS_ARG" "$MINIFIER_ARG" "$GRAPHBENCH_ARG" "$OPERATIONS_ARG" "$BUILD_TYPE" "$PACKAGING_ARG" "$EXPERIMENTAL_ARG" "$TESTS_ARG" "$CUDA_COMPUTE" -DOPENBLAS_PATH="$OPENBLAS_PATH" -DDEV=FALSE -DCMAKE_NEED_RESPONSE=YES -DMKL_MULTI_THREADED=TRUE ../..
 
 if [ "$PARALLEL" == "true" ]; then
     MAKE_ARGUMENTS="$MAKE_ARGUMENTS -j $MAKEJ"
@@ -0,0 +1,166 @@
+/*******************************************************************************
+ * Copyright (c) 2020 Konduit K.K.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+/*
+ * Implementation for BenchOpt class.
+ *
+ */
+
+#include <cstdlib>
+#include <cstring>
+
+#include "benchopt.h"
+
+std::ostream&
+operator<< (std::ostream& out, BenchOpt const& opts) {
+    out << "==================================================" << std::endl;
+    for (auto const& file: opts._files)
+        out << "Graph: " << file << std::endl;
+
+    for (auto const& input: opts._inputs)
+        out << "Input: " << input.first << " <- " << input.second << std::endl;
+
+    out << "Warmup iterations: " << opts._warmup << std::endl;
+    out << "Timed iterations: " << opts._iterations << std::endl;
+    out << "Threads: " << (opts._threads > 0 ? std::to_string(opts._threads) : std::string("default")) << std::endl;
+    out << "Sessions: " << opts._sessions << std::endl;
+    out << "Batch size: " << opts._batchSize << std::endl;
+    out << "Mixed precision: " << (opts._amp.empty() ? std::string("off") : opts._amp) << std::endl;
+    out << "Hardware counters: " << (opts._counters ? "on" : "off") << std::endl;
+    out << "==================================================";
+    return out;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+static bool parsePositive(char const* arg, int& value) {
+    char* end = nullptr;
+    auto v = strtol(arg, &end, 10);
+    if (end == arg || *end != '\0' || v < 0)
+        return false;
+
+    value = static_cast<int>(v);
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int
+BenchOpt::optionsWithArgs(int argc, char* argv[], BenchOpt& res) {
+    int optIndex = 1;
+
+    char const* optionStr = "w:n:t:s:b:i:k:m:pc";
+
+    for (optIndex = 1; (optIndex < argc) && (argv[optIndex][0] == '-') &&
+                       (argv[optIndex][0]); optIndex++) {
+
+        int opt = argv[optIndex][1];
+
+        if (opt == '?' || opt == 'h') {
+            res.help(argv[0], std::cout);
+            res.reset();
+            return 1;
+        }
+
+        char const* p = strchr(optionStr, opt);
+
+        if (p == nullptr) {
+            std::cerr << "opt " << (char)opt << " not found with " << optionStr << std::endl;
+            res.reset();
+            return -1;
+        }
+
+        if (p[1] != ':') {
+            // flags without argument
+            if (opt == 'c')
+                res._counters = true;
+            else
+                res._profile = true;
+            continue;
+        }
+
+        optIndex++;
+        if (optIndex >= argc) {
+            std::cerr << "optIndex " << optIndex << " is out of bounds " << argc << std::endl;
+            res.reset();
+            return -2;
+        }
+
+        char const* arg = argv[optIndex];
+        bool valid = true;
+        switch (opt) {
+            case 'w': valid = parsePositive(arg, res._warmup); break;
+            case 'n': valid = parsePositive(arg, res._iterations) && res._iterations > 0; break;
+            case 't': valid = parsePositive(arg, res._threads); break;
+            case 's': valid = parsePositive(arg, res._sessions) && res._sessions > 0; break;
+            case 'b': valid = parsePositive(arg, res._batchSize) && res._batchSize > 0; break;
+            case 'k': valid = parsePositive(arg, res._hotSpots); break;
+            case 'm':
+                res._amp = arg;
+                valid = res._amp == "bf16" || res._amp == "fp16";
+                break;
+            case 'i': {
+                    // placeholder=file.npy
+                    char const* eq = strchr(arg, '=');
+                    if (eq == nullptr || eq == arg || eq[1] == '\0') {
+                        valid = false;
+                        break;
+                    }
+                    res._inputs[std::string(arg, eq - arg)] = std::string(eq + 1);
+                }
+                break;
+            default:
+                valid = false;
+        }
+
+        if (!valid) {
+            std::cerr << "Wrong argument for option -" << (char)opt << ": " << arg << std::endl;
+            res.reset();
+            return -3;
+        }
+    }
+
+    for ( ; optIndex < argc; optIndex++) {
+        res._files.push_back(std::string(argv[optIndex]));
+    }
+
+    if (res._files.size() != 1) {
+        std::cerr << "Exactly one FlatBuffers graph file should be provided" << std::endl;
+        res.reset();
+        return -4;
+    }
+
+    return 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::ostream&
+BenchOpt::help(std::string app, std::ostream& out) {
+    out << "Usage: \n" << app << " [-w N] [-n N] [-t N] [-s N] [-b N] [-k N] [-m bf16|fp16] [-p] [-c] "
+                                 "[-i placeholder=file.npy ...] graph.fb" << std::endl;
+    out << "Parameters:" << std::endl;
+    out << "\t-w <N>\t Number of warmup iterations, 10 by default" << std::endl;
+    out << "\t-n <N>\t Number of timed iterations per session, 100 by default" << std::endl;
+    out << "\t-t <N>\t Max number of threads used by ops" << std::endl;
+    out << "\t-s <N>\t Number of concurrent sessions, 1 by default" << std::endl;
+    out << "\t-b <N>\t Value used for unknown dimensions of generated placeholders, 1 by default" << std::endl;
+    out << "\t-i <placeholder=file.npy> Load placeholder (by name or id) from npy file, random values are used otherwise" << std::endl;
+    out << "\t-k <N>\t Number of per-node hot spots to report, 10 by default" << std::endl;
+    out << "\t-m <bf16|fp16> Rewrite graph to mixed precision, and report output errors against fp32 run" << std::endl;
+    out << "\t-p\t Run additional profiled pass and report per-node hot spots" << std::endl;
+    out << "\t-c\t Record hardware counters in profiled pass (Linux perf events), implies -p" << std::endl;
+    out << "\t-h\t This help" << std::endl;
+
+    return out;
+}
@@ -0,0 +1,97 @@
+/*******************************************************************************
+ * Copyright (c) 2020 Konduit K.K.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+/*
+ * BenchOpt class declarations
+ *
+ * BenchOpt class used for parsing command line arguments of graphbench
+ *
+ */
+
+#ifndef __H__BENCH_OPTIONS__
+#define __H__BENCH_OPTIONS__
+
+#include <string>
+#include <list>
+#include <map>
+#include <iostream>
+
+class BenchOpt {
+public:
+    typedef std::list<std::string> FileList;
+    typedef std::map<std::string, std::string> InputDict;
+public:
+    BenchOpt()
+    {}
+
+    static int optionsWithArgs(int argc, char* argv[], BenchOpt& options);
+
+    FileList const& files() const { return _files; }
+
+    /**
+     * Placeholder name (or id) -> path to npy file
+     */
+    InputDict const& inputs() const { return _inputs; }
+
+    int warmup() const { return _warmup; }
+    int iterations() const { return _iterations; }
+    int threads() const { return _threads; }
+    int sessions() const { return _sessions; }
+    int batchSize() const { return _batchSize; }
+    int hotSpots() const { return _hotSpots; }
+    bool profile() const { return _profile || _counters; }
+
+    /**
+     * Hardware counters are recorded in profiled pass
+     */
+    bool counters() const { return _counters; }
+
+    /**
+     * Low precision type for automatic mixed precision rewrite: "bf16" or "fp16", empty means fp32 graph as is
+     */
+    std::string const& amp() const { return _amp; }
+
+    std::ostream& help(std::string app, std::ostream& out);
+
+    friend std::ostream& operator<< (std::ostream& out, BenchOpt const& opts);
+
+    void reset() {
+        _files.clear();
+        _inputs.clear();
+    }
+
+private:
+    FileList _files;
+    InputDict _inputs;
+
+    int _warmup = 10;
+    int _iterations = 100;
+
+    // 0 means: use Environment defaults
+    int _threads = 0;
+    int _sessions = 1;
+
+    // used to resolve unknown (i.e. -1) dimensions of generated placeholders
+    int _batchSize = 1;
+
+    int _hotSpots = 10;
+    bool _profile = false;
+    bool _counters = false;
+
+    std::string _amp;
+};
+
+#endif
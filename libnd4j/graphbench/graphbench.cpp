@@ -0,0 +1,295 @@
+/*******************************************************************************
+ * Copyright (c) 2020 Konduit K.K.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+/*
+ * End-to-end benchmark runner for FlatBuffers graphs
+ *
+ * Loads graph, fills placeholders, and measures GraphExecutioner::execute latency
+ * for one or more concurrent sessions.
+ *
+ */
+
+#ifndef _WIN32
+    #include <sys/resource.h>
+#endif
+#include <cstdlib>
+#include <thread>
+#include <vector>
+#include <algorithm>
+#include <chrono>
+#include "benchopt.h"
+#include <graph/GraphExecutioner.h>
+#include <graph/AutoMixedPrecision.h>
+#include <graph/profiling/GraphProfilingHelper.h>
+#include <array/NDArrayFactory.h>
+#include <helpers/RandomLauncher.h>
+#include <helpers/ShapeUtils.h>
+#include <system/Environment.h>
+
+using namespace sd;
+using namespace sd::graph;
+
+// peak resident set size of this process, in bytes
+static Nd4jLong peakRSS() {
+#ifdef _WIN32
+    return -1;
+#else
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+        return -1;
+
+#ifdef __APPLE__
+    return (Nd4jLong) usage.ru_maxrss;
+#else
+    // linux reports kilobytes
+    return (Nd4jLong) usage.ru_maxrss * 1024L;
+#endif
+#endif
+}
+
+static Nd4jLong percentile(std::vector<Nd4jLong> const& sorted, double p) {
+    if (sorted.empty())
+        return 0L;
+
+    auto idx = static_cast<size_t>(p * (sorted.size() - 1) + 0.5);
+    return sorted[std::min(idx, sorted.size() - 1)];
+}
+
+static std::string lookupInput(BenchOpt const& opt, Variable* variable) {
+    auto name = variable->getName();
+    if (name != nullptr && opt.inputs().count(*name) > 0)
+        return opt.inputs().at(*name);
+
+    auto id = std::to_string(variable->id());
+    if (opt.inputs().count(id) > 0)
+        return opt.inputs().at(id);
+
+    return std::string();
+}
+
+// returns number of placeholders filled
+static int fillPlaceholders(Graph* graph, BenchOpt const& opt) {
+    RandomGenerator rng(119, 5);
+    int cnt = 0;
+
+    for (auto variable: graph->getVariableSpace()->getVariables()) {
+        if (variable->variableType() != VariableType::PLACEHOLDER)
+            continue;
+
+        NDArray* array = nullptr;
+        auto file = lookupInput(opt, variable);
+        if (!file.empty()) {
+            array = new NDArray(NDArrayFactory::fromNpyFile(file.c_str()));
+        } else {
+            std::vector<Nd4jLong> shape(variable->shape());
+            for (auto& v: shape)
+                if (v < 0)
+                    v = opt.batchSize();
+
+            array = new NDArray('c', shape, Environment::getInstance().defaultFloatDataType());
+            RandomLauncher::fillUniform(array->getContext(), rng, array, 0.0, 1.0);
+        }
+
+        // unnamed placeholders are shown by id, same key lookupInput() falls back to
+        auto name = variable->getName() != nullptr ? *variable->getName() : std::to_string(variable->id());
+        nd4j_printf("Placeholder <%i:%s>: %s%s\n", variable->id(), name.c_str(), ShapeUtils::shapeAsString(array).c_str(), file.empty() ? " (random)" : "");
+        variable->setNDArray(array);
+        cnt++;
+    }
+
+    return cnt;
+}
+
+static void runSession(Graph* graph, int warmup, int iterations, std::vector<Nd4jLong>& latencies, Nd4jStatus& status) {
+    for (int e = 0; e < warmup + iterations; e++) {
+        FlowPath fp;
+
+        // every iteration starts from "fresh" varspace, just like GraphProfilingHelper does
+        auto vs = graph->getVariableSpace()->clone();
+        vs->setFlowPath(&fp);
+
+        auto timeStart = std::chrono::system_clock::now();
+        status = GraphExecutioner::execute(graph, vs);
+        auto timeEnd = std::chrono::system_clock::now();
+
+        delete vs;
+
+        if (status != Status::OK())
+            return;
+
+        if (e >= warmup)
+            latencies.emplace_back(std::chrono::duration_cast<std::chrono::nanoseconds>(timeEnd - timeStart).count());
+    }
+}
+
+int
+main(int argc, char *argv[]) {
+    BenchOpt opt;
+    int err = BenchOpt::optionsWithArgs(argc, argv, opt);
+
+    if (err > 0) {
+        // only help message
+        return 0;
+    }
+
+    if (err < 0) {
+        std::cerr << "Wrong parameter list" << std::endl;
+        opt.help(argv[0], std::cerr);
+        return err;
+    }
+
+    if (opt.threads() > 0) {
+        Environment::getInstance().setMaxThreads(opt.threads());
+        Environment::getInstance().setMaxMasterThreads(opt.threads());
+    }
+
+    std::cout << opt << std::endl;
+
+    auto file = opt.files().front();
+    if (getFileSize(file.c_str()) <= 0) {
+        std::cerr << "File " << file << " does not exist or has zero size" << std::endl;
+        return 10;
+    }
+
+    auto tb0 = GraphProfile::currentTime();
+    auto graph = GraphExecutioner::importFromFlatBuffers(file.c_str());
+    auto buildTime = GraphProfile::relativeTime(tb0);
+
+    // rewrite has to happen before placeholders are filled, otherwise they'd be treated as constants
+    Graph* reference = nullptr;
+    if (!opt.amp().empty()) {
+        reference = graph->clone();
+
+        AutoMixedPrecision amp(opt.amp() == "fp16" ? DataType::HALF : DataType::BFLOAT16);
+        amp.apply(graph);
+        nd4j_printf("Mixed precision: %i nodes lowered to %s; %i casts inserted; %i constants converted;\n", amp.loweredNodes(), opt.amp().c_str(), amp.insertedCasts(), amp.convertedConstants());
+
+        fillPlaceholders(reference, opt);
+    }
+
+    fillPlaceholders(graph, opt);
+    graph->buildGraph();
+
+    nd4j_printf("Graph: %i nodes; import time: %lld us;\n", graph->totalNodes(), buildTime / 1000);
+
+    if (reference != nullptr) {
+        // both graphs got the same placeholder values, since generator is seeded the same way
+        auto mixed = graph->clone();
+        auto errors = AutoMixedPrecision::compare(reference, mixed);
+
+        nd4j_printf("\nOutput errors against fp32:\n", "");
+        for (auto const& e: errors)
+            nd4j_printf("<%i:%i>: length: %lld; max abs: %.6g; mean abs: %.6g; max rel: %.6g;\n", e.id, e.index, e.length, e.maxAbsError, e.meanAbsError, e.maxRelError);
+
+        delete mixed;
+        delete reference;
+    }
+
+    // every session gets own copy of the Graph, so there's no shared state between sessions
+    std::vector<Graph*> graphs(opt.sessions());
+    std::vector<std::vector<Nd4jLong>> latencies(opt.sessions());
+    std::vector<Nd4jStatus> statuses(opt.sessions(), Status::OK());
+    for (int s = 0; s < opt.sessions(); s++) {
+        graphs[s] = graph->clone();
+        latencies[s].reserve(opt.iterations());
+    }
+
+    auto timeStart = std::chrono::system_clock::now();
+    if (opt.sessions() == 1) {
+        runSession(graphs[0], opt.warmup(), opt.iterations(), latencies[0], statuses[0]);
+    } else {
+        std::vector<std::thread> threads;
+        for (int s = 0; s < opt.sessions(); s++)
+            threads.emplace_back(runSession, graphs[s], opt.warmup(), opt.iterations(), std::ref(latencies[s]), std::ref(statuses[s]));
+
+        for (auto &t: threads)
+            t.join();
+    }
+    auto timeEnd = std::chrono::system_clock::now();
+
+    for (int s = 0; s < opt.sessions(); s++) {
+        if (statuses[s] != Status::OK()) {
+            nd4j_printf("Session %i failed with status %i\n", s, statuses[s]);
+            return statuses[s];
+        }
+    }
+
+    std::vector<Nd4jLong> all;
+    for (auto const& v: latencies)
+        all.insert(all.end(), v.begin(), v.end());
+
+    std::sort(all.begin(), all.end());
+
+    // wall time includes warmup, so throughput is estimated from per-iteration latencies of each session
+    auto wallTime = std::chrono::duration_cast<std::chrono::nanoseconds>(timeEnd - timeStart).count();
+    double sessionTime = 0.0;
+    for (auto const& v: latencies) {
+        Nd4jLong sum = 0L;
+        for (auto l: v)
+            sum += l;
+
+        sessionTime = sd::math::nd4j_max<double>(sessionTime, (double) sum);
+    }
+
+    double mean = 0.0;
+    for (auto v: all)
+        mean += (double) v / all.size();
+
+    nd4j_printf("\nLatency over %i iterations x %i sessions:\n", opt.iterations(), opt.sessions());
+    nd4j_printf("MIN: %lld us; MEAN: %lld us; MAX: %lld us;\n", all.front() / 1000, (Nd4jLong) mean / 1000, all.back() / 1000);
+    nd4j_printf("P50: %lld us; P90: %lld us; P99: %lld us;\n", percentile(all, 0.5) / 1000, percentile(all, 0.9) / 1000, percentile(all, 0.99) / 1000);
+    nd4j_printf("Throughput: %.2f inferences/s; Wall time: %lld ms;\n", (double) all.size() / (sessionTime / 1e9), wallTime / 1000000);
+
+    auto rss = peakRSS();
+    if (rss >= 0)
+        nd4j_printf("Peak RSS: %lld MB;\n", rss / (1024L * 1024L));
+
+    if (opt.profile()) {
+        if (opt.counters()) {
+            Environment::getInstance().setHardwareCounters(true);
+            if (!Environment::getInstance().isHardwareCounters())
+                nd4j_printf("\nHardware counters are not available on this system\n", "");
+        }
+
+        Environment::getInstance().setProfiling(true);
+        auto profile = GraphProfilingHelper::profile(graphs[0], sd::math::nd4j_max<int>(1, opt.iterations() / 10));
+        Environment::getInstance().setProfiling(false);
+        Environment::getInstance().setHardwareCounters(false);
+
+        nd4j_printf("\nTop %i nodes by EXEC:\n", opt.hotSpots());
+        Nd4jLong total = 0L;
+        for (auto v: profile->hotSpots(-1))
+            total += v->getAverageExecutionTime();
+
+        for (auto v: profile->hotSpots(opt.hotSpots())) {
+            auto time = v->getAverageExecutionTime();
+            nd4j_printf("<%i:%s>: %lld us; %.2f%%;\n", v->id(), v->name().c_str(), time / 1000, total > 0 ? 100.0 * time / total : 0.0);
+
+            auto c = v->getAverageCounters();
+            if (c.hasValues())
+                nd4j_printf("    CYCLES: %lld; INSTR: %lld; CACHE REFS: %lld; CACHE MISSES: %lld;\n", c.cycles, c.instructions, c.cacheReferences, c.cacheMisses);
+        }
+
+        delete profile;
+    }
+
+    for (auto g: graphs)
+        delete g;
+
+    delete graph;
+
+    return EXIT_SUCCESS;
+}
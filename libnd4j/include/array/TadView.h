@@ -0,0 +1,108 @@
+/*******************************************************************************
+ * Copyright (c) 2020 Konduit K.K.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+#ifndef SD_TADVIEW_H
+#define SD_TADVIEW_H
+
+#include <array/NDArray.h>
+#include <array/TadPack.h>
+#include <helpers/ConstantTadHelper.h>
+#include <helpers/shape.h>
+
+namespace sd {
+    /**
+     * Non-owning view over all TADs of an array: host base pointer, plus TAD shapeInfo and offsets shared via TadPack.
+     *
+     * Unlike NDArray::allTensorsAlongDimension() nothing is allocated per TAD, so view is cheap to create
+     * and can be captured by reference in PRAGMA_THREADS_FOR lambdas. Use TadView<const T> for read-only inputs.
+     * Array must outlive the view, and its host buffer must be actual.
+     */
+    template <typename T>
+    class TadView {
+    private:
+        const NDArray *_array = nullptr;
+        TadPack _pack;
+        T *_buffer = nullptr;
+        const Nd4jLong *_shapeInfo = nullptr;
+        const Nd4jLong *_offsets = nullptr;
+        const Nd4jLong *_strides = nullptr;
+        Nd4jLong _numTads = 0;
+        Nd4jLong _tadLength = 0;
+        Nd4jLong _ews = 0;
+
+    public:
+        /**
+         * @param dimensions - dimensions spanned by every TAD, same as for allTensorsAlongDimension()
+         */
+        TadView(const NDArray &array, const std::vector<int> &dimensions) {
+            if (dimensions.empty())
+                return;
+
+            if (dimensions.back() >= array.rankOf())
+                throw std::runtime_error("TadView: all dimensions must be smaller than rank of input array !");
+
+            _array = &array;
+            _pack = ConstantTadHelper::getInstance().tadForDimensions(array.shapeInfo(), const_cast<int*>(dimensions.data()), dimensions.size());
+            _buffer = reinterpret_cast<T*>(const_cast<void*>(array.buffer()));
+            _shapeInfo = _pack.primaryShapeInfo();
+            _offsets = _pack.primaryOffsets();
+            _strides = shape::stride(_shapeInfo);
+            _numTads = _pack.numberOfTads();
+            _tadLength = shape::length(_shapeInfo);
+            _ews = shape::elementWiseStride(_shapeInfo) > 0 && (shape::order(_shapeInfo) == 'c' || shape::rank(_shapeInfo) == 1) ? shape::elementWiseStride(_shapeInfo) : 0;
+        }
+
+        ~TadView() = default;
+
+        FORCEINLINE Nd4jLong size() const { return _numTads; }
+        FORCEINLINE Nd4jLong tadLength() const { return _tadLength; }
+        FORCEINLINE const Nd4jLong* shapeInfo() const { return _shapeInfo; }
+        FORCEINLINE const Nd4jLong* offsets() const { return _offsets; }
+
+        /**
+         * Returns pointer to the first element of given TAD
+         */
+        FORCEINLINE T* at(Nd4jLong tad) const { return _buffer + _offsets[tad]; }
+
+        /**
+         * Returns element of given TAD by its linear index, in c order
+         */
+        FORCEINLINE T& operator()(Nd4jLong tad, Nd4jLong index) const {
+            return at(tad)[_ews > 0 ? index * _ews : shape::getIndexOffset(index, _shapeInfo)];
+        }
+
+        /**
+         * Returns element of given TAD by its coordinates, TAD rank must match number of coordinates
+         */
+        FORCEINLINE T& operator()(Nd4jLong tad, Nd4jLong i, Nd4jLong j) const {
+            return at(tad)[i * _strides[0] + j * _strides[1]];
+        }
+
+        FORCEINLINE T& operator()(Nd4jLong tad, Nd4jLong i, Nd4jLong j, Nd4jLong k) const {
+            return at(tad)[i * _strides[0] + j * _strides[1] + k * _strides[2]];
+        }
+
+        /**
+         * Materializes given TAD as NDArray view, for helpers which need NDArray-level ops on it
+         */
+        NDArray array(Nd4jLong tad) const {
+            return NDArray(_array->getDataBuffer(), ShapeDescriptor(_shapeInfo), _array->getContext(), _offsets[tad] + _array->bufferOffset());
+        }
+    };
+}
+
+#endif //SD_TADVIEW_H
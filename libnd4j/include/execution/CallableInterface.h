@@ -28,6 +28,11 @@
 #include <array>
 #include <mutex>
 #include <condition_variable>
+#include <helpers/HardwareCounters.h>
+
+namespace sd {
+    struct OpMarker;
+}
 
 namespace samediff {
     /**
@@ -63,6 +68,12 @@ namespace samediff {
         int64_t* _lptr = nullptr;
         double* _dptr = nullptr;
 
+        // marker of the op which dispatched this task, borrowed for the duration of the task
+        const sd::OpMarker* _marker = nullptr;
+
+        // hardware counters of the thread which dispatched this task, nullptr if counters are disabled
+        sd::HardwareCounters::ThreadCounters* _counters = nullptr;
+
         std::mutex _ms;
         std::mutex _mf;
     public:
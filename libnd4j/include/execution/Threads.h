@@ -21,6 +21,7 @@
 #define SAMEDIFF_THREADS_H
 
 #include <functional>
+#include <vector>
 #include <system/openmp_pragmas.h>
 #include <system/op_boilerplate.h>
 #include <system/Environment.h>
@@ -162,6 +163,15 @@ namespace samediff {
          */
         static int parallel_do(FUNC_DO function, uint64_t numThreads = sd::Environment::getInstance().maxMasterThreads());
 
+        /**
+         * This method runs independent tasks concurrently, and splits master threads between them:
+         * parallel loops launched from within a task use only its share. Exception thrown by a task is rethrown here.
+         * On CUDA tasks run one by one, since they share device stream and handles
+         *
+         * @param tasks
+         */
+        static void parallel_tasks(const std::vector<std::function<void()>> &tasks);
+
         static int64_t parallel_long(FUNC_RL function, FUNC_AL aggregator, int64_t start, int64_t stop, int64_t increment = 1, uint64_t numThreads = sd::Environment::getInstance().maxMasterThreads());
 
         static double parallel_double(FUNC_RD function, FUNC_AD aggregator, int64_t start, int64_t stop, int64_t increment = 1, uint64_t numThreads = sd::Environment::getInstance().maxMasterThreads());
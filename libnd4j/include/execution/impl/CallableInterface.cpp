@@ -20,6 +20,8 @@
 
 #include <execution/CallableInterface.h>
 #include <helpers/logger.h>
+#include <helpers/HardwareCounters.h>
+#include <helpers/SamplingProfiler.h>
 
 namespace samediff {
     CallableInterface::CallableInterface() {
@@ -48,6 +50,8 @@ namespace samediff {
         _num_threads = numThreads;
         _thread_id = threadID;
         _finished = false;
+        _marker = sd::SamplingProfiler::currentMarker();
+        _counters = sd::HardwareCounters::getInstance().currentThread();
         {
             std::unique_lock<std::mutex> l(_ms);
             _filled = true;
@@ -65,6 +69,8 @@ namespace samediff {
         _num_threads = numThreads;
         _thread_id = threadID;
         _finished = false;
+        _marker = sd::SamplingProfiler::currentMarker();
+        _counters = sd::HardwareCounters::getInstance().currentThread();
 
         {
             std::unique_lock<std::mutex> l(_ms);
@@ -86,6 +92,8 @@ namespace samediff {
         _num_threads = numThreads;
         _thread_id = threadID;
         _finished = false;
+        _marker = sd::SamplingProfiler::currentMarker();
+        _counters = sd::HardwareCounters::getInstance().currentThread();
 
         {
             std::unique_lock<std::mutex> l(_ms);
@@ -110,6 +118,8 @@ namespace samediff {
         _num_threads = numThreads;
         _thread_id = threadID;
         _finished = false;
+        _marker = sd::SamplingProfiler::currentMarker();
+        _counters = sd::HardwareCounters::getInstance().currentThread();
 
         {
             std::unique_lock<std::mutex> l(_ms);
@@ -130,6 +140,8 @@ namespace samediff {
         _num_threads = numThreads;
         _thread_id = threadID;
         _finished = false;
+        _marker = sd::SamplingProfiler::currentMarker();
+        _counters = sd::HardwareCounters::getInstance().currentThread();
 
         {
             std::unique_lock<std::mutex> l(_ms);
@@ -150,6 +162,8 @@ namespace samediff {
         _num_threads = numThreads;
         _thread_id = threadID;
         _finished = false;
+        _marker = sd::SamplingProfiler::currentMarker();
+        _counters = sd::HardwareCounters::getInstance().currentThread();
 
         {
             std::unique_lock<std::mutex> l(_ms);
@@ -185,6 +199,15 @@ namespace samediff {
         // mark it as consumed
         _filled = false;
 
+        // hardware counters spent on this task are added to the thread which dispatched it
+        auto &counters = sd::HardwareCounters::getInstance();
+        sd::CounterValues countersBefore;
+        if (_counters != nullptr)
+            countersBefore = counters.threadValues();
+
+        // samples taken on this worker belong to the op which dispatched the task
+        auto previousMarker = sd::SamplingProfiler::swapMarker(_marker);
+
         // actually executing op
         switch (_branch) {
             case 0:
@@ -207,6 +230,11 @@ namespace samediff {
                 break;
         }
 
+        sd::SamplingProfiler::swapMarker(previousMarker);
+
+        if (_counters != nullptr)
+            counters.attribute(_counters, counters.threadValues() - countersBefore);
+
         // notify that thread finished the job
         this->finish();
     }
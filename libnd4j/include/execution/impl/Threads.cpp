@@ -21,9 +21,12 @@
 #include <execution/ThreadPool.h>
 #include <vector>
 #include <thread>
+#include <exception>
 #include <helpers/logger.h>
 #include <math/templatemath.h>
 #include <helpers/shape.h>
+#include <helpers/MixedPrecision.h>
+#include <helpers/SamplingProfiler.h>
 
 
 namespace samediff {
@@ -550,6 +553,54 @@ namespace samediff {
         return numThreads;
     }
 
+    void Threads::parallel_tasks(const std::vector<std::function<void()>> &tasks) {
+        const int numTasks = tasks.size();
+        const int totalThreads = sd::Environment::getInstance().maxMasterThreads();
+
+        if (numTasks < 2 || totalThreads < 2 || !sd::Environment::getInstance().isCPU()) {
+            for (const auto &task : tasks)
+                task();
+
+            return;
+        }
+
+        std::vector<std::exception_ptr> errors(numTasks);
+
+        // workers don't inherit thread-local state of the caller, so op marker and precision mode are passed explicitly
+        auto marker = sd::SamplingProfiler::currentMarker();
+        auto mode = sd::MixedPrecision::swapMode(-1);
+        sd::MixedPrecision::swapMode(mode);
+
+        auto func = PRAGMA_THREADS_DO {
+            for (auto e = thread_id; e < numTasks; e += numThreads) {
+                // first tasks get the remainder
+                const int share = sd::math::nd4j_max<int>(1, totalThreads / numTasks + (e < totalThreads % numTasks ? 1 : 0));
+
+                // pool threads are reused, so previous cap is restored afterwards
+                auto previous = sd::Environment::getInstance().localMaxMasterThreads();
+                auto previousMarker = sd::SamplingProfiler::swapMarker(marker);
+                auto previousMode = sd::MixedPrecision::swapMode(mode);
+                sd::Environment::getInstance().setLocalMaxMasterThreads(share);
+
+                try {
+                    tasks[e]();
+                } catch (...) {
+                    errors[e] = std::current_exception();
+                }
+
+                sd::Environment::getInstance().setLocalMaxMasterThreads(previous);
+                sd::MixedPrecision::swapMode(previousMode);
+                sd::SamplingProfiler::swapMarker(previousMarker);
+            }
+        };
+
+        parallel_do(func, sd::math::nd4j_min<int>(numTasks, totalThreads));
+
+        for (const auto &error : errors)
+            if (error)
+                std::rethrow_exception(error);
+    }
+
     int64_t Threads::parallel_long(FUNC_RL function, FUNC_AL aggregator, int64_t start, int64_t stop, int64_t increment, uint64_t numThreads) {
         if (start > stop)
             throw std::runtime_error("Threads::parallel_long got start > stop");
@@ -0,0 +1,105 @@
+/*******************************************************************************
+ * Copyright (c) 2020 Konduit K.K.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+#ifndef SD_ACTIVATION_COMPRESSION_H
+#define SD_ACTIVATION_COMPRESSION_H
+
+#include <graph/Graph.h>
+#include <graph/profiling/GraphProfile.h>
+#include <graph/ActivationCompressionMode.h>
+#include <map>
+#include <set>
+#include <vector>
+
+namespace sd {
+    namespace graph {
+        /**
+         * This class keeps activations of forward nodes compressed while they wait for backward nodes.
+         *
+         * Backward part of the Graph starts at the first node executing *_bp op. Output of forward node used by backward nodes
+         * is compressed after its last use in forward part, decompressed right before first backward node that needs it,
+         * and released after its last use. Compression is chosen per array:
+         * - 1-bit mask, if array is used only as input 0 of relu_bp (sign x > 0 is kept) or lrelu_bp (x < 0 is kept).
+         *   Such backward ops give exactly the same results
+         * - otherwise, depending on given mode: BFLOAT16 or HALF casts (2x for FLOAT32), or INT8 symmetric quantization
+         *   with one scale per 256 elements (~4x for FLOAT32). ACTIVATION_COMPRESSION_MASKS leaves such arrays as is, so only lossless masks are used
+         *
+         * Outputs of the Graph, arrays shared by in-place nodes, views, non-contiguous arrays and persistent variables are never compressed.
+         *
+         * GraphExecutioner uses this class if ExecutorConfiguration::_activationCompression is set, and rematerialization is off.
+         * Graphs with logic ops (loops, conditions, scopes) or without backward part are executed as is.
+         * Saved bytes and time spent on compression are reported via GraphProfile.
+         */
+        class ND4J_EXPORT ActivationCompression {
+        private:
+            struct Compressed {
+                NDArray* packed = nullptr;
+                NDArray* scales = nullptr;
+                std::vector<Nd4jLong> shape;
+                sd::DataType dataType = sd::DataType::INHERIT;
+                int mask = 0;
+            };
+
+            Graph* _graph;
+            VariableSpace* _variableSpace;
+            GraphProfile* _profile;
+            ActivationCompressionMode _mode;
+
+            std::map<int, int> _positions;
+
+            // position of first backward node, -1 if there's nothing to do
+            int _backward = -1;
+
+            // arrays compressed after forward node at given position: last use within forward part, or production if there's none
+            std::map<int, std::vector<std::pair<int, int>>> _compressions;
+
+            // arrays needed as signs only: 1 for x > 0, -1 for x < 0
+            std::map<std::pair<int, int>, int> _masks;
+
+            // last use of every compressed array
+            std::map<std::pair<int, int>, int> _lastUse;
+
+            std::map<std::pair<int, int>, Compressed> _compressed;
+            std::set<std::pair<int, int>> _restored;
+
+            void compress(const std::pair<int, int> &pair);
+            void decompress(const std::pair<int, int> &pair);
+        public:
+            static const int BLOCK_SIZE = 256;
+
+            ActivationCompression(Graph* graph, VariableSpace* variableSpace, GraphProfile* profile, ActivationCompressionMode mode);
+            ~ActivationCompression();
+
+            /**
+             * This method returns true if Graph has backward part, and some forward arrays are used there
+             */
+            bool isActive() const;
+
+            /**
+             * This method must be called right before node execution: it decompresses inputs of backward nodes
+             */
+            Nd4jStatus prepare(Node* node);
+
+            /**
+             * This method must be called right after node execution: it compresses or releases arrays
+             */
+            void release(Node* node);
+        };
+    }
+}
+
+#endif //SD_ACTIVATION_COMPRESSION_H
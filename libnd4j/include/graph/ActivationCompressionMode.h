@@ -0,0 +1,39 @@
+/*******************************************************************************
+ * Copyright (c) 2020 Konduit K.K.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+#ifndef SD_ACTIVATION_COMPRESSION_MODE_H
+#define SD_ACTIVATION_COMPRESSION_MODE_H
+
+namespace sd {
+    namespace graph {
+        /**
+         * Storage of activations waiting for backward nodes, see ActivationCompression.
+         * Every mode except NONE keeps 1-bit masks for arrays which are used as sign only, and differs for all other arrays
+         */
+        enum ActivationCompressionMode {
+            ACTIVATION_COMPRESSION_NONE = 0,
+            // lossless: only arrays used as sign are compressed, everything else is kept as is
+            ACTIVATION_COMPRESSION_MASKS = 1,
+            ACTIVATION_COMPRESSION_HALF = 2,
+            ACTIVATION_COMPRESSION_BFLOAT16 = 3,
+            // symmetric quantization with one FLOAT32 scale per ActivationCompression::BLOCK_SIZE elements
+            ACTIVATION_COMPRESSION_INT8 = 4,
+        };
+    }
+}
+
+#endif //SD_ACTIVATION_COMPRESSION_MODE_H
@@ -0,0 +1,116 @@
+/*******************************************************************************
+ * Copyright (c) 2020 Konduit K.K.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#ifndef SD_AUTO_MIXED_PRECISION_H
+#define SD_AUTO_MIXED_PRECISION_H
+
+#include <graph/Graph.h>
+#include <array/DataType.h>
+#include <set>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace sd {
+    namespace graph {
+        /**
+         * Difference between outputs of reference (fp32) and mixed-precision runs of the same graph
+         */
+        struct ND4J_EXPORT AmpOutputError {
+            int id = 0;
+            int index = 0;
+            Nd4jLong length = 0L;
+            double maxAbsError = 0.0;
+            double meanAbsError = 0.0;
+
+            // relative to max(|reference|, 1e-6)
+            double maxRelError = 0.0;
+        };
+
+        /**
+         * This class rewrites fp32 inference Graph into mixed-precision one:
+         * - ops from allow list (matmul, conv etc) are executed in low precision whenever their inputs are floats
+         * - ops from infer list (elementwise, reshapes etc) are executed in low precision if any of their inputs is already there
+         * - ops from deny list (softmax, reductions, exp/log, losses), and any unknown op, stay in fp32
+         *
+         * Graph outputs are never lowered, so output data types stay the same.
+         * Casts are inserted only at precision boundaries: each tensor is cast at most once per direction,
+         * and cast of an inserted cast is resolved to the original fp32 tensor.
+         * Constants are converted once, right in the VariableSpace.
+         *
+         * PLEASE NOTE: data types are derived from variables, so apply() should be called before placeholders are filled:
+         * arrays of variables are treated as constants. Empty placeholders are assumed to be of placeholderType(),
+         * and this assumption is trusted by allow list ops only.
+         */
+        class ND4J_EXPORT AutoMixedPrecision {
+        private:
+            sd::DataType _lowType;
+            sd::DataType _placeholderType = sd::DataType::FLOAT32;
+
+            std::set<std::string> _allow;
+            std::set<std::string> _infer;
+            std::set<std::string> _deny;
+
+            // stats of the last apply() call
+            int _lowered = 0;
+            int _casts = 0;
+            int _constants = 0;
+
+            int _nextNodeId = 0;
+            int _nextVariableId = 0;
+
+            int classify(Node* node);
+            Node* insertCast(Graph* graph, const std::pair<int, int>& source, sd::DataType dataType, Node* before);
+        public:
+            explicit AutoMixedPrecision(sd::DataType lowType = sd::DataType::BFLOAT16);
+            ~AutoMixedPrecision() = default;
+
+            /**
+             * Op names, can be modified before apply(). Names from deny list win over other lists.
+             * Besides deny list, custom ops with names starting with "reduce_" or ending with "_loss" are always kept in fp32
+             */
+            std::set<std::string>& allowList();
+            std::set<std::string>& inferList();
+            std::set<std::string>& denyList();
+
+            sd::DataType lowType();
+
+            /**
+             * Data type assumed for placeholders without arrays, INHERIT disables lowering of their consumers
+             */
+            sd::DataType placeholderType();
+            void setPlaceholderType(sd::DataType dataType);
+
+            /**
+             * This method applies rewrite to the given graph, and returns number of nodes switched to low precision.
+             * Graphs with logic ops (loops, conditions, scopes) are left as is.
+             */
+            int apply(Graph* graph);
+
+            int loweredNodes();
+            int insertedCasts();
+            int convertedConstants();
+
+            /**
+             * This method executes both graphs and compares their outputs, matched by id.
+             * Meant to be used with reference graph and mixed-precision rewrite of its clone.
+             */
+            static std::vector<AmpOutputError> compare(Graph* reference, Graph* mixed);
+        };
+    }
+}
+
+#endif //SD_AUTO_MIXED_PRECISION_H
@@ -63,6 +63,15 @@ namespace sd {
             sd::ops::OpDescriptor* _opDescriptor;
             bool _useMKLDNN = sd::Environment::getInstance().isUseMKLDNN();
 
+            // accumulate HALF/BFLOAT16 in FLOAT32
+            bool _fp32Accumulation = false;
+
+            // op is allowed to return views of its inputs, set by graph use analysis
+            bool _outputViews = false;
+
+            // in-place execution was set by InplacePlanner, so it's verified at runtime
+            bool _inplacePlanned = false;
+
             // target engine for execution
             samediff::Engine _engine = DEFAULT_ENGINE;
 
@@ -114,6 +123,15 @@ namespace sd {
             bool isUseMKLDNN() { return _useMKLDNN; }
             void setUseMKLDNN(bool useMKLDNN) { _useMKLDNN = useMKLDNN; }
 
+            bool isFp32Accumulation() { return _fp32Accumulation; }
+            void setFp32Accumulation(bool fp32Accumulation) { _fp32Accumulation = fp32Accumulation; }
+
+            bool isOutputViews() { return _outputViews; }
+            void setOutputViews(bool outputViews) { _outputViews = outputViews; }
+
+            bool isInplacePlanned() { return _inplacePlanned; }
+            void setInplacePlanned(bool inplacePlanned) { _inplacePlanned = inplacePlanned; }
+
             /**
              * This method returns number of inputs available in this block
              * @return
@@ -0,0 +1,71 @@
+/*******************************************************************************
+ * Copyright (c) 2020 Konduit K.K.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#ifndef SD_CONV_FUSION_H
+#define SD_CONV_FUSION_H
+
+#include <graph/Graph.h>
+
+namespace sd {
+    namespace graph {
+        /**
+         * This class rewrites convolution chains of inference Graph into single convolution node:
+         *
+         *      conv2d | depthwise_conv2d | deconv2d [-> batchnorm] [-> relu | tanh | sigmoid]
+         *
+         * batchnorm with constant statistics is folded into convolution weights and bias once, at rewrite time:
+         *      W' = W * gamma / sqrt(var + eps),  b' = (b - mean) * gamma / sqrt(var + eps) + beta
+         * activation is passed to convolution as fused activation argument, and applied by its output stage.
+         *
+         * Chain is fused only if:
+         * - convolution weights and bias, batchnorm mean, variance, gamma and beta are constants
+         * - batchnorm normalizes over channels axis of convolution output only
+         * - intermediate results are consumed by the chain only, and aren't graph outputs
+         *
+         * Fused node takes id and name of the last node of the chain, so its consumers and graph outputs stay intact.
+         * Folded weights replace original constants if convolution was their only consumer.
+         * PLEASE NOTE: backprop ops don't support fused activation, so rewritten graphs are meant for inference only.
+         */
+        class ND4J_EXPORT ConvFusion {
+        private:
+            int _fused = 0;
+            int _folded = 0;
+            int _activations = 0;
+
+            int _nextVariableId = 0;
+
+        public:
+            ConvFusion() = default;
+            ~ConvFusion() = default;
+
+            /**
+             * This method applies rewrite to the given graph, and returns number of fused chains.
+             * Graphs with logic ops (loops, conditions, scopes) are left as is.
+             */
+            int apply(Graph* graph);
+
+            int fusedChains();
+
+            // number of batchnorm nodes folded into convolutions
+            int foldedBatchNorms();
+
+            // number of fused chains with activation
+            int fusedActivations();
+        };
+    }
+}
+
+#endif //SD_CONV_FUSION_H
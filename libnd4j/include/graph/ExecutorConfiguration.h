@@ -24,6 +24,8 @@
 #include <graph/generated/config_generated.h>
 #include <system/pointercast.h>
 #include <system/dll.h>
+#include <array/DataType.h>
+#include <graph/ActivationCompressionMode.h>
 
 namespace sd {
     namespace graph {
@@ -37,6 +39,24 @@ namespace sd {
             Nd4jLong _footprintBackward = 0L;
             Direction _direction = Direction_FORWARD_ONLY;
 
+            // not a part of FlatConfiguration yet, so it can be enabled only from native side
+            bool _fp32Accumulation = false;
+
+            // allows ops like split or strided_slice to return views of their inputs, see OutputAliasing
+            bool _outputViews = false;
+
+            // allows outputs to reuse buffers of inputs with no other uses, see InplacePlanner
+            bool _inplacePlanning = false;
+
+            // releases forward activations between checkpoints and recomputes them for backward nodes, see Rematerialization
+            bool _rematerialization = false;
+
+            // max bytes of activations recomputed at once, sqrt(N) checkpoints are used if not positive
+            Nd4jLong _rematerializationBudget = 0L;
+
+            // storage of activations waiting for backward nodes, see ActivationCompression
+            ActivationCompressionMode _activationCompression = ACTIVATION_COMPRESSION_NONE;
+
             explicit ExecutorConfiguration(const sd::graph::FlatConfiguration *conf = nullptr);
             ~ExecutorConfiguration() = default;
             
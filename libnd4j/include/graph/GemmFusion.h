@@ -0,0 +1,63 @@
+/*******************************************************************************
+ * Copyright (c) 2020 Konduit K.K.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#ifndef SD_GEMM_FUSION_H
+#define SD_GEMM_FUSION_H
+
+#include <graph/Graph.h>
+
+namespace sd {
+    namespace graph {
+        /**
+         * This class rewrites GEMM chains of inference Graph into single xw_plus_b node with fused post-ops:
+         *
+         *      matmul -> biasadd [-> relu | tanh | sigmoid]
+         *
+         * xw_plus_b applies bias and activation in one pass over gemm output (see MmulHelper::mmulFused),
+         * instead of separate passes per post-op.
+         *
+         * Chain is fused only if:
+         * - matmul has no transposed x / z, and default alpha/beta
+         * - both matmul operands are known to be matrices: variables with rank 2 arrays or shapes, or results of already fused nodes
+         * - intermediate results are consumed by the chain only, and aren't graph outputs
+         *
+         * Fused node takes id and name of the last node of the chain, so its consumers and graph outputs stay intact.
+         * PLEASE NOTE: xw_plus_b_bp doesn't support fused activation, so rewritten graphs are meant for inference only.
+         */
+        class ND4J_EXPORT GemmFusion {
+        private:
+            int _fused = 0;
+            int _activations = 0;
+
+        public:
+            GemmFusion() = default;
+            ~GemmFusion() = default;
+
+            /**
+             * This method applies rewrite to the given graph, and returns number of fused chains.
+             * Graphs with logic ops (loops, conditions, scopes) are left as is.
+             */
+            int apply(Graph* graph);
+
+            int fusedChains();
+
+            // number of fused chains with activation
+            int fusedActivations();
+        };
+    }
+}
+
+#endif //SD_GEMM_FUSION_H
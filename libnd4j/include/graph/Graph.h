@@ -74,6 +74,8 @@ namespace sd {
 
             void injectNode(sd::graph::Node *node);
 
+            void attachContext(sd::graph::Node *node);
+
             void pushToOutputOnce(int id);
 
             void printOutNode(Node* node);
@@ -120,6 +122,33 @@ namespace sd {
              */
             void addNode(sd::graph::Node *node);
 
+            /**
+             * This method inserts given node into already built graph, right before specified node and within its layer.
+             * Meant for graph rewrite passes: all inputs of the node must be available at that point of execution
+             *
+             * @param node
+             * @param before
+             */
+            void insertNode(sd::graph::Node *node, sd::graph::Node *before);
+
+            /**
+             * This method puts given node in place of existing one, within the same layer. Replacement must have the same id,
+             * so consumers and outputs keep pointing to it. Replaced node is deleted.
+             * Meant for graph rewrite passes
+             *
+             * @param node
+             * @param replacement
+             */
+            void replaceNode(sd::graph::Node *node, sd::graph::Node *replacement);
+
+            /**
+             * This method removes given node from already built graph, and deletes it.
+             * Meant for graph rewrite passes: nobody should consume outputs of the node anymore
+             *
+             * @param node
+             */
+            void removeNode(sd::graph::Node *node);
+
             /**
              * This method returns layered representation of the graph
              *
@@ -0,0 +1,48 @@
+/*******************************************************************************
+ * Copyright (c) 2020 Konduit K.K.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#ifndef SD_INPLACE_PLANNER_H
+#define SD_INPLACE_PLANNER_H
+
+#include <graph/Graph.h>
+
+namespace sd {
+    namespace graph {
+        /**
+         * This class marks nodes of the Graph for in-place execution, so their outputs reuse buffers of their inputs.
+         *
+         * Node is marked if its op allows in-place execution, and every input it would overwrite (input i for output i)
+         * is an output of another node with no other uses: reference count of this input is 1 and it's not an output of the Graph.
+         * Graph variables (placeholders, constants) are never overwritten.
+         *
+         * Shapes aren't known statically, so each planned node is verified once more right before its execution:
+         * in-place execution is cancelled if output shape or data type differs from input one, or if input shares buffer
+         * with any external variable. Bytes saved this way are reported via GraphProfile.
+         *
+         * GraphExecutioner runs this pass on every execution if ExecutorConfiguration::_inplacePlanning is set.
+         * Graphs with logic ops (loops, conditions, scopes) are left as is.
+         */
+        class ND4J_EXPORT InplacePlanner {
+        public:
+            /**
+             * This method marks eligible nodes, and returns number of nodes marked
+             */
+            static int apply(Graph* graph);
+        };
+    }
+}
+
+#endif //SD_INPLACE_PLANNER_H
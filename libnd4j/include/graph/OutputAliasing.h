@@ -0,0 +1,51 @@
+/*******************************************************************************
+ * Copyright (c) 2020 Konduit K.K.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#ifndef SD_OUTPUT_ALIASING_H
+#define SD_OUTPUT_ALIASING_H
+
+#include <graph/Graph.h>
+
+namespace sd {
+    namespace graph {
+        /**
+         * This class decides which nodes of the Graph may return views of their inputs instead of copies.
+         *
+         * Only ops declaring OpDescriptor::allowsOutputViews() are considered (split, unstack, slice, strided_slice),
+         * and only if neither their inputs nor their outputs are modified later: any array consumed by in-place node
+         * is treated as modified, together with all arrays it might alias through other view-producing nodes.
+         *
+         * Outputs of the Graph are never aliased, since they are consumed outside of it.
+         *
+         * GraphExecutioner runs this analysis on every execution if ExecutorConfiguration::_outputViews is set.
+         * Graphs with logic ops (loops, conditions, scopes) are left as is.
+         */
+        class ND4J_EXPORT OutputAliasing {
+        public:
+            /**
+             * This method marks ContextPrototypes of eligible nodes, and returns number of such nodes
+             */
+            static int apply(Graph* graph);
+
+            /**
+             * This method clears marks set by apply()
+             */
+            static void reset(Graph* graph);
+        };
+    }
+}
+
+#endif //SD_OUTPUT_ALIASING_H
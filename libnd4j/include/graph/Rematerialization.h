@@ -0,0 +1,113 @@
+/*******************************************************************************
+ * Copyright (c) 2020 Konduit K.K.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+#ifndef SD_REMATERIALIZATION_H
+#define SD_REMATERIALIZATION_H
+
+#include <graph/Graph.h>
+#include <graph/profiling/GraphProfile.h>
+#include <map>
+#include <set>
+#include <vector>
+
+namespace sd {
+    namespace graph {
+        /**
+         * This class implements gradient checkpointing for graphs that contain both forward and backward nodes.
+         *
+         * Backward part of the Graph starts at the first node executing *_bp op. Some forward nodes are chosen as checkpoints,
+         * outputs of other forward nodes are released right after their last use in forward part, and recomputed from
+         * the nearest checkpoints once backward node requests them. Recomputed arrays are released after their last use again.
+         *
+         * Checkpoints are chosen in one of two ways:
+         * - budget <= 0: every ceil(sqrt(N))-th of N forward nodes, so both stored and recomputed memory are O(sqrt(N))
+         * - budget > 0: greedily, as forward part goes: node becomes checkpoint once outputs of the nodes since previous
+         *   checkpoint exceed given number of bytes, so each segment recomputed in backward part fits into the budget
+         *
+         * Outputs of the Graph, outputs of in-place nodes and their inputs, outputs of random ops and persistent variables are never released.
+         * Ops are expected to be deterministic otherwise.
+         *
+         * GraphExecutioner uses this class if ExecutorConfiguration::_rematerialization is set.
+         * Graphs with logic ops (loops, conditions, scopes) or without backward part are executed as is.
+         * Released bytes, number of recomputed nodes and time spent on recomputation are reported via GraphProfile.
+         */
+        class ND4J_EXPORT Rematerialization {
+        private:
+            Graph* _graph;
+            VariableSpace* _variableSpace;
+            GraphProfile* _profile;
+            Nd4jLong _budget;
+
+            // nodes in execution order, and position of every node
+            std::vector<Node*> _order;
+            std::map<int, int> _positions;
+
+            // position of first backward node, -1 if there's nothing to do
+            int _backward = -1;
+
+            // nodes which outputs can be released
+            std::set<int> _candidates;
+            std::set<int> _checkpoints;
+
+            // arrays released after forward node at given position: last use within forward part, or production if there's none
+            std::map<int, std::vector<std::pair<int, int>>> _releases;
+
+            // last use of every forward array
+            std::map<std::pair<int, int>, int> _lastUse;
+
+            // arrays recomputed for backward part
+            std::set<std::pair<int, int>> _recomputed;
+
+            // bytes produced since last checkpoint, budget mode only
+            Nd4jLong _segment = 0L;
+
+            bool isAvailable(const std::pair<int, int> &pair);
+            void release(const std::pair<int, int> &pair);
+            Nd4jStatus recompute(Node* node);
+        public:
+            Rematerialization(Graph* graph, VariableSpace* variableSpace, GraphProfile* profile, Nd4jLong budget = 0L);
+            ~Rematerialization() = default;
+
+            /**
+             * This method returns true if given node executes backward (*_bp) op
+             */
+            static bool isBackward(Node* node);
+
+            /**
+             * This method returns true if Graph has backward part and at least one array can be released
+             */
+            bool isActive() const;
+
+            /**
+             * This method returns ids of checkpoint nodes chosen so far
+             */
+            const std::set<int>& checkpoints() const;
+
+            /**
+             * This method must be called right before node execution: it recomputes released inputs of backward nodes
+             */
+            Nd4jStatus prepare(Node* node);
+
+            /**
+             * This method must be called right after node execution: it releases arrays that aren't needed anymore
+             */
+            void release(Node* node);
+        };
+    }
+}
+
+#endif //SD_REMATERIALIZATION_H
@@ -0,0 +1,112 @@
+/*******************************************************************************
+ * Copyright (c) 2020 Konduit K.K.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+#ifndef SD_STREAMING_SESSION_H
+#define SD_STREAMING_SESSION_H
+
+#include <graph/Graph.h>
+#include <graph/VariableSpace.h>
+#include <map>
+#include <vector>
+
+namespace sd {
+    namespace graph {
+        /**
+         * This class executes inference Graph over a stream of chunks, i.e. for online speech or time series models.
+         *
+         * Recurrent state inputs of the Graph (hI/cI of lstmLayer, hI of gru, c0 of sru etc) are bound to node outputs
+         * holding final states of the chunk. State variables are marked persistent in VariableSpace and stay resident
+         * between calls: each execute() call feeds new timesteps only, and final states of one call become initial
+         * states of the next one.
+         *
+         * - bindState(): source output has shape of the state itself, i.e. hL/cL of lstmLayer. State and source arrays are
+         *   swapped before next call, so nothing is copied and buffer of previous state receives next final state.
+         * - bindStateToLastStep(): source is whole sequence, i.e. h of gru or c of sru, only its last timestep is copied into state.
+         *
+         * Node outputs are reused while chunk shapes stay the same, and released once they change.
+         * Chunks stay owned by caller, and should be alive until next execute() call.
+         *
+         * PLEASE NOTE: once states are committed, source outputs hold previous states, so states should be read via state()
+         */
+        class ND4J_EXPORT StreamingSession {
+        protected:
+            struct StateBinding {
+                std::pair<int, int> state;
+                std::pair<int, int> source;
+                bool lastStep = false;
+                int timeAxis = 0;
+
+                // copy of state at binding time, restored by reset()
+                NDArray initial;
+            };
+
+            Graph* _graph;
+            VariableSpace* _variableSpace;
+
+            std::vector<StateBinding> _states;
+
+            // shapes of chunks fed by previous call
+            std::map<int, std::vector<Nd4jLong>> _shapes;
+
+            // true if final states of last call weren't moved to state variables yet
+            bool _pending = false;
+
+            Nd4jLong _chunks = 0L;
+
+            void bind(int stateId, const std::pair<int, int>& source, bool lastStep, int timeAxis, const NDArray* initial);
+
+            void commitStates();
+
+        public:
+            explicit StreamingSession(Graph* graph, VariableSpace* variableSpace = nullptr);
+            ~StreamingSession() = default;
+
+            /**
+             * This method binds state variable to node output of the same shape
+             * @param stateId - id of the Graph variable (placeholder or variable) used as initial state
+             * @param source - node output holding final state
+             * @param initial - optional initial state, otherwise current array of state variable is used
+             */
+            void bindState(int stateId, const std::pair<int, int>& source, const NDArray* initial = nullptr);
+
+            /**
+             * This method binds state variable to the last timestep of node output along given axis
+             */
+            void bindStateToLastStep(int stateId, const std::pair<int, int>& source, int timeAxis, const NDArray* initial = nullptr);
+
+            /**
+             * This method feeds next chunk into given variables (usually placeholders), and executes the Graph
+             */
+            Nd4jStatus execute(const std::map<int, NDArray*>& inputs);
+
+            /**
+             * This method returns current value of given state variable
+             */
+            NDArray* state(int stateId);
+
+            /**
+             * This method restores initial values of all states, so next call starts new stream
+             */
+            void reset();
+
+            // number of chunks processed since session creation
+            Nd4jLong chunks();
+        };
+    }
+}
+
+#endif //SD_STREAMING_SESSION_H
@@ -70,6 +70,9 @@ namespace sd {
             bool _placeholder = false;
             bool _removable = true;
 
+            // persistent variables keep their arrays between executions, i.e. recurrent states of StreamingSession
+            bool _persistent = false;
+
             // for now we're setting default to numeric
             // in future we'll be fetching it right from the array, 
             //InputType _variableType = InputType_UNDEFINED;
@@ -107,6 +110,7 @@ namespace sd {
             bool isReadOnly();
             bool isEmpty();
             bool isRemovable();
+            bool isPersistent();
 
             bool isPlaceholder();
 
@@ -123,6 +127,7 @@ namespace sd {
             void markExternal(bool reallyExternal);
             void markReadOnly(bool reallyReadOnly);
             void markRemovable(bool reallyRemovable);
+            void markPersistent(bool reallyPersistent);
 
             int id();
             int index();
@@ -112,6 +112,19 @@ namespace sd {
 
             virtual void replaceVariable(Variable *variable);
 
+            /**
+             * This method marks variable as persistent: its array is kept resident between executions,
+             * and it's never released by rematerialization, activation compression or dropTransientArrays()
+             */
+            virtual void markPersistent(std::pair<int,int>& pair, bool persistent = true);
+
+            /**
+             * This method releases arrays of all node outputs which aren't persistent, so next execution allocates them again.
+             * Graph variables (placeholders, constants) are left as is
+             * @return number of arrays dropped
+             */
+            virtual int dropTransientArrays();
+
             // memory-related statistics
             virtual Nd4jLong externalMemory();
             virtual Nd4jLong internalMemory();
@@ -0,0 +1,250 @@
+/*******************************************************************************
+ * Copyright (c) 2020 Konduit K.K.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+#include <graph/ActivationCompression.h>
+#include <graph/Rematerialization.h>
+#include <array/DataTypeUtils.h>
+#include <ops/declarable/helpers/compression.h>
+
+namespace sd {
+    namespace graph {
+        ActivationCompression::ActivationCompression(Graph* graph, VariableSpace* variableSpace, GraphProfile* profile, ActivationCompressionMode mode) {
+            _graph = graph;
+            _variableSpace = variableSpace;
+            _profile = profile;
+            _mode = mode;
+
+            if (mode == ACTIVATION_COMPRESSION_NONE)
+                return;
+
+            if (!graph->built())
+                graph->buildGraph();
+
+            if (!graph->scopes()->empty())
+                return;
+
+            std::vector<Node*> order;
+            auto onion = graph->getOnion();
+            for (int l = 0; l < (int) onion->size(); l++) {
+                if (onion->count(l) == 0)
+                    continue;
+
+                for (auto node: *onion->at(l)) {
+                    if (node->opType() == OpType_LOGIC)
+                        return;
+
+                    if (_backward < 0 && Rematerialization::isBackward(node))
+                        _backward = (int) order.size();
+
+                    _positions[node->id()] = (int) order.size();
+                    order.emplace_back(node);
+                }
+            }
+
+            if (_backward <= 0) {
+                _backward = -1;
+                return;
+            }
+
+            std::set<int> outputs(graph->output()->begin(), graph->output()->end());
+            std::set<int> pinned;
+
+            std::map<std::pair<int, int>, int> lastForwardUse;
+            for (int e = 0; e < (int) order.size(); e++) {
+                auto node = order[e];
+                auto proto = node->getContextPrototype();
+
+                // in-place outputs share arrays with inputs
+                if (proto != nullptr && proto->isInplace()) {
+                    pinned.insert(node->id());
+
+                    for (auto &p: *node->input())
+                        pinned.insert(p.first);
+                }
+
+                // masks are enough only if every backward use of array needs sign of it
+                int mask = 0;
+                if (e >= _backward && node->hasCustomOp()) {
+                    auto name = node->getCustomOp()->getOpName();
+                    if (*name == "relu_bp")
+                        mask = 1;
+                    else if (*name == "lrelu_bp")
+                        mask = -1;
+                }
+
+                for (int i = 0; i < (int) node->input()->size(); i++) {
+                    auto &p = node->input()->at(i);
+                    if (!graph->hasNode(p.first) || _positions[p.first] >= _backward)
+                        continue;
+
+                    if (e < _backward) {
+                        lastForwardUse[p] = e;
+                        continue;
+                    }
+
+                    auto m = i == 0 ? mask : 0;
+                    if (_lastUse.count(p) == 0)
+                        _masks[p] = m;
+                    else if (_masks[p] != m)
+                        _masks[p] = 0;
+
+                    _lastUse[p] = e;
+                }
+            }
+
+            for (auto &v: _lastUse) {
+                auto &p = v.first;
+                if (outputs.count(p.first) > 0 || pinned.count(p.first) > 0)
+                    continue;
+
+                auto position = lastForwardUse.count(p) > 0 ? lastForwardUse[p] : _positions[p.first];
+                _compressions[position].emplace_back(p);
+            }
+        }
+
+        ActivationCompression::~ActivationCompression() {
+            // arrays that were never requested back
+            for (auto &v: _compressed) {
+                delete v.second.packed;
+                delete v.second.scales;
+            }
+        }
+
+        bool ActivationCompression::isActive() const {
+            return _backward > 0 && !_compressions.empty();
+        }
+
+        void ActivationCompression::compress(const std::pair<int, int> &pair) {
+            std::pair<int, int> p(pair);
+            if (!_variableSpace->hasVariable(p))
+                return;
+
+            auto var = _variableSpace->getVariable(p);
+            if (var->variableType() != VariableType::NDARRAY || !var->hasNDArray() || !var->isRemovable() || var->isReadOnly() || var->isPersistent())
+                return;
+
+            auto array = var->getNDArray();
+            if (!array->isR() || array->isView() || array->ordering() != 'c' || array->ews() != 1 || array->lengthOf() == 0)
+                return;
+
+            auto timeStart = GraphProfile::currentTime();
+
+            Compressed c;
+            c.shape = array->getShapeAsVector();
+            c.dataType = array->dataType();
+            c.mask = _masks[p];
+
+            auto context = array->getContext();
+            auto length = array->lengthOf();
+
+            if (c.mask != 0) {
+                c.packed = new NDArray('c', {(length + 7) / 8}, sd::DataType::UINT8, context);
+                ops::helpers::encodeSignMask(context, array, c.packed, c.mask < 0);
+            } else if (_mode == ACTIVATION_COMPRESSION_INT8 && array->sizeOfT() > 1) {
+                c.packed = new NDArray('c', {length}, sd::DataType::INT8, context);
+                c.scales = new NDArray('c', {(length + BLOCK_SIZE - 1) / BLOCK_SIZE}, sd::DataType::FLOAT32, context);
+                ops::helpers::quantizeBlocks(context, array, c.packed, c.scales, BLOCK_SIZE);
+            } else if (_mode == ACTIVATION_COMPRESSION_HALF || _mode == ACTIVATION_COMPRESSION_BFLOAT16) {
+                auto dataType = _mode == ACTIVATION_COMPRESSION_HALF ? sd::DataType::HALF : sd::DataType::BFLOAT16;
+                if (array->sizeOfT() <= DataTypeUtils::sizeOfElement(dataType))
+                    return;
+
+                c.packed = new NDArray(array->cast(dataType));
+            } else
+                return;
+
+            Nd4jLong saved = array->getDataBuffer()->getLenInBytes() - c.packed->getDataBuffer()->getLenInBytes();
+            if (c.scales != nullptr)
+                saved -= c.scales->getDataBuffer()->getLenInBytes();
+
+            var->setNDArray(nullptr);
+            delete array;
+
+            _compressed[p] = c;
+
+            _profile->addToCompressed(saved);
+            _profile->addToCompressionTime(GraphProfile::relativeTime(timeStart));
+        }
+
+        void ActivationCompression::decompress(const std::pair<int, int> &pair) {
+            std::pair<int, int> p(pair);
+            auto &c = _compressed[p];
+
+            auto timeStart = GraphProfile::currentTime();
+
+            auto context = c.packed->getContext();
+            auto array = new NDArray('c', c.shape, c.dataType, context);
+
+            if (c.mask != 0)
+                ops::helpers::decodeSignMask(context, c.packed, array, c.mask < 0);
+            else if (c.scales != nullptr)
+                ops::helpers::dequantizeBlocks(context, c.packed, c.scales, array, BLOCK_SIZE);
+            else
+                array->assign(*c.packed);
+
+            auto var = _variableSpace->getVariable(p);
+            var->setNDArray(array);
+            var->markRemovable(true);
+
+            delete c.packed;
+            delete c.scales;
+            _compressed.erase(p);
+            _restored.insert(p);
+
+            _profile->addToCompressionTime(GraphProfile::relativeTime(timeStart));
+        }
+
+        Nd4jStatus ActivationCompression::prepare(Node* node) {
+            if (!isActive() || _positions[node->id()] < _backward)
+                return Status::OK();
+
+            for (auto &p: *node->input())
+                if (_compressed.count(p) > 0)
+                    decompress(p);
+
+            return Status::OK();
+        }
+
+        void ActivationCompression::release(Node* node) {
+            if (!isActive())
+                return;
+
+            auto e = _positions[node->id()];
+
+            if (e < _backward) {
+                if (_compressions.count(e) > 0)
+                    for (auto &p: _compressions[e])
+                        compress(p);
+
+                return;
+            }
+
+            for (auto it = _restored.begin(); it != _restored.end(); ) {
+                if (_lastUse[*it] <= e) {
+                    std::pair<int, int> p(*it);
+                    auto var = _variableSpace->getVariable(p);
+                    auto array = var->getNDArray();
+                    var->setNDArray(nullptr);
+                    delete array;
+
+                    it = _restored.erase(it);
+                } else
+                    ++it;
+            }
+        }
+    }
+}
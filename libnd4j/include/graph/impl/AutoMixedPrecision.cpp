@@ -0,0 +1,440 @@
+/*******************************************************************************
+ * Copyright (c) 2020 Konduit K.K.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#include <graph/AutoMixedPrecision.h>
+#include <graph/GraphExecutioner.h>
+#include <ops/declarable/OpRegistrator.h>
+#include <array/DataTypeUtils.h>
+#include <helpers/logger.h>
+#include <stdexcept>
+#include <cmath>
+#include <math/templatemath.h>
+
+namespace sd {
+    namespace graph {
+        enum AmpClass {
+            AMP_OTHER = 0,
+            AMP_ALLOW = 1,
+            AMP_INFER = 2,
+            AMP_DENY = 3,
+            AMP_CAST = 4,
+        };
+
+        AutoMixedPrecision::AutoMixedPrecision(sd::DataType lowType) {
+            if (lowType != sd::DataType::HALF && lowType != sd::DataType::BFLOAT16)
+                throw std::invalid_argument("AutoMixedPrecision: low precision type should be either HALF or BFLOAT16");
+
+            _lowType = lowType;
+
+            // compute-bound ops, worth casting for
+            _allow = {"matmul", "tensormmul", "batched_gemm", "xw_plus_b", "relu_layer",
+                      "conv1d", "conv2d", "conv3dnew", "depthwise_conv2d", "pointwise_conv2d", "sconv2d",
+                      "deconv2d", "deconv3d"};
+
+            // ops that follow precision of their inputs
+            _infer = {"biasadd", "add", "subtract", "multiply", "divide", "realdiv", "maximum", "minimum", "squaredsubtract", "mergeadd",
+                      "relu", "relu6", "lrelu", "elu", "selu", "sigmoid", "tanh",
+                      "avgpool2d", "maxpool2d", "avgpool3dnew", "maxpool3dnew",
+                      "reshape", "transpose", "permute", "squeeze", "expand_dims", "flatten", "identity",
+                      "concat", "stack", "unstack", "split", "slice", "strided_slice", "gather", "tile", "pad"};
+
+            // numerically sensitive ops
+            _deny = {"softmax", "log_softmax", "softmax_cross_entropy_loss_with_logits", "log1p", "Pow",
+                     "lrn", "layer_norm", "batchnorm", "standardize", "moments", "norm"};
+        }
+
+        std::set<std::string>& AutoMixedPrecision::allowList() {
+            return _allow;
+        }
+
+        std::set<std::string>& AutoMixedPrecision::inferList() {
+            return _infer;
+        }
+
+        std::set<std::string>& AutoMixedPrecision::denyList() {
+            return _deny;
+        }
+
+        sd::DataType AutoMixedPrecision::lowType() {
+            return _lowType;
+        }
+
+        sd::DataType AutoMixedPrecision::placeholderType() {
+            return _placeholderType;
+        }
+
+        void AutoMixedPrecision::setPlaceholderType(sd::DataType dataType) {
+            _placeholderType = dataType;
+        }
+
+        int AutoMixedPrecision::loweredNodes() {
+            return _lowered;
+        }
+
+        int AutoMixedPrecision::insertedCasts() {
+            return _casts;
+        }
+
+        int AutoMixedPrecision::convertedConstants() {
+            return _constants;
+        }
+
+        int AutoMixedPrecision::classify(Node* node) {
+            switch (node->opType()) {
+                // legacy elementwise ops
+                case OpType_PAIRWISE:
+                case OpType_BROADCAST:
+                case OpType_SCALAR:
+                    return AMP_INFER;
+                // exp/log/sqrt and friends, and reductions
+                case OpType_TRANSFORM_FLOAT:
+                case OpType_TRANSFORM_STRICT:
+                case OpType_REDUCE_FLOAT:
+                case OpType_REDUCE_SAME:
+                case OpType_REDUCE_3:
+                case OpType_SUMMARYSTATS:
+                    return AMP_DENY;
+                case OpType_CUSTOM:
+                    break;
+                default:
+                    return AMP_OTHER;
+            }
+
+            if (!node->hasCustomOp())
+                return AMP_OTHER;
+
+            auto name = *node->getCustomOp()->getOpName();
+            if (name == "cast")
+                return AMP_CAST;
+
+            if (_deny.count(name) > 0 || name.compare(0, 7, "reduce_") == 0 || (name.length() > 5 && name.compare(name.length() - 5, 5, "_loss") == 0))
+                return AMP_DENY;
+
+            if (_allow.count(name) > 0)
+                return AMP_ALLOW;
+
+            if (_infer.count(name) > 0)
+                return AMP_INFER;
+
+            return AMP_OTHER;
+        }
+
+        static void replaceInput(Node* node, int index, const std::pair<int, int>& input) {
+            node->input()->at(index) = input;
+
+            // Context is built from ContextPrototype, so it has to be updated as well
+            if (node->hasBlockAttached()) {
+                auto inputs = node->getContextPrototype()->inputs();
+                if (index < (int) inputs->size())
+                    inputs->at(index) = input;
+            }
+        }
+
+        Node* AutoMixedPrecision::insertCast(Graph* graph, const std::pair<int, int>& source, sd::DataType dataType, Node* before) {
+            auto op = sd::ops::OpRegistrator::getInstance().getOperation("cast");
+            auto node = new Node(op, _nextNodeId++, {}, {}, {}, 0.0f, {}, {static_cast<int>(dataType)});
+            node->setName("amp/cast_" + std::to_string(source.first) + ":" + std::to_string(source.second) + "/" + DataTypeUtils::asString(dataType));
+            node->pickInput(source.first, source.second);
+
+            graph->insertNode(node, before);
+            _casts++;
+
+            return node;
+        }
+
+        int AutoMixedPrecision::apply(Graph* graph) {
+            _lowered = 0;
+            _casts = 0;
+            _constants = 0;
+
+            if (!graph->built())
+                graph->buildGraph();
+
+            if (!graph->scopes()->empty()) {
+                nd4j_printf("AutoMixedPrecision: graphs with scopes aren't supported, skipping\n", "");
+                return 0;
+            }
+
+            auto onion = graph->getOnion();
+            auto variableSpace = graph->getVariableSpace();
+
+            // nodes in execution order
+            std::vector<Node*> order;
+            for (int l = 0; l < (int) onion->size(); l++) {
+                if (onion->count(l) == 0)
+                    continue;
+
+                for (auto node: *onion->at(l)) {
+                    if (node->opType() == OpType_LOGIC) {
+                        nd4j_printf("AutoMixedPrecision: graphs with logic ops aren't supported, skipping\n", "");
+                        return 0;
+                    }
+
+                    order.emplace_back(node);
+                }
+            }
+
+            _nextNodeId = 1;
+            _nextVariableId = -1;
+            for (auto &v: *graph->getMapped())
+                _nextNodeId = sd::math::nd4j_max<int>(_nextNodeId, v.first + 1);
+
+            for (auto v: variableSpace->getVariables()) {
+                _nextNodeId = sd::math::nd4j_max<int>(_nextNodeId, v->id() + 1);
+                _nextVariableId = sd::math::nd4j_min<int>(_nextVariableId, v->id() - 1);
+            }
+
+            std::set<int> outputs(graph->output()->begin(), graph->output()->end());
+            outputs.insert(graph->autos()->begin(), graph->autos()->end());
+
+            // output data types of nodes, as far as they can be derived without execution. INHERIT means unknown
+            std::map<int, sd::DataType> nodeTypes;
+
+            // nodes producing low precision outputs, inserted casts included
+            std::set<int> lowered;
+
+            std::map<std::pair<int, int>, int> downCasts;
+            std::map<std::pair<int, int>, int> upCasts;
+            std::map<int, std::pair<int, int>> castSources;
+
+            // constants consumed in low precision, and ones still consumed in fp32
+            std::map<std::pair<int, int>, std::vector<std::pair<Node*, int>>> constantUses;
+            std::set<std::pair<int, int>> fp32Constants;
+
+            auto variableOf = [&](const std::pair<int, int>& p) -> Variable* {
+                if (graph->hasNode(p.first) || !variableSpace->hasVariable(p.first, p.second))
+                    return nullptr;
+
+                return variableSpace->getVariable(p.first, p.second);
+            };
+
+            auto isConstant = [&](const std::pair<int, int>& p) -> bool {
+                auto var = variableOf(p);
+                return var != nullptr && var->hasNDArray() && !var->isPlaceholder();
+            };
+
+            auto isEmptyPlaceholder = [&](const std::pair<int, int>& p) -> bool {
+                auto var = variableOf(p);
+                return var != nullptr && !var->hasNDArray() && (var->isPlaceholder() || var->variableType() == VariableType::PLACEHOLDER);
+            };
+
+            auto typeOf = [&](const std::pair<int, int>& p) -> sd::DataType {
+                if (graph->hasNode(p.first))
+                    return nodeTypes.count(p.first) > 0 ? nodeTypes.at(p.first) : sd::DataType::INHERIT;
+
+                auto var = variableOf(p);
+                if (var != nullptr && var->hasNDArray())
+                    return var->getNDArray()->dataType();
+
+                return sd::DataType::INHERIT;
+            };
+
+            for (auto node: order) {
+                auto cls = classify(node);
+                auto inputs = node->input();
+
+                bool anyLow = false;
+                bool anyFloat = false;
+                bool convertible = true;
+                for (auto &p: *inputs) {
+                    auto t = typeOf(p);
+                    if (lowered.count(p.first) > 0 || t == _lowType) {
+                        anyLow = true;
+                        anyFloat = true;
+                    } else if (t == sd::DataType::FLOAT32 || (cls == AMP_ALLOW && _placeholderType == sd::DataType::FLOAT32 && isEmptyPlaceholder(p))) {
+                        anyFloat = true;
+                    } else if (t == sd::DataType::INHERIT || DataTypeUtils::isR(t)) {
+                        // integer inputs (shapes, indices) are fine, anything else we can't reason about
+                        convertible = false;
+                    }
+                }
+
+                bool lower = convertible && outputs.count(node->id()) == 0 && ((cls == AMP_ALLOW && anyFloat) || (cls == AMP_INFER && anyLow));
+
+                if (lower) {
+                    for (int e = 0; e < (int) inputs->size(); e++) {
+                        auto p = inputs->at(e);
+                        auto t = typeOf(p);
+
+                        // only fp32 inputs are converted, empty placeholders of allow list ops included
+                        if (lowered.count(p.first) > 0 || (t != sd::DataType::FLOAT32 && !(t == sd::DataType::INHERIT && isEmptyPlaceholder(p))))
+                            continue;
+
+                        if (isConstant(p)) {
+                            constantUses[p].emplace_back(node, e);
+                            continue;
+                        }
+
+                        if (downCasts.count(p) == 0) {
+                            auto cast = insertCast(graph, p, _lowType, node);
+                            downCasts[p] = cast->id();
+                            castSources[cast->id()] = p;
+                            lowered.insert(cast->id());
+                            nodeTypes[cast->id()] = _lowType;
+                        }
+
+                        replaceInput(node, e, std::pair<int, int>(downCasts.at(p), 0));
+                    }
+
+                    lowered.insert(node->id());
+                    nodeTypes[node->id()] = _lowType;
+                    _lowered++;
+                    continue;
+                }
+
+                // this node stays in original precision
+                auto resultType = sd::DataType::INHERIT;
+                for (int e = 0; e < (int) inputs->size(); e++) {
+                    auto p = inputs->at(e);
+
+                    if (castSources.count(p.first) > 0) {
+                        // cast of inserted cast: original tensor is still available
+                        p = castSources.at(p.first);
+                        replaceInput(node, e, p);
+                    } else if (lowered.count(p.first) > 0 && cls != AMP_CAST) {
+                        if (upCasts.count(p) == 0) {
+                            auto cast = insertCast(graph, p, sd::DataType::FLOAT32, node);
+                            upCasts[p] = cast->id();
+                            nodeTypes[cast->id()] = sd::DataType::FLOAT32;
+                        }
+
+                        p = std::pair<int, int>(upCasts.at(p), 0);
+                        replaceInput(node, e, p);
+                    }
+
+                    if (isConstant(p))
+                        fp32Constants.insert(p);
+
+                    auto t = typeOf(p);
+                    if (resultType == sd::DataType::INHERIT && (DataTypeUtils::isR(t) || (cls == AMP_INFER && t != sd::DataType::INHERIT)))
+                        resultType = t;
+                }
+
+                if (cls == AMP_CAST && !node->getContextPrototype()->getIArguments()->empty())
+                    resultType = DataTypeUtils::fromInt(node->getContextPrototype()->getIArguments()->at(0));
+                else if (cls == AMP_OTHER)
+                    resultType = sd::DataType::INHERIT;
+
+                if (resultType != sd::DataType::INHERIT)
+                    nodeTypes[node->id()] = resultType;
+            }
+
+            // constants are converted once, right here
+            for (auto &c: constantUses) {
+                auto var = variableOf(c.first);
+                auto array = new NDArray(var->getNDArray()->cast(_lowType));
+
+                if (fp32Constants.count(c.first) == 0) {
+                    // nobody needs fp32 copy anymore, so it's replaced in place
+                    auto original = var->getNDArray();
+                    auto type = var->variableType();
+                    bool owned = type == VariableType::NDARRAY && var->isRemovable() && !var->isReadOnly();
+
+                    var->setNDArray(array);
+                    var->setVariableType(type);
+
+                    if (owned)
+                        delete original;
+                } else {
+                    std::pair<int, int> id(_nextVariableId--, 0);
+                    auto name = var->getName() != nullptr && !var->getName()->empty() ? *var->getName() + "/amp" : std::string();
+                    auto copy = new Variable(array, name.empty() ? nullptr : name.c_str(), id.first, 0);
+                    variableSpace->putVariable(id, copy);
+
+                    for (auto &u: c.second)
+                        replaceInput(u.first, u.second, id);
+                }
+
+                _constants++;
+            }
+
+            nd4j_debug("AutoMixedPrecision: %i nodes lowered to %s; %i casts inserted; %i constants converted\n", _lowered, DataTypeUtils::asString(_lowType).c_str(), _casts, _constants);
+
+            return _lowered;
+        }
+
+        static std::vector<std::pair<int, int>> outputVariables(Graph* graph) {
+            std::vector<std::pair<int, int>> result;
+            std::set<int> seen;
+            auto variableSpace = graph->getVariableSpace();
+
+            std::vector<int> ids(graph->output()->begin(), graph->output()->end());
+            ids.insert(ids.end(), graph->autos()->begin(), graph->autos()->end());
+
+            for (auto id: ids) {
+                if (!seen.insert(id).second)
+                    continue;
+
+                for (int e = 0; variableSpace->hasVariable(id, e); e++)
+                    result.emplace_back(id, e);
+            }
+
+            return result;
+        }
+
+        std::vector<AmpOutputError> AutoMixedPrecision::compare(Graph* reference, Graph* mixed) {
+            if (GraphExecutioner::execute(reference) != Status::OK())
+                throw std::runtime_error("AutoMixedPrecision::compare: reference graph execution failed");
+
+            if (GraphExecutioner::execute(mixed) != Status::OK())
+                throw std::runtime_error("AutoMixedPrecision::compare: mixed-precision graph execution failed");
+
+            std::vector<AmpOutputError> result;
+            for (auto &p: outputVariables(reference)) {
+                if (!mixed->getVariableSpace()->hasVariable(p.first, p.second))
+                    continue;
+
+                auto x = reference->getVariableSpace()->getVariable(p.first, p.second);
+                auto y = mixed->getVariableSpace()->getVariable(p.first, p.second);
+                if (!x->hasNDArray() || !y->hasNDArray() || !x->getNDArray()->isR())
+                    continue;
+
+                if (!x->getNDArray()->isSameShape(y->getNDArray())) {
+                    nd4j_printf("AutoMixedPrecision: output <%i:%i> has different shapes\n", p.first, p.second);
+                    throw std::runtime_error("AutoMixedPrecision::compare: output shapes mismatch");
+                }
+
+                auto rx = x->getNDArray()->cast(sd::DataType::DOUBLE).dup('c');
+                auto ry = y->getNDArray()->cast(sd::DataType::DOUBLE).dup('c');
+                rx.syncToHost();
+                ry.syncToHost();
+
+                auto bx = rx.bufferAsT<double>();
+                auto by = ry.bufferAsT<double>();
+
+                AmpOutputError error;
+                error.id = p.first;
+                error.index = p.second;
+                error.length = rx.lengthOf();
+
+                double sum = 0.0;
+                for (Nd4jLong e = 0; e < error.length; e++) {
+                    auto diff = std::abs(bx[e] - by[e]);
+                    sum += diff;
+                    error.maxAbsError = sd::math::nd4j_max<double>(error.maxAbsError, diff);
+                    error.maxRelError = sd::math::nd4j_max<double>(error.maxRelError, diff / sd::math::nd4j_max<double>(std::abs(bx[e]), 1e-6));
+                }
+
+                if (error.length > 0)
+                    error.meanAbsError = sum / error.length;
+
+                result.emplace_back(error);
+            }
+
+            return result;
+        }
+    }
+}
@@ -55,6 +55,9 @@ namespace sd {
                 this->_isInplace = prototype->isInplace();
                 this->_nodeId = prototype->nodeId();
                 this->_useMKLDNN = prototype->isUseMKLDNN();
+                this->_fp32Accumulation = prototype->isFp32Accumulation();
+                this->_outputViews = prototype->isOutputViews();
+                this->_inplacePlanned = prototype->isInplacePlanned();
             }
 
 
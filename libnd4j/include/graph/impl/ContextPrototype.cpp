@@ -161,7 +161,10 @@ namespace sd {
         ContextPrototype* ContextPrototype::clone() {
             auto clone = new ContextPrototype(_opDescriptor, _nodeId, _isInplace);
             clone->_opNum = _opNum;
-            
+            clone->_fp32Accumulation = _fp32Accumulation;
+            clone->_outputViews = _outputViews;
+            clone->_inplacePlanned = _inplacePlanned;
+
             for (auto v: _inputs)
                 clone->_inputs.emplace_back(v);
 
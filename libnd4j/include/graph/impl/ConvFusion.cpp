@@ -0,0 +1,347 @@
+/*******************************************************************************
+ * Copyright (c) 2020 Konduit K.K.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#include <graph/ConvFusion.h>
+#include <helpers/GemmEpilogue.h>
+#include <helpers/logger.h>
+#include <map>
+#include <set>
+
+namespace sd {
+    namespace graph {
+        static std::string opName(Node* node) {
+            if (node->opType() != OpType_CUSTOM || !node->hasCustomOp())
+                return std::string();
+
+            return *node->getCustomOp()->getOpName();
+        }
+
+        // position of output channels within weights, depthwise weights have them split over iC and mC
+        static int weightsChannelAxis(const std::string& name, const int wFormat) {
+            if (name == "conv2d")
+                return 0 == wFormat ? 3 : 0;                                    // [kH, kW, iC, oC], [oC, iC, kH, kW], [oC, kH, kW, iC]
+
+            if (name == "deconv2d")
+                return 0 == wFormat ? 2 : (1 == wFormat ? 1 : 3);               // [kH, kW, oC, iC], [iC, oC, kH, kW], [iC, kH, kW, oC]
+
+            return -1;
+        }
+
+        static Nd4jLong outputChannels(const NDArray& weights, const std::string& name, const int wFormat) {
+            if (name != "depthwise_conv2d")
+                return weights.sizeAt(weightsChannelAxis(name, wFormat));
+
+            // [kH, kW, iC, mC], [mC, iC, kH, kW], [mC, kH, kW, iC]
+            return weights.sizeAt(0 == wFormat ? 2 : (1 == wFormat ? 1 : 3)) * weights.sizeAt(0 == wFormat ? 3 : 0);
+        }
+
+        // per output channel scale, reshaped to be broadcastable against weights
+        static NDArray weightsScale(const NDArray& scale, const NDArray& weights, const std::string& name, const int wFormat) {
+            const Nd4jLong oC = scale.lengthOf();
+
+            if (name != "depthwise_conv2d") {
+                std::vector<Nd4jLong> shape(4, 1);
+                shape[weightsChannelAxis(name, wFormat)] = oC;
+                return scale.reshape('c', shape);
+            }
+
+            // depthwise output channel is iC * mC + m
+            const Nd4jLong mC = weights.sizeAt(0 == wFormat ? 3 : 0);
+            const Nd4jLong iC = oC / mC;
+
+            if (0 == wFormat)
+                return scale.reshape('c', {1, 1, iC, mC});
+
+            auto transposed = scale.reshape('c', {iC, mC}).transpose().dup('c');
+            return 1 == wFormat ? transposed.reshape('c', {mC, iC, 1, 1}) : transposed.reshape('c', {mC, 1, 1, iC});
+        }
+
+        int ConvFusion::fusedChains() {
+            return _fused;
+        }
+
+        int ConvFusion::foldedBatchNorms() {
+            return _folded;
+        }
+
+        int ConvFusion::fusedActivations() {
+            return _activations;
+        }
+
+        int ConvFusion::apply(Graph* graph) {
+            _fused = 0;
+            _folded = 0;
+            _activations = 0;
+
+            if (!graph->built())
+                graph->buildGraph();
+
+            if (!graph->scopes()->empty()) {
+                nd4j_printf("ConvFusion: graphs with scopes aren't supported, skipping\n", "");
+                return 0;
+            }
+
+            auto onion = graph->getOnion();
+            auto variableSpace = graph->getVariableSpace();
+
+            // node ids in execution order, nodes themselves might be replaced on the way
+            std::vector<int> order;
+            for (int l = 0; l < (int) onion->size(); l++) {
+                if (onion->count(l) == 0)
+                    continue;
+
+                for (auto node: *onion->at(l)) {
+                    if (node->opType() == OpType_LOGIC) {
+                        nd4j_printf("ConvFusion: graphs with logic ops aren't supported, skipping\n", "");
+                        return 0;
+                    }
+
+                    order.emplace_back(node->id());
+                }
+            }
+
+            _nextVariableId = -1;
+            for (auto v: variableSpace->getVariables())
+                _nextVariableId = sd::math::nd4j_min<int>(_nextVariableId, v->id() - 1);
+
+            std::set<int> outputs(graph->output()->begin(), graph->output()->end());
+            outputs.insert(graph->autos()->begin(), graph->autos()->end());
+
+            std::map<int, std::vector<int>> consumers;
+            std::map<std::pair<int, int>, int> uses;
+            for (auto id: order)
+                for (auto &p: *graph->nodeById(id)->input()) {
+                    consumers[p.first].emplace_back(id);
+                    uses[p]++;
+                }
+
+            auto constant = [&](const std::pair<int, int>& p) -> NDArray* {
+                if (graph->hasNode(p.first) || !variableSpace->hasVariable(p.first, p.second))
+                    return nullptr;
+
+                auto var = variableSpace->getVariable(p.first, p.second);
+                return var->hasNDArray() && !var->isPlaceholder() ? var->getNDArray() : nullptr;
+            };
+
+            // returns the only consumer of the node, if it's allowed to be fused into the chain
+            auto soleConsumer = [&](int id) -> Node* {
+                if (outputs.count(id) > 0 || consumers.count(id) == 0 || consumers.at(id).size() != 1)
+                    return nullptr;
+
+                auto next = graph->nodeById(consumers.at(id).front());
+                return next->input()->at(0) == std::pair<int, int>(id, 0) ? next : nullptr;
+            };
+
+            // folded array replaces original constant if nobody else uses it, otherwise it becomes new constant
+            auto putConstant = [&](const std::pair<int, int>& p, NDArray* array, const std::string& name) -> std::pair<int, int> {
+                if (constant(p) != nullptr && uses[p] == 1) {
+                    auto var = variableSpace->getVariable(p.first, p.second);
+                    auto original = var->getNDArray();
+                    auto type = var->variableType();
+                    bool owned = type == VariableType::NDARRAY && var->isRemovable() && !var->isReadOnly();
+
+                    var->setNDArray(array);
+                    var->setVariableType(type);
+
+                    if (owned)
+                        delete original;
+
+                    return p;
+                }
+
+                std::pair<int, int> id(_nextVariableId--, 0);
+                variableSpace->putVariable(id, new Variable(array, name.empty() ? nullptr : name.c_str(), id.first, 0));
+                uses[id] = 1;
+
+                return id;
+            };
+
+            for (auto id: order) {
+                if (!graph->hasNode(id))
+                    continue;
+
+                auto node = graph->nodeById(id);
+                auto name = opName(node);
+                auto inputs = node->input();
+
+                if ((name != "conv2d" && name != "depthwise_conv2d" && name != "deconv2d") || inputs->size() < 2 || inputs->size() > 3)
+                    continue;
+
+                auto iArgs = *node->getContextPrototype()->getIArguments();
+                if (iArgs.size() < 9 || (iArgs.size() > 11 && iArgs[11] != 0))
+                    continue;
+
+                const int isNCHW = iArgs.size() > 9 ? !iArgs[9] : 1;
+                const int wFormat = iArgs.size() > 10 ? iArgs[10] : 0;
+
+                auto weights = constant(inputs->at(1));
+                auto bias = inputs->size() > 2 ? constant(inputs->at(2)) : nullptr;
+                if (weights == nullptr || weights->rankOf() != 4 || !weights->isR() || (inputs->size() > 2 && bias == nullptr))
+                    continue;
+
+                const Nd4jLong oC = outputChannels(*weights, name, wFormat);
+                if (bias != nullptr && bias->lengthOf() != oC)
+                    continue;
+
+                Node* last = node;
+                Node* norm = nullptr;
+                NDArray *mean = nullptr, *variance = nullptr, *gamma = nullptr, *beta = nullptr;
+                double epsilon = 0.0;
+
+                auto next = soleConsumer(id);
+                if (next != nullptr && opName(next) == "batchnorm") {
+                    auto bnInputs = next->input();
+                    auto bnI = next->getContextPrototype()->getIArguments();
+                    auto bnT = next->getContextPrototype()->getTArguments();
+
+                    const bool applyScale = bnI->size() > 0 && bnI->at(0) != 0;
+                    const bool applyOffset = bnI->size() > 1 && bnI->at(1) != 0;
+                    const int channelAxis = isNCHW ? 1 : 3;
+
+                    // single normalized axis is expected, and it should be channels one, by default batchnorm takes the last axis
+                    bool foldable = bnI->size() >= 2 && !bnT->empty() && (int) bnInputs->size() == 3 + (int) applyScale + (int) applyOffset;
+                    if (bnI->size() > 2)
+                        foldable &= bnI->size() == 3 && (bnI->at(2) == channelAxis || bnI->at(2) == channelAxis - 4);
+                    else
+                        foldable &= channelAxis == 3;
+
+                    if (foldable) {
+                        mean = constant(bnInputs->at(1));
+                        variance = constant(bnInputs->at(2));
+                        gamma = applyScale ? constant(bnInputs->at(3)) : nullptr;
+                        beta = applyOffset ? constant(bnInputs->at(3 + (int) applyScale)) : nullptr;
+
+                        foldable &= mean != nullptr && mean->lengthOf() == oC && variance != nullptr && variance->lengthOf() == oC;
+                        foldable &= !applyScale || (gamma != nullptr && gamma->lengthOf() == oC);
+                        foldable &= !applyOffset || (beta != nullptr && beta->lengthOf() == oC);
+                    }
+
+                    if (foldable) {
+                        norm = next;
+                        last = next;
+                        epsilon = bnT->at(0);
+                    }
+                }
+
+                auto activation = GemmEpilogue::NONE;
+                double cutoff = 0.0;
+
+                auto act = soleConsumer(last->id());
+                if (act != nullptr && act->input()->size() == 1) {
+                    auto actName = opName(act);
+                    if (actName == "relu") {
+                        activation = GemmEpilogue::RELU;
+                        auto actT = act->getContextPrototype()->getTArguments();
+                        cutoff = actT->empty() ? 0.0 : actT->at(0);
+                    } else if (actName == "tanh")
+                        activation = GemmEpilogue::TANH;
+                    else if (actName == "sigmoid")
+                        activation = GemmEpilogue::SIGMOID;
+
+                    if (activation != GemmEpilogue::NONE)
+                        last = act;
+                }
+
+                if (norm == nullptr && activation == GemmEpilogue::NONE)
+                    continue;
+
+                auto wId = inputs->at(1);
+                auto bId = inputs->size() > 2 ? inputs->at(2) : std::pair<int, int>(0, 0);
+                bool hasBias = inputs->size() > 2;
+
+                if (norm != nullptr) {
+                    // everything is computed in double, and cast back to types of original constants
+                    NDArray scale = variance->cast(sd::DataType::DOUBLE);
+                    scale.reshapei({oC});
+                    scale += epsilon;
+                    scale.applyTransform(sd::transform::RSqrt, scale);
+
+                    if (gamma != nullptr) {
+                        NDArray g = gamma->cast(sd::DataType::DOUBLE);
+                        scale *= g.reshape('c', {oC});
+                    }
+
+                    NDArray shift('c', {oC}, sd::DataType::DOUBLE);
+                    shift.nullify();
+
+                    if (bias != nullptr) {
+                        NDArray b = bias->cast(sd::DataType::DOUBLE);
+                        shift += b.reshape('c', {oC});
+                    }
+
+                    NDArray m = mean->cast(sd::DataType::DOUBLE);
+                    shift -= m.reshape('c', {oC});
+                    shift *= scale;
+
+                    if (beta != nullptr) {
+                        NDArray b = beta->cast(sd::DataType::DOUBLE);
+                        shift += b.reshape('c', {oC});
+                    }
+
+                    NDArray w = weights->cast(sd::DataType::DOUBLE);
+                    w *= weightsScale(scale, *weights, name, wFormat);
+
+                    auto nodeName = last->getName() != nullptr ? *last->getName() : std::string();
+                    wId = putConstant(wId, new NDArray(w.cast(weights->dataType())), nodeName.empty() ? nodeName : nodeName + "/weights");
+                    bId = putConstant(bId, new NDArray(shift.cast(bias != nullptr ? bias->dataType() : weights->dataType())), nodeName.empty() ? nodeName : nodeName + "/bias");
+                    hasBias = true;
+                }
+
+                // missing optional args are filled with their defaults: NCHW, [kH, kW, iC, oC] weights
+                while (iArgs.size() < 11)
+                    iArgs.emplace_back(0);
+
+                if (iArgs.size() == 11)
+                    iArgs.emplace_back(static_cast<int>(activation));
+                else
+                    iArgs[11] = static_cast<int>(activation);
+
+                auto fused = new Node(node->getCustomOp(), last->id());
+                *fused->getContextPrototype()->getIArguments() = iArgs;
+                fused->getContextPrototype()->getTArguments()->emplace_back(cutoff);
+
+                if (last->getName() != nullptr)
+                    fused->setName(*last->getName());
+
+                fused->pickInput(inputs->at(0).first, inputs->at(0).second);
+                fused->pickInput(wId.first, wId.second);
+                if (hasBias)
+                    fused->pickInput(bId.first, bId.second);
+
+                for (auto &o: *last->output())
+                    fused->pickOutput(o.first, o.second);
+
+                const bool activated = activation != GemmEpilogue::NONE;
+
+                graph->replaceNode(last, fused);
+                if (norm != nullptr && norm != last)
+                    graph->removeNode(norm);
+                if (node != last)
+                    graph->removeNode(node);
+
+                _fused++;
+                if (norm != nullptr)
+                    _folded++;
+                if (activated)
+                    _activations++;
+            }
+
+            nd4j_debug("ConvFusion: %i convolution chains fused, %i batchnorms folded, %i activations fused\n", _fused, _folded, _activations);
+
+            return _fused;
+        }
+    }
+}
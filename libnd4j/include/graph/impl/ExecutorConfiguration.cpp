@@ -48,6 +48,12 @@ namespace sd {
             clone->_direction = _direction;
             clone->_footprintForward = _footprintForward;
             clone->_footprintBackward = _footprintBackward;
+            clone->_fp32Accumulation = _fp32Accumulation;
+            clone->_outputViews = _outputViews;
+            clone->_inplacePlanning = _inplacePlanning;
+            clone->_rematerialization = _rematerialization;
+            clone->_rematerializationBudget = _rematerializationBudget;
+            clone->_activationCompression = _activationCompression;
 
             return clone;
         };
@@ -103,6 +103,12 @@ namespace sd {
         }
 
         flatbuffers::Offset<FlatArray> FlatUtils::toFlatArray(flatbuffers::FlatBufferBuilder &builder, NDArray &array) {
+            // data of strided views is compacted, so shape info has to describe compacted copy as well
+            if (!array.isS() && (array.isView() || array.ews() != 1)) {
+                auto compact = array.dup(array.ordering());
+                return toFlatArray(builder, compact);
+            }
+
             auto byteVector = array.asByteVector();
 
             auto fBuffer = builder.CreateVector(byteVector);
@@ -0,0 +1,200 @@
+/*******************************************************************************
+ * Copyright (c) 2020 Konduit K.K.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#include <graph/GemmFusion.h>
+#include <helpers/GemmEpilogue.h>
+#include <ops/declarable/OpRegistrator.h>
+#include <helpers/logger.h>
+#include <map>
+#include <set>
+
+namespace sd {
+    namespace graph {
+        static std::string opName(Node* node) {
+            if (node->opType() != OpType_CUSTOM || !node->hasCustomOp())
+                return std::string();
+
+            return *node->getCustomOp()->getOpName();
+        }
+
+        int GemmFusion::fusedChains() {
+            return _fused;
+        }
+
+        int GemmFusion::fusedActivations() {
+            return _activations;
+        }
+
+        int GemmFusion::apply(Graph* graph) {
+            _fused = 0;
+            _activations = 0;
+
+            if (!graph->built())
+                graph->buildGraph();
+
+            if (!graph->scopes()->empty()) {
+                nd4j_printf("GemmFusion: graphs with scopes aren't supported, skipping\n", "");
+                return 0;
+            }
+
+            auto onion = graph->getOnion();
+            auto variableSpace = graph->getVariableSpace();
+
+            // node ids in execution order, nodes themselves might be replaced on the way
+            std::vector<int> order;
+            for (int l = 0; l < (int) onion->size(); l++) {
+                if (onion->count(l) == 0)
+                    continue;
+
+                for (auto node: *onion->at(l)) {
+                    if (node->opType() == OpType_LOGIC) {
+                        nd4j_printf("GemmFusion: graphs with logic ops aren't supported, skipping\n", "");
+                        return 0;
+                    }
+
+                    order.emplace_back(node->id());
+                }
+            }
+
+            std::set<int> outputs(graph->output()->begin(), graph->output()->end());
+            outputs.insert(graph->autos()->begin(), graph->autos()->end());
+
+            std::map<int, std::vector<int>> consumers;
+            for (auto id: order)
+                for (auto &p: *graph->nodeById(id)->input())
+                    consumers[p.first].emplace_back(id);
+
+            // ranks of node outputs, as far as they can be derived without execution
+            std::map<int, int> ranks;
+
+            auto rankOf = [&](const std::pair<int, int>& p) -> int {
+                if (graph->hasNode(p.first))
+                    return ranks.count(p.first) > 0 ? ranks.at(p.first) : -1;
+
+                if (!variableSpace->hasVariable(p.first, p.second))
+                    return -1;
+
+                auto var = variableSpace->getVariable(p.first, p.second);
+                if (var->hasNDArray())
+                    return var->getNDArray()->rankOf();
+
+                return var->shape().empty() ? -1 : (int) var->shape().size();
+            };
+
+            // returns the only consumer of the node, if it's allowed to be fused into the chain
+            auto soleConsumer = [&](int id) -> Node* {
+                if (outputs.count(id) > 0 || consumers.count(id) == 0 || consumers.at(id).size() != 1)
+                    return nullptr;
+
+                auto next = graph->nodeById(consumers.at(id).front());
+                return next->input()->at(0) == std::pair<int, int>(id, 0) ? next : nullptr;
+            };
+
+            auto xwPlusB = sd::ops::OpRegistrator::getInstance().getOperation("xw_plus_b");
+
+            for (auto id: order) {
+                if (!graph->hasNode(id))
+                    continue;
+
+                auto node = graph->nodeById(id);
+                auto name = opName(node);
+                auto inputs = node->input();
+
+                if (name == "xw_plus_b" || name == "relu_layer") {
+                    ranks[id] = 2;
+                    continue;
+                }
+
+                if (name == "biasadd" || name == "relu" || name == "tanh" || name == "sigmoid" || name == "identity") {
+                    if (!inputs->empty())
+                        ranks[id] = rankOf(inputs->at(0));
+                    continue;
+                }
+
+                if (name != "matmul" || inputs->size() != 2)
+                    continue;
+
+                auto block = node->getContextPrototype();
+                auto iArgs = block->getIArguments();
+                auto tArgs = block->getTArguments();
+
+                const int transX = iArgs->size() > 0 ? iArgs->at(0) : 0;
+                const int transY = iArgs->size() > 1 ? iArgs->at(1) : 0;
+                const int transZ = iArgs->size() > 2 ? iArgs->at(2) : 0;
+                const double alpha = tArgs->size() > 0 ? tArgs->at(0) : 1.0;
+                const double beta = tArgs->size() > 1 ? tArgs->at(1) : 0.0;
+
+                const bool matrices = rankOf(inputs->at(0)) == 2 && rankOf(inputs->at(1)) == 2;
+                if (matrices)
+                    ranks[id] = 2;
+
+                if (!matrices || transX != 0 || transZ != 0 || alpha != 1.0 || beta != 0.0)
+                    continue;
+
+                auto bias = soleConsumer(id);
+                if (bias == nullptr || opName(bias) != "biasadd" || bias->input()->size() != 2 || rankOf(bias->input()->at(1)) > 1)
+                    continue;
+
+                auto last = bias;
+                auto activation = GemmEpilogue::NONE;
+                double cutoff = 0.0;
+
+                auto act = soleConsumer(bias->id());
+                if (act != nullptr && act->input()->size() == 1) {
+                    auto actName = opName(act);
+                    if (actName == "relu") {
+                        activation = GemmEpilogue::RELU;
+                        auto actT = act->getContextPrototype()->getTArguments();
+                        cutoff = actT->empty() ? 0.0 : actT->at(0);
+                    } else if (actName == "tanh")
+                        activation = GemmEpilogue::TANH;
+                    else if (actName == "sigmoid")
+                        activation = GemmEpilogue::SIGMOID;
+
+                    if (activation != GemmEpilogue::NONE)
+                        last = act;
+                }
+
+                auto fused = new Node(xwPlusB, last->id(), {}, {}, {}, 0.0f, {cutoff}, {transY, static_cast<int>(activation)});
+                if (last->getName() != nullptr)
+                    fused->setName(*last->getName());
+
+                fused->pickInput(inputs->at(0).first, inputs->at(0).second);
+                fused->pickInput(inputs->at(1).first, inputs->at(1).second);
+                fused->pickInput(bias->input()->at(1).first, bias->input()->at(1).second);
+
+                for (auto &o: *last->output())
+                    fused->pickOutput(o.first, o.second);
+
+                const int lastId = last->id();
+
+                graph->replaceNode(last, fused);
+                if (last != bias)
+                    graph->removeNode(bias);
+                graph->removeNode(node);
+
+                ranks[lastId] = 2;
+                _fused++;
+                if (activation != GemmEpilogue::NONE)
+                    _activations++;
+            }
+
+            nd4j_debug("GemmFusion: %i GEMM chains fused, %i of them with activation\n", _fused, _activations);
+
+            return _fused;
+        }
+    }
+}
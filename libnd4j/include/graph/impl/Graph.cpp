@@ -24,6 +24,7 @@
 #include <graph/FlatUtils.h>
 #include <legacy/NativeOps.h>
 #include <vector>
+#include <algorithm>
 #include <helpers/ShapeUtils.h>
 #include <ops/declarable/OpRegistrator.h>
 #include <graph/VariableProxy.h>
@@ -306,6 +307,84 @@ namespace sd {
             delete _configuration;
         }
 
+        void Graph::insertNode(Node *node, Node *before) {
+            if (before == nullptr || _mapped->count(before->id()) == 0)
+                throw std::runtime_error("Graph::insertNode: anchor node should be mapped already");
+
+            if (_mapped->count(node->id()) > 0 || _variableSpace->hasVariable(node->id()))
+                throw std::runtime_error("Graph::insertNode: node id is already in use");
+
+            auto cname = node->getName() == nullptr ? nullptr : node->getName()->c_str();
+            _variableSpace->putVariable(node->id(), new Variable(nullptr, cname, node->id()));
+
+            attachContext(node);
+
+            _handles.push_back(node);
+            _nodes->emplace_back(node->id());
+
+            // executioner walks layers in order, so position within the layer is enough here
+            node->setLayer(before->getLayer());
+            auto layer = _onion->at(before->getLayer());
+            layer->insert(std::find(layer->begin(), layer->end(), before), node);
+
+            std::pair<int, Node *> pair(node->id(), node);
+            _mapped->insert(pair);
+        }
+
+        void Graph::attachContext(Node *node) {
+            if (!node->hasCustomOp())
+                return;
+
+            ContextPrototype* block = nullptr;
+
+            if (!node->hasBlockAttached()) {
+                block = new ContextPrototype(node->getCustomOp()->getOpDescriptor(), node->id());
+                node->setContextPrototype(block);
+            } else
+                block = node->getContextPrototype();
+
+            if (!block->hasVariablesFilled()) {
+                for (uint32_t e = 0; e < node->input()->size(); e++) {
+                    auto p = node->input()->at(e);
+
+                    block->pickInput(p);
+                }
+            }
+        }
+
+        void Graph::replaceNode(Node *node, Node *replacement) {
+            if (node == nullptr || _mapped->count(node->id()) == 0 || _mapped->at(node->id()) != node)
+                throw std::runtime_error("Graph::replaceNode: node should be mapped already");
+
+            if (replacement == nullptr || replacement->id() != node->id())
+                throw std::runtime_error("Graph::replaceNode: replacement should have the same id");
+
+            attachContext(replacement);
+
+            replacement->setLayer(node->getLayer());
+            auto layer = _onion->at(node->getLayer());
+            std::replace(layer->begin(), layer->end(), node, replacement);
+            std::replace(_handles.begin(), _handles.end(), node, replacement);
+
+            (*_mapped)[node->id()] = replacement;
+
+            delete node;
+        }
+
+        void Graph::removeNode(Node *node) {
+            if (node == nullptr || _mapped->count(node->id()) == 0 || _mapped->at(node->id()) != node)
+                throw std::runtime_error("Graph::removeNode: node should be mapped already");
+
+            auto layer = _onion->at(node->getLayer());
+            layer->erase(std::remove(layer->begin(), layer->end(), node), layer->end());
+            _handles.erase(std::remove(_handles.begin(), _handles.end(), node), _handles.end());
+            _nodes->erase(std::remove(_nodes->begin(), _nodes->end(), node->id()), _nodes->end());
+
+            _mapped->erase(node->id());
+
+            delete node;
+        }
+
         void Graph::addNode(Node *node) {
             _built.store(false);
 
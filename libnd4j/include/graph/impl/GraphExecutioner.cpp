@@ -31,6 +31,10 @@
 #include <graph/Scope.h>
 #include <graph/GraphExecutioner.h>
 #include <graph/TimeHolder.h>
+#include <graph/OutputAliasing.h>
+#include <graph/InplacePlanner.h>
+#include <graph/Rematerialization.h>
+#include <graph/ActivationCompression.h>
 #include <loops/scalar.h>
 #include <loops/pairwise_transform.h>
 #include <loops/transform_same.h>
@@ -50,11 +54,13 @@
 #include <helpers/ShapeUtils.h>
 #include <graph/Status.h>
 #include <deque>
+#include <memory>
 #include <graph/ResultWrapper.h>
 #include <graph/ExecutionResult.h>
 #include <exceptions/graph_execution_exception.h>
 #include <exceptions/no_results_exception.h>
 #include <graph/FlatUtils.h>
+#include <helpers/MixedPrecision.h>
 
 namespace sd{
 namespace graph {
@@ -218,6 +224,24 @@ Nd4jStatus GraphExecutioner::execute(Graph *graph, VariableSpace* variableSpace)
     Nd4jLong tb0 = Environment::getInstance().isProfiling() ? GraphProfile::currentTime() : 0L;
     graph->buildGraph();
 
+    // graph might be modified between executions, so use analysis is repeated every time
+    // in-place nodes go first, since arrays they overwrite can't be aliased
+    if (graph->getExecutorConfiguration()->_inplacePlanning)
+        InplacePlanner::apply(graph);
+
+    if (graph->getExecutorConfiguration()->_outputViews)
+        OutputAliasing::apply(graph);
+
+    // checkpoints are chosen after in-place marks, since arrays shared by in-place nodes are never released
+    std::unique_ptr<Rematerialization> remat;
+    if (graph->getExecutorConfiguration()->_rematerialization)
+        remat.reset(new Rematerialization(graph, __variableSpace, flowPath->profile(), graph->getExecutorConfiguration()->_rematerializationBudget));
+
+    // recomputation reads checkpoints directly, so these modes don't mix
+    std::unique_ptr<ActivationCompression> compression;
+    if (remat == nullptr && graph->getExecutorConfiguration()->_activationCompression != ACTIVATION_COMPRESSION_NONE)
+        compression.reset(new ActivationCompression(graph, __variableSpace, flowPath->profile(), graph->getExecutorConfiguration()->_activationCompression));
+
     auto footprintForward = sd::memory::MemoryRegistrator::getInstance().getGraphMemoryFootprint(graph->hashCode());
     if (footprintForward > 0) {
         if (__variableSpace->launchContext()->getWorkspace() != nullptr) {
@@ -235,6 +259,9 @@ Nd4jStatus GraphExecutioner::execute(Graph *graph, VariableSpace* variableSpace)
 
     bool pe = graph->getExecutorConfiguration()->_executionMode == ExecutionMode_AUTO;
 
+    // graph-wide accumulation mode, individual Contexts can only enable it
+    MixedPrecisionScope precision(graph->getExecutorConfiguration()->_fp32Accumulation || MixedPrecision::isFp32Accumulation());
+
 
     // basically if at some point code diverges, code branch might be _DISABLED_, and all nodes within that branch will be disabled as well
 
@@ -432,7 +459,18 @@ Nd4jStatus GraphExecutioner::execute(Graph *graph, VariableSpace* variableSpace)
                 if (status != Status::OK())
                     return status;
             } else {
+                // released inputs of backward nodes are recomputed or decompressed first, and this time isn't attributed to the node
+                if (remat != nullptr) {
+                    auto status = remat->prepare(node);
+                    if (status != Status::OK())
+                        return status;
+                }
 
+                if (compression != nullptr) {
+                    auto status = compression->prepare(node);
+                    if (status != Status::OK())
+                        return status;
+                }
 
                 auto timeStart = std::chrono::system_clock::now();
 
@@ -449,6 +487,12 @@ Nd4jStatus GraphExecutioner::execute(Graph *graph, VariableSpace* variableSpace)
                 if (status != ND4J_STATUS_OK)
                     return status;
 
+                if (remat != nullptr)
+                    remat->release(node);
+
+                if (compression != nullptr)
+                    compression->release(node);
+
 
                 // here we should handle divergent ops, and disable nodes accordingly
                 if (node->isDivergencePoint()) {
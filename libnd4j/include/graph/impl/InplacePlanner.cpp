@@ -0,0 +1,115 @@
+/*******************************************************************************
+ * Copyright (c) 2020 Konduit K.K.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#include <graph/InplacePlanner.h>
+#include <map>
+#include <set>
+#include <vector>
+
+namespace sd {
+    namespace graph {
+        // legacy elementwise ops are executed in-place by design, even though their descriptors don't say so
+        static bool isElementwise(OpType opType) {
+            switch (opType) {
+                case OpType_TRANSFORM_SAME:
+                case OpType_TRANSFORM_FLOAT:
+                case OpType_TRANSFORM_STRICT:
+                case OpType_SCALAR:
+                case OpType_PAIRWISE:
+                case OpType_BROADCAST:
+                    return true;
+                default:
+                    return false;
+            }
+        }
+
+        int InplacePlanner::apply(Graph* graph) {
+            if (!graph->built())
+                graph->buildGraph();
+
+            // marks of previous call might be outdated
+            for (auto &v: *graph->getMapped()) {
+                auto proto = v.second->getContextPrototype();
+                if (proto != nullptr && proto->isInplacePlanned()) {
+                    v.second->markInplace(false);
+                    proto->setInplacePlanned(false);
+                }
+            }
+
+            if (!graph->scopes()->empty())
+                return 0;
+
+            auto onion = graph->getOnion();
+
+            // nodes in execution order
+            std::vector<Node*> order;
+            for (int l = 0; l < (int) onion->size(); l++) {
+                if (onion->count(l) == 0)
+                    continue;
+
+                for (auto node: *onion->at(l)) {
+                    if (node->opType() == OpType_LOGIC)
+                        return 0;
+
+                    order.emplace_back(node);
+                }
+            }
+
+            // number of uses of each array, input used twice by the same node counts twice
+            std::map<std::pair<int, int>, int> references;
+            for (auto node: order)
+                for (auto &p: *node->input())
+                    references[p]++;
+
+            // results of the graph, all nodes in VARIABLE_SPACE output mode
+            std::set<int> outputs(graph->output()->begin(), graph->output()->end());
+
+            int cnt = 0;
+            for (auto node: order) {
+                auto proto = node->getContextPrototype();
+
+                // nodes marked in-place explicitly are left as is
+                if (!node->hasCustomOp() || proto == nullptr || proto->isInplace())
+                    continue;
+
+                auto descriptor = node->getCustomOp()->getOpDescriptor();
+                auto numOutputs = descriptor->getNumberOfOutputs();
+                auto inputs = node->input();
+
+                if (!(descriptor->allowsInplace() || isElementwise(node->opType())) || descriptor->isDivergent() || numOutputs < 1 || numOutputs > (int) inputs->size())
+                    continue;
+
+                // inputs [0, numOutputs) are overwritten, so they must be last uses of other nodes outputs
+                bool lastUse = true;
+                for (int e = 0; e < numOutputs && lastUse; e++) {
+                    auto &p = inputs->at(e);
+
+                    if (!graph->hasNode(p.first) || references[p] != 1 || outputs.count(p.first) > 0)
+                        lastUse = false;
+                }
+
+                if (!lastUse)
+                    continue;
+
+                node->markInplace(true);
+                proto->setInplacePlanned(true);
+                cnt++;
+            }
+
+            return cnt;
+        }
+    }
+}
@@ -0,0 +1,104 @@
+/*******************************************************************************
+ * Copyright (c) 2020 Konduit K.K.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#include <graph/OutputAliasing.h>
+#include <set>
+#include <vector>
+
+namespace sd {
+    namespace graph {
+        void OutputAliasing::reset(Graph* graph) {
+            for (auto &v: *graph->getMapped())
+                if (v.second->getContextPrototype() != nullptr)
+                    v.second->getContextPrototype()->setOutputViews(false);
+        }
+
+        int OutputAliasing::apply(Graph* graph) {
+            if (!graph->built())
+                graph->buildGraph();
+
+            reset(graph);
+
+            if (!graph->scopes()->empty())
+                return 0;
+
+            auto onion = graph->getOnion();
+
+            // nodes in execution order
+            std::vector<Node*> order;
+            for (int l = 0; l < (int) onion->size(); l++) {
+                if (onion->count(l) == 0)
+                    continue;
+
+                for (auto node: *onion->at(l)) {
+                    if (node->opType() == OpType_LOGIC)
+                        return 0;
+
+                    order.emplace_back(node);
+                }
+            }
+
+            // outputs of the Graph are consumed outside (i.e. exported via FlatUtils), so they're always materialized
+            std::set<int> outputs(graph->output()->begin(), graph->output()->end());
+
+            // nodes that could return views, if nothing they alias gets modified
+            std::set<int> candidates;
+            for (auto node: order)
+                if (outputs.count(node->id()) == 0 && node->opType() == OpType_CUSTOM && node->hasCustomOp() && !node->isInplace() && node->getContextPrototype() != nullptr && node->getCustomOp()->getOpDescriptor()->allowsOutputViews())
+                    candidates.insert(node->id());
+
+            if (candidates.empty())
+                return 0;
+
+            // arrays modified by in-place nodes. output of a candidate might be a view, so its inputs are modified as well
+            std::set<std::pair<int, int>> modified;
+            std::vector<std::pair<int, int>> queue;
+            for (auto node: order)
+                if (node->isInplace())
+                    for (auto &p: *node->input())
+                        queue.emplace_back(p);
+
+            while (!queue.empty()) {
+                auto p = queue.back();
+                queue.pop_back();
+
+                if (!modified.insert(p).second || candidates.count(p.first) == 0)
+                    continue;
+
+                for (auto &q: *graph->getMapped()->at(p.first)->input())
+                    queue.emplace_back(q);
+            }
+
+            int cnt = 0;
+            for (auto node: order) {
+                if (candidates.count(node->id()) == 0)
+                    continue;
+
+                bool views = true;
+                for (auto &p: *node->input())
+                    if (modified.count(p) > 0)
+                        views = false;
+
+                if (views) {
+                    node->getContextPrototype()->setOutputViews(true);
+                    cnt++;
+                }
+            }
+
+            return cnt;
+        }
+    }
+}
@@ -0,0 +1,228 @@
+/*******************************************************************************
+ * Copyright (c) 2020 Konduit K.K.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+#include <graph/Rematerialization.h>
+#include <graph/GraphExecutioner.h>
+#include <cmath>
+
+namespace sd {
+    namespace graph {
+        bool Rematerialization::isBackward(Node* node) {
+            if (!node->hasCustomOp())
+                return false;
+
+            auto name = node->getCustomOp()->getOpName();
+            return name != nullptr && name->size() > 3 && name->compare(name->size() - 3, 3, "_bp") == 0;
+        }
+
+        Rematerialization::Rematerialization(Graph* graph, VariableSpace* variableSpace, GraphProfile* profile, Nd4jLong budget) {
+            _graph = graph;
+            _variableSpace = variableSpace;
+            _profile = profile;
+            _budget = budget;
+
+            if (!graph->built())
+                graph->buildGraph();
+
+            if (!graph->scopes()->empty())
+                return;
+
+            auto onion = graph->getOnion();
+            for (int l = 0; l < (int) onion->size(); l++) {
+                if (onion->count(l) == 0)
+                    continue;
+
+                for (auto node: *onion->at(l)) {
+                    if (node->opType() == OpType_LOGIC)
+                        return;
+
+                    if (_backward < 0 && isBackward(node))
+                        _backward = (int) _order.size();
+
+                    _positions[node->id()] = (int) _order.size();
+                    _order.emplace_back(node);
+                }
+            }
+
+            // forward-only graph, nothing is ever recomputed
+            if (_backward <= 0) {
+                _backward = -1;
+                return;
+            }
+
+            std::set<int> outputs(graph->output()->begin(), graph->output()->end());
+            std::set<int> pinned;
+
+            std::map<std::pair<int, int>, int> lastForwardUse;
+            for (int e = 0; e < (int) _order.size(); e++) {
+                auto node = _order[e];
+                auto proto = node->getContextPrototype();
+
+                // in-place outputs share arrays with inputs, and random ops can't be reproduced
+                if ((proto != nullptr && proto->isInplace()) || node->opType() == OpType_RANDOM) {
+                    pinned.insert(node->id());
+
+                    for (auto &p: *node->input())
+                        pinned.insert(p.first);
+                }
+
+                for (auto &p: *node->input()) {
+                    if (!graph->hasNode(p.first) || _positions[p.first] >= _backward)
+                        continue;
+
+                    _lastUse[p] = e;
+                    if (e < _backward)
+                        lastForwardUse[p] = e;
+                    else if (lastForwardUse.count(p) == 0)
+                        lastForwardUse[p] = _positions[p.first];
+                }
+            }
+
+            for (auto &v: lastForwardUse)
+                _releases[v.second].emplace_back(v.first);
+
+            for (int e = 0; e < _backward; e++) {
+                auto id = _order[e]->id();
+                if (outputs.count(id) == 0 && pinned.count(id) == 0)
+                    _candidates.insert(id);
+            }
+
+            if (_budget > 0)
+                return;
+
+            // sqrt(N) segments
+            auto step = (int) std::ceil(std::sqrt((double) _backward));
+            for (int e = step - 1; e < _backward; e += step) {
+                auto id = _order[e]->id();
+                if (_candidates.count(id) > 0) {
+                    _candidates.erase(id);
+                    _checkpoints.insert(id);
+                }
+            }
+        }
+
+        bool Rematerialization::isActive() const {
+            return _backward > 0 && !_candidates.empty();
+        }
+
+        const std::set<int>& Rematerialization::checkpoints() const {
+            return _checkpoints;
+        }
+
+        bool Rematerialization::isAvailable(const std::pair<int, int> &pair) {
+            std::pair<int, int> p(pair);
+            return _variableSpace->hasVariable(p) && _variableSpace->getVariable(p)->hasNDArray();
+        }
+
+        void Rematerialization::release(const std::pair<int, int> &pair) {
+            std::pair<int, int> p(pair);
+            if (!_variableSpace->hasVariable(p))
+                return;
+
+            auto var = _variableSpace->getVariable(p);
+            if (var->variableType() != VariableType::NDARRAY || !var->hasNDArray() || !var->isRemovable() || var->isReadOnly() || var->isPersistent())
+                return;
+
+            auto array = var->getNDArray();
+
+            // views don't own their buffers
+            if (!array->isView())
+                _profile->addToRematerialized(array->getDataBuffer()->getLenInBytes());
+
+            var->setNDArray(nullptr);
+            delete array;
+        }
+
+        Nd4jStatus Rematerialization::recompute(Node* node) {
+            for (auto &p: *node->input()) {
+                if (_candidates.count(p.first) == 0 || isAvailable(p))
+                    continue;
+
+                auto status = recompute(_graph->nodeById(p.first));
+                if (status != Status::OK())
+                    return status;
+            }
+
+            nd4j_debug("Recomputing Node_%i\n", node->id());
+
+            auto timeStart = GraphProfile::currentTime();
+            auto status = GraphExecutioner::executeFlatNode(_graph, node, _variableSpace);
+            _profile->addToRecomputation(GraphProfile::relativeTime(timeStart));
+
+            if (status != Status::OK())
+                return status;
+
+            for (auto it = _lastUse.lower_bound(std::pair<int, int>(node->id(), 0)); it != _lastUse.end() && it->first.first == node->id(); ++it)
+                _recomputed.insert(it->first);
+
+            return Status::OK();
+        }
+
+        Nd4jStatus Rematerialization::prepare(Node* node) {
+            if (!isActive() || _positions[node->id()] < _backward)
+                return Status::OK();
+
+            for (auto &p: *node->input()) {
+                if (_candidates.count(p.first) == 0 || isAvailable(p))
+                    continue;
+
+                auto status = recompute(_graph->nodeById(p.first));
+                if (status != Status::OK())
+                    return status;
+            }
+
+            return Status::OK();
+        }
+
+        void Rematerialization::release(Node* node) {
+            if (!isActive())
+                return;
+
+            auto e = _positions[node->id()];
+
+            if (e < _backward) {
+                // greedy checkpoint choice, output sizes are known only now
+                if (_budget > 0 && _candidates.count(node->id()) > 0) {
+                    for (int i = 0; _variableSpace->hasVariable(node->id(), i); i++) {
+                        auto var = _variableSpace->getVariable(node->id(), i);
+                        if (var->variableType() == VariableType::NDARRAY && var->hasNDArray() && !var->getNDArray()->isView())
+                            _segment += var->getNDArray()->getDataBuffer()->getLenInBytes();
+                    }
+
+                    if (_segment > _budget) {
+                        _candidates.erase(node->id());
+                        _checkpoints.insert(node->id());
+                        _segment = 0L;
+                    }
+                }
+
+                if (_releases.count(e) > 0)
+                    for (auto &p: _releases[e])
+                        if (_candidates.count(p.first) > 0)
+                            release(p);
+            } else {
+                for (auto it = _recomputed.begin(); it != _recomputed.end(); ) {
+                    if (_lastUse[*it] <= e) {
+                        release(*it);
+                        it = _recomputed.erase(it);
+                    } else
+                        ++it;
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,188 @@
+/*******************************************************************************
+ * Copyright (c) 2020 Konduit K.K.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+#include <graph/StreamingSession.h>
+#include <graph/GraphExecutioner.h>
+#include <stdexcept>
+
+namespace sd {
+    namespace graph {
+        StreamingSession::StreamingSession(Graph* graph, VariableSpace* variableSpace) {
+            _graph = graph;
+            _variableSpace = variableSpace == nullptr ? graph->getVariableSpace() : variableSpace;
+        }
+
+        void StreamingSession::bind(int stateId, const std::pair<int, int>& source, bool lastStep, int timeAxis, const NDArray* initial) {
+            std::pair<int, int> pair(stateId, 0);
+
+            if (stateId >= 0 || !_variableSpace->hasVariable(pair))
+                throw std::runtime_error("StreamingSession: state should be existing variable of the Graph");
+
+            if (!_graph->hasNode(source.first))
+                throw std::runtime_error("StreamingSession: state source should be output of the Graph node");
+
+            for (auto &s: _states)
+                if (s.state == pair)
+                    throw std::runtime_error("StreamingSession: state variable is bound already");
+
+            auto var = _variableSpace->getVariable(pair);
+            if (initial == nullptr && !var->hasNDArray())
+                throw std::runtime_error("StreamingSession: state variable has no array, initial state should be provided");
+
+            // states are swapped with node outputs, so session keeps its own copy unless array is owned by VariableSpace already
+            if (initial != nullptr || !var->isRemovable() || var->isReadOnly()) {
+                auto array = new NDArray(initial != nullptr ? initial->dup() : var->getNDArray()->dup());
+
+                if (var->hasNDArray() && var->isRemovable() && !var->isReadOnly())
+                    delete var->getNDArray();
+
+                var->setNDArray(array);
+                var->markRemovable(true);
+                var->markReadOnly(false);
+            }
+
+            _variableSpace->markPersistent(pair);
+
+            StateBinding binding;
+            binding.state = pair;
+            binding.source = source;
+            binding.lastStep = lastStep;
+            binding.timeAxis = timeAxis;
+            binding.initial = var->getNDArray()->dup();
+
+            _states.emplace_back(binding);
+        }
+
+        void StreamingSession::bindState(int stateId, const std::pair<int, int>& source, const NDArray* initial) {
+            bind(stateId, source, false, 0, initial);
+        }
+
+        void StreamingSession::bindStateToLastStep(int stateId, const std::pair<int, int>& source, int timeAxis, const NDArray* initial) {
+            bind(stateId, source, true, timeAxis, initial);
+        }
+
+        void StreamingSession::commitStates() {
+            if (!_pending)
+                return;
+
+            for (auto &s: _states) {
+                auto source = s.source;
+                if (!_variableSpace->hasVariable(source) || !_variableSpace->getVariable(source)->hasNDArray())
+                    throw std::runtime_error("StreamingSession: state source wasn't produced by the Graph");
+
+                auto stateVar = _variableSpace->getVariable(s.state);
+                auto sourceVar = _variableSpace->getVariable(source);
+                auto state = stateVar->getNDArray();
+                auto output = sourceVar->getNDArray();
+
+                if (s.lastStep) {
+                    const int axis = s.timeAxis < 0 ? s.timeAxis + output->rankOf() : s.timeAxis;
+                    if (axis < 0 || axis >= output->rankOf())
+                        throw std::runtime_error("StreamingSession: time axis is out of rank of state source");
+
+                    std::vector<Nd4jLong> idx(2 * output->rankOf(), 0);
+                    idx[2 * axis] = output->sizeAt(axis) - 1;
+                    idx[2 * axis + 1] = output->sizeAt(axis);
+
+                    // unit dims are kept, so only time axis is dropped from shape of last step (bS or nOut may be 1)
+                    auto last = (*output)(idx, true);
+                    auto shape = last.getShapeAsVector();
+                    shape.erase(shape.begin() + axis);
+                    if (shape != state->getShapeAsVector())
+                        throw std::runtime_error("StreamingSession: last step of state source doesn't match state shape");
+
+                    state->assign(last.reshape(state->ordering(), shape, false));
+                } else if (sourceVar->isRemovable() && !sourceVar->isReadOnly() && output->isSameShape(state) && output->dataType() == state->dataType()) {
+                    // final state becomes initial one, and buffer of previous state receives next final state
+                    stateVar->setNDArray(output);
+                    sourceVar->setNDArray(state);
+                } else {
+                    if (!output->isSameShape(state))
+                        throw std::runtime_error("StreamingSession: state source doesn't match state shape");
+
+                    state->assign(output);
+                }
+            }
+
+            _pending = false;
+        }
+
+        Nd4jStatus StreamingSession::execute(const std::map<int, NDArray*>& inputs) {
+            commitStates();
+
+            bool reshaped = false;
+            for (auto &i: inputs) {
+                std::pair<int, int> pair(i.first, 0);
+                if (!_variableSpace->hasVariable(pair))
+                    throw std::runtime_error("StreamingSession: input variable doesn't exist");
+
+                auto var = _variableSpace->getVariable(pair);
+                if (var->isPersistent())
+                    throw std::runtime_error("StreamingSession: state variables can't be fed, use reset() instead");
+
+                auto shape = i.second->getShapeAsVector();
+                auto it = _shapes.find(i.first);
+                if (it == _shapes.end() || it->second != shape) {
+                    _shapes[i.first] = shape;
+                    reshaped = true;
+                }
+
+                if (var->hasNDArray() && var->getNDArray() != i.second && var->isRemovable() && !var->isReadOnly())
+                    delete var->getNDArray();
+
+                var->setNDArray(i.second);
+                var->markRemovable(false);
+            }
+
+            // outputs allocated for chunks of other shape can't be reused
+            if (reshaped) {
+                auto dropped = _variableSpace->dropTransientArrays();
+                nd4j_debug("StreamingSession: chunk shape changed, %i arrays dropped\n", dropped);
+            }
+
+            auto status = GraphExecutioner::execute(_graph, _variableSpace);
+            if (status != Status::OK())
+                return status;
+
+            _pending = true;
+            _chunks++;
+
+            return status;
+        }
+
+        NDArray* StreamingSession::state(int stateId) {
+            commitStates();
+
+            for (auto &s: _states)
+                if (s.state.first == stateId)
+                    return _variableSpace->getVariable(s.state)->getNDArray();
+
+            throw std::runtime_error("StreamingSession: variable isn't bound as state");
+        }
+
+        void StreamingSession::reset() {
+            _pending = false;
+
+            for (auto &s: _states)
+                _variableSpace->getVariable(s.state)->getNDArray()->assign(s.initial);
+        }
+
+        Nd4jLong StreamingSession::chunks() {
+            return _chunks;
+        }
+    }
+}
@@ -36,6 +36,7 @@ namespace sd {
             result->markExternal(this->_external);
             result->setId(this->_id);
             result->markReadOnly(this->_readOnly);
+            result->markPersistent(this->_persistent);
             result->setName(&this->_name);
             result->setIndex(this->_index);
 
@@ -57,6 +58,7 @@ namespace sd {
             result->_external = this->_external;
             result->_id = this->_id;
             result->_readOnly = this->_readOnly;
+            result->_persistent = this->_persistent;
             result->_name = this->_name;
             result->_index = this->_index;
 
@@ -143,6 +145,10 @@ namespace sd {
             this->_readOnly = reallyReadOnly;
         }
 
+        void sd::graph::Variable::markPersistent(bool reallyPersistent) {
+            this->_persistent = reallyPersistent;
+        }
+
         sd::NDArray * sd::graph::Variable::getNDArray() {
             if (_variableType != VariableType::NDARRAY) {
                 nd4j_printf("Variable[%i:%i/<%s>] is has [%s] type, but NDArray was requested\n", this->_id, this->_index, this->_name.c_str(), EnumUtils::_VariableTypeToString(_variableType));
@@ -174,6 +180,10 @@ namespace sd {
             return _removable;
         }
 
+        bool Variable::isPersistent() {
+            return _persistent;
+        }
+
 
         void sd::graph::Variable::setNDArrayList(sd::NDArrayList * list) {
             this->_variableType = VariableType::ARRAY_LIST;
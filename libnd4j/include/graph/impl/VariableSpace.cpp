@@ -389,6 +389,35 @@ namespace sd {
             return *this;
         }
 
+        void VariableSpace::markPersistent(std::pair<int,int>& pair, bool persistent) {
+            if (!hasVariable(pair))
+                throw std::runtime_error("VariableSpace::markPersistent: variable doesn't exist");
+
+            getVariable(pair)->markPersistent(persistent);
+        }
+
+        int VariableSpace::dropTransientArrays() {
+            int cnt = 0;
+
+            for (auto &v: _paired) {
+                auto var = v.second;
+
+                // only node outputs are considered
+                if (v.first.first <= 0 || var->isPersistent() || var->variableType() != VariableType::NDARRAY || !var->hasNDArray())
+                    continue;
+
+                // arrays not owned by their variables (i.e. outputs of in-place nodes) are only detached
+                if (var->isRemovable() && !var->isReadOnly())
+                    delete var->getNDArray();
+
+                var->setNDArray(nullptr);
+                var->markRemovable(true);
+                cnt++;
+            }
+
+            return cnt;
+        }
+
         void VariableSpace::replaceVariable(Variable *variable) {
             bool replaced = false;
             // trying name first
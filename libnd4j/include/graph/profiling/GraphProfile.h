@@ -44,6 +44,18 @@ namespace sd {
             Nd4jLong _memoryTemporary = 0L;
             Nd4jLong _memoryObjects = 0L;
 
+            // memory not allocated due to in-place execution
+            Nd4jLong _memoryInplace = 0L;
+
+            // memory released by rematerialization, and price paid for it
+            Nd4jLong _memoryRematerialized = 0L;
+            Nd4jLong _recomputedNodes = 0L;
+            Nd4jLong _recomputationTime = 0L;
+
+            // memory saved by activation compression, and time spent on it
+            Nd4jLong _memoryCompressed = 0L;
+            Nd4jLong _compressionTime = 0L;
+
             // time spent for graph construction
             Nd4jLong _buildTime = 0L;
 
@@ -72,6 +84,34 @@ namespace sd {
             void addToActivations(Nd4jLong bytes);
             void addToTemporary(Nd4jLong bytes);
             void addToObjects(Nd4jLong bytes);
+            void addToInplace(Nd4jLong bytes);
+            void addToRematerialized(Nd4jLong bytes);
+
+            /**
+             * This method registers one node recomputed for backward pass, and time spent on it in nanoseconds
+             */
+            void addToRecomputation(Nd4jLong nanos);
+
+            void addToCompressed(Nd4jLong bytes);
+            void addToCompressionTime(Nd4jLong nanos);
+
+            /**
+             * This method returns number of bytes saved by planned in-place execution, see InplacePlanner
+             */
+            Nd4jLong inplaceBytes() const;
+
+            /**
+             * These methods return memory/time trade-off of gradient checkpointing, see Rematerialization
+             */
+            Nd4jLong rematerializedBytes() const;
+            Nd4jLong recomputedNodes() const;
+            Nd4jLong recomputationTime() const;
+
+            /**
+             * These methods return memory/time trade-off of activation compression, see ActivationCompression
+             */
+            Nd4jLong compressedBytes() const;
+            Nd4jLong compressionTime() const;
 
             /**
              * This method allows to set graph construction (i.e. deserialization) time in nanoseconds
@@ -106,6 +146,16 @@ namespace sd {
             void merge(GraphProfile *other);
             void assign(GraphProfile *other);
 
+            /**
+             * This method returns up to limit NodeProfiles, sorted by execution time in descending order
+             */
+            std::vector<NodeProfile*> hotSpots(int limit);
+
+            /**
+             * This method returns number of reports merged into this profile
+             */
+            Nd4jLong merges() const;
+
             /**
              * These methods are just utility methods for time
              */
@@ -23,6 +23,7 @@
 
 #include <system/pointercast.h>
 #include <system/dll.h>
+#include <helpers/HardwareCounters.h>
 #include <string>
 #include <vector>
 
@@ -67,6 +68,15 @@ namespace sd {
             // total amount of memory used during execution
             Nd4jLong _memoryTotal = 0L;
 
+            // estimated number of floating point operations
+            Nd4jLong _flops = 0L;
+
+            // amount of bytes read from inputs and written to outputs
+            Nd4jLong _bytesMoved = 0L;
+
+            // hardware counters, only available if HardwareCounters were enabled
+            CounterValues _counters;
+
             std::vector<std::string> _inputShapes;
             std::vector<std::string> _outputShapes;
         public:
@@ -88,6 +98,10 @@ namespace sd {
             void setObjectsSize(Nd4jLong bytes);
             void setTotalSize(Nd4jLong bytes);
 
+            void setFlops(Nd4jLong flops);
+            void setBytesMoved(Nd4jLong bytes);
+            void setCounters(const CounterValues &counters);
+
             void addInputShape(Nd4jLong const* shapeInfo);
             void addOutputShape(Nd4jLong const* shapeInfo);
 
@@ -98,6 +112,22 @@ namespace sd {
 
             Nd4jLong getExecutionTime() const;
 
+            Nd4jLong getFlops() const;
+            Nd4jLong getBytesMoved() const;
+            const CounterValues& getCounters() const;
+
+            /**
+             * This method returns execution time averaged over all merged reports
+             */
+            Nd4jLong getAverageExecutionTime() const;
+
+            /**
+             * This method returns hardware counters averaged over all merged reports
+             */
+            CounterValues getAverageCounters() const;
+
+            int id() const;
+
             std::string& name();
 
             void merge(NodeProfile *other);
@@ -0,0 +1,48 @@
+/*******************************************************************************
+ * Copyright (c) 2020 Konduit K.K.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#ifndef SD_OP_COST_H
+#define SD_OP_COST_H
+
+#include <array/NDArray.h>
+#include <system/dll.h>
+#include <string>
+#include <vector>
+
+namespace sd {
+    namespace graph {
+        /**
+         * This class provides rough cost estimates for op invocations, used for roofline reports in NodeProfile
+         */
+        class ND4J_EXPORT OpCost {
+        public:
+            /**
+             * This method returns estimated number of floating point operations for given op invocation.
+             *
+             * GEMM-like and convolution ops are estimated from their contraction size (1 FMA = 2 flops),
+             * data movement ops are 0, everything else is treated as 1 flop per element of its largest side.
+             */
+            static Nd4jLong flops(const std::string &opName, const std::vector<NDArray*> &inputs, const std::vector<NDArray*> &outputs, const std::vector<int> &iArgs);
+
+            /**
+             * This method returns number of bytes read from inputs plus number of bytes written to outputs
+             */
+            static Nd4jLong bytes(const std::vector<NDArray*> &inputs, const std::vector<NDArray*> &outputs);
+        };
+    }
+}
+
+#endif //SD_OP_COST_H
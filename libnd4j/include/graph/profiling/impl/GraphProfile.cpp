@@ -23,6 +23,7 @@
 #include <chrono>
 #include <math/templatemath.h>
 #include <algorithm>
+#include <helpers/HardwareCounters.h>
 
 namespace sd {
     namespace graph {
@@ -54,6 +55,51 @@ namespace sd {
             _memoryObjects += bytes;
         }
 
+        void GraphProfile::addToInplace(Nd4jLong bytes) {
+            _memoryInplace += bytes;
+        }
+
+        Nd4jLong GraphProfile::inplaceBytes() const {
+            return _memoryInplace;
+        }
+
+        void GraphProfile::addToRematerialized(Nd4jLong bytes) {
+            _memoryRematerialized += bytes;
+        }
+
+        void GraphProfile::addToRecomputation(Nd4jLong nanos) {
+            _recomputedNodes++;
+            _recomputationTime += nanos;
+        }
+
+        Nd4jLong GraphProfile::rematerializedBytes() const {
+            return _memoryRematerialized;
+        }
+
+        Nd4jLong GraphProfile::recomputedNodes() const {
+            return _recomputedNodes;
+        }
+
+        Nd4jLong GraphProfile::recomputationTime() const {
+            return _recomputationTime;
+        }
+
+        void GraphProfile::addToCompressed(Nd4jLong bytes) {
+            _memoryCompressed += bytes;
+        }
+
+        void GraphProfile::addToCompressionTime(Nd4jLong nanos) {
+            _compressionTime += nanos;
+        }
+
+        Nd4jLong GraphProfile::compressedBytes() const {
+            return _memoryCompressed;
+        }
+
+        Nd4jLong GraphProfile::compressionTime() const {
+            return _compressionTime;
+        }
+
         void GraphProfile::setBuildTime(Nd4jLong nanos) {
             _buildTime = nanos;
         }
@@ -128,6 +174,12 @@ namespace sd {
             _memoryTemporary += other->_memoryTemporary;
             _memoryTotal += other->_memoryTotal;
             _memoryObjects += other->_memoryObjects;
+            _memoryInplace += other->_memoryInplace;
+            _memoryRematerialized += other->_memoryRematerialized;
+            _recomputedNodes += other->_recomputedNodes;
+            _recomputationTime += other->_recomputationTime;
+            _memoryCompressed += other->_memoryCompressed;
+            _compressionTime += other->_compressionTime;
 
             _executionTime += other->_executionTime;
             _buildTime += other->_buildTime;
@@ -147,6 +199,12 @@ namespace sd {
             _memoryTemporary = other->_memoryTemporary;
             _memoryTotal = other->_memoryTotal;
             _memoryObjects = other->_memoryObjects;
+            _memoryInplace = other->_memoryInplace;
+            _memoryRematerialized = other->_memoryRematerialized;
+            _recomputedNodes = other->_recomputedNodes;
+            _recomputationTime = other->_recomputationTime;
+            _memoryCompressed = other->_memoryCompressed;
+            _compressionTime = other->_compressionTime;
 
             _executionTime = other->_executionTime;
             _buildTime = other->_buildTime;
@@ -157,6 +215,24 @@ namespace sd {
             }
         }
 
+        std::vector<NodeProfile*> GraphProfile::hotSpots(int limit) {
+            std::vector<NodeProfile*> sorted(_profiles);
+
+            // building hot spots
+            std::sort(sorted.begin(), sorted.end(), [](const NodeProfile *a, const NodeProfile *b) -> bool {
+                return a->getExecutionTime() > b->getExecutionTime();
+            });
+
+            if (limit >= 0 && sorted.size() > (size_t) limit)
+                sorted.resize(limit);
+
+            return sorted;
+        }
+
+        Nd4jLong GraphProfile::merges() const {
+            return _merges;
+        }
+
         bool GraphProfile::nodeExists(int id) {
             return _profilesById.count(id) > 0;
         }
@@ -177,33 +253,40 @@ namespace sd {
             }
 
             nd4j_printf("ACT: %lld; TMP: %lld; OBJ: %lld; TTL: %lld;\n", act / _merges, tmp / _merges, obj / _merges, ttl / _merges);
+            nd4j_printf("Saved by in-place execution: %lld;\n", _memoryInplace / _merges);
+            nd4j_printf("Released by rematerialization: %lld;\n", _memoryRematerialized / _merges);
+            nd4j_printf("Saved by activation compression: %lld;\n", _memoryCompressed / _merges);
 
             nd4j_printf("\nTime:\n", "");
             nd4j_printf("Construction time: %lld ns;\n", _buildTime / _merges);
             nd4j_printf("Execution time: %lld ns;\n", _executionTime / _merges);
+            nd4j_printf("Recomputation: %lld nodes, %lld ns;\n", _recomputedNodes / _merges, _recomputationTime / _merges);
+            nd4j_printf("Activation compression time: %lld ns;\n", _compressionTime / _merges);
+
+            Nd4jLong flops = 0L;
+            Nd4jLong bytes = 0L;
+            for (auto v: _profiles) {
+                flops += v->getFlops();
+                bytes += v->getBytesMoved();
+            }
+
+            if (_executionTime > 0)
+                nd4j_printf("Roofline: %.3f GFLOP/s; %.3f GB/s;\n", (double) flops / _executionTime, (double) bytes / _executionTime);
+
+            nd4j_printf("Hardware counters: %s;\n", HardwareCounters::getInstance().isEnabled() ? "enabled" : HardwareCounters::getInstance().isAvailable() ? "disabled" : "not available");
 
             nd4j_printf("\nPer-node reports:\n", "");
             if (_profiles.empty())
                 nd4j_printf("No nodes in graph\n","");
 
             // printint out stuff
-            std::vector<NodeProfile*> sorted;
-            for (auto v: _profiles) {
+            for (auto v: _profiles)
                 v->printOut();
-                sorted.emplace_back(v);
-            }
 
             if (_profiles.size() > 1) {
-                // building hot spots
-                std::sort(sorted.begin(), sorted.end(), [](const NodeProfile *a, const NodeProfile *b) -> bool {
-                    return a->getExecutionTime() > b->getExecutionTime();
-                });
-
                 nd4j_printf("\nTop 50 reports by EXEC:\n", "");
-                auto limit = sd::math::nd4j_min<int>(50, sorted.size());
-                for (int e = 0; e < limit; e++) {
-                    sorted[e]->printOut();
-                }
+                for (auto v: hotSpots(50))
+                    v->printOut();
             }
 
             nd4j_printf("\nSpecial timers:\n", "");
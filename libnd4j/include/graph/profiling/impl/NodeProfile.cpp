@@ -48,6 +48,30 @@ namespace sd {
                 outputs += v + "    ";
 
 
+            // roofline: achieved throughput vs arithmetic intensity
+            auto exec = _executionTime / _merges;
+            if (exec > 0 && (_flops > 0 || _bytesMoved > 0)) {
+                // ops per nanosecond is exactly GFLOP/s, bytes per nanosecond is GB/s
+                nd4j_printf("      Roofline: FLOPS: %lld; BYTES: %lld; AI: %.3f flop/byte; %.3f GFLOP/s; %.3f GB/s;\n",
+                            _flops / _merges, _bytesMoved / _merges,
+                            _bytesMoved > 0 ? (double) _flops / (double) _bytesMoved : 0.0,
+                            (double) (_flops / _merges) / exec, (double) (_bytesMoved / _merges) / exec);
+            }
+
+            if (_counters.hasValues()) {
+                auto cycles = _counters.cycles >= 0 ? _counters.cycles / _merges : -1L;
+                auto instructions = _counters.instructions >= 0 ? _counters.instructions / _merges : -1L;
+                auto misses = _counters.cacheMisses >= 0 ? _counters.cacheMisses / _merges : -1L;
+                auto references = _counters.cacheReferences >= 0 ? _counters.cacheReferences / _merges : -1L;
+
+                nd4j_printf("      Counters: CYCLES: %lld; INSTR: %lld; IPC: %.2f; CACHE REFS: %lld; CACHE MISSES: %lld;\n",
+                            cycles, instructions, cycles > 0 && instructions >= 0 ? (double) instructions / cycles : 0.0, references, misses);
+
+                // every LLC miss means one cache line pulled from memory
+                if (misses >= 0 && exec > 0)
+                    nd4j_printf("      Memory traffic estimate: %.3f GB/s;\n", (double) (misses * 64L) / exec);
+            }
+
             nd4j_printf("      Inputs: %s\n", inputs.c_str());
             nd4j_printf("      Outputs: %s\n", outputs.c_str());
         };
@@ -116,6 +140,47 @@ namespace sd {
             return _executionTime;
         }
 
+        void NodeProfile::setFlops(Nd4jLong flops) {
+            _flops = flops;
+        }
+
+        void NodeProfile::setBytesMoved(Nd4jLong bytes) {
+            _bytesMoved = bytes;
+        }
+
+        void NodeProfile::setCounters(const CounterValues &counters) {
+            _counters = counters;
+        }
+
+        Nd4jLong NodeProfile::getFlops() const {
+            return _flops;
+        }
+
+        Nd4jLong NodeProfile::getBytesMoved() const {
+            return _bytesMoved;
+        }
+
+        const CounterValues& NodeProfile::getCounters() const {
+            return _counters;
+        }
+
+        Nd4jLong NodeProfile::getAverageExecutionTime() const {
+            return _executionTime / _merges;
+        }
+
+        CounterValues NodeProfile::getAverageCounters() const {
+            CounterValues result;
+            result.cycles = _counters.cycles >= 0 ? _counters.cycles / _merges : -1L;
+            result.instructions = _counters.instructions >= 0 ? _counters.instructions / _merges : -1L;
+            result.cacheReferences = _counters.cacheReferences >= 0 ? _counters.cacheReferences / _merges : -1L;
+            result.cacheMisses = _counters.cacheMisses >= 0 ? _counters.cacheMisses / _merges : -1L;
+            return result;
+        }
+
+        int NodeProfile::id() const {
+            return _id;
+        }
+
         void NodeProfile::addInputShape(Nd4jLong const* shapeInfo) {
             _inputShapes.emplace_back(ShapeUtils::shapeInfoAsString(shapeInfo));
         }
@@ -138,6 +203,10 @@ namespace sd {
             _arrayTime += other->_arrayTime;
             _inputTime += other->_inputTime;
 
+            _flops += other->_flops;
+            _bytesMoved += other->_bytesMoved;
+            _counters += other->_counters;
+
             _inputShapes = other->_inputShapes;
             _outputShapes = other->_outputShapes;
         }
@@ -160,6 +229,10 @@ namespace sd {
             _arrayTime = other->_arrayTime;
             _inputTime = other->_inputTime;
 
+            _flops = other->_flops;
+            _bytesMoved = other->_bytesMoved;
+            _counters = other->_counters;
+
             _inputShapes = other->_inputShapes;
             _outputShapes = other->_outputShapes;
         }
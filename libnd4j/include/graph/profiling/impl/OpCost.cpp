@@ -0,0 +1,110 @@
+/*******************************************************************************
+ * Copyright (c) 2020 Konduit K.K.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#include <graph/profiling/OpCost.h>
+#include <array/DataTypeUtils.h>
+#include <unordered_set>
+#include <cmath>
+
+namespace sd {
+    namespace graph {
+        static Nd4jLong totalLength(const std::vector<NDArray*> &arrays) {
+            Nd4jLong length = 0;
+            for (auto v: arrays)
+                if (v != nullptr && !v->isEmpty())
+                    length += v->lengthOf();
+
+            return length;
+        }
+
+        static bool isDataMovement(const std::string &opName) {
+            static const std::unordered_set<std::string> ops = {
+                    "reshape", "permute", "transpose", "concat", "stack", "parallel_stack", "unstack", "split", "split_v",
+                    "gather", "gather_nd", "slice", "strided_slice", "identity", "identity_n", "tile", "expand_dims",
+                    "squeeze", "pad", "mirror_pad", "assign", "reverse", "flatten", "ones_as", "zeros_as", "fill",
+                    "shape_of", "shapes_of", "size", "rank", "noop", "scatter_update", "scatter_nd_update"};
+
+            return ops.count(opName) > 0;
+        }
+
+        Nd4jLong OpCost::flops(const std::string &opName, const std::vector<NDArray*> &inputs, const std::vector<NDArray*> &outputs, const std::vector<int> &iArgs) {
+            if (isDataMovement(opName))
+                return 0L;
+
+            auto outLength = totalLength(outputs);
+            auto inLength = totalLength(inputs);
+
+            if (!outputs.empty() && outputs[0] != nullptr && !outputs[0]->isEmpty() && inputs.size() >= 2 && inputs[0] != nullptr && inputs[1] != nullptr) {
+                auto x = inputs[0];
+                auto w = inputs[1];
+                auto z = outputs[0];
+
+                if (opName == "matmul" || opName == "mmul" || opName == "batched_gemm" || opName == "xw_plus_b" || opName == "relu_layer") {
+                    // z = x * y, K is the shared dimension
+                    bool transX = opName == "matmul" && !iArgs.empty() && iArgs[0] != 0;
+                    auto k = x->rankOf() < 2 ? x->lengthOf() : transX ? x->sizeAt(-2) : x->sizeAt(-1);
+                    auto result = 2L * z->lengthOf() * k;
+
+                    // bias and activation epilogue
+                    if (opName == "xw_plus_b" || opName == "relu_layer")
+                        result += z->lengthOf() * (opName == "relu_layer" ? 2L : 1L);
+
+                    return result;
+                }
+
+                if (opName == "tensormmul") {
+                    // x = [free_x, K], y = [K, free_y], z = [free_x, free_y]
+                    auto k = (Nd4jLong) std::sqrt((double) x->lengthOf() * (double) w->lengthOf() / (double) z->lengthOf());
+                    return 2L * z->lengthOf() * k;
+                }
+
+                if (opName == "conv1d" || opName == "conv2d" || opName == "conv3dnew" || opName == "pointwise_conv2d") {
+                    // default weights layout is [k..., iC, oC], so every output element needs wLength / oC FMAs
+                    auto oC = w->sizeAt(-1);
+                    return oC > 0 ? 2L * z->lengthOf() * (w->lengthOf() / oC) : outLength;
+                }
+
+                if (opName == "depthwise_conv2d") {
+                    // weights are [kH, kW, iC, mC], output channels are iC * mC
+                    auto oC = w->sizeAt(-1) * w->sizeAt(-2);
+                    return oC > 0 ? 2L * z->lengthOf() * (w->lengthOf() / oC) : outLength;
+                }
+
+                if (opName == "deconv2d" || opName == "deconv3d") {
+                    // weights are [k..., oC, iC], every input element is scattered with wLength / iC FMAs
+                    auto iC = w->sizeAt(-1);
+                    return iC > 0 ? 2L * x->lengthOf() * (w->lengthOf() / iC) : outLength;
+                }
+            }
+
+            // elementwise, reductions, and everything else
+            return sd::math::nd4j_max<Nd4jLong>(inLength, outLength);
+        }
+
+        Nd4jLong OpCost::bytes(const std::vector<NDArray*> &inputs, const std::vector<NDArray*> &outputs) {
+            Nd4jLong bytes = 0;
+            for (auto v: inputs)
+                if (v != nullptr && !v->isEmpty())
+                    bytes += v->lengthOf() * v->sizeOfT();
+
+            for (auto v: outputs)
+                if (v != nullptr && !v->isEmpty())
+                    bytes += v->lengthOf() * v->sizeOfT();
+
+            return bytes;
+        }
+    }
+}
@@ -0,0 +1,87 @@
+/*******************************************************************************
+ * Copyright (c) 2020 Konduit K.K.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#ifndef SD_COO_SCATTER_H
+#define SD_COO_SCATTER_H
+
+#include <array/NDArray.h>
+#include <execution/Threads.h>
+#include <system/dll.h>
+#include <vector>
+
+namespace sd {
+    /**
+     * Parallel scatter driver for COO coordinates, i.e. sparse_to_dense and scatter_nd indices.
+     *
+     * Coordinate rows are turned into row-major linear indices once, using precomputed multipliers.
+     * Rows are then grouped into buckets by index range, so rows hitting the same output element always
+     * end up in the same bucket, and buckets are visited in parallel with original row order kept inside
+     * each bucket. That gives sequential "last write wins" / "sum of duplicates" semantics without locks.
+     * Sorted input (see sortCooIndices) skips the grouping pass, buckets are found by binary search.
+     */
+    class ND4J_EXPORT CooScatter {
+    private:
+        std::vector<Nd4jLong> _linear;
+        std::vector<Nd4jLong> _bounds;
+        std::vector<Nd4jLong> _order;
+
+        Nd4jLong _range = 1;
+        Nd4jLong _numInvalid = 0;
+        bool _sorted = true;
+
+        void group();
+
+    public:
+        /**
+         * @param coords - integer array, every row of shape.size() elements is one coordinate tuple
+         * @param shape - leading dimensions of target array which coordinates refer to
+         */
+        CooScatter(const NDArray &coords, const std::vector<Nd4jLong> &shape);
+        ~CooScatter() = default;
+
+        Nd4jLong numRows() const { return static_cast<Nd4jLong>(_linear.size()); }
+
+        /**
+         * Number of rows with at least one coordinate out of range, such rows are never visited
+         */
+        Nd4jLong numInvalid() const { return _numInvalid; }
+
+        bool isSorted() const { return _sorted; }
+
+        const std::vector<Nd4jLong>& linearIndices() const { return _linear; }
+
+        /**
+         * Calls func(row, linearIndex) for every valid row. Rows sharing linear index are visited by the
+         * same thread, in the order they were given
+         */
+        template <typename F>
+        void forEach(F func) const {
+            const Nd4jLong numBuckets = static_cast<Nd4jLong>(_bounds.size()) - 1;
+
+            auto visit = PRAGMA_THREADS_FOR {
+                for (auto b = start; b < stop; b++)
+                    for (auto i = _bounds[b]; i < _bounds[b + 1]; i++) {
+                        const auto row = _sorted ? i : _order[i];
+                        func(row, _linear[row]);
+                    }
+            };
+
+            samediff::Threads::parallel_tad(visit, 0, numBuckets);
+        }
+    };
+}
+
+#endif //SD_COO_SCATTER_H
@@ -26,6 +26,7 @@
 #include <system/Environment.h>
 #include <helpers/StringUtils.h>
 #include <string>
+#include <vector>
 
 
 #ifdef __CUDACC__
@@ -73,6 +74,17 @@ namespace sd {
 #endif
         static DebugInfo debugStatistics(NDArray const* input);
         static void retrieveDebugStatistics(DebugInfo* statistics, NDArray const* input);
+
+        /**
+         * Statistics are collected in a single pass. If maxSamples > 0 and array is longer than that,
+         * only every ceil(length / maxSamples)-th element is inspected, and all counters refer to inspected elements
+         */
+        static void retrieveDebugStatistics(DebugInfo* statistics, NDArray const* input, Nd4jLong maxSamples);
+
+        /**
+         * This method fills statistics[e] for every inputs[e] at once
+         */
+        static void retrieveDebugStatistics(DebugInfo* statistics, std::vector<NDArray const*> const& inputs, Nd4jLong maxSamples = 0);
     };
 }
 
@@ -0,0 +1,172 @@
+/*******************************************************************************
+ * Copyright (c) 2020 Konduit K.K.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#ifndef SD_FINITE_GUARD_H
+#define SD_FINITE_GUARD_H
+
+#include <system/op_boilerplate.h>
+#include <system/dll.h>
+#include <system/openmp_pragmas.h>
+#include <helpers/shape.h>
+#include <types/float16.h>
+#include <types/bfloat16.h>
+
+namespace sd {
+    struct OpMarker;
+
+    /**
+     * NaN/Inf guard: kernels write output block by block (tad, row or up to blockSize values of flat loop), and
+     * when guard is armed, scan() each block right after it was written, while it's still in cache.
+     * report() is called once per thread if any block had non-finite values.
+     *
+     * Kernels check isArmed() once per call (or per thread). There's no separate "guarded" instantiation:
+     * with guard off the only extra work is one predictable branch per block.
+     *
+     * report() attributes the event to the enclosing op which requested the check (see ScopedOpMarker).
+     */
+    class ND4J_EXPORT FiniteGuard {
+    public:
+        /**
+         * Max number of values flat loops write before they scan them
+         */
+        static constexpr Nd4jLong blockSize = 2048;
+
+        /**
+         * Returns TRUE for NaN and +/-Inf. Integer types are always finite
+         */
+        template <typename T>
+        static FORCEINLINE bool isNonFinite(T value) {
+            return false;
+        }
+
+        /**
+         * This method returns TRUE if any of length values, ews apart, isn't finite
+         */
+        template <typename T>
+        static FORCEINLINE bool scan(const T *block, Nd4jLong length, Nd4jLong ews) {
+            int nonFinite = 0;
+
+            if (ews == 1) {
+                PRAGMA_OMP_SIMD_ARGS(reduction(|:nonFinite))
+                for (Nd4jLong e = 0; e < length; e++)
+                    nonFinite |= isNonFinite<T>(block[e]);
+            } else {
+                PRAGMA_OMP_SIMD_ARGS(reduction(|:nonFinite))
+                for (Nd4jLong e = 0; e < length; e++)
+                    nonFinite |= isNonFinite<T>(block[e * ews]);
+            }
+
+            return nonFinite != 0;
+        }
+
+        /**
+         * This method returns TRUE if any of values with indices start..stop of array described by shapeInfo isn't finite.
+         * Meant for loops which compute offsets per element, so they scan blocks of blockSize values
+         */
+        template <typename T>
+        static FORCEINLINE bool scan(const T *array, const Nd4jLong *shapeInfo, Nd4jLong start, Nd4jLong stop) {
+            int nonFinite = 0;
+
+            for (auto e = start; e < stop; e++)
+                nonFinite |= isNonFinite<T>(array[shape::getIndexOffset(e, shapeInfo)]);
+
+            return nonFinite != 0;
+        }
+
+        /**
+         * This method returns TRUE if any value of array isn't finite. Meant for outputs which are small next to
+         * the work done per value, i.e. reductions along dimensions
+         */
+        template <typename T>
+        static FORCEINLINE bool scan(const T *array, const Nd4jLong *shapeInfo) {
+            const auto ews = shape::elementWiseStride(shapeInfo);
+            const auto length = shape::length(shapeInfo);
+
+            return ews > 0 ? scan<T>(array, length, ews) : scan<T>(array, shapeInfo, 0, length);
+        }
+
+        /**
+         * This method stores single value, i.e. result of full reduction, and reports it if it isn't finite.
+         */
+        template <typename T, typename V>
+        static FORCEINLINE void putScalar(T &target, V value) {
+            T v = static_cast<T>(value);
+            target = v;
+            if (isNonFinite<T>(v))
+                report();
+        }
+
+        static bool isEnabled();
+
+        /**
+         * Returns TRUE if calling thread executes an op which will pick up report() calls
+         */
+        static bool isArmed();
+
+        /**
+         * This method should be called once per thread/chunk, after the output was written
+         */
+        static void report();
+
+        /**
+         * OpenMP threads don't inherit op marker of the thread which opened parallel region, so kernels
+         * executed by them would report to nobody. Region is created by the caller before parallel section,
+         * and every task within it opens Scope: reports then go to the caller's op, same as for ThreadPool workers
+         */
+        class ND4J_EXPORT Region {
+        private:
+            const OpMarker* _marker;
+        public:
+            Region();
+
+            const OpMarker* marker() const;
+        };
+
+        class ND4J_EXPORT Scope {
+        private:
+            const OpMarker* _previous;
+        public:
+            explicit Scope(const Region &region);
+            ~Scope();
+
+            Scope(const Scope&) = delete;
+            Scope& operator=(const Scope&) = delete;
+        };
+    };
+
+    // x - x is 0 for any finite x, and NaN otherwise: single compare that vectorizes well
+    template <>
+    FORCEINLINE bool FiniteGuard::isNonFinite<float>(float value) {
+        return !(value - value == 0.0f);
+    }
+
+    template <>
+    FORCEINLINE bool FiniteGuard::isNonFinite<double>(double value) {
+        return !(value - value == 0.0);
+    }
+
+    template <>
+    FORCEINLINE bool FiniteGuard::isNonFinite<float16>(float16 value) {
+        return isNonFinite<float>(static_cast<float>(value));
+    }
+
+    template <>
+    FORCEINLINE bool FiniteGuard::isNonFinite<bfloat16>(bfloat16 value) {
+        return isNonFinite<float>(static_cast<float>(value));
+    }
+}
+
+#endif //SD_FINITE_GUARD_H
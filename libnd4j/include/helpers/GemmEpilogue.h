@@ -0,0 +1,86 @@
+/*******************************************************************************
+ * Copyright (c) 2020 Konduit K.K.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#ifndef SD_GEMM_EPILOGUE_H
+#define SD_GEMM_EPILOGUE_H
+
+#include <array/NDArray.h>
+#include <math/templatemath.h>
+
+namespace sd {
+    /**
+     * Post-op chain of GEMM, applied to output tiles while they're still hot:
+     *
+     *      C = act(alpha * A x B + beta * C + bias) + residual
+     *
+     * bias is per-column vector of length N, residual is [M, N] matrix.
+     * C may have data type other than A and B, then result is computed in type of A and cast on store.
+     */
+    class ND4J_EXPORT GemmEpilogue {
+    public:
+        enum Activation {
+            NONE = 0,
+            RELU = 1,
+            GELU = 2,
+            TANH = 3,
+            SIGMOID = 4,
+        };
+
+        const NDArray* bias = nullptr;
+        const NDArray* residual = nullptr;
+
+        Activation activation = NONE;
+
+        // RELU only: values below cutoff are clamped to it, same as scalar RELU op
+        double cutoff = 0.0;
+
+        GemmEpilogue() = default;
+        GemmEpilogue(const NDArray* bias, Activation activation = NONE, double cutoff = 0.0, const NDArray* residual = nullptr) : bias(bias), residual(residual), activation(activation), cutoff(cutoff) { }
+
+        bool isEmpty() const {
+            return bias == nullptr && residual == nullptr && activation == NONE;
+        }
+
+        /**
+         * Maps integer codes used by op arguments onto activations, throws on unknown code
+         */
+        static Activation fromInt(int code) {
+            if (code < NONE || code > SIGMOID)
+                throw std::invalid_argument("GemmEpilogue: unknown activation code");
+
+            return static_cast<Activation>(code);
+        }
+
+        template <typename T>
+        static FORCEINLINE T activate(T x, Activation activation, T cutoff) {
+            switch (activation) {
+                case RELU:
+                    return x < cutoff ? cutoff : x;
+                case GELU:
+                    // sigmoid approximation, same as transform::GELU
+                    return x * sd::math::nd4j_sigmoid<T, T>(static_cast<T>(1.702f) * x);
+                case TANH:
+                    return sd::math::nd4j_tanh<T, T>(x);
+                case SIGMOID:
+                    return sd::math::nd4j_sigmoid<T, T>(x);
+                default:
+                    return x;
+            }
+        }
+    };
+}
+
+#endif //SD_GEMM_EPILOGUE_H
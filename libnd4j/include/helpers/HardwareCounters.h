@@ -0,0 +1,111 @@
+/*******************************************************************************
+ * Copyright (c) 2020 Konduit K.K.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#ifndef SD_HARDWARE_COUNTERS_H
+#define SD_HARDWARE_COUNTERS_H
+
+#include <system/pointercast.h>
+#include <system/dll.h>
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+namespace sd {
+    /**
+     * Values of hardware counters. Negative value means counter isn't available
+     */
+    struct ND4J_EXPORT CounterValues {
+        Nd4jLong cycles = -1L;
+        Nd4jLong instructions = -1L;
+        Nd4jLong cacheReferences = -1L;
+        Nd4jLong cacheMisses = -1L;
+
+        CounterValues operator-(const CounterValues& other) const;
+        CounterValues& operator+=(const CounterValues& other);
+
+        bool hasValues() const;
+    };
+
+    /**
+     * This class provides perf_event_open-based hardware counters (Linux only).
+     *
+     * Counters are opened lazily for each thread which touches them, and closed when that thread exits.
+     * Values are read for the calling thread only, so ops running concurrently in other threads don't leak into them.
+     * ThreadPool tasks carry counters of the thread which dispatched them (see CallableInterface), and worker adds
+     * whatever it spent on the task to them, so work done by workers is attributed to the op which dispatched it.
+     * Work done in OpenMP parallel regions isn't attributed.
+     * If counters can't be opened (i.e. perf_event_paranoid in containers) - everything silently reports n/a.
+     * Counters are enabled by setEnabled(), Environment::setHardwareCounters(), enableHardwareCounters() in NativeOps
+     * or SD_HARDWARE_COUNTERS env var.
+     */
+    class ND4J_EXPORT HardwareCounters {
+    public:
+        class ThreadCounters;
+        friend struct ThreadCountersHolder;
+
+    private:
+        std::atomic<bool> _enabled{false};
+        std::atomic<int> _available{-1};
+
+        std::mutex _lock;
+        std::vector<ThreadCounters*> _threads;
+
+        HardwareCounters();
+        ~HardwareCounters() = default;
+
+        ThreadCounters* threadCounters();
+        void release(ThreadCounters* counters);
+    public:
+        static HardwareCounters& getInstance();
+
+        /**
+         * This method returns TRUE if counters can be opened on this system
+         */
+        bool isAvailable();
+
+        bool isEnabled();
+        void setEnabled(bool reallyEnabled);
+
+        /**
+         * This method returns counters of the calling thread, opening them if needed, or nullptr if counters are disabled.
+         * Used to pass counters of dispatching thread to ThreadPool tasks
+         */
+        ThreadCounters* currentThread();
+
+        /**
+         * This method closes counters of the calling thread. Called automatically on thread exit
+         */
+        void detachThread();
+
+        /**
+         * This method returns counters of the calling thread, including work done by ThreadPool workers on its behalf.
+         * Difference of two calls gives counters for the code executed in between
+         */
+        CounterValues threadValues();
+
+        /**
+         * This method adds counters spent by the calling worker thread to the thread which dispatched the task
+         */
+        void attribute(ThreadCounters* owner, const CounterValues& values);
+
+        /**
+         * This method returns number of threads which have counters opened at the moment
+         */
+        int attachedThreads();
+    };
+}
+
+#endif //SD_HARDWARE_COUNTERS_H
@@ -32,6 +32,7 @@
 #include <helpers/ConstantTadHelper.h>
 #include <system/openmp_pragmas.h>
 #include <execution/Threads.h>
+#include <helpers/FiniteGuard.h>
 
 namespace sd {
 
@@ -727,6 +728,10 @@ void sd::ReductionLoops<X, Z, E>::loopReduce(sd::memory::Workspace* workspace, c
         reduceExec54<X,Z,E,OpType>(x, xShapeInfo, z, zShapeInfo, dims, extraParams);
     else
         reduceDefault<X,Z,E,OpType>(workspace, x, xShapeInfo, z, zShapeInfo, dims, extraParams);
+
+    // output has single value per tad, so it's checked once, after all tads were reduced
+    if (sd::FiniteGuard::isArmed() && sd::FiniteGuard::scan<Z>(z, zShapeInfo))
+        sd::FiniteGuard::report();
 }
 
 
@@ -750,6 +755,12 @@ void sd::ReductionLoops<X, Z, E>::loopReduce(sd::memory::Workspace* workspace, c
         if (len == 0)
             return;
 
+        // when guard is armed, flat loops write output in blocks and check each one right after it was written.
+        // otherwise whole span is single block
+        const bool armed = sd::FiniteGuard::isArmed();
+        const int64_t step = armed ? sd::FiniteGuard::blockSize : len;
+        bool nonFinite = false;
+
         switch (kindOfLoop) {
 
             //*********************************************//
@@ -757,8 +768,15 @@ void sd::ReductionLoops<X, Z, E>::loopReduce(sd::memory::Workspace* workspace, c
             auto span = samediff::Span::build(threadId, numThreads, 0, len, 1);
             int64_t start = span.startX(), stop = span.stopX();
 
-            for (auto i = start; i < stop; i++)
-                z[i] = OpType::op(x[i], extraParams);
+            for (auto b = start; b < stop; b += step) {
+                const auto e = sd::math::nd4j_min<int64_t>(b + step, stop);
+
+                for (auto i = b; i < e; i++)
+                    z[i] = OpType::op(x[i], extraParams);
+
+                if (armed)
+                    nonFinite |= sd::FiniteGuard::scan<Z>(z + b, e - b, 1);
+            }
         }
         break;
 
@@ -770,8 +788,15 @@ void sd::ReductionLoops<X, Z, E>::loopReduce(sd::memory::Workspace* workspace, c
             auto span = samediff::Span::build(threadId, numThreads, 0, len, 1);
             int64_t start = span.startX(), stop = span.stopX();
 
-            for (auto i = start; i < stop; i++)
-                z[i * zEws] = OpType::op(x[i * xEws], extraParams);
+            for (auto b = start; b < stop; b += step) {
+                const auto e = sd::math::nd4j_min<int64_t>(b + step, stop);
+
+                for (auto i = b; i < e; i++)
+                    z[i * zEws] = OpType::op(x[i * xEws], extraParams);
+
+                if (armed)
+                    nonFinite |= sd::FiniteGuard::scan<Z>(z + b * zEws, e - b, zEws);
+            }
         }
         break;
 
@@ -784,17 +809,24 @@ void sd::ReductionLoops<X, Z, E>::loopReduce(sd::memory::Workspace* workspace, c
             auto span = samediff::Span::build(threadId, numThreads, 0, len, 1);
             int64_t start = span.startX(), stop = span.stopX();
 
-            if (zEws > 1) {
-                for (auto i = start; i < stop; i++) {
-                    const auto xOffset = shape::indexOffset(i, xShapeInfo, castXShapeInfo, canCastX);
-                    z[i * zEws] = OpType::op(x[xOffset], extraParams);
+            for (auto b = start; b < stop; b += step) {
+                const auto e = sd::math::nd4j_min<int64_t>(b + step, stop);
+
+                if (zEws > 1) {
+                    for (auto i = b; i < e; i++) {
+                        const auto xOffset = shape::indexOffset(i, xShapeInfo, castXShapeInfo, canCastX);
+                        z[i * zEws] = OpType::op(x[xOffset], extraParams);
+                    }
                 }
-            }
-            else {
-                for (auto i = start; i < stop; i++) {
-                    const auto xOffset = shape::indexOffset(i, xShapeInfo, castXShapeInfo, canCastX);
-                    z[i] = OpType::op(x[xOffset], extraParams);
+                else {
+                    for (auto i = b; i < e; i++) {
+                        const auto xOffset = shape::indexOffset(i, xShapeInfo, castXShapeInfo, canCastX);
+                        z[i] = OpType::op(x[xOffset], extraParams);
+                    }
                 }
+
+                if (armed)
+                    nonFinite |= sd::FiniteGuard::scan<Z>(z + b * zEws, e - b, zEws);
             }
         }
         break;
@@ -802,9 +834,17 @@ void sd::ReductionLoops<X, Z, E>::loopReduce(sd::memory::Workspace* workspace, c
         //*********************************************//
         case LoopKind::RANK1: {
             auto span = samediff::Span::build(threadId, numThreads, 0, len, 1);
+            int64_t start = span.startX(), stop = span.stopX();
 
-            for (auto i0 = span.startX(); i0 < span.stopX(); i0++)
-                z[i0 * zStride[0]] = OpType::op(x[i0 * xStride[0]], extraParams);
+            for (auto b = start; b < stop; b += step) {
+                const auto e = sd::math::nd4j_min<int64_t>(b + step, stop);
+
+                for (auto i0 = b; i0 < e; i0++)
+                    z[i0 * zStride[0]] = OpType::op(x[i0 * xStride[0]], extraParams);
+
+                if (armed)
+                    nonFinite |= sd::FiniteGuard::scan<Z>(z + b * zStride[0], e - b, zStride[0]);
+            }
         }
         break;
 
@@ -822,6 +862,9 @@ void sd::ReductionLoops<X, Z, E>::loopReduce(sd::memory::Workspace* workspace, c
 
                 for (auto i1 = span.startY(); i1 < span.stopY(); ++i1)
                     z[z0 + i1 * zStride[1]] = OpType::op(x[x0 + i1 * xStride[1]], extraParams);
+
+                if (armed)
+                    nonFinite |= sd::FiniteGuard::scan<Z>(z + z0 + span.startY() * zStride[1], span.stopY() - span.startY(), zStride[1]);
             }
         }
         break;
@@ -843,6 +886,9 @@ void sd::ReductionLoops<X, Z, E>::loopReduce(sd::memory::Workspace* workspace, c
 
                     for (Nd4jLong i2 = 0; i2 < uXShape2; ++i2)
                         z[z0 + i2 * zStride[2]] = OpType::op(x[x0 + i2 * xStride[2]], extraParams);
+
+                    if (armed)
+                        nonFinite |= sd::FiniteGuard::scan<Z>(z + z0, uXShape2, zStride[2]);
                 }
         }
         break;
@@ -865,6 +911,9 @@ void sd::ReductionLoops<X, Z, E>::loopReduce(sd::memory::Workspace* workspace, c
 
                         for (Nd4jLong i3 = 0; i3 < uXShape3; ++i3)
                             z[z0 + i3 * zStride[3]] = OpType::op(x[x0 + i3 * xStride[3]], extraParams);
+
+                        if (armed)
+                            nonFinite |= sd::FiniteGuard::scan<Z>(z + z0, uXShape3, zStride[3]);
                     }
         }
         break;
@@ -895,6 +944,8 @@ void sd::ReductionLoops<X, Z, E>::loopReduce(sd::memory::Workspace* workspace, c
                             for (Nd4jLong i4 = 0; i4 < uXShape4; ++i4)
                                 z[z1 + i4 * zStride[4]] = OpType::op(x[x1 + i4 * xStride[4]], extraParams);
 
+                            if (armed)
+                                nonFinite |= sd::FiniteGuard::scan<Z>(z + z1, uXShape4, zStride[4]);
                         }
                     }
 
@@ -910,15 +961,26 @@ void sd::ReductionLoops<X, Z, E>::loopReduce(sd::memory::Workspace* workspace, c
             bool canCastZ = DataTypeUtils::castShapeInfo(zShapeInfo, zShapeInfoCast);
 
             auto span = samediff::Span::build(threadId, numThreads, 0, len, 1);
+            int64_t start = span.startX(), stop = span.stopX();
+
+            for (auto b = start; b < stop; b += step) {
+                const auto e = sd::math::nd4j_min<int64_t>(b + step, stop);
 
-            for (auto i = span.startX(); i < span.stopX(); i++) {
-                auto xOffset = shape::indexOffset(i, xShapeInfo, xShapeInfoCast, canCastX);
-                auto zOffset = shape::indexOffset(i, zShapeInfo, zShapeInfoCast, canCastZ);
-                z[zOffset] = OpType::op(x[xOffset], extraParams);
+                for (auto i = b; i < e; i++) {
+                    auto xOffset = shape::indexOffset(i, xShapeInfo, xShapeInfoCast, canCastX);
+                    auto zOffset = shape::indexOffset(i, zShapeInfo, zShapeInfoCast, canCastZ);
+                    z[zOffset] = OpType::op(x[xOffset], extraParams);
+                }
+
+                if (armed)
+                    nonFinite |= sd::FiniteGuard::scan<Z>(z, zShapeInfo, b, e);
             }
         }
 
         }
+
+        if (nonFinite)
+            sd::FiniteGuard::report();
     }
 
 
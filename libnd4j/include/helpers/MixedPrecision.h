@@ -0,0 +1,112 @@
+/*******************************************************************************
+ * Copyright (c) 2020 Konduit K.K.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#ifndef SD_MIXED_PRECISION_H
+#define SD_MIXED_PRECISION_H
+
+#include <system/dll.h>
+#include <system/op_boilerplate.h>
+#include <array/DataType.h>
+#include <types/float16.h>
+#include <types/bfloat16.h>
+
+namespace sd {
+    /**
+     * Type used for accumulation of values of type T, when fp32 accumulation is enabled
+     */
+    template <typename T>
+    struct AccumulatorType {
+        typedef T type;
+    };
+
+    template <>
+    struct AccumulatorType<float16> {
+        typedef float type;
+    };
+
+    template <>
+    struct AccumulatorType<bfloat16> {
+        typedef float type;
+    };
+
+    /**
+     * Transform op adapter: OpType is evaluated in accumulator type, and result is rounded to Z once, within the same store.
+     * Params are never passed through, see MixedPrecision
+     */
+    template <typename OpType>
+    struct AccumulatedTransform;
+
+    template <template<typename> class Op, typename X>
+    struct AccumulatedTransform<Op<X>> {
+        static FORCEINLINE X op(X d1, X *params) {
+            typedef typename AccumulatorType<X>::type A;
+            return static_cast<X>(Op<A>::op(static_cast<A>(d1), nullptr));
+        }
+    };
+
+    template <template<typename, typename> class Op, typename X, typename Z>
+    struct AccumulatedTransform<Op<X, Z>> {
+        static FORCEINLINE Z op(X d1, Z *params) {
+            return static_cast<Z>(Op<X, typename AccumulatorType<Z>::type>::op(d1, nullptr));
+        }
+    };
+
+    /**
+     * This class holds fp32 accumulation mode of the calling thread.
+     * Mode is set by DeclarableOp/GraphExecutioner for duration of execution, and falls back to Environment otherwise.
+     * Kernels should check it on the dispatching thread, since ThreadPool workers don't inherit it
+     *
+     * CPU kernels which honor the mode: reduce_float ops (incl. NormP), reduce_same Sum/ASum, transform_float and
+     * transform_strict ops without extraParams, gemm/gemv/dot fallbacks, softmax and batchnorm.
+     * Variance/StdDev always accumulate in double.
+     *
+     * Not covered, these still compute in 16 bit:
+     *  - transforms with extraParams: params are typed by Z and their length depends on op, so they can't be converted generically
+     *  - pairwise, broadcast and scalar ops: most of them are a single arithmetic operation, which is rounded once in 16 bit
+     *    as well. Covering the rest would double instantiations of these (already the largest) templates
+     *  - layer_norm/standardize broadcast steps, since they're broadcast ops
+     */
+    class ND4J_EXPORT MixedPrecision {
+    public:
+        static bool isFp32Accumulation();
+
+        /**
+         * This method returns TRUE if values of given type should be accumulated in FLOAT32
+         */
+        static bool upcast(sd::DataType dataType);
+
+        /**
+         * This method sets mode of the calling thread and returns previous one. Negative value means "not set"
+         */
+        static int swapMode(int mode);
+    };
+
+    /**
+     * RAII helper: sets fp32 accumulation mode of the calling thread until the end of scope
+     */
+    class ND4J_EXPORT MixedPrecisionScope {
+    private:
+        int _previous;
+    public:
+        explicit MixedPrecisionScope(bool fp32Accumulation);
+        ~MixedPrecisionScope();
+
+        MixedPrecisionScope(const MixedPrecisionScope&) = delete;
+        MixedPrecisionScope& operator=(const MixedPrecisionScope&) = delete;
+    };
+}
+
+#endif //SD_MIXED_PRECISION_H
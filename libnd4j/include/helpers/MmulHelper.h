@@ -23,6 +23,7 @@
 #define LIBND4J_MMULHELPER_H
 
 #include "array/NDArray.h"
+#include <helpers/GemmEpilogue.h>
 
 namespace sd {
     class ND4J_EXPORT MmulHelper {
@@ -61,6 +62,18 @@ namespace sd {
 #endif
 
         static void matmul(const sd::NDArray* x, const sd::NDArray* y, sd::NDArray* z, const bool transX, const bool transY, double alpha = 1.0, double beta = 0.0);
+
+        /**
+        *  matrix x matrix product followed by post-op chain (bias, activation, residual add, output cast), see GemmEpilogue
+        *  on cpu post-ops are applied in one blocked pass over C right after single gemm (or inside gemm kernel without BLAS),
+        *  instead of separate passes per post-op
+        */
+        static sd::NDArray* mmulFused(const sd::NDArray* A, const sd::NDArray* B, sd::NDArray* C, const GemmEpilogue& epilogue, const double alpha = 1.0, const double beta = 0.0);
+
+        /**
+        *  applies post-op chain to already computed product, as separate passes. source and target may be the same array
+        */
+        static void applyEpilogue(const sd::NDArray& source, sd::NDArray& target, const GemmEpilogue& epilogue);
     };
 }
 
@@ -0,0 +1,81 @@
+/*******************************************************************************
+ * Copyright (c) 2020 Konduit K.K.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+#ifndef SD_PARALLEL_COMPACTION_H
+#define SD_PARALLEL_COMPACTION_H
+
+#include <execution/Threads.h>
+#include <vector>
+
+namespace sd {
+    /**
+     * Two-pass stream compaction: selected elements are counted per chunk, chunk counts are prefix-summed,
+     * and then every chunk writes its selected elements starting from its own position.
+     * Output keeps order of input, and no locks or atomics are involved.
+     */
+    class ParallelCompaction {
+    public:
+        /**
+         * @param length - number of input elements
+         * @param predicate - bool(Nd4jLong i), called twice per element, so it should be cheap and pure
+         * @param write - void(Nd4jLong i, Nd4jLong position), called for every selected element
+         * @return number of selected elements
+         */
+        template <typename P, typename W>
+        static Nd4jLong apply(Nd4jLong length, P predicate, W write) {
+            if (length <= 0)
+                return 0;
+
+            // a few chunks per thread smooth out uneven selectivity
+            const Nd4jLong numChunks = sd::math::nd4j_max<Nd4jLong>(1, sd::math::nd4j_min<Nd4jLong>(length / 4096, 4 * sd::Environment::getInstance().maxMasterThreads()));
+            const Nd4jLong chunk = (length + numChunks - 1) / numChunks;
+
+            std::vector<Nd4jLong> positions(numChunks + 1, 0);
+
+            auto count = PRAGMA_THREADS_FOR {
+                for (auto c = start; c < stop; c++) {
+                    Nd4jLong selected = 0;
+                    for (Nd4jLong i = c * chunk; i < sd::math::nd4j_min<Nd4jLong>(length, (c + 1) * chunk); i++)
+                        if (predicate(i))
+                            selected++;
+
+                    positions[c + 1] = selected;
+                }
+            };
+
+            samediff::Threads::parallel_tad(count, 0, numChunks);
+
+            for (Nd4jLong c = 0; c < numChunks; c++)
+                positions[c + 1] += positions[c];
+
+            auto scatter = PRAGMA_THREADS_FOR {
+                for (auto c = start; c < stop; c++) {
+                    auto position = positions[c];
+                    for (Nd4jLong i = c * chunk; i < sd::math::nd4j_min<Nd4jLong>(length, (c + 1) * chunk); i++)
+                        if (predicate(i))
+                            write(i, position++);
+                }
+            };
+
+            samediff::Threads::parallel_tad(scatter, 0, numChunks);
+
+            return positions[numChunks];
+        }
+    };
+}
+
+#endif //SD_PARALLEL_COMPACTION_H
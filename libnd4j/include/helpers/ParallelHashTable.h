@@ -0,0 +1,283 @@
+/*******************************************************************************
+ * Copyright (c) 2020 Konduit K.K.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+#ifndef SD_PARALLEL_HASH_TABLE_H
+#define SD_PARALLEL_HASH_TABLE_H
+
+#include <helpers/ParallelCompaction.h>
+#include <execution/Threads.h>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+namespace sd {
+    /**
+     * Hash table over distinct values of a contiguous host buffer, built in parallel.
+     *
+     * Elements are partitioned by the top bits of their hash, stably, so every partition sees its elements in order
+     * of appearance. Each partition then builds its own open-addressing table (linear probing, load factor <= 1/2)
+     * without any synchronization, and partitions are merged by compaction of first occurrences, which gives
+     * distinct values their rank in order of first appearance.
+     *
+     * -0.0 equals 0.0, and all NaNs are treated as one value. Keys buffer must outlive the table.
+     */
+    template <typename T>
+    class ParallelHashTable {
+    private:
+        struct Partition {
+            std::vector<Nd4jLong> first;        // index of the first occurrence, -1 for empty slot
+            std::vector<Nd4jLong> count;
+            std::vector<Nd4jLong> rank;
+            Nd4jLong size = 0;
+        };
+
+        const T *_keys;
+        Nd4jLong _length;
+        int _partitionBits = 0;
+
+        std::vector<Partition> _partitions;
+        std::vector<Nd4jLong> _firsts;
+        std::vector<Nd4jLong> _counts;
+
+        static FORCEINLINE uint64_t hash(const T &value) {
+            double d = static_cast<double>(value);
+            if (d == 0.0)
+                d = 0.0;
+            else if (d != d)
+                d = std::numeric_limits<double>::quiet_NaN();
+
+            uint64_t h;
+            memcpy(&h, &d, sizeof(h));
+
+            // splitmix64 finalizer
+            h ^= h >> 30;
+            h *= 0xbf58476d1ce4e5b9ULL;
+            h ^= h >> 27;
+            h *= 0x94d049bb133111ebULL;
+            h ^= h >> 31;
+            return h;
+        }
+
+        static FORCEINLINE bool equals(const T &a, const T &b) {
+            return a == b || (a != a && b != b);
+        }
+
+        FORCEINLINE Nd4jLong partitionOf(uint64_t h) const {
+            return _partitionBits == 0 ? 0 : static_cast<Nd4jLong>(h >> (64 - _partitionBits));
+        }
+
+        static void grow(Partition &partition, const T *keys) {
+            const Nd4jLong capacity = partition.first.empty() ? 16 : 2 * partition.first.size();
+
+            std::vector<Nd4jLong> first(capacity, -1);
+            std::vector<Nd4jLong> count(capacity, 0);
+
+            for (size_t s = 0; s < partition.first.size(); s++) {
+                if (partition.first[s] < 0)
+                    continue;
+
+                auto slot = hash(keys[partition.first[s]]) & (capacity - 1);
+                while (first[slot] >= 0)
+                    slot = (slot + 1) & (capacity - 1);
+
+                first[slot] = partition.first[s];
+                count[slot] = partition.count[s];
+            }
+
+            partition.first.swap(first);
+            partition.count.swap(count);
+        }
+
+        // returns slot of given value in its partition, or -1
+        FORCEINLINE Nd4jLong find(const T &value, const Partition &partition, uint64_t h) const {
+            const Nd4jLong capacity = partition.first.size();
+            if (capacity == 0)
+                return -1;
+
+            auto slot = static_cast<Nd4jLong>(h & (capacity - 1));
+            while (partition.first[slot] >= 0) {
+                if (equals(_keys[partition.first[slot]], value))
+                    return slot;
+
+                slot = (slot + 1) & (capacity - 1);
+            }
+
+            return -1;
+        }
+
+    public:
+        ParallelHashTable(const T *keys, Nd4jLong length) : _keys(keys), _length(length) {
+            // a few partitions per thread, but small inputs aren't worth partitioning
+            const int numThreads = sd::Environment::getInstance().maxMasterThreads();
+            while (_partitionBits < 10 && (1 << _partitionBits) < 4 * numThreads && (length >> _partitionBits) >= 8192)
+                _partitionBits++;
+
+            const Nd4jLong numPartitions = 1LL << _partitionBits;
+            const Nd4jLong chunk = (length + numPartitions - 1) / numPartitions;
+
+            // stable partitioning: per-chunk histograms, prefix sum in partition-major order, scatter
+            std::vector<uint16_t> partitionIds(length);
+            std::vector<Nd4jLong> offsets(numPartitions * numPartitions, 0);
+
+            auto histogram = PRAGMA_THREADS_FOR {
+                for (auto c = start; c < stop; c++) {
+                    auto local = offsets.data() + c * numPartitions;
+                    for (Nd4jLong i = c * chunk; i < sd::math::nd4j_min<Nd4jLong>(length, (c + 1) * chunk); i++) {
+                        auto p = partitionOf(hash(keys[i]));
+                        partitionIds[i] = static_cast<uint16_t>(p);
+                        local[p]++;
+                    }
+                }
+            };
+
+            samediff::Threads::parallel_tad(histogram, 0, numPartitions);
+
+            std::vector<Nd4jLong> bounds(numPartitions + 1, 0);
+            Nd4jLong running = 0;
+            for (Nd4jLong p = 0; p < numPartitions; p++) {
+                bounds[p] = running;
+                for (Nd4jLong c = 0; c < numPartitions; c++) {
+                    auto v = offsets[c * numPartitions + p];
+                    offsets[c * numPartitions + p] = running;
+                    running += v;
+                }
+            }
+            bounds[numPartitions] = running;
+
+            std::vector<Nd4jLong> order(length);
+
+            auto scatter = PRAGMA_THREADS_FOR {
+                for (auto c = start; c < stop; c++) {
+                    auto local = offsets.data() + c * numPartitions;
+                    for (Nd4jLong i = c * chunk; i < sd::math::nd4j_min<Nd4jLong>(length, (c + 1) * chunk); i++)
+                        order[local[partitionIds[i]]++] = i;
+                }
+            };
+
+            samediff::Threads::parallel_tad(scatter, 0, numPartitions);
+
+            std::vector<uint16_t>().swap(partitionIds);
+
+            // every partition is owned by a single thread, so tables are built without synchronization
+            _partitions.resize(numPartitions);
+            std::vector<int8_t> isFirst(length, 0);
+
+            auto build = PRAGMA_THREADS_FOR {
+                for (auto p = start; p < stop; p++) {
+                    auto &partition = _partitions[p];
+
+                    for (Nd4jLong pos = bounds[p]; pos < bounds[p + 1]; pos++) {
+                        const auto i = order[pos];
+                        const auto h = hash(keys[i]);
+
+                        auto slot = find(keys[i], partition, h);
+                        if (slot >= 0) {
+                            partition.count[slot]++;
+                            continue;
+                        }
+
+                        if (2 * (partition.size + 1) > static_cast<Nd4jLong>(partition.first.size()))
+                            grow(partition, keys);
+
+                        const Nd4jLong capacity = partition.first.size();
+                        slot = h & (capacity - 1);
+                        while (partition.first[slot] >= 0)
+                            slot = (slot + 1) & (capacity - 1);
+
+                        partition.first[slot] = i;
+                        partition.count[slot] = 1;
+                        partition.size++;
+                        isFirst[i] = 1;
+                    }
+                }
+            };
+
+            samediff::Threads::parallel_tad(build, 0, numPartitions);
+
+            std::vector<Nd4jLong>().swap(order);
+
+            // merge: first occurrences in order of appearance define ranks of distinct values
+            Nd4jLong numDistinct = 0;
+            for (const auto &partition : _partitions)
+                numDistinct += partition.size;
+
+            _firsts.resize(numDistinct);
+            ParallelCompaction::apply(length, [&](Nd4jLong i) -> bool { return isFirst[i] != 0; }, [&](Nd4jLong i, Nd4jLong position) { _firsts[position] = i; });
+
+            std::vector<int8_t>().swap(isFirst);
+
+            for (auto &partition : _partitions)
+                partition.rank.assign(partition.first.size(), -1);
+
+            _counts.resize(numDistinct);
+
+            auto rank = PRAGMA_THREADS_FOR {
+                for (auto r = start; r < stop; r++) {
+                    const auto &value = keys[_firsts[r]];
+                    const auto h = hash(value);
+                    auto &partition = _partitions[partitionOf(h)];
+                    auto slot = find(value, partition, h);
+
+                    partition.rank[slot] = r;
+                    _counts[r] = partition.count[slot];
+                }
+            };
+
+            samediff::Threads::parallel_for(rank, 0, numDistinct);
+        }
+
+        ~ParallelHashTable() = default;
+
+        /**
+         * Number of distinct values
+         */
+        Nd4jLong size() const {
+            return _firsts.size();
+        }
+
+        /**
+         * Indices of first occurrences of distinct values, in order of appearance
+         */
+        const std::vector<Nd4jLong>& firstIndices() const {
+            return _firsts;
+        }
+
+        /**
+         * Number of occurrences of every distinct value, in order of first appearance
+         */
+        const std::vector<Nd4jLong>& counts() const {
+            return _counts;
+        }
+
+        /**
+         * Returns position of given value in order of first appearance, or -1 if there's no such value. Thread-safe
+         */
+        Nd4jLong rankOf(const T &value) const {
+            const auto h = hash(value);
+            const auto &partition = _partitions[partitionOf(h)];
+            auto slot = find(value, partition, h);
+
+            return slot < 0 ? -1 : partition.rank[slot];
+        }
+
+        bool contains(const T &value) const {
+            return rankOf(value) >= 0;
+        }
+    };
+}
+
+#endif //SD_PARALLEL_HASH_TABLE_H
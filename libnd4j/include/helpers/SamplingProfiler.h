@@ -0,0 +1,130 @@
+/*******************************************************************************
+ * Copyright (c) 2020 Konduit K.K.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#ifndef SD_SAMPLING_PROFILER_H
+#define SD_SAMPLING_PROFILER_H
+
+#include <system/pointercast.h>
+#include <system/dll.h>
+#include <atomic>
+#include <mutex>
+#include <vector>
+#include <map>
+#include <string>
+
+namespace sd {
+    /**
+     * Describes op currently executed by a thread. Markers form a stack via parent pointer
+     */
+    struct ND4J_EXPORT OpMarker {
+        const char* name = nullptr;
+        Nd4jLong hash = 0L;
+        int nodeId = -1;
+        int opNum = -1;
+        const OpMarker* parent = nullptr;
+
+        // set by kernels if non-finite values were produced, see FiniteGuard
+        std::atomic<bool>* nonFinite = nullptr;
+    };
+
+    /**
+     * RAII helper: marks calling thread as executing given op until the end of scope.
+     * Costs a couple of thread-local stores, so it's fine to keep it always on.
+     */
+    class ND4J_EXPORT ScopedOpMarker {
+    private:
+        OpMarker _marker;
+    public:
+        ScopedOpMarker(const char* name, Nd4jLong hash, int nodeId, int opNum, std::atomic<bool>* nonFinite = nullptr);
+        ~ScopedOpMarker();
+
+        ScopedOpMarker(const ScopedOpMarker&) = delete;
+        ScopedOpMarker& operator=(const ScopedOpMarker&) = delete;
+    };
+
+    /**
+     * This class provides SIGPROF-based sampling profiler (POSIX only).
+     *
+     * Every sample copies marker stack of the interrupted thread into its own ring buffer,
+     * and foldedStacks() aggregates them into "root;...;leaf count" lines, suitable for flamegraph.pl
+     */
+    class ND4J_EXPORT SamplingProfiler {
+    public:
+        class ThreadSamples;
+
+    private:
+        std::atomic<bool> _running{false};
+        std::atomic<Nd4jLong> _unattributed{0L};
+        int _frequency = 0;
+
+        std::mutex _lock;
+        std::vector<ThreadSamples*> _threads;
+        std::map<std::string, Nd4jLong> _folded;
+
+        SamplingProfiler() = default;
+        ~SamplingProfiler();
+
+        void drain();
+    public:
+        static SamplingProfiler& getInstance();
+
+        /**
+         * This method starts sampling with given frequency, in samples per second of CPU time.
+         * Returns FALSE if profiler isn't supported on this platform, or timer can't be set
+         */
+        bool start(int frequency);
+        void stop();
+        bool isRunning();
+
+        /**
+         * This method allocates ring buffer for the calling thread, if it has none yet.
+         * Samples of threads without buffers are counted as unattributed
+         */
+        void attachThread();
+
+        /**
+         * This method releases ring buffer of the calling thread, samples collected so far are kept.
+         * Called automatically when thread exits
+         */
+        void detachThread();
+
+        /**
+         * This method is called from signal handler only
+         */
+        void sample();
+
+        /**
+         * Marker of the op executed by calling thread, or nullptr
+         */
+        static const OpMarker* currentMarker();
+
+        /**
+         * This method replaces marker of the calling thread and returns previous one.
+         * Used by ThreadPool workers to attribute their samples to the op which dispatched the task
+         */
+        static const OpMarker* swapMarker(const OpMarker* marker);
+
+        /**
+         * This method returns samples aggregated since last reset(), in folded stacks format
+         */
+        std::string foldedStacks();
+
+        Nd4jLong totalSamples();
+        void reset();
+    };
+}
+
+#endif //SD_SAMPLING_PROFILER_H
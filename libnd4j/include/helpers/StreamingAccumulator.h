@@ -0,0 +1,93 @@
+/*******************************************************************************
+ * Copyright (c) 2020 Konduit K.K.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+#ifndef SD_STREAMING_ACCUMULATOR_H
+#define SD_STREAMING_ACCUMULATOR_H
+
+#include <array/NDArray.h>
+#include <system/dll.h>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace sd {
+    /**
+     * N-way sum of arrays that arrive one by one, i.e. gradients received by a parameter server.
+     *
+     * Accumulator is split into tiles, every tile has its own mutex. add() try-locks tiles and skips
+     * busy ones, coming back to them later, so concurrent producers work on different parts of the buffer
+     * instead of waiting for each other. Half types are accumulated in FLOAT32.
+     *
+     * Every tile counts arrays added to it under its mutex, so average() divides each tile by the number of
+     * arrays that tile actually holds, even if add() runs concurrently.
+     */
+    class ND4J_EXPORT StreamingAccumulator {
+    public:
+        static const Nd4jLong TILE = 8192;
+
+        StreamingAccumulator(sd::DataType dataType, Nd4jLong length);
+        ~StreamingAccumulator() = default;
+
+        StreamingAccumulator(const StreamingAccumulator&) = delete;
+        StreamingAccumulator& operator=(const StreamingAccumulator&) = delete;
+
+        /**
+         * This method adds array to the accumulator. Thread-safe
+         */
+        void add(const NDArray &array);
+
+        /**
+         * These methods store current sum (or sum divided by number of added arrays) into target.
+         * Can be called concurrently with add(), every tile is then stored as of some point in time
+         */
+        void sum(NDArray &target);
+        void average(NDArray &target);
+
+        /**
+         * This method zeroes accumulator. Shouldn't be called concurrently with add()
+         */
+        void reset();
+
+        Nd4jLong count() const;
+        Nd4jLong length() const;
+        sd::DataType dataType() const;
+
+    private:
+        void validate(const NDArray &array) const;
+        void store(NDArray &target, bool average);
+
+        template <typename F>
+        void forEachTile(F func);
+
+        sd::DataType _dataType;
+        Nd4jLong _length;
+        Nd4jLong _numTiles;
+
+        // FLOAT32 or DOUBLE values, depending on _dataType
+        std::vector<int8_t> _buffer;
+
+        // guards tile of the buffer, and number of arrays added to it
+        std::unique_ptr<std::mutex[]> _locks;
+        std::vector<Nd4jLong> _tileCounts;
+
+        std::atomic<Nd4jLong> _count;
+        std::atomic<Nd4jLong> _cursor;
+    };
+}
+
+#endif //SD_STREAMING_ACCUMULATOR_H
@@ -24,26 +24,58 @@
 #include <helpers/ShapeUtils.h>
 #include <exceptions/datatype_exception.h>
 #include <execution/Threads.h>
+#include <helpers/MixedPrecision.h>
+#include <helpers/FiniteGuard.h>
+#include <array/DataTypeUtils.h>
+#include <memory>
 
 
 namespace sd {
 
+//////////////////////////////////////////////////////////////////////////////
+// raw view of GemmEpilogue: bias is contiguous [N], residual is [M, N] with any strides, both of type T passed to apply()
+struct EpilogueKernel {
+    const void* bias = nullptr;
+    const void* residual = nullptr;
+    Nd4jLong residualStrideM = 0;
+    Nd4jLong residualStrideN = 0;
+    GemmEpilogue::Activation activation = GemmEpilogue::NONE;
+    double cutoff = 0.0;
+
+    template <typename T, typename TA>
+    FORCEINLINE TA apply(TA value, const Nd4jLong m, const Nd4jLong n) const {
+        if (bias != nullptr)
+            value = value + static_cast<TA>(reinterpret_cast<const T*>(bias)[n]);
+
+        value = GemmEpilogue::activate<TA>(value, activation, static_cast<TA>(cutoff));
+
+        if (residual != nullptr)
+            value = value + static_cast<TA>(reinterpret_cast<const T*>(residual)[m * residualStrideM + n * residualStrideN]);
+
+        return value;
+    }
+};
+
 //////////////////////////////////////////////////////////////////////////////
 // MXK x KxN = MxN              -> actual sequence of axes doesn't matter
-template <typename T1, typename T2, typename T3>
-static  void usualGemm(const NDArray* vA, const NDArray* vB, NDArray* vC,
+// TA is type of accumulator, it differs from T3 only for HALF/BFLOAT16 with fp32 accumulation
+// vEpilogue is optional EpilogueKernel over T3 operands, applied to every element right after its dot product
+template <typename T1, typename T2, typename T3, typename TA>
+static  void usualGemm_(const NDArray* vA, const NDArray* vB, NDArray* vC,
                                  const int aMaxis, const int aKaxis, const int bKaxis, const int bNaxis, const int cMaxis, const int cNaxis,
-                                 const double alpha, const double beta) {
+                                 const double alpha, const double beta, const void* vEpilogue) {
 
     const T1* A = vA->bufferAsT<T1>();
     const T2* B = vB->bufferAsT<T2>();
           T3* C = vC->bufferAsT<T3>();
 
-    const T3 alphaZ = alpha;
-    const T3 betaZ  = beta;
+    const TA alphaZ = alpha;
+    const TA betaZ  = beta;
 
     const bool betaPersent = beta;
 
+    const auto epilogue = reinterpret_cast<const EpilogueKernel*>(vEpilogue);
+
     const Nd4jLong* aShapeInfo = vA->shapeInfo();
     const Nd4jLong* bShapeInfo = vB->shapeInfo();
     const Nd4jLong* cShapeInfo = vC->shapeInfo();
@@ -56,8 +88,12 @@ static  void usualGemm(const NDArray* vA, const NDArray* vB, NDArray* vC,
 
     const int K = vA->sizeAt(aKaxis);
 
+    // every C value ends K-long dot product, so checking it right at the store costs nothing measurable
+    const bool armed = FiniteGuard::isArmed();
+
     auto func = PRAGMA_THREADS_FOR {
 
+        bool nonFinite = false;
         std::vector<Nd4jLong> aCoords(2), bCoords(2), cCoords(2);
 
         for (auto i = start; i < stop; ++i) {
@@ -76,38 +112,56 @@ static  void usualGemm(const NDArray* vA, const NDArray* vB, NDArray* vC,
             auto aOffset = shape::getOffset(aShapeInfo, aCoords.data());
             auto bOffset = shape::getOffset(bShapeInfo, bCoords.data());
 
-            T3 val = A[aOffset] * B[bOffset];                       // first iteration
+            TA val = static_cast<TA>(A[aOffset]) * static_cast<TA>(B[bOffset]);       // first iteration
 
             for (int j = 1; j < K; ++j) {                          // rest iterations
                 aOffset += shape::stride(aShapeInfo)[aKaxis];
                 bOffset += shape::stride(bShapeInfo)[bKaxis];
-                val = val + A[aOffset] * B[bOffset];
+                val = val + static_cast<TA>(A[aOffset]) * static_cast<TA>(B[bOffset]);
             }
 
             auto cOffset = shape::getOffset(cShapeInfo, cCoords.data());
 
-            if(betaPersent)
-                C[cOffset] = alphaZ * val + betaZ * C[cOffset];
-            else
-                C[cOffset] = alphaZ * val;
+            TA result = betaPersent ? alphaZ * val + betaZ * static_cast<TA>(C[cOffset]) : alphaZ * val;
+
+            if(epilogue != nullptr)
+                result = epilogue->apply<T3, TA>(result, cCoords[cMaxis], cCoords[cNaxis]);
+
+            C[cOffset] = static_cast<T3>(result);
+
+            if (armed)
+                nonFinite |= FiniteGuard::isNonFinite<T3>(C[cOffset]);
         }
+
+        if (nonFinite)
+            FiniteGuard::report();
     };
 
     samediff::Threads::parallel_tad(func, 0, cLen);
 }
 
+template <typename T1, typename T2, typename T3>
+static  void usualGemm(const NDArray* vA, const NDArray* vB, NDArray* vC,
+                                 const int aMaxis, const int aKaxis, const int bKaxis, const int bNaxis, const int cMaxis, const int cNaxis,
+                                 const double alpha, const double beta, const void* vEpilogue = nullptr) {
+    if (MixedPrecision::isFp32Accumulation())
+        usualGemm_<T1, T2, T3, typename AccumulatorType<T3>::type>(vA, vB, vC, aMaxis, aKaxis, bKaxis, bNaxis, cMaxis, cNaxis, alpha, beta, vEpilogue);
+    else
+        usualGemm_<T1, T2, T3, T3>(vA, vB, vC, aMaxis, aKaxis, bKaxis, bNaxis, cMaxis, cNaxis, alpha, beta, vEpilogue);
+}
+
 
 //////////////////////////////////////////////////////////////////////////////
 // MXN x N = M  -> actual sequence of {M,N} axes doesn't matter
-template <typename T1, typename T2, typename T3>
-static  void usualGemv(const NDArray* vA, const NDArray* vX, NDArray* vY, const int incx, const int incy, const int aMaxis, const double alpha, const double beta) {
+template <typename T1, typename T2, typename T3, typename TA>
+static  void usualGemv_(const NDArray* vA, const NDArray* vX, NDArray* vY, const int incx, const int incy, const int aMaxis, const double alpha, const double beta) {
 
     const T1* A = vA->bufferAsT<T1>();
     const T2* X = vX->bufferAsT<T2>();
           T3* Y = vY->bufferAsT<T3>();
 
-    const T3 alphaZ = alpha;
-    const T3 betaZ  = beta;
+    const TA alphaZ = alpha;
+    const TA betaZ  = beta;
 
     const bool betaPersent = beta;
 
@@ -129,47 +183,63 @@ static  void usualGemv(const NDArray* vA, const NDArray* vX, NDArray* vY, const
             auto aOffset = i * aMstride;
             auto xOffset = 0;
 
-            T3 val = A[aOffset] * X[xOffset];                       // first iteration
+            TA val = static_cast<TA>(A[aOffset]) * static_cast<TA>(X[xOffset]);       // first iteration
 
             for (int j = 1; j < N; ++j) {                          // rest iterations
                 aOffset += aNstride;
                 xOffset += incx;
-                val = val + A[aOffset] * X[xOffset];
+                val = val + static_cast<TA>(A[aOffset]) * static_cast<TA>(X[xOffset]);
             }
 
             auto yOffset = i * incy;
 
             if(betaPersent)
-                Y[yOffset] = alphaZ * val + betaZ * Y[yOffset];
+                Y[yOffset] = static_cast<T3>(alphaZ * val + betaZ * static_cast<TA>(Y[yOffset]));
             else
-                Y[yOffset] = alphaZ * val;
+                Y[yOffset] = static_cast<T3>(alphaZ * val);
         }
     };
 
     samediff::Threads::parallel_tad(func, 0, M);
 }
 
+template <typename T1, typename T2, typename T3>
+static  void usualGemv(const NDArray* vA, const NDArray* vX, NDArray* vY, const int incx, const int incy, const int aMaxis, const double alpha, const double beta) {
+    if (MixedPrecision::isFp32Accumulation())
+        usualGemv_<T1, T2, T3, typename AccumulatorType<T3>::type>(vA, vX, vY, incx, incy, aMaxis, alpha, beta);
+    else
+        usualGemv_<T1, T2, T3, T3>(vA, vX, vY, incx, incy, aMaxis, alpha, beta);
+}
+
 //////////////////////////////////////////////////////////////////////////////
 // (X*Y) = Z[0]
-template <typename T1, typename T2, typename T3>
-static void usualDot(const Nd4jLong length, const double alpha, const void* vX, const Nd4jLong incx, const void* vY, const Nd4jLong incy, const double beta, void* vZ) {
+template <typename T1, typename T2, typename T3, typename TA>
+static void usualDot_(const Nd4jLong length, const double alpha, const void* vX, const Nd4jLong incx, const void* vY, const Nd4jLong incy, const double beta, void* vZ) {
 
     T1* X = reinterpret_cast<T1*>(const_cast<void*>(vX));
     T2* Y = reinterpret_cast<T2*>(const_cast<void*>(vY));
     T3* Z = reinterpret_cast<T3*>(vZ);
-    T3 alphaZ(alpha), betaZ(beta);
+    TA alphaZ(alpha), betaZ(beta);
 
     const bool betaPersent = beta;
 
-    T3 sum = 0;
+    TA sum = 0;
     PRAGMA_OMP_PARALLEL_FOR_ARGS(OMP_IF(length > Environment::getInstance().elementwiseThreshold()) schedule(guided) reduction(OMP_SUMT:sum))
     for(Nd4jLong i = 0; i < length; ++i)
-            sum += X[i * incx] * Y[i * incy];
+            sum += static_cast<TA>(X[i * incx]) * static_cast<TA>(Y[i * incy]);
 
     if(betaPersent)
-        *Z = alphaZ * sum + betaZ * *Z;
+        *Z = static_cast<T3>(alphaZ * sum + betaZ * static_cast<TA>(*Z));
     else
-        *Z = alphaZ * sum;
+        *Z = static_cast<T3>(alphaZ * sum);
+}
+
+template <typename T1, typename T2, typename T3>
+static void usualDot(const Nd4jLong length, const double alpha, const void* vX, const Nd4jLong incx, const void* vY, const Nd4jLong incy, const double beta, void* vZ) {
+    if (MixedPrecision::isFp32Accumulation())
+        usualDot_<T1, T2, T3, typename AccumulatorType<T3>::type>(length, alpha, vX, incx, vY, incy, beta, vZ);
+    else
+        usualDot_<T1, T2, T3, T3>(length, alpha, vX, incx, vY, incy, beta, vZ);
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -267,6 +337,10 @@ NDArray* MmulHelper::mmulMxM(const NDArray* A, const NDArray* B, NDArray* C, con
             BlasHelper::getInstance().dgemm()(blasOrder, transAblas, transBblas, M, N, K, (double) alpha, pA->bufferAsT<double>(), lda, pB->bufferAsT<double>(), ldb, (double) beta, pC->bufferAsT<double>(), ldc);
         }
 
+        // BLAS output can't be checked on the fly, so guard mode costs one extra pass here
+        if (FiniteGuard::isArmed() && !pC->isFinite())
+            FiniteGuard::report();
+
         if(pC != C) {
             C->assign(pC);
             delete pC;
@@ -280,6 +354,146 @@ NDArray* MmulHelper::mmulMxM(const NDArray* A, const NDArray* B, NDArray* C, con
     return C;
 }
 
+//////////////////////////////////////////////////////////////////////////////
+// post-ops over whole C computed in T and stored as Z, threads take blocks of rows, each block is walked in memory order of C
+template <typename T, typename Z>
+static void epilogueBlocks_(const NDArray& source, NDArray& target, const void* vEpilogue, const Nd4jLong rowsPerBlock) {
+
+    typedef typename AccumulatorType<T>::type TA;
+
+    const auto epilogue = reinterpret_cast<const EpilogueKernel*>(vEpilogue);
+
+    const T* x = source.bufferAsT<T>();
+          Z* z = target.bufferAsT<Z>();
+
+    const Nd4jLong M = source.sizeAt(0);
+    const Nd4jLong N = source.sizeAt(1);
+    const Nd4jLong xStrideM = source.strideAt(0), xStrideN = source.strideAt(1);
+    const Nd4jLong zStrideM = target.strideAt(0), zStrideN = target.strideAt(1);
+    const bool rowMajor = zStrideN <= zStrideM;
+
+    // each row (column) of block is checked right after it was written
+    const bool armed = FiniteGuard::isArmed();
+
+    auto func = PRAGMA_THREADS_FOR {
+
+        bool nonFinite = false;
+
+        for (auto block = start; block < stop; ++block) {
+            const Nd4jLong first = block * rowsPerBlock;
+            const Nd4jLong last = sd::math::nd4j_min<Nd4jLong>(M, first + rowsPerBlock);
+
+            if (rowMajor) {
+                for (Nd4jLong m = first; m < last; ++m) {
+                    for (Nd4jLong n = 0; n < N; ++n)
+                        z[m * zStrideM + n * zStrideN] = static_cast<Z>(epilogue->apply<T, TA>(static_cast<TA>(x[m * xStrideM + n * xStrideN]), m, n));
+
+                    if (armed)
+                        nonFinite |= FiniteGuard::scan<Z>(z + m * zStrideM, N, zStrideN);
+                }
+            }
+            else {
+                for (Nd4jLong n = 0; n < N; ++n) {
+                    for (Nd4jLong m = first; m < last; ++m)
+                        z[m * zStrideM + n * zStrideN] = static_cast<Z>(epilogue->apply<T, TA>(static_cast<TA>(x[m * xStrideM + n * xStrideN]), m, n));
+
+                    if (armed)
+                        nonFinite |= FiniteGuard::scan<Z>(z + first * zStrideM + n * zStrideN, last - first, zStrideM);
+                }
+            }
+        }
+
+        if (nonFinite)
+            FiniteGuard::report();
+    };
+
+    samediff::Threads::parallel_tad(func, 0, (M + rowsPerBlock - 1) / rowsPerBlock);
+}
+
+// epilogue pass works on blocks of C rows sized to stay in L2
+static const Nd4jLong EPILOGUE_BLOCK_BYTES = 256 * 1024;
+
+//////////////////////////////////////////////////////////////////////////////
+NDArray* MmulHelper::mmulFused(const NDArray* A, const NDArray* B, NDArray* C, const GemmEpilogue& epilogue, const double alpha, const double beta) {
+
+    if(A->rankOf() != 2 || B->rankOf() != 2)
+        throw std::runtime_error("MmulHelper::mmulFused: A and B arrays must have rank 2 !");
+    const auto M = A->sizeAt(0);
+    const auto K = A->sizeAt(1);
+    const auto N = B->sizeAt(1);
+
+    if(B->sizeAt(0) != K)
+        throw std::runtime_error("MmulHelper::mmulFused: B array has wrong number of rows !");
+    if(C != nullptr && (C->rankOf() != 2 || C->sizeAt(0) != M || C->sizeAt(1) != N))
+        throw std::runtime_error("MmulHelper::mmulFused: C array has wrong shape !");
+    if(epilogue.bias != nullptr && epilogue.bias->lengthOf() != N)
+        throw std::runtime_error("MmulHelper::mmulFused: bias length must be equal to number of C columns !");
+    if(epilogue.residual != nullptr && (epilogue.residual->rankOf() != 2 || epilogue.residual->sizeAt(0) != M || epilogue.residual->sizeAt(1) != N))
+        throw std::runtime_error("MmulHelper::mmulFused: residual array must have the same shape as C !");
+
+    if(C == nullptr)
+        C = new NDArray('c', {M, N}, A->dataType(), A->getContext());
+
+    if (C->isEmpty())
+        return C;
+
+    if (!C->isR())
+        throw datatype_exception::build("mmulFused supports floating point output types only", C->dataType());
+
+    // fused kernels (and mmul as well) need A and B of the same floating point type, so mixed or integer operands are cast to C type first
+    const bool castOperands = A->dataType() != B->dataType() || !A->isR();
+    std::unique_ptr<NDArray> castA(castOperands && A->dataType() != C->dataType() ? new NDArray(A->cast(C->dataType())) : nullptr);
+    std::unique_ptr<NDArray> castB(castOperands && B->dataType() != C->dataType() ? new NDArray(B->cast(C->dataType())) : nullptr);
+
+    if (castA)
+        A = castA.get();
+    if (castB)
+        B = castB.get();
+
+    const auto type = A->dataType();
+
+    if (epilogue.isEmpty() && C->dataType() == type)
+        return mmulMxM(A, B, C, alpha, beta, 'f');
+
+    // post-op operands are brought to compute type once, bias to contiguous layout as well
+    std::unique_ptr<NDArray> bias(epilogue.bias == nullptr || (epilogue.bias->dataType() == type && epilogue.bias->ews() == 1) ? nullptr : new NDArray(epilogue.bias->cast(type).dup('c')));
+    std::unique_ptr<NDArray> residual(epilogue.residual == nullptr || epilogue.residual->dataType() == type ? nullptr : new NDArray(epilogue.residual->cast(type)));
+
+    auto pBias = bias ? bias.get() : epilogue.bias;
+    auto pResidual = residual ? residual.get() : epilogue.residual;
+
+    EpilogueKernel kernel;
+    kernel.bias = pBias == nullptr ? nullptr : pBias->buffer();
+    kernel.residual = pResidual == nullptr ? nullptr : pResidual->buffer();
+    kernel.residualStrideM = pResidual == nullptr ? 0 : pResidual->strideAt(0);
+    kernel.residualStrideN = pResidual == nullptr ? 0 : pResidual->strideAt(1);
+    kernel.activation = epilogue.activation;
+    kernel.cutoff = epilogue.cutoff;
+
+    const bool blas = BlasHelper::getInstance().hasGEMM(type) && (type == DataType::FLOAT32 || type == DataType::DOUBLE);
+
+    if (!blas && C->dataType() == type) {
+        // no BLAS: post-ops are applied to every element right after its dot product
+        BUILD_SINGLE_SELECTOR_THRICE(type, usualGemm, (A, B, C, 0, 1, 0, 1, 0, 1, alpha, beta, &kernel), FLOAT_TYPES);
+        return C;
+    }
+
+    // BLAS: whole product is done by one gemm, so B is packed once, post-ops follow in one blocked pass over C
+    // output cast: product is computed in A type first
+    std::unique_ptr<NDArray> work(C->dataType() == type ? nullptr : new NDArray('c', {M, N}, type, C->getContext()));
+    if (work && beta != 0.0)
+        work->assign(C);
+
+    mmulMxM(A, B, work ? work.get() : C, alpha, beta, 'f');
+
+    // blocks fit L2, and there are at least as many of them as threads
+    const Nd4jLong rowsPerThread = (M + sd::Environment::getInstance().maxMasterThreads() - 1) / sd::Environment::getInstance().maxMasterThreads();
+    const Nd4jLong rowsPerBlock = sd::math::nd4j_max<Nd4jLong>(1, sd::math::nd4j_min<Nd4jLong>(rowsPerThread, EPILOGUE_BLOCK_BYTES / (N * DataTypeUtils::sizeOf(type))));
+    BUILD_DOUBLE_SELECTOR(type, C->dataType(), epilogueBlocks_, (work ? *work : *C, *C, &kernel, rowsPerBlock), FLOAT_TYPES, FLOAT_TYPES);
+
+    return C;
+}
+
 ////////////////////////////////////////////////////////////////////////////
 // MXN x N = M
 NDArray* MmulHelper::mmulMxV(const NDArray* A, const NDArray* X, sd::NDArray* Y, const double alpha, const double beta, const char outOrder) {
@@ -404,8 +618,8 @@ NDArray* MmulHelper::dot(const NDArray* X, const NDArray* Y, sd::NDArray* Z, con
 // [bS,M,K] x    [K,N] = [bS,M,N]
 //    [M,K] x [bS,K,N] = [bS,M,N]
 // bS could stand for several axes
-template <typename T1, typename T2, typename T3>
-static void batchedGemm(const NDArray* vA, const NDArray* vB,  NDArray* vC,
+template <typename T1, typename T2, typename T3, typename TA>
+static void batchedGemm_(const NDArray* vA, const NDArray* vB,  NDArray* vC,
                         const int* aBatchDims, const int* bBatchDims, const int* cBatchDims,
                         const int aMaxis, const int aKaxis, const int bKaxis, const int bNaxis, const int cMaxis, const int cNaxis,
                         const double alpha, const double beta) {
@@ -414,8 +628,8 @@ static void batchedGemm(const NDArray* vA, const NDArray* vB,  NDArray* vC,
     const T2* B = vB->bufferAsT<T2>();
           T3* C = vC->bufferAsT<T3>();
 
-    const T3 alphaZ = alpha;
-    const T3 betaZ  = beta;
+    const TA alphaZ = alpha;
+    const TA betaZ  = beta;
 
     const bool betaPersent = beta;
 
@@ -431,8 +645,12 @@ static void batchedGemm(const NDArray* vA, const NDArray* vB,  NDArray* vC,
 
     const int K = vA->sizeAt(aKaxis);
 
+    // every C value ends K-long dot product, so checking it right at the store costs nothing measurable
+    const bool armed = FiniteGuard::isArmed();
+
     auto func = PRAGMA_THREADS_FOR {
 
+        bool nonFinite = false;
         std::vector<int> aCoords(aRank), bCoords(bRank), cCoords(cRank);
 
         for (auto i = start; i < stop; ++i) {
@@ -460,26 +678,43 @@ static void batchedGemm(const NDArray* vA, const NDArray* vB,  NDArray* vC,
             auto aOffset = shape::getOffset(aShapeInfo, aCoords.data());
             auto bOffset = shape::getOffset(bShapeInfo, bCoords.data());
 
-            T3 val = A[aOffset] * B[bOffset];                       // first iteration
+            TA val = static_cast<TA>(A[aOffset]) * static_cast<TA>(B[bOffset]);       // first iteration
 
             for (int j = 1; j < K; ++j) {                          // rest iterations
                 aOffset += shape::stride(aShapeInfo)[aKaxis];
                 bOffset += shape::stride(bShapeInfo)[bKaxis];
-                val = val + A[aOffset] * B[bOffset];
+                val = val + static_cast<TA>(A[aOffset]) * static_cast<TA>(B[bOffset]);
             }
 
             auto cOffset = shape::getOffset(cShapeInfo, cCoords.data());
 
             if(betaPersent)
-                C[cOffset] = alphaZ * val + betaZ * C[cOffset];
+                C[cOffset] = static_cast<T3>(alphaZ * val + betaZ * static_cast<TA>(C[cOffset]));
             else
-                C[cOffset] = alphaZ * val;
+                C[cOffset] = static_cast<T3>(alphaZ * val);
+
+            if (armed)
+                nonFinite |= FiniteGuard::isNonFinite<T3>(C[cOffset]);
         }
+
+        if (nonFinite)
+            FiniteGuard::report();
     };
 
     samediff::Threads::parallel_tad(func, 0, cLen);
 }
 
+template <typename T1, typename T2, typename T3>
+static void batchedGemm(const NDArray* vA, const NDArray* vB,  NDArray* vC,
+                        const int* aBatchDims, const int* bBatchDims, const int* cBatchDims,
+                        const int aMaxis, const int aKaxis, const int bKaxis, const int bNaxis, const int cMaxis, const int cNaxis,
+                        const double alpha, const double beta) {
+    if (MixedPrecision::isFp32Accumulation())
+        batchedGemm_<T1, T2, T3, typename AccumulatorType<T3>::type>(vA, vB, vC, aBatchDims, bBatchDims, cBatchDims, aMaxis, aKaxis, bKaxis, bNaxis, cMaxis, cNaxis, alpha, beta);
+    else
+        batchedGemm_<T1, T2, T3, T3>(vA, vB, vC, aBatchDims, bBatchDims, cBatchDims, aMaxis, aKaxis, bKaxis, bNaxis, cMaxis, cNaxis, alpha, beta);
+}
+
 //////////////////////////////////////////////////////////////////////////
 // [bS,M,K] x [bS,K,N] = [bS,M,N]
 // [bS,M,K] x    [K,N] = [bS,M,N]
@@ -1046,4 +1046,29 @@ NDArray* MmulHelper::mmulNxNold2(const NDArray* A, const NDArray* B, NDArray* C,
 //BUILD_TRIPLE_TEMPLATE(template void usualGemv, (const dim3 &blocksPerGrid, const dim3 &threadsPerBlock, cudaStream_t *stream, const bool transA, const int M, const int N, const double alpha, const void* vA, const int lda, const void* vB, const int incx, const double beta, void* vC, const int incy), NUMERIC_TYPES, NUMERIC_TYPES, FLOAT_TYPES);
 //BUILD_TRIPLE_TEMPLATE(template void usualDot,  (const dim3 &blocksPerGrid, const dim3 &threadsPerBlock, cudaStream_t *stream, const Nd4jLong length, const double alpha, const void* vX, const Nd4jLong incx, const void* vY, const Nd4jLong incy, const double beta, void* vZ), NUMERIC_TYPES, NUMERIC_TYPES, FLOAT_TYPES);
 
+//////////////////////////////////////////////////////////////////////////
+// there are no fused kernels for cuda yet, so post-ops are applied as separate passes
+NDArray* MmulHelper::mmulFused(const NDArray* A, const NDArray* B, NDArray* C, const GemmEpilogue& epilogue, const double alpha, const double beta) {
+
+    if(A->rankOf() != 2 || B->rankOf() != 2)
+        throw std::runtime_error("MmulHelper::mmulFused: A and B arrays must have rank 2 !");
+
+    if(C != nullptr && C->dataType() != A->dataType()) {
+        NDArray temp('f', {A->sizeAt(0), B->sizeAt(1)}, A->dataType(), A->getContext());
+        if(beta != 0.0)
+            temp.assign(C);
+
+        mmulMxM(A, B, &temp, alpha, beta, 'f');
+        applyEpilogue(temp, *C, epilogue);
+        return C;
+    }
+
+    C = mmulMxM(A, B, C, alpha, beta, 'f');
+
+    if(!epilogue.isEmpty())
+        applyEpilogue(*C, *C, epilogue);
+
+    return C;
+}
+
 }
\ No newline at end of file
@@ -0,0 +1,151 @@
+/*******************************************************************************
+ * Copyright (c) 2020 Konduit K.K.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#include <helpers/CooScatter.h>
+#include <algorithm>
+#include <memory>
+
+namespace sd {
+    template <typename I>
+    static Nd4jLong linearize_(const void *vcoords, Nd4jLong numRows, int width, const Nd4jLong *shape, const Nd4jLong *multipliers, Nd4jLong *linear) {
+        auto coords = reinterpret_cast<const I*>(vcoords);
+
+        auto func = PRAGMA_REDUCE_LONG {
+            for (auto r = start; r < stop; r++)
+                linear[r] = 0;
+
+            // one dimension at a time, so the inner loop runs over rows and vectorizes
+            Nd4jLong bad = 0;
+            for (int p = 0; p < width; p++) {
+                const Nd4jLong dim = shape[p];
+                const Nd4jLong multiplier = multipliers[p];
+
+                PRAGMA_OMP_SIMD_SUM(bad)
+                for (auto r = start; r < stop; r++) {
+                    const auto c = static_cast<Nd4jLong>(coords[r * width + p]);
+                    linear[r] += c * multiplier;
+                    bad += c < 0 || c >= dim ? 1 : 0;
+                }
+            }
+
+            if (bad == 0)
+                return 0;
+
+            // rare case: rows with coordinates out of range are marked, so they're never written
+            int64_t invalid = 0;
+            for (auto r = start; r < stop; r++)
+                for (int p = 0; p < width; p++) {
+                    const auto c = static_cast<Nd4jLong>(coords[r * width + p]);
+                    if (c < 0 || c >= shape[p]) {
+                        linear[r] = -1;
+                        invalid++;
+                        break;
+                    }
+                }
+
+            return invalid;
+        };
+
+        return samediff::Threads::parallel_long(func, LAMBDA_AL { return _old + _new; }, 0, numRows);
+    }
+
+    CooScatter::CooScatter(const NDArray &coords, const std::vector<Nd4jLong> &shape) {
+        if (!coords.isZ())
+            throw std::invalid_argument("CooScatter: coordinates must have integer data type");
+
+        const int width = static_cast<int>(shape.size());
+        if (width < 1 || width > MAX_RANK || coords.lengthOf() % width != 0)
+            throw std::invalid_argument("CooScatter: length of coordinates array must be a multiple of target rank");
+
+        Nd4jLong multipliers[MAX_RANK];
+        for (int p = width - 1; p >= 0; p--) {
+            multipliers[p] = _range;
+            _range *= shape[p];
+        }
+
+        std::unique_ptr<NDArray> temp(coords.ordering() == 'c' && coords.ews() == 1 ? nullptr : new NDArray(coords.dup('c')));
+        auto source = temp ? temp.get() : &coords;
+
+        _linear.resize(coords.lengthOf() / width);
+        BUILD_SINGLE_SELECTOR(source->dataType(), _numInvalid = linearize_, (source->buffer(), numRows(), width, shape.data(), multipliers, _linear.data()), INTEGER_TYPES);
+
+        auto descents = PRAGMA_REDUCE_LONG {
+            int64_t cnt = 0;
+            for (auto r = start; r < stop; r++)
+                if (_linear[r] < _linear[r - 1])
+                    cnt++;
+
+            return cnt;
+        };
+
+        _sorted = numRows() < 2 || samediff::Threads::parallel_long(descents, LAMBDA_AL { return _old + _new; }, 1, numRows()) == 0;
+
+        group();
+    }
+
+    void CooScatter::group() {
+        const Nd4jLong n = numRows();
+        const Nd4jLong numBuckets = sd::math::nd4j_max<Nd4jLong>(1, sd::math::nd4j_min<Nd4jLong>(sd::math::nd4j_min<Nd4jLong>(n / 4096, _range), 4 * sd::Environment::getInstance().maxMasterThreads()));
+        const Nd4jLong bucketWidth = (_range + numBuckets - 1) / numBuckets;
+
+        _bounds.resize(numBuckets + 1);
+
+        if (_sorted) {
+            // invalid rows are marked with -1, so in sorted input they all precede the first bucket
+            for (Nd4jLong b = 0; b < numBuckets; b++)
+                _bounds[b] = std::lower_bound(_linear.begin(), _linear.end(), b * bucketWidth) - _linear.begin();
+
+            _bounds[numBuckets] = n;
+            return;
+        }
+
+        // stable counting sort of rows by bucket: per-chunk histograms, prefix sums, scatter
+        const Nd4jLong numChunks = numBuckets;
+        const Nd4jLong chunk = (n + numChunks - 1) / numChunks;
+        std::vector<Nd4jLong> histogram(numChunks * numBuckets, 0);
+
+        auto count = PRAGMA_THREADS_FOR {
+            for (auto c = start; c < stop; c++)
+                for (Nd4jLong r = c * chunk; r < sd::math::nd4j_min<Nd4jLong>(n, (c + 1) * chunk); r++)
+                    if (_linear[r] >= 0)
+                        histogram[c * numBuckets + _linear[r] / bucketWidth]++;
+        };
+
+        samediff::Threads::parallel_tad(count, 0, numChunks);
+
+        Nd4jLong position = 0;
+        for (Nd4jLong b = 0; b < numBuckets; b++) {
+            _bounds[b] = position;
+            for (Nd4jLong c = 0; c < numChunks; c++) {
+                const auto cnt = histogram[c * numBuckets + b];
+                histogram[c * numBuckets + b] = position;
+                position += cnt;
+            }
+        }
+        _bounds[numBuckets] = position;
+
+        _order.resize(position);
+
+        auto scatter = PRAGMA_THREADS_FOR {
+            for (auto c = start; c < stop; c++)
+                for (Nd4jLong r = c * chunk; r < sd::math::nd4j_min<Nd4jLong>(n, (c + 1) * chunk); r++)
+                    if (_linear[r] >= 0)
+                        _order[histogram[c * numBuckets + _linear[r] / bucketWidth]++] = r;
+        };
+
+        samediff::Threads::parallel_tad(scatter, 0, numChunks);
+    }
+}
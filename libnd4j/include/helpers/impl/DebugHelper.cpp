@@ -24,18 +24,161 @@
 #include <ops/declarable/headers/parity_ops.h>
 #include <helpers/DebugInfo.h>
 #include <execution/Threads.h>
+#include <limits>
+#include <vector>
 
 namespace sd {
-    DebugInfo DebugHelper::debugStatistics(NDArray const* input) {
-        DebugInfo info;
-        DebugHelper::retrieveDebugStatistics(&info, input);
-        return info;
-    }
-    void 
-    DebugHelper::retrieveDebugStatistics(DebugInfo* info, NDArray const* input) {
-        if (nullptr == info)
+    // elements are processed in blocks small enough to stay in L1 between the two loops over them
+    static const Nd4jLong STATS_BLOCK = 2048;
+
+    // don't bother with threads for less than this number of elements
+    static const Nd4jLong STATS_THREAD_MIN = 32768;
+
+    // partial statistics of some range of elements. mean & M2 are merged with Chan et al. formulas
+    struct StatsPartial {
+        Nd4jLong count = 0;
+        double mean = 0.0;
+        double m2 = 0.0;
+        double min = std::numeric_limits<double>::infinity();
+        double max = -std::numeric_limits<double>::infinity();
+        Nd4jLong zero = 0;
+        Nd4jLong positive = 0;
+        Nd4jLong negative = 0;
+        Nd4jLong inf = 0;
+        Nd4jLong nan = 0;
+
+        void mergeMoments(Nd4jLong otherCount, double otherMean, double otherM2) {
+            if (otherCount == 0)
                 return;
-        
+
+            auto total = count + otherCount;
+            auto delta = otherMean - mean;
+            mean += delta * otherCount / total;
+            m2 += otherM2 + delta * delta * ((double) count * otherCount / total);
+            count = total;
+        }
+
+        void merge(StatsPartial const& other) {
+            mergeMoments(other.count, other.mean, other.m2);
+            min = sd::math::nd4j_min<double>(min, other.min);
+            max = sd::math::nd4j_max<double>(max, other.max);
+            zero += other.zero;
+            positive += other.positive;
+            negative += other.negative;
+            inf += other.inf;
+            nan += other.nan;
+        }
+    };
+
+    template <typename T>
+    static FORCEINLINE double statsValue(T value) {
+        return static_cast<double>(value);
+    }
+
+    template <>
+    FORCEINLINE double statsValue(float16 value) {
+        return static_cast<double>(static_cast<float>(value));
+    }
+
+    template <>
+    FORCEINLINE double statsValue(bfloat16 value) {
+        return static_cast<double>(static_cast<float>(value));
+    }
+
+    // sampled elements [start, stop) of the array, every stride-th element of the original one
+    template <typename T>
+    static void collectStatistics(T const* x, Nd4jLong const* shapeInfo, Nd4jLong stride, Nd4jLong start, Nd4jLong stop, StatsPartial& stats) {
+        const auto ews = shape::elementWiseStride(shapeInfo);
+        // element order doesn't matter for statistics, so any array with ews can be scanned linearly
+        const bool linear = ews >= 1;
+        const auto step = linear ? ews * stride : 0L;
+        const auto inf = std::numeric_limits<double>::infinity();
+
+        double block[STATS_BLOCK];
+        for (Nd4jLong b = start; b < stop; b += STATS_BLOCK) {
+            auto length = sd::math::nd4j_min<Nd4jLong>(STATS_BLOCK, stop - b);
+
+            // gathering block as doubles, so both loops below are vectorizable regardless of T
+            if (linear) {
+                auto xb = x + b * step;
+                PRAGMA_OMP_SIMD
+                for (Nd4jLong e = 0; e < length; e++)
+                    block[e] = statsValue<T>(xb[e * step]);
+            } else {
+                for (Nd4jLong e = 0; e < length; e++)
+                    block[e] = statsValue<T>(x[shape::getIndexOffset((b + e) * stride, shapeInfo)]);
+            }
+
+            double sum = 0.0;
+            double min = stats.min;
+            double max = stats.max;
+            Nd4jLong zero = 0, positive = 0, negative = 0, infs = 0, nans = 0;
+
+            PRAGMA_OMP_SIMD_ARGS(reduction(+:sum,zero,positive,negative,infs,nans) reduction(min:min) reduction(max:max))
+            for (Nd4jLong e = 0; e < length; e++) {
+                auto v = block[e];
+                sum += v;
+                min = v < min ? v : min;
+                max = v > max ? v : max;
+                zero += sd::math::nd4j_abs(v) <= 0.00001 ? 1 : 0;
+                positive += v > 0 ? 1 : 0;
+                negative += v < 0 ? 1 : 0;
+                infs += sd::math::nd4j_abs(v) == inf ? 1 : 0;
+                nans += v != v ? 1 : 0;
+            }
+
+            auto mean = sum / length;
+            double m2 = 0.0;
+
+            PRAGMA_OMP_SIMD_ARGS(reduction(+:m2))
+            for (Nd4jLong e = 0; e < length; e++) {
+                auto d = block[e] - mean;
+                m2 += d * d;
+            }
+
+            stats.mergeMoments(length, mean, m2);
+            stats.min = min;
+            stats.max = max;
+            stats.zero += zero;
+            stats.positive += positive;
+            stats.negative += negative;
+            stats.inf += infs;
+            stats.nan += nans;
+        }
+    }
+
+    template <typename T>
+    static void collectStatisticsGeneric(void const* x, Nd4jLong const* shapeInfo, Nd4jLong stride, Nd4jLong start, Nd4jLong stop, StatsPartial* stats) {
+        collectStatistics<T>(reinterpret_cast<T const*>(x), shapeInfo, stride, start, stop, *stats);
+    }
+
+    static Nd4jLong samplingStride(NDArray const* input, Nd4jLong maxSamples) {
+        if (maxSamples <= 0 || input->lengthOf() <= maxSamples)
+            return 1;
+
+        return (input->lengthOf() + maxSamples - 1) / maxSamples;
+    }
+
+    static void storeStatistics(DebugInfo* info, StatsPartial const& stats) {
+        info->_minValue = stats.min;
+        info->_maxValue = stats.max;
+        info->_meanValue = stats.mean;
+        info->_stdDevValue = stats.count > 0 ? sd::math::nd4j_sqrt<double, double>(stats.m2 / stats.count) : 0.0;
+        info->_zeroCount = stats.zero;
+        info->_positiveCount = stats.positive;
+        info->_negativeCount = stats.negative;
+        info->_infCount = stats.inf;
+        info->_nanCount = stats.nan;
+
+        // nothing but NaNs
+        if (stats.count > 0 && stats.min > stats.max) {
+            info->_minValue = std::numeric_limits<double>::quiet_NaN();
+            info->_maxValue = std::numeric_limits<double>::quiet_NaN();
+        }
+    }
+
+    // single array, all threads
+    static void inspect(DebugInfo* info, NDArray const* input, Nd4jLong maxSamples, uint64_t maxThreads) {
         info->_minValue = 0.;
         info->_maxValue = -1;
         info->_meanValue = 0.;
@@ -45,65 +188,80 @@ namespace sd {
         info->_negativeCount = 0;
         info->_infCount = 0;
         info->_nanCount = 0;
-        if (input->lengthOf() == 1) { // scalar case
-            info->_minValue = input->e<double>(0);
-            info->_maxValue = info->_minValue;
-            info->_meanValue = info->_minValue;
-            info->_stdDevValue = info->_minValue;
-            info->_zeroCount = sd::math::nd4j_abs(input->e<double>(0)) > 0.00001? 0: 1;
-            info->_positiveCount = input->e<double>(0) > 0?1:0;
-            info->_negativeCount = input->e<double>(0) < 0?1:0;
-            info->_infCount = sd::math::nd4j_isinf(input->e<double>(0));
-            info->_nanCount = sd::math::nd4j_isnan(input->e<double>(0));
-        }
-        else if (input->lengthOf() > 0) {
-            // TO DO: here processing for all elements with array
-            auto _minValue = input->e<double>(0);
-            auto _maxValue = input->e<double>(0);
-            auto _meanValue = input->e<double>(0);
-            auto _stdDevValue = 0.; //info->_minValue;
-            auto _zeroCount = sd::math::nd4j_abs(input->e<double>(0)) > 0.00001? 0L : 1L;
-            auto _positiveCount = input->e<double>(0) > 0? 1L : 0L;
-            auto _negativeCount = input->e<double>(0) < 0? 1L : 0L;
-            auto _infCount = sd::math::nd4j_isinf(input->e<double>(0)) ? 1L : 0L;
-            auto _nanCount = sd::math::nd4j_isnan(input->e<double>(0)) ? 1L : 0L;
-
-PRAGMA_OMP_PARALLEL_FOR_ARGS(schedule(guided) reduction(+:_nanCount,_infCount,_meanValue,_zeroCount,_positiveCount,_negativeCount) reduction(min:_minValue) reduction(max:_maxValue))
-            for (Nd4jLong e = 1; e < input->lengthOf(); e++) {
-                auto current = input->e<double>(e);
-                auto n = e + 1.;
-//                auto delta = current - _meanValue;
-//                auto delta2 = delta * delta;
-                _minValue = sd::math::nd4j_min(current, _minValue);
-                _maxValue = sd::math::nd4j_max(current, _maxValue);
-
-                _meanValue += current;
-                //_meanValue += delta / n; // this is a perfect formula but not working with omp in this notation
-                //_stdDevValue += delta2 * e / n;
-
-                _zeroCount += sd::math::nd4j_abs(current) > 0.00001 ? 0 : 1;
-                _positiveCount += current > 0 ? 1 : 0;
-                _negativeCount += current < 0 ? 1 : 0;
-                _infCount += sd::math::nd4j_isinf(current);
-                _nanCount += sd::math::nd4j_isnan(current);
-            }
-            *info = {_minValue, _maxValue, _meanValue / input->lengthOf(), _stdDevValue, _zeroCount, _positiveCount, _negativeCount, _infCount, _nanCount};
-            _stdDevValue = 0; //math::nd4j_sqrt<double, double>(info->_stdDevValue / (input->lengthOf() - 1));
 
-            auto func = PRAGMA_REDUCE_DOUBLE {
-                auto _stdDevValue = 0.0;
-                for (auto e = start; e < stop; e++) {
-                    double current = input->e<double>(e);
-                    _stdDevValue += (info->_meanValue - current) * (info->_meanValue - current); //info->_minValue;
-                }
+        // no statistics for empty
+        if (input->lengthOf() == 0)
+            return;
+
+        input->syncToHost();
+
+        auto stride = samplingStride(input, maxSamples);
+        auto samples = (input->lengthOf() + stride - 1) / stride;
+        auto x = input->buffer();
+        auto shapeInfo = input->shapeInfo();
+        auto xType = input->dataType();
+
+        auto numThreads = sd::math::nd4j_max<uint64_t>(1, sd::math::nd4j_min<uint64_t>(maxThreads, samples / STATS_THREAD_MIN));
+        std::vector<StatsPartial> partials(numThreads);
 
-                return _stdDevValue;
-            };
-            _stdDevValue = samediff::Threads::parallel_double(func, LAMBDA_AD { return _old + _new; }, 0, input->lengthOf());
+        auto func = PRAGMA_THREADS_DO {
+            // span of each thread is aligned to blocks
+            auto blocks = (samples + STATS_BLOCK - 1) / STATS_BLOCK;
+            auto perThread = (blocks + numThreads - 1) / numThreads;
+            auto start = sd::math::nd4j_min<Nd4jLong>(samples, thread_id * perThread * STATS_BLOCK);
+            auto stop = sd::math::nd4j_min<Nd4jLong>(samples, (thread_id + 1) * perThread * STATS_BLOCK);
 
-            info->_stdDevValue = math::nd4j_sqrt<double, double>(_stdDevValue / input->lengthOf());
+            BUILD_SINGLE_SELECTOR(xType, collectStatisticsGeneric, (x, shapeInfo, stride, start, stop, &partials[thread_id]), LIBND4J_TYPES);
+        };
+
+        if (numThreads > 1)
+            samediff::Threads::parallel_do(func, numThreads);
+        else
+            func(0, 1);
+
+        for (uint64_t e = 1; e < numThreads; e++)
+            partials[0].merge(partials[e]);
+
+        storeStatistics(info, partials[0]);
+    }
 
+    DebugInfo DebugHelper::debugStatistics(NDArray const* input) {
+        DebugInfo info;
+        DebugHelper::retrieveDebugStatistics(&info, input);
+        return info;
+    }
+
+    void DebugHelper::retrieveDebugStatistics(DebugInfo* info, NDArray const* input) {
+        retrieveDebugStatistics(info, input, 0);
+    }
+
+    void DebugHelper::retrieveDebugStatistics(DebugInfo* info, NDArray const* input, Nd4jLong maxSamples) {
+        if (nullptr == info)
+            return;
+
+        inspect(info, input, maxSamples, sd::Environment::getInstance().maxMasterThreads());
+    }
+
+    void DebugHelper::retrieveDebugStatistics(DebugInfo* info, std::vector<NDArray const*> const& inputs, Nd4jLong maxSamples) {
+        if (nullptr == info)
+            return;
+
+        // large arrays get all threads one by one, small ones are inspected in parallel, one thread each
+        std::vector<int> small;
+        for (int e = 0; e < (int) inputs.size(); e++) {
+            auto samples = inputs[e]->lengthOf() / samplingStride(inputs[e], maxSamples);
+            if (samples >= STATS_THREAD_MIN)
+                inspect(&info[e], inputs[e], maxSamples, sd::Environment::getInstance().maxMasterThreads());
+            else
+                small.emplace_back(e);
         }
-// else - no statistics for empty
+
+        auto func = PRAGMA_THREADS_FOR {
+            for (auto e = start; e < stop; e++)
+                inspect(&info[small[e]], inputs[small[e]], maxSamples, 1);
+        };
+
+        if (!small.empty())
+            samediff::Threads::parallel_tad(func, 0, small.size());
     }
 }
@@ -0,0 +1,58 @@
+/*******************************************************************************
+ * Copyright (c) 2020 Konduit K.K.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#include <helpers/FiniteGuard.h>
+#include <helpers/SamplingProfiler.h>
+#include <system/Environment.h>
+
+namespace sd {
+    bool FiniteGuard::isEnabled() {
+        return Environment::getInstance().isNanGuard();
+    }
+
+    bool FiniteGuard::isArmed() {
+        for (auto marker = SamplingProfiler::currentMarker(); marker != nullptr; marker = marker->parent)
+            if (marker->nonFinite != nullptr)
+                return true;
+
+        return false;
+    }
+
+    void FiniteGuard::report() {
+        for (auto marker = SamplingProfiler::currentMarker(); marker != nullptr; marker = marker->parent) {
+            if (marker->nonFinite != nullptr) {
+                marker->nonFinite->store(true, std::memory_order_relaxed);
+                return;
+            }
+        }
+    }
+
+    FiniteGuard::Region::Region() {
+        _marker = SamplingProfiler::currentMarker();
+    }
+
+    const OpMarker* FiniteGuard::Region::marker() const {
+        return _marker;
+    }
+
+    FiniteGuard::Scope::Scope(const Region &region) {
+        _previous = SamplingProfiler::swapMarker(region.marker());
+    }
+
+    FiniteGuard::Scope::~Scope() {
+        SamplingProfiler::swapMarker(_previous);
+    }
+}
@@ -0,0 +1,252 @@
+/*******************************************************************************
+ * Copyright (c) 2020 Konduit K.K.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#include <helpers/HardwareCounters.h>
+#include <helpers/logger.h>
+#include <algorithm>
+#include <cstdlib>
+
+#if defined(__linux__) && !defined(SD_ANDROID_BUILD)
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+#include <cstring>
+#define SD_PERF_EVENTS
+#endif
+
+namespace sd {
+    static const int NUM_COUNTERS = 4;
+
+    static Nd4jLong diff(Nd4jLong a, Nd4jLong b) {
+        return a < 0 || b < 0 ? -1L : a - b;
+    }
+
+    static Nd4jLong sum(Nd4jLong a, Nd4jLong b) {
+        if (a < 0)
+            return b;
+
+        return b < 0 ? a : a + b;
+    }
+
+    CounterValues CounterValues::operator-(const CounterValues& other) const {
+        CounterValues result;
+        result.cycles = diff(cycles, other.cycles);
+        result.instructions = diff(instructions, other.instructions);
+        result.cacheReferences = diff(cacheReferences, other.cacheReferences);
+        result.cacheMisses = diff(cacheMisses, other.cacheMisses);
+        return result;
+    }
+
+    CounterValues& CounterValues::operator+=(const CounterValues& other) {
+        cycles = sum(cycles, other.cycles);
+        instructions = sum(instructions, other.instructions);
+        cacheReferences = sum(cacheReferences, other.cacheReferences);
+        cacheMisses = sum(cacheMisses, other.cacheMisses);
+        return *this;
+    }
+
+    bool CounterValues::hasValues() const {
+        return cycles >= 0 || instructions >= 0 || cacheReferences >= 0 || cacheMisses >= 0;
+    }
+
+    class HardwareCounters::ThreadCounters {
+    private:
+        int _fds[NUM_COUNTERS] = {-1, -1, -1, -1};
+
+        // last values read by owning thread
+        Nd4jLong _values[NUM_COUNTERS];
+
+        // values spent by ThreadPool workers on tasks dispatched by owning thread
+        std::atomic<Nd4jLong> _inherited[NUM_COUNTERS];
+
+    public:
+        ThreadCounters() {
+            for (int e = 0; e < NUM_COUNTERS; e++) {
+                _values[e] = -1L;
+                _inherited[e].store(0L);
+            }
+
+#ifdef SD_PERF_EVENTS
+            const uint64_t configs[NUM_COUNTERS] = {PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CACHE_REFERENCES, PERF_COUNT_HW_CACHE_MISSES};
+
+            for (int e = 0; e < NUM_COUNTERS; e++) {
+                struct perf_event_attr attr;
+                memset(&attr, 0, sizeof(attr));
+                attr.type = PERF_TYPE_HARDWARE;
+                attr.size = sizeof(attr);
+                attr.config = configs[e];
+                attr.exclude_kernel = 1;
+                attr.exclude_hv = 1;
+
+                // counting calling thread on any cpu
+                _fds[e] = (int) syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+                if (_fds[e] >= 0)
+                    _values[e] = 0L;
+            }
+#endif
+        }
+
+        ~ThreadCounters() {
+#ifdef SD_PERF_EVENTS
+            for (int e = 0; e < NUM_COUNTERS; e++)
+                if (_fds[e] >= 0)
+                    close(_fds[e]);
+#endif
+        }
+
+        bool isOpen() const {
+            for (int e = 0; e < NUM_COUNTERS; e++)
+                if (_fds[e] >= 0)
+                    return true;
+
+            return false;
+        }
+
+        // must be called by owning thread only
+        void refresh() {
+#ifdef SD_PERF_EVENTS
+            for (int e = 0; e < NUM_COUNTERS; e++) {
+                if (_fds[e] < 0)
+                    continue;
+
+                uint64_t value = 0;
+                if (read(_fds[e], &value, sizeof(value)) == sizeof(value))
+                    _values[e] = (Nd4jLong) value;
+            }
+#endif
+        }
+
+        // must be called by owning thread only
+        CounterValues values() const {
+            Nd4jLong v[NUM_COUNTERS];
+            for (int e = 0; e < NUM_COUNTERS; e++)
+                v[e] = _values[e] < 0 ? -1L : _values[e] + _inherited[e].load();
+
+            CounterValues result;
+            result.cycles = v[0];
+            result.instructions = v[1];
+            result.cacheReferences = v[2];
+            result.cacheMisses = v[3];
+            return result;
+        }
+
+        // called by ThreadPool workers, when task dispatched by owning thread is done
+        void inherit(const CounterValues& values) {
+            const Nd4jLong v[NUM_COUNTERS] = {values.cycles, values.instructions, values.cacheReferences, values.cacheMisses};
+            for (int e = 0; e < NUM_COUNTERS; e++)
+                if (v[e] > 0)
+                    _inherited[e].fetch_add(v[e]);
+        }
+    };
+
+    // closes counters of the thread when it exits
+    struct ThreadCountersHolder {
+        HardwareCounters::ThreadCounters* counters = nullptr;
+
+        ~ThreadCountersHolder() {
+            if (counters != nullptr)
+                HardwareCounters::getInstance().release(counters);
+        }
+    };
+
+    static thread_local ThreadCountersHolder holder;
+
+    HardwareCounters::HardwareCounters() {
+        // if this env var is defined - profiled ops will record hardware counters, if they're available
+        if (std::getenv("SD_HARDWARE_COUNTERS") != nullptr)
+            setEnabled(true);
+    }
+
+    HardwareCounters& HardwareCounters::getInstance() {
+        static HardwareCounters instance;
+        return instance;
+    }
+
+    bool HardwareCounters::isAvailable() {
+        if (_available.load() < 0) {
+            ThreadCounters probe;
+            _available.store(probe.isOpen() ? 1 : 0);
+
+            if (!probe.isOpen())
+                nd4j_debug("Hardware counters are not available on this system\n", "");
+        }
+
+        return _available.load() > 0;
+    }
+
+    bool HardwareCounters::isEnabled() {
+        return _enabled.load();
+    }
+
+    void HardwareCounters::setEnabled(bool reallyEnabled) {
+        // there's no reason to enable counters we can't open
+        _enabled.store(reallyEnabled && isAvailable());
+    }
+
+    HardwareCounters::ThreadCounters* HardwareCounters::threadCounters() {
+        // counters are opened once per thread, and closed on thread exit
+        if (holder.counters == nullptr) {
+            holder.counters = new ThreadCounters();
+
+            std::lock_guard<std::mutex> lock(_lock);
+            _threads.emplace_back(holder.counters);
+        }
+
+        return holder.counters;
+    }
+
+    void HardwareCounters::release(ThreadCounters* counters) {
+        {
+            std::lock_guard<std::mutex> lock(_lock);
+            _threads.erase(std::remove(_threads.begin(), _threads.end(), counters), _threads.end());
+        }
+
+        delete counters;
+    }
+
+    HardwareCounters::ThreadCounters* HardwareCounters::currentThread() {
+        return isEnabled() ? threadCounters() : nullptr;
+    }
+
+    void HardwareCounters::detachThread() {
+        auto counters = holder.counters;
+        holder.counters = nullptr;
+
+        if (counters != nullptr)
+            release(counters);
+    }
+
+    CounterValues HardwareCounters::threadValues() {
+        if (!isEnabled())
+            return CounterValues();
+
+        auto counters = threadCounters();
+        counters->refresh();
+
+        return counters->values();
+    }
+
+    void HardwareCounters::attribute(ThreadCounters* owner, const CounterValues& values) {
+        if (owner != nullptr)
+            owner->inherit(values);
+    }
+
+    int HardwareCounters::attachedThreads() {
+        std::lock_guard<std::mutex> lock(_lock);
+        return (int) _threads.size();
+    }
+}
@@ -0,0 +1,48 @@
+/*******************************************************************************
+ * Copyright (c) 2020 Konduit K.K.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#include <helpers/MixedPrecision.h>
+#include <system/Environment.h>
+
+namespace sd {
+    static thread_local int _fp32AccumulationMode = -1;
+
+    bool MixedPrecision::isFp32Accumulation() {
+        auto mode = _fp32AccumulationMode;
+        if (mode < 0)
+            return Environment::getInstance().isFp32Accumulation();
+
+        return mode > 0;
+    }
+
+    bool MixedPrecision::upcast(sd::DataType dataType) {
+        return (dataType == sd::DataType::HALF || dataType == sd::DataType::BFLOAT16) && isFp32Accumulation();
+    }
+
+    int MixedPrecision::swapMode(int mode) {
+        auto previous = _fp32AccumulationMode;
+        _fp32AccumulationMode = mode;
+        return previous;
+    }
+
+    MixedPrecisionScope::MixedPrecisionScope(bool fp32Accumulation) {
+        _previous = MixedPrecision::swapMode(fp32Accumulation ? 1 : 0);
+    }
+
+    MixedPrecisionScope::~MixedPrecisionScope() {
+        MixedPrecision::swapMode(_previous);
+    }
+}
@@ -25,6 +25,7 @@
 #include <helpers/ShapeUtils.h>
 #include <helpers/BlasHelper.h>
 #include <array/NDArrayFactory.h>
+#include <memory>
 
 namespace sd {
 
@@ -238,6 +239,41 @@ sd::NDArray* MmulHelper::mmul(const sd::NDArray* A, const sd::NDArray* B, sd::ND
 }
 
 
+//////////////////////////////////////////////////////////////////////////
+void MmulHelper::applyEpilogue(const sd::NDArray& source, sd::NDArray& target, const GemmEpilogue& epilogue) {
+
+    NDArray z = source.dup();
+
+    if (epilogue.bias != nullptr) {
+        std::unique_ptr<NDArray> bias(epilogue.bias->dataType() == z.dataType() ? nullptr : new NDArray(epilogue.bias->cast(z.dataType())));
+        z.addiRowVector(bias ? *bias : *epilogue.bias);
+    }
+
+    switch (epilogue.activation) {
+        case GemmEpilogue::RELU:
+            z.applyScalar(sd::scalar::RELU, epilogue.cutoff, z);
+            break;
+        case GemmEpilogue::GELU:
+            z.applyTransform(sd::transform::GELU, z);
+            break;
+        case GemmEpilogue::TANH:
+            z.applyTransform(sd::transform::Tanh, z);
+            break;
+        case GemmEpilogue::SIGMOID:
+            z.applyTransform(sd::transform::Sigmoid, z);
+            break;
+        default:
+            break;
+    }
+
+    if (epilogue.residual != nullptr) {
+        std::unique_ptr<NDArray> residual(epilogue.residual->dataType() == z.dataType() ? nullptr : new NDArray(epilogue.residual->cast(z.dataType())));
+        z += residual ? *residual : *epilogue.residual;
+    }
+
+    target.assign(z);
+}
+
 //////////////////////////////////////////////////////////////////////////
     void MmulHelper::matmul(const sd::NDArray* x, const sd::NDArray* y, sd::NDArray* z, const bool transX, const bool transY, double alpha, double beta) {
         int xRank = x->rankOf();
@@ -0,0 +1,364 @@
+/*******************************************************************************
+ * Copyright (c) 2020 Konduit K.K.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#include <helpers/SamplingProfiler.h>
+#include <helpers/logger.h>
+#include <algorithm>
+
+#if !defined(_WIN32) && !defined(SD_ANDROID_BUILD)
+#include <signal.h>
+#include <sys/time.h>
+#include <cerrno>
+#include <cstring>
+#define SD_SIGPROF
+#endif
+
+// signal handler touches thread-locals, so we want them to be resolved without any lazy allocation
+#if defined(__GNUC__) && !defined(__APPLE__)
+#define SD_TLS_IE __attribute__((tls_model("initial-exec")))
+#else
+#define SD_TLS_IE
+#endif
+
+namespace sd {
+    static const int MAX_DEPTH = 8;
+    static const int NAME_LENGTH = 32;
+    static const Nd4jLong RING_SIZE = 512;
+
+    struct SampleFrame {
+        char name[NAME_LENGTH];
+        int nodeId;
+        int opNum;
+    };
+
+    // frames are stored leaf first
+    struct Sample {
+        int depth;
+        SampleFrame frames[MAX_DEPTH];
+    };
+
+    class SamplingProfiler::ThreadSamples {
+    public:
+        Sample _samples[RING_SIZE];
+
+        // written by owning thread from signal handler only
+        std::atomic<Nd4jLong> _head{0L};
+
+        // accessed under profiler lock only
+        Nd4jLong _consumed = 0L;
+    };
+
+    static thread_local const OpMarker* _currentMarker SD_TLS_IE = nullptr;
+    static thread_local SamplingProfiler::ThreadSamples* _threadSamples SD_TLS_IE = nullptr;
+
+    // set once profiler singleton is destroyed, so threads exiting after that don't touch it
+    static std::atomic<bool> _profilerDestroyed{false};
+
+    // owns ring buffer of the calling thread, and hands it back to profiler when thread exits.
+    // signal handler uses raw _threadSamples pointer above, since this one isn't initial-exec
+    class ThreadSamplesHolder {
+    public:
+        bool attached = false;
+
+        ~ThreadSamplesHolder() {
+            if (attached && !_profilerDestroyed.load())
+                SamplingProfiler::getInstance().detachThread();
+        }
+    };
+
+    static thread_local ThreadSamplesHolder _threadSamplesHolder;
+
+    ScopedOpMarker::ScopedOpMarker(const char* name, Nd4jLong hash, int nodeId, int opNum, std::atomic<bool>* nonFinite) {
+        _marker.name = name;
+        _marker.hash = hash;
+        _marker.nodeId = nodeId;
+        _marker.opNum = opNum;
+        _marker.parent = _currentMarker;
+        _marker.nonFinite = nonFinite;
+
+        auto &profiler = SamplingProfiler::getInstance();
+        if (profiler.isRunning())
+            profiler.attachThread();
+
+        // marker must be complete before signal handler can see it
+        std::atomic_signal_fence(std::memory_order_release);
+        _currentMarker = &_marker;
+    }
+
+    ScopedOpMarker::~ScopedOpMarker() {
+        std::atomic_signal_fence(std::memory_order_release);
+        _currentMarker = _marker.parent;
+    }
+
+#ifdef SD_SIGPROF
+    static struct sigaction _previousAction;
+
+    static void sigprofHandler(int signal, siginfo_t* info, void* context) {
+        auto savedErrno = errno;
+        SamplingProfiler::getInstance().sample();
+        errno = savedErrno;
+    }
+#endif
+
+    SamplingProfiler::~SamplingProfiler() {
+        stop();
+        _profilerDestroyed.store(true);
+
+        // buffers of threads which are still alive (i.e. detached ThreadPool workers) are released with the process
+    }
+
+    SamplingProfiler& SamplingProfiler::getInstance() {
+        static SamplingProfiler instance;
+        return instance;
+    }
+
+    bool SamplingProfiler::isRunning() {
+        return _running.load(std::memory_order_relaxed);
+    }
+
+    const OpMarker* SamplingProfiler::currentMarker() {
+        return _currentMarker;
+    }
+
+    const OpMarker* SamplingProfiler::swapMarker(const OpMarker* marker) {
+        if (marker != nullptr) {
+            auto &profiler = getInstance();
+            if (profiler.isRunning())
+                profiler.attachThread();
+        }
+
+        auto previous = _currentMarker;
+        std::atomic_signal_fence(std::memory_order_release);
+        _currentMarker = marker;
+        return previous;
+    }
+
+    void SamplingProfiler::attachThread() {
+        if (_threadSamples != nullptr)
+            return;
+
+        auto samples = new ThreadSamples();
+        {
+            std::lock_guard<std::mutex> lock(_lock);
+            _threads.emplace_back(samples);
+        }
+
+        std::atomic_signal_fence(std::memory_order_release);
+        _threadSamples = samples;
+        _threadSamplesHolder.attached = true;
+    }
+
+    void SamplingProfiler::detachThread() {
+        auto samples = _threadSamples;
+        if (samples == nullptr)
+            return;
+
+        // signal handler must not see the buffer once we start releasing it
+        _threadSamples = nullptr;
+        _threadSamplesHolder.attached = false;
+        std::atomic_signal_fence(std::memory_order_seq_cst);
+
+        std::lock_guard<std::mutex> lock(_lock);
+
+        // samples collected so far are kept
+        drain();
+
+        _threads.erase(std::remove(_threads.begin(), _threads.end(), samples), _threads.end());
+        delete samples;
+    }
+
+    void SamplingProfiler::sample() {
+        if (!_running.load(std::memory_order_relaxed))
+            return;
+
+        auto samples = _threadSamples;
+        if (samples == nullptr) {
+            _unattributed.fetch_add(1L, std::memory_order_relaxed);
+            return;
+        }
+
+        // only owning thread writes here, so plain load/store pair is enough
+        auto head = samples->_head.load(std::memory_order_relaxed);
+        auto &sample = samples->_samples[head % RING_SIZE];
+
+        int depth = 0;
+        for (auto marker = _currentMarker; marker != nullptr && depth < MAX_DEPTH; marker = marker->parent, depth++) {
+            auto &frame = sample.frames[depth];
+            int e = 0;
+            if (marker->name != nullptr)
+                for (; e < NAME_LENGTH - 1 && marker->name[e] != 0; e++)
+                    frame.name[e] = marker->name[e];
+
+            frame.name[e] = 0;
+            frame.nodeId = marker->nodeId;
+            frame.opNum = marker->opNum;
+        }
+        sample.depth = depth;
+
+        samples->_head.store(head + 1, std::memory_order_release);
+    }
+
+    bool SamplingProfiler::start(int frequency) {
+#ifdef SD_SIGPROF
+        if (frequency <= 0 || frequency > 1000000) {
+            nd4j_printf("SamplingProfiler: frequency should be in range [1, 1000000], got %i\n", frequency);
+            return false;
+        }
+
+        if (isRunning())
+            return true;
+
+        attachThread();
+
+        struct sigaction action;
+        memset(&action, 0, sizeof(action));
+        action.sa_sigaction = sigprofHandler;
+        action.sa_flags = SA_SIGINFO | SA_RESTART;
+        sigemptyset(&action.sa_mask);
+
+        if (sigaction(SIGPROF, &action, &_previousAction) != 0) {
+            nd4j_printf("SamplingProfiler: can't install SIGPROF handler: %s\n", strerror(errno));
+            return false;
+        }
+
+        _frequency = frequency;
+        _running.store(true);
+
+        struct itimerval timer;
+        // tv_usec must stay below one second, i.e. for frequency of 1
+        auto period = 1000000 / frequency;
+        timer.it_interval.tv_sec = period / 1000000;
+        timer.it_interval.tv_usec = period % 1000000;
+        timer.it_value = timer.it_interval;
+
+        if (setitimer(ITIMER_PROF, &timer, nullptr) != 0) {
+            nd4j_printf("SamplingProfiler: can't start profiling timer: %s\n", strerror(errno));
+            _running.store(false);
+            sigaction(SIGPROF, &_previousAction, nullptr);
+            return false;
+        }
+
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    void SamplingProfiler::stop() {
+#ifdef SD_SIGPROF
+        if (!isRunning())
+            return;
+
+        struct itimerval timer;
+        memset(&timer, 0, sizeof(timer));
+        setitimer(ITIMER_PROF, &timer, nullptr);
+
+        _running.store(false);
+
+        // signal might be still pending, and default action for SIGPROF is termination
+        if (_previousAction.sa_handler == SIG_DFL) {
+            struct sigaction ignore;
+            memset(&ignore, 0, sizeof(ignore));
+            ignore.sa_handler = SIG_IGN;
+            sigemptyset(&ignore.sa_mask);
+            sigaction(SIGPROF, &ignore, nullptr);
+        } else {
+            sigaction(SIGPROF, &_previousAction, nullptr);
+        }
+#endif
+    }
+
+    static std::string frameName(const SampleFrame& frame) {
+        std::string result(frame.name);
+        if (frame.nodeId >= 0)
+            result += " [node " + std::to_string(frame.nodeId) + "]";
+        else if (frame.opNum >= 0)
+            result += " [op " + std::to_string(frame.opNum) + "]";
+
+        return result;
+    }
+
+    void SamplingProfiler::drain() {
+        // must be called under lock
+        for (auto samples: _threads) {
+            auto head = samples->_head.load(std::memory_order_acquire);
+
+            // ring was overwritten since last drain
+            if (head - samples->_consumed > RING_SIZE) {
+                _folded["[lost]"] += head - RING_SIZE - samples->_consumed;
+                samples->_consumed = head - RING_SIZE;
+            }
+
+            for (auto e = samples->_consumed; e < head; e++) {
+                Sample sample = samples->_samples[e % RING_SIZE];
+
+                // writer lapped us while we were copying
+                if (samples->_head.load(std::memory_order_acquire) - e > RING_SIZE) {
+                    _folded["[lost]"]++;
+                    continue;
+                }
+
+                std::string stack;
+                if (sample.depth == 0)
+                    stack = "[outside_ops]";
+
+                for (int f = sample.depth - 1; f >= 0; f--) {
+                    stack += frameName(sample.frames[f]);
+                    if (f > 0)
+                        stack += ";";
+                }
+
+                _folded[stack]++;
+            }
+
+            samples->_consumed = head;
+        }
+    }
+
+    std::string SamplingProfiler::foldedStacks() {
+        std::lock_guard<std::mutex> lock(_lock);
+        drain();
+
+        std::string result;
+        for (auto const& v: _folded)
+            result += v.first + " " + std::to_string(v.second) + "\n";
+
+        auto unattributed = _unattributed.load();
+        if (unattributed > 0)
+            result += "[unattributed] " + std::to_string(unattributed) + "\n";
+
+        return result;
+    }
+
+    Nd4jLong SamplingProfiler::totalSamples() {
+        std::lock_guard<std::mutex> lock(_lock);
+        drain();
+
+        Nd4jLong result = _unattributed.load();
+        for (auto const& v: _folded)
+            result += v.second;
+
+        return result;
+    }
+
+    void SamplingProfiler::reset() {
+        std::lock_guard<std::mutex> lock(_lock);
+        drain();
+
+        _folded.clear();
+        _unattributed.store(0L);
+    }
+}
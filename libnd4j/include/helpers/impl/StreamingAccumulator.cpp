@@ -0,0 +1,184 @@
+/*******************************************************************************
+ * Copyright (c) 2020 Konduit K.K.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+#include <helpers/StreamingAccumulator.h>
+#include <helpers/MixedPrecision.h>
+#include <array/DataTypeUtils.h>
+#include <thread>
+
+namespace sd {
+    template <typename T>
+    static void addTile_(void *vacc, const void *vx, Nd4jLong first, Nd4jLong width) {
+        typedef typename AccumulatorType<T>::type A;
+
+        auto acc = reinterpret_cast<A*>(vacc) + first;
+        auto x = reinterpret_cast<const T*>(vx) + first;
+
+        PRAGMA_OMP_SIMD
+        for (Nd4jLong i = 0; i < width; i++)
+            acc[i] += static_cast<A>(x[i]);
+    }
+
+    template <typename T>
+    static void storeTile_(const void *vacc, void *vz, Nd4jLong first, Nd4jLong width, Nd4jLong count) {
+        typedef typename AccumulatorType<T>::type A;
+
+        auto acc = reinterpret_cast<const A*>(vacc) + first;
+        auto z = reinterpret_cast<T*>(vz) + first;
+        auto div = static_cast<A>(count > 0 ? count : 1);
+
+        PRAGMA_OMP_SIMD
+        for (Nd4jLong i = 0; i < width; i++)
+            z[i] = static_cast<T>(acc[i] / div);
+    }
+
+    StreamingAccumulator::StreamingAccumulator(sd::DataType dataType, Nd4jLong length) : _count(0), _cursor(0) {
+        if (!DataTypeUtils::isR(dataType))
+            throw std::runtime_error("StreamingAccumulator: only floating point types are supported");
+
+        if (length <= 0)
+            throw std::runtime_error("StreamingAccumulator: length should be positive");
+
+        _dataType = dataType;
+        _length = length;
+        _numTiles = (length + TILE - 1) / TILE;
+
+        auto accType = dataType == sd::DataType::DOUBLE ? sd::DataType::DOUBLE : sd::DataType::FLOAT32;
+        _buffer.resize(length * DataTypeUtils::sizeOfElement(accType), 0);
+
+        _locks.reset(new std::mutex[_numTiles]);
+        _tileCounts.resize(_numTiles, 0L);
+    }
+
+    template <typename F>
+    void StreamingAccumulator::forEachTile(F func) {
+        // producers start from different tiles, so they rarely meet
+        auto offset = _cursor.fetch_add(1) % _numTiles;
+
+        std::vector<Nd4jLong> pending(_numTiles);
+        for (Nd4jLong e = 0; e < _numTiles; e++)
+            pending[e] = (e + offset) % _numTiles;
+
+        std::vector<Nd4jLong> busy;
+        while (!pending.empty()) {
+            busy.clear();
+
+            for (auto tile : pending) {
+                std::unique_lock<std::mutex> lock(_locks[tile], std::try_to_lock);
+                if (!lock.owns_lock()) {
+                    busy.emplace_back(tile);
+                    continue;
+                }
+
+                auto first = tile * TILE;
+                func(tile, first, sd::math::nd4j_min<Nd4jLong>(TILE, _length - first));
+            }
+
+            // every remaining tile is taken by someone else
+            if (busy.size() == pending.size())
+                std::this_thread::yield();
+
+            pending.swap(busy);
+        }
+    }
+
+    void StreamingAccumulator::validate(const NDArray &array) const {
+        if (array.dataType() != _dataType)
+            throw std::runtime_error("StreamingAccumulator: data type mismatch");
+
+        if (array.lengthOf() != _length)
+            throw std::runtime_error("StreamingAccumulator: length mismatch");
+    }
+
+    void StreamingAccumulator::add(const NDArray &array) {
+        validate(array);
+
+        // tiles are addressed by plain offset
+        std::unique_ptr<NDArray> temp;
+        if (array.ordering() != 'c' || array.ews() != 1)
+            temp.reset(new NDArray(array.dup('c')));
+
+        auto x = temp ? temp.get() : &array;
+
+        NDArray::preparePrimaryUse({}, {x});
+
+        auto acc = _buffer.data();
+        auto buffer = x->buffer();
+        auto dataType = _dataType;
+
+        forEachTile([&](Nd4jLong tile, Nd4jLong first, Nd4jLong width) {
+            BUILD_SINGLE_SELECTOR(dataType, addTile_, (acc, buffer, first, width), FLOAT_TYPES);
+            _tileCounts[tile]++;
+        });
+
+        NDArray::registerPrimaryUse({}, {x});
+
+        _count++;
+    }
+
+    void StreamingAccumulator::store(NDArray &target, bool average) {
+        validate(target);
+
+        // strided targets are written through a contiguous temporary
+        std::unique_ptr<NDArray> temp;
+        if (target.ordering() != 'c' || target.ews() != 1)
+            temp.reset(new NDArray('c', target.getShapeAsVector(), _dataType, target.getContext()));
+
+        auto z = temp ? temp.get() : &target;
+
+        NDArray::preparePrimaryUse({z}, {});
+
+        auto acc = _buffer.data();
+        auto buffer = z->buffer();
+        auto dataType = _dataType;
+        forEachTile([&](Nd4jLong tile, Nd4jLong first, Nd4jLong width) {
+            Nd4jLong count = average ? _tileCounts[tile] : 1L;
+            BUILD_SINGLE_SELECTOR(dataType, storeTile_, (acc, buffer, first, width, count), FLOAT_TYPES);
+        });
+
+        NDArray::registerPrimaryUse({z}, {});
+
+        if (temp)
+            target.assign(*temp);
+    }
+
+    void StreamingAccumulator::sum(NDArray &target) {
+        store(target, false);
+    }
+
+    void StreamingAccumulator::average(NDArray &target) {
+        store(target, true);
+    }
+
+    void StreamingAccumulator::reset() {
+        std::fill(_buffer.begin(), _buffer.end(), 0);
+        std::fill(_tileCounts.begin(), _tileCounts.end(), 0L);
+        _count = 0;
+    }
+
+    Nd4jLong StreamingAccumulator::count() const {
+        return _count.load();
+    }
+
+    Nd4jLong StreamingAccumulator::length() const {
+        return _length;
+    }
+
+    sd::DataType StreamingAccumulator::dataType() const {
+        return _dataType;
+    }
+}
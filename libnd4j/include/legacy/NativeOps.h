@@ -77,6 +77,7 @@ bool verbose = false;
 #include <graph/ResultWrapper.h>
 #include <helpers/DebugInfo.h>
 #include <memory/MemoryCounter.h>
+#include <helpers/StreamingAccumulator.h>
 
 typedef sd::InteropDataBuffer OpaqueDataBuffer;
 
@@ -776,6 +777,29 @@ ND4J_EXPORT void enableDebugMode(bool reallyEnable);
  */
 ND4J_EXPORT void enableVerboseMode(bool reallyEnable);
 
+/**
+ * This method enables FLOAT32 accumulation for HALF/BFLOAT16 ops by default
+ * @param reallyEnable
+ */
+ND4J_EXPORT void enableFp32Accumulation(bool reallyEnable);
+
+/**
+ * This method enables NaN/Inf guard: ops producing non-finite values fail, and lastErrorMessage() points to the node
+ * @param reallyEnable
+ */
+ND4J_EXPORT void enableNanGuard(bool reallyEnable);
+
+/**
+ * This method enables hardware counters (cycles, instructions, cache references/misses) in op profiling, Linux only
+ * @param reallyEnable
+ */
+ND4J_EXPORT void enableHardwareCounters(bool reallyEnable);
+
+/**
+ * This method returns TRUE if hardware counters are enabled, i.e. they were requested and are available on this system
+ */
+ND4J_EXPORT bool isHardwareCountersEnabled();
+
 /**
  *
  * @param gridSize
@@ -860,6 +884,29 @@ ND4J_EXPORT void accumulate(Nd4jPointer *extras,
                             int n,
                             Nd4jLong length);
 
+typedef sd::StreamingAccumulator OpaqueStreamingAccumulator;
+
+/**
+ * Streaming N-way sum of arrays which arrive one by one, i.e. gradients received from workers, see StreamingAccumulator.
+ * Arrays are passed as host buffers, and must have the same data type and length as accumulator.
+ * streamingAccumulatorAdd may be called from several threads at once
+ *
+ * @param dataType floating point data type of accumulated arrays
+ * @param length number of elements in each array
+ */
+ND4J_EXPORT OpaqueStreamingAccumulator* createStreamingAccumulator(int dataType, Nd4jLong length);
+ND4J_EXPORT void deleteStreamingAccumulator(OpaqueStreamingAccumulator* ptr);
+
+ND4J_EXPORT void streamingAccumulatorAdd(OpaqueStreamingAccumulator* ptr, void *hX, Nd4jLong const* hXShapeInfo);
+
+/**
+ * This method stores current sum, or average if average is TRUE, into z
+ */
+ND4J_EXPORT void streamingAccumulatorStore(OpaqueStreamingAccumulator* ptr, void *hZ, Nd4jLong const* hZShapeInfo, bool average);
+
+ND4J_EXPORT void streamingAccumulatorReset(OpaqueStreamingAccumulator* ptr);
+ND4J_EXPORT Nd4jLong streamingAccumulatorCount(OpaqueStreamingAccumulator* ptr);
+
 
 /**
  * P2P enabler
@@ -1561,6 +1608,14 @@ ND4J_EXPORT void scatterUpdate(Nd4jPointer *extraPointers, int opCode, int numOf
 
 ND4J_EXPORT void inspectArray(Nd4jPointer *extraPointers, Nd4jPointer buffer, Nd4jLong *shapeInfo, Nd4jPointer specialBuffer, Nd4jLong *specialShapeInfo, Nd4jPointer debugInfo);
 
+/**
+ * This method fills DebugInfo for each of numArrays arrays at once
+ *
+ * @param debugInfos pointer to numArrays DebugInfo structs
+ * @param maxSamples if > 0, longer arrays are inspected with stride, so only ~maxSamples elements are read
+ */
+ND4J_EXPORT void inspectArrays(Nd4jPointer *extraPointers, int numArrays, Nd4jPointer *buffers, Nd4jLong **shapeInfos, Nd4jPointer *specialBuffers, Nd4jLong **specialShapeInfos, Nd4jPointer debugInfos, Nd4jLong maxSamples);
+
 
 typedef sd::ConstantDataBuffer OpaqueConstantDataBuffer;
 typedef sd::ConstantShapeBuffer OpaqueConstantShapeBuffer;
@@ -1589,6 +1644,7 @@ ND4J_EXPORT OpaqueRandomGenerator* getGraphContextRandomGenerator(OpaqueContext*
 ND4J_EXPORT void ctxAllowHelpers(OpaqueContext* ptr, bool reallyAllow);
 ND4J_EXPORT void ctxShapeFunctionOverride(OpaqueContext* ptr, bool reallyOverride);
 ND4J_EXPORT void ctxSetExecutionMode(OpaqueContext* ptr, int execMode);
+ND4J_EXPORT void ctxSetFp32Accumulation(OpaqueContext* ptr, bool reallyEnable);
 ND4J_EXPORT void ctxPurge(OpaqueContext* ptr);
 ND4J_EXPORT void markGraphContextInplace(OpaqueContext* ptr, bool reallyInplace);
 ND4J_EXPORT void setGraphContextCudaContext(OpaqueContext* ptr, void *stream, void *reductionPointer, void *allocationPointer);
@@ -1615,6 +1671,22 @@ ND4J_EXPORT void deleteRandomGenerator(OpaqueRandomGenerator* ptr);
 ND4J_EXPORT const char* runLightBenchmarkSuit(bool printOut);
 ND4J_EXPORT const char* runFullBenchmarkSuit(bool printOut);
 
+/**
+ * This method starts SIGPROF-based sampling profiler, which attributes samples to currently executed ops
+ *
+ * @param frequency samples per second of CPU time
+ * @return false if profiler isn't supported on this platform
+ */
+ND4J_EXPORT bool startSamplingProfiler(int frequency);
+ND4J_EXPORT void stopSamplingProfiler();
+ND4J_EXPORT void resetSamplingProfiler();
+
+/**
+ * This method returns samples aggregated so far as folded stacks (one "frame;frame count" line per stack), for flame graphs.
+ * Returned array should be released with deleteCharArray()
+ */
+ND4J_EXPORT const char* dumpSamplingProfile();
+
 typedef sd::LaunchContext OpaqueLaunchContext;
 
 ND4J_EXPORT OpaqueLaunchContext* defaultLaunchContext();
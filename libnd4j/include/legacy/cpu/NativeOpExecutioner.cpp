@@ -54,6 +54,9 @@
 #include <exceptions/datatype_exception.h>
 #include <array/TadPack.h>
 #include <helpers/ConstantTadHelper.h>
+#include <helpers/SamplingProfiler.h>
+#include <helpers/MixedPrecision.h>
+#include <helpers/ConstantShapeHelper.h>
 
 
 #ifdef _OPENMP
@@ -65,6 +68,107 @@
 
 
 
+////////////////////////////////////////////////////////////////////////
+// fp32 accumulation for HALF/BFLOAT16 reductions: result is computed in FLOAT32 and rounded only once.
+// transforms don't need any of this, see TransformFloat::execFp32/TransformStrict::execFp32
+
+// scratch buffer has c order and the same shape as z, i.e. one value per tad, so extra pass over it is small next to reduction itself
+template <typename Z>
+static void storeFromFp32(const float *src, void *vz, const Nd4jLong *zShapeInfo) {
+    auto z = reinterpret_cast<Z*>(vz);
+    const bool contiguous = shape::elementWiseStride(zShapeInfo) == 1 && shape::order(zShapeInfo) == 'c';
+
+    auto func = PRAGMA_THREADS_FOR {
+        if (contiguous) {
+            for (auto e = start; e < stop; e++)
+                z[e] = static_cast<Z>(src[e]);
+        } else {
+            for (auto e = start; e < stop; e++)
+                z[shape::getIndexOffset(e, zShapeInfo)] = static_cast<Z>(src[e]);
+        }
+    };
+
+    samediff::Threads::parallel_for(func, 0, shape::length(zShapeInfo));
+}
+
+template <typename X>
+static float sumTadFp32(const X *tad, const Nd4jLong *tadShapeInfo, const bool absolute, Nd4jLong start, Nd4jLong stop) {
+    // sum doesn't depend on order of elements, so any positive ews is fine
+    const auto ews = shape::elementWiseStride(tadShapeInfo);
+
+    float sum = 0.f;
+    if (ews >= 1) {
+        for (auto e = start; e < stop; e++) {
+            auto v = static_cast<float>(tad[e * ews]);
+            sum += absolute ? sd::math::nd4j_abs<float>(v) : v;
+        }
+    } else {
+        for (auto e = start; e < stop; e++) {
+            auto v = static_cast<float>(tad[shape::getIndexOffset(e, tadShapeInfo)]);
+            sum += absolute ? sd::math::nd4j_abs<float>(v) : v;
+        }
+    }
+
+    return sum;
+}
+
+// Sum and ASum are the only ReduceSame ops which lose precision with 16 bit accumulator
+template <typename X>
+static void sumWithFp32(const bool absolute, const void *vx, const Nd4jLong *tadShapeInfo, const Nd4jLong *tadOffsets, const Nd4jLong numTads, void *vz, const Nd4jLong *zShapeInfo) {
+    auto x = reinterpret_cast<const X*>(vx);
+    const auto tadLength = shape::length(tadShapeInfo);
+
+    std::vector<float> sums(numTads);
+    if (numTads == 1) {
+        auto func = PRAGMA_REDUCE_DOUBLE {
+            return sumTadFp32<X>(x + tadOffsets[0], tadShapeInfo, absolute, start, stop);
+        };
+
+        sums[0] = static_cast<float>(samediff::Threads::parallel_double(func, LAMBDA_SUMD, 0, tadLength));
+    } else {
+        auto func = PRAGMA_THREADS_FOR {
+            for (auto t = start; t < stop; t++)
+                sums[t] = sumTadFp32<X>(x + tadOffsets[t], tadShapeInfo, absolute, 0, tadLength);
+        };
+
+        samediff::Threads::parallel_tad(func, 0, numTads);
+    }
+
+    storeFromFp32<X>(sums.data(), vz, zShapeInfo);
+}
+
+template <typename X>
+static void reduceFloatToFp32(const int opNum, sd::memory::Workspace *workspace, const void *hX, const Nd4jLong *hXShapeInfo, void *extraParams, float *tmp, const Nd4jLong *tmpShapeInfo, int *dimension) {
+    if (dimension == nullptr)
+        functions::reduce::ReduceFloatFunction<X, float>::execScalar(opNum, hX, hXShapeInfo, extraParams, tmp, tmpShapeInfo);
+    else
+        functions::reduce::ReduceFloatFunction<X, float>::exec(opNum, workspace, hX, hXShapeInfo, extraParams, tmp, tmpShapeInfo, dimension);
+}
+
+// extraParams are typed by Z. NormP is the only ReduceFloat op which reads them (p), so only that value has to be converted
+template <typename Z>
+static void paramsToFp32(const void *vextraParams, float *dst) {
+    dst[0] = static_cast<float>(reinterpret_cast<const Z*>(vextraParams)[0]);
+}
+
+static float* reduceFloatParamsFp32(const int opNum, const sd::DataType zType, const void *extraParams, float *storage) {
+    if (extraParams == nullptr || opNum != sd::reduce::NormP)
+        return nullptr;
+
+    BUILD_SINGLE_SELECTOR(zType, paramsToFp32, (extraParams, storage), FLOAT_TYPES);
+    return storage;
+}
+
+static bool reduceSameWithFp32(const int opNum, const sd::DataType xType, const Nd4jLong *hXShapeInfo) {
+    return (opNum == sd::reduce::Sum || opNum == sd::reduce::ASum) && !shape::isEmpty(hXShapeInfo) && sd::MixedPrecision::upcast(xType);
+}
+
+static const Nd4jLong* fp32ShapeInfo(const Nd4jLong *hZShapeInfo) {
+    if (shape::rank(hZShapeInfo) == 0)
+        return sd::ConstantShapeHelper::getInstance().scalarShapeInfo(sd::DataType::FLOAT32);
+
+    return sd::ConstantShapeHelper::getInstance().createShapeInfo(sd::DataType::FLOAT32, 'c', shape::rank(hZShapeInfo), shape::shapeOf(hZShapeInfo));
+}
 
 ////////////////////////////////////////////////////////////////////////
 /**
@@ -82,6 +186,8 @@ void NativeOpExecutioner::execIndexReduceScalar(sd::LaunchContext  *lc, int opNu
                                                 void *extraParams,
                                                 void *hZ, const Nd4jLong *hZShapeInfo,
                                                 void *dZ, const Nd4jLong *dZShapeInfo) {
+    sd::ScopedOpMarker marker("execIndexReduceScalar", 0L, -1, opNum);
+
 
 
 
@@ -114,6 +220,8 @@ void NativeOpExecutioner::execIndexReduce(sd::LaunchContext  *lc,
                                           void *dZ, const Nd4jLong *dZShapeInfo,
                                           int *dimension, int dimensionLength,
                                           const Nd4jLong *tadShapeInfo, const Nd4jLong *tadOffsets) {
+    sd::ScopedOpMarker marker("execIndexReduce", 0L, -1, opNum);
+
 
 
     auto xType = sd::ArrayOptions::dataType(hXShapeInfo);
@@ -148,6 +256,8 @@ void NativeOpExecutioner::execBroadcast(sd::LaunchContext  *lc,
                                         int *dimension, int dimensionLength,
                                         const Nd4jLong *tadOnlyShapeInfo, const Nd4jLong *tadOffsets,
                                         const Nd4jLong *tadOnlyShapeInfoZ,const Nd4jLong *tadOffsetsZ) {
+    sd::ScopedOpMarker marker("execBroadcast", 0L, -1, opNum);
+
 
 
 
@@ -211,6 +321,8 @@ void NativeOpExecutioner::execBroadcast(sd::LaunchContext* lc, const int opNum,
                                         const void *dY, const Nd4jLong *dYShapeInfo,
                                               void *hZ, const Nd4jLong *hZShapeInfo,
                                               void *dZ, const Nd4jLong *dZShapeInfo) {
+    sd::ScopedOpMarker marker("execBroadcast", 0L, -1, opNum);
+
 
     if (shape::isEmpty(hXShapeInfo) || shape::isEmpty(hYShapeInfo))
         return;
@@ -238,6 +350,8 @@ void NativeOpExecutioner::execInverseBroadcast(sd::LaunchContext  *lc,
                                                int *dimension, int dimensionLength,
                                                const Nd4jLong *tadOnlyShapeInfo, const Nd4jLong *tadOffsets,
                                                const Nd4jLong *tadOnlyShapeInfoZ,const Nd4jLong *tadOffsetsZ) {
+    sd::ScopedOpMarker marker("execInverseBroadcast", 0L, -1, opNum);
+
     auto xType = sd::ArrayOptions::dataType(hXShapeInfo);
     auto yType = sd::ArrayOptions::dataType(hYShapeInfo);
     auto zType = sd::ArrayOptions::dataType(hZShapeInfo);
@@ -279,6 +393,8 @@ void NativeOpExecutioner::execBroadcastBool(sd::LaunchContext  *lc,
                                             int *dimension, int dimensionLength,
                                             const Nd4jLong *tadOnlyShapeInfo, const Nd4jLong *tadOffsets,
                                             const Nd4jLong *tadOnlyShapeInfoZ,const Nd4jLong *tadOffsetsZ) {
+    sd::ScopedOpMarker marker("execBroadcastBool", 0L, -1, opNum);
+
 
 
     if (shape::isEmpty(hXShapeInfo) || shape::isEmpty(hYShapeInfo))
@@ -307,6 +423,8 @@ void NativeOpExecutioner::execBroadcastBool(sd::LaunchContext* lc, const int opN
                                               void *hZ, const Nd4jLong *hZShapeInfo,
                                               void *dZ, const Nd4jLong *dZShapeInfo,
                                               void *extraParams) {
+    sd::ScopedOpMarker marker("execBroadcastBool", 0L, -1, opNum);
+
 
     if (shape::isEmpty(hXShapeInfo) || shape::isEmpty(hYShapeInfo))
         return;
@@ -330,6 +448,8 @@ void NativeOpExecutioner::execInverseBroadcastBool(sd::LaunchContext  *lc,
                                                    int *dimension, int dimensionLength,
                                                    const Nd4jLong *tadOnlyShapeInfo, const Nd4jLong *tadOffsets,
                                                    const Nd4jLong *tadOnlyShapeInfoZ,const Nd4jLong *tadOffsetsZ) {
+    sd::ScopedOpMarker marker("execInverseBroadcastBool", 0L, -1, opNum);
+
 
     auto xType = sd::ArrayOptions::dataType(hXShapeInfo);
     auto yType = sd::ArrayOptions::dataType(hYShapeInfo);
@@ -367,6 +487,8 @@ void NativeOpExecutioner::execBroadcastInt(sd::LaunchContext  *lc,
                                            int *dimension, int dimensionLength,
                                            const Nd4jLong *tadOnlyShapeInfo, const Nd4jLong *tadOffsets,
                                            const Nd4jLong *tadOnlyShapeInfoZ,const Nd4jLong *tadOffsetsZ) {
+    sd::ScopedOpMarker marker("execBroadcastInt", 0L, -1, opNum);
+
 
 
     auto xType = sd::ArrayOptions::dataType(hXShapeInfo);
@@ -401,6 +523,8 @@ void NativeOpExecutioner::execBroadcastInt(sd::LaunchContext  *lc, const int opN
                                             const void *dY, const Nd4jLong *dYShapeInfo,
                                                   void *hZ, const Nd4jLong *hZShapeInfo,
                                                   void *dZ, const Nd4jLong *dZShapeInfo) {
+    sd::ScopedOpMarker marker("execBroadcastInt", 0L, -1, opNum);
+
 
 
     auto xType = sd::ArrayOptions::dataType(hXShapeInfo);
@@ -431,6 +555,8 @@ void NativeOpExecutioner::execInverseBroadcastInt(sd::LaunchContext  *lc,
                                                   int *dimension, int dimensionLength,
                                                   const Nd4jLong *tadOnlyShapeInfo, const Nd4jLong *tadOffsets,
                                                   const Nd4jLong *tadOnlyShapeInfoZ,const Nd4jLong *tadOffsetsZ) {
+    sd::ScopedOpMarker marker("execInverseBroadcastInt", 0L, -1, opNum);
+
 
     auto xType = sd::ArrayOptions::dataType(hXShapeInfo);
     auto yType = sd::ArrayOptions::dataType(hYShapeInfo);
@@ -478,6 +604,8 @@ void NativeOpExecutioner::execPairwiseTransform(sd::LaunchContext  *lc,
                                                 void *hZ, const Nd4jLong *hZShapeInfo,
                                                 void *dZ, const Nd4jLong *dZShapeInfo,
                                                 void *extraParams) {
+    sd::ScopedOpMarker marker("execPairwiseTransform", 0L, -1, opNum);
+
 
     auto xType = sd::ArrayOptions::dataType(hXShapeInfo);
     auto yType = sd::ArrayOptions::dataType(hYShapeInfo);
@@ -511,6 +639,8 @@ void NativeOpExecutioner::execPairwiseBoolTransform(sd::LaunchContext  *lc,
                                                     void *hZ, const Nd4jLong *hZShapeInfo,
                                                     void *dZ, const Nd4jLong *dZShapeInfo,
                                                     void *extraParams) {
+    sd::ScopedOpMarker marker("execPairwiseBoolTransform", 0L, -1, opNum);
+
 
 
     auto xType = sd::ArrayOptions::dataType(hXShapeInfo);
@@ -545,6 +675,8 @@ void NativeOpExecutioner::execPairwiseIntTransform(sd::LaunchContext  *lc,
                                                    void *hZ, const Nd4jLong *hZShapeInfo,
                                                    void *dZ, const Nd4jLong *dZShapeInfo,
                                                    void *extraParams) {
+    sd::ScopedOpMarker marker("execPairwiseIntTransform", 0L, -1, opNum);
+
 
     auto xType = sd::ArrayOptions::dataType(hXShapeInfo);
     auto yType = sd::ArrayOptions::dataType(hYShapeInfo);
@@ -586,6 +718,8 @@ void NativeOpExecutioner::execReduceFloat(sd::LaunchContext  *lc,
                                           void *hZ, const Nd4jLong *hZShapeInfo,
                                           void *dZ, const Nd4jLong *dZShapeInfo,
                                           int *dimension, int dimensionLength) {
+    sd::ScopedOpMarker marker("execReduceFloat", 0L, -1, opNum);
+
 
 
 
@@ -596,6 +730,17 @@ void NativeOpExecutioner::execReduceFloat(sd::LaunchContext  *lc,
     if (shape::isEmpty(hZShapeInfo))
         return;
 
+    if (sd::MixedPrecision::upcast(zType)) {
+        auto tmpShapeInfo = fp32ShapeInfo(hZShapeInfo);
+        std::vector<float> tmp(shape::length(hZShapeInfo));
+        float params[1];
+        auto fp32Params = reduceFloatParamsFp32(opNum, zType, extraParams, params);
+
+        BUILD_SINGLE_SELECTOR(xType, reduceFloatToFp32, (opNum, lc ? lc->getWorkspace() : nullptr, hX, hXShapeInfo, fp32Params, tmp.data(), tmpShapeInfo, dimension), LIBND4J_TYPES);
+        BUILD_SINGLE_SELECTOR(zType, storeFromFp32, (tmp.data(), hZ, hZShapeInfo), FLOAT_TYPES);
+        return;
+    }
+
       BUILD_DOUBLE_SELECTOR(xType, zType, functions::reduce::ReduceFloatFunction, ::exec(opNum, lc ? lc->getWorkspace() : nullptr, hX, hXShapeInfo, extraParams, hZ, hZShapeInfo, dimension), LIBND4J_TYPES, FLOAT_TYPES);
 }
 
@@ -608,6 +753,8 @@ void NativeOpExecutioner::execReduceSame(sd::LaunchContext  *lc,
                                          void *hZ, const Nd4jLong *hZShapeInfo,
                                          void *dZ, const Nd4jLong *dZShapeInfo,
                                          int *dimension, int dimensionLength) {
+    sd::ScopedOpMarker marker("execReduceSame", 0L, -1, opNum);
+
 
 
     auto xType = sd::ArrayOptions::dataType(hXShapeInfo);
@@ -616,6 +763,12 @@ void NativeOpExecutioner::execReduceSame(sd::LaunchContext  *lc,
     if (shape::isEmpty(hZShapeInfo))
         return;
 
+    if (reduceSameWithFp32(opNum, xType, hXShapeInfo)) {
+        auto tadPack = sd::ConstantTadHelper::getInstance().tadForDimensions(hXShapeInfo, dimension, dimensionLength);
+        BUILD_SINGLE_SELECTOR(xType, sumWithFp32, (opNum == sd::reduce::ASum, hX, tadPack.primaryShapeInfo(), tadPack.primaryOffsets(), tadPack.numberOfTads(), hZ, hZShapeInfo), FLOAT_TYPES);
+        return;
+    }
+
     BUILD_SINGLE_SELECTOR(xType, functions::reduce::ReduceSameFunction, ::exec(opNum, lc ? lc->getWorkspace() : nullptr, hX, hXShapeInfo, extraParams, hZ, hZShapeInfo, dimension), LIBND4J_TYPES);
 }
 
@@ -628,6 +781,8 @@ void NativeOpExecutioner::execReduceBool(sd::LaunchContext  *lc,
                                          void *hZ, const Nd4jLong *hZShapeInfo,
                                          void *dZ, const Nd4jLong *dZShapeInfo,
                                          int *dimension, int dimensionLength) {
+    sd::ScopedOpMarker marker("execReduceBool", 0L, -1, opNum);
+
 
 
     auto xType = sd::ArrayOptions::dataType(hXShapeInfo);
@@ -649,6 +804,8 @@ void NativeOpExecutioner::execReduceLong(sd::LaunchContext  *lc,
                                          void *hZ, const Nd4jLong *hZShapeInfo,
                                          void *dZ, const Nd4jLong *dZShapeInfo,
                                          int *dimension, int dimensionLength) {
+    sd::ScopedOpMarker marker("execReduceLong", 0L, -1, opNum);
+
 
 
     auto xType = sd::ArrayOptions::dataType(hXShapeInfo);
@@ -677,11 +834,23 @@ void NativeOpExecutioner::execReduceFloatScalar(sd::LaunchContext  *lc,
                                                 void *extraParams,
                                                 void *hZ, const Nd4jLong *hZShapeInfo,
                                                 void *dZ, const Nd4jLong *dZShapeInfo) {
+    sd::ScopedOpMarker marker("execReduceFloatScalar", 0L, -1, opNum);
+
 
 
     auto xType = sd::ArrayOptions::dataType(hXShapeInfo);
     auto zType = sd::ArrayOptions::dataType(hZShapeInfo);
 
+    if (sd::MixedPrecision::upcast(zType)) {
+        float tmp = 0.f;
+        float params[1];
+        auto fp32Params = reduceFloatParamsFp32(opNum, zType, extraParams, params);
+
+        BUILD_SINGLE_SELECTOR(xType, reduceFloatToFp32, (opNum, nullptr, hX, hXShapeInfo, fp32Params, &tmp, fp32ShapeInfo(hZShapeInfo), nullptr), LIBND4J_TYPES);
+        BUILD_SINGLE_SELECTOR(zType, storeFromFp32, (&tmp, hZ, hZShapeInfo), FLOAT_TYPES);
+        return;
+    }
+
     BUILD_DOUBLE_SELECTOR(xType, zType, functions::reduce::ReduceFloatFunction, ::execScalar(opNum, hX, hXShapeInfo, extraParams, hZ, hZShapeInfo), LIBND4J_TYPES, FLOAT_TYPES);
 }
 
@@ -693,10 +862,18 @@ void NativeOpExecutioner::execReduceSameScalar(sd::LaunchContext  *lc,
                                                void *extraParams,
                                                void *hZ, const Nd4jLong *hZShapeInfo,
                                                void *dZ, const Nd4jLong *dZShapeInfo) {
+    sd::ScopedOpMarker marker("execReduceSameScalar", 0L, -1, opNum);
+
 
 
     auto xType = sd::ArrayOptions::dataType(hXShapeInfo);
 
+    if (reduceSameWithFp32(opNum, xType, hXShapeInfo)) {
+        Nd4jLong offset = 0L;
+        BUILD_SINGLE_SELECTOR(xType, sumWithFp32, (opNum == sd::reduce::ASum, hX, hXShapeInfo, &offset, 1, hZ, hZShapeInfo), FLOAT_TYPES);
+        return;
+    }
+
     BUILD_SINGLE_SELECTOR(xType, functions::reduce::ReduceSameFunction, ::execScalar(opNum, hX, hXShapeInfo, extraParams, hZ, hZShapeInfo), LIBND4J_TYPES);
 }
 
@@ -708,6 +885,8 @@ void NativeOpExecutioner::execReduceBoolScalar(sd::LaunchContext  *lc,
                                                void *extraParams,
                                                void *hZ, const Nd4jLong *hZShapeInfo,
                                                void *dZ, const Nd4jLong *dZShapeInfo) {
+    sd::ScopedOpMarker marker("execReduceBoolScalar", 0L, -1, opNum);
+
 
     auto xType = sd::ArrayOptions::dataType(hXShapeInfo);
     auto zType = sd::ArrayOptions::dataType(hZShapeInfo);
@@ -723,6 +902,8 @@ void NativeOpExecutioner::execReduceLongScalar(sd::LaunchContext  *lc,
                                                void *extraParams,
                                                void *hZ, const Nd4jLong *hZShapeInfo,
                                                void *dZ, const Nd4jLong *dZShapeInfo) {
+    sd::ScopedOpMarker marker("execReduceLongScalar", 0L, -1, opNum);
+
 
     auto xType = sd::ArrayOptions::dataType(hXShapeInfo);
     auto zType = sd::ArrayOptions::dataType(hZShapeInfo);
@@ -754,6 +935,8 @@ void NativeOpExecutioner::execReduce3Scalar(sd::LaunchContext  *lc,
                                             const void *dY, const Nd4jLong *dYShapeInfo,
                                             void *hZ, const Nd4jLong *hZShapeInfo,
                                             void *dZ, const Nd4jLong *dZShapeInfo) {
+    sd::ScopedOpMarker marker("execReduce3Scalar", 0L, -1, opNum);
+
 
     auto xType = sd::ArrayOptions::dataType(hXShapeInfo);
     auto zType = sd::ArrayOptions::dataType(hZShapeInfo);
@@ -783,6 +966,8 @@ void NativeOpExecutioner::execReduce3(sd::LaunchContext  *lc,
                                       const void *dY, const Nd4jLong *dYShapeInfo,
                                       void *hZ, const Nd4jLong *hZShapeInfo,
                                       void *dZ, const Nd4jLong *dZShapeInfo) {
+    sd::ScopedOpMarker marker("execReduce3", 0L, -1, opNum);
+
 
     auto xType = sd::ArrayOptions::dataType(hXShapeInfo);
     auto zType = sd::ArrayOptions::dataType(hZShapeInfo);
@@ -804,6 +989,8 @@ void NativeOpExecutioner::execReduce3(sd::LaunchContext  *lc,
                                       int *dimension, int dimensionLength,
                                       const Nd4jLong *xTadOnlyShapeInfo, const Nd4jLong *xTadOffsets,
                                       const Nd4jLong *yTadOnlyShapeInfo, const Nd4jLong *yTadOffsets) {
+    sd::ScopedOpMarker marker("execReduce3", 0L, -1, opNum);
+
 
 
     auto xType = sd::ArrayOptions::dataType(hXShapeInfo);
@@ -845,6 +1032,8 @@ void NativeOpExecutioner::execReduce3All(sd::LaunchContext  *lc,
                                          int *dimension, int dimensionLength,
                                          const Nd4jLong *xTadShapeInfo, const Nd4jLong *xOffsets,
                                          const Nd4jLong *yTadShapeInfo, const Nd4jLong *yOffsets) {
+    sd::ScopedOpMarker marker("execReduce3All", 0L, -1, opNum);
+
 
     auto xType = sd::ArrayOptions::dataType(hXShapeInfo);
     auto zType = sd::ArrayOptions::dataType(hZShapeInfo);
@@ -872,6 +1061,8 @@ void NativeOpExecutioner::execReduce3TAD(sd::LaunchContext  *lc,
                                          int *dimension, int dimensionLength,
                                          const Nd4jLong *tadShapeInfo, const Nd4jLong *tadOffsets,
                                          const Nd4jLong *yTadShapeInfo, const Nd4jLong *yTadOffsets) {
+    sd::ScopedOpMarker marker("execReduce3TAD", 0L, -1, opNum);
+
 
     auto xType = sd::ArrayOptions::dataType(hXShapeInfo);
     auto zType = sd::ArrayOptions::dataType(hZShapeInfo);
@@ -921,6 +1112,8 @@ void NativeOpExecutioner::execScalar(sd::LaunchContext  *lc,
                                      const void *dScalar, const Nd4jLong *dScalarShapeInfo,
                                      void *extraParams,
                                      bool allowParallelism) {
+    sd::ScopedOpMarker marker("execScalar", 0L, -1, opNum);
+
 
     auto xType = sd::ArrayOptions::dataType(hXShapeInfo);
     auto yType = sd::ArrayOptions::dataType(hScalarShapeInfo);
@@ -958,6 +1151,8 @@ void NativeOpExecutioner::execScalar(sd::LaunchContext  *lc,
                             int *dimension, int dimensionLength,
                             Nd4jLong  const*tadShapeInfo, Nd4jLong  const*tadOffsets,
                             Nd4jLong  const*tadShapeInfoZ, Nd4jLong  const*tadOffsetsZ) {
+    sd::ScopedOpMarker marker("execScalar", 0L, -1, opNum);
+
 
     auto xType = sd::ArrayOptions::dataType(hXShapeInfo);
     auto yType = sd::ArrayOptions::dataType(hScalarShapeInfo);
@@ -993,6 +1188,8 @@ void NativeOpExecutioner::execScalarBool(sd::LaunchContext  *lc,
                                          const void *dScalar, const Nd4jLong *dSscalarShapeInfo,
                                          void *extraParams,
                                          bool allowParallelism) {
+    sd::ScopedOpMarker marker("execScalarBool", 0L, -1, opNum);
+
 
     auto xType = sd::ArrayOptions::dataType(hXShapeInfo);
     auto yType = sd::ArrayOptions::dataType(hSscalarShapeInfo);
@@ -1029,6 +1226,8 @@ void NativeOpExecutioner::execScalarBool(sd::LaunchContext  *lc,
                                          int *dimension, int dimensionLength,
                                          const Nd4jLong *tadShapeInfo, const Nd4jLong *tadOffsets,
                                          const Nd4jLong *tadShapeInfoZ, const Nd4jLong *tadOffsetsZ) {
+    sd::ScopedOpMarker marker("execScalarBool", 0L, -1, opNum);
+
 
     auto xType = sd::ArrayOptions::dataType(hXShapeInfo);
     auto yType = sd::ArrayOptions::dataType(hScalarShapeInfo);
@@ -1062,6 +1261,8 @@ void NativeOpExecutioner::execScalarInt(sd::LaunchContext  *lc,
                                         const void *dScalar, const Nd4jLong *dSscalarShapeInfo,
                                         void *extraParams,
                                         bool allowParallelism) {
+    sd::ScopedOpMarker marker("execScalarInt", 0L, -1, opNum);
+
 
     auto xType = sd::ArrayOptions::dataType(hXShapeInfo);
     auto yType = sd::ArrayOptions::dataType(hSscalarShapeInfo);
@@ -1098,6 +1299,8 @@ void NativeOpExecutioner::execScalarInt(sd::LaunchContext  *lc,
                                         int *dimension, int dimensionLength,
                                         const Nd4jLong *tadShapeInfo, const Nd4jLong *tadOffsets,
                                         const Nd4jLong *tadShapeInfoZ, const Nd4jLong *tadOffsetsZ) {
+    sd::ScopedOpMarker marker("execScalarInt", 0L, -1, opNum);
+
 
     auto xType = sd::ArrayOptions::dataType(hXShapeInfo);
     auto yType = sd::ArrayOptions::dataType(hScalarShapeInfo);
@@ -1138,6 +1341,8 @@ void NativeOpExecutioner::execSummaryStats(sd::LaunchContext  *lc,
                                            void *hZ, const Nd4jLong *hZShapeInfo,
                                            void *dZ, const Nd4jLong *dZShapeInfo,
                                            bool biasCorrected) {
+    sd::ScopedOpMarker marker("execSummaryStats", 0L, -1, opNum);
+
 
 
     auto xType = sd::ArrayOptions::dataType(hXShapeInfo);
@@ -1164,6 +1369,8 @@ void NativeOpExecutioner::execSummaryStatsScalar(sd::LaunchContext  *lc,
                                                  void *hZ, const Nd4jLong *hZShapeInfo,
                                                  void *dZ, const Nd4jLong *dZShapeInfo,
                                                  bool biasCorrected) {
+    sd::ScopedOpMarker marker("execSummaryStatsScalar", 0L, -1, opNum);
+
 
 
     auto xType = sd::ArrayOptions::dataType(hXShapeInfo);
@@ -1194,6 +1401,8 @@ void NativeOpExecutioner::execSummaryStats(sd::LaunchContext  *lc,
                                            int *dimension, int dimensionLength,
                                            const Nd4jLong *tadShapeInfo, const Nd4jLong *tadOffsets,
                                            bool biasCorrected) {
+    sd::ScopedOpMarker marker("execSummaryStats", 0L, -1, opNum);
+
     auto xType = sd::ArrayOptions::dataType(hXShapeInfo);
     auto zType = sd::ArrayOptions::dataType(hZShapeInfo);
 
@@ -1220,14 +1429,23 @@ void NativeOpExecutioner::execTransformFloat(sd::LaunchContext  *lc,
                                              void *dZ, const Nd4jLong *dZShapeInfo,
                                              void *extraParams,
                                              const Nd4jLong *tadShapeInfo, const Nd4jLong *tadOffsets) {
+    sd::ScopedOpMarker marker("execTransformFloat", 0L, -1, opNum);
+
     auto xType = sd::ArrayOptions::dataType(hXShapeInfo);
     auto zType = sd::ArrayOptions::dataType(hZShapeInfo);
 
     if (shape::isEmpty(hXShapeInfo))
         return;
 
+    // extraParams are typed by Z, so transforms which use them stay in 16 bit
+    const bool fp32 = sd::MixedPrecision::upcast(zType) && extraParams == nullptr;
+
     auto func = PRAGMA_THREADS_DO {
-        BUILD_DOUBLE_SELECTOR(xType, zType, functions::transform::TransformFloat, ::exec(opNum, hX, hXShapeInfo, hZ, hZShapeInfo, extraParams, thread_id, numThreads), LIBND4J_TYPES, FLOAT_TYPES);
+        if (fp32) {
+            BUILD_DOUBLE_SELECTOR(xType, zType, functions::transform::TransformFloat, ::execFp32(opNum, hX, hXShapeInfo, hZ, hZShapeInfo, thread_id, numThreads), LIBND4J_TYPES, HALF_TYPES);
+        } else {
+            BUILD_DOUBLE_SELECTOR(xType, zType, functions::transform::TransformFloat, ::exec(opNum, hX, hXShapeInfo, hZ, hZShapeInfo, extraParams, thread_id, numThreads), LIBND4J_TYPES, FLOAT_TYPES);
+        }
     };
 
     samediff::Threads::parallel_do(func, sd::math::nd4j_max<int>(1, sd::math::nd4j_min<int>(shape::length(hZShapeInfo) / 1024, sd::Environment::getInstance().maxMasterThreads())));
@@ -1242,6 +1460,8 @@ void NativeOpExecutioner::execTransformBool(sd::LaunchContext  *lc,
                                             void *dZ, const Nd4jLong *dZShapeInfo,
                                             void *extraParams,
                                             const Nd4jLong *tadShapeInfo, const Nd4jLong *tadOffsets) {
+    sd::ScopedOpMarker marker("execTransformBool", 0L, -1, opNum);
+
     auto xType = sd::ArrayOptions::dataType(hXShapeInfo);
     auto zType = sd::ArrayOptions::dataType(hZShapeInfo);
 
@@ -1265,6 +1485,8 @@ void NativeOpExecutioner::execTransformAny(sd::LaunchContext  *lc,
                                            void *extraParams,
                                            const Nd4jLong *tadShapeInfo, const Nd4jLong *tadOffsets,
                                            bool allowParallelism) {
+    sd::ScopedOpMarker marker("execTransformAny", 0L, -1, opNum);
+
     auto xType = sd::ArrayOptions::dataType(hXShapeInfo);
     auto zType = sd::ArrayOptions::dataType(hZShapeInfo);
 
@@ -1294,6 +1516,8 @@ void NativeOpExecutioner::execTransformSame(sd::LaunchContext  *lc,
                                             void *dZ, const Nd4jLong *dZShapeInfo,
                                             void *extraParams,
                                             const Nd4jLong *tadShapeInfo, const Nd4jLong *tadOffsets) {
+    sd::ScopedOpMarker marker("execTransformSame", 0L, -1, opNum);
+
     auto xType = sd::ArrayOptions::dataType(hXShapeInfo);
     auto zType = sd::ArrayOptions::dataType(hZShapeInfo);
 
@@ -1316,14 +1540,23 @@ void NativeOpExecutioner::execTransformStrict(sd::LaunchContext  *lc,
                                               void *dZ, const Nd4jLong *dZShapeInfo,
                                               void *extraParams,
                                               const Nd4jLong *tadShapeInfo, const Nd4jLong *tadOffsets) {
+    sd::ScopedOpMarker marker("execTransformStrict", 0L, -1, opNum);
+
     auto xType = sd::ArrayOptions::dataType(hXShapeInfo);
     auto zType = sd::ArrayOptions::dataType(hZShapeInfo);
 
     if (shape::isEmpty(hXShapeInfo))
         return;
 
+    // extraParams are typed by Z, so transforms which use them stay in 16 bit
+    const bool fp32 = sd::MixedPrecision::upcast(zType) && extraParams == nullptr;
+
     auto func = PRAGMA_THREADS_DO {
-        BUILD_SINGLE_SELECTOR(xType, functions::transform::TransformStrict, ::exec(opNum, hX, hXShapeInfo, hZ, hZShapeInfo, extraParams, thread_id, numThreads), FLOAT_TYPES);
+        if (fp32) {
+            BUILD_SINGLE_SELECTOR(xType, functions::transform::TransformStrict, ::execFp32(opNum, hX, hXShapeInfo, hZ, hZShapeInfo, thread_id, numThreads), HALF_TYPES);
+        } else {
+            BUILD_SINGLE_SELECTOR(xType, functions::transform::TransformStrict, ::exec(opNum, hX, hXShapeInfo, hZ, hZShapeInfo, extraParams, thread_id, numThreads), FLOAT_TYPES);
+        }
     };
 
     samediff::Threads::parallel_do(func, sd::math::nd4j_max<int>(1, sd::math::nd4j_min<int>(shape::length(hZShapeInfo) / 1024, sd::Environment::getInstance().maxMasterThreads())));
@@ -1336,6 +1569,8 @@ void NativeOpExecutioner::execRandom(sd::LaunchContext  *lc,
                                      void *hZ, const Nd4jLong *hZShapeInfo,
                                      void *dZ, const Nd4jLong *dZShapeInfo,
                                      void *extraArguments) {
+    sd::ScopedOpMarker marker("execRandom", 0L, -1, opNum);
+
 
 
     auto zType = sd::ArrayOptions::dataType(hZShapeInfo);
@@ -1355,6 +1590,8 @@ void NativeOpExecutioner::execRandom(sd::LaunchContext  *lc,
                                      void *hZ, const Nd4jLong *hZShapeInfo,
                                      void *dZ, const Nd4jLong *dZShapeInfo,
                                      void *extraArguments) {
+    sd::ScopedOpMarker marker("execRandom", 0L, -1, opNum);
+
 
     auto zType = sd::ArrayOptions::dataType(hZShapeInfo);
 
@@ -1375,6 +1612,8 @@ void NativeOpExecutioner::execRandom(sd::LaunchContext  *lc,
                                      void *hZ, const Nd4jLong *hZShapeInfo,
                                      void *dZ, const Nd4jLong *dZShapeInfo,
                                      void *extraArguments) {
+    sd::ScopedOpMarker marker("execRandom", 0L, -1, opNum);
+
 
     auto xType = sd::ArrayOptions::dataType(hZShapeInfo);
 
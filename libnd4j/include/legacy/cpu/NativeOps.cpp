@@ -75,6 +75,7 @@ bool experimentalSupport = false;
 #include <performance/benchmarking/BenchmarkSuit.h>
 #include <performance/benchmarking/FullBenchmarkSuit.h>
 #include <performance/benchmarking/LightBenchmarkSuit.h>
+#include <helpers/SamplingProfiler.h>
 #include <execution/Threads.h>
 
 #ifdef CPU_FEATURES
@@ -1203,6 +1204,22 @@ void enableVerboseMode(bool reallyEnable) {
     sd::Environment::getInstance().setVerbose(reallyEnable);
 }
 
+void enableFp32Accumulation(bool reallyEnable) {
+    sd::Environment::getInstance().setFp32Accumulation(reallyEnable);
+}
+
+void enableNanGuard(bool reallyEnable) {
+    sd::Environment::getInstance().setNanGuard(reallyEnable);
+}
+
+void enableHardwareCounters(bool reallyEnable) {
+    sd::Environment::getInstance().setHardwareCounters(reallyEnable);
+}
+
+bool isHardwareCountersEnabled() {
+    return sd::Environment::getInstance().isHardwareCounters();
+}
+
 void setGridLimit(int gridSize) {
     // no-op
 }
@@ -1417,6 +1434,51 @@ void accumulate(Nd4jPointer *extras,
     }
 }
 
+OpaqueStreamingAccumulator* createStreamingAccumulator(int dataType, Nd4jLong length) {
+    try {
+        return new sd::StreamingAccumulator(sd::DataTypeUtils::fromInt(dataType), length);
+    } catch (std::exception &e) {
+        sd::LaunchContext::defaultContext()->errorReference()->setErrorCode(1);
+        sd::LaunchContext::defaultContext()->errorReference()->setErrorMessage(e.what());
+        return nullptr;
+    }
+}
+
+void deleteStreamingAccumulator(OpaqueStreamingAccumulator* ptr) {
+    delete ptr;
+}
+
+void streamingAccumulatorAdd(OpaqueStreamingAccumulator* ptr, void *hX, Nd4jLong const* hXShapeInfo) {
+    try {
+        NDArray x(hX, hXShapeInfo);
+        ptr->add(x);
+    } catch (std::exception &e) {
+        sd::LaunchContext::defaultContext()->errorReference()->setErrorCode(1);
+        sd::LaunchContext::defaultContext()->errorReference()->setErrorMessage(e.what());
+    }
+}
+
+void streamingAccumulatorStore(OpaqueStreamingAccumulator* ptr, void *hZ, Nd4jLong const* hZShapeInfo, bool average) {
+    try {
+        NDArray z(hZ, hZShapeInfo);
+        if (average)
+            ptr->average(z);
+        else
+            ptr->sum(z);
+    } catch (std::exception &e) {
+        sd::LaunchContext::defaultContext()->errorReference()->setErrorCode(1);
+        sd::LaunchContext::defaultContext()->errorReference()->setErrorMessage(e.what());
+    }
+}
+
+void streamingAccumulatorReset(OpaqueStreamingAccumulator* ptr) {
+    ptr->reset();
+}
+
+Nd4jLong streamingAccumulatorCount(OpaqueStreamingAccumulator* ptr) {
+    return ptr->count();
+}
+
 void enableP2P(bool enable) {
     // no-op
 }
@@ -2670,6 +2732,23 @@ void inspectArray(Nd4jPointer *extraPointers, Nd4jPointer buffer, Nd4jLong *shap
     }
 }
 
+void inspectArrays(Nd4jPointer *extraPointers, int numArrays, Nd4jPointer *buffers, Nd4jLong **shapeInfos, Nd4jPointer *specialBuffers, Nd4jLong **specialShapeInfos, Nd4jPointer debugInfos, Nd4jLong maxSamples) {
+    try {
+        auto p = reinterpret_cast<sd::DebugInfo *>(debugInfos);
+        std::vector<NDArray const*> arrays(numArrays);
+        for (int e = 0; e < numArrays; e++)
+            arrays[e] = new NDArray(buffers[e], shapeInfos[e]);
+
+        sd::DebugHelper::retrieveDebugStatistics(p, arrays, maxSamples);
+
+        for (auto v: arrays)
+            delete v;
+    } catch (std::exception &e) {
+        sd::LaunchContext::defaultContext()->errorReference()->setErrorCode(1);
+        sd::LaunchContext::defaultContext()->errorReference()->setErrorMessage(e.what());
+    }
+}
+
 void tryPointer(Nd4jPointer extra, Nd4jPointer p, int len) {
     try {
         auto buf = reinterpret_cast<int8_t *>(p);
@@ -2805,6 +2884,10 @@ void ctxAllowHelpers(OpaqueContext* ptr, bool reallyAllow) {
     ptr->allowHelpers(reallyAllow);
 }
 
+void ctxSetFp32Accumulation(OpaqueContext* ptr, bool reallyEnable) {
+    ptr->setFp32Accumulation(reallyEnable);
+}
+
 void ctxSetExecutionMode(OpaqueContext* ptr, int execMode) {
     if (execMode < 0 || execMode > 2)
         execMode = 0;
@@ -2982,6 +3065,34 @@ const char* runLightBenchmarkSuit(bool printOut) {
     }
 }
 
+bool startSamplingProfiler(int frequency) {
+    return sd::SamplingProfiler::getInstance().start(frequency);
+}
+
+void stopSamplingProfiler() {
+    sd::SamplingProfiler::getInstance().stop();
+}
+
+void resetSamplingProfiler() {
+    sd::SamplingProfiler::getInstance().reset();
+}
+
+const char* dumpSamplingProfile() {
+    try {
+        auto result = sd::SamplingProfiler::getInstance().foldedStacks();
+
+        auto chars = new char[result.length() + 1];
+        std::memcpy(chars, result.data(), result.length());
+        chars[result.length()] = (char) 0x0;
+
+        return chars;
+    } catch (std::exception &e) {
+        sd::LaunchContext::defaultContext()->errorReference()->setErrorCode(1);
+        sd::LaunchContext::defaultContext()->errorReference()->setErrorMessage(e.what());
+        return nullptr;
+    }
+}
+
 Nd4jLong getCachedMemory(int deviceId) {
     return sd::ConstantHelper::getInstance().getCachedAmount(deviceId);
 }
@@ -52,6 +52,7 @@ using namespace sd;
 #include <loops/special_kernels.h>
 #include <performance/benchmarking/FullBenchmarkSuit.h>
 #include <performance/benchmarking/LightBenchmarkSuit.h>
+#include <helpers/SamplingProfiler.h>
 
 cudaDeviceProp *deviceProperties;
 cudaFuncAttributes *funcAttributes = new cudaFuncAttributes[64];
@@ -1379,6 +1380,22 @@ void enableVerboseMode(bool reallyEnable) {
 	sd::Environment::getInstance().setVerbose(reallyEnable);
 }
 
+void enableFp32Accumulation(bool reallyEnable) {
+	sd::Environment::getInstance().setFp32Accumulation(reallyEnable);
+}
+
+void enableNanGuard(bool reallyEnable) {
+	sd::Environment::getInstance().setNanGuard(reallyEnable);
+}
+
+void enableHardwareCounters(bool reallyEnable) {
+	sd::Environment::getInstance().setHardwareCounters(reallyEnable);
+}
+
+bool isHardwareCountersEnabled() {
+	return sd::Environment::getInstance().isHardwareCounters();
+}
+
 int getDeviceMajor(int device) {
 	return deviceProperties[device].major;
 }
@@ -1588,6 +1605,51 @@ void accumulate(Nd4jPointer *extras,
     }
 }
 
+OpaqueStreamingAccumulator* createStreamingAccumulator(int dataType, Nd4jLong length) {
+    try {
+        return new sd::StreamingAccumulator(sd::DataTypeUtils::fromInt(dataType), length);
+    } catch (std::exception &e) {
+        sd::LaunchContext::defaultContext()->errorReference()->setErrorCode(1);
+        sd::LaunchContext::defaultContext()->errorReference()->setErrorMessage(e.what());
+        return nullptr;
+    }
+}
+
+void deleteStreamingAccumulator(OpaqueStreamingAccumulator* ptr) {
+    delete ptr;
+}
+
+void streamingAccumulatorAdd(OpaqueStreamingAccumulator* ptr, void *hX, Nd4jLong const* hXShapeInfo) {
+    try {
+        NDArray x(hX, hXShapeInfo);
+        ptr->add(x);
+    } catch (std::exception &e) {
+        sd::LaunchContext::defaultContext()->errorReference()->setErrorCode(1);
+        sd::LaunchContext::defaultContext()->errorReference()->setErrorMessage(e.what());
+    }
+}
+
+void streamingAccumulatorStore(OpaqueStreamingAccumulator* ptr, void *hZ, Nd4jLong const* hZShapeInfo, bool average) {
+    try {
+        NDArray z(hZ, hZShapeInfo);
+        if (average)
+            ptr->average(z);
+        else
+            ptr->sum(z);
+    } catch (std::exception &e) {
+        sd::LaunchContext::defaultContext()->errorReference()->setErrorCode(1);
+        sd::LaunchContext::defaultContext()->errorReference()->setErrorMessage(e.what());
+    }
+}
+
+void streamingAccumulatorReset(OpaqueStreamingAccumulator* ptr) {
+    ptr->reset();
+}
+
+Nd4jLong streamingAccumulatorCount(OpaqueStreamingAccumulator* ptr) {
+    return ptr->count();
+}
+
 
 void shuffle(Nd4jPointer *extras,
 						Nd4jPointer *x, Nd4jPointer *xShapeInfo,
@@ -3373,6 +3435,24 @@ void inspectArray(Nd4jPointer *extraPointers, Nd4jPointer buffer, Nd4jLong *shap
     }
 }
 
+void inspectArrays(Nd4jPointer *extraPointers, int numArrays, Nd4jPointer *buffers, Nd4jLong **shapeInfos, Nd4jPointer *specialBuffers, Nd4jLong **specialShapeInfos, Nd4jPointer debugInfos, Nd4jLong maxSamples) {
+    try {
+        LaunchContext lc(extraPointers[1], extraPointers[4], extraPointers[5], extraPointers[3]);
+        auto p = reinterpret_cast<sd::DebugInfo *>(debugInfos);
+        std::vector<NDArray const*> arrays(numArrays);
+        for (int e = 0; e < numArrays; e++)
+            arrays[e] = new NDArray(buffers[e], specialBuffers[e], shapeInfos[e], &lc);
+
+        sd::DebugHelper::retrieveDebugStatistics(p, arrays, maxSamples);
+
+        for (auto v: arrays)
+            delete v;
+    } catch (std::exception &e) {
+        sd::LaunchContext::defaultContext()->errorReference()->setErrorCode(1);
+        sd::LaunchContext::defaultContext()->errorReference()->setErrorMessage(e.what());
+    }
+}
+
 void __global__ tryPointerKernel(void* p, int len) {
     auto buf = reinterpret_cast<int8_t*>(p);
     auto tid = threadIdx.x + blockIdx.x * blockDim.x;
@@ -3654,6 +3734,34 @@ const char* runFullBenchmarkSuit(bool printOut) {
     }
 }
 
+bool startSamplingProfiler(int frequency) {
+    return sd::SamplingProfiler::getInstance().start(frequency);
+}
+
+void stopSamplingProfiler() {
+    sd::SamplingProfiler::getInstance().stop();
+}
+
+void resetSamplingProfiler() {
+    sd::SamplingProfiler::getInstance().reset();
+}
+
+const char* dumpSamplingProfile() {
+    try {
+        auto result = sd::SamplingProfiler::getInstance().foldedStacks();
+
+        auto chars = new char[result.length() + 1];
+        std::memcpy(chars, result.data(), result.length());
+        chars[result.length()] = (char) 0x0;
+
+        return chars;
+    } catch (std::exception &e) {
+        sd::LaunchContext::defaultContext()->errorReference()->setErrorCode(1);
+        sd::LaunchContext::defaultContext()->errorReference()->setErrorMessage(e.what());
+        return nullptr;
+    }
+}
+
 Nd4jLong getCachedMemory(int deviceId) {
     return sd::ConstantHelper::getInstance().getCachedAmount(deviceId);
 }
@@ -3726,6 +3834,10 @@ void ctxAllowHelpers(OpaqueContext* ptr, bool reallyAllow) {
     ptr->allowHelpers(reallyAllow);
 }
 
+void ctxSetFp32Accumulation(OpaqueContext* ptr, bool reallyEnable) {
+    ptr->setFp32Accumulation(reallyEnable);
+}
+
 void ctxSetExecutionMode(OpaqueContext* ptr, int execMode) {
     if (execMode < 0 || execMode > 2)
         execMode = 0;
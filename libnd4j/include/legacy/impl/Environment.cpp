@@ -27,6 +27,7 @@
 #include <thread>
 #include <helpers/logger.h>
 #include <memory/MemoryCounter.h>
+#include <helpers/HardwareCounters.h>
 
 #ifdef _OPENMP
 
@@ -43,6 +44,9 @@
 
 namespace sd {
 
+    // per-thread cap of master threads, 0 means no cap
+    static thread_local int localMasterThreads = 0;
+
     sd::Environment::Environment() {
         _tadThreshold.store(1);
         _elementThreshold.store(1024);
@@ -163,10 +167,43 @@ namespace sd {
             }
         }
 
+        /**
+         * This var defines max size of columns buffer used by 3D convolutions
+         */
+        const char* conv_buffer_limit = std::getenv("SD_CONV_BUFFER_LIMIT");
+        if (conv_buffer_limit != nullptr) {
+            try {
+                std::string t(conv_buffer_limit);
+                auto val = std::stol(t);
+                if (val > 0)
+                    _convolutionBufferLimit.store(val);
+            } catch (std::invalid_argument &e) {
+                // just do nothing
+            } catch (std::out_of_range &e) {
+                // still do nothing
+            }
+        }
+
         const char* blas_fallback = std::getenv("SD_BLAS_FALLBACK");
         if (blas_fallback != nullptr) {
             _blasFallback = true;
         }
+
+        /**
+         * If this env var is defined - 16 bit floating point types will be accumulated in FLOAT32 by default
+         */
+        const char* fp32_accumulation = std::getenv("SD_FP32_ACCUMULATION");
+        if (fp32_accumulation != nullptr) {
+            _fp32Accumulation = true;
+        }
+
+        /**
+         * If this env var is defined - ops will report NaN/Inf values produced by their kernels
+         */
+        const char* nan_guard = std::getenv("SD_NAN_GUARD");
+        if (nan_guard != nullptr) {
+            _nanGuard = true;
+        }
 #endif
 
 #ifdef __CUDABLAS__
@@ -295,7 +332,16 @@ namespace sd {
     }
 
     int Environment::maxMasterThreads() {
-        return _maxMasterThreads.load();
+        auto global = _maxMasterThreads.load();
+        return localMasterThreads > 0 && localMasterThreads < global ? localMasterThreads : global;
+    }
+
+    int Environment::localMaxMasterThreads() {
+        return localMasterThreads;
+    }
+
+    void Environment::setLocalMaxMasterThreads(int max) {
+        localMasterThreads = max > 0 ? max : 0;
     }
 
     void Environment::setMaxThreads(int max) {
@@ -322,6 +368,30 @@ namespace sd {
         _precBoost.store(reallyAllow);
     }
 
+    bool Environment::isFp32Accumulation() {
+        return _fp32Accumulation.load();
+    }
+
+    void Environment::setFp32Accumulation(bool reallyEnable) {
+        _fp32Accumulation.store(reallyEnable);
+    }
+
+    bool Environment::isNanGuard() {
+        return _nanGuard.load(std::memory_order_relaxed);
+    }
+
+    void Environment::setNanGuard(bool reallyEnable) {
+        _nanGuard.store(reallyEnable);
+    }
+
+    bool Environment::isHardwareCounters() {
+        return HardwareCounters::getInstance().isEnabled();
+    }
+
+    void Environment::setHardwareCounters(bool reallyEnable) {
+        HardwareCounters::getInstance().setEnabled(reallyEnable);
+    }
+
     bool Environment::isCPU() {
 #ifdef __CUDABLAS__
         return false;
@@ -381,4 +451,12 @@ namespace sd {
     uint64_t Environment::maxSpecialMemory() {
         return _maxTotalSpecialMemory.load();
     }
+
+    Nd4jLong Environment::convolutionBufferLimit() {
+        return _convolutionBufferLimit.load();
+    }
+
+    void Environment::setConvolutionBufferLimit(Nd4jLong numBytes) {
+        _convolutionBufferLimit.store(numBytes);
+    }
 }
@@ -26,6 +26,7 @@
 #include <helpers/ConstantTadHelper.h>
 #include <execution/Threads.h>
 #include <helpers/ShapeUtils.h>
+#include <helpers/FiniteGuard.h>
 
 using namespace simdOps;
 
@@ -95,6 +96,10 @@ namespace broadcast {
                 auto y = reinterpret_cast<const Y *>(vy);
                 auto z = reinterpret_cast<Z *>(vz);
 
+                // every tad is scanned right after it was written
+                const bool armed = sd::FiniteGuard::isArmed();
+                bool nonFinite = false;
+
                 //decompose in to several sub tads after
                 //moving all dimensions (in sorted order)
                 //to the back.
@@ -142,6 +147,9 @@ namespace broadcast {
                         PRAGMA_OMP_SIMD
                         for (unsigned int f = 0; f < tadLength; f++)
                             oZ[f] = OpType::op(oX[f], y[f]);
+
+                        if (armed)
+                            nonFinite |= sd::FiniteGuard::scan<Z>(oZ, tadLength, 1);
                     }
                 }
                 else if(kindOfLoop == sd::LoopKind::EWSNONZERO){
@@ -152,6 +160,9 @@ namespace broadcast {
                         PRAGMA_OMP_SIMD
                         for (unsigned int f = 0; f < tadLength; f++)
                             oZ[f * zEws] = OpType::op(oX[f * xEws], y[f * yEws]);
+
+                        if (armed)
+                            nonFinite |= sd::FiniteGuard::scan<Z>(oZ, tadLength, zEws);
                     }
                 } else if(kindOfLoop == sd::LoopKind::BROADCAST_SCALAR_X){
                     // this loop effectively turns broadcast into series of scalar ops
@@ -166,6 +177,9 @@ namespace broadcast {
                         PRAGMA_OMP_SIMD
                         for (Nd4jLong f = 0; f < loopLength; f++)
                             oZ[f] = OpType::op(oX, oY[f]);
+
+                        if (armed)
+                            nonFinite |= sd::FiniteGuard::scan<Z>(oZ, loopLength, 1);
                     }
                 } else if(kindOfLoop == sd::LoopKind::BROADCAST_SCALAR_Y){
                     // this loop effectively turns broadcast into series of scalar ops
@@ -180,6 +194,9 @@ namespace broadcast {
                         PRAGMA_OMP_SIMD
                         for (Nd4jLong f = 0; f < loopLength; f++)
                             oZ[f] = OpType::op(oX[f], oY);
+
+                        if (armed)
+                            nonFinite |= sd::FiniteGuard::scan<Z>(oZ, loopLength, 1);
                     }
                 }
                 else if (kindOfLoop == sd::LoopKind::BROADCAST_3D) {
@@ -208,6 +225,9 @@ namespace broadcast {
                                 }
                             }
 
+                        if (armed)
+                            for (uint64_t index1 = 0; index1 < nSize1; index1++)
+                                nonFinite |= sd::FiniteGuard::scan<Z>(z + zStrides[0] * index0 + zStrides[1] * index1, nSize2, zStrides[2]);
                     }
 
                 }
@@ -240,6 +260,10 @@ namespace broadcast {
                                     *rZ = OpType::op(*rX, *rY);
                                 }
                             }
+
+                        if (armed)
+                            for (uint64_t index2 = 0; index2 < nSize2; index2++)
+                                nonFinite |= sd::FiniteGuard::scan<Z>(z + zStrides[0] * index0 + zStrides[1] * index1 + zStrides[2] * index2, nSize3, zStrides[3]);
                     }
 
                 }
@@ -276,6 +300,11 @@ namespace broadcast {
                                     }
                                 }
                             }
+
+                        if (armed)
+                            for (uint32_t index2 = 0; index2 < nSize2; index2++)
+                                for (uint32_t index3 = 0; index3 < nSize3; index3++)
+                                    nonFinite |= sd::FiniteGuard::scan<Z>(z + zStrides[0] * index0 + zStrides[1] * index1 + zStrides[2] * index2 + zStrides[3] * index3, nSize4, zStrides[4]);
                     }
 
                 }
@@ -292,6 +321,9 @@ namespace broadcast {
                             auto offset = shape::indexOffset(f, xTadShapeShapeInfo, tadShapeShapeInfoCast, canCastX);
                             oZ[offset] = OpType::op(oX[offset], y[offset]);
                         }
+
+                        if (armed)
+                            nonFinite |= sd::FiniteGuard::scan<Z>(oZ, zTadShapeInfo);
                     }
                 }
                 else if(shape::haveSameShapeAndStrides(xTadShapeShapeInfo, yShapeInfo)) {
@@ -311,6 +343,9 @@ namespace broadcast {
                             auto zOffset = shape::indexOffset(f, zTadShapeInfo, tadShapeInfoZCast, canCastZ);
                             oZ[zOffset] = OpType::op(oX[offset], y[offset]);
                         }
+
+                        if (armed)
+                            nonFinite |= sd::FiniteGuard::scan<Z>(oZ, zTadShapeInfo);
                     }
                 }
                 else if(shape::haveSameShapeAndStrides(xTadShapeShapeInfo, zTadShapeInfo)) {
@@ -329,6 +364,9 @@ namespace broadcast {
                             auto yOffset = shape::indexOffset(f, yShapeInfo, yShapeInfoCast, canCastY);
                             oZ[offset] = OpType::op(oX[offset], y[yOffset]);
                         }
+
+                        if (armed)
+                            nonFinite |= sd::FiniteGuard::scan<Z>(oZ, zTadShapeInfo);
                     }
                 }
                 else if(shape::haveSameShapeAndStrides(yShapeInfo, zTadShapeInfo)) {
@@ -347,6 +385,9 @@ namespace broadcast {
                             auto offset = shape::indexOffset(f, yShapeInfo, yShapeInfoCast, canCastY);
                             oZ[offset] = OpType::op(oX[xOffset], y[offset]);
                         }
+
+                        if (armed)
+                            nonFinite |= sd::FiniteGuard::scan<Z>(oZ, zTadShapeInfo);
                     }
                 }
                 else {
@@ -368,8 +409,14 @@ namespace broadcast {
                             auto zOffset = shape::indexOffset(f, zTadShapeInfo, tadShapeInfoZCast, canCastZ);
                             oZ[zOffset] = OpType::op(oX[xOffset], y[yOffset]);
                         }
+
+                        if (armed)
+                            nonFinite |= sd::FiniteGuard::scan<Z>(oZ, zTadShapeInfo);
                     }
                 }
+
+                if (nonFinite)
+                    sd::FiniteGuard::report();
         }
 
 
@@ -388,6 +435,10 @@ namespace broadcast {
             auto y = reinterpret_cast<const Y *>(vy);
             auto z = reinterpret_cast<Z *>(vz);
 
+            // every tad is scanned right after it was written
+            const bool armed = sd::FiniteGuard::isArmed();
+            bool nonFinite = false;
+
             //decompose in to several sub tads after
             //moving all dimensions (in sorted order)
             //to the back.
@@ -432,6 +483,9 @@ namespace broadcast {
                     PRAGMA_OMP_SIMD
                     for (unsigned int f = 0; f < tadLength; f++)
                         oZ[f] = OpType::op(x[f], oY[f]);
+
+                    if (armed)
+                        nonFinite |= sd::FiniteGuard::scan<Z>(oZ, tadLength, 1);
                 }
             }
             else if(kindOfLoop == sd::LoopKind::EWSNONZERO) {
@@ -442,6 +496,9 @@ namespace broadcast {
                     PRAGMA_OMP_SIMD
                     for (unsigned int f = 0; f < tadLength; f++)
                         oZ[f * zEws] = OpType::op(x[f * xEws], oY[f * yEws]);
+
+                    if (armed)
+                        nonFinite |= sd::FiniteGuard::scan<Z>(oZ, tadLength, zEws);
                 };
             }
             else if(shape::haveSameShapeAndStrides(yTadShapeShapeInfo, xShapeInfo) && shape::haveSameShapeAndStrides(yTadShapeShapeInfo, zTadShapeInfo)) {
@@ -457,6 +514,9 @@ namespace broadcast {
                         auto offset = shape::indexOffset(f, yTadShapeShapeInfo, tadShapeShapeInfoCast, canCastY);
                         oZ[offset] = OpType::op(x[offset], oY[offset]);
                     }
+
+                    if (armed)
+                        nonFinite |= sd::FiniteGuard::scan<Z>(oZ, zTadShapeInfo);
                 };
             }
             else if(shape::haveSameShapeAndStrides(yTadShapeShapeInfo, xShapeInfo)) {
@@ -475,6 +535,9 @@ namespace broadcast {
                         auto zOffset = shape::indexOffset(f, zTadShapeInfo, tadShapeInfoZCast, canCastZ);
                         oZ[zOffset] = OpType::op(x[offset], oY[offset]);
                     }
+
+                    if (armed)
+                        nonFinite |= sd::FiniteGuard::scan<Z>(oZ, zTadShapeInfo);
                 };
             }
             else if(shape::haveSameShapeAndStrides(yTadShapeShapeInfo, zTadShapeInfo)) {
@@ -493,6 +556,9 @@ namespace broadcast {
                         auto xOffset = shape::indexOffset(f, yShapeInfo, xShapeInfoCast, canCastX);
                         oZ[offset] = OpType::op(x[xOffset], oY[offset]);
                     }
+
+                    if (armed)
+                        nonFinite |= sd::FiniteGuard::scan<Z>(oZ, zTadShapeInfo);
                 };
             }
             else if(shape::haveSameShapeAndStrides(xShapeInfo, zTadShapeInfo)) {
@@ -511,6 +577,9 @@ namespace broadcast {
                         auto offset = shape::indexOffset(f, xShapeInfo, xShapeInfoCast, canCastX);
                         oZ[offset] = OpType::op(x[offset], oY[yOffset]);
                     }
+
+                    if (armed)
+                        nonFinite |= sd::FiniteGuard::scan<Z>(oZ, zTadShapeInfo);
                 };
             }
             else {
@@ -532,8 +601,14 @@ namespace broadcast {
                         auto zOffset = shape::indexOffset(f, zTadShapeInfo, tadShapeInfoZCast, canCastZ);
                         oZ[zOffset] = OpType::op(x[xOffset], oY[yOffset]);
                     }
+
+                    if (armed)
+                        nonFinite |= sd::FiniteGuard::scan<Z>(oZ, zTadShapeInfo);
                 };
             }
+
+            if (nonFinite)
+                sd::FiniteGuard::report();
         }
 
 
@@ -553,6 +628,8 @@ static void execRank1(const X *x, const Nd4jLong *xShapeInfo, const Y *y, const
     Nd4jLong yStrd0 = shape::strideAt(yShapeInfo, 0);
     Nd4jLong zStrd0 = shape::strideAt(zShapeInfo, 0);
 
+    const bool armed = sd::FiniteGuard::isArmed();
+
     auto func = PRAGMA_THREADS_FOR{
 
         if(zStrd0 == 1 && xStrd0 == 1 && yStrd0 == 0) {
@@ -571,6 +648,9 @@ static void execRank1(const X *x, const Nd4jLong *xShapeInfo, const Y *y, const
             for (auto i0 = start; i0 < stop; ++i0)
                 z[i0 * zStrd0] = OpType::op(x[i0 * xStrd0], y[i0 * yStrd0]);
         }
+
+        if (armed && sd::FiniteGuard::scan<Z>(z + start * zStrd0, stop - start, zStrd0))
+            sd::FiniteGuard::report();
     };
     samediff::Threads::parallel_tad(func, 0, zAxis0);
 }
@@ -589,8 +669,12 @@ static void execRank2(const X *x, const Nd4jLong *xShapeInfo, const Y *y, const
     Nd4jLong yStrd1 = shape::strideAt(yShapeInfo, shape::order(zShapeInfo) == 'c' ? 1 : 0);
     Nd4jLong zStrd1 = shape::strideAt(zShapeInfo, shape::order(zShapeInfo) == 'c' ? 1 : 0);
 
+    const bool armed = sd::FiniteGuard::isArmed();
+
     auto func = PRAGMA_THREADS_FOR{
 
+        bool nonFinite = false;
+
         for (auto i0 = start; i0 < stop; ++i0) {
 
             auto x0 = x + i0 * xStrd0;
@@ -609,7 +693,13 @@ static void execRank2(const X *x, const Nd4jLong *xShapeInfo, const Y *y, const
             else
                 for (uint i1 = 0; i1 < zAxis1; ++i1)
                     z0[i1 * zStrd1] = OpType::op(x0[i1 * xStrd1], y0[i1 * yStrd1]);
+
+            if (armed)
+                nonFinite |= sd::FiniteGuard::scan<Z>(z0, zAxis1, zStrd1);
         }
+
+        if (nonFinite)
+            sd::FiniteGuard::report();
     };
 
     samediff::Threads::parallel_tad(func, 0, zAxis0);
@@ -634,8 +724,12 @@ static void execRank3(const X *x, const Nd4jLong *xShapeInfo, const Y *y, const
     Nd4jLong yStrd2 = shape::strideAt(yShapeInfo, shape::order(zShapeInfo) == 'c' ? 2 : 0);
     Nd4jLong zStrd2 = shape::strideAt(zShapeInfo, shape::order(zShapeInfo) == 'c' ? 2 : 0);
 
+    const bool armed = sd::FiniteGuard::isArmed();
+
       auto func = PRAGMA_THREADS_FOR_2D {
 
+        bool nonFinite = false;
+
         for (auto i0 = start_x; i0 < stop_x; ++i0) {
             for (auto i1 = start_y; i1 < stop_y; ++i1) {
 
@@ -655,8 +749,14 @@ static void execRank3(const X *x, const Nd4jLong *xShapeInfo, const Y *y, const
                 else
                     for (uint i2 = 0; i2 < zAxis2; ++i2)
                         z1[i2 * zStrd2] = OpType::op(x1[i2 * xStrd2], y1[i2 * yStrd2]);
+
+                if (armed)
+                    nonFinite |= sd::FiniteGuard::scan<Z>(z1, zAxis2, zStrd2);
             }
         }
+
+        if (nonFinite)
+            sd::FiniteGuard::report();
     };
 
     samediff::Threads::parallel_for(func, 0,zAxis0,1,  0,zAxis1,1);
@@ -686,8 +786,12 @@ static void execRank4(const X *x, const Nd4jLong *xShapeInfo, const Y *y, const
     Nd4jLong yStrd3 = shape::strideAt(yShapeInfo, shape::order(zShapeInfo) == 'c' ? 3 : 0);
     Nd4jLong zStrd3 = shape::strideAt(zShapeInfo, shape::order(zShapeInfo) == 'c' ? 3 : 0);
 
+    const bool armed = sd::FiniteGuard::isArmed();
+
      auto func = PRAGMA_THREADS_FOR_3D {
 
+        bool nonFinite = false;
+
         for (auto i0 = start_x; i0 < stop_x; ++i0) {
             for (auto i1 = start_y; i1 < stop_y; ++i1) {
                 for (auto i2 = start_z; i2 < stop_z; ++i2) {
@@ -708,9 +812,15 @@ static void execRank4(const X *x, const Nd4jLong *xShapeInfo, const Y *y, const
                     else
                         for (uint i3 = 0; i3 < zAxis3; ++i3)
                             z2[i3 * zStrd3] = OpType::op(x2[i3 * xStrd3], y2[i3 * yStrd3]);
+
+                    if (armed)
+                        nonFinite |= sd::FiniteGuard::scan<Z>(z2, zAxis3, zStrd3);
                 }
             }
         }
+
+        if (nonFinite)
+            sd::FiniteGuard::report();
     };
 
     samediff::Threads::parallel_for(func,  0,zAxis0,1,  0,zAxis1,1,  0,zAxis2,1);
@@ -745,8 +855,12 @@ static void execRank5(const X *x, const Nd4jLong *xShapeInfo, const Y *y, const
     Nd4jLong yStrd4 = shape::strideAt(yShapeInfo, shape::order(zShapeInfo) == 'c' ? 4 : 0);
     Nd4jLong zStrd4 = shape::strideAt(zShapeInfo, shape::order(zShapeInfo) == 'c' ? 4 : 0);
 
+    const bool armed = sd::FiniteGuard::isArmed();
+
     auto func = PRAGMA_THREADS_FOR_3D {
 
+        bool nonFinite = false;
+
         for (auto i0 = start_x; i0 < stop_x; ++i0) {
             for (auto i1 = start_y; i1 < stop_y; ++i1) {
                 for (auto i2 = start_z; i2 < stop_z; ++i2) {
@@ -768,10 +882,16 @@ static void execRank5(const X *x, const Nd4jLong *xShapeInfo, const Y *y, const
                         else
                             for (uint i4 = 0; i4 < zAxis4; ++i4)
                                 z3[i4 * zStrd4] = OpType::op(x3[i4 * xStrd4], y3[i4 * yStrd4]);
+
+                        if (armed)
+                            nonFinite |= sd::FiniteGuard::scan<Z>(z3, zAxis4, zStrd4);
                     }
                 }
             }
         }
+
+        if (nonFinite)
+            sd::FiniteGuard::report();
     };
 
     samediff::Threads::parallel_for(func,  0,zAxis0,1,  0,zAxis1,1,  0,zAxis2,1);
@@ -784,17 +904,33 @@ static void execDefault(const X *x, const Nd4jLong *xShapeInfo, const Y *y, cons
     const bool xzSameOffsets = shape::haveSameShapeAndStrides(xShapeInfo, zShapeInfo);
     const bool yzSameOffsets = shape::haveSameShapeAndStrides(yShapeInfo, zShapeInfo);
 
+    // when guard is armed, output is written in blocks and each one is checked right after it was written
+    const bool armed = sd::FiniteGuard::isArmed();
+
     auto func = PRAGMA_THREADS_FOR{
 
         int coords[MAX_RANK];
         Nd4jLong xOffset, yOffset, zOffset;
 
-        for (auto i = start; i < stop; ++i) {
+        const auto step = armed ? sd::FiniteGuard::blockSize : stop - start;
+        bool nonFinite = false;
 
-            shape::getOffsetBroadcast(start, i, zShapeInfo, xShapeInfo, yShapeInfo, xzSameOffsets, yzSameOffsets, coords, zOffset, xOffset, yOffset);
+        for (auto b = start; b < stop; b += step) {
+            const auto e = sd::math::nd4j_min<Nd4jLong>(b + step, stop);
 
-            z[zOffset] = OpType::op(x[xOffset], y[yOffset]);
+            for (auto i = b; i < e; ++i) {
+
+                shape::getOffsetBroadcast(start, i, zShapeInfo, xShapeInfo, yShapeInfo, xzSameOffsets, yzSameOffsets, coords, zOffset, xOffset, yOffset);
+
+                z[zOffset] = OpType::op(x[xOffset], y[yOffset]);
+            }
+
+            if (armed)
+                nonFinite |= sd::FiniteGuard::scan<Z>(z, zShapeInfo, b, e);
         }
+
+        if (nonFinite)
+            sd::FiniteGuard::report();
     };
 
     samediff::Threads::parallel_for(func, 0, shape::length(zShapeInfo));
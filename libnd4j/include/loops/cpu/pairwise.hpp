@@ -27,6 +27,7 @@
 #include <system/op_boilerplate.h>
 #include <helpers/OmpLaunchHelper.h>
 #include <execution/Threads.h>
+#include <helpers/FiniteGuard.h>
 
 using namespace simdOps;
 
@@ -98,24 +99,13 @@ namespace functions {
         };
 
 
-        template <typename X, typename Y, typename Z>
-        template <typename OpType>
-        void PairWiseTransform<X, Y, Z>::exec(const void *vx, const Nd4jLong* xShapeInfo,
-                                              const void *vy, const Nd4jLong* yShapeInfo,
-                                              void *vz, const Nd4jLong* zShapeInfo,
-                                              void *vextraParams,
-                                              const uint64_t start, const uint64_t stop) {
-
-            auto x = reinterpret_cast<const X *>(vx);
-            auto y = reinterpret_cast<const Y *>(vy);
-            auto z = reinterpret_cast<Z *>(vz);
-            auto extraParams = reinterpret_cast<Z *>(vextraParams);
-
-            auto n = shape::length(xShapeInfo);
-            auto xEws = shape::elementWiseStride(xShapeInfo);
-            auto yEws = shape::elementWiseStride(yShapeInfo);
-            auto zEws = shape::elementWiseStride(zShapeInfo);
-
+        // loops which compute offsets per element
+        template <typename X, typename Y, typename Z, typename OpType>
+        static void execShaped(const X *x, const Nd4jLong* xShapeInfo,
+                               const Y *y, const Nd4jLong* yShapeInfo,
+                               Z *z, const Nd4jLong* zShapeInfo,
+                               Z *extraParams,
+                               const uint64_t start, const uint64_t stop) {
 
             if (shape::isScalar(yShapeInfo)) {
 
@@ -144,84 +134,119 @@ namespace functions {
             }
 
 
+            if(shape::haveSameShapeAndStrides(xShapeInfo, yShapeInfo) && shape::haveSameShapeAndStrides(xShapeInfo, zShapeInfo)) {
+                uint xShapeInfoCast[MAX_RANK];
+                bool canCastX = sd::DataTypeUtils::castShapeInfo(xShapeInfo, xShapeInfoCast);
 
-            const sd::LoopKind::Kind kindOfLoop = sd::LoopKind::deduceKindOfLoopXYZ(xShapeInfo, yShapeInfo, zShapeInfo);
-            const bool sameShapesXY = shape::shapeEquals(xShapeInfo, yShapeInfo);
+                PRAGMA_OMP_SIMD
+                for (auto i = start; i < stop; i++)  {
+                    auto offset = shape::indexOffset(i, xShapeInfo, xShapeInfoCast, canCastX);
+                    z[offset] = OpType::op(x[offset], y[offset], extraParams);
+                }
+            }
+            else if(shape::haveSameShapeAndStrides(xShapeInfo, yShapeInfo)) {
+                uint xShapeInfoCast[MAX_RANK];
+                uint zShapeInfoCast[MAX_RANK];
+                bool canCastX = sd::DataTypeUtils::castShapeInfo(xShapeInfo, xShapeInfoCast);
+                bool canCastZ = sd::DataTypeUtils::castShapeInfo(zShapeInfo, zShapeInfoCast);
 
-            if ((kindOfLoop == sd::LoopKind::EWS1 || kindOfLoop == sd::LoopKind::EWSNONZERO) && sameShapesXY) {
-                exec<OpType>(x, xEws, y, yEws, z, zEws, extraParams, n, start, stop);
+                PRAGMA_OMP_SIMD
+                for (auto i = start; i < stop; i++)  {
+                    auto offset  = shape::indexOffset(i, xShapeInfo, xShapeInfoCast, canCastX);
+                    auto zOffset = shape::indexOffset(i, zShapeInfo, zShapeInfoCast, canCastZ);
+                    z[zOffset] = OpType::op(x[offset], y[offset], extraParams);
+                };
+            }
+            else if(shape::haveSameShapeAndStrides(xShapeInfo, zShapeInfo)) {
+                uint xShapeInfoCast[MAX_RANK];
+                uint yShapeInfoCast[MAX_RANK];
+                bool canCastX = sd::DataTypeUtils::castShapeInfo(xShapeInfo, xShapeInfoCast);
+                bool canCastY = sd::DataTypeUtils::castShapeInfo(yShapeInfo, yShapeInfoCast);
+
+                PRAGMA_OMP_SIMD
+                for (auto i = start; i < stop; i++)  {
+                    auto offset  = shape::indexOffset(i, xShapeInfo, xShapeInfoCast, canCastX);
+                    auto yOffset = shape::indexOffset(i, yShapeInfo, yShapeInfoCast, canCastY);
+                    z[offset] = OpType::op(x[offset], y[yOffset], extraParams);
+                };
             }
-            else if ((kindOfLoop == sd::LoopKind::EWS1 || kindOfLoop == sd::LoopKind::EWSNONZERO) && !sameShapesXY) { //not same shape
-                exec<OpType>(x, xEws, y, yEws, z, zEws, extraParams, shape::length(yShapeInfo), start, stop);
+            else if(shape::haveSameShapeAndStrides(yShapeInfo, zShapeInfo)) {
+                uint xShapeInfoCast[MAX_RANK];
+                uint yShapeInfoCast[MAX_RANK];
+                bool canCastX = sd::DataTypeUtils::castShapeInfo(xShapeInfo, xShapeInfoCast);
+                bool canCastY = sd::DataTypeUtils::castShapeInfo(yShapeInfo, yShapeInfoCast);
+
+                PRAGMA_OMP_SIMD
+                for (auto i = start; i < stop; i++)  {
+                    auto xOffset = shape::indexOffset(i, xShapeInfo, xShapeInfoCast, canCastX);
+                    auto offset  = shape::indexOffset(i, yShapeInfo, yShapeInfoCast, canCastY);
+                    z[offset] = OpType::op(x[xOffset], y[offset], extraParams);
+                };
             }
             else {
+                uint xShapeInfoCast[MAX_RANK];
+                uint yShapeInfoCast[MAX_RANK];
+                uint zShapeInfoCast[MAX_RANK];
+                bool canCastX = sd::DataTypeUtils::castShapeInfo(xShapeInfo, xShapeInfoCast);
+                bool canCastY = sd::DataTypeUtils::castShapeInfo(yShapeInfo, yShapeInfoCast);
+                bool canCastZ = sd::DataTypeUtils::castShapeInfo(zShapeInfo, zShapeInfoCast);
 
-                if(shape::haveSameShapeAndStrides(xShapeInfo, yShapeInfo) && shape::haveSameShapeAndStrides(xShapeInfo, zShapeInfo)) {
-                    uint xShapeInfoCast[MAX_RANK];
-                    bool canCastX = sd::DataTypeUtils::castShapeInfo(xShapeInfo, xShapeInfoCast);
+                PRAGMA_OMP_SIMD
+                for (auto i = start; i < stop; i++)  {
+                    auto xOffset = shape::indexOffset(i, xShapeInfo, xShapeInfoCast, canCastX);
+                    auto yOffset = shape::indexOffset(i, yShapeInfo, yShapeInfoCast, canCastY);
+                    auto zOffset = shape::indexOffset(i, zShapeInfo, zShapeInfoCast, canCastZ);
+                    z[zOffset] = OpType::op(x[xOffset], y[yOffset], extraParams);
+                };
+            }
+        }
 
-                    PRAGMA_OMP_SIMD
-                    for (auto i = start; i < stop; i++)  {
-                        auto offset = shape::indexOffset(i, xShapeInfo, xShapeInfoCast, canCastX);
-                        z[offset] = OpType::op(x[offset], y[offset], extraParams);
-                    }
-                }
-                else if(shape::haveSameShapeAndStrides(xShapeInfo, yShapeInfo)) {
-                    uint xShapeInfoCast[MAX_RANK];
-                    uint zShapeInfoCast[MAX_RANK];
-                    bool canCastX = sd::DataTypeUtils::castShapeInfo(xShapeInfo, xShapeInfoCast);
-                    bool canCastZ = sd::DataTypeUtils::castShapeInfo(zShapeInfo, zShapeInfoCast);
+        template <typename X, typename Y, typename Z>
+        template <typename OpType>
+        void PairWiseTransform<X, Y, Z>::exec(const void *vx, const Nd4jLong* xShapeInfo,
+                                              const void *vy, const Nd4jLong* yShapeInfo,
+                                              void *vz, const Nd4jLong* zShapeInfo,
+                                              void *vextraParams,
+                                              const uint64_t start, const uint64_t stop) {
 
-                    PRAGMA_OMP_SIMD
-                    for (auto i = start; i < stop; i++)  {
-                        auto offset  = shape::indexOffset(i, xShapeInfo, xShapeInfoCast, canCastX);
-                        auto zOffset = shape::indexOffset(i, zShapeInfo, zShapeInfoCast, canCastZ);
-                        z[zOffset] = OpType::op(x[offset], y[offset], extraParams);
-                    };
-                }
-                else if(shape::haveSameShapeAndStrides(xShapeInfo, zShapeInfo)) {
-                    uint xShapeInfoCast[MAX_RANK];
-                    uint yShapeInfoCast[MAX_RANK];
-                    bool canCastX = sd::DataTypeUtils::castShapeInfo(xShapeInfo, xShapeInfoCast);
-                    bool canCastY = sd::DataTypeUtils::castShapeInfo(yShapeInfo, yShapeInfoCast);
+            auto x = reinterpret_cast<const X *>(vx);
+            auto y = reinterpret_cast<const Y *>(vy);
+            auto z = reinterpret_cast<Z *>(vz);
+            auto extraParams = reinterpret_cast<Z *>(vextraParams);
 
-                    PRAGMA_OMP_SIMD
-                    for (auto i = start; i < stop; i++)  {
-                        auto offset  = shape::indexOffset(i, xShapeInfo, xShapeInfoCast, canCastX);
-                        auto yOffset = shape::indexOffset(i, yShapeInfo, yShapeInfoCast, canCastY);
-                        z[offset] = OpType::op(x[offset], y[yOffset], extraParams);
-                    };
-                }
-                else if(shape::haveSameShapeAndStrides(yShapeInfo, zShapeInfo)) {
-                    uint xShapeInfoCast[MAX_RANK];
-                    uint yShapeInfoCast[MAX_RANK];
-                    bool canCastX = sd::DataTypeUtils::castShapeInfo(xShapeInfo, xShapeInfoCast);
-                    bool canCastY = sd::DataTypeUtils::castShapeInfo(yShapeInfo, yShapeInfoCast);
+            auto xEws = shape::elementWiseStride(xShapeInfo);
+            auto yEws = shape::elementWiseStride(yShapeInfo);
+            auto zEws = shape::elementWiseStride(zShapeInfo);
 
-                    PRAGMA_OMP_SIMD
-                    for (auto i = start; i < stop; i++)  {
-                        auto xOffset = shape::indexOffset(i, xShapeInfo, xShapeInfoCast, canCastX);
-                        auto offset  = shape::indexOffset(i, yShapeInfo, yShapeInfoCast, canCastY);
-                        z[offset] = OpType::op(x[xOffset], y[offset], extraParams);
-                    };
+            const sd::LoopKind::Kind kindOfLoop = sd::LoopKind::deduceKindOfLoopXYZ(xShapeInfo, yShapeInfo, zShapeInfo);
+            const bool ewsLoop = !shape::isScalar(yShapeInfo) && (kindOfLoop == sd::LoopKind::EWS1 || kindOfLoop == sd::LoopKind::EWSNONZERO);
+            const auto n = shape::shapeEquals(xShapeInfo, yShapeInfo) ? shape::length(xShapeInfo) : shape::length(yShapeInfo);
+
+            // when guard is armed, output is written in blocks and each one is checked right after it was written.
+            // otherwise whole range is single block
+            const bool armed = sd::FiniteGuard::isArmed();
+            const uint64_t step = armed ? sd::FiniteGuard::blockSize : stop - start;
+            bool nonFinite = false;
+
+            for (auto b = start; b < stop; b += step) {
+                const auto e = sd::math::nd4j_min<uint64_t>(b + step, stop);
+
+                if (ewsLoop) {
+                    exec<OpType>(x, xEws, y, yEws, z, zEws, extraParams, n, b, e);
+
+                    if (armed)
+                        nonFinite |= sd::FiniteGuard::scan<Z>(z + b * zEws, e - b, zEws);
                 }
                 else {
-                    uint xShapeInfoCast[MAX_RANK];
-                    uint yShapeInfoCast[MAX_RANK];
-                    uint zShapeInfoCast[MAX_RANK];
-                    bool canCastX = sd::DataTypeUtils::castShapeInfo(xShapeInfo, xShapeInfoCast);
-                    bool canCastY = sd::DataTypeUtils::castShapeInfo(yShapeInfo, yShapeInfoCast);
-                    bool canCastZ = sd::DataTypeUtils::castShapeInfo(zShapeInfo, zShapeInfoCast);
+                    execShaped<X, Y, Z, OpType>(x, xShapeInfo, y, yShapeInfo, z, zShapeInfo, extraParams, b, e);
 
-                    PRAGMA_OMP_SIMD
-                    for (auto i = start; i < stop; i++)  {
-                        auto xOffset = shape::indexOffset(i, xShapeInfo, xShapeInfoCast, canCastX);
-                        auto yOffset = shape::indexOffset(i, yShapeInfo, yShapeInfoCast, canCastY);
-                        auto zOffset = shape::indexOffset(i, zShapeInfo, zShapeInfoCast, canCastZ);
-                        z[zOffset] = OpType::op(x[xOffset], y[yOffset], extraParams);
-                    };
+                    if (armed)
+                        nonFinite |= sd::FiniteGuard::scan<Z>(z, zShapeInfo, b, e);
                 }
             }
+
+            if (nonFinite)
+                sd::FiniteGuard::report();
         }
     }
 }
@@ -27,6 +27,7 @@
 #include <helpers/Loops.h>
 #include <helpers/ConstantTadHelper.h>
 #include <helpers/ShapeBuilders.h>
+#include <helpers/FiniteGuard.h>
 
 using namespace simdOps;
 
@@ -66,7 +67,7 @@ namespace reduce    {
             }
 
             if (xEws > 0) {
-                z[0] = execScalar<OpType>(x, xEws, length, extraParams);
+                sd::FiniteGuard::putScalar(z[0], execScalar<OpType>(x, xEws, length, extraParams));
             }
             else {
                 auto startingValue = OpType::startingValue(x);
@@ -91,7 +92,7 @@ namespace reduce    {
                     intermediate[0] = OpType::update(intermediate[0], intermediate[e], extraParams);
 
                 // write out results
-                z[0] = OpType::postProcess(intermediate[0], length, extraParams);
+                sd::FiniteGuard::putScalar(z[0], OpType::postProcess(intermediate[0], length, extraParams));
             }
         }
 
@@ -142,7 +143,7 @@ namespace reduce    {
                                                     void *vresult, const Nd4jLong *resultShapeInfo) {
                 // FIXME: wtf???
                 auto z = reinterpret_cast<Z*>(vresult);
-                z[0] = execScalar<OpType>(x, xShapeInfo, extraParams);
+                sd::FiniteGuard::putScalar(z[0], execScalar<OpType>(x, xShapeInfo, extraParams));
         }
 
         template <typename X, typename Z>
@@ -202,7 +203,7 @@ void _CUDA_H ReduceFloatFunction<X, Z>::exec(sd::memory::Workspace* workspace, c
     }
 
     if (shape::length(zShapeInfo) == 1) {
-        z[0] = execScalar<OpType>(x, xShapeInfo, extraParams);
+        sd::FiniteGuard::putScalar(z[0], execScalar<OpType>(x, xShapeInfo, extraParams));
         return;
     }
 
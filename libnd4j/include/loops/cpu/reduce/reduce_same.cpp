@@ -27,6 +27,7 @@
 #include <chrono>
 #include <helpers/Loops.h>
 #include <helpers/ConstantTadHelper.h>
+#include <helpers/FiniteGuard.h>
 
 using namespace simdOps;
 
@@ -61,7 +62,7 @@ namespace functions {
             }
 
             if (xEws >= 1) {
-                z[0] = execScalar<OpType>(x, xEws, length, extraParams);
+                sd::FiniteGuard::putScalar(z[0], execScalar<OpType>(x, xEws, length, extraParams));
             }
             else {
                 auto startingValue = OpType::startingValue(x);
@@ -86,7 +87,7 @@ namespace functions {
                     intermediate[0] = OpType::update(intermediate[0], intermediate[e], extraParams);
 
                 // write out results
-                z[0] = OpType::postProcess(intermediate[0], length, extraParams);
+                sd::FiniteGuard::putScalar(z[0], OpType::postProcess(intermediate[0], length, extraParams));
             }
         }
 
@@ -136,7 +137,7 @@ namespace functions {
                                                  void *extraParams,
                                                  void *vz, const Nd4jLong *zShapeInfo) {
                 auto z = reinterpret_cast<X*>(vz);
-                z[0] = execScalar<OpType>(x, xShapeInfo, extraParams);
+                sd::FiniteGuard::putScalar(z[0], execScalar<OpType>(x, xShapeInfo, extraParams));
         }
 
         template <typename X>
@@ -195,7 +196,7 @@ void _CUDA_H ReduceSameFunction<X>::exec(sd::memory::Workspace* workspace, const
     }
 
     if (shape::length(zShapeInfo) == 1) {
-        z[0] = execScalar<OpType>(x, xShapeInfo, extraParams);
+        sd::FiniteGuard::putScalar(z[0], execScalar<OpType>(x, xShapeInfo, extraParams));
         return;
     }
 
@@ -23,6 +23,7 @@
 #include <types/types.h>
 #include <loops/transform_float.h>
 #include <loops/legacy_ops.h>
+#include <helpers/MixedPrecision.h>
 
 using namespace simdOps;
 
@@ -52,5 +53,28 @@ namespace functions {
         }
 
         BUILD_DOUBLE_TEMPLATE(template class ND4J_EXPORT TransformFloat, , LIBND4J_TYPES, FLOAT_TYPES);
+
+        // defined after class instantiation above, so only HALF/BFLOAT16 outputs get these
+        template <typename X, typename Y>
+        void TransformFloat<X, Y>::execFp32(int opNum,
+                                            const void *x, const Nd4jLong *xShapeInfo,
+                                            void *z, const Nd4jLong *zShapeInfo,
+                                            uint64_t threadId, uint64_t numThreads) {
+                    DISPATCH_BY_OPNUM_TT(execFp32, PARAMS(x, xShapeInfo, z, zShapeInfo, threadId, numThreads), TRANSFORM_FLOAT_OPS);
+        }
+
+        template <typename X, typename Z>
+        template<typename OpType>
+        void _CUDA_H TransformFloat<X, Z>::execFp32(const void *vx, const Nd4jLong *xShapeInfo,
+                                                    void *vz, const Nd4jLong *zShapeInfo,
+                                                    uint64_t threadId, uint64_t numThreads) {
+
+            auto x = reinterpret_cast<const X *>(vx);
+            auto z = reinterpret_cast<Z *>(vz);
+
+            sd::TransformLoops<X,Z,Z>::template loopTransform<sd::AccumulatedTransform<OpType>>(x, xShapeInfo, z, zShapeInfo, nullptr, threadId, numThreads);
+        }
+
+        BUILD_DOUBLE_TEMPLATE(template void TransformFloat, ::execFp32(int opNum, const void *x, const Nd4jLong *xShapeInfo, void *z, const Nd4jLong *zShapeInfo, uint64_t threadId, uint64_t numThreads), LIBND4J_TYPES, HALF_TYPES);
     }
 }
\ No newline at end of file
@@ -23,6 +23,7 @@
 #include <types/types.h>
 #include <loops/transform_strict.h>
 #include <loops/legacy_ops.h>
+#include <helpers/MixedPrecision.h>
 
 using namespace simdOps;
 
@@ -54,5 +55,28 @@ namespace functions {
         }
 
         BUILD_SINGLE_TEMPLATE(template class ND4J_EXPORT TransformStrict, , FLOAT_TYPES);
+
+        // defined after class instantiation above, so only HALF/BFLOAT16 get these
+        template <typename X>
+        void TransformStrict<X>::execFp32(int opNum,
+                                          const void *x, const Nd4jLong *xShapeInfo,
+                                          void *z, const Nd4jLong *zShapeInfo,
+                                          uint64_t threadId, uint64_t numThreads) {
+                    DISPATCH_BY_OPNUM_T(execFp32, PARAMS(x, xShapeInfo, z, zShapeInfo, threadId, numThreads), TRANSFORM_STRICT_OPS);
+        }
+
+        template <typename X>
+        template<typename OpType>
+        void _CUDA_H TransformStrict<X>::execFp32(const void *vx, const Nd4jLong *xShapeInfo,
+                                                  void *vz, const Nd4jLong *zShapeInfo,
+                                                  uint64_t threadId, uint64_t numThreads) {
+
+            auto x = reinterpret_cast<const X *>(vx);
+            auto z = reinterpret_cast<X *>(vz);
+
+            sd::TransformLoops<X,X,X>::template loopTransform<sd::AccumulatedTransform<OpType>>(x, xShapeInfo, z, zShapeInfo, nullptr, threadId, numThreads);
+        }
+
+        BUILD_SINGLE_TEMPLATE(template void TransformStrict, ::execFp32(int opNum, const void *x, const Nd4jLong *xShapeInfo, void *z, const Nd4jLong *zShapeInfo, uint64_t threadId, uint64_t numThreads), HALF_TYPES);
     }
 }
\ No newline at end of file
@@ -96,6 +96,20 @@ namespace functions {
 			                             void *extraParams,
 			                             uint64_t threadId, uint64_t numThreads);
 
+			/**
+			 * Same as exec() without extraParams, but op is evaluated in FLOAT32 and rounded once per element.
+			 * Instantiated for HALF and BFLOAT16 outputs only
+			 */
+			static void execFp32(int opNum,
+			        const void *dx, const Nd4jLong *xShapeInfo,
+			        void *result, const Nd4jLong *resultShapeInfo,
+			        uint64_t threadId, uint64_t numThreads);
+
+			template<typename OpType>
+			static ND4J_EXPORT void execFp32(const void *dx, const Nd4jLong *xShapeInfo,
+			                                 void *result, const Nd4jLong *resultShapeInfo,
+			                                 uint64_t threadId, uint64_t numThreads);
+
 #endif
         };
     }
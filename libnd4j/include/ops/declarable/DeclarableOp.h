@@ -113,6 +113,18 @@ namespace sd {
             */
             int prepareOutputs(Context& block);
 
+            /**
+             * This method checks if inputs of the given block can be overwritten by its outputs:
+             * shapes and data types must match, and inputs can't share buffers with external variables (placeholders, constants)
+             * @return number of bytes saved by in-place execution, or -1 if it's not possible
+             */
+            Nd4jLong inplaceSavings(Context& block);
+
+            /**
+             * This method collects input and output arrays of the given block, used for profiling purposes
+             */
+            void collectArrays(Context& block, int numOutputs, std::vector<NDArray*>& inputs, std::vector<NDArray*>& outputs);
+
             virtual samediff::EmptyHandling emptyHandling();
         public:
             // for special cases, like BooleanOps
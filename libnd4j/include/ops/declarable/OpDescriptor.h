@@ -90,6 +90,9 @@ namespace sd {
             // field for ops that allow data type override at runtime
             bool _dtypeOverride = false;
 
+            // field for ops that can return strided views of their inputs instead of copies
+            bool _outputViews = false;
+
             bool checkDataTypesMatch(sd::DataType needle, std::vector<sd::DataType> &haystack) const;
         public:
             // default constructor
@@ -149,6 +152,13 @@ namespace sd {
             // this method allows you to enable/disable inplace call for a given op
             void allowInplace(bool reallyAllow);
 
+            /**
+             * returns TRUE if this op can return its outputs as views of its inputs.
+             * Such op, once executed with Context::isOutputViews() set, must push every non-empty output into VariableSpace by itself:
+             * only empty outputs are preallocated in this mode
+             */
+            bool allowsOutputViews();
+
             // this method returns opNum (applicable for legacy XYZ ops only)
             int getOpNum();
 
@@ -172,6 +182,7 @@ namespace sd {
             OpDescriptor* setAllowedOutputTypes(sd::DataType dtype);
             OpDescriptor* allowOverride(bool reallyAllow);
             OpDescriptor* setSameMode(bool reallySame);
+            OpDescriptor* allowOutputViews(bool reallyAllow);
             OpDescriptor* setInputType(int idx, sd::DataType dtype);
             OpDescriptor* setOutputType(int idx, sd::DataType dtype);
 
@@ -24,6 +24,7 @@
 #include <helpers/ShapeUtils.h>
 #include <ops/declarable/CustomOperations.h>
 #include <ops/declarable/helpers/where.h>
+#include <execution/Threads.h>
 
 namespace sd {
     namespace ops {
@@ -95,9 +96,15 @@ namespace sd {
                 // output shape is the 2D tensor num_true x rankOf (inShape)
                 auto condition = INPUT_VARIABLE(0);
                 auto inShape = inputShape->at(0);
-                Nd4jLong numOfTrue = 0; //condition->reduceNumber(reduce::CountNonZero, nullptr).e<Nd4jLong>(0);
-                for (Nd4jLong i = 0; i < condition->lengthOf(); i++)
-                    if (condition->e<bool>(i)) numOfTrue++;
+                auto func = PRAGMA_REDUCE_LONG {
+                    int64_t cnt = 0;
+                    for (auto i = start; i < stop; i++)
+                        if (condition->e<bool>(i))
+                            cnt++;
+
+                    return cnt;
+                };
+                Nd4jLong numOfTrue = samediff::Threads::parallel_long(func, LAMBDA_AL { return _old + _new; }, 0, condition->lengthOf());
 
                 Nd4jLong const* theNewShape;
                 if (numOfTrue > 0) {
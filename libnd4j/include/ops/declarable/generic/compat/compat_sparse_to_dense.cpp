@@ -37,7 +37,11 @@ namespace sd {
             if (block.width() > 3)
                 def = INPUT_VARIABLE(3);
 
-            sd::ops::helpers::compat_sparse_to_dense(*values, *indices, def, *output);
+            // optional IArg: duplicates policy, 0 - last value wins (default), 1 - sum
+            const int duplicates = block.numI() > 0 ? INT_ARG(0) : 0;
+            REQUIRE_TRUE(duplicates == 0 || duplicates == 1, 0, "compat_sparse_to_dense: duplicates policy must be 0 (last) or 1 (sum), but got %i instead", duplicates);
+
+            sd::ops::helpers::compat_sparse_to_dense(*values, *indices, def, *output, duplicates);
 
             return Status::OK();
         };
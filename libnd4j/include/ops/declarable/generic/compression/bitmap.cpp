@@ -59,12 +59,15 @@ namespace sd {
 
             float threshold = T_ARG(0);
 
+            // optionally, very sparse bitmap is sent as list of positions
+            bool rle = block.numB() > 0 ? B_ARG(0) : false;
+
             encoded->p(0, (int) input->lengthOf());
             encoded->p(1, (int) input->lengthOf());
             encoded->p(2, reinterpret_cast<int *>(&threshold)[0]);
             encoded->p(3, 1); // flag for BITMAP_ENCODING
 
-            auto result = helpers::encodeBitmap(block.launchContext(), input, encoded, threshold);
+            auto result = helpers::encodeBitmap(block.launchContext(), input, encoded, threshold, rle);
             counter->p(0, result);
             counter->syncToDevice();
 
@@ -0,0 +1,67 @@
+/*******************************************************************************
+ * Copyright (c) 2020 Konduit K.K.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+#include <system/op_boilerplate.h>
+#if NOT_EXCLUDED(OP_beam_search_backtrace)
+
+#include <ops/declarable/CustomOperations.h>
+#include <ops/declarable/helpers/beam_search.h>
+
+namespace sd {
+namespace ops  {
+
+    CUSTOM_OP_IMPL(beam_search_backtrace, 2, 1, false, 0, 0) {
+        auto tokens  = INPUT_VARIABLE(0);       // [time, bS, beamWidth]
+        auto parents = INPUT_VARIABLE(1);       // [time, bS, beamWidth]
+
+        auto sequences = OUTPUT_VARIABLE(0);    // [bS, beamWidth, time]
+
+        REQUIRE_TRUE(tokens->rankOf() == 3 && tokens->isSameShape(parents), 0, "BEAM_SEARCH_BACKTRACE op: tokens and parents must have the same shape [time, bS, beamWidth], but got %s and %s !",
+                     ShapeUtils::shapeAsString(tokens).c_str(), ShapeUtils::shapeAsString(parents).c_str());
+
+        if (tokens->isEmpty())
+            return Status::OK();
+
+        const int beam = tokens->sizeAt(2);
+        const int minParent = parents->reduceNumber(reduce::Min).e<int>(0);
+        const int maxParent = parents->reduceNumber(reduce::Max).e<int>(0);
+        REQUIRE_TRUE(minParent >= 0 && maxParent < beam, 0, "BEAM_SEARCH_BACKTRACE op: parents must be in range [0, %i), but got values in [%i, %i] !", beam, minParent, maxParent);
+
+        helpers::beamSearchBacktrace(block.launchContext(), *tokens, *parents, *sequences);
+
+        return Status::OK();
+    }
+
+    DECLARE_TYPES(beam_search_backtrace) {
+        getOpDescriptor()
+                ->setAllowedInputTypes(0, sd::DataType::INT32)
+                ->setAllowedInputTypes(1, sd::DataType::INT32)
+                ->setAllowedOutputTypes(0, sd::DataType::INT32);
+    }
+
+    DECLARE_SHAPE_FN(beam_search_backtrace) {
+        auto tokensShape = inputShape->at(0);
+
+        auto outputShape = ConstantShapeHelper::getInstance().createShapeInfo(sd::DataType::INT32, 'c', {shape::sizeAt(tokensShape, 1), shape::sizeAt(tokensShape, 2), shape::sizeAt(tokensShape, 0)});
+
+        return SHAPELIST(outputShape);
+    }
+
+}
+}
+
+#endif
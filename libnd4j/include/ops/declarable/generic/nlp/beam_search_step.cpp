@@ -0,0 +1,91 @@
+/*******************************************************************************
+ * Copyright (c) 2020 Konduit K.K.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+#include <system/op_boilerplate.h>
+#if NOT_EXCLUDED(OP_beam_search_step)
+
+#include <ops/declarable/CustomOperations.h>
+#include <ops/declarable/helpers/beam_search.h>
+
+namespace sd {
+namespace ops  {
+
+    CUSTOM_OP_IMPL(beam_search_step, 4, 5, false, 0, 1) {
+        auto logits   = INPUT_VARIABLE(0);      // [bS, beamWidth, vocab]
+        auto scores   = INPUT_VARIABLE(1);      // [bS, beamWidth]
+        auto finished = INPUT_VARIABLE(2);      // [bS, beamWidth]
+        auto lengths  = INPUT_VARIABLE(3);      // [bS, beamWidth]
+
+        auto newScores   = OUTPUT_VARIABLE(0);  // [bS, beamWidth]
+        auto tokens      = OUTPUT_VARIABLE(1);  // [bS, beamWidth]
+        auto parents     = OUTPUT_VARIABLE(2);  // [bS, beamWidth]
+        auto newFinished = OUTPUT_VARIABLE(3);  // [bS, beamWidth]
+        auto newLengths  = OUTPUT_VARIABLE(4);  // [bS, beamWidth]
+
+        const int eosId = INT_ARG(0);
+        const double alpha = block.numT() > 0 ? T_ARG(0) : 0.;
+
+        REQUIRE_TRUE(logits->rankOf() == 3, 0, "BEAM_SEARCH_STEP op: logits must have rank 3 [bS, beamWidth, vocab], but got %s !", ShapeUtils::shapeAsString(logits).c_str());
+
+        const std::vector<Nd4jLong> beamShape = {logits->sizeAt(0), logits->sizeAt(1)};
+        REQUIRE_TRUE(scores->isSameShape(beamShape) && finished->isSameShape(beamShape) && lengths->isSameShape(beamShape), 0,
+                     "BEAM_SEARCH_STEP op: scores, finished and lengths must have shape %s, but got %s, %s and %s !", ShapeUtils::shapeAsString(beamShape).c_str(),
+                     ShapeUtils::shapeAsString(scores).c_str(), ShapeUtils::shapeAsString(finished).c_str(), ShapeUtils::shapeAsString(lengths).c_str());
+
+        REQUIRE_TRUE(scores->dataType() == logits->dataType(), 0, "BEAM_SEARCH_STEP op: scores must have the same data type as logits, but got %s and %s !",
+                     DataTypeUtils::asString(scores->dataType()).c_str(), DataTypeUtils::asString(logits->dataType()).c_str());
+
+        REQUIRE_TRUE(eosId >= 0 && eosId < logits->sizeAt(2), 0, "BEAM_SEARCH_STEP op: end of sequence token id must be in range [0, %i), but got %i !", (int) logits->sizeAt(2), eosId);
+        REQUIRE_TRUE(alpha >= 0., 0, "BEAM_SEARCH_STEP op: length penalty alpha must be non-negative, but got %f !", alpha);
+
+        if (logits->isEmpty())
+            return Status::OK();
+
+        helpers::beamSearchStep(block.launchContext(), *logits, *scores, *finished, *lengths, *newScores, *tokens, *parents, *newFinished, *newLengths, eosId, alpha);
+
+        return Status::OK();
+    }
+
+    DECLARE_TYPES(beam_search_step) {
+        getOpDescriptor()
+                ->setAllowedInputTypes(0, {ALL_FLOATS})
+                ->setAllowedInputTypes(1, {ALL_FLOATS})
+                ->setAllowedInputTypes(2, sd::DataType::BOOL)
+                ->setAllowedInputTypes(3, sd::DataType::INT32)
+                ->setAllowedOutputTypes(0, {ALL_FLOATS})
+                ->setAllowedOutputTypes(1, sd::DataType::INT32)
+                ->setAllowedOutputTypes(2, sd::DataType::INT32)
+                ->setAllowedOutputTypes(3, sd::DataType::BOOL)
+                ->setAllowedOutputTypes(4, sd::DataType::INT32);
+    }
+
+    DECLARE_SHAPE_FN(beam_search_step) {
+        auto logitsShape = inputShape->at(0);
+
+        const std::vector<Nd4jLong> beamShape = {shape::sizeAt(logitsShape, 0), shape::sizeAt(logitsShape, 1)};
+
+        auto scoresShape   = ConstantShapeHelper::getInstance().createShapeInfo(ArrayOptions::dataType(logitsShape), 'c', beamShape);
+        auto indicesShape  = ConstantShapeHelper::getInstance().createShapeInfo(sd::DataType::INT32, 'c', beamShape);
+        auto finishedShape = ConstantShapeHelper::getInstance().createShapeInfo(sd::DataType::BOOL, 'c', beamShape);
+
+        return SHAPELIST(scoresShape, indicesShape, indicesShape, finishedShape, indicesShape);
+    }
+
+}
+}
+
+#endif
@@ -69,35 +69,43 @@ CUSTOM_OP_IMPL(conv3dnew, 2, 1, false, 0, 13) {
 
     nd4j_debug("MKL-DNN is not used for conv3dnew!\n", 0);
 
-    std::vector<int> permutForOutput;
-
-    if (isNCDHW)
-        permutForOutput = {0,2,3,4,1};                                        // [bS, oC, oD, oH, oW] -> [bS, oD, oH, oW, oC]
-    else
-        input = new NDArray(input->permute({0,4,1,2,3}));
-
-    std::vector<int> wAxes;
-    if(0 == wFormat)
-        wAxes = {3,0,1,2};
-    else if(1 == wFormat)
-        wAxes = {1,2,3,4};
-    else
-        wAxes = {4,1,2,3};
-
-    NDArray columns(input->ordering(), {bS, iC, kD, kH, kW, oD, oH, oW}, input->dataType(), block.launchContext());
-    ConvolutionUtils::vol2col(block, *input, columns, sD, sH, sW, pD, pH, pW, dD, dH, dW);                 // [bS, iC, iD, iH, iW] is convoluted to [bS, iC, kD, kH, kW, oD, oH, oW]
-    // [bS, iC, kD, kH, kW, oD, oH, oW] x [kD, kH, kW, iC, oC] = [bS, oD, oH, oW, oC]
-    // [bS, iC, kD, kH, kW, oD, oH, oW] x [oC, iC, kD, kH, kW] = [bS, oD, oH, oW, oC]
-    // [bS, iC, kD, kH, kW, oD, oH, oW] x [oC, kD, kH, kW, iC] = [bS, oD, oH, oW, oC]
-    MmulHelper::tensorDot(&columns, weights, output, {1,2,3,4}, wAxes, permutForOutput);
+    if(ConvolutionUtils::conv3dDirectApplicable(input, weights, output, kD, kH, kW, isNCDHW)) {
+        ConvolutionUtils::conv3dDirect(block, input, weights, output, kD, kH, kW, sD, sH, sW, pD, pH, pW, dD, dH, dW, wFormat);
+    }
+    else if(!ConvolutionUtils::conv3dColumnsFit(bS, iC, kD, kH, kW, oD, oH, oW, input->dataType())) {
+        ConvolutionUtils::conv3dChunked(block, input, weights, output, kD, kH, kW, sD, sH, sW, pD, pH, pW, dD, dH, dW, isNCDHW, wFormat);
+    }
+    else {
+        std::vector<int> permutForOutput;
+
+        if (isNCDHW)
+            permutForOutput = {0,2,3,4,1};                                        // [bS, oC, oD, oH, oW] -> [bS, oD, oH, oW, oC]
+        else
+            input = new NDArray(input->permute({0,4,1,2,3}));
+
+        std::vector<int> wAxes;
+        if(0 == wFormat)
+            wAxes = {3,0,1,2};
+        else if(1 == wFormat)
+            wAxes = {1,2,3,4};
+        else
+            wAxes = {4,1,2,3};
+
+        NDArray columns(input->ordering(), {bS, iC, kD, kH, kW, oD, oH, oW}, input->dataType(), block.launchContext());
+        ConvolutionUtils::vol2col(block, *input, columns, sD, sH, sW, pD, pH, pW, dD, dH, dW);                 // [bS, iC, iD, iH, iW] is convoluted to [bS, iC, kD, kH, kW, oD, oH, oW]
+        // [bS, iC, kD, kH, kW, oD, oH, oW] x [kD, kH, kW, iC, oC] = [bS, oD, oH, oW, oC]
+        // [bS, iC, kD, kH, kW, oD, oH, oW] x [oC, iC, kD, kH, kW] = [bS, oD, oH, oW, oC]
+        // [bS, iC, kD, kH, kW, oD, oH, oW] x [oC, kD, kH, kW, iC] = [bS, oD, oH, oW, oC]
+        MmulHelper::tensorDot(&columns, weights, output, {1,2,3,4}, wAxes, permutForOutput);
+
+        if(!isNCDHW)
+            delete input;
+    }
 
     if(bias)
         // output->applyBroadcast(broadcast::Add, {indIOioC}, bias);
         helpers::addBias(block, *output, *bias, *output, isNCDHW);
 
-     if(!isNCDHW)
-        delete input;
-
     return Status::OK();
 }
 
@@ -235,14 +243,29 @@ CUSTOM_OP_IMPL(conv3dnew_bp, 3, 2, false, 0, 13) {
 
     std::vector<int> gradOaxesForDot;
 
-    if(!isNCDHW) {
+    if(!isNCDHW)
         gradOaxesForDot  = {0,1,2,3};                                           // bS, oD, oH, oW
+    else
+        gradOaxesForDot  = {0,2,3,4};                                           // bS, oD, oH, oW
+
+    //----- calculation of gradB -----//
+    if(gradB) {
+        if(gradB->rankOf() == 2)
+            gradB = new NDArray(gradB->reshape(gradB->ordering(), {(int)gradB->lengthOf()}, false));
+        gradO->reduceAlongDimension(reduce::Sum, *gradB, gradOaxesForDot);                          // sum over bS oD oH oW
+        if(gradB != OUTPUT_VARIABLE(2))
+            delete gradB;
+    }
+
+    if(!ConvolutionUtils::conv3dColumnsFit(bS, iC, kD, kH, kW, oD, oH, oW, input->dataType())) {
+        ConvolutionUtils::conv3dBPChunked(block, input, weights, gradO, gradI, gradW, kD, kH, kW, sD, sH, sW, pD, pH, pW, dD, dH, dW, isNCDHW, wFormat);
+        return Status::OK();
+    }
+
+    if(!isNCDHW) {
         input = new NDArray(input->permute({0,4,1,2,3}));                       // [bS, iD, iH, iW, iC] -> [bS, iC, iD, iH, iW]
         gradI = new NDArray(gradI->permute({0,4,1,2,3}));                       // [bS, iD, iH, iW, iC] -> [bS, iC, iD, iH, iW]
     }
-    else {
-        gradOaxesForDot  = {0,2,3,4};                                           // bS, oD, oH, oW
-    }
 
     std::vector<int> wPermut, colPermut;
 
@@ -259,20 +282,11 @@ CUSTOM_OP_IMPL(conv3dnew_bp, 3, 2, false, 0, 13) {
         colPermut = {2,3,4,1,0,5,6,7};
     }
 
-    // ----- calculation of gradW and gradB ----- //
+    // ----- calculation of gradW ----- //
     NDArray columns(input->ordering(), {bS, iC, kD, kH, kW, oD, oH, oW}, input->dataType(), block.launchContext());
     ConvolutionUtils::vol2col(block, *input, columns, sD, sH, sW, pD, pH, pW, dD, dH, dW);                   // [bS, iC, iD, iH, iW] is convoluted to [bS, iC, kD, kH, kW, oD, oH, oW]
     MmulHelper::tensorDot(&columns, gradO, gradW, {0,5,6,7}, gradOaxesForDot, wPermut);     // [bS, iC, kD, kH, kW, oD, oH, oW] x [bS, oD, oH, oW, oC]/[bS, oC, oD, oH, oW] = [iC, kD, kH, kW, oC]
 
-    //----- calculation of gradO -----//
-    if(gradB) {
-        if(gradB->rankOf() == 2)
-            gradB = new NDArray(gradB->reshape(gradB->ordering(), {(int)gradB->lengthOf()}, false));
-        gradO->reduceAlongDimension(reduce::Sum, *gradB, gradOaxesForDot);                          // sum over bS oD oH oW
-        if(gradB != OUTPUT_VARIABLE(2))
-            delete gradB;
-    }
-
     //----- calculation of gradI -----//
     // [kD, kH, kW, iC, oC] x [bS, oD, oH, oW, oC]/[bS, oC, oD, oH, oW] = [kD, kH, kW, iC, bS, oD, oH, oW]
     // [oC, iC, kD, kH, kW] x [bS, oD, oH, oW, oC]/[bS, oC, oD, oH, oW] = [kD, kH, kW, iC, bS, oD, oH, oW]
@@ -54,6 +54,8 @@ CUSTOM_OP_IMPL(deconv2d, 2, 1, false, 0, 9) {
     int isSameMode = INT_ARG(8);                                                // 0-VALID, 1-SAME
     int isNCHW     = block.getIArguments()->size() > 9 ? !INT_ARG(9) : 1;       // INT_ARG(9): 0-NCHW,  1-NHWC
     int wFormat = block.getIArguments()->size() > 10 ? INT_ARG(10) : 0;         // 0 - [kH, kW, oC, iC], 1 - [iC, oC, kH, kW], 2 - [iC, kH, kW, oC]
+    auto activation = GemmEpilogue::fromInt(block.getIArguments()->size() > 11 ? INT_ARG(11) : 0);  // INT_ARG(11): fused activation, see GemmEpilogue::Activation
+    double cutoff = block.numT() > 0 ? T_ARG(0) : 0.;                           // RELU cutoff
 
     int bS, iC, iH, iW, oC, oH, oW;                             // batch size, input channels, input height/width, output channels, output height/width;
     int indIOioC, indIiH, indWoC, indWiC, indWkH, indOoH;       // corresponding indexes
@@ -64,6 +66,15 @@ CUSTOM_OP_IMPL(deconv2d, 2, 1, false, 0, 9) {
     if (bias)
         REQUIRE_TRUE(bias->rankOf() <= 2 && oC == bias->lengthOf(), 0, "CUSTOM DECONV2D OP: wrong shape of array with biases, expected rank, length: <=2, %i, but got %i, %i instead !", oC, bias->rankOf(), bias->lengthOf());
 
+    if(isSameMode)          // Note: we're intentionally swapping iH and oH, to calculated the padding for a"normal" conv (not deconv) forward pass
+        ConvolutionUtils::calcPadding2D(pH, pW, iH, iW, oH, oW, kH, kW, sH, sW, dH, dW);
+
+    // every output pixel is gathered from input pixels it depends on, bias is added on the fly
+    if(input->dataType() == weights->dataType() && input->dataType() == output->dataType()) {
+        ConvolutionUtils::deconv2d(block, input, weights, bias, output, kH, kW, sH, sW, pH, pW, dH, dW, isNCHW, wFormat, activation, cutoff);
+        return Status::OK();
+    }
+
     if(!isNCHW)
         output = new NDArray(output->permute({0, 3, 1, 2}));       // [bS, oH, oW, oC] -> [bS, oC, oH, oW]
 
@@ -73,9 +84,6 @@ CUSTOM_OP_IMPL(deconv2d, 2, 1, false, 0, 9) {
     else
         colPermut = {2, 3, 1, 0, 4, 5};
 
-    if(isSameMode)          // Note: we're intentionally swapping iH and oH, to calculated the padding for a"normal" conv (not deconv) forward pass
-        ConvolutionUtils::calcPadding2D(pH, pW, iH, iW, oH, oW, kH, kW, sH, sW, dH, dW);
-
     NDArray columns(input->ordering(), {bS, oC, kH, kW, iH, iW}, input->dataType(),  block.launchContext());
 
     //----- calculation of output -----//
@@ -86,10 +94,9 @@ CUSTOM_OP_IMPL(deconv2d, 2, 1, false, 0, 9) {
     LaunchContext* ctx = block.launchContext();
     helpers::col2im(*ctx, columns, *output, sH, sW, pH, pW, oH, oW, dH, dW);     // [bS, oC, kH, kW, iH, iW] is de-convoluted to [bS, oC, oH, oW]
 
-    //----- add biases if required -----//
-    if(bias)
-        // output->applyBroadcast(broadcast::Add, {1}, bias);
-        helpers::addBias(block, *output, *bias, *output, true);
+    //----- add biases and apply fused activation if required -----//
+    if(bias || activation != GemmEpilogue::NONE)
+        ConvolutionUtils::biasActivation(block, *output, bias, true, activation, cutoff);
 
      if(!isNCHW)
         delete output;
@@ -183,6 +190,7 @@ CUSTOM_OP_IMPL(deconv2d_bp, 3, 2, false, 0, 9) {
     REQUIRE_TRUE(input->rankOf()   == 4, 0, "CUSTOM DECONV2D_BP OP: rank of input array must be equal to 4, but got %i instead !", input->rankOf());
     REQUIRE_TRUE(weights->rankOf() == 4, 0, "CUSTOM DECONV2D_BP OP: rank of weights array must be equal to 4 , but got %i instead !", weights->rankOf());
     REQUIRE_TRUE(gradO->rankOf()   == 4, 0, "CUSTOM DECONV2D_BP OP: rank of output gradients (next epsilon) array must be equal to 4, but got %i instead !", gradO->rankOf());
+    REQUIRE_TRUE(block.getIArguments()->size() < 12 || INT_ARG(11) == 0, 0, "CUSTOM DECONV2D_BP OP: fused activation isn't supported in backprop !");
 
 
     int kH = INT_ARG(0) > 0 ? INT_ARG(0) : static_cast<int>(weights->sizeAt(0));// filter(kernel) height
@@ -65,6 +65,18 @@ CUSTOM_OP_IMPL(deconv3d, 2, 1, false, 0, 13) {
     if (bias)
         REQUIRE_TRUE(bias->rankOf() <= 2 && oC == bias->lengthOf(), 0, "CUSTOM DECONV3D OP: wrong shape of array with biases, expected rank, length: <=2, %i, but got %i, %i instead !", oC, bias->rankOf(), bias->lengthOf());
 
+    if(isSameMode)         // Note: we're intentionally swapping iH and oH, to calculated the padding for a"normal" conv (not deconv) forward pass
+        ConvolutionUtils::calcPadding3D(pD, pH, pW, iD, iH, iW, oD, oH, oW, kD, kH, kW, sD, sH, sW, dD, dH, dW);
+
+    if(!ConvolutionUtils::conv3dColumnsFit(bS, oC, kD, kH, kW, iD, iH, iW, input->dataType())) {
+        ConvolutionUtils::deconv3dChunked(block, input, weights, output, kD, kH, kW, sD, sH, sW, pD, pH, pW, dD, dH, dW, isNCDHW, wFormat);
+
+        if(bias)
+            helpers::addBias(block, *output, *bias, *output, isNCDHW);
+
+        return Status::OK();
+    }
+
     if(!isNCDHW)
         output = new NDArray(output->permute({0, 4, 1, 2, 3}));                 // [bS, oD, oH, oW, oC] -> [bS, oC, oD, oH, oW]
 
@@ -74,9 +86,6 @@ CUSTOM_OP_IMPL(deconv3d, 2, 1, false, 0, 13) {
     else
         colPermut = {2,3,4,1,0,5,6,7};
 
-    if(isSameMode)         // Note: we're intentionally swapping iH and oH, to calculated the padding for a"normal" conv (not deconv) forward pass
-        ConvolutionUtils::calcPadding3D(pD, pH, pW, iD, iH, iW, oD, oH, oW, kD, kH, kW, sD, sH, sW, dD, dH, dW);
-
     NDArray columns(input->ordering(), {bS, oC, kD, kH, kW, iD, iH, iW}, input->dataType(),  block.launchContext());
 
     //----- calculation of output -----//
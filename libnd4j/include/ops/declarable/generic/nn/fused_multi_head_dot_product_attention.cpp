@@ -0,0 +1,102 @@
+/*******************************************************************************
+ * Copyright (c) 2020 Konduit K.K.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+#include <system/op_boilerplate.h>
+#if NOT_EXCLUDED(OP_fused_multi_head_dot_product_attention)
+
+#include <ops/declarable/CustomOperations.h>
+#include <ops/declarable/helpers/attention.h>
+
+namespace sd {
+namespace ops  {
+
+    CUSTOM_OP_IMPL(fused_multi_head_dot_product_attention, 7, 1, false, 0, 1) {
+        auto queries = INPUT_VARIABLE(0);       //[batch, nIn, queryCount]
+        auto keys    = INPUT_VARIABLE(1);       //[batch, nIn, timeSteps]
+        auto values  = INPUT_VARIABLE(2);       //[batch, nIn, timeSteps]
+        auto Wq      = INPUT_VARIABLE(3);       //[nHeads, headSize, nIn]
+        auto Wk      = INPUT_VARIABLE(4);       //[nHeads, headSize, nIn]
+        auto Wv      = INPUT_VARIABLE(5);       //[nHeads, headSize, nIn]
+        auto Wo      = INPUT_VARIABLE(6);       //[nHeads * headSize, nOut]
+        auto mask    = block.width() > 7 ? INPUT_VARIABLE(7) : nullptr;
+
+        auto output = OUTPUT_VARIABLE(0);       //[batch, nOut, queryCount]
+
+        const bool normalization = INT_ARG(0);
+
+        REQUIRE_TRUE(queries->rankOf() == 3 && keys->rankOf() == 3 && values->rankOf() == 3, 0,
+                     "fused_multi_head_dot_product_attention: Queries, Keys and Values must be rank 3 arrays. "
+                     "But got queries = %s, keys = %s, values = %s", ShapeUtils::shapeAsString(queries).c_str(),
+                     ShapeUtils::shapeAsString(keys).c_str(), ShapeUtils::shapeAsString(values).c_str());
+
+        REQUIRE_TRUE(queries->sizeAt(0) == keys->sizeAt(0) && keys->sizeAt(0) == values->sizeAt(0) && keys->sizeAt(2) == values->sizeAt(2), 0,
+                     "fused_multi_head_dot_product_attention: Queries, Keys and Values must have the same mini batch size, Keys and Values must have the same timestep length. "
+                     "But got queries = %s, keys = %s, values = %s", ShapeUtils::shapeAsString(queries).c_str(),
+                     ShapeUtils::shapeAsString(keys).c_str(), ShapeUtils::shapeAsString(values).c_str());
+
+        REQUIRE_TRUE(Wq->rankOf() == 3 && Wk->rankOf() == 3 && Wv->rankOf() == 3 && Wo->rankOf() == 2, 0,
+                     "fused_multi_head_dot_product_attention: Input projections weights must have rank 3, output projection weights must have rank 2. "
+                     "But got Wq = %s, Wk = %s, Wv = %s, Wo = %s", ShapeUtils::shapeAsString(Wq).c_str(), ShapeUtils::shapeAsString(Wk).c_str(),
+                     ShapeUtils::shapeAsString(Wv).c_str(), ShapeUtils::shapeAsString(Wo).c_str());
+
+        REQUIRE_TRUE(Wq->sizeAt(0) == Wk->sizeAt(0) && Wk->sizeAt(0) == Wv->sizeAt(0) && Wq->sizeAt(1) == Wk->sizeAt(1), 0,
+                     "fused_multi_head_dot_product_attention: Projections weights must have the same number of attention heads, Wq and Wk must have the same projected size. "
+                     "But got Wq = %s, Wk = %s, Wv = %s", ShapeUtils::shapeAsString(Wq).c_str(),
+                     ShapeUtils::shapeAsString(Wk).c_str(), ShapeUtils::shapeAsString(Wv).c_str());
+
+        REQUIRE_TRUE(Wq->sizeAt(2) == queries->sizeAt(1) && Wk->sizeAt(2) == keys->sizeAt(1) && Wv->sizeAt(2) == values->sizeAt(1), 0,
+                     "fused_multi_head_dot_product_attention: Projection matrices have incompatible size to inputs. "
+                     "Got Wq = %s, Wk = %s, Wv = %s, queries = %s, keys = %s, values = %s", ShapeUtils::shapeAsString(Wq).c_str(),
+                     ShapeUtils::shapeAsString(Wk).c_str(), ShapeUtils::shapeAsString(Wv).c_str(), ShapeUtils::shapeAsString(queries).c_str(),
+                     ShapeUtils::shapeAsString(keys).c_str(), ShapeUtils::shapeAsString(values).c_str());
+
+        REQUIRE_TRUE(Wo->sizeAt(0) == Wv->sizeAt(0) * Wv->sizeAt(1), 0,
+                     "fused_multi_head_dot_product_attention: Output projection matrix Wo has incompatible size to attention result. "
+                     "Expected Wo[0] = Wv[0] * Wv[1] = %i, but got Wo = %s", (int) (Wv->sizeAt(0) * Wv->sizeAt(1)), ShapeUtils::shapeAsString(Wo).c_str());
+
+        REQUIRE_TRUE(mask == nullptr || (mask->rankOf() == 2 && mask->sizeAt(0) == keys->sizeAt(0) && mask->sizeAt(1) == keys->sizeAt(2)), 0,
+                     "fused_multi_head_dot_product_attention: Mask must have shape [batch, timeSteps] = [%i, %i], but got %s", (int) keys->sizeAt(0), (int) keys->sizeAt(2),
+                     mask == nullptr ? "" : ShapeUtils::shapeAsString(mask).c_str());
+
+        // projections run through one gemm, so all arrays are expected to be of output type
+        for (int i = 0; i < 7; ++i)
+            REQUIRE_TRUE(INPUT_VARIABLE(i)->dataType() == output->dataType(), 0, "fused_multi_head_dot_product_attention: all inputs except mask must have the same data type as output, but input %i has %s !", i, DataTypeUtils::asString(INPUT_VARIABLE(i)->dataType()).c_str());
+
+        helpers::multiHeadAttention(block.launchContext(), *queries, *keys, *values, *Wq, *Wk, *Wv, *Wo, mask, *output, normalization);
+
+        return Status::OK();
+    }
+
+    DECLARE_TYPES(fused_multi_head_dot_product_attention) {
+        getOpDescriptor()->setAllowedInputTypes({ALL_FLOATS});
+        getOpDescriptor()->setAllowedOutputTypes({ALL_FLOATS});
+    }
+
+    DECLARE_SHAPE_FN(fused_multi_head_dot_product_attention) {
+        auto queryShape = inputShape->at(0);
+        auto valuesShape = inputShape->at(2);
+        auto WoShape = inputShape->at(6);
+
+        auto outputShape = ConstantShapeHelper::getInstance().createShapeInfo(sd::ArrayOptions::dataType(valuesShape), 'c', {shape::sizeAt(queryShape, 0), shape::sizeAt(WoShape, 1), shape::sizeAt(queryShape, 2)});
+
+        return SHAPELIST(outputShape);
+    }
+
+}
+}
+
+#endif
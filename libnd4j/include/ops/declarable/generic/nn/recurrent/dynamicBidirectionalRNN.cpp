@@ -19,6 +19,8 @@
 //
 
 #include <ops/declarable/CustomOperations.h>
+#include <ops/declarable/helpers/rnn.h>
+#include <execution/Threads.h>
 
 namespace sd {
 namespace ops  {
@@ -92,36 +94,24 @@ CUSTOM_OP_IMPL(dynamic_bidirectional_rnn, 7, 4, false, 0, 0) {
     }
 
 
-    // forward steps
-    sd::ops::dynamic_rnn dynamicRnn;
-    auto resultsFW = dynamicRnn.evaluate({x, WxFW, WhFW, bFW, h0FW, maxTimeStep}, {timeMajor});
-    hFW->assign(resultsFW.at(0));                              // [time x bS x numUnitsFW] or [bS x time x numUnitsFW]
-    hFWFinal->assign(resultsFW.at(1));
-
-    auto seqLen = maxTimeStep;
-    if(seqLen == nullptr) {
-        // FIXME: which datatype should be used here?
-    	seqLen = new NDArray(x->ordering(), {bS}, sd::DataType::INT64, block.launchContext());
-    	seqLen->assign(time);                                        // set each element of seqLen to be equal to time
+    // backward direction walks time in reverse by itself, so neither input nor output is copied through reverse_sequence
+    NDArray *xT = x, *hFWT = hFW, *hBWT = hBW;
+    if(timeMajor == false) {
+        xT   = new NDArray(x->permute({1, 0, 2}));                 // [bS x time x inSize]     -> [time x bS x inSize]
+        hFWT = new NDArray(hFW->permute({1, 0, 2}));               // [bS x time x numUnitsFW] -> [time x bS x numUnitsFW]
+        hBWT = new NDArray(hBW->permute({1, 0, 2}));               // [bS x time x numUnitsBW] -> [time x bS x numUnitsBW]
     }
 
-    // reverse x     
-    sd::ops::reverse_sequence reverse;
-    auto resultsIn = timeMajor ? reverse.evaluate({x, seqLen}, {0, 1}) : reverse.evaluate({x, seqLen}, {1, 0});
-    REQUIRE_TRUE (resultsIn.status() == ND4J_STATUS_OK, 0, "dynamic_bidirectional_rnn: there is a problem with reverse on the sequence.");
-    auto revInput = resultsIn.at(0);
-
-    // backward steps
-    auto resultsBW = dynamicRnn.evaluate({revInput, WxBW, WhBW, bBW, h0BW, maxTimeStep}, {timeMajor});
-    auto hBWtemp = resultsBW.at(0);					           // [time x bS x numUnitsBW] or [ bS x time xnumUnitsBW]
-    hBWFinal->assign(resultsBW.at(1));
+    samediff::Threads::parallel_tasks({
+        [&] { helpers::rnnTimeLoop(block.launchContext(), xT, WxFW, WhFW, bFW, h0FW, maxTimeStep, hFWT, hFWFinal, true); },
+        [&] { helpers::rnnTimeLoop(block.launchContext(), xT, WxBW, WhBW, bBW, h0BW, maxTimeStep, hBWT, hBWFinal, false); }
+    });
 
-    // reverse hBWtemp
-    auto resultsOut = timeMajor ? reverse.evaluate({hBWtemp, seqLen}, {0, 1}) : reverse.evaluate({hBWtemp, seqLen}, {1, 0});
-    hBW->assign(resultsOut.at(0));
-
-    if(seqLen != maxTimeStep)
-    	delete seqLen;
+    if(timeMajor == false) {
+        delete xT;
+        delete hFWT;
+        delete hBWT;
+    }
 
     return Status::OK();
 }
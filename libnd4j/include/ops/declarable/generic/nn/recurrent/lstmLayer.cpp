@@ -23,6 +23,7 @@
 
 #include <ops/declarable/CustomOperations.h>
 #include<ops/declarable/helpers/lstmLayer.h>
+#include <execution/Threads.h>
 
 
 namespace sd {
@@ -286,9 +287,11 @@ CUSTOM_OP_IMPL(lstmLayer, 3, 1, false, 1, 5) {
             }
         }
 
-        // FIXME - following two calls are independent and may run in different streams
-        helpers::lstmLayerTimeLoop(x, &WxFwd, &WrFwd, bFwd, seqLen, hIFwd, cIFwd, WpFwd, params, true,  hFwd, hLFwd, cLFwd);
-        helpers::lstmLayerTimeLoop(x, &WxBwd, &WrBwd, bBwd, seqLen, hIBwd, cIBwd, WpBwd, params, false, hBwd, hLBwd, cLBwd);
+        // directions are independent, so they run concurrently, each one with its own share of threads
+        samediff::Threads::parallel_tasks({
+            [&] { helpers::lstmLayerTimeLoop(x, &WxFwd, &WrFwd, bFwd, seqLen, hIFwd, cIFwd, WpFwd, params, true,  hFwd, hLFwd, cLFwd); },
+            [&] { helpers::lstmLayerTimeLoop(x, &WxBwd, &WrBwd, bBwd, seqLen, hIBwd, cIBwd, WpBwd, params, false, hBwd, hLBwd, cLBwd); }
+        });
 
         if(h && directionMode == 2)
             *h += *hBwd;
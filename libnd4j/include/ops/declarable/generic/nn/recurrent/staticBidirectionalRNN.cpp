@@ -20,8 +20,7 @@
 
 #include <ops/declarable/CustomOperations.h>
 #include<ops/declarable/helpers/rnn.h>
-#include<ops/declarable/helpers/reverse.h>
-#include<ops/declarable/helpers/transforms.h>
+#include <execution/Threads.h>
 
 namespace sd {
 namespace ops  {
@@ -90,42 +89,14 @@ CUSTOM_OP_IMPL(static_bidirectional_rnn, 7, 3, false, 0, 0) {
     if(maxTimeStep)
         REQUIRE_TRUE(maxTimeStep->isSameShape({bS}), 0, "STATIC_BIDIRECTIONAL_RNN custom operation: wrong shape of maxTimeStep array, expected is [%i], but got %s instead !", bS, ShapeUtils::shapeAsString(maxTimeStep).c_str());
 
-    // forward steps
-    auto hFW = new NDArray(x->ordering(), {time, bS, numUnitsFW}, x->dataType(), block.launchContext());
-    helpers::rnnTimeLoop(block.launchContext(), x, WxFW, WhFW, bFW, h0FW, maxTimeStep, hFW, hFWFinal);
-
-    auto seqLen = maxTimeStep;
-    if(seqLen == nullptr) {
-//        seqLen = new NDArray(x->ordering(), {x->sizeAt(1)}, x->dataType(), block.launchContext());	  // [bS]
-    	seqLen = new NDArray(x->ordering(), {x->sizeAt(1)}, sd::DataType::INT64, block.launchContext());	  // [bS]
-        *seqLen = x->sizeAt(0);                                 			                  // set each element of seqLen to be equal to time
-    }
-
-    // reverse x
-    auto revOut = new NDArray(x, false, block.launchContext());
-    helpers::reverseSequence(block.launchContext(), x, seqLen, revOut, 0, 1);
-
-    // backward steps
-    auto hBW = new NDArray(x->ordering(), {time, bS, numUnitsBW}, x->dataType(), block.launchContext());
-
-    helpers::rnnTimeLoop(block.launchContext(), revOut, WxBW, WhBW, bBW, h0BW, maxTimeStep, hBW, hBWFinal);
-
-    // reverse hBW
-    auto hBWcopy = new NDArray(*hBW);
-    helpers::reverseSequence(block.launchContext(), hBWcopy, seqLen, hBW, 0, 1);
-
-    // concatenate hFW and hBW along last third dimension
-    // NDArrayFactory<T>::concat({hFW, hBW}, 2, h);
-    helpers::concat(block.launchContext(), {hFW, hBW}, *h, 2);
-
-    delete hBW;
-    delete hFW;
-    delete hBWcopy;
-    delete revOut;
-
-    if(seqLen != maxTimeStep)
-    	delete seqLen;
+    // both directions write straight into their halves of h, backward one walks time in reverse by itself
+    NDArray hFW = (*h)({0,0, 0,0, 0,numUnitsFW});
+    NDArray hBW = (*h)({0,0, 0,0, numUnitsFW,numUnitsFW+numUnitsBW});
 
+    samediff::Threads::parallel_tasks({
+        [&] { helpers::rnnTimeLoop(block.launchContext(), x, WxFW, WhFW, bFW, h0FW, maxTimeStep, &hFW, hFWFinal, true); },
+        [&] { helpers::rnnTimeLoop(block.launchContext(), x, WxBW, WhBW, bBW, h0BW, maxTimeStep, &hBW, hBWFinal, false); }
+    });
 
     return Status::OK();
 }
@@ -19,6 +19,7 @@
 //
 
 #include <ops/declarable/CustomOperations.h>
+#include <helpers/MmulHelper.h>
 
 namespace sd {
     namespace ops {
@@ -35,13 +36,13 @@ namespace sd {
 
             auto output = OUTPUT_VARIABLE(0);
 
-            sd::ops::xw_plus_b op;
-            auto status = op.execute({x, w, b}, {output});
-            REQUIRE_TRUE(Status::OK() == status, 0, "relu_layer: xw_plus_b op failed on input data.");
-
             auto scalar = block.numT() > 0 ? block.getTArguments()->at(0) : 0.0;
 
-            output->applyScalar(sd::scalar::RELU, scalar, *output);
+            // relu is fused into xw_plus_b, so it's applied in the same pass as bias (values below cutoff are clamped to it),
+            // and platform helpers of xw_plus_b are still picked up
+            sd::ops::xw_plus_b op;
+            auto status = op.execute({x, w, b}, {output}, {scalar}, {0, GemmEpilogue::RELU});
+            REQUIRE_TRUE(Status::OK() == status, 0, "relu_layer: xw_plus_b op failed on input data.");
 
             return Status::OK();
         }
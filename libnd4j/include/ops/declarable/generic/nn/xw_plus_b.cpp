@@ -50,11 +50,12 @@ namespace sd {
             REQUIRE_TRUE(1 == b->rankOf() && b->lengthOf() == z->sizeAt(-1), 0, "xw_plus_b: Input bias vector should be 1D and have proper dimension 1x%i."
                 " But got rank %i, and got length %i instead %i.", z->sizeAt(-1), b->rankOf(), b->lengthOf(), z->sizeAt(-1));
 
-            // multiply x to y
-            MmulHelper::mmul(x, w, z, 1.0, 0.0);
+            // optional fused activation, see GemmEpilogue::Activation, TArg is RELU cutoff
+            const auto activation = GemmEpilogue::fromInt(block.getIArguments()->size() > 1 ? INT_ARG(1) : 0);
+            const double cutoff = block.numT() > 0 ? T_ARG(0) : 0.0;
 
-            // adding b vector
-            z->addiRowVector(*b);
+            // bias and activation are applied in one pass over gemm output
+            MmulHelper::mmulFused(x, w, z, GemmEpilogue(b, activation, cutoff), 1.0, 0.0);
 
             if (bTranspose)
                 delete w;
@@ -96,6 +97,7 @@ namespace sd {
                 return Status::OK();
 
             const bool bTranspose = (block.getIArguments()->size() > 0 ? INT_ARG(0) == 1 : false);
+            REQUIRE_TRUE(block.getIArguments()->size() < 2 || INT_ARG(1) == 0, 0, "xw_plus_b BP: fused activation isn't supported in backprop");
 
             auto w = bTranspose ? new NDArray(INPUT_VARIABLE(1)->transpose()) : INPUT_VARIABLE(1);
 
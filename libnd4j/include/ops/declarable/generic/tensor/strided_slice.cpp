@@ -301,8 +301,12 @@ namespace sd {
 
         CUSTOM_OP_IMPL(strided_slice, 1, 1, false, 0, 5) {
             auto x = INPUT_VARIABLE(0);
-            auto z = OUTPUT_VARIABLE(0);
-            if (z->isEmpty()) {
+
+            // non-empty output isn't preallocated if it's allowed to be a view, see OutputAliasing
+            const bool views = block.isOutputViews() && !x->isS();
+
+            auto z = views ? nullptr : OUTPUT_VARIABLE(0);
+            if (z != nullptr && z->isEmpty()) {
                 return ND4J_STATUS_OK;
             }
 
@@ -406,6 +410,31 @@ namespace sd {
             // FIXME: remove this method once we get 1D vectors supported
             //vectorize(input_shape);
             REQUIRE_TRUE(_preprocess_strided_slice(&indices, &final_shape, input_shape, begin, end, strides, begin_mask, ellipsis_mask, end_mask, new_axis_mask, shrink_axis_mask, &is_identity, &is_simple_slice, &is_dim0), 0, "StridedSlice: shape calculation failed");
+
+            if (views && indices.empty()) {
+                // nothing to make view of: preallocated (or provided) output is handled by copy path below
+                z = OUTPUT_VARIABLE(0);
+                if (z->isEmpty())
+                    return Status::OK();
+            } else if (views) {
+                // empty output was preallocated
+                if (shape::prodLong(final_shape.data(), final_shape.size()) == 0)
+                    return Status::OK();
+
+                bool reversed = false;
+                for (int e = 2; e < indices.size(); e += 3)
+                    if (indices[e] < 0)
+                        reversed = true;
+
+                // scalars and reversed slices are copied
+                if (!reversed && !final_shape.empty()) {
+                    STORE_RESULT(new NDArray((*x)(indices, true, true).reshape('c', final_shape)));
+                    return Status::OK();
+                }
+
+                z = new NDArray(ConstantShapeHelper::getInstance().createShapeInfo(x->dataType(), 'c', final_shape), false, block.launchContext(), false);
+                STORE_RESULT(z);
+            }
 //            if(z->lengthOf() == 1 && !z->isEmpty() && (input_shape.size() == 2 && input_shape[0] == 1)) { //(indices.size() == 6) && (indices[2] - indices[0] == 1)) {
 //                z->assign(x->e<float>(indices[0]));
 //            }
@@ -662,7 +691,8 @@ namespace sd {
         DECLARE_TYPES(strided_slice) {
             getOpDescriptor()
                     ->setAllowedInputTypes(sd::DataType::ANY)
-                    ->setSameMode(true);
+                    ->setSameMode(true)
+                    ->allowOutputViews(true);
         }
 
         DECLARE_TYPES(strided_slice_bp) {
@@ -28,7 +28,6 @@ namespace sd {
     namespace ops {
         CUSTOM_OP_IMPL(slice, 1, 1, false, 0, -2) {
             auto input = INPUT_VARIABLE(0);
-            auto output = OUTPUT_VARIABLE(0);
 
             int x_rank = input->rankOf();
 
@@ -76,10 +75,18 @@ namespace sd {
             }
 
             if(empty){
-                REQUIRE_TRUE(output->isEmpty(), 0, "Slice: empty array indices requested, but output array is not empty");
+                REQUIRE_TRUE(OUTPUT_VARIABLE(0)->isEmpty(), 0, "Slice: empty array indices requested, but output array is not empty");
+                return Status::OK();
+            }
+
+            // output shares buffer with input, see OutputAliasing
+            if (block.isOutputViews() && !input->isS()) {
+                STORE_RESULT(new NDArray((*input)(indices, true)));
                 return Status::OK();
             }
 
+            auto output = OUTPUT_VARIABLE(0);
+
             Nd4jLong* subArrShapeInfo = nullptr;
             ALLOCATE(subArrShapeInfo, block.getWorkspace(), shape::shapeInfoLength(input->rankOf()), Nd4jLong);
 
@@ -112,7 +119,8 @@ namespace sd {
         DECLARE_TYPES(slice) {
             getOpDescriptor()
                     ->setAllowedInputTypes(sd::DataType::ANY)
-                    ->setSameMode(true);
+                    ->setSameMode(true)
+                    ->allowOutputViews(true);
         }
 
         DECLARE_SHAPE_FN(slice) {
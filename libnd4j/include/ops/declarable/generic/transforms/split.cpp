@@ -66,6 +66,21 @@ namespace ops {
 
         REQUIRE_TRUE(input->sizeAt(axis) % num_splits == 0, 0, "Split: num_splits has wrong value, remainder of division should be 0, but it's %i", input->sizeAt(axis) % num_splits);
 
+        // outputs share buffer with input, see OutputAliasing
+        if (block.isOutputViews() && !input->isS()) {
+            const Nd4jLong size = input->sizeAt(axis) / num_splits;
+            std::vector<Nd4jLong> indices(2 * input->rankOf(), 0);
+
+            for (int e = 0; e < num_splits; e++) {
+                indices[2 * axis]     = e * size;
+                indices[2 * axis + 1] = (e + 1) * size;
+
+                this->storeResult(block, e, new NDArray((*input)(indices, true)));
+            }
+
+            return Status::OK();
+        }
+
         std::vector<NDArray*> outArrs(num_splits);
         for (int e = 0; e < num_splits; e++) {
             outArrs[e] = OUTPUT_VARIABLE(e);
@@ -79,7 +94,8 @@ namespace ops {
     DECLARE_TYPES(split) {
         getOpDescriptor()
                 ->setAllowedInputTypes({ALL_INTS, ALL_FLOATS})
-                ->setAllowedOutputTypes({ALL_INTS, ALL_FLOATS});
+                ->setAllowedOutputTypes({ALL_INTS, ALL_FLOATS})
+                ->allowOutputViews(true);
     }
 
     DECLARE_SHAPE_FN(split) {
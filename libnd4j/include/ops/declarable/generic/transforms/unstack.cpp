@@ -43,6 +43,32 @@ CUSTOM_OP_IMPL(unstack, 1, -1, false, 0, 1) {
     if(input->isEmpty())
         return Status::OK();
 
+    // outputs share buffer with input, see OutputAliasing
+    if (block.isOutputViews()) {
+        std::vector<Nd4jLong> subArrShape;
+        for (int i = 0; i < input->rankOf(); ++i)
+            if (i != dim)
+                subArrShape.push_back(input->sizeAt(i));
+
+        std::vector<Nd4jLong> indices(2 * input->rankOf(), 0);
+
+        for (Nd4jLong e = 0; e < input->sizeAt(dim); ++e) {
+            // vector is split into scalars, these are just copied
+            if (subArrShape.empty()) {
+                this->storeResult(block, e, new NDArray(input->e(e)));
+                continue;
+            }
+
+            indices[2 * dim]     = e;
+            indices[2 * dim + 1] = e + 1;
+
+            // removal of unit dimension keeps view a view
+            this->storeResult(block, e, new NDArray((*input)(indices, true).reshape(input->ordering(), subArrShape)));
+        }
+
+        return Status::OK();
+    }
+
     std::vector<NDArray*> outArrs(input->sizeAt(dim));
     for(uint i = 0; i < outArrs.size(); ++i)
         outArrs[i] = OUTPUT_VARIABLE(i);
@@ -119,7 +145,8 @@ DECLARE_SHAPE_FN(unstack) {
 DECLARE_TYPES(unstack) {
     getOpDescriptor()
             ->setAllowedInputTypes({ALL_FLOATS, ALL_INTS})
-            ->setSameMode(true);
+            ->setSameMode(true)
+            ->allowOutputViews(true);
 }
 
 
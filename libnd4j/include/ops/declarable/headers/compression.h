@@ -34,6 +34,10 @@ namespace sd {
          *
          * Output:
          *      0 - 1D uint8_t tensor with shape {N}
+         *
+         * Bool arguments:
+         *      0 - optional, if true very sparse bitmap is converted into list of positions (BITMAP_RLE_ENCODING flag).
+         *          CPU only, and only libnd4j decoders understand this flag
          */
         #if NOT_EXCLUDED(OP_encode_bitmap)
         DECLARE_CUSTOM_OP(encode_bitmap, 1, 3, true, 1, 0);
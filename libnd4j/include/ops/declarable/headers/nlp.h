@@ -32,6 +32,50 @@ namespace sd {
         #if NOT_EXCLUDED(OP_cbow)
         DECLARE_CONFIGURABLE_OP(cbow, 15, 15, true, 0, 0);
         #endif
+
+        /**
+         * One beam search decoding step: log-softmax of logits is added to running beam scores, finished beams
+         * are carried over with end of sequence token only, and best beamWidth candidates out of beamWidth x vocab
+         * are selected per batch item, ranked by score / ((5 + length) / 6)^alpha
+         *
+         * Input arrays:
+         * 0: logits [bS, beamWidth, vocab]
+         * 1: accumulated log probabilities [bS, beamWidth], same type as logits
+         * 2: finished flags [bS, beamWidth], bool
+         * 3: sequence lengths [bS, beamWidth], int32
+         *
+         * Int arguments:
+         * 0: end of sequence token id
+         *
+         * T arguments:
+         * 0: length penalty alpha, optional, 0 by default (no penalty)
+         *
+         * Output arrays, all [bS, beamWidth], best candidate first:
+         * 0: accumulated log probabilities of selected candidates
+         * 1: selected token ids, int32
+         * 2: parent beam indices (backpointers), int32
+         * 3: finished flags, bool
+         * 4: sequence lengths, int32
+         *
+         * at first step only beam 0 should have finite score, so duplicate beams aren't selected
+         */
+        #if NOT_EXCLUDED(OP_beam_search_step)
+        DECLARE_CUSTOM_OP(beam_search_step, 4, 5, false, 0, 1);
+        #endif
+
+        /**
+         * Follows backpointers of stacked beam_search_step outputs from the last step to the first one
+         *
+         * Input arrays:
+         * 0: token ids [time, bS, beamWidth], int32
+         * 1: parent beam indices [time, bS, beamWidth], int32
+         *
+         * Output array:
+         * 0: sequences of final beams [bS, beamWidth, time], int32
+         */
+        #if NOT_EXCLUDED(OP_beam_search_backtrace)
+        DECLARE_CUSTOM_OP(beam_search_backtrace, 2, 1, false, 0, 0);
+        #endif
     }
 }
 
@@ -253,6 +253,25 @@ namespace sd {
                 DECLARE_CUSTOM_OP(multi_head_dot_product_attention, 7, -1, false, 0, 2);
                 DECLARE_CUSTOM_OP(multi_head_dot_product_attention_bp, 8, 7, false, 0, 1);
         #endif
+
+        /**
+         * Inference-only variant of multi_head_dot_product_attention with the same inputs and result.
+         * Inputs which are the same array (e.g. self attention) are projected by one gemm with stacked weights,
+         * heads are read from projection workspace by index, attention runs per (batch, head) tile, and
+         * output projection is written directly into output. Attention weights are not returned.
+         *
+         * Expected arguments:
+         * q, k, v, Wq, Wk, Wv, Wo, mask: same as for multi_head_dot_product_attention, all except mask must be of the same type
+         *
+         * integer input arguments:
+         * 0: normalization, may have two values: zero -> do not apply normalization, one -> apply normalization
+         *
+         * Output Arrays:
+         * 0: Attention result arrays of shape [batchSize, outSize, queryCount]
+         */
+        #if NOT_EXCLUDED(OP_fused_multi_head_dot_product_attention)
+                DECLARE_CUSTOM_OP(fused_multi_head_dot_product_attention, 7, 1, false, 0, 1);
+        #endif
     }
 }
 
@@ -0,0 +1,45 @@
+/*******************************************************************************
+ * Copyright (c) 2020 Konduit K.K.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+#ifndef LIBND4J_HELPERS_ATTENTION_H
+#define LIBND4J_HELPERS_ATTENTION_H
+
+#include <ops/declarable/helpers/helpers.h>
+
+namespace sd {
+namespace ops {
+namespace helpers {
+
+    /**
+     * Inference-only multi-head attention block: output = concat(head_1, ..., head_n) * Wo,
+     * head_i = softmax((Wq_i*q)^T (Wk_i*k) [/ sqrt(projectedKeys)] + mask) applied to Wv_i*v
+     *
+     * Inputs which are the same array share one projection gemm with stacked weights, heads are addressed
+     * in projection workspace by index arithmetic, and output projection writes straight into output
+     *
+     * queries [bS, featureKeys, queryCount], keys [bS, featureKeys, timesteps], values [bS, featureValues, timesteps]
+     * Wq, Wk [numHeads, projectedKeys, featureKeys], Wv [numHeads, projectedValues, featureValues], Wo [numHeads * projectedValues, outSize]
+     * mask [bS, timesteps], may be nullptr
+     * output [bS, outSize, queryCount]
+     */
+    void multiHeadAttention(sd::LaunchContext* context, const NDArray& queries, const NDArray& keys, const NDArray& values, const NDArray& Wq, const NDArray& Wk, const NDArray& Wv, const NDArray& Wo, const NDArray* mask, NDArray& output, const bool normalization);
+
+}
+}
+}
+
+#endif //LIBND4J_HELPERS_ATTENTION_H
@@ -0,0 +1,53 @@
+/*******************************************************************************
+ * Copyright (c) 2020 Konduit K.K.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#ifndef LIBND4J_HELPERS_BEAM_SEARCH_H
+#define LIBND4J_HELPERS_BEAM_SEARCH_H
+
+#include <ops/declarable/helpers/helpers.h>
+
+namespace sd {
+namespace ops {
+namespace helpers {
+
+    /**
+     * One beam search decoding step, batch items are processed independently
+     *
+     * for every live beam candidate score is scores[b, k] + logSoftmax(logits[b, k])[v], finished beam yields
+     * single candidate (eosId, scores[b, k]), so it's carried over unchanged. Best beamWidth candidates out of
+     * beamWidth x vocab are selected by score / ((5 + length) / 6)^alpha, ordered best first
+     *
+     * logits [bS, beamWidth, vocab], scores [bS, beamWidth], finished [bS, beamWidth] bool, lengths [bS, beamWidth] int32
+     * newScores [bS, beamWidth] holds raw accumulated log probabilities of selected candidates
+     * tokens, parents [bS, beamWidth] int32 hold selected token ids and beams they extend
+     * newFinished, newLengths [bS, beamWidth] may be the same arrays as finished and lengths
+     */
+    void beamSearchStep(sd::LaunchContext* context, const NDArray& logits, const NDArray& scores, const NDArray& finished, const NDArray& lengths,
+                        NDArray& newScores, NDArray& tokens, NDArray& parents, NDArray& newFinished, NDArray& newLengths, const int eosId, const double alpha);
+
+    /**
+     * Follows parents backpointers from the last step and writes full token sequence of every final beam
+     *
+     * tokens, parents [time, bS, beamWidth] int32, as stacked outputs of beamSearchStep
+     * sequences [bS, beamWidth, time] int32
+     */
+    void beamSearchBacktrace(sd::LaunchContext* context, const NDArray& tokens, const NDArray& parents, NDArray& sequences);
+
+}
+}
+}
+
+#endif //LIBND4J_HELPERS_BEAM_SEARCH_H
@@ -27,7 +27,25 @@ namespace ops {
 namespace helpers {
 
     void decodeBitmap(sd::LaunchContext* context, const NDArray* input, NDArray* output);
-    Nd4jLong encodeBitmap(sd::LaunchContext* context, NDArray* input, NDArray* output, float threshold);
+    /**
+     * if rle is true, very sparse bitmap is converted into list of positions (BITMAP_RLE_ENCODING). CPU only, CUDA throws if rle is true
+     */
+    Nd4jLong encodeBitmap(sd::LaunchContext* context, NDArray* input, NDArray* output, float threshold, bool rle = false);
+
+    /**
+     * 1-bit masks: bit i of output is set if input[i] > 0 (or input[i] < 0 if negative is true),
+     * output is UINT8 array of (length + 7) / 8 elements. Decoding gives 1 (or -1) for set bits and 0 otherwise.
+     * Both arrays are expected to be contiguous.
+     */
+    void encodeSignMask(sd::LaunchContext* context, const NDArray* input, NDArray* output, bool negative);
+    void decodeSignMask(sd::LaunchContext* context, const NDArray* input, NDArray* output, bool negative);
+
+    /**
+     * Symmetric int8 quantization: each block of blockSize elements gets its own FLOAT32 scale max|x| / 127,
+     * output is INT8 array of the same length as input. Both arrays are expected to be contiguous.
+     */
+    void quantizeBlocks(sd::LaunchContext* context, const NDArray* input, NDArray* output, NDArray* scales, int blockSize);
+    void dequantizeBlocks(sd::LaunchContext* context, const NDArray* input, const NDArray* scales, NDArray* output, int blockSize);
 }
 }
 }
@@ -24,6 +24,7 @@
 #include <array/NDArray.h>
 #include <graph/Context.h>
 #include <system/dll.h>
+#include <helpers/GemmEpilogue.h>
 
 #include <execution/LaunchContext.h>
 
@@ -293,7 +294,8 @@ namespace sd {
                 return std::vector<Nd4jLong>({oC, kD, kH, kW, iC});
             }
 
-            static void conv2d(sd::graph::Context  &context, const NDArray* input, const NDArray* weights, const NDArray* bias, NDArray* output, const int kH, const int kW, const int sH, const int sW, int pH, int pW, const int dH, const int dW, const int paddingMode, const int isNCHW, const int wFormat);
+            // activation (see GemmEpilogue::Activation) is applied to output together with bias, RELU uses cutoff
+            static void conv2d(sd::graph::Context  &context, const NDArray* input, const NDArray* weights, const NDArray* bias, NDArray* output, const int kH, const int kW, const int sH, const int sW, int pH, int pW, const int dH, const int dW, const int paddingMode, const int isNCHW, const int wFormat, const GemmEpilogue::Activation activation = GemmEpilogue::NONE, const double cutoff = 0.0);
 
             // static void conv2d(sd::graph::Context & block, const std::vector<NDArray*>& inArrs, NDArray* output, const std::vector<int>& intArgs);
 
@@ -301,12 +303,18 @@ namespace sd {
 
             static void conv2dBP(sd::graph::Context & block, const NDArray* input, const NDArray* weights, const NDArray* bias, const NDArray* gradO, NDArray* gradI, NDArray* gradW, NDArray* gradB, const int kH, const int kW, const int sH, const int sW, int pH, int pW, const int dH, const int dW, const int paddingMode, const int isNCHW, const int wFormat);
 
-            static void depthwiseConv2d(sd::graph::Context & block, const NDArray* input, const NDArray* weights, const NDArray* bias, NDArray* output, const int kH, const int kW, const int sH, const int sW, int pH, int pW, const int dH, const int dW, const int paddingMode, const int isNCHW, const int wFormat);
+            static void depthwiseConv2d(sd::graph::Context & block, const NDArray* input, const NDArray* weights, const NDArray* bias, NDArray* output, const int kH, const int kW, const int sH, const int sW, int pH, int pW, const int dH, const int dW, const int paddingMode, const int isNCHW, const int wFormat, const GemmEpilogue::Activation activation = GemmEpilogue::NONE, const double cutoff = 0.0);
 
             static void depthwiseConv2dBP(sd::graph::Context & block, const NDArray* input, const NDArray* weights, const NDArray* bias, const NDArray* gradO, NDArray* gradI, NDArray* gradW, NDArray* gradB, const int kH, const int kW, const int sH, const int sW, int pH, int pW, const int dH, const int dW, const int paddingMode, const int isNCHW, const int wFormat);
 
             static void sconv2d(sd::graph::Context & block, const NDArray* input, const NDArray* weightsDepth, const NDArray* weightsPoint, const NDArray* bias,  NDArray* output, const int kH, const int kW, const int sH, const int sW, int pH, int pW, const int dH, const int dW, const int paddingMode, const int isNCHW, const int wFormat);
 
+            // transposed convolution computed per output pixel (gather), padding is expected to be calculated already; input, weights and output must have the same data type
+            static void deconv2d(sd::graph::Context & block, const NDArray* input, const NDArray* weights, const NDArray* bias, NDArray* output, const int kH, const int kW, const int sH, const int sW, const int pH, const int pW, const int dH, const int dW, const int isNCHW, const int wFormat, const GemmEpilogue::Activation activation = GemmEpilogue::NONE, const double cutoff = 0.0);
+
+            // fused output stage of convolutions: adds bias (if any) and applies activation in single pass over output
+            static void biasActivation(sd::graph::Context & block, NDArray& output, const NDArray* bias, const int isNCHW, const GemmEpilogue::Activation activation, const double cutoff);
+
             static void vol2col(sd::graph::Context & block, const NDArray& vol, NDArray& col, const int sD, const int sH, const int sW, const int pD, const int pH, const int pW, const int dD, const int dH, const int dW);
 
             static void col2vol(sd::graph::Context & block, const NDArray& col, NDArray& vol, const int sD, const int sH, const int sW, const int pD, const int pH, const int pW, const int dD, const int dH, const int dW);
@@ -326,6 +334,21 @@ namespace sd {
             static void pooling2dBP(sd::graph::Context & block, const NDArray& input, const NDArray& gradO, NDArray& gradI, const int kH, const int kW, const int sH, const int sW, const int pH, const int pW, const int dH, const int dW, const int poolingMode, const int extraParam0);
 
             static void pooling3dBP(sd::graph::Context & block, const NDArray& input, const NDArray& gradO, NDArray& gradI, const int kD, const int kH, const int kW, const int sD, const int sH, const int sW, const int pD, const int pH, const int pW, const int dD, const int dH, const int dW, const int poolingMode, const int extraParam0);
+
+            // returns false if columns array of conv3d/deconv3d exceeds Environment::convolutionBufferLimit(), chunked versions below should be used then
+            static bool conv3dColumnsFit(const int bS, const int iC, const int kD, const int kH, const int kW, const int oD, const int oH, const int oW, const sd::DataType dataType);
+
+            // these process output (gradient) depth slabs and batch items one by one, reusing single columns buffer of bounded size
+            static void conv3dChunked(sd::graph::Context & block, const NDArray* input, const NDArray* weights, NDArray* output, const int kD, const int kH, const int kW, const int sD, const int sH, const int sW, const int pD, const int pH, const int pW, const int dD, const int dH, const int dW, const int isNCDHW, const int wFormat);
+
+            static void conv3dBPChunked(sd::graph::Context & block, const NDArray* input, const NDArray* weights, const NDArray* gradO, NDArray* gradI, NDArray* gradW, const int kD, const int kH, const int kW, const int sD, const int sH, const int sW, const int pD, const int pH, const int pW, const int dD, const int dH, const int dW, const int isNCDHW, const int wFormat);
+
+            static void deconv3dChunked(sd::graph::Context & block, const NDArray* input, const NDArray* weights, NDArray* output, const int kD, const int kH, const int kW, const int sD, const int sH, const int sW, const int pD, const int pH, const int pW, const int dD, const int dH, const int dW, const int isNCDHW, const int wFormat);
+
+            // direct (columns-free) conv3d for NDHWC layout and small kernels
+            static bool conv3dDirectApplicable(const NDArray* input, const NDArray* weights, const NDArray* output, const int kD, const int kH, const int kW, const int isNCDHW);
+
+            static void conv3dDirect(sd::graph::Context & block, const NDArray* input, const NDArray* weights, NDArray* output, const int kD, const int kH, const int kW, const int sD, const int sH, const int sW, const int pD, const int pH, const int pW, const int dD, const int dH, const int dW, const int wFormat);
     };
 
 }
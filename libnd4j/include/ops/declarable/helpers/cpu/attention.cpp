@@ -0,0 +1,243 @@
+/*******************************************************************************
+ * Copyright (c) 2020 Konduit K.K.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+#include <ops/declarable/helpers/attention.h>
+#include <helpers/MmulHelper.h>
+#include <execution/Threads.h>
+
+namespace sd {
+namespace ops {
+namespace helpers {
+
+//////////////////////////////////////////////////////////////////////////
+static bool sameArray(const NDArray& a, const NDArray& b) {
+    return &a == &b || (a.buffer() == b.buffer() && shape::haveSameShapeAndStrides(a.shapeInfo(), b.shapeInfo()));
+}
+
+//////////////////////////////////////////////////////////////////////////
+// [numHeads, projectedSize, featureSize] weights are stacked into single [sum(numHeads * projectedSize), featureSize] matrix
+static NDArray stackWeights(const std::vector<const NDArray*>& weights) {
+
+    if (weights.size() == 1)
+        return weights[0]->reshape('c', {weights[0]->sizeAt(0) * weights[0]->sizeAt(1), weights[0]->sizeAt(2)});
+
+    Nd4jLong rows = 0;
+    for (auto w : weights)
+        rows += w->sizeAt(0) * w->sizeAt(1);
+
+    NDArray stacked('c', {rows, weights[0]->sizeAt(2)}, weights[0]->dataType(), weights[0]->getContext());
+
+    Nd4jLong row = 0;
+    for (auto w : weights) {
+        const Nd4jLong len = w->sizeAt(0) * w->sizeAt(1);
+        stacked({row, row + len, 0, 0}).assign(w->reshape('c', {len, w->sizeAt(2)}));
+        row += len;
+    }
+
+    return stacked;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// input [bS, featureSize, timesteps] x stacked weights [rows, featureSize] -> projected [bS, rows, timesteps], one gemm per batch entry
+static void project(const NDArray& input, const NDArray& weights, NDArray& projected) {
+
+    for (Nd4jLong b = 0; b < input.sizeAt(0); ++b) {
+        auto x = input(b, {0});
+        auto z = projected(b, {0});
+        MmulHelper::mmul(&weights, &x, &z, 1.0, 0.0);
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////
+template <typename T>
+static void attentionTiles_(const NDArray& q, const Nd4jLong qOffset, const NDArray& k, const Nd4jLong kOffset, const NDArray& v, const Nd4jLong vOffset,
+                            const NDArray* mask, NDArray& attn, const int numHeads, const int hK, const int hV, const bool normalization) {
+
+    // q [bS, qRows, qT], k [bS, kRows, kT], v [bS, vRows, kT], all contiguous; head h occupies rows offset + h*size ... offset + (h+1)*size
+    // attn [bS, numHeads * hV, qT], contiguous
+
+    const T* qBuf = q.bufferAsT<T>();
+    const T* kBuf = k.bufferAsT<T>();
+    const T* vBuf = v.bufferAsT<T>();
+          T* aBuf = attn.bufferAsT<T>();
+
+    const Nd4jLong bS    = q.sizeAt(0);
+    const Nd4jLong qRows = q.sizeAt(1);
+    const Nd4jLong qT    = q.sizeAt(2);
+    const Nd4jLong kRows = k.sizeAt(1);
+    const Nd4jLong kT    = k.sizeAt(2);
+    const Nd4jLong vRows = v.sizeAt(1);
+
+    const T factor = normalization ? static_cast<T>(1. / sd::math::nd4j_sqrt<double, double>(hK)) : static_cast<T>(1.);
+
+    // mask is 1 for positions to keep and 0 for positions to skip, skipped ones get -1e9 added before softmax, same as dot_product_attention
+    std::vector<T> maskBias;
+    if (mask != nullptr) {
+        maskBias.resize(bS * kT);
+        for (Nd4jLong b = 0; b < bS; ++b)
+            for (Nd4jLong s = 0; s < kT; ++s)
+                maskBias[b * kT + s] = static_cast<T>((mask->e<double>(b, s) - 1.) * 1e9);
+    }
+
+    auto func = PRAGMA_THREADS_FOR {
+
+        std::vector<T> probs(qT * kT);
+
+        for (auto i = start; i < stop; i++) {
+
+            const Nd4jLong b = i / numHeads;
+            const Nd4jLong h = i % numHeads;
+
+            const T* qTile = qBuf + (b * qRows + qOffset + h * hK) * qT;       // [hK, qT]
+            const T* kTile = kBuf + (b * kRows + kOffset + h * hK) * kT;       // [hK, kT]
+            const T* vTile = vBuf + (b * vRows + vOffset + h * hV) * kT;       // [hV, kT]
+                  T* aTile = aBuf + i * hV * qT;                               // [hV, qT]
+
+            // scores [qT, kT]
+            std::fill(probs.begin(), probs.end(), static_cast<T>(0));
+            for (int d = 0; d < hK; ++d) {
+                const T* kRow = kTile + d * kT;
+                for (Nd4jLong t = 0; t < qT; ++t) {
+                    const T qVal = qTile[d * qT + t] * factor;
+                    T* pRow = probs.data() + t * kT;
+
+                    PRAGMA_OMP_SIMD
+                    for (Nd4jLong s = 0; s < kT; ++s)
+                        pRow[s] += qVal * kRow[s];
+                }
+            }
+
+            // softmax over timesteps
+            for (Nd4jLong t = 0; t < qT; ++t) {
+                T* pRow = probs.data() + t * kT;
+
+                if (!maskBias.empty())
+                    for (Nd4jLong s = 0; s < kT; ++s)
+                        pRow[s] += maskBias[b * kT + s];
+
+                T max = pRow[0];
+                PRAGMA_OMP_SIMD_MAX(max)
+                for (Nd4jLong s = 1; s < kT; ++s)
+                    max = sd::math::nd4j_max<T>(max, pRow[s]);
+
+                T sum = static_cast<T>(0);
+                PRAGMA_OMP_SIMD_SUM(sum)
+                for (Nd4jLong s = 0; s < kT; ++s) {
+                    pRow[s] = sd::math::nd4j_exp<T, T>(pRow[s] - max);
+                    sum += pRow[s];
+                }
+
+                for (Nd4jLong s = 0; s < kT; ++s)
+                    pRow[s] /= sum;
+            }
+
+            // weighted values [hV, qT]
+            for (int d = 0; d < hV; ++d) {
+                const T* vRow = vTile + d * kT;
+                for (Nd4jLong t = 0; t < qT; ++t) {
+                    const T* pRow = probs.data() + t * kT;
+                    T sum = static_cast<T>(0);
+
+                    PRAGMA_OMP_SIMD_SUM(sum)
+                    for (Nd4jLong s = 0; s < kT; ++s)
+                        sum += vRow[s] * pRow[s];
+
+                    aTile[d * qT + t] = sum;
+                }
+            }
+        }
+    };
+
+    samediff::Threads::parallel_tad(func, 0, bS * numHeads);
+}
+
+//////////////////////////////////////////////////////////////////////////
+void multiHeadAttention(sd::LaunchContext* context, const NDArray& queries, const NDArray& keys, const NDArray& values, const NDArray& Wq, const NDArray& Wk, const NDArray& Wv, const NDArray& Wo, const NDArray* mask, NDArray& output, const bool normalization) {
+
+    const int numHeads = Wq.sizeAt(0);
+    const int hK = Wq.sizeAt(1);
+    const int hV = Wv.sizeAt(1);
+
+    const Nd4jLong bS = queries.sizeAt(0);
+    const Nd4jLong qT = queries.sizeAt(2);
+    const Nd4jLong kT = keys.sizeAt(2);
+
+    const Nd4jLong kRows = numHeads * hK;
+    const Nd4jLong vRows = numHeads * hV;
+
+    const bool kvShared  = sameArray(keys, values);
+    const bool qkvShared = kvShared && sameArray(queries, keys);
+
+    // all projections and attention result live in one scratch workspace
+    Nd4jLong wsLength = bS * vRows * qT;
+    if (qkvShared)
+        wsLength += bS * (2 * kRows + vRows) * qT;
+    else
+        wsLength += bS * kRows * qT + bS * (kRows + vRows) * kT;
+
+    const auto dtype = output.dataType();
+    NDArray workspace('c', {wsLength}, dtype, context);
+    Nd4jLong wsOffset = 0;
+
+    auto scratch = [&](const std::vector<Nd4jLong>& shape) -> NDArray {
+        NDArray arr(workspace.getDataBuffer(), ShapeDescriptor(dtype, 'c', shape), context, wsOffset);
+        wsOffset += arr.lengthOf();
+        return arr;
+    };
+
+    NDArray attn = scratch({bS, vRows, qT});
+
+    if (qkvShared) {
+        NDArray qkv = scratch({bS, 2 * kRows + vRows, qT});
+        project(queries, stackWeights({&Wq, &Wk, &Wv}), qkv);
+
+        BUILD_SINGLE_SELECTOR(dtype, attentionTiles_, (qkv, 0, qkv, kRows, qkv, 2 * kRows, mask, attn, numHeads, hK, hV, normalization), FLOAT_TYPES);
+    }
+    else {
+        NDArray q = scratch({bS, kRows, qT});
+        project(queries, stackWeights({&Wq}), q);
+
+        if (kvShared) {
+            NDArray kv = scratch({bS, kRows + vRows, kT});
+            project(keys, stackWeights({&Wk, &Wv}), kv);
+
+            BUILD_SINGLE_SELECTOR(dtype, attentionTiles_, (q, 0, kv, 0, kv, kRows, mask, attn, numHeads, hK, hV, normalization), FLOAT_TYPES);
+        }
+        else {
+            NDArray k = scratch({bS, kRows, kT});
+            NDArray v = scratch({bS, vRows, kT});
+            project(keys, stackWeights({&Wk}), k);
+            project(values, stackWeights({&Wv}), v);
+
+            BUILD_SINGLE_SELECTOR(dtype, attentionTiles_, (q, 0, k, 0, v, 0, mask, attn, numHeads, hK, hV, normalization), FLOAT_TYPES);
+        }
+    }
+
+    // output [bS, outSize, qT] = Wo^T [outSize, numHeads * hV] x attn [bS, numHeads * hV, qT], written per batch entry directly
+    const NDArray WoT = Wo.transpose();
+    for (Nd4jLong b = 0; b < bS; ++b) {
+        auto a = attn(b, {0});
+        auto z = output(b, {0});
+        MmulHelper::mmul(&WoT, &a, &z, 1.0, 0.0);
+    }
+}
+
+BUILD_SINGLE_TEMPLATE(template void attentionTiles_, (const NDArray& q, const Nd4jLong qOffset, const NDArray& k, const Nd4jLong kOffset, const NDArray& v, const Nd4jLong vOffset, const NDArray* mask, NDArray& attn, const int numHeads, const int hK, const int hV, const bool normalization), FLOAT_TYPES);
+
+}
+}
+}
@@ -23,6 +23,7 @@
 #include <helpers/ShapeUtils.h>
 #include <helpers/OmpLaunchHelper.h>
 #include <execution/Threads.h>
+#include <helpers/MixedPrecision.h>
 
 namespace sd 	  {
 namespace ops 	  {
@@ -30,7 +31,8 @@ namespace helpers {
 
 
 //////////////////////////////////////////////////////////////////////////
-template <typename T>
+// TA is type used for per-channel coefficients and arithmetic, output is rounded to T once per element
+template <typename T, typename TA>
 static void batchnorm_(const NDArray* input, const NDArray* mean, const NDArray* variance, const NDArray* gamma, const NDArray* beta,
                        NDArray* output,
                        const std::vector<int>& axes, const double epsilon) {
@@ -76,18 +78,18 @@ static void batchnorm_(const NDArray* input, const NDArray* mean, const NDArray*
             const auto meanOffset = shape::getIndexOffset(j, mean->shapeInfo());
             const auto varOffset  = paramSameOffset ? meanOffset : shape::getIndexOffset(j, variance->shapeInfo());
 
-            const auto meanVal = m[meanOffset];
-            auto sigmaInvGam   = static_cast<T>(1) / sd::math::nd4j_sqrt<T, T>(v[varOffset] + epsilon);
+            const auto meanVal = static_cast<TA>(m[meanOffset]);
+            auto sigmaInvGam   = static_cast<TA>(1) / sd::math::nd4j_sqrt<TA, TA>(static_cast<TA>(static_cast<double>(v[varOffset]) + epsilon));
 
             if(g != nullptr) {
                 const auto gammaOffset = paramSameOffset ? meanOffset : shape::getIndexOffset(j, gamma->shapeInfo());
-                sigmaInvGam *= g[gammaOffset];
+                sigmaInvGam *= static_cast<TA>(g[gammaOffset]);
             }
 
-            T betaVal = static_cast<T>(0);
+            TA betaVal = static_cast<TA>(0);
             if(b != nullptr) {
                 const auto betaOffset = paramSameOffset ? meanOffset : shape::getIndexOffset(j, beta->shapeInfo());
-                betaVal = b[betaOffset];
+                betaVal = static_cast<TA>(b[betaOffset]);
             }
 
             // calculate offsets for input and output
@@ -97,7 +99,7 @@ static void batchnorm_(const NDArray* input, const NDArray* mean, const NDArray*
 
             PRAGMA_OMP_SIMD
             for (Nd4jLong i = 0; i < steps; ++i)
-                z[zOffsets[i]] = (x[xOffsets[i]] - meanVal) * sigmaInvGam + betaVal;
+                z[zOffsets[i]] = static_cast<T>((static_cast<TA>(x[xOffsets[i]]) - meanVal) * sigmaInvGam + betaVal);
         }
 
         delete []auxBuff;
@@ -183,16 +185,25 @@ static void batchnorm2_(const NDArray* input, const NDArray* mean, const NDArray
     samediff::Threads::parallel_for(func, 0, input->lengthOf());
 }
 
+//////////////////////////////////////////////////////////////////////////
+template <typename T>
+static void batchnormWrapper_(const NDArray* input, const NDArray* mean, const NDArray* variance, const NDArray* gamma, const NDArray* beta, NDArray* output, const std::vector<int>& axes, const double epsilon) {
+    if (MixedPrecision::isFp32Accumulation())
+        batchnorm_<T, typename AccumulatorType<T>::type>(input, mean, variance, gamma, beta, output, axes, epsilon);
+    else
+        batchnorm_<T, T>(input, mean, variance, gamma, beta, output, axes, epsilon);
+}
+
 //////////////////////////////////////////////////////////////////////////
 void batchnorm(const NDArray* input, const NDArray* mean, const NDArray* variance, const NDArray* gamma, const NDArray* beta, NDArray* output, const std::vector<int>& axes, const double epsilon) {
 
     // batchnorm2_ is still slower ?
-    BUILD_SINGLE_SELECTOR(input->dataType(), batchnorm_, (input, mean, variance, gamma, beta, output, axes, epsilon), FLOAT_TYPES);
+    BUILD_SINGLE_SELECTOR(input->dataType(), batchnormWrapper_, (input, mean, variance, gamma, beta, output, axes, epsilon), FLOAT_TYPES);
 }
 
 
 
-BUILD_SINGLE_TEMPLATE(template void batchnorm_, (const NDArray* input, const NDArray* mean, const NDArray* variance, const NDArray* gamma, const NDArray* beta, NDArray* output, const std::vector<int>& axes, const double epsilon), FLOAT_TYPES);
+BUILD_SINGLE_TEMPLATE(template void batchnormWrapper_, (const NDArray* input, const NDArray* mean, const NDArray* variance, const NDArray* gamma, const NDArray* beta, NDArray* output, const std::vector<int>& axes, const double epsilon), FLOAT_TYPES);
 
 }
 }
@@ -0,0 +1,199 @@
+/*******************************************************************************
+ * Copyright (c) 2020 Konduit K.K.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+#include <ops/declarable/helpers/beam_search.h>
+#include <execution/Threads.h>
+#include <algorithm>
+
+namespace sd {
+namespace ops {
+namespace helpers {
+
+//////////////////////////////////////////////////////////////////////////
+template <typename T>
+struct BeamCandidate {
+    T key;
+    T score;
+    int parent;
+    int token;
+};
+
+// ties are resolved towards lower beam and lower token id, so selection doesn't depend on scan order
+template <typename T>
+static FORCEINLINE bool isBetter(const BeamCandidate<T>& a, const BeamCandidate<T>& b) {
+    if (a.key != b.key)
+        return a.key > b.key;
+    return a.parent != b.parent ? a.parent < b.parent : a.token < b.token;
+}
+
+// heap keeps the worst of k best candidates on top
+template <typename T>
+static FORCEINLINE void offer(std::vector<BeamCandidate<T>>& heap, const int k, const BeamCandidate<T>& c) {
+    if (static_cast<int>(heap.size()) < k) {
+        heap.push_back(c);
+        std::push_heap(heap.begin(), heap.end(), isBetter<T>);
+    }
+    else if (isBetter<T>(c, heap.front())) {
+        std::pop_heap(heap.begin(), heap.end(), isBetter<T>);
+        heap.back() = c;
+        std::push_heap(heap.begin(), heap.end(), isBetter<T>);
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////
+template <typename T>
+static void beamSearchStep_(const NDArray& logits, const NDArray& scores, const NDArray& finished, const NDArray& lengths,
+                            NDArray& newScores, NDArray& tokens, NDArray& parents, NDArray& newFinished, NDArray& newLengths, const int eosId, const double alpha) {
+
+    const int bS    = logits.sizeAt(0);
+    const int beam  = logits.sizeAt(1);
+    const int vocab = logits.sizeAt(2);
+
+    const T*    x = logits.bufferAsT<T>();
+    const T*    s = scores.bufferAsT<T>();
+    const bool* f = finished.bufferAsT<bool>();
+    const int*  l = lengths.bufferAsT<int>();
+
+    T*    zS = newScores.bufferAsT<T>();
+    int*  zT = tokens.bufferAsT<int>();
+    int*  zP = parents.bufferAsT<int>();
+    bool* zF = newFinished.bufferAsT<bool>();
+    int*  zL = newLengths.bufferAsT<int>();
+
+    const Nd4jLong xStride0 = logits.stridesOf()[0], xStride1 = logits.stridesOf()[1], xStride2 = logits.stridesOf()[2];
+    const Nd4jLong sStride0 = scores.stridesOf()[0], sStride1 = scores.stridesOf()[1];
+    const Nd4jLong fStride0 = finished.stridesOf()[0], fStride1 = finished.stridesOf()[1];
+    const Nd4jLong lStride0 = lengths.stridesOf()[0], lStride1 = lengths.stridesOf()[1];
+
+    const T minusInf = -DataTypeUtils::infOrMax<T>();
+
+    auto func = PRAGMA_THREADS_FOR {
+
+        std::vector<BeamCandidate<T>> heap, rowHeap;
+        heap.reserve(beam);
+        rowHeap.reserve(beam);
+
+        // previous state is copied out first, since finished and lengths may be updated in place
+        std::vector<T> prevScores(beam);
+        std::vector<char> prevFinished(beam);
+        std::vector<int> prevLengths(beam);
+
+        for (auto b = start; b < stop; b++) {
+
+            for (int k = 0; k < beam; ++k) {
+                prevScores[k]   = s[b * sStride0 + k * sStride1];
+                prevFinished[k] = f[b * fStride0 + k * fStride1];
+                prevLengths[k]  = l[b * lStride0 + k * lStride1];
+            }
+
+            heap.clear();
+
+            for (int k = 0; k < beam; ++k) {
+
+                const int length = prevFinished[k] ? prevLengths[k] : prevLengths[k] + 1;
+                const T penalty = alpha == 0. ? static_cast<T>(1) : static_cast<T>(std::pow((5. + length) / 6., alpha));
+
+                if (prevFinished[k]) {
+                    offer<T>(heap, beam, {prevScores[k] / penalty, prevScores[k], k, eosId});
+                    continue;
+                }
+
+                // single sweep over the row: log-sum-exp is accumulated online, while beam best tokens by raw logit are collected,
+                // candidate score is monotonic in logit within the row, so nothing else in the row can make it to the top
+                const T* row = x + b * xStride0 + k * xStride1;
+                T max = minusInf, sum = static_cast<T>(0);
+                rowHeap.clear();
+
+                for (int v = 0; v < vocab; ++v) {
+                    const T val = row[v * xStride2];
+                    if (val > max) {
+                        sum = sum * sd::math::nd4j_exp<T, T>(max - val) + static_cast<T>(1);
+                        max = val;
+                    }
+                    else if (val > minusInf)
+                        sum += sd::math::nd4j_exp<T, T>(val - max);
+
+                    offer<T>(rowHeap, beam, {val, val, k, v});
+                }
+
+                const bool dead = max == minusInf;       // every token of this beam is masked out
+                const T logSum = max + sd::math::nd4j_log<T, T>(sum);
+
+                for (const auto& c : rowHeap) {
+                    const T score = dead ? minusInf : prevScores[k] + (c.score - logSum);
+                    offer<T>(heap, beam, {score / penalty, score, k, c.token});
+                }
+            }
+
+            std::sort_heap(heap.begin(), heap.end(), isBetter<T>);
+
+            for (int j = 0; j < beam; ++j) {
+                const auto& c = heap[j];
+                const bool wasFinished = prevFinished[c.parent];
+
+                zS[b * newScores.stridesOf()[0] + j * newScores.stridesOf()[1]] = c.score;
+                zT[b * tokens.stridesOf()[0] + j * tokens.stridesOf()[1]] = c.token;
+                zP[b * parents.stridesOf()[0] + j * parents.stridesOf()[1]] = c.parent;
+                zF[b * newFinished.stridesOf()[0] + j * newFinished.stridesOf()[1]] = wasFinished || c.token == eosId;
+                zL[b * newLengths.stridesOf()[0] + j * newLengths.stridesOf()[1]] = wasFinished ? prevLengths[c.parent] : prevLengths[c.parent] + 1;
+            }
+        }
+    };
+
+    samediff::Threads::parallel_tad(func, 0, bS);
+}
+
+//////////////////////////////////////////////////////////////////////////
+void beamSearchStep(sd::LaunchContext* context, const NDArray& logits, const NDArray& scores, const NDArray& finished, const NDArray& lengths,
+                    NDArray& newScores, NDArray& tokens, NDArray& parents, NDArray& newFinished, NDArray& newLengths, const int eosId, const double alpha) {
+
+    BUILD_SINGLE_SELECTOR(logits.dataType(), beamSearchStep_, (logits, scores, finished, lengths, newScores, tokens, parents, newFinished, newLengths, eosId, alpha), FLOAT_TYPES);
+}
+
+//////////////////////////////////////////////////////////////////////////
+void beamSearchBacktrace(sd::LaunchContext* context, const NDArray& tokens, const NDArray& parents, NDArray& sequences) {
+
+    const int time = tokens.sizeAt(0);
+    const int bS   = tokens.sizeAt(1);
+    const int beam = tokens.sizeAt(2);
+
+    const int* t = tokens.bufferAsT<int>();
+    const int* p = parents.bufferAsT<int>();
+          int* z = sequences.bufferAsT<int>();
+
+    const Nd4jLong tStride0 = tokens.stridesOf()[0], tStride1 = tokens.stridesOf()[1], tStride2 = tokens.stridesOf()[2];
+    const Nd4jLong pStride0 = parents.stridesOf()[0], pStride1 = parents.stridesOf()[1], pStride2 = parents.stridesOf()[2];
+    const Nd4jLong zStride0 = sequences.stridesOf()[0], zStride1 = sequences.stridesOf()[1], zStride2 = sequences.stridesOf()[2];
+
+    auto func = PRAGMA_THREADS_FOR {
+        for (auto b = start; b < stop; b++) {
+            for (int k = 0; k < beam; ++k) {
+                int beamIdx = k;
+                for (int i = time - 1; i >= 0; --i) {
+                    z[b * zStride0 + k * zStride1 + i * zStride2] = t[i * tStride0 + b * tStride1 + beamIdx * tStride2];
+                    beamIdx = p[i * pStride0 + b * pStride1 + beamIdx * pStride2];
+                }
+            }
+        }
+    };
+
+    samediff::Threads::parallel_tad(func, 0, bS);
+}
+
+}
+}
+}
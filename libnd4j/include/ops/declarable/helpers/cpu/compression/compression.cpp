@@ -29,8 +29,102 @@ namespace helpers {
     }
 
 
-    Nd4jLong encodeBitmap(sd::LaunchContext* context, NDArray* input, NDArray* output, float threshold) {
-        return NativeOpExecutioner::encodeBitmap(input->buffer(), input->shapeInfo(), input->lengthOf(), output->bufferAsT<int>(), threshold);
+    Nd4jLong encodeBitmap(sd::LaunchContext* context, NDArray* input, NDArray* output, float threshold, bool rle) {
+        return NativeOpExecutioner::encodeBitmap(input->buffer(), input->shapeInfo(), input->lengthOf(), output->bufferAsT<int>(), threshold, rle);
+    }
+
+    template <typename T>
+    static void encodeSignMask_(const NDArray* input, NDArray* output, bool negative) {
+        auto x = input->bufferAsT<T>();
+        auto z = output->bufferAsT<uint8_t>();
+        auto length = input->lengthOf();
+
+        // each byte is packed by single thread
+        auto func = PRAGMA_THREADS_FOR {
+            for (auto b = start; b < stop; b++) {
+                uint8_t byte = 0;
+                auto last = sd::math::nd4j_min<Nd4jLong>(length, (b + 1) * 8);
+                for (auto e = b * 8; e < last; e++)
+                    if (negative ? x[e] < static_cast<T>(0.f) : x[e] > static_cast<T>(0.f))
+                        byte |= static_cast<uint8_t>(1 << (e - b * 8));
+
+                z[b] = byte;
+            }
+        };
+
+        samediff::Threads::parallel_for(func, 0, output->lengthOf());
+    }
+
+    template <typename T>
+    static void decodeSignMask_(const NDArray* input, NDArray* output, bool negative) {
+        auto x = input->bufferAsT<uint8_t>();
+        auto z = output->bufferAsT<T>();
+        auto one = static_cast<T>(negative ? -1.f : 1.f);
+
+        auto func = PRAGMA_THREADS_FOR {
+            for (auto e = start; e < stop; e++)
+                z[e] = (x[e >> 3] >> (e & 7)) & 1 ? one : static_cast<T>(0.f);
+        };
+
+        samediff::Threads::parallel_for(func, 0, output->lengthOf());
+    }
+
+    template <typename T>
+    static void quantizeBlocks_(const NDArray* input, NDArray* output, NDArray* scales, int blockSize) {
+        auto x = input->bufferAsT<T>();
+        auto z = output->bufferAsT<int8_t>();
+        auto s = scales->bufferAsT<float>();
+        auto length = input->lengthOf();
+
+        auto func = PRAGMA_THREADS_FOR {
+            for (auto b = start; b < stop; b++) {
+                auto first = b * blockSize;
+                auto last = sd::math::nd4j_min<Nd4jLong>(length, first + blockSize);
+
+                float amax = 0.f;
+                for (auto e = first; e < last; e++)
+                    amax = sd::math::nd4j_max<float>(amax, sd::math::nd4j_abs<float>(static_cast<float>(x[e])));
+
+                auto scale = amax / 127.f;
+                auto inverse = scale > 0.f ? 1.f / scale : 0.f;
+                s[b] = scale;
+
+                for (auto e = first; e < last; e++)
+                    z[e] = static_cast<int8_t>(sd::math::nd4j_round<float, float>(static_cast<float>(x[e]) * inverse));
+            }
+        };
+
+        samediff::Threads::parallel_for(func, 0, scales->lengthOf());
+    }
+
+    template <typename T>
+    static void dequantizeBlocks_(const NDArray* input, const NDArray* scales, NDArray* output, int blockSize) {
+        auto x = input->bufferAsT<int8_t>();
+        auto s = scales->bufferAsT<float>();
+        auto z = output->bufferAsT<T>();
+
+        auto func = PRAGMA_THREADS_FOR {
+            for (auto e = start; e < stop; e++)
+                z[e] = static_cast<T>(static_cast<float>(x[e]) * s[e / blockSize]);
+        };
+
+        samediff::Threads::parallel_for(func, 0, output->lengthOf());
+    }
+
+    void encodeSignMask(sd::LaunchContext* context, const NDArray* input, NDArray* output, bool negative) {
+        BUILD_SINGLE_SELECTOR(input->dataType(), encodeSignMask_, (input, output, negative), FLOAT_TYPES);
+    }
+
+    void decodeSignMask(sd::LaunchContext* context, const NDArray* input, NDArray* output, bool negative) {
+        BUILD_SINGLE_SELECTOR(output->dataType(), decodeSignMask_, (input, output, negative), FLOAT_TYPES);
+    }
+
+    void quantizeBlocks(sd::LaunchContext* context, const NDArray* input, NDArray* output, NDArray* scales, int blockSize) {
+        BUILD_SINGLE_SELECTOR(input->dataType(), quantizeBlocks_, (input, output, scales, blockSize), FLOAT_TYPES);
+    }
+
+    void dequantizeBlocks(sd::LaunchContext* context, const NDArray* input, const NDArray* scales, NDArray* output, int blockSize) {
+        BUILD_SINGLE_SELECTOR(output->dataType(), dequantizeBlocks_, (input, scales, output, blockSize), FLOAT_TYPES);
     }
 }
 }
@@ -20,6 +20,7 @@
 
 #include <ops/declarable/helpers/confusion.h>
 #include <execution/Threads.h>
+#include <array/TadView.h>
 
 
 namespace sd {
@@ -28,7 +29,7 @@ namespace helpers {
 
     template <typename T>
     void _confusionFunctor(NDArray* labels, NDArray* predictions, NDArray* weights, NDArray* output) {
-        ResultSet arrs = output->allTensorsAlongDimension({1});
+        TadView<T> arrs(*output, {1});
         int lLen = labels->lengthOf();
 
         auto func = PRAGMA_THREADS_FOR {
@@ -36,7 +37,7 @@ namespace helpers {
                 auto label = labels->e<Nd4jLong>(j);
                 auto pred = predictions->e<Nd4jLong>(j);
                 T value = (weights == nullptr ? (T) 1.0f : weights->e<T>(j));
-                arrs.at(label)->p<T>(pred, value);
+                arrs(label, pred) = value;
             }
         };
 
@@ -0,0 +1,93 @@
+/*******************************************************************************
+ * Copyright (c) 2020 Konduit K.K.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#include <ops/declarable/helpers/convolutions.h>
+#include <ops/declarable/helpers/addBias.h>
+#include <helpers/MmulHelper.h>
+#include <execution/Threads.h>
+
+namespace sd {
+    namespace ops  {
+
+//////////////////////////////////////////////////////////////////////////
+template <typename T>
+static void biasActivation_(NDArray& output, const NDArray* bias, const int isNCHW, const GemmEpilogue::Activation activation, const double cutoff) {
+
+    // output [bS, oC, oH, oW] (NCHW) or [bS, oH, oW, oC] (NHWC), c-contiguous
+
+    T* z = output.bufferAsT<T>();
+
+    const Nd4jLong oC = output.sizeAt(isNCHW ? 1 : -1);
+    const Nd4jLong plane = isNCHW ? output.lengthOf() / (output.sizeAt(0) * oC) : 1;   // contiguous run of elements sharing channel
+    const Nd4jLong runs = output.lengthOf() / plane;
+    const T cut = static_cast<T>(cutoff);
+
+    std::vector<T> b(oC, static_cast<T>(0));
+    if (bias != nullptr)
+        for (Nd4jLong c = 0; c < oC; ++c)
+            b[c] = bias->e<T>(c);
+
+    if (isNCHW) {
+        auto func = PRAGMA_THREADS_FOR {
+            for (auto r = start; r < stop; r++) {
+                T* zRun = z + r * plane;
+                const T bc = b[r % oC];
+
+                PRAGMA_OMP_SIMD
+                for (Nd4jLong e = 0; e < plane; e++)
+                    zRun[e] = GemmEpilogue::activate<T>(zRun[e] + bc, activation, cut);
+            }
+        };
+
+        samediff::Threads::parallel_for(func, 0, runs);
+    }
+    else {
+        auto func = PRAGMA_THREADS_FOR {
+            for (auto r = start; r < stop; r++) {
+                T* zRun = z + r * oC;
+
+                PRAGMA_OMP_SIMD
+                for (Nd4jLong c = 0; c < oC; c++)
+                    zRun[c] = GemmEpilogue::activate<T>(zRun[c] + b[c], activation, cut);
+            }
+        };
+
+        samediff::Threads::parallel_for(func, 0, output.lengthOf() / oC);
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////
+void ConvolutionUtils::biasActivation(sd::graph::Context& block, NDArray& output, const NDArray* bias, const int isNCHW, const GemmEpilogue::Activation activation, const double cutoff) {
+
+    if (activation == GemmEpilogue::NONE) {
+        if (bias != nullptr)
+            helpers::addBias(block, output, *bias, output, isNCHW);
+        return;
+    }
+
+    if (output.ordering() == 'c' && output.ews() == 1 && output.rankOf() == 4) {
+        BUILD_SINGLE_SELECTOR(output.dataType(), biasActivation_, (output, bias, isNCHW, activation, cutoff), FLOAT_TYPES);
+        return;
+    }
+
+    if (bias != nullptr)
+        helpers::addBias(block, output, *bias, output, isNCHW);
+
+    MmulHelper::applyEpilogue(output, output, GemmEpilogue(nullptr, activation, cutoff));
+}
+
+}
+}
@@ -32,7 +32,7 @@ namespace sd {
 
 //////////////////////////////////////////////////////////////////////////
 template <typename X, typename Y>
-static void conv2d_(sd::graph::Context& block, const NDArray* input, const NDArray* weights, const NDArray* bias, NDArray* output, const int kH, const int kW, const int sH, const int sW, int pH, int pW, const int dH, const int dW, const int paddingMode, const int isNCHW, const int wFormat) {
+static void conv2d_(sd::graph::Context& block, const NDArray* input, const NDArray* weights, const NDArray* bias, NDArray* output, const int kH, const int kW, const int sH, const int sW, int pH, int pW, const int dH, const int dW, const int paddingMode, const int isNCHW, const int wFormat, const GemmEpilogue::Activation activation, const double cutoff) {
 
             // input   [bS, iH, iW, iC] (NHWC) or [bS, iC, iH, iW] (NCHW)
             // weights [kH, kW, iC, oC], [oC, iC, kH, kW], [oC, kH, kW, iC]
@@ -89,18 +89,17 @@ static void conv2d_(sd::graph::Context& block, const NDArray* input, const NDArr
             }
             output->assign(mmulResult);
 
-            //----- add biases if required -----//
-            if(bias)
-                // output->applyBroadcast(broadcast::Add, {indIOioC}, bias);
-                helpers::addBias(block, *output, *bias, *output, isNCHW);
+            //----- add biases and apply fused activation if required -----//
+            if(bias || activation != GemmEpilogue::NONE)
+                ConvolutionUtils::biasActivation(block, *output, bias, isNCHW, activation, cutoff);
 
             if(!isNCHW)
                 delete input;
 
         }
 
-void ConvolutionUtils::conv2d(sd::graph::Context& block, const NDArray* input, const NDArray* weights, const NDArray* bias, NDArray* output, const int kH, const int kW, const int sH, const int sW, int pH, int pW, const int dH, const int dW, const int paddingMode, const int isNCHW, const int wFormat) {
-            BUILD_SINGLE_SELECTOR_TWICE(input->dataType(), conv2d_, (block, input, weights, bias, output, kH, kW, sH, sW, pH, pW, dH, dW, paddingMode, isNCHW, wFormat), FLOAT_TYPES);
+void ConvolutionUtils::conv2d(sd::graph::Context& block, const NDArray* input, const NDArray* weights, const NDArray* bias, NDArray* output, const int kH, const int kW, const int sH, const int sW, int pH, int pW, const int dH, const int dW, const int paddingMode, const int isNCHW, const int wFormat, const GemmEpilogue::Activation activation, const double cutoff) {
+            BUILD_SINGLE_SELECTOR_TWICE(input->dataType(), conv2d_, (block, input, weights, bias, output, kH, kW, sH, sW, pH, pW, dH, dW, paddingMode, isNCHW, wFormat, activation, cutoff), FLOAT_TYPES);
 }
 
 }
@@ -0,0 +1,127 @@
+/*******************************************************************************
+ * Copyright (c) 2020 Konduit K.K.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#include <ops/declarable/helpers/convolutions.h>
+#include <execution/Threads.h>
+
+namespace sd {
+    namespace ops  {
+
+//////////////////////////////////////////////////////////////////////////
+template <typename T>
+static void conv3dDirect_(const NDArray& input, const NDArray& weights, NDArray& output, const int kD, const int kH, const int kW, const int sD, const int sH, const int sW, const int pD, const int pH, const int pW, const int dD, const int dH, const int dW) {
+
+    // input   [bS, iD, iH, iW, iC]
+    // weights [kD, kH, kW, iC, oC], contiguous
+    // output  [bS, oD, oH, oW, oC]
+
+    const T* x = input.bufferAsT<T>();
+    const T* w = weights.bufferAsT<T>();
+          T* z = output.bufferAsT<T>();
+
+    const int bS = input.sizeAt(0);
+    const int iD = input.sizeAt(1);
+    const int iH = input.sizeAt(2);
+    const int iW = input.sizeAt(3);
+    const int iC = input.sizeAt(4);
+    const int oD = output.sizeAt(1);
+    const int oH = output.sizeAt(2);
+    const int oW = output.sizeAt(3);
+    const int oC = output.sizeAt(4);
+
+    const Nd4jLong xStride0 = input.stridesOf()[0];
+    const Nd4jLong xStride1 = input.stridesOf()[1];
+    const Nd4jLong xStride2 = input.stridesOf()[2];
+    const Nd4jLong xStride3 = input.stridesOf()[3];
+    const Nd4jLong xStride4 = input.stridesOf()[4];
+    const Nd4jLong zStride0 = output.stridesOf()[0];
+    const Nd4jLong zStride1 = output.stridesOf()[1];
+    const Nd4jLong zStride2 = output.stridesOf()[2];
+    const Nd4jLong zStride3 = output.stridesOf()[3];
+    const Nd4jLong zStride4 = output.stridesOf()[4];
+
+    auto func = PRAGMA_THREADS_FOR_3D {
+
+        std::vector<T> acc(oC);
+
+        for (int b = start_x; b < stop_x; b += inc_x) {
+            for (int od = start_y; od < stop_y; od += inc_y) {
+                for (int oh = start_z; oh < stop_z; oh += inc_z) {
+                    for (int ow = 0; ow < oW; ++ow) {
+
+                        std::fill(acc.begin(), acc.end(), static_cast<T>(0));
+
+                        for (int kd = 0; kd < kD; ++kd) {
+                            const int id = od * sD - pD + kd * dD;
+                            if (id < 0 || id >= iD)
+                                continue;
+
+                            for (int kh = 0; kh < kH; ++kh) {
+                                const int ih = oh * sH - pH + kh * dH;
+                                if (ih < 0 || ih >= iH)
+                                    continue;
+
+                                for (int kw = 0; kw < kW; ++kw) {
+                                    const int iw = ow * sW - pW + kw * dW;
+                                    if (iw < 0 || iw >= iW)
+                                        continue;
+
+                                    const T* xIn = x + b * xStride0 + id * xStride1 + ih * xStride2 + iw * xStride3;
+                                    const T* wIn = w + ((kd * kH + kh) * kW + kw) * iC * oC;
+
+                                    for (int ic = 0; ic < iC; ++ic) {
+                                        const T xVal = xIn[ic * xStride4];
+                                        const T* wRow = wIn + ic * oC;
+
+                                        PRAGMA_OMP_SIMD
+                                        for (int oc = 0; oc < oC; ++oc)
+                                            acc[oc] += xVal * wRow[oc];
+                                    }
+                                }
+                            }
+                        }
+
+                        T* zOut = z + b * zStride0 + od * zStride1 + oh * zStride2 + ow * zStride3;
+                        for (int oc = 0; oc < oC; ++oc)
+                            zOut[oc * zStride4] = acc[oc];
+                    }
+                }
+            }
+        }
+    };
+
+    samediff::Threads::parallel_for(func, 0, bS, 1, 0, oD, 1, 0, oH, 1);
+}
+
+//////////////////////////////////////////////////////////////////////////
+void ConvolutionUtils::conv3dDirect(sd::graph::Context& block, const NDArray* input, const NDArray* weights, NDArray* output, const int kD, const int kH, const int kW, const int sD, const int sH, const int sW, const int pD, const int pH, const int pW, const int dD, const int dH, const int dW, const int wFormat) {
+
+    // inner loop runs over oC, so weights are brought to contiguous [kD, kH, kW, iC, oC] once
+    std::vector<int> permut;
+    if(0 == wFormat)
+        permut = {0,1,2,3,4};
+    else if(1 == wFormat)
+        permut = {2,3,4,1,0};                   // [oC, iC, kD, kH, kW] -> [kD, kH, kW, iC, oC]
+    else
+        permut = {1,2,3,4,0};                   // [oC, kD, kH, kW, iC] -> [kD, kH, kW, iC, oC]
+
+    NDArray w = weights->permute(permut).dup('c');
+
+    BUILD_SINGLE_SELECTOR(input->dataType(), conv3dDirect_, (*input, w, *output, kD, kH, kW, sD, sH, sW, pD, pH, pW, dD, dH, dW), FLOAT_TYPES);
+}
+
+}
+}
@@ -0,0 +1,153 @@
+/*******************************************************************************
+ * Copyright (c) 2020 Konduit K.K.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#include <ops/declarable/helpers/convolutions.h>
+#include <execution/Threads.h>
+
+namespace sd {
+    namespace ops  {
+
+//////////////////////////////////////////////////////////////////////////
+// output pixel oh receives input pixel ih through kernel row kh if oh = ih*sH - pH + kh*dH,
+// so for given phase (oh + pH) % sH only kernel rows with kh*dH % sH equal to that phase contribute
+static std::vector<std::vector<int>> phaseTaps(const int k, const int s, const int d) {
+
+    std::vector<std::vector<int>> taps(s);
+    for (int i = 0; i < k; ++i)
+        taps[(i * d) % s].push_back(i);
+
+    return taps;
+}
+
+//////////////////////////////////////////////////////////////////////////
+template <typename T>
+static void deconv2d_(const NDArray& input, const NDArray& weights, const NDArray* bias, NDArray& output, const int kH, const int kW, const int sH, const int sW, const int pH, const int pW, const int dH, const int dW, const GemmEpilogue::Activation activation, const double cutoff) {
+
+    // input   [bS, iC, iH, iW], any strides
+    // weights [kH, kW, iC, oC], contiguous
+    // output  [bS, oC, oH, oW], any strides
+
+    const T* x = input.bufferAsT<T>();
+    const T* w = weights.bufferAsT<T>();
+          T* z = output.bufferAsT<T>();
+
+    const int bS = input.sizeAt(0);
+    const int iC = input.sizeAt(1);
+    const int iH = input.sizeAt(2);
+    const int iW = input.sizeAt(3);
+    const int oC = output.sizeAt(1);
+    const int oH = output.sizeAt(2);
+    const int oW = output.sizeAt(3);
+
+    const Nd4jLong xStride0 = input.stridesOf()[0];
+    const Nd4jLong xStride1 = input.stridesOf()[1];
+    const Nd4jLong xStride2 = input.stridesOf()[2];
+    const Nd4jLong xStride3 = input.stridesOf()[3];
+    const Nd4jLong zStride0 = output.stridesOf()[0];
+    const Nd4jLong zStride1 = output.stridesOf()[1];
+    const Nd4jLong zStride2 = output.stridesOf()[2];
+    const Nd4jLong zStride3 = output.stridesOf()[3];
+
+    const T cut = static_cast<T>(cutoff);
+
+    const auto hTaps = phaseTaps(kH, sH, dH);
+    const auto wTaps = phaseTaps(kW, sW, dW);
+
+    std::vector<T> init(oC, static_cast<T>(0));
+    if (bias != nullptr)
+        for (int oc = 0; oc < oC; ++oc)
+            init[oc] = bias->e<T>(oc);
+
+    auto func = PRAGMA_THREADS_FOR_2D {
+
+        std::vector<T> acc(oC);
+
+        for (int b = start_x; b < stop_x; b += inc_x) {
+            for (int oh = start_y; oh < stop_y; oh += inc_y) {
+
+                const auto& rows = hTaps[((oh + pH) % sH + sH) % sH];        // SAME mode padding might be negative
+
+                for (int ow = 0; ow < oW; ++ow) {
+
+                    std::copy(init.begin(), init.end(), acc.begin());
+
+                    const auto& cols = wTaps[((ow + pW) % sW + sW) % sW];
+
+                    for (const auto kh : rows) {
+                        const int hPos = oh + pH - kh * dH;
+                        if (hPos < 0 || hPos / sH >= iH)
+                            continue;
+                        const int ih = hPos / sH;
+
+                        for (const auto kw : cols) {
+                            const int wPos = ow + pW - kw * dW;
+                            if (wPos < 0 || wPos / sW >= iW)
+                                continue;
+                            const int iw = wPos / sW;
+
+                            const T* xIn = x + b * xStride0 + ih * xStride2 + iw * xStride3;
+                            const T* wIn = w + (kh * kW + kw) * iC * oC;
+
+                            for (int ic = 0; ic < iC; ++ic) {
+                                const T xVal = xIn[ic * xStride1];
+                                const T* wRow = wIn + ic * oC;
+
+                                PRAGMA_OMP_SIMD
+                                for (int oc = 0; oc < oC; ++oc)
+                                    acc[oc] += xVal * wRow[oc];
+                            }
+                        }
+                    }
+
+                    T* zOut = z + b * zStride0 + oh * zStride2 + ow * zStride3;
+                    for (int oc = 0; oc < oC; ++oc)
+                        zOut[oc * zStride1] = GemmEpilogue::activate<T>(acc[oc], activation, cut);
+                }
+            }
+        }
+    };
+
+    samediff::Threads::parallel_for(func, 0, bS, 1, 0, oH, 1);
+}
+
+//////////////////////////////////////////////////////////////////////////
+void ConvolutionUtils::deconv2d(sd::graph::Context& block, const NDArray* input, const NDArray* weights, const NDArray* bias, NDArray* output, const int kH, const int kW, const int sH, const int sW, const int pH, const int pW, const int dH, const int dW, const int isNCHW, const int wFormat, const GemmEpilogue::Activation activation, const double cutoff) {
+
+    // input   [bS, iH, iW, iC] (NHWC) or [bS, iC, iH, iW] (NCHW)
+    // weights [kH, kW, oC, iC], [iC, oC, kH, kW], [iC, kH, kW, oC]
+    // bias    [oC]
+    // output  [bS, oH, oW, oC] (NHWC) or [bS, oC, oH, oW] (NCHW)
+
+    std::vector<int> wPermut;
+    if(0 == wFormat)
+        wPermut = {0, 1, 3, 2};                 // [kH, kW, oC, iC] -> [kH, kW, iC, oC]
+    else if(1 == wFormat)
+        wPermut = {2, 3, 0, 1};                 // [iC, oC, kH, kW] -> [kH, kW, iC, oC]
+    else
+        wPermut = {1, 2, 0, 3};                 // [iC, kH, kW, oC] -> [kH, kW, iC, oC]
+
+    NDArray w = weights->permute(wPermut).dup('c');
+
+    const std::vector<int> toNCHW = isNCHW ? std::vector<int>({0, 1, 2, 3}) : std::vector<int>({0, 3, 1, 2});
+
+    NDArray in  = input->permute(toNCHW);
+    NDArray out = output->permute(toNCHW);
+
+    BUILD_SINGLE_SELECTOR(input->dataType(), deconv2d_, (in, w, bias, out, kH, kW, sH, sW, pH, pW, dH, dW, activation, cutoff), FLOAT_TYPES);
+}
+
+}
+}
@@ -20,6 +20,7 @@
 
 #include <ops/declarable/helpers/axis.h>
 #include <execution/Threads.h>
+#include <array/TadView.h>
 
 namespace sd {
 namespace ops {
@@ -28,8 +29,8 @@ namespace helpers {
     template <typename T>
     static void _extractPatches(NDArray* images, NDArray* output, int sizeRow, int sizeCol, int strideRow, int strideCol, int rateRow, int rateCol, bool theSame){
         std::vector<int> restDims({1, 2, 3}); // the first and the last dims
-        ResultSet listOfMatricies = images->allTensorsAlongDimension(restDims);
-        ResultSet listOfOutputs = output->allTensorsAlongDimension(restDims);
+        TadView<const T> listOfMatricies(*images, restDims);
+        TadView<T> listOfOutputs(*output, restDims);
         // 3D matricies - 2D matricies of vectors (if last dim is greater than 1)
         //int e = 0;
         const int ksizeRowsEffective = sizeRow + (sizeRow - 1) * (rateRow - 1);
@@ -50,10 +51,7 @@ namespace helpers {
             colCast = 0;
 
        auto func = PRAGMA_THREADS_FOR {
-           for (auto batch = 0; batch < stop; batch++) {
-               auto patch = listOfMatricies.at(batch);
-               auto outMatrix = listOfOutputs.at(batch);
-
+           for (auto batch = start; batch < stop; batch++) {
                for (Nd4jLong i = 0; i < outRowDim; i++) {
                    for (Nd4jLong j = 0; j < outColDim; j++) {
                        Nd4jLong pos = 0;
@@ -73,7 +71,7 @@ namespace helpers {
                                    bool setUp = (theSame && row >= 0 && col >= 0 && row < rowDim && col < colDim) ||
                                                 (!theSame);
                                    if (setUp) {
-                                       outMatrix->r<T>(i, j, pos) = patch->e<T>(row, col, pixel);
+                                       listOfOutputs(batch, i, j, pos) = listOfMatricies(batch, row, col, pixel);
                                    }
                                    pos++;
                                }
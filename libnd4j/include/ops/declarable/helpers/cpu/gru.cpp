@@ -0,0 +1,158 @@
+/*******************************************************************************
+ * Copyright (c) 2020 Konduit K.K.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+#include <ops/declarable/helpers/gru.h>
+#include <execution/Threads.h>
+
+namespace sd 	  {
+namespace ops 	  {
+namespace helpers {
+
+//////////////////////////////////////////////////////////////////////////
+template <typename T>
+static void gruCellActivations_(const NDArray& xProj, const NDArray& hI, NDArray& gates, NDArray* hc, NDArray& h) {
+
+    // zr = xProj_r + (hI × Wh)_r,  r = sigmoid(zr)
+    // zu = xProj_u + (hI × Wh)_u,  u = sigmoid(zu)
+    // zc = xProj_c + r * (hI × Wh)_c,  c = tanh(zc)
+    // h = u * hI + (1 - u) * c
+
+    const int bS   = hI.sizeAt(0);
+    const int nOut = hI.sizeAt(1);
+
+    const T* xp = xProj.bufferAsT<T>();
+    const T* hp = hI.bufferAsT<T>();
+          T* g  = gates.bufferAsT<T>();
+          T* zc = hc == nullptr ? nullptr : hc->bufferAsT<T>();
+          T* z  = h.bufferAsT<T>();
+
+    const Nd4jLong xStride0 = xProj.stridesOf()[0], xStride1 = xProj.stridesOf()[1];
+    const Nd4jLong hStride0 = hI.stridesOf()[0],    hStride1 = hI.stridesOf()[1];
+    const Nd4jLong gStride0 = gates.stridesOf()[0], gStride1 = gates.stridesOf()[1];
+    const Nd4jLong zStride0 = h.stridesOf()[0],     zStride1 = h.stridesOf()[1];
+    const Nd4jLong cStride0 = hc == nullptr ? 0 : hc->stridesOf()[0];
+    const Nd4jLong cStride1 = hc == nullptr ? 0 : hc->stridesOf()[1];
+
+    auto func = PRAGMA_THREADS_FOR {
+        for (auto e = start; e < stop; e++) {
+
+            const T* xRow = xp + e * xStride0;
+            const T* hRow = hp + e * hStride0;
+                  T* gRow = g  + e * gStride0;
+                  T* zRow = z  + e * zStride0;
+
+            for (int j = 0; j < nOut; ++j) {
+
+                const T r     = sd::math::nd4j_sigmoid<T, T>(gRow[j * gStride1] + xRow[j * xStride1]);
+                const T u     = sd::math::nd4j_sigmoid<T, T>(gRow[(nOut + j) * gStride1] + xRow[(nOut + j) * xStride1]);
+                const T hWc   = gRow[(2 * nOut + j) * gStride1];
+                const T c     = sd::math::nd4j_tanh<T, T>(r * hWc + xRow[(2 * nOut + j) * xStride1]);
+                const T hPrev = hRow[j * hStride1];
+
+                if (zc != nullptr)
+                    zc[e * cStride0 + j * cStride1] = hWc;
+
+                gRow[j * gStride1]              = r;
+                gRow[(nOut + j) * gStride1]     = u;
+                gRow[(2 * nOut + j) * gStride1] = c;
+
+                zRow[j * zStride1] = u * hPrev + (static_cast<T>(1) - u) * c;
+            }
+        }
+    };
+
+    samediff::Threads::parallel_tad(func, 0, bS);
+}
+
+//////////////////////////////////////////////////////////////////////////
+template <typename T>
+static void gruCellActivationsBp_(const NDArray& hI, const NDArray& gates, const NDArray& hc, const NDArray* dLdh, NDArray& dLdhI, NDArray& dLdz, NDArray& dLdzh) {
+
+    // dLdzc = dLdh * (1 - u) * (1 - c*c)
+    // dLdzu = dLdh * (hI - c) * u * (1 - u)
+    // dLdzr = dLdzc * (hI × Wh)_c * r * (1 - r)
+    // dLdhI = dLdh * u + (rest comes from dLdzh × WhT)
+
+    const int bS   = hI.sizeAt(0);
+    const int nOut = hI.sizeAt(1);
+
+    const T* hp  = hI.bufferAsT<T>();
+    const T* g   = gates.bufferAsT<T>();
+    const T* hWc = hc.bufferAsT<T>();
+    const T* dh  = dLdh == nullptr ? nullptr : dLdh->bufferAsT<T>();
+          T* dhI = dLdhI.bufferAsT<T>();
+          T* dz  = dLdz.bufferAsT<T>();
+          T* dzh = dLdzh.bufferAsT<T>();
+
+    const Nd4jLong hStride0   = hI.stridesOf()[0],    hStride1   = hI.stridesOf()[1];
+    const Nd4jLong gStride0   = gates.stridesOf()[0], gStride1   = gates.stridesOf()[1];
+    const Nd4jLong cStride0   = hc.stridesOf()[0],    cStride1   = hc.stridesOf()[1];
+    const Nd4jLong dhStride0  = dLdh == nullptr ? 0 : dLdh->stridesOf()[0];
+    const Nd4jLong dhStride1  = dLdh == nullptr ? 0 : dLdh->stridesOf()[1];
+    const Nd4jLong dhIStride0 = dLdhI.stridesOf()[0], dhIStride1 = dLdhI.stridesOf()[1];
+    const Nd4jLong dzStride0  = dLdz.stridesOf()[0],  dzStride1  = dLdz.stridesOf()[1];
+    const Nd4jLong dzhStride0 = dLdzh.stridesOf()[0], dzhStride1 = dLdzh.stridesOf()[1];
+
+    auto func = PRAGMA_THREADS_FOR {
+        for (auto e = start; e < stop; e++) {
+
+            const T* gRow   = g + e * gStride0;
+                  T* dzRow  = dz + e * dzStride0;
+                  T* dzhRow = dzh + e * dzhStride0;
+
+            for (int j = 0; j < nOut; ++j) {
+
+                const T r = gRow[j * gStride1];
+                const T u = gRow[(nOut + j) * gStride1];
+                const T c = gRow[(2 * nOut + j) * gStride1];
+
+                T& dLdhIj = dhI[e * dhIStride0 + j * dhIStride1];
+                const T grad = dh == nullptr ? dLdhIj : dLdhIj + dh[e * dhStride0 + j * dhStride1];
+
+                const T dzc = grad * (static_cast<T>(1) - u) * (static_cast<T>(1) - c * c);
+                const T dzu = grad * (hp[e * hStride0 + j * hStride1] - c) * u * (static_cast<T>(1) - u);
+                const T dzr = dzc * hWc[e * cStride0 + j * cStride1] * r * (static_cast<T>(1) - r);
+
+                dzRow[j * dzStride1]              = dzr;
+                dzRow[(nOut + j) * dzStride1]     = dzu;
+                dzRow[(2 * nOut + j) * dzStride1] = dzc;
+
+                dzhRow[j * dzhStride1]              = dzr;
+                dzhRow[(nOut + j) * dzhStride1]     = dzu;
+                dzhRow[(2 * nOut + j) * dzhStride1] = dzc * r;
+
+                dLdhIj = grad * u;
+            }
+        }
+    };
+
+    samediff::Threads::parallel_tad(func, 0, bS);
+}
+
+//////////////////////////////////////////////////////////////////////////
+void gruCellActivations(sd::LaunchContext * context, const NDArray* xProj, const NDArray* hI, NDArray* gates, NDArray* hc, NDArray* h) {
+    BUILD_SINGLE_SELECTOR(h->dataType(), gruCellActivations_, (*xProj, *hI, *gates, hc, *h), FLOAT_TYPES);
+}
+
+//////////////////////////////////////////////////////////////////////////
+void gruCellActivationsBp(sd::LaunchContext * context, const NDArray* hI, const NDArray* gates, const NDArray* hc, const NDArray* dLdh, NDArray* dLdhI, NDArray* dLdz, NDArray* dLdzh) {
+    BUILD_SINGLE_SELECTOR(gates->dataType(), gruCellActivationsBp_, (*hI, *gates, *hc, dLdh, *dLdhI, *dLdz, *dLdzh), FLOAT_TYPES);
+}
+
+}
+}
+}
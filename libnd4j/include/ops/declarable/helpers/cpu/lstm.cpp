@@ -35,6 +35,7 @@
 #include <iterator>
 #include <helpers/MmulHelper.h>
 #include <execution/Threads.h>
+#include <helpers/FiniteGuard.h>
 
 namespace sd 	  {
 namespace ops 	  {
@@ -195,17 +196,29 @@ void lstmBlockCell(const NDArray* xt, const NDArray* cLast, const NDArray* yLast
     if(forgetBias != 0.0)
         zf += forgetBias;
 
+    // tasks run on OpenMP threads, which report non-finite outputs to this op via region
+    FiniteGuard::Region region;
+
     PRAGMA_OMP_PARALLEL
     PRAGMA_OMP_SINGLE
     {
         PRAGMA_OMP_TASK
-        zz.applyTransform(transform::Tanh, *z);      //z = tanh(zz)
+        {
+            FiniteGuard::Scope scope(region);
+            zz.applyTransform(transform::Tanh, *z);      //z = tanh(zz)
+        }
 
         PRAGMA_OMP_TASK
-        zi.applyTransform(transform::Sigmoid, *i);   //i = sigmoid(zi)
+        {
+            FiniteGuard::Scope scope(region);
+            zi.applyTransform(transform::Sigmoid, *i);   //i = sigmoid(zi)
+        }
 
         PRAGMA_OMP_TASK
-        zf.applyTransform(transform::Sigmoid, *f);   //f = sigmoid(zf);
+        {
+            FiniteGuard::Scope scope(region);
+            zf.applyTransform(transform::Sigmoid, *f);   //f = sigmoid(zf);
+        }
     }
 
     if (z->ews() == 1 && i->ews() == 1 && c->ews() == 1 && cLast->ews() == 1 && f->ews() == 1 && h->ews() == 1 &&
@@ -21,6 +21,7 @@
 #include <helpers/MmulHelper.h>
 #include <execution/Threads.h>
 #include <array/NDArrayFactory.h>
+#include <array/TadView.h>
 
 namespace sd {
 namespace ops {
@@ -109,13 +110,16 @@ namespace helpers {
     void qr_(NDArray const* input, NDArray* outputQ, NDArray* outputR, bool const fullMatricies) {
         Nd4jLong lastDim = input->rankOf() - 1;
         Nd4jLong preLastDim = input->rankOf() - 2;
-        ResultSet listOutQ(outputQ->allTensorsAlongDimension({(int)preLastDim, (int)lastDim}));
-        ResultSet listOutR(outputR->allTensorsAlongDimension({(int)preLastDim, (int)lastDim}));
-        ResultSet listInput(input->allTensorsAlongDimension({(int)preLastDim, (int)lastDim}));
+        TadView<T> listOutQ(*outputQ, {(int)preLastDim, (int)lastDim});
+        TadView<T> listOutR(*outputR, {(int)preLastDim, (int)lastDim});
+        TadView<const T> listInput(*input, {(int)preLastDim, (int)lastDim});
         auto batching = PRAGMA_THREADS_FOR {
             for (auto batch = start; batch < stop; batch++) {
-                //qr here
-                qrSingle<T>(listInput.at(batch), listOutQ.at(batch), listOutR.at(batch), fullMatricies);
+                // matrices are materialized one at a time, qrSingle needs NDArray-level ops on them
+                auto matrix = listInput.array(batch);
+                auto q = listOutQ.array(batch);
+                auto r = listOutR.array(batch);
+                qrSingle<T>(&matrix, &q, &r, fullMatricies);
             }
         };
 
@@ -0,0 +1,86 @@
+/*******************************************************************************
+ * Copyright (c) 2020 Konduit K.K.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+
+#include <ops/declarable/helpers/rnn.h>
+#include <execution/Threads.h>
+
+namespace sd 	  {
+namespace ops 	  {
+namespace helpers {
+
+//////////////////////////////////////////////////////////////////////////
+template <typename T>
+static void rnnMaskedStep_(const NDArray& xProj, const NDArray& seqLengths, const int t, const bool forward, NDArray& hStep, NDArray& h, NDArray& hFinal) {
+
+    const int bS = hStep.sizeAt(0);
+    const int nU = hStep.sizeAt(1);
+
+    const T*   xp   = xProj.bufferAsT<T>();
+    const int* lens = seqLengths.bufferAsT<int>();
+          T*   hs   = hStep.bufferAsT<T>();
+          T*   hp   = h.bufferAsT<T>();
+          T*   hf   = hFinal.bufferAsT<T>();
+
+    const Nd4jLong* xStrides = xProj.stridesOf();
+    const Nd4jLong* hStrides = h.stridesOf();
+    const Nd4jLong sStride0 = hStep.stridesOf()[0],  sStride1 = hStep.stridesOf()[1];
+    const Nd4jLong fStride0 = hFinal.stridesOf()[0], fStride1 = hFinal.stridesOf()[1];
+    const Nd4jLong lStride  = seqLengths.stridesOf()[0];
+
+    auto func = PRAGMA_THREADS_FOR {
+        for (auto e = start; e < stop; e++) {
+
+            const int len = lens[e * lStride];
+            T* sRow = hs + e * sStride0;
+
+            if (t >= len) {
+                // sequence is over: padded step of h is zero, and so is scratch row, so that it stays bounded in following gemms
+                T* hRow = hp + t * hStrides[0] + e * hStrides[1];
+                for (int j = 0; j < nU; ++j) {
+                    hRow[j * hStrides[2]] = static_cast<T>(0);
+                    sRow[j * sStride1] = static_cast<T>(0);
+                }
+                continue;
+            }
+
+            const int s = forward ? t : len - 1 - t;
+            const T* xRow = xp + s * xStrides[0] + e * xStrides[1];
+                  T* hRow = hp + s * hStrides[0] + e * hStrides[1];
+                  T* fRow = t == len - 1 ? hf + e * fStride0 : nullptr;
+
+            for (int j = 0; j < nU; ++j) {
+                const T v = sd::math::nd4j_tanh<T, T>(sRow[j * sStride1] + xRow[j * xStrides[2]]);
+                sRow[j * sStride1] = v;
+                hRow[j * hStrides[2]] = v;
+                if (fRow != nullptr)
+                    fRow[j * fStride1] = v;
+            }
+        }
+    };
+
+    samediff::Threads::parallel_tad(func, 0, bS);
+}
+
+//////////////////////////////////////////////////////////////////////////
+void rnnMaskedStep(sd::LaunchContext * context, const NDArray* xProj, const NDArray* seqLengths, const int t, const bool forward, NDArray* hStep, NDArray* h, NDArray* hFinal) {
+    BUILD_SINGLE_SELECTOR(hStep->dataType(), rnnMaskedStep_, (*xProj, *seqLengths, t, forward, *hStep, *h, *hFinal), FLOAT_TYPES);
+}
+
+}
+}
+}
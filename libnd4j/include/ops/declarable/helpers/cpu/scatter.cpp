@@ -22,6 +22,8 @@
 #include <numeric>
 #include <helpers/ShapeUtils.h>
 #include <execution/Threads.h>
+#include <helpers/CooScatter.h>
+#include <cstring>
 
 namespace sd    {
 namespace ops     {
@@ -111,50 +113,93 @@ void scatter(sd::LaunchContext  *context, pairwise::Ops op, const NDArray& indic
     }
 }
 
+///////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////
+// contiguous output and updates of the same type, op is applied to whole slices in place
+template<typename T>
+static void scatterNDSlices_(pairwise::Ops op, const CooScatter& coo, const NDArray& updates, NDArray& output, const Nd4jLong sliceLen) {
+
+    const T* u = updates.bufferAsT<T>();
+          T* z = output.bufferAsT<T>();
+
+    coo.forEach([&](Nd4jLong row, Nd4jLong index) {
+        const T* uSlice = u + row * sliceLen;
+              T* zSlice = z + index * sliceLen;
+
+        switch (op) {
+            case pairwise::CopyPws:
+                std::memcpy(zSlice, uSlice, sliceLen * sizeof(T));
+                break;
+            case pairwise::Add:
+                PRAGMA_OMP_SIMD
+                for (Nd4jLong e = 0; e < sliceLen; e++)
+                    zSlice[e] += uSlice[e];
+                break;
+            case pairwise::Subtract:
+                PRAGMA_OMP_SIMD
+                for (Nd4jLong e = 0; e < sliceLen; e++)
+                    zSlice[e] -= uSlice[e];
+                break;
+            case pairwise::Multiply:
+                PRAGMA_OMP_SIMD
+                for (Nd4jLong e = 0; e < sliceLen; e++)
+                    zSlice[e] *= uSlice[e];
+                break;
+            default:
+                PRAGMA_OMP_SIMD
+                for (Nd4jLong e = 0; e < sliceLen; e++)
+                    zSlice[e] /= uSlice[e];
+        }
+    });
+}
+
 ///////////////////////////////////////////////////////////////////
 void scatterND(sd::LaunchContext  *context, pairwise::Ops op, const NDArray& indices, const NDArray& updates, NDArray& output, const bool lock) {
 
-    const Nd4jLong indLen = indices.lengthOf();
+    // rows hitting the same output slice are applied by one thread in original order,
+    // so result is deterministic and equal to sequential one regardless of lock
     const int outRank = output.rankOf();
     const int indRank = indices.rankOf();
     const Nd4jLong indLastDim = indices.sizeAt(-1);
 
-    if(outRank == 1) {
-        auto func = PRAGMA_THREADS_FOR {
-            for (auto i = start; i < stop; i++) {
-                Nd4jLong idx = indices.e<Nd4jLong>(i);
-                NDArray out = output({idx, idx + 1});
+    std::vector<Nd4jLong> leadingShape(output.shapeOf(), output.shapeOf() + indLastDim);
+    CooScatter coo(indices, leadingShape);
 
-                out.applyPairwiseTransform(op, updates.e(i), nullptr);
-            }
-        };
+    const Nd4jLong sliceLen = output.lengthOf() / sd::math::nd4j_max<Nd4jLong>(1, shape::prodLong(leadingShape.data(), indLastDim));
 
-        samediff::Threads::parallel_tad(func, 0, indLen, 1, lock ? 1 : sd::Environment::getInstance().maxThreads());
+    const bool fastOp = op == pairwise::CopyPws || op == pairwise::Add || op == pairwise::Subtract || op == pairwise::Multiply || op == pairwise::Divide;
+
+    if (fastOp && !output.isB() && output.dataType() == updates.dataType() && output.ordering() == 'c' && output.ews() == 1 && updates.ordering() == 'c' && updates.ews() == 1) {
+        BUILD_SINGLE_SELECTOR(output.dataType(), scatterNDSlices_, (op, coo, updates, output, sliceLen), NUMERIC_TYPES);
+        return;
+    }
+
+    if(outRank == 1) {
+        coo.forEach([&](Nd4jLong row, Nd4jLong index) {
+            NDArray out = output({index, index + 1});
+
+            out.applyPairwiseTransform(op, updates.e(row), nullptr);
+        });
     }
     else {
-        std::vector<int> dimsToExcludeInd = ShapeUtils::evalDimsToExclude(indRank, {indRank-1});
         std::vector<int> dimsToExcludeUpd(indRank - 1);
         std::iota(dimsToExcludeUpd.begin(), dimsToExcludeUpd.end(), 0);
 
-        auto func = PRAGMA_THREADS_FOR {
+        coo.forEach([&](Nd4jLong row, Nd4jLong index) {
             std::vector<Nd4jLong> idxRangeOut(2*outRank, 0);
+            Nd4jLong coords[MAX_RANK];
+            shape::index2coords(index, indLastDim, leadingShape.data(), coords);
 
-            for (auto i = start; i < stop; i++) {
-                NDArray indSubArr = indices(i, dimsToExcludeInd);
-
-                for (Nd4jLong j = 0; j < indLastDim; ++j) {
-                    idxRangeOut[2 * j] = indSubArr.e<Nd4jLong>(j);
-                    idxRangeOut[2 * j + 1] = idxRangeOut[2 * j] + 1;
-                }
-
-                NDArray outSubArr = output(idxRangeOut);
-                NDArray updSubArr = updates(i, dimsToExcludeUpd);
-
-                outSubArr.applyPairwiseTransform(op, updSubArr);
+            for (Nd4jLong j = 0; j < indLastDim; ++j) {
+                idxRangeOut[2 * j] = coords[j];
+                idxRangeOut[2 * j + 1] = coords[j] + 1;
             }
-        };
 
-        samediff::Threads::parallel_tad(func, 0, indLen / indLastDim, 1, lock ? 1 : sd::Environment::getInstance().maxThreads());
+            NDArray outSubArr = output(idxRangeOut);
+            NDArray updSubArr = updates(row, dimsToExcludeUpd);
+
+            outSubArr.applyPairwiseTransform(op, updSubArr);
+        });
     }
 }
 
@@ -22,12 +22,88 @@
 #include <ops/declarable/helpers/segment.h>
 #include <helpers/ShapeUtils.h>
 #include <execution/Threads.h>
+#include <array/TadView.h>
 #include <unordered_map>
 
 namespace sd {
 namespace ops {
 namespace helpers {
 
+    // rows of sorted segments are reduced into output rows: the first row of every run is copied, following rows of
+    // the same run are combined into it, and finalize(value, runLength) is applied once the run ends.
+    // threads split row elements, so every thread walks all rows over its own slice and no synchronization is needed
+    template <typename T, typename C, typename F>
+    static void segmentReduceRows_(NDArray* input, NDArray* indices, NDArray* output, C combine, F finalize) {
+        auto restDims = ShapeUtils::evalDimsToExclude(input->rankOf(), {0});
+
+        TadView<const T> rows(*input, restDims);
+        TadView<T> outRows(*output, restDims);
+
+        std::vector<Nd4jLong> ids(indices->lengthOf());
+        for (Nd4jLong e = 0; e < indices->lengthOf(); e++)
+            ids[e] = indices->e<Nd4jLong>(e);
+
+        const Nd4jLong numOfRows = ids.size();
+
+        auto func = PRAGMA_THREADS_FOR {
+            Nd4jLong runStart = 0;
+
+            for (Nd4jLong i = 0; i < numOfRows; i++) {
+                const bool first = i == 0 || ids[i] != ids[i - 1];
+                const bool last = i == numOfRows - 1 || ids[i] != ids[i + 1];
+
+                if (first)
+                    runStart = i;
+
+                for (auto e = start; e < stop; e++) {
+                    auto &z = outRows(ids[i], e);
+                    T v = first ? rows(i, e) : combine(z, rows(i, e));
+
+                    z = last ? finalize(v, i - runStart + 1) : v;
+                }
+            }
+        };
+
+        samediff::Threads::parallel_for(func, 0, rows.tadLength());
+    }
+
+    // unsorted counterpart: rows are grouped by segment id first, and threads split segments
+    template <typename T, typename C, typename F>
+    static void unsortedSegmentReduceRows_(NDArray* input, const MAP_IMPL<Nd4jLong, std::vector<Nd4jLong>>& idxs, NDArray* output, C combine, F finalize) {
+        auto restDims = ShapeUtils::evalDimsToExclude(input->rankOf(), {0});
+
+        TadView<const T> rows(*input, restDims);
+        TadView<T> outRows(*output, restDims);
+
+        std::vector<std::pair<Nd4jLong, const std::vector<Nd4jLong>*>> segments;
+        for (auto fi = idxs.begin(); fi != idxs.end(); ++fi)
+            segments.emplace_back(fi->first, &fi->second);
+
+        const Nd4jLong len = rows.tadLength();
+
+        auto func = PRAGMA_THREADS_FOR {
+            for (auto s = start; s < stop; s++) {
+                const auto segment = segments[s].first;
+                const auto &members = *segments[s].second;
+
+                for (Nd4jLong e = 0; e < len; e++) {
+                    T v = rows(members[0], e);
+                    for (size_t idx = 1; idx < members.size(); ++idx)
+                        v = combine(v, rows(members[idx], e));
+
+                    outRows(segment, e) = finalize(v, members.size());
+                }
+            }
+        };
+
+        samediff::Threads::parallel_tad(func, 0, segments.size());
+    }
+
+    template <typename T>
+    static FORCEINLINE T segmentIdentity_(T value, Nd4jLong count) {
+        return value;
+    }
+
     // segment max
     template <typename T>
     static void segmentMaxFunctor_(NDArray* input, NDArray* indices, NDArray* output) {
@@ -50,31 +126,7 @@ namespace helpers {
             }
         }
         else {
-            std::vector<int> restDims = ShapeUtils::evalDimsToExclude(input->rankOf(), {0});
-            auto listOfTensors = input->allTensorsAlongDimension(restDims);
-            auto listOfOutTensors = output->allTensorsAlongDimension(restDims);
-
-            auto numOfClasses = output->sizeAt(0); // number of classes
-            std::vector<std::pair<NDArray*, int>> outputs(numOfClasses);
-            auto maxT = listOfOutTensors.at(idx);
-
-            //int pos = 0;
-            maxT->assign(listOfTensors.at(0));
-
-            for (Nd4jLong i = 1; i < indices->lengthOf(); i++) {
-                if (indices->e<int>(i) == idx) {
-
-                    for (Nd4jLong e = 0; e < maxT->lengthOf(); e++) {
-                       maxT->r<T>(e) = sd::math::nd4j_max(maxT->t<T>(e), listOfTensors.at(i)->t<T>(e));
-                    }
-                }
-                else {
-                    idx = indices->e<Nd4jLong>(i);
-                    maxT = listOfOutTensors.at(idx);
-                    maxT->assign(listOfTensors.at(i));
-                }
-
-            }
+            segmentReduceRows_<T>(input, indices, output, [](T a, T b) -> T { return sd::math::nd4j_max<T>(a, b); }, segmentIdentity_<T>);
         }
     }
 
@@ -100,31 +152,7 @@ namespace helpers {
             }
         }
         else {
-            auto restDims = ShapeUtils::evalDimsToExclude(input->rankOf(), {0});
-
-            ResultSet listOfTensors = input->allTensorsAlongDimension(restDims);
-            ResultSet listOfOutTensors = output->allTensorsAlongDimension(restDims);
-
-            int numOfClasses = output->sizeAt(0); // number of classes
-            std::vector<std::pair<NDArray*, int>> outputs(numOfClasses);
-            auto minT = listOfOutTensors.at(idx);
-
-            int pos = 0;
-            minT->assign(listOfTensors.at(0));
-
-            for (Nd4jLong i = 1; i < indices->lengthOf(); i++) {
-                if (indices->e<Nd4jLong>(i) == idx) {
-
-                    for (Nd4jLong e = 0; e < minT->lengthOf(); e++) {
-                       minT->p(e, sd::math::nd4j_min(minT->e<T>(e), listOfTensors.at(i)->e<T>(e)));
-                    }
-                }
-                else {
-                    idx = indices->e<Nd4jLong>(i);
-                    minT = listOfOutTensors.at(idx);
-                    minT->assign(listOfTensors.at(i));
-                }
-            }
+            segmentReduceRows_<T>(input, indices, output, [](T a, T b) -> T { return sd::math::nd4j_min<T>(a, b); }, segmentIdentity_<T>);
         }
     }
 
@@ -154,39 +182,7 @@ namespace helpers {
             }
         }
         else {
-            auto restDims = ShapeUtils::evalDimsToExclude(input->rankOf(), {0});
-
-            auto listOfTensors = input->allTensorsAlongDimension(restDims);
-            auto listOfOutTensors = output->allTensorsAlongDimension(restDims);
-
-            int numOfClasses = output->sizeAt(0); // number of classes
-            std::vector<std::pair<NDArray*, int>> outputs(numOfClasses);
-            auto meanT = listOfOutTensors.at(idx);
-            int count = 1;
-            auto meanV = meanT->dup();
-            meanV.assign(listOfTensors.at(0));
-
-            for (Nd4jLong i = 1; i < indices->lengthOf(); i++) {
-                if (indices->e<int>(i) == idx) {
-                    auto func = PRAGMA_THREADS_FOR {
-                        for (auto e = start; e < stop; e++) {
-                            meanV.p<T>(e, meanV.e<T>(e) + listOfTensors.at(i)->e<T>(e));
-                        }
-                    };
-                    samediff::Threads::parallel_for(func, 0, meanT->lengthOf());
-
-                    count++;
-                }
-                else {
-                    //meanT->assign(meanV);
-                    meanV.applyScalar(scalar::Divide, count, *meanT);
-                    idx = indices->e<int>(i);
-                    meanT = listOfOutTensors.at(idx);
-                    meanV.assign(listOfTensors.at(i));
-                    count = 1;
-                }
-                meanV.applyScalar(scalar::Divide, count, *meanT);
-            }
+            segmentReduceRows_<T>(input, indices, output, [](T a, T b) -> T { return a + b; }, [](T v, Nd4jLong count) -> T { return v / static_cast<T>(count); });
         }
     }
 
@@ -211,30 +207,7 @@ namespace helpers {
             }
         }
         else {
-            auto restDims = ShapeUtils::evalDimsToExclude(input->rankOf(), {0});
-
-            auto listOfTensors = input->allTensorsAlongDimension(restDims);
-            auto listOfOutTensors = output->allTensorsAlongDimension(restDims);
-
-            int numOfClasses = output->sizeAt(0); // number of classes
-            std::vector<std::pair<NDArray*, int>> outputs(numOfClasses);
-            auto sumT = listOfOutTensors.at(idx);
-
-            for (Nd4jLong i = 0; i < indices->lengthOf(); i++) {
-                if (indices->e<int>(i) == idx) {
-                    auto func = PRAGMA_THREADS_FOR {
-                        for (auto e = start; e < stop; e++) {
-                            sumT->p(e, sumT->e<T>(e) + listOfTensors.at(i)->e<T>(e));
-                        }
-                    };
-                    samediff::Threads::parallel_for(func, 0, sumT->lengthOf());
-                }
-                else {
-                    idx = indices->e<int>(i);
-                    sumT = listOfOutTensors.at(idx);
-                    sumT->assign(listOfTensors.at(i));
-                }
-            }
+            segmentReduceRows_<T>(input, indices, output, [](T a, T b) -> T { return a + b; }, segmentIdentity_<T>);
         }
     }
 
@@ -261,29 +234,7 @@ namespace helpers {
             }
         }
         else {
-            auto restDims = ShapeUtils::evalDimsToExclude(input->rankOf(), {0});
-
-            auto listOfTensors = input->allTensorsAlongDimension(restDims);
-            auto listOfOutTensors = output->allTensorsAlongDimension(restDims);
-
-            int numOfClasses = output->sizeAt(0); // number of classes
-            auto sumT = listOfOutTensors.at(idx);
-            sumT->assign(listOfTensors.at(0));
-            for (Nd4jLong i = 1; i < indices->lengthOf(); i++) {
-                if (indices->e<int>(i)  == idx) {
-                    auto func = PRAGMA_THREADS_FOR {
-                        for (auto e = start; e < stop; e++) {
-                            sumT->p(e, sumT->e<T>(e) * listOfTensors.at(i)->e<T>(e));
-                        }
-                    };
-                    samediff::Threads::parallel_for(func, 0, sumT->lengthOf());
-                }
-                else {
-                    idx = indices->e<int>(i);
-                    sumT = listOfOutTensors.at(idx);
-                    sumT->assign(listOfTensors.at(i));
-                }
-            }
+            segmentReduceRows_<T>(input, indices, output, [](T a, T b) -> T { return a * b; }, segmentIdentity_<T>);
         }
     }
 
@@ -369,26 +320,10 @@ namespace helpers {
             }
         }
         else {
-            auto restDims = ShapeUtils::evalDimsToExclude(input->rankOf(), {0});
-
-            ResultSet listOfTensors = input->allTensorsAlongDimension(restDims);
-            ResultSet listOfOutTensors = output->allTensorsAlongDimension(restDims);
-
             T maxVal = DataTypeUtils::max<T>();
             output->assign(-maxVal);
 
-            for (auto fi = idxs.begin(); fi != idxs.end(); ++fi) {
-                auto outputT = listOfOutTensors.at(fi->first);
-                outputT->assign(listOfTensors.at(fi->second.at(0)));
-                for (Nd4jLong idx = 1; idx < static_cast<Nd4jLong>(fi->second.size()); ++idx) {
-                    auto maxT = listOfTensors.at(fi->second.at(idx));
-                    for (Nd4jLong e = 0; e < outputT->lengthOf(); ++e) {
-                        T val = sd::math::nd4j_max(maxT->e<T>(e), outputT->e<T>(e));
-
-                        outputT->p(e, val);
-                    }
-                }
-            }
+            unsortedSegmentReduceRows_<T>(input, idxs, output, [](T a, T b) -> T { return sd::math::nd4j_max<T>(a, b); }, segmentIdentity_<T>);
         }
     }
     void unsortedSegmentMaxFunctor(sd::LaunchContext * context, NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output) {
@@ -421,26 +356,10 @@ namespace helpers {
             }
         }
         else {
-            auto restDims = ShapeUtils::evalDimsToExclude(input->rankOf(), {0});
-
-            ResultSet listOfTensors = input->allTensorsAlongDimension(restDims);
-            ResultSet listOfOutTensors = output->allTensorsAlongDimension(restDims);
-
             T maxVal = DataTypeUtils::max<T>();
             output->assign(maxVal);
 
-            for (auto fi = idxs.begin(); fi != idxs.end(); ++fi) {
-                auto outputT = listOfOutTensors.at(fi->first);
-                outputT->assign(listOfTensors.at(fi->second.at(0)));
-                for (size_t idx = 1; idx < fi->second.size(); ++idx) {
-                    auto minT = listOfTensors.at(fi->second.at(idx));
-
-                    for (Nd4jLong e = 0; e < outputT->lengthOf(); ++e) {
-                        outputT->r<T>(e) = sd::math::nd4j_min(minT->t<T>(e), outputT->t<T>(e));
-                    }
-                }
-                //outputT->assign(maxT);
-            }
+            unsortedSegmentReduceRows_<T>(input, idxs, output, [](T a, T b) -> T { return sd::math::nd4j_min<T>(a, b); }, segmentIdentity_<T>);
         }
 
     }
@@ -552,20 +471,7 @@ namespace helpers {
             }
         }
         else {
-            auto restDims = ShapeUtils::evalDimsToExclude(input->rankOf(), {0});
-
-            ResultSet listOfTensors = input->allTensorsAlongDimension(restDims);
-            ResultSet listOfOutTensors = output->allTensorsAlongDimension(restDims);
-
-            for (auto fi = idxs.begin(); fi != idxs.end(); ++fi) {
-                auto outputT = listOfOutTensors.at(fi->first);
-                outputT->assign(listOfTensors.at(fi->second.at(0)));
-                for (size_t idx = 1; idx < fi->second.size(); ++idx) {
-                    auto current = listOfTensors.at(fi->second.at(idx));
-
-                    *outputT *= *current;
-                }
-            }
+            unsortedSegmentReduceRows_<T>(input, idxs, output, [](T a, T b) -> T { return a * b; }, segmentIdentity_<T>);
         }
     }
 
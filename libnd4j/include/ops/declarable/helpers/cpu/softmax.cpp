@@ -24,6 +24,7 @@
 #include <numeric>
 #include <helpers/ConstantTadHelper.h>
 #include <execution/Threads.h>
+#include <helpers/MixedPrecision.h>
 
 namespace sd {
     namespace ops {
@@ -172,6 +173,35 @@ namespace sd {
                 samediff::Threads::parallel_tad(func,0, numOfSubArrs);
             }
 
+//////////////////////////////////////////////////////////////////////////
+            // fp32 accumulation for HALF/BFLOAT16: exp is evaluated twice, so output is rounded only once
+            // inOffsets/outOffsets are offsets within sub-array, nullptr means ews == 1
+            template <typename T>
+            static void softmaxFp32_(const T *input, T *output, const Nd4jLong *tadOffsets, const Nd4jLong numOfSubArrs, const uint tadLen, const Nd4jLong *inOffsets, const Nd4jLong *outOffsets) {
+                auto func = PRAGMA_THREADS_FOR {
+                    for (auto i = start; i < stop; i++) {
+                        auto inBuff = input + tadOffsets[i];
+                        auto outBuff = output + tadOffsets[i];
+
+                        float max = -DataTypeUtils::max<float>();
+                        float sum = 0.f;
+
+                        for (uint j = 0; j < tadLen; ++j)
+                            max = sd::math::nd4j_max<float>(max, static_cast<float>(inBuff[inOffsets == nullptr ? j : inOffsets[j]]));
+
+                        for (uint j = 0; j < tadLen; ++j)
+                            sum += sd::math::nd4j_exp<float, float>(static_cast<float>(inBuff[inOffsets == nullptr ? j : inOffsets[j]]) - max);
+
+                        for (uint j = 0; j < tadLen; ++j) {
+                            auto e = sd::math::nd4j_exp<float, float>(static_cast<float>(inBuff[inOffsets == nullptr ? j : inOffsets[j]]) - max);
+                            outBuff[outOffsets == nullptr ? j : outOffsets[j]] = static_cast<T>(e / sum);
+                        }
+                    }
+                };
+
+                samediff::Threads::parallel_tad(func, 0, numOfSubArrs);
+            }
+
 //////////////////////////////////////////////////////////////////////////
             template <typename T>
             static void softmax_(sd::LaunchContext * context, const NDArray& input, NDArray& output, const int dimension) {
@@ -180,8 +210,17 @@ namespace sd {
 
                 if(input.isVector()) {
 
-                    if(rank == 1 || input.sizeAt(dimension) != 1)
-                        softMaxForVector_<T>(input.buffer(), input.shapeInfo(), output.buffer(), output.shapeInfo());
+                    if(rank == 1 || input.sizeAt(dimension) != 1) {
+                        if (MixedPrecision::upcast(input.dataType())) {
+                            const Nd4jLong zero = 0;
+                            std::vector<Nd4jLong> inOffsets(input.lengthOf()), outOffsets(output.lengthOf());
+                            shape::calcOffsets(input.shapeInfo(), inOffsets.data());
+                            shape::calcOffsets(output.shapeInfo(), outOffsets.data());
+
+                            softmaxFp32_<T>(input.bufferAsT<T>(), output.bufferAsT<T>(), &zero, 1, input.lengthOf(), inOffsets.data(), outOffsets.data());
+                        } else
+                            softMaxForVector_<T>(input.buffer(), input.shapeInfo(), output.buffer(), output.shapeInfo());
+                    }
                     else
                         output = 1.;
                 }
@@ -193,7 +232,17 @@ namespace sd {
                     const uint numOfSubArrs = tadPack.numberOfTads();
                     const uint tadLen       = shape::length(tadShapeInfo);
 
-                    if(shape::elementWiseStride(tadShapeInfo) == 1){
+                    if (MixedPrecision::upcast(input.dataType())) {
+                        std::vector<Nd4jLong> offsets;
+                        if (shape::elementWiseStride(tadShapeInfo) != 1) {
+                            offsets.resize(tadLen);
+                            shape::calcOffsets(tadShapeInfo, offsets.data());
+                        }
+
+                        auto ptr = offsets.empty() ? nullptr : offsets.data();
+                        softmaxFp32_<T>(input.bufferAsT<T>(), output.bufferAsT<T>(), tadOffsets, numOfSubArrs, tadLen, ptr, ptr);
+                    }
+                    else if(shape::elementWiseStride(tadShapeInfo) == 1){
                         auto inBuff = input.bufferAsT<T>();
                         T *outBuff = output.bufferAsT<T>();
 
@@ -0,0 +1,58 @@
+/*******************************************************************************
+ * Copyright (c) 2020 Konduit K.K.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+#include <ops/declarable/helpers/attention.h>
+#include <ops/declarable/CustomOperations.h>
+#include <helpers/AttentionHelper.h>
+#include <helpers/MmulHelper.h>
+
+namespace sd {
+namespace ops {
+namespace helpers {
+
+//////////////////////////////////////////////////////////////////////////
+// there is no fused kernel on cuda yet: projections and attention go through existing ops, only output projection is written to output directly
+void multiHeadAttention(sd::LaunchContext* context, const NDArray& queries, const NDArray& keys, const NDArray& values, const NDArray& Wq, const NDArray& Wk, const NDArray& Wv, const NDArray& Wo, const NDArray* mask, NDArray& output, const bool normalization) {
+
+    const Nd4jLong bS = queries.sizeAt(0);
+
+    auto projectedQueries = AttentionHelper::multiHeadProject(&queries, &Wq, context);      // [bS, numHeads, hK, qT]
+    auto projectedKeys    = AttentionHelper::multiHeadProject(&keys, &Wk, context);         // [bS, numHeads, hK, kT]
+    auto projectedValues  = AttentionHelper::multiHeadProject(&values, &Wv, context);       // [bS, numHeads, hV, kT]
+
+    NDArray attn('c', {bS, projectedValues.sizeAt(1), projectedValues.sizeAt(2), projectedQueries.sizeAt(3)}, output.dataType(), context);
+
+    std::vector<NDArray*> inputs = {&projectedQueries, &projectedKeys, &projectedValues};
+    if (mask != nullptr)
+        inputs.push_back(const_cast<NDArray*>(mask));
+
+    sd::ops::dot_product_attention attention;
+    attention.execute(inputs, {&attn}, {}, {normalization ? 1 : 0, 0}, {});
+
+    attn.reshapei({bS, attn.sizeAt(1) * attn.sizeAt(2), attn.sizeAt(3)});
+
+    const NDArray WoT = Wo.transpose();
+    for (Nd4jLong b = 0; b < bS; ++b) {
+        auto a = attn(b, {0});
+        auto z = output(b, {0});
+        MmulHelper::mmul(&WoT, &a, &z, 1.0, 0.0);
+    }
+}
+
+}
+}
+}
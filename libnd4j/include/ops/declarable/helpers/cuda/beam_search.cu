@@ -0,0 +1,266 @@
+/*******************************************************************************
+ * Copyright (c) 2020 Konduit K.K.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+#include <ops/declarable/helpers/beam_search.h>
+#include <helpers/PointersManager.h>
+
+namespace sd {
+namespace ops {
+namespace helpers {
+
+//////////////////////////////////////////////////////////////////////////
+template <typename T>
+__global__ static void beamSearchStepCuda(const void* vx, const Nd4jLong* xShapeInfo, const void* vs, const Nd4jLong* sShapeInfo,
+                                          const void* vf, const Nd4jLong* fShapeInfo, const void* vl, const Nd4jLong* lShapeInfo,
+                                          void* vzs, const Nd4jLong* zsShapeInfo, void* vzt, const Nd4jLong* ztShapeInfo, void* vzp, const Nd4jLong* zpShapeInfo,
+                                          void* vzf, const Nd4jLong* zfShapeInfo, void* vzl, const Nd4jLong* zlShapeInfo,
+                                          const int eosId, const double alpha) {
+
+    // one block per batch item, beamWidth best candidates are picked by beamWidth rounds of block-wide argmax
+
+    const T*    x = reinterpret_cast<const T*>(vx);
+    const T*    s = reinterpret_cast<const T*>(vs);
+    const bool* f = reinterpret_cast<const bool*>(vf);
+    const int*  l = reinterpret_cast<const int*>(vl);
+
+    __shared__ int beam, vocab;
+    __shared__ Nd4jLong *selected, *redIdx, *prevLengths;
+    __shared__ T *redKey, *logSum, *penalty, *prevScores;
+    __shared__ bool *prevFinished;
+
+    if (threadIdx.x == 0) {
+        extern __shared__ unsigned char shmem[];
+
+        beam  = shape::sizeAt(xShapeInfo, 1);
+        vocab = shape::sizeAt(xShapeInfo, 2);
+
+        selected     = reinterpret_cast<Nd4jLong*>(shmem);
+        redIdx       = selected + beam;
+        prevLengths  = redIdx + blockDim.x;
+        redKey       = reinterpret_cast<T*>(prevLengths + beam);
+        logSum       = redKey + blockDim.x;
+        penalty      = logSum + beam;
+        prevScores   = penalty + beam;
+        prevFinished = reinterpret_cast<bool*>(prevScores + beam);
+    }
+    __syncthreads();
+
+    const auto b = blockIdx.x;
+    const T minusInf = -DataTypeUtils::infOrMax<T>();
+
+    const Nd4jLong* xStrides = shape::stride(xShapeInfo);
+
+    // previous state is copied out first, since finished and lengths may be updated in place
+    for (int k = threadIdx.x; k < beam; k += blockDim.x) {
+        prevScores[k]   = s[b * shape::stride(sShapeInfo)[0] + k * shape::stride(sShapeInfo)[1]];
+        prevFinished[k] = f[b * shape::stride(fShapeInfo)[0] + k * shape::stride(fShapeInfo)[1]];
+        prevLengths[k]  = l[b * shape::stride(lShapeInfo)[0] + k * shape::stride(lShapeInfo)[1]];
+
+        const Nd4jLong length = prevFinished[k] ? prevLengths[k] : prevLengths[k] + 1;
+        penalty[k] = alpha == 0. ? static_cast<T>(1) : static_cast<T>(sd::math::nd4j_pow<double, double, double>((5. + length) / 6., alpha));
+    }
+    __syncthreads();
+
+    // log-sum-exp of every live beam row
+    for (int k = 0; k < beam; ++k) {
+
+        if (prevFinished[k])
+            continue;
+
+        const T* row = x + b * xStrides[0] + k * xStrides[1];
+
+        T max = minusInf;
+        for (int v = threadIdx.x; v < vocab; v += blockDim.x)
+            max = sd::math::nd4j_max<T>(max, row[v * xStrides[2]]);
+
+        redKey[threadIdx.x] = max;
+        __syncthreads();
+
+        for (int activeThreads = blockDim.x / 2; activeThreads > 0; activeThreads /= 2) {
+            if (threadIdx.x < activeThreads)
+                redKey[threadIdx.x] = sd::math::nd4j_max<T>(redKey[threadIdx.x], redKey[threadIdx.x + activeThreads]);
+            __syncthreads();
+        }
+
+        max = redKey[0];
+        __syncthreads();
+
+        T sum = static_cast<T>(0);
+        if (max != minusInf)
+            for (int v = threadIdx.x; v < vocab; v += blockDim.x)
+                sum += sd::math::nd4j_exp<T, T>(row[v * xStrides[2]] - max);
+
+        redKey[threadIdx.x] = sum;
+        __syncthreads();
+
+        for (int activeThreads = blockDim.x / 2; activeThreads > 0; activeThreads /= 2) {
+            if (threadIdx.x < activeThreads)
+                redKey[threadIdx.x] += redKey[threadIdx.x + activeThreads];
+            __syncthreads();
+        }
+
+        if (threadIdx.x == 0)
+            logSum[k] = max == minusInf ? minusInf : max + sd::math::nd4j_log<T, T>(redKey[0]);      // every token of this beam is masked out
+        __syncthreads();
+    }
+
+    const Nd4jLong len = static_cast<Nd4jLong>(beam) * vocab;
+
+    for (int j = 0; j < beam; ++j) {
+
+        T bestKey = minusInf;
+        Nd4jLong bestIdx = -1;
+
+        // candidates are visited in increasing flat index order, so ties are resolved towards lower beam and token id
+        for (Nd4jLong i = threadIdx.x; i < len; i += blockDim.x) {
+
+            const int k = i / vocab;
+            const int v = i % vocab;
+
+            if (prevFinished[k] && v != eosId)
+                continue;
+
+            bool taken = false;
+            for (int m = 0; m < j && !taken; ++m)
+                taken = selected[m] == i;
+            if (taken)
+                continue;
+
+            T score = prevScores[k];
+            if (!prevFinished[k])
+                score = logSum[k] == minusInf ? minusInf : score + (x[b * xStrides[0] + k * xStrides[1] + v * xStrides[2]] - logSum[k]);
+
+            const T key = score / penalty[k];
+            if (bestIdx < 0 || key > bestKey) {
+                bestKey = key;
+                bestIdx = i;
+            }
+        }
+
+        redKey[threadIdx.x] = bestKey;
+        redIdx[threadIdx.x] = bestIdx;
+        __syncthreads();
+
+        for (int activeThreads = blockDim.x / 2; activeThreads > 0; activeThreads /= 2) {
+            if (threadIdx.x < activeThreads) {
+                const auto other = threadIdx.x + activeThreads;
+                if (redIdx[other] >= 0 && (redIdx[threadIdx.x] < 0 || redKey[other] > redKey[threadIdx.x] || (redKey[other] == redKey[threadIdx.x] && redIdx[other] < redIdx[threadIdx.x]))) {
+                    redKey[threadIdx.x] = redKey[other];
+                    redIdx[threadIdx.x] = redIdx[other];
+                }
+            }
+            __syncthreads();
+        }
+
+        if (threadIdx.x == 0)
+            selected[j] = redIdx[0];
+        __syncthreads();
+    }
+
+    for (int j = threadIdx.x; j < beam; j += blockDim.x) {
+
+        const int k = selected[j] / vocab;
+        const int v = selected[j] % vocab;
+
+        T score = prevScores[k];
+        if (!prevFinished[k])
+            score = logSum[k] == minusInf ? minusInf : score + (x[b * xStrides[0] + k * xStrides[1] + v * xStrides[2]] - logSum[k]);
+
+        reinterpret_cast<T*>(vzs)[b * shape::stride(zsShapeInfo)[0] + j * shape::stride(zsShapeInfo)[1]] = score;
+        reinterpret_cast<int*>(vzt)[b * shape::stride(ztShapeInfo)[0] + j * shape::stride(ztShapeInfo)[1]] = v;
+        reinterpret_cast<int*>(vzp)[b * shape::stride(zpShapeInfo)[0] + j * shape::stride(zpShapeInfo)[1]] = k;
+        reinterpret_cast<bool*>(vzf)[b * shape::stride(zfShapeInfo)[0] + j * shape::stride(zfShapeInfo)[1]] = prevFinished[k] || v == eosId;
+        reinterpret_cast<int*>(vzl)[b * shape::stride(zlShapeInfo)[0] + j * shape::stride(zlShapeInfo)[1]] = prevFinished[k] ? prevLengths[k] : prevLengths[k] + 1;
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////
+template <typename T>
+static void beamSearchStepCudaLauncher(const int blocksPerGrid, const int threadsPerBlock, const int sharedMem, const cudaStream_t *stream,
+                                       const void* vx, const Nd4jLong* xShapeInfo, const void* vs, const Nd4jLong* sShapeInfo,
+                                       const void* vf, const Nd4jLong* fShapeInfo, const void* vl, const Nd4jLong* lShapeInfo,
+                                       void* vzs, const Nd4jLong* zsShapeInfo, void* vzt, const Nd4jLong* ztShapeInfo, void* vzp, const Nd4jLong* zpShapeInfo,
+                                       void* vzf, const Nd4jLong* zfShapeInfo, void* vzl, const Nd4jLong* zlShapeInfo,
+                                       const int eosId, const double alpha) {
+
+    beamSearchStepCuda<T><<<blocksPerGrid, threadsPerBlock, sharedMem, *stream>>>(vx, xShapeInfo, vs, sShapeInfo, vf, fShapeInfo, vl, lShapeInfo, vzs, zsShapeInfo, vzt, ztShapeInfo, vzp, zpShapeInfo, vzf, zfShapeInfo, vzl, zlShapeInfo, eosId, alpha);
+}
+
+//////////////////////////////////////////////////////////////////////////
+void beamSearchStep(sd::LaunchContext* context, const NDArray& logits, const NDArray& scores, const NDArray& finished, const NDArray& lengths,
+                    NDArray& newScores, NDArray& tokens, NDArray& parents, NDArray& newFinished, NDArray& newLengths, const int eosId, const double alpha) {
+
+    const int beam = logits.sizeAt(1);
+
+    PointersManager manager(context, "beamSearchStep");
+
+    const int threadsPerBlock = MAX_NUM_THREADS / 4;        // power of 2, required by block reductions
+    const int blocksPerGrid = logits.sizeAt(0);
+    const int sharedMem = (2 * beam + threadsPerBlock) * sizeof(Nd4jLong) + (threadsPerBlock + 3 * beam) * logits.sizeOfT() + beam * sizeof(bool) + 128;
+
+    NDArray::prepareSpecialUse({&newScores, &tokens, &parents, &newFinished, &newLengths}, {&logits, &scores, &finished, &lengths});
+    BUILD_SINGLE_SELECTOR(logits.dataType(), beamSearchStepCudaLauncher, (blocksPerGrid, threadsPerBlock, sharedMem, context->getCudaStream(), logits.specialBuffer(), logits.specialShapeInfo(), scores.specialBuffer(), scores.specialShapeInfo(), finished.specialBuffer(), finished.specialShapeInfo(), lengths.specialBuffer(), lengths.specialShapeInfo(), newScores.specialBuffer(), newScores.specialShapeInfo(), tokens.specialBuffer(), tokens.specialShapeInfo(), parents.specialBuffer(), parents.specialShapeInfo(), newFinished.specialBuffer(), newFinished.specialShapeInfo(), newLengths.specialBuffer(), newLengths.specialShapeInfo(), eosId, alpha), FLOAT_TYPES);
+    NDArray::registerSpecialUse({&newScores, &tokens, &parents, &newFinished, &newLengths}, {&logits, &scores, &finished, &lengths});
+
+    manager.synchronize();
+}
+
+//////////////////////////////////////////////////////////////////////////
+__global__ static void beamSearchBacktraceCuda(const int* t, const Nd4jLong* tShapeInfo, const int* p, const Nd4jLong* pShapeInfo, int* z, const Nd4jLong* zShapeInfo) {
+
+    // one thread per final beam of every batch item
+
+    const int time = shape::sizeAt(tShapeInfo, 0);
+    const int bS   = shape::sizeAt(tShapeInfo, 1);
+    const int beam = shape::sizeAt(tShapeInfo, 2);
+
+    const auto ind = threadIdx.x + blockIdx.x * blockDim.x;
+    if (ind >= bS * beam)
+        return;
+
+    const int b = ind / beam;
+    const int k = ind % beam;
+
+    const Nd4jLong* tStrides = shape::stride(tShapeInfo);
+    const Nd4jLong* pStrides = shape::stride(pShapeInfo);
+    const Nd4jLong* zStrides = shape::stride(zShapeInfo);
+
+    int beamIdx = k;
+    for (int i = time - 1; i >= 0; --i) {
+        z[b * zStrides[0] + k * zStrides[1] + i * zStrides[2]] = t[i * tStrides[0] + b * tStrides[1] + beamIdx * tStrides[2]];
+        beamIdx = p[i * pStrides[0] + b * pStrides[1] + beamIdx * pStrides[2]];
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////
+void beamSearchBacktrace(sd::LaunchContext* context, const NDArray& tokens, const NDArray& parents, NDArray& sequences) {
+
+    PointersManager manager(context, "beamSearchBacktrace");
+
+    const int threadsPerBlock = MAX_NUM_THREADS / 4;
+    const int blocksPerGrid = (tokens.sizeAt(1) * tokens.sizeAt(2) + threadsPerBlock - 1) / threadsPerBlock;
+
+    NDArray::prepareSpecialUse({&sequences}, {&tokens, &parents});
+    beamSearchBacktraceCuda<<<blocksPerGrid, threadsPerBlock, 0, *context->getCudaStream()>>>(reinterpret_cast<const int*>(tokens.specialBuffer()), tokens.specialShapeInfo(), reinterpret_cast<const int*>(parents.specialBuffer()), parents.specialShapeInfo(), reinterpret_cast<int*>(sequences.specialBuffer()), sequences.specialShapeInfo());
+    NDArray::registerSpecialUse({&sequences}, {&tokens, &parents});
+
+    manager.synchronize();
+}
+
+}
+}
+}
@@ -20,11 +20,20 @@
 #include <ops/declarable/helpers/compression.h>
 #include <loops/type_conversions.h>
 #include <helpers/DebugHelper.h>
+#include <ops/specials.h>
 
 namespace sd {
 namespace ops {
 namespace helpers {
     void decodeBitmap(sd::LaunchContext* context, const NDArray* input, NDArray* output) {
+        // list of positions is sequential by nature, and it's short, so it's decoded on host
+        if (input->e<int>(3) == BITMAP_RLE_ENCODING) {
+            NDArray::preparePrimaryUse({output}, {input}, true);
+            BUILD_SINGLE_SELECTOR(output->dataType(), SpecialMethods, ::decodeBitmapGeneric(input->buffer(), output->lengthOf(), output->buffer(), output->shapeInfo()), FLOAT_TYPES);
+            NDArray::registerPrimaryUse({output}, {input});
+            return;
+        }
+
         auto stream = context->getCudaStream();
         NDArray::prepareSpecialUse({output}, {input});
 
@@ -37,7 +46,11 @@ namespace helpers {
         NDArray::registerSpecialUse({output}, {input});
     }
 
-    Nd4jLong encodeBitmap(sd::LaunchContext* context, NDArray* input, NDArray* output, float threshold) {
+    Nd4jLong encodeBitmap(sd::LaunchContext* context, NDArray* input, NDArray* output, float threshold, bool rle) {
+        // positions list is built on host only, so asking for it here is an error rather than a silent plain bitmap
+        if (rle)
+            throw std::runtime_error("encodeBitmap: BITMAP_RLE_ENCODING isn't supported on CUDA");
+
         auto stream = LaunchContext::defaultContext()->getCudaStream();
         int *resultPointer = reinterpret_cast<int *>(LaunchContext::defaultContext()->getScalarPointer());
         int *reductionPointer = reinterpret_cast<int *>(LaunchContext::defaultContext()->getReductionPointer());
@@ -61,6 +74,124 @@ namespace helpers {
         NDArray::registerSpecialUse({output, input}, {});
         return dZ;
     }
+
+    template <typename T>
+    static __global__ void encodeSignMaskCuda(const void* vx, Nd4jLong length, uint8_t* z, Nd4jLong zLength, bool negative) {
+        auto x = reinterpret_cast<const T*>(vx);
+
+        // each byte is packed by single thread
+        for (Nd4jLong b = blockIdx.x * blockDim.x + threadIdx.x; b < zLength; b += gridDim.x * blockDim.x) {
+            uint8_t byte = 0;
+            auto last = sd::math::nd4j_min<Nd4jLong>(length, (b + 1) * 8);
+            for (auto e = b * 8; e < last; e++)
+                if (negative ? x[e] < static_cast<T>(0.f) : x[e] > static_cast<T>(0.f))
+                    byte |= static_cast<uint8_t>(1 << (e - b * 8));
+
+            z[b] = byte;
+        }
+    }
+
+    template <typename T>
+    static __global__ void decodeSignMaskCuda(const uint8_t* x, void* vz, Nd4jLong length, bool negative) {
+        auto z = reinterpret_cast<T*>(vz);
+        auto one = static_cast<T>(negative ? -1.f : 1.f);
+
+        for (Nd4jLong e = blockIdx.x * blockDim.x + threadIdx.x; e < length; e += gridDim.x * blockDim.x)
+            z[e] = (x[e >> 3] >> (e & 7)) & 1 ? one : static_cast<T>(0.f);
+    }
+
+    template <typename T>
+    static __global__ void quantizeBlocksCuda(const void* vx, Nd4jLong length, int8_t* z, float* scales, int blockSize) {
+        auto x = reinterpret_cast<const T*>(vx);
+
+        __shared__ float amax[512];
+
+        // one CUDA block per quantization block
+        auto first = (Nd4jLong) blockIdx.x * blockSize;
+        auto last = sd::math::nd4j_min<Nd4jLong>(length, first + blockSize);
+
+        float local = 0.f;
+        for (auto e = first + threadIdx.x; e < last; e += blockDim.x)
+            local = sd::math::nd4j_max<float>(local, sd::math::nd4j_abs<float>(static_cast<float>(x[e])));
+
+        amax[threadIdx.x] = local;
+        __syncthreads();
+
+        for (int activeThreads = blockDim.x / 2; activeThreads > 0; activeThreads /= 2) {
+            if (threadIdx.x < activeThreads)
+                amax[threadIdx.x] = sd::math::nd4j_max<float>(amax[threadIdx.x], amax[threadIdx.x + activeThreads]);
+            __syncthreads();
+        }
+
+        auto scale = amax[0] / 127.f;
+        auto inverse = scale > 0.f ? 1.f / scale : 0.f;
+
+        if (threadIdx.x == 0)
+            scales[blockIdx.x] = scale;
+
+        for (auto e = first + threadIdx.x; e < last; e += blockDim.x)
+            z[e] = static_cast<int8_t>(sd::math::nd4j_round<float, float>(static_cast<float>(x[e]) * inverse));
+    }
+
+    template <typename T>
+    static __global__ void dequantizeBlocksCuda(const int8_t* x, const float* scales, void* vz, Nd4jLong length, int blockSize) {
+        auto z = reinterpret_cast<T*>(vz);
+
+        for (Nd4jLong e = blockIdx.x * blockDim.x + threadIdx.x; e < length; e += gridDim.x * blockDim.x)
+            z[e] = static_cast<T>(static_cast<float>(x[e]) * scales[e / blockSize]);
+    }
+
+    template <typename T>
+    static void encodeSignMask_(sd::LaunchContext* context, const NDArray* input, NDArray* output, bool negative) {
+        auto stream = context->getCudaStream();
+        encodeSignMaskCuda<T><<<256, 512, 1024, *stream>>>(input->specialBuffer(), input->lengthOf(), reinterpret_cast<uint8_t*>(output->specialBuffer()), output->lengthOf(), negative);
+    }
+
+    template <typename T>
+    static void decodeSignMask_(sd::LaunchContext* context, const NDArray* input, NDArray* output, bool negative) {
+        auto stream = context->getCudaStream();
+        decodeSignMaskCuda<T><<<256, 512, 1024, *stream>>>(reinterpret_cast<const uint8_t*>(input->specialBuffer()), output->specialBuffer(), output->lengthOf(), negative);
+    }
+
+    template <typename T>
+    static void quantizeBlocks_(sd::LaunchContext* context, const NDArray* input, NDArray* output, NDArray* scales, int blockSize) {
+        auto stream = context->getCudaStream();
+        quantizeBlocksCuda<T><<<scales->lengthOf(), 512, 1024, *stream>>>(input->specialBuffer(), input->lengthOf(), reinterpret_cast<int8_t*>(output->specialBuffer()), reinterpret_cast<float*>(scales->specialBuffer()), blockSize);
+    }
+
+    template <typename T>
+    static void dequantizeBlocks_(sd::LaunchContext* context, const NDArray* input, const NDArray* scales, NDArray* output, int blockSize) {
+        auto stream = context->getCudaStream();
+        dequantizeBlocksCuda<T><<<256, 512, 1024, *stream>>>(reinterpret_cast<const int8_t*>(input->specialBuffer()), reinterpret_cast<const float*>(scales->specialBuffer()), output->specialBuffer(), output->lengthOf(), blockSize);
+    }
+
+    void encodeSignMask(sd::LaunchContext* context, const NDArray* input, NDArray* output, bool negative) {
+        NDArray::prepareSpecialUse({output}, {input});
+        BUILD_SINGLE_SELECTOR(input->dataType(), encodeSignMask_, (context, input, output, negative), FLOAT_TYPES);
+        sd::DebugHelper::checkErrorCode(context->getCudaStream(), "encodeSignMask(...) failed");
+        NDArray::registerSpecialUse({output}, {input});
+    }
+
+    void decodeSignMask(sd::LaunchContext* context, const NDArray* input, NDArray* output, bool negative) {
+        NDArray::prepareSpecialUse({output}, {input});
+        BUILD_SINGLE_SELECTOR(output->dataType(), decodeSignMask_, (context, input, output, negative), FLOAT_TYPES);
+        sd::DebugHelper::checkErrorCode(context->getCudaStream(), "decodeSignMask(...) failed");
+        NDArray::registerSpecialUse({output}, {input});
+    }
+
+    void quantizeBlocks(sd::LaunchContext* context, const NDArray* input, NDArray* output, NDArray* scales, int blockSize) {
+        NDArray::prepareSpecialUse({output, scales}, {input});
+        BUILD_SINGLE_SELECTOR(input->dataType(), quantizeBlocks_, (context, input, output, scales, blockSize), FLOAT_TYPES);
+        sd::DebugHelper::checkErrorCode(context->getCudaStream(), "quantizeBlocks(...) failed");
+        NDArray::registerSpecialUse({output, scales}, {input});
+    }
+
+    void dequantizeBlocks(sd::LaunchContext* context, const NDArray* input, const NDArray* scales, NDArray* output, int blockSize) {
+        NDArray::prepareSpecialUse({output}, {input, scales});
+        BUILD_SINGLE_SELECTOR(output->dataType(), dequantizeBlocks_, (context, input, scales, output, blockSize), FLOAT_TYPES);
+        sd::DebugHelper::checkErrorCode(context->getCudaStream(), "dequantizeBlocks(...) failed");
+        NDArray::registerSpecialUse({output}, {input, scales});
+    }
 }
 }
 }
@@ -0,0 +1,36 @@
+/*******************************************************************************
+ * Copyright (c) 2020 Konduit K.K.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#include <ops/declarable/helpers/convolutions.h>
+#include <ops/declarable/helpers/addBias.h>
+#include <helpers/MmulHelper.h>
+
+namespace sd {
+namespace ops  {
+
+//////////////////////////////////////////////////////////////////////////
+// no fused kernel here yet: bias and activation are applied one after another
+void ConvolutionUtils::biasActivation(sd::graph::Context& block, NDArray& output, const NDArray* bias, const int isNCHW, const GemmEpilogue::Activation activation, const double cutoff) {
+
+    if (bias != nullptr)
+        helpers::addBias(block, output, *bias, output, isNCHW);
+
+    if (activation != GemmEpilogue::NONE)
+        MmulHelper::applyEpilogue(output, output, GemmEpilogue(nullptr, activation, cutoff));
+}
+
+}
+}
@@ -0,0 +1,144 @@
+/*******************************************************************************
+ * Copyright (c) 2020 Konduit K.K.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#include <ops/declarable/helpers/convolutions.h>
+#include <helpers/PointersManager.h>
+
+namespace sd {
+namespace ops  {
+
+//////////////////////////////////////////////////////////////////////////
+template <typename T>
+__global__ static void conv3dDirectCuda(const void* vx, const Nd4jLong* xShapeInfo, const void* vw, void* vz, const Nd4jLong* zShapeInfo,
+                                        const int kD, const int kH, const int kW, const int sD, const int sH, const int sW,
+                                        const int pD, const int pH, const int pW, const int dD, const int dH, const int dW) {
+
+    // x has shape [bS, iD, iH, iW, iC]
+    // w has shape [kD, kH, kW, iC, oC], contiguous
+    // z has shape [bS, oD, oH, oW, oC]
+
+    const T* x = reinterpret_cast<const T*>(vx);
+    const T* w = reinterpret_cast<const T*>(vw);
+          T* z = reinterpret_cast<T*>(vz);
+
+    __shared__ int iD, iH, iW, iC, oC;
+    __shared__ Nd4jLong zLen, *sharedMem;
+
+    if (threadIdx.x == 0) {
+        extern __shared__ unsigned char shmem[];
+        sharedMem = reinterpret_cast<Nd4jLong*>(shmem);
+
+        iD = shape::sizeAt(xShapeInfo, 1);
+        iH = shape::sizeAt(xShapeInfo, 2);
+        iW = shape::sizeAt(xShapeInfo, 3);
+        iC = shape::sizeAt(xShapeInfo, 4);
+        oC = shape::sizeAt(zShapeInfo, 4);
+        zLen = shape::length(zShapeInfo);
+    }
+    __syncthreads();
+
+    const auto zInd = threadIdx.x + blockIdx.x * blockDim.x;
+
+    if(zInd >= zLen)
+        return;
+
+    auto coords = sharedMem + threadIdx.x * 5;
+
+    shape::index2coords(zInd, zShapeInfo, coords);
+
+    const auto zOffset = shape::getOffset(zShapeInfo, coords);
+
+    const int b  = coords[0];
+    const int od = coords[1];
+    const int oh = coords[2];
+    const int ow = coords[3];
+    const int oc = coords[4];
+
+    T sum = static_cast<T>(0);
+
+    for (int kd = 0; kd < kD; ++kd) {
+        const int id = od * sD - pD + kd * dD;
+        if (id < 0 || id >= iD)
+            continue;
+
+        for (int kh = 0; kh < kH; ++kh) {
+            const int ih = oh * sH - pH + kh * dH;
+            if (ih < 0 || ih >= iH)
+                continue;
+
+            for (int kw = 0; kw < kW; ++kw) {
+                const int iw = ow * sW - pW + kw * dW;
+                if (iw < 0 || iw >= iW)
+                    continue;
+
+                coords[0] = b;
+                coords[1] = id;
+                coords[2] = ih;
+                coords[3] = iw;
+
+                const T* wIn = w + ((kd * kH + kh) * kW + kw) * iC * oC + oc;
+
+                for (int ic = 0; ic < iC; ++ic) {
+                    coords[4] = ic;
+                    sum += x[shape::getOffset(xShapeInfo, coords)] * wIn[ic * oC];
+                }
+            }
+        }
+    }
+
+    z[zOffset] = sum;
+}
+
+//////////////////////////////////////////////////////////////////////////
+template <typename T>
+static void conv3dDirectCudaLauncher(const int blocksPerGrid, const int threadsPerBlock, const int sharedMem, const cudaStream_t *stream,
+                                     const void* vx, const Nd4jLong* xShapeInfo, const void* vw,
+                                           void* vz, const Nd4jLong* zShapeInfo,
+                                     const int kD, const int kH, const int kW, const int sD, const int sH, const int sW,
+                                     const int pD, const int pH, const int pW, const int dD, const int dH, const int dW) {
+
+    conv3dDirectCuda<T><<<blocksPerGrid, threadsPerBlock, sharedMem, *stream>>>(vx, xShapeInfo, vw, vz, zShapeInfo, kD, kH, kW, sD, sH, sW, pD, pH, pW, dD, dH, dW);
+}
+
+//////////////////////////////////////////////////////////////////////////
+void ConvolutionUtils::conv3dDirect(sd::graph::Context& block, const NDArray* input, const NDArray* weights, NDArray* output, const int kD, const int kH, const int kW, const int sD, const int sH, const int sW, const int pD, const int pH, const int pW, const int dD, const int dH, const int dW, const int wFormat) {
+
+    // kernel reads weights by plain index, so they're brought to contiguous [kD, kH, kW, iC, oC] once
+    std::vector<int> permut;
+    if(0 == wFormat)
+        permut = {0,1,2,3,4};
+    else if(1 == wFormat)
+        permut = {2,3,4,1,0};                   // [oC, iC, kD, kH, kW] -> [kD, kH, kW, iC, oC]
+    else
+        permut = {1,2,3,4,0};                   // [oC, kD, kH, kW, iC] -> [kD, kH, kW, iC, oC]
+
+    NDArray w = weights->permute(permut).dup('c');
+
+    PointersManager manager(block.launchContext(), "conv3dDirect");
+
+    const int threadsPerBlock = MAX_NUM_THREADS / 2;
+    const int blocksPerGrid = (output->lengthOf() + threadsPerBlock - 1) / threadsPerBlock;
+    const int sharedMem = output->rankOf() * sizeof(Nd4jLong) * threadsPerBlock + 128;
+
+    NDArray::prepareSpecialUse({output}, {input, &w});
+    BUILD_SINGLE_SELECTOR(input->dataType(), conv3dDirectCudaLauncher, (blocksPerGrid, threadsPerBlock, sharedMem, block.launchContext()->getCudaStream(), input->specialBuffer(), input->specialShapeInfo(), w.specialBuffer(), output->specialBuffer(), output->specialShapeInfo(), kD, kH, kW, sD, sH, sW, pD, pH, pW, dD, dH, dW), FLOAT_TYPES);
+    NDArray::registerSpecialUse({output}, {input, &w});
+
+    manager.synchronize();
+}
+
+}
+}
@@ -0,0 +1,155 @@
+/*******************************************************************************
+ * Copyright (c) 2020 Konduit K.K.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#include <ops/declarable/helpers/convolutions.h>
+#include <helpers/PointersManager.h>
+
+namespace sd {
+namespace ops  {
+
+//////////////////////////////////////////////////////////////////////////
+template <typename T>
+__global__ static void deconv2dCuda(const void* vx, const Nd4jLong* xShapeInfo, const void* vw, const void* vb, const Nd4jLong* bShapeInfo, void* vz, const Nd4jLong* zShapeInfo,
+                                    const int kH, const int kW, const int sH, const int sW, const int pH, const int pW, const int dH, const int dW) {
+
+    // x has shape [bS, iC, iH, iW], any strides
+    // w has shape [kH, kW, iC, oC], contiguous
+    // z has shape [bS, oC, oH, oW], any strides
+
+    const T* x = reinterpret_cast<const T*>(vx);
+    const T* w = reinterpret_cast<const T*>(vw);
+    const T* b = reinterpret_cast<const T*>(vb);
+          T* z = reinterpret_cast<T*>(vz);
+
+    __shared__ int iC, iH, iW, oC;
+    __shared__ Nd4jLong zLen, *sharedMem;
+
+    if (threadIdx.x == 0) {
+        extern __shared__ unsigned char shmem[];
+        sharedMem = reinterpret_cast<Nd4jLong*>(shmem);
+
+        iC = shape::sizeAt(xShapeInfo, 1);
+        iH = shape::sizeAt(xShapeInfo, 2);
+        iW = shape::sizeAt(xShapeInfo, 3);
+        oC = shape::sizeAt(zShapeInfo, 1);
+        zLen = shape::length(zShapeInfo);
+    }
+    __syncthreads();
+
+    const auto zInd = threadIdx.x + blockIdx.x * blockDim.x;
+
+    if(zInd >= zLen)
+        return;
+
+    auto coords = sharedMem + threadIdx.x * 4;
+
+    shape::index2coords(zInd, zShapeInfo, coords);
+
+    const auto zOffset = shape::getOffset(zShapeInfo, coords);
+
+    const int oc = coords[1];
+    const int oh = coords[2];
+    const int ow = coords[3];
+
+    T sum = b == nullptr ? static_cast<T>(0) : b[shape::getIndexOffset(oc, bShapeInfo)];
+
+    // every thread gathers its own output pixel, so there are no write conflicts
+    for (int kh = 0; kh < kH; ++kh) {
+        const int hPos = oh + pH - kh * dH;
+        if (hPos < 0 || hPos % sH != 0 || hPos / sH >= iH)
+            continue;
+
+        for (int kw = 0; kw < kW; ++kw) {
+            const int wPos = ow + pW - kw * dW;
+            if (wPos < 0 || wPos % sW != 0 || wPos / sW >= iW)
+                continue;
+
+            coords[2] = hPos / sH;
+            coords[3] = wPos / sW;
+
+            const T* wIn = w + (kh * kW + kw) * iC * oC + oc;
+
+            for (int ic = 0; ic < iC; ++ic) {
+                coords[1] = ic;
+                sum += x[shape::getOffset(xShapeInfo, coords)] * wIn[ic * oC];
+            }
+        }
+    }
+
+    z[zOffset] = sum;
+}
+
+//////////////////////////////////////////////////////////////////////////
+template <typename T>
+static void deconv2dCudaLauncher(const int blocksPerGrid, const int threadsPerBlock, const int sharedMem, const cudaStream_t *stream,
+                                 const void* vx, const Nd4jLong* xShapeInfo, const void* vw, const void* vb, const Nd4jLong* bShapeInfo,
+                                       void* vz, const Nd4jLong* zShapeInfo,
+                                 const int kH, const int kW, const int sH, const int sW, const int pH, const int pW, const int dH, const int dW) {
+
+    deconv2dCuda<T><<<blocksPerGrid, threadsPerBlock, sharedMem, *stream>>>(vx, xShapeInfo, vw, vb, bShapeInfo, vz, zShapeInfo, kH, kW, sH, sW, pH, pW, dH, dW);
+}
+
+//////////////////////////////////////////////////////////////////////////
+void ConvolutionUtils::deconv2d(sd::graph::Context& block, const NDArray* input, const NDArray* weights, const NDArray* bias, NDArray* output, const int kH, const int kW, const int sH, const int sW, const int pH, const int pW, const int dH, const int dW, const int isNCHW, const int wFormat, const GemmEpilogue::Activation activation, const double cutoff) {
+
+    // input   [bS, iH, iW, iC] (NHWC) or [bS, iC, iH, iW] (NCHW)
+    // weights [kH, kW, oC, iC], [iC, oC, kH, kW], [iC, kH, kW, oC]
+    // bias    [oC]
+    // output  [bS, oH, oW, oC] (NHWC) or [bS, oC, oH, oW] (NCHW)
+
+    std::vector<int> wPermut;
+    if(0 == wFormat)
+        wPermut = {0, 1, 3, 2};                 // [kH, kW, oC, iC] -> [kH, kW, iC, oC]
+    else if(1 == wFormat)
+        wPermut = {2, 3, 0, 1};                 // [iC, oC, kH, kW] -> [kH, kW, iC, oC]
+    else
+        wPermut = {1, 2, 0, 3};                 // [iC, kH, kW, oC] -> [kH, kW, iC, oC]
+
+    NDArray w = weights->permute(wPermut).dup('c');
+
+    std::vector<const NDArray*> readList = {&w};
+
+    NDArray b;
+    if(bias != nullptr) {
+        b = bias->cast(input->dataType());
+        readList.push_back(&b);
+    }
+
+    const std::vector<int> toNCHW = isNCHW ? std::vector<int>({0, 1, 2, 3}) : std::vector<int>({0, 3, 1, 2});
+
+    NDArray in  = input->permute(toNCHW);
+    NDArray out = output->permute(toNCHW);
+    readList.push_back(&in);
+
+    PointersManager manager(block.launchContext(), "deconv2d");
+
+    const int threadsPerBlock = MAX_NUM_THREADS / 2;
+    const int blocksPerGrid = (out.lengthOf() + threadsPerBlock - 1) / threadsPerBlock;
+    const int sharedMem = out.rankOf() * sizeof(Nd4jLong) * threadsPerBlock + 128;
+
+    NDArray::prepareSpecialUse({&out}, readList);
+    BUILD_SINGLE_SELECTOR(input->dataType(), deconv2dCudaLauncher, (blocksPerGrid, threadsPerBlock, sharedMem, block.launchContext()->getCudaStream(), in.specialBuffer(), in.specialShapeInfo(), w.specialBuffer(), bias == nullptr ? nullptr : b.specialBuffer(), bias == nullptr ? nullptr : b.specialShapeInfo(), out.specialBuffer(), out.specialShapeInfo(), kH, kW, sH, sW, pH, pW, dH, dW), FLOAT_TYPES);
+    NDArray::registerSpecialUse({&out}, readList);
+
+    manager.synchronize();
+
+    // bias is already added by kernel
+    if(activation != GemmEpilogue::NONE)
+        ConvolutionUtils::biasActivation(block, *output, nullptr, isNCHW, activation, cutoff);
+}
+
+}
+}
@@ -0,0 +1,173 @@
+/*******************************************************************************
+ * Copyright (c) 2020 Konduit K.K.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+#include <ops/declarable/helpers/gru.h>
+#include <helpers/PointersManager.h>
+
+namespace sd 	  {
+namespace ops 	  {
+namespace helpers {
+
+//////////////////////////////////////////////////////////////////////////
+template <typename T>
+__global__ static void gruCellActivationsCuda(const void* vxp, const Nd4jLong* xpShapeInfo, const void* vh, const Nd4jLong* hShapeInfo,
+                                              void* vg, const Nd4jLong* gShapeInfo, void* vc, const Nd4jLong* cShapeInfo, void* vz, const Nd4jLong* zShapeInfo) {
+
+    // one thread per element of h [bS, nOut]
+
+    const T* xp = reinterpret_cast<const T*>(vxp);
+    const T* hp = reinterpret_cast<const T*>(vh);
+          T* g  = reinterpret_cast<T*>(vg);
+          T* zc = reinterpret_cast<T*>(vc);
+          T* z  = reinterpret_cast<T*>(vz);
+
+    const int bS   = shape::sizeAt(zShapeInfo, 0);
+    const int nOut = shape::sizeAt(zShapeInfo, 1);
+
+    const auto ind = threadIdx.x + blockIdx.x * blockDim.x;
+    if (ind >= bS * nOut)
+        return;
+
+    const int e = ind / nOut;
+    const int j = ind % nOut;
+
+    const Nd4jLong* xStrides = shape::stride(xpShapeInfo);
+    const Nd4jLong* gStrides = shape::stride(gShapeInfo);
+
+    const T* xRow = xp + e * xStrides[0];
+          T* gRow = g  + e * gStrides[0];
+
+    const T r     = sd::math::nd4j_sigmoid<T, T>(gRow[j * gStrides[1]] + xRow[j * xStrides[1]]);
+    const T u     = sd::math::nd4j_sigmoid<T, T>(gRow[(nOut + j) * gStrides[1]] + xRow[(nOut + j) * xStrides[1]]);
+    const T hWc   = gRow[(2 * nOut + j) * gStrides[1]];
+    const T c     = sd::math::nd4j_tanh<T, T>(r * hWc + xRow[(2 * nOut + j) * xStrides[1]]);
+    const T hPrev = hp[e * shape::stride(hShapeInfo)[0] + j * shape::stride(hShapeInfo)[1]];
+
+    if (zc != nullptr)
+        zc[e * shape::stride(cShapeInfo)[0] + j * shape::stride(cShapeInfo)[1]] = hWc;
+
+    gRow[j * gStrides[1]]              = r;
+    gRow[(nOut + j) * gStrides[1]]     = u;
+    gRow[(2 * nOut + j) * gStrides[1]] = c;
+
+    z[e * shape::stride(zShapeInfo)[0] + j * shape::stride(zShapeInfo)[1]] = u * hPrev + (static_cast<T>(1) - u) * c;
+}
+
+//////////////////////////////////////////////////////////////////////////
+template <typename T>
+static void gruCellActivationsCudaLauncher(const int blocksPerGrid, const int threadsPerBlock, const cudaStream_t *stream,
+                                           const void* vxp, const Nd4jLong* xpShapeInfo, const void* vh, const Nd4jLong* hShapeInfo,
+                                           void* vg, const Nd4jLong* gShapeInfo, void* vc, const Nd4jLong* cShapeInfo, void* vz, const Nd4jLong* zShapeInfo) {
+
+    gruCellActivationsCuda<T><<<blocksPerGrid, threadsPerBlock, 0, *stream>>>(vxp, xpShapeInfo, vh, hShapeInfo, vg, gShapeInfo, vc, cShapeInfo, vz, zShapeInfo);
+}
+
+//////////////////////////////////////////////////////////////////////////
+template <typename T>
+__global__ static void gruCellActivationsBpCuda(const void* vh, const Nd4jLong* hShapeInfo, const void* vg, const Nd4jLong* gShapeInfo, const void* vc, const Nd4jLong* cShapeInfo,
+                                                const void* vdh, const Nd4jLong* dhShapeInfo, void* vdhI, const Nd4jLong* dhIShapeInfo,
+                                                void* vdz, const Nd4jLong* dzShapeInfo, void* vdzh, const Nd4jLong* dzhShapeInfo) {
+
+    // one thread per element of dLdhI [bS, nOut]
+
+    const T* hp  = reinterpret_cast<const T*>(vh);
+    const T* g   = reinterpret_cast<const T*>(vg);
+    const T* hWc = reinterpret_cast<const T*>(vc);
+    const T* dh  = reinterpret_cast<const T*>(vdh);
+          T* dhI = reinterpret_cast<T*>(vdhI);
+          T* dz  = reinterpret_cast<T*>(vdz);
+          T* dzh = reinterpret_cast<T*>(vdzh);
+
+    const int bS   = shape::sizeAt(dhIShapeInfo, 0);
+    const int nOut = shape::sizeAt(dhIShapeInfo, 1);
+
+    const auto ind = threadIdx.x + blockIdx.x * blockDim.x;
+    if (ind >= bS * nOut)
+        return;
+
+    const int e = ind / nOut;
+    const int j = ind % nOut;
+
+    const Nd4jLong* gStrides   = shape::stride(gShapeInfo);
+    const Nd4jLong* dzStrides  = shape::stride(dzShapeInfo);
+    const Nd4jLong* dzhStrides = shape::stride(dzhShapeInfo);
+
+    const T r = g[e * gStrides[0] + j * gStrides[1]];
+    const T u = g[e * gStrides[0] + (nOut + j) * gStrides[1]];
+    const T c = g[e * gStrides[0] + (2 * nOut + j) * gStrides[1]];
+
+    T& dLdhIj = dhI[e * shape::stride(dhIShapeInfo)[0] + j * shape::stride(dhIShapeInfo)[1]];
+    const T grad = dh == nullptr ? dLdhIj : dLdhIj + dh[e * shape::stride(dhShapeInfo)[0] + j * shape::stride(dhShapeInfo)[1]];
+
+    const T dzc = grad * (static_cast<T>(1) - u) * (static_cast<T>(1) - c * c);
+    const T dzu = grad * (hp[e * shape::stride(hShapeInfo)[0] + j * shape::stride(hShapeInfo)[1]] - c) * u * (static_cast<T>(1) - u);
+    const T dzr = dzc * hWc[e * shape::stride(cShapeInfo)[0] + j * shape::stride(cShapeInfo)[1]] * r * (static_cast<T>(1) - r);
+
+    dz[e * dzStrides[0] + j * dzStrides[1]]              = dzr;
+    dz[e * dzStrides[0] + (nOut + j) * dzStrides[1]]     = dzu;
+    dz[e * dzStrides[0] + (2 * nOut + j) * dzStrides[1]] = dzc;
+
+    dzh[e * dzhStrides[0] + j * dzhStrides[1]]              = dzr;
+    dzh[e * dzhStrides[0] + (nOut + j) * dzhStrides[1]]     = dzu;
+    dzh[e * dzhStrides[0] + (2 * nOut + j) * dzhStrides[1]] = dzc * r;
+
+    dLdhIj = grad * u;
+}
+
+//////////////////////////////////////////////////////////////////////////
+template <typename T>
+static void gruCellActivationsBpCudaLauncher(const int blocksPerGrid, const int threadsPerBlock, const cudaStream_t *stream,
+                                             const void* vh, const Nd4jLong* hShapeInfo, const void* vg, const Nd4jLong* gShapeInfo, const void* vc, const Nd4jLong* cShapeInfo,
+                                             const void* vdh, const Nd4jLong* dhShapeInfo, void* vdhI, const Nd4jLong* dhIShapeInfo,
+                                             void* vdz, const Nd4jLong* dzShapeInfo, void* vdzh, const Nd4jLong* dzhShapeInfo) {
+
+    gruCellActivationsBpCuda<T><<<blocksPerGrid, threadsPerBlock, 0, *stream>>>(vh, hShapeInfo, vg, gShapeInfo, vc, cShapeInfo, vdh, dhShapeInfo, vdhI, dhIShapeInfo, vdz, dzShapeInfo, vdzh, dzhShapeInfo);
+}
+
+//////////////////////////////////////////////////////////////////////////
+void gruCellActivations(sd::LaunchContext * context, const NDArray* xProj, const NDArray* hI, NDArray* gates, NDArray* hc, NDArray* h) {
+
+    PointersManager manager(context, "gruCellActivations");
+
+    const int threadsPerBlock = MAX_NUM_THREADS / 4;
+    const int blocksPerGrid = (h->lengthOf() + threadsPerBlock - 1) / threadsPerBlock;
+
+    NDArray::prepareSpecialUse({gates, hc, h}, {xProj, hI, gates});
+    BUILD_SINGLE_SELECTOR(h->dataType(), gruCellActivationsCudaLauncher, (blocksPerGrid, threadsPerBlock, context->getCudaStream(), xProj->specialBuffer(), xProj->specialShapeInfo(), hI->specialBuffer(), hI->specialShapeInfo(), gates->specialBuffer(), gates->specialShapeInfo(), hc == nullptr ? nullptr : hc->specialBuffer(), hc == nullptr ? nullptr : hc->specialShapeInfo(), h->specialBuffer(), h->specialShapeInfo()), FLOAT_TYPES);
+    NDArray::registerSpecialUse({gates, hc, h}, {xProj, hI, gates});
+
+    manager.synchronize();
+}
+
+//////////////////////////////////////////////////////////////////////////
+void gruCellActivationsBp(sd::LaunchContext * context, const NDArray* hI, const NDArray* gates, const NDArray* hc, const NDArray* dLdh, NDArray* dLdhI, NDArray* dLdz, NDArray* dLdzh) {
+
+    PointersManager manager(context, "gruCellActivationsBp");
+
+    const int threadsPerBlock = MAX_NUM_THREADS / 4;
+    const int blocksPerGrid = (dLdhI->lengthOf() + threadsPerBlock - 1) / threadsPerBlock;
+
+    NDArray::prepareSpecialUse({dLdhI, dLdz, dLdzh}, {hI, gates, hc, dLdh, dLdhI});
+    BUILD_SINGLE_SELECTOR(gates->dataType(), gruCellActivationsBpCudaLauncher, (blocksPerGrid, threadsPerBlock, context->getCudaStream(), hI->specialBuffer(), hI->specialShapeInfo(), gates->specialBuffer(), gates->specialShapeInfo(), hc->specialBuffer(), hc->specialShapeInfo(), dLdh == nullptr ? nullptr : dLdh->specialBuffer(), dLdh == nullptr ? nullptr : dLdh->specialShapeInfo(), dLdhI->specialBuffer(), dLdhI->specialShapeInfo(), dLdz->specialBuffer(), dLdz->specialShapeInfo(), dLdzh->specialBuffer(), dLdzh->specialShapeInfo()), FLOAT_TYPES);
+    NDArray::registerSpecialUse({dLdhI, dLdz, dLdzh}, {hI, gates, hc, dLdh, dLdhI});
+
+    manager.synchronize();
+}
+
+}
+}
+}
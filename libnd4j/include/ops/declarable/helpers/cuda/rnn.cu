@@ -0,0 +1,96 @@
+/*******************************************************************************
+ * Copyright (c) 2020 Konduit K.K.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+
+#include <ops/declarable/helpers/rnn.h>
+#include <helpers/PointersManager.h>
+
+namespace sd 	  {
+namespace ops 	  {
+namespace helpers {
+
+//////////////////////////////////////////////////////////////////////////
+template <typename T>
+__global__ static void rnnMaskedStepCuda(const void* vxp, const Nd4jLong* xpShapeInfo, const int* seqLengths, const Nd4jLong lStride, const int t, const bool forward,
+                                         void* vs, const Nd4jLong* sShapeInfo, void* vh, const Nd4jLong* hShapeInfo, void* vf, const Nd4jLong* fShapeInfo) {
+
+    // one thread per element of hStep [bS, nU]
+
+    const T* xp = reinterpret_cast<const T*>(vxp);
+          T* hs = reinterpret_cast<T*>(vs);
+          T* hp = reinterpret_cast<T*>(vh);
+          T* hf = reinterpret_cast<T*>(vf);
+
+    const int bS = shape::sizeAt(sShapeInfo, 0);
+    const int nU = shape::sizeAt(sShapeInfo, 1);
+
+    const auto ind = threadIdx.x + blockIdx.x * blockDim.x;
+    if (ind >= bS * nU)
+        return;
+
+    const int e = ind / nU;
+    const int j = ind % nU;
+
+    const Nd4jLong* xStrides = shape::stride(xpShapeInfo);
+    const Nd4jLong* hStrides = shape::stride(hShapeInfo);
+
+    const int len = seqLengths[e * lStride];
+    T& sj = hs[e * shape::stride(sShapeInfo)[0] + j * shape::stride(sShapeInfo)[1]];
+
+    if (t >= len) {
+        // sequence is over: padded step of h is zero, and so is scratch row, so that it stays bounded in following gemms
+        hp[t * hStrides[0] + e * hStrides[1] + j * hStrides[2]] = static_cast<T>(0);
+        sj = static_cast<T>(0);
+        return;
+    }
+
+    const int s = forward ? t : len - 1 - t;
+    const T v = sd::math::nd4j_tanh<T, T>(sj + xp[s * xStrides[0] + e * xStrides[1] + j * xStrides[2]]);
+
+    sj = v;
+    hp[s * hStrides[0] + e * hStrides[1] + j * hStrides[2]] = v;
+    if (t == len - 1)
+        hf[e * shape::stride(fShapeInfo)[0] + j * shape::stride(fShapeInfo)[1]] = v;
+}
+
+//////////////////////////////////////////////////////////////////////////
+template <typename T>
+static void rnnMaskedStepCudaLauncher(const int blocksPerGrid, const int threadsPerBlock, const cudaStream_t *stream,
+                                      const void* vxp, const Nd4jLong* xpShapeInfo, const int* seqLengths, const Nd4jLong lStride, const int t, const bool forward,
+                                      void* vs, const Nd4jLong* sShapeInfo, void* vh, const Nd4jLong* hShapeInfo, void* vf, const Nd4jLong* fShapeInfo) {
+
+    rnnMaskedStepCuda<T><<<blocksPerGrid, threadsPerBlock, 0, *stream>>>(vxp, xpShapeInfo, seqLengths, lStride, t, forward, vs, sShapeInfo, vh, hShapeInfo, vf, fShapeInfo);
+}
+
+//////////////////////////////////////////////////////////////////////////
+void rnnMaskedStep(sd::LaunchContext * context, const NDArray* xProj, const NDArray* seqLengths, const int t, const bool forward, NDArray* hStep, NDArray* h, NDArray* hFinal) {
+
+    PointersManager manager(context, "rnnMaskedStep");
+
+    const int threadsPerBlock = MAX_NUM_THREADS / 4;
+    const int blocksPerGrid = (hStep->lengthOf() + threadsPerBlock - 1) / threadsPerBlock;
+
+    NDArray::prepareSpecialUse({hStep, h, hFinal}, {xProj, seqLengths, hStep});
+    BUILD_SINGLE_SELECTOR(hStep->dataType(), rnnMaskedStepCudaLauncher, (blocksPerGrid, threadsPerBlock, context->getCudaStream(), xProj->specialBuffer(), xProj->specialShapeInfo(), reinterpret_cast<const int*>(seqLengths->specialBuffer()), seqLengths->stridesOf()[0], t, forward, hStep->specialBuffer(), hStep->specialShapeInfo(), h->specialBuffer(), h->specialShapeInfo(), hFinal->specialBuffer(), hFinal->specialShapeInfo()), FLOAT_TYPES);
+    NDArray::registerSpecialUse({hStep, h, hFinal}, {xProj, seqLengths, hStep});
+
+    manager.synchronize();
+}
+
+}
+}
+}
@@ -34,6 +34,15 @@ namespace helpers {
 	void gruCell(sd::LaunchContext * context, const NDArray* x, const NDArray* hLast, const NDArray* Wru, const NDArray* Wc, const NDArray* b,
 				 NDArray* gates, NDArray* h);
 
+	// single pass over gates following hI × Wh gemm: on input gates [bS, 3*nOut] holds hI × Wh, on output reset, update and cell gates activations,
+	// xProj [bS, 3*nOut] is x × Wx + b, hc [bS, nOut] receives cell part of hI × Wh required by backprop, may be nullptr
+	void gruCellActivations(sd::LaunchContext * context, const NDArray* xProj, const NDArray* hI, NDArray* gates, NDArray* hc, NDArray* h);
+
+	// single pass counterpart of gruCellActivations: dLdhI holds gradient vs. cell output accumulated from later time steps, dLdh (may be nullptr)
+	// is added to it, on output dLdhI holds direct part of gradient vs. hI, dLdz [bS, 3*nOut] is gradient vs. gates pre-activations,
+	// dLdzh [bS, 3*nOut] is the same as dLdz but with cell part multiplied by reset gate, as it's seen by hI × Wh
+	void gruCellActivationsBp(sd::LaunchContext * context, const NDArray* hI, const NDArray* gates, const NDArray* hc, const NDArray* dLdh, NDArray* dLdhI, NDArray* dLdz, NDArray* dLdzh);
+
 	void gruTimeLoop(sd::LaunchContext * context, const NDArray* x, const NDArray* h0, const NDArray* Wx, const NDArray* Wh, const NDArray* b, NDArray* h);
 
 	void gruCellBp(sd::LaunchContext* context,
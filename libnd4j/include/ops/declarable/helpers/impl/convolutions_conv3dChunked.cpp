@@ -0,0 +1,290 @@
+/*******************************************************************************
+ * Copyright (c) 2020 Konduit K.K.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+// Bounded-memory versions of conv3d, conv3d_bp and deconv3d.
+// Full columns array has [bS, iC, kD, kH, kW, oD, oH, oW] shape, here it's built only for [bChunk, ..., dChunk, oH, oW] part of it at once:
+// output plane d depends on input planes [d*sD - pD, d*sD - pD + (kD-1)*dD] only, so every chunk needs just a slab of input volume.
+
+#include <ops/declarable/helpers/convolutions.h>
+#include <helpers/MmulHelper.h>
+#include <array/DataTypeUtils.h>
+#include <system/Environment.h>
+
+namespace sd {
+    namespace ops  {
+
+//////////////////////////////////////////////////////////////////////////
+// volume planes [v0, v1) which columns of output planes [d0, d1) are built from, pS is the padding in front of v0
+static void slabForPlanes(const int d0, const int d1, const int kD, const int sD, const int pD, const int dD, const int vD, int& v0, int& v1, int& pS) {
+
+    const int first = d0 * sD - pD;
+    const int last  = (d1 - 1) * sD - pD + (kD - 1) * dD + 1;
+
+    v0 = math::nd4j_max<int>(first, 0);
+    v1 = math::nd4j_min<int>(last, vD);
+    pS = v0 - first;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// planeBytes is the size of columns of single output plane of single batch item
+static void chunkSizes(const int bS, const int oD, const Nd4jLong planeBytes, int& bChunk, int& dChunk) {
+
+    const Nd4jLong planes = math::nd4j_max<Nd4jLong>(1, Environment::getInstance().convolutionBufferLimit() / planeBytes);
+
+    if(planes >= oD) {
+        dChunk = oD;
+        bChunk = static_cast<int>(math::nd4j_min<Nd4jLong>(bS, planes / oD));
+    }
+    else {
+        dChunk = static_cast<int>(planes);
+        bChunk = 1;
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////
+// [kD, kH, kW, iC, oC] -> [oC, iC, kD, kH, kW], [oC, kD, kH, kW, iC] -> [oC, iC, kD, kH, kW]
+// deconv3d weights [kD, kH, kW, oC, iC], [iC, kD, kH, kW, oC] are brought to [iC, oC, kD, kH, kW] the same way
+static std::vector<int> weightsPermutation(const int wFormat) {
+
+    if(0 == wFormat)
+        return {4,3,0,1,2};
+    if(1 == wFormat)
+        return {0,1,2,3,4};
+    return {0,4,1,2,3};
+}
+
+//////////////////////////////////////////////////////////////////////////
+static NDArray weightsMatrix(const NDArray* weights, const int wFormat) {
+
+    NDArray permuted = weights->permute(weightsPermutation(wFormat));
+    return permuted.reshape('c', {permuted.sizeAt(0), permuted.lengthOf() / permuted.sizeAt(0)});
+}
+
+//////////////////////////////////////////////////////////////////////////
+// c = a x b, where c is a view of any shape with proper length
+static void mmulInto(const NDArray& a, const NDArray& b, NDArray& c) {
+
+    NDArray cMat = c.reshape('c', {a.sizeAt(0), b.sizeAt(1)}, false);
+    MmulHelper::mmul(&a, &b, &cMat, 1., 0.);
+
+    if(cMat.getDataBuffer() != c.getDataBuffer())
+        c.assign(cMat);
+}
+
+//////////////////////////////////////////////////////////////////////////
+// gVol [bS, gC, gD, gH, gW] is spread over vol [bS, vC, vD, vH, vW] through wMat [gC, vC*kD*kH*kW]: this is gradI of conv3d and output of deconv3d
+static void spreadChunked(sd::graph::Context& block, const NDArray& wMat, const NDArray& gVol, NDArray& vol, const int kD, const int kH, const int kW, const int sD, const int sH, const int sW, const int pD, const int pH, const int pW, const int dD, const int dH, const int dW) {
+
+    const int bS = gVol.sizeAt(0);
+    const int gC = gVol.sizeAt(1);
+    const int gD = gVol.sizeAt(2);
+    const int gH = gVol.sizeAt(3);
+    const int gW = gVol.sizeAt(4);
+    const int vC = vol.sizeAt(1);
+    const int vD = vol.sizeAt(2);
+    const int vH = vol.sizeAt(3);
+    const int vW = vol.sizeAt(4);
+
+    const Nd4jLong K = (Nd4jLong) vC * kD * kH * kW;
+    const Nd4jLong N = (Nd4jLong) gH * gW;
+
+    int bChunk, dChunk;
+    chunkSizes(bS, gD, K * N * DataTypeUtils::sizeOf(vol.dataType()), bChunk, dChunk);
+
+    const int slabD = math::nd4j_min<int>((dChunk - 1) * sD + (kD - 1) * dD + 1, vD);
+
+    NDArray colBuffer('c', {bChunk * dChunk * K * N}, vol.dataType(), block.launchContext());
+    NDArray slabBuffer('c', {(Nd4jLong) bChunk * vC * slabD * vH * vW}, vol.dataType(), block.launchContext());
+    NDArray wMatT = wMat.transpose();                                                   // [vC*kD*kH*kW, gC]
+
+    vol.nullify();
+
+    for(int b0 = 0; b0 < bS; b0 += bChunk) {
+        const int b1 = math::nd4j_min<int>(b0 + bChunk, bS);
+
+        for(int d0 = 0; d0 < gD; d0 += dChunk) {
+            const int d1 = math::nd4j_min<int>(d0 + dChunk, gD);
+
+            int v0, v1, pS;
+            slabForPlanes(d0, d1, kD, sD, pD, dD, vD, v0, v1, pS);
+            if(v1 <= v0)            // these planes contribute to padding only
+                continue;
+
+            NDArray columns(colBuffer.getDataBuffer(), 'c', {b1 - b0, vC, kD, kH, kW, d1 - d0, gH, gW}, block.launchContext());
+
+            for(int b = b0; b < b1; ++b) {
+                NDArray colMat = columns({b-b0,b-b0+1, 0,0, 0,0, 0,0, 0,0, 0,0, 0,0, 0,0}, true).reshape('c', {K, (d1 - d0) * N}, false);
+                NDArray gMat   = gVol({b,b+1, 0,0, d0,d1, 0,0, 0,0}, true).reshape('c', {(Nd4jLong) gC, (d1 - d0) * N});
+                MmulHelper::mmul(&wMatT, &gMat, &colMat, 1., 0.);                       // [vC*kD*kH*kW, gC] x [gC, dc*gH*gW] = [vC*kD*kH*kW, dc*gH*gW]
+            }
+
+            // col2vol overwrites its target, so neighbouring slabs are summed up via temporary one
+            NDArray slab(slabBuffer.getDataBuffer(), 'c', {b1 - b0, vC, v1 - v0, vH, vW}, block.launchContext());
+            ConvolutionUtils::col2vol(block, columns, slab, sD, sH, sW, pS, pH, pW, dD, dH, dW);
+
+            NDArray target = vol({b0,b1, 0,0, v0,v1, 0,0, 0,0}, true);
+            target += slab;
+        }
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////
+bool ConvolutionUtils::conv3dColumnsFit(const int bS, const int iC, const int kD, const int kH, const int kW, const int oD, const int oH, const int oW, const sd::DataType dataType) {
+
+    const Nd4jLong bytes = (Nd4jLong) bS * iC * kD * kH * kW * oD * oH * oW * DataTypeUtils::sizeOf(dataType);
+    return bytes <= Environment::getInstance().convolutionBufferLimit();
+}
+
+//////////////////////////////////////////////////////////////////////////
+bool ConvolutionUtils::conv3dDirectApplicable(const NDArray* input, const NDArray* weights, const NDArray* output, const int kD, const int kH, const int kW, const int isNCDHW) {
+
+    if(isNCDHW || !input->isR() || input->dataType() != weights->dataType() || input->dataType() != output->dataType())
+        return false;
+
+    // every output element reads kD*kH*kW*iC inputs, columns pay off for larger receptive fields
+    return (Nd4jLong) kD * kH * kW * input->sizeAt(4) <= 64;
+}
+
+//////////////////////////////////////////////////////////////////////////
+void ConvolutionUtils::conv3dChunked(sd::graph::Context& block, const NDArray* input, const NDArray* weights, NDArray* output, const int kD, const int kH, const int kW, const int sD, const int sH, const int sW, const int pD, const int pH, const int pW, const int dD, const int dH, const int dW, const int isNCDHW, const int wFormat) {
+
+    // input   [bS, iD, iH, iW, iC] (NDHWC) or [bS, iC, iD, iH, iW] (NCDHW)
+    // weights [kD, kH, kW, iC, oC], [oC, iC, kD, kH, kW], [oC, kD, kH, kW, iC]
+    // output  [bS, oD, oH, oW, oC] (NDHWC) or [bS, oC, oD, oH, oW] (NCDHW)
+
+    int bS, iC, iD, iH, iW, oC, oD, oH, oW;                     // batch size, input channels, input depth/height/width, output channels, output depth/height/width;
+    int indIOioC, indIOioD, indWoC, indWiC, indWkD;             // corresponding indexes
+    getSizesAndIndexesConv3d(isNCDHW, wFormat, *input, *output, bS, iC, iD, iH, iW, oC, oD, oH, oW, indIOioC, indIOioD, indWiC, indWoC, indWkD);
+
+    const std::vector<int> toNCDHW = isNCDHW ? std::vector<int>({0,1,2,3,4}) : std::vector<int>({0,4,1,2,3});
+
+    NDArray vol = input->permute(toNCDHW);                      // [bS, iC, iD, iH, iW]
+    NDArray out = output->permute(toNCDHW);                     // [bS, oC, oD, oH, oW]
+
+    const Nd4jLong K = (Nd4jLong) iC * kD * kH * kW;
+    const Nd4jLong N = (Nd4jLong) oH * oW;
+
+    int bChunk, dChunk;
+    chunkSizes(bS, oD, K * N * DataTypeUtils::sizeOf(vol.dataType()), bChunk, dChunk);
+
+    NDArray wMat = weightsMatrix(weights, wFormat);             // [oC, iC*kD*kH*kW]
+    NDArray colBuffer('c', {bChunk * dChunk * K * N}, vol.dataType(), block.launchContext());
+
+    for(int b0 = 0; b0 < bS; b0 += bChunk) {
+        const int b1 = math::nd4j_min<int>(b0 + bChunk, bS);
+
+        for(int d0 = 0; d0 < oD; d0 += dChunk) {
+            const int d1 = math::nd4j_min<int>(d0 + dChunk, oD);
+
+            int v0, v1, pS;
+            slabForPlanes(d0, d1, kD, sD, pD, dD, iD, v0, v1, pS);
+
+            NDArray columns(colBuffer.getDataBuffer(), 'c', {b1 - b0, iC, kD, kH, kW, d1 - d0, oH, oW}, block.launchContext());
+
+            if(v0 < v1)
+                vol2col(block, vol({b0,b1, 0,0, v0,v1, 0,0, 0,0}, true), columns, sD, sH, sW, pS, pH, pW, dD, dH, dW);
+            else
+                columns.nullify();                              // slab lies in padding entirely
+
+            for(int b = b0; b < b1; ++b) {
+                NDArray colMat   = columns({b-b0,b-b0+1, 0,0, 0,0, 0,0, 0,0, 0,0, 0,0, 0,0}, true).reshape('c', {K, (d1 - d0) * N}, false);
+                NDArray outChunk = out({b,b+1, 0,0, d0,d1, 0,0, 0,0}, true);
+                mmulInto(wMat, colMat, outChunk);               // [oC, iC*kD*kH*kW] x [iC*kD*kH*kW, dc*oH*oW] = [oC, dc*oH*oW]
+            }
+        }
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////
+void ConvolutionUtils::conv3dBPChunked(sd::graph::Context& block, const NDArray* input, const NDArray* weights, const NDArray* gradO, NDArray* gradI, NDArray* gradW, const int kD, const int kH, const int kW, const int sD, const int sH, const int sW, const int pD, const int pH, const int pW, const int dD, const int dH, const int dW, const int isNCDHW, const int wFormat) {
+
+    // input   [bS, iD, iH, iW, iC] (NDHWC) or [bS, iC, iD, iH, iW] (NCDHW)
+    // weights [kD, kH, kW, iC, oC], [oC, iC, kD, kH, kW], [oC, kD, kH, kW, iC]
+    // gradO   [bS, oD, oH, oW, oC] (NDHWC) or [bS, oC, oD, oH, oW] (NCDHW)
+    // gradI and gradW have the same shapes as input and weights
+
+    int bS, iC, iD, iH, iW, oC, oD, oH, oW;                     // batch size, input channels, input depth/height/width, output channels, output depth/height/width;
+    int indIOioC, indIOioD, indWoC, indWiC, indWkD;             // corresponding indexes
+    getSizesAndIndexesConv3d(isNCDHW, wFormat, *input, *gradO, bS, iC, iD, iH, iW, oC, oD, oH, oW, indIOioC, indIOioD, indWiC, indWoC, indWkD);
+
+    const std::vector<int> toNCDHW = isNCDHW ? std::vector<int>({0,1,2,3,4}) : std::vector<int>({0,4,1,2,3});
+
+    NDArray vol      = input->permute(toNCDHW);                 // [bS, iC, iD, iH, iW]
+    NDArray gradIVol = gradI->permute(toNCDHW);                 // [bS, iC, iD, iH, iW]
+    NDArray gradOVol = gradO->permute(toNCDHW);                 // [bS, oC, oD, oH, oW]
+
+    const Nd4jLong K = (Nd4jLong) iC * kD * kH * kW;
+    const Nd4jLong N = (Nd4jLong) oH * oW;
+
+    int bChunk, dChunk;
+    chunkSizes(bS, oD, K * N * DataTypeUtils::sizeOf(vol.dataType()), bChunk, dChunk);
+
+    NDArray wMat = weightsMatrix(weights, wFormat);             // [oC, iC*kD*kH*kW]
+
+    // ----- calculation of gradW ----- //
+    {
+        NDArray gradWMat('c', {(Nd4jLong) oC, K}, gradW->dataType(), block.launchContext());
+        gradWMat.nullify();
+
+        NDArray colBuffer('c', {bChunk * dChunk * K * N}, vol.dataType(), block.launchContext());
+
+        for(int b0 = 0; b0 < bS; b0 += bChunk) {
+            const int b1 = math::nd4j_min<int>(b0 + bChunk, bS);
+
+            for(int d0 = 0; d0 < oD; d0 += dChunk) {
+                const int d1 = math::nd4j_min<int>(d0 + dChunk, oD);
+
+                int v0, v1, pS;
+                slabForPlanes(d0, d1, kD, sD, pD, dD, iD, v0, v1, pS);
+                if(v1 <= v0)                                    // zero columns, nothing to accumulate
+                    continue;
+
+                NDArray columns(colBuffer.getDataBuffer(), 'c', {b1 - b0, iC, kD, kH, kW, d1 - d0, oH, oW}, block.launchContext());
+                vol2col(block, vol({b0,b1, 0,0, v0,v1, 0,0, 0,0}, true), columns, sD, sH, sW, pS, pH, pW, dD, dH, dW);
+
+                for(int b = b0; b < b1; ++b) {
+                    NDArray colMatT  = columns({b-b0,b-b0+1, 0,0, 0,0, 0,0, 0,0, 0,0, 0,0, 0,0}, true).reshape('c', {K, (d1 - d0) * N}, false).transpose();
+                    NDArray gradOMat = gradOVol({b,b+1, 0,0, d0,d1, 0,0, 0,0}, true).reshape('c', {(Nd4jLong) oC, (d1 - d0) * N});
+                    MmulHelper::mmul(&gradOMat, &colMatT, &gradWMat, 1., 1.);   // [oC, dc*oH*oW] x [dc*oH*oW, iC*kD*kH*kW] = [oC, iC*kD*kH*kW]
+                }
+            }
+        }
+
+        gradW->permute(weightsPermutation(wFormat)).assign(gradWMat.reshape('c', {oC, iC, kD, kH, kW}));
+    }
+
+    //----- calculation of gradI -----//
+    spreadChunked(block, wMat, gradOVol, gradIVol, kD, kH, kW, sD, sH, sW, pD, pH, pW, dD, dH, dW);
+}
+
+//////////////////////////////////////////////////////////////////////////
+void ConvolutionUtils::deconv3dChunked(sd::graph::Context& block, const NDArray* input, const NDArray* weights, NDArray* output, const int kD, const int kH, const int kW, const int sD, const int sH, const int sW, const int pD, const int pH, const int pW, const int dD, const int dH, const int dW, const int isNCDHW, const int wFormat) {
+
+    // input   [bS, iD, iH, iW, iC] (NDHWC) or [bS, iC, iD, iH, iW] (NCDHW)
+    // weights [kD, kH, kW, oC, iC], [iC, oC, kD, kH, kW], [iC, kD, kH, kW, oC]
+    // output  [bS, oD, oH, oW, oC] (NDHWC) or [bS, oC, oD, oH, oW] (NCDHW)
+
+    const std::vector<int> toNCDHW = isNCDHW ? std::vector<int>({0,1,2,3,4}) : std::vector<int>({0,4,1,2,3});
+
+    NDArray inVol  = input->permute(toNCDHW);                   // [bS, iC, iD, iH, iW]
+    NDArray outVol = output->permute(toNCDHW);                  // [bS, oC, oD, oH, oW]
+
+    // [iC, oC*kD*kH*kW] x [iC, iD*iH*iW] -> columns [oC, kD, kH, kW, iD, iH, iW] -> [oC, oD, oH, oW]
+    spreadChunked(block, weightsMatrix(weights, wFormat), inVol, outVol, kD, kH, kW, sD, sH, sW, pD, pH, pW, dD, dH, dW);
+}
+
+    }
+}
@@ -29,6 +29,7 @@
 #include <ops/declarable/CustomOperations.h>
 #include <ops/declarable/helpers/transforms.h>
 #include <helpers/MmulHelper.h>
+#include <array/ResultSet.h>
 
 namespace sd 	  {
 namespace ops 	  {
@@ -113,36 +114,32 @@ void gruCell(sd::LaunchContext * context, const NDArray* x, const NDArray* hI, c
     // zu = x × Wxu + hI × Whu + bu
     // r = sigmoid(zr)
     // u = sigmoid(zu)
-    // zc = x × Wxc + (r * hI) × Whc + bc
+    // zc = x × Wxc + r * (hI × Whc) + bc
     // c = tanh(zc)
     // h = (1-u)*c + u*hI
 
-    const int bS  = x->sizeAt(0);
-    const int nIn = x->sizeAt(1);
-    const int nOut = hI->sizeAt(1);
-
-    NDArray temp = gates->ulike();
-    MmulHelper::mmul(x, Wx, &temp);                 // [bS, nIn] × [nIn, 3*nOut] = [bS, 3*nOut]
-    temp += *b;
+    NDArray xProj = gates->ulike();
+    MmulHelper::mmul(x, Wx, &xProj);                // [bS, nIn] × [nIn, 3*nOut] = [bS, 3*nOut]
+    xProj += *b;
 
     MmulHelper::mmul(hI, Wh, gates);                // [bS, nOut] × [nOut, 3*nOut] = [bS, 3*nOut]
 
-    NDArray ru = (*gates)({0,0, 0,2*nOut});             // [bS, 2*nOut]
+    gruCellActivations(context, &xProj, hI, gates, nullptr, h);
+}
 
-    NDArray r  = (*gates)({0,0, 0,nOut});               // [bS, nOut]
-    NDArray u  = (*gates)({0,0, nOut,2*nOut});          // [bS, nOut]
-    NDArray c  = (*gates)({0,0, 2*nOut,3*nOut});        // [bS, nOut]
+//////////////////////////////////////////////////////////////////////////
+// x × Wx + b for all time steps at once, x [sL, bS, nIn] -> xProj [sL, bS, 3*nOut]
+static void gruProjectInputs(const NDArray* x, const NDArray* Wx, const NDArray* b, NDArray& xProj) {
 
-    // reset and update gates
-    ru += temp({0,0, 0,2*nOut});
-    ru.applyTransform(transform::Sigmoid, ru);
+    const int sL  = x->sizeAt(0);
+    const int bS  = x->sizeAt(1);
+    const int nIn = x->sizeAt(2);
 
-    // cell gate
-    c.assign(c*r + temp({0,0, 2*nOut, 3*nOut}));
-    c.applyTransform(transform::Tanh, c);
+    NDArray x2d     = x->reshape('c', {sL * bS, nIn});                              // view unless x is strided
+    NDArray xProj2d = xProj.reshape('c', {sL * bS, xProj.sizeAt(2)}, false);
 
-    // cell output
-    h->assign(u * *hI + (1.f - u) * c);
+    MmulHelper::mmul(&x2d, Wx, &xProj2d);           // [sL*bS, nIn] × [nIn, 3*nOut] = [sL*bS, 3*nOut]
+    xProj2d += *b;
 }
 
 //////////////////////////////////////////////////////////////////////////
@@ -162,14 +159,25 @@ void gruTimeLoop(sd::LaunchContext * context, const NDArray* x, const NDArray* h
     const int bS   = x->sizeAt(1);
     const int nOut = hI->sizeAt(1);
 
-    NDArray gates(h->ordering(), {bS, 3*nOut}, h->dataType(), context);
+    if(sL == 0)
+        return;
 
-    auto xSet = x->allTensorsAlongDimension({1,2});       // sub-arrays with shape [bS, nIn]
-    auto hSet = h->allTensorsAlongDimension({1,2});       // sub-arrays with shape [bS, nOut]
+    // input projection doesn't depend on recurrence, so it's done by one gemm before time loop
+    NDArray xProj('c', {sL, bS, 3*nOut}, h->dataType(), context);
+    gruProjectInputs(x, Wx, b, xProj);
+
+    // the only per step scratch, reused by every step
+    NDArray gates('c', {bS, 3*nOut}, h->dataType(), context);
+
+    auto xProjSet = xProj.allTensorsAlongDimension({1,2});   // sub-arrays with shape [bS, 3*nOut]
+    auto hSet     = h->allTensorsAlongDimension({1,2});      // sub-arrays with shape [bS, nOut]
 
     // time loop
-    for (int t = 0; t < sL; ++t)
-        gruCell(context, xSet.at(t), t == 0 ? hI : hSet.at(t-1), Wx, Wh, b, &gates, hSet.at(t));
+    for (int t = 0; t < sL; ++t) {
+        const NDArray* hPrev = t == 0 ? hI : hSet.at(t-1);
+        MmulHelper::mmul(hPrev, Wh, &gates);                   // [bS, nOut] × [nOut, 3*nOut] = [bS, 3*nOut]
+        gruCellActivations(context, xProjSet.at(t), hPrev, &gates, nullptr, hSet.at(t));
+    }
 }
 
 //////////////////////////////////////////////////////////////////////////
@@ -408,7 +416,7 @@ void gruCellBp(sd::LaunchContext* context,
     // zu = x × Wxu + hI × Whu + bu
     // r = sigmoid(zr)
     // u = sigmoid(zu)
-    // zc = x × Wxc + (r * hI) × Whc + bc
+    // zc = x × Wxc + r * (hI × Whc) + bc
     // c = tanh(zc)
     // h = (1-u)*c + u*hI
 
@@ -422,23 +430,23 @@ void gruCellBp(sd::LaunchContext* context,
     // dudzu = u*(1-u)                                                          [bS, nOut]
     // drdzr = r(1-r)                                                           [bS, nOut]
 
-    // dzcdr = (...*hI × WhcT)                                                  [bS, nOut]
+    // dzcdr = hI × Whc                                                         [bS, nOut]
 
-    // dLdzr = dLdh*dhdc*dcdzc*dzcdr*drdzr = (dLdzc*hI*r(1-r) × WhcT);          [bS, nOut]
+    // dLdzr = dLdh*dhdc*dcdzc*dzcdr*drdzr = dLdzc*(hI × Whc)*r(1-r);           [bS, nOut]
     // dLdzu = dLdh*dhdu*dudzu = dLdh*(hI-c)*u*(1-u)                            [bS, nOut]
     // dLdzc = dLdh*dhdc*dcdzc = dLdh*(1-u)*(1-c*c)                             [bS, nOut]
 
     // dLdx  = dLdzr × WxrT + dLdzu × WxuT + dLdzc × WxcT,                      [bs, nOut] × [nOut, nIn] + ... =  [bS, nIn]
 
-    // dLdhI = dLdzr × WhrT + dLdzu × WhuT + dLdzc × WhcT,                      [bs, nOut] × [nOut, nOut] + ... =  [bS, nOut]
+    // dLdhI = dLdh*u + dLdzr × WhrT + dLdzu × WhuT + (dLdzc*r) × WhcT,        [bs, nOut] × [nOut, nOut] + ... =  [bS, nOut]
 
     // dLdWxr = xT × dLdzr                          [nIn, bS] x [bS, nOut] = [nIn, nOut]
     // dLdWxu = xT × dLdzu                          [nIn, bS] x [bS, nOut] = [nIn, nOut]
     // dLdWxc = xT × dLdzc                          [nIn, bS] x [bS, nOut] = [nIn, nOut]
 
-    // dLdWhr = xT × dLdzr                          [nOut, bS] x [bS, nOut] = [nOut, nOut]
-    // dLdWhu = xT × dLdzu                          [nOut, bS] x [bS, nOut] = [nOut, nOut]
-    // dLdWhc = (r*hI)T × dLdzc                     [nOut, bS] x [bS, nOut] = [nOut, nOut]
+    // dLdWhr = hIT × dLdzr                         [nOut, bS] x [bS, nOut] = [nOut, nOut]
+    // dLdWhu = hIT × dLdzu                         [nOut, bS] x [bS, nOut] = [nOut, nOut]
+    // dLdWhc = hIT × (dLdzc*r)                     [nOut, bS] x [bS, nOut] = [nOut, nOut]
 
     // dLdbr = dLdzr.reduce_sum_along_0_axis        [bS, nOut] -> reduce -> [nOut]
     // dLdbu = dLdzu.reduce_sum_along_0_axis        [bS, nOut] -> reduce -> [nOut]
@@ -446,53 +454,34 @@ void gruCellBp(sd::LaunchContext* context,
 
     const int nOut = hI->sizeAt(1);
 
-    NDArray dLdz = gates->ulike();                      // [bS, 3*nOut]
-
-    NDArray dLdzru = dLdz({0,0, 0,2*nOut});             // [bS, 2*nOut]
-
-    NDArray dLdzr  = dLdz({0,0, 0,nOut});               // [bS, nOut]
-    NDArray dLdzu  = dLdz({0,0, nOut,2*nOut});          // [bS, nOut]
-    NDArray dLdzc  = dLdz({0,0, 2*nOut,3*nOut});        // [bS, nOut]
-
-    NDArray r  = (*gates)({0,0, 0,nOut});               // [bS, nOut]
-    NDArray u  = (*gates)({0,0, nOut,2*nOut});          // [bS, nOut]
-    NDArray c  = (*gates)({0,0, 2*nOut,3*nOut});        // [bS, nOut]
-
-    NDArray WhcT  = (*Wh)({0,0, 2*nOut,3*nOut}).transpose();
-
-    if(dLdh)
-        *dLdhI += *dLdh;
-
-    NDArray temp1 = 1 - u;                                  // [bS, nOut]
+    NDArray dLdz  = gates->ulike();                     // [bS, 3*nOut]
+    NDArray dLdzh = gates->ulike();                     // [bS, 3*nOut], as seen by hI × Wh
 
-    // dLdzc
-    dLdzc.assign(*dLdhI * temp1 * (1-c*c));                 // [bS, nOut]
+    // cell part of hI × Wh isn't kept by gruCell, so it's recomputed
+    NDArray hc('c', {hI->sizeAt(0), nOut}, gates->dataType(), context);
+    NDArray Whc = (*Wh)({0,0, 2*nOut,3*nOut});
+    MmulHelper::mmul(hI, &Whc, &hc);                        // [bS, nOut] x [nOut, nOut] = [bS, nOut]
 
-    // dLdzu
-    dLdzu.assign(*dLdhI * (*hI - c) * u * temp1);           // [bS, nOut]
-
-    // dLdzr
-    NDArray temp2 = dLdzc * (*hI) * r *(1-r);
-    MmulHelper::mmul(&temp2, &WhcT, &dLdzr);                // [bS, nOut] x [nOut, nOut] = [bS, nOut]
+    gruCellActivationsBp(context, hI, gates, &hc, dLdh, dLdhI, &dLdz, &dLdzh);
 
     // dLdx
     NDArray WxT = Wx->transpose();
     MmulHelper::mmul(&dLdz, &WxT, dLdx);                    // [bS, 3*nOut] x [3*nOut, nIn] = [bS, nIn]
 
     // dLdWx
-    *dLdWx += mmul(x->transpose(), dLdz);                   // [nIn, bS] x [bS, 3*nOut] = [nIn, 3*nOut]
+    NDArray xT = x->transpose();
+    MmulHelper::mmul(&xT, &dLdz, dLdWx, 1., 1.);            // [nIn, bS] x [bS, 3*nOut] = [nIn, 3*nOut]
 
     // dLdb
     *dLdb += dLdz.reduceAlongDimension(reduce::Sum, {0});   // [bS, 3*nOut] -> reduce -> [3*nOut];
 
-    dLdzc *= r;
-
     // dLdhI
     NDArray WhT = Wh->transpose();
-    dLdhI->assign(*dLdhI*u + mmul(dLdz, WhT));              // [bS, 3*nOut] x [3*nOut, nOut] = [bS, nOut]
+    MmulHelper::mmul(&dLdzh, &WhT, dLdhI, 1., 1.);          // [bS, 3*nOut] x [3*nOut, nOut] = [bS, nOut]
 
-    // dLdWr
-    *dLdWh += mmul(hI->transpose(), dLdz);                  // [nOut, bS] x [bS, 3*nOut] = [nOut, 3*nOut]
+    // dLdWh
+    NDArray hIT = hI->transpose();
+    MmulHelper::mmul(&hIT, &dLdzh, dLdWh, 1., 1.);          // [nOut, bS] x [bS, 3*nOut] = [nOut, 3*nOut]
 }
 
 
@@ -515,29 +504,71 @@ void gruTimeLoopBp(sd::LaunchContext * context,
     // dLdWh  gradient vs. Wc, [nOut, 3*nOut]
     // dLdb   gradient vs. b   [3*nOut]
 
-    const int sL = x->sizeAt(0);
+    const int sL   = x->sizeAt(0);
     const int bS   = x->sizeAt(1);
+    const int nIn  = x->sizeAt(2);
     const int nOut = hI->sizeAt(1);
 
-    NDArray gates(x->ordering(), {sL, bS, 3*nOut}, dLdh->dataType(), x->getContext());
-    NDArray h(x->ordering(), {sL+1, bS, nOut}, dLdh->dataType(), x->getContext());
+    if(sL == 0)
+        return;
 
-    auto xSet     = x->allTensorsAlongDimension({1,2});         // sub-arrays with shape [bS, nIn]
-    auto dLdhSet  = dLdh->allTensorsAlongDimension({1,2});      // sub-arrays with shape [bS, nOut]
+    const auto dataType = dLdh->dataType();
+
+    // ***** forward pass, activations of all steps are kept ***** //
+
+    NDArray xProj('c', {sL, bS, 3*nOut}, dataType, context);
+    gruProjectInputs(x, Wx, b, xProj);
+
+    NDArray gates('c', {sL, bS, 3*nOut}, dataType, context);
+    NDArray hc('c', {sL, bS, nOut}, dataType, context);           // cell part of hI × Wh
+    NDArray h('c', {sL+1, bS, nOut}, dataType, context);
+
+    auto xProjSet = xProj.allTensorsAlongDimension({1,2});      // sub-arrays with shape [bS, 3*nOut]
+    auto gatesSet = gates.allTensorsAlongDimension({1,2});      // sub-arrays with shape [bS, 3*nOut]
+    auto hcSet    = hc.allTensorsAlongDimension({1,2});         // sub-arrays with shape [bS, nOut]
     auto hSet     = h.allTensorsAlongDimension({1,2});          // sub-arrays with shape [bS, nOut]
-    auto gatesSet = gates.allTensorsAlongDimension({1,2});      // sub-arrays with shape [bS, nOut]
-    auto dLdxSet  = dLdx->allTensorsAlongDimension({1,2});      // sub-arrays with shape [bS, nIn]
+    auto dLdhSet  = dLdh->allTensorsAlongDimension({1,2});      // sub-arrays with shape [bS, nOut]
 
     hSet.at(0)->assign(hI);
 
-    // forward time loop
-    for (int t = 0; t < sL; ++t)
-        gruCell(context, xSet.at(t), hSet.at(t), Wx, Wh, b, gatesSet.at(t), hSet.at(t+1));
+    for (int t = 0; t < sL; ++t) {
+        MmulHelper::mmul(hSet.at(t), Wh, gatesSet.at(t));       // [bS, nOut] × [nOut, 3*nOut] = [bS, 3*nOut]
+        gruCellActivations(context, xProjSet.at(t), hSet.at(t), gatesSet.at(t), hcSet.at(t), hSet.at(t+1));
+    }
+
+    // ***** backward pass, only recurrence dLdhI is computed per step ***** //
+
+    // gradients vs. gates pre-activations of all steps, xProj buffer isn't needed any more and holds dLdz
+    NDArray& dLdz = xProj;
+    NDArray dLdzh('c', {sL, bS, 3*nOut}, dataType, context);
+    auto dLdzSet  = dLdz.allTensorsAlongDimension({1,2});       // sub-arrays with shape [bS, 3*nOut]
+    auto dLdzhSet = dLdzh.allTensorsAlongDimension({1,2});      // sub-arrays with shape [bS, 3*nOut]
+
+    const NDArray WhT = Wh->transpose();
+
+    for (int t = sL-1; t >= 0; --t) {
+        gruCellActivationsBp(context, hSet.at(t), gatesSet.at(t), hcSet.at(t), dLdhSet.at(t), dLdhI, dLdzSet.at(t), dLdzhSet.at(t));
+        MmulHelper::mmul(dLdzhSet.at(t), &WhT, dLdhI, 1., 1.);   // [bS, 3*nOut] x [3*nOut, nOut] = [bS, nOut]
+    }
+
+    // ***** weights, biases and input gradients don't depend on recurrence, each one is done by single gemm/reduction over all steps ***** //
+
+    NDArray dLdz2d  = dLdz.reshape('c', {sL * bS, 3*nOut}, false);
+    NDArray dLdzh2d = dLdzh.reshape('c', {sL * bS, 3*nOut}, false);
+    NDArray hPrevT  = h({0,sL, 0,0, 0,0}).reshape('c', {sL * bS, nOut}, false).transpose();     // [nOut, sL*bS]
+    NDArray xT      = x->reshape('c', {sL * bS, nIn}).transpose();                               // [nIn, sL*bS]
+    NDArray WxT     = Wx->transpose();
+
+    MmulHelper::mmul(&xT, &dLdz2d, dLdWx, 1., 1.);              // [nIn, sL*bS] x [sL*bS, 3*nOut] = [nIn, 3*nOut]
+    MmulHelper::mmul(&hPrevT, &dLdzh2d, dLdWh, 1., 1.);         // [nOut, sL*bS] x [sL*bS, 3*nOut] = [nOut, 3*nOut]
+    *dLdb += dLdz2d.reduceAlongDimension(reduce::Sum, {0});     // [sL*bS, 3*nOut] -> reduce -> [3*nOut]
 
-    // backward time loop
-    for (int t = sL-1; t >= 0; --t)
-        gruCellBp(context, xSet.at(t), hSet.at(t), Wx, Wh, b, dLdhSet.at(t), gatesSet.at(t),
-                  dLdxSet.at(t), dLdhI, dLdWx, dLdWh, dLdb);
+    if(dLdx->ordering() == 'c' && dLdx->ews() == 1) {
+        NDArray dLdx2d = dLdx->reshape('c', {sL * bS, nIn}, false);
+        MmulHelper::mmul(&dLdz2d, &WxT, &dLdx2d);                // [sL*bS, 3*nOut] x [3*nOut, nIn] = [sL*bS, nIn]
+    }
+    else
+        dLdx->assign(mmul(dLdz2d, WxT).reshape('c', {sL, bS, nIn}));
 }
 
 
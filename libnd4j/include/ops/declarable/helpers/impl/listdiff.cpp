@@ -20,6 +20,8 @@
 
 #include <ops/declarable/helpers/listdiff.h>
 #include <vector>
+#include <memory>
+#include <helpers/ParallelHashTable.h>
 //#include <memory>
 
 namespace sd {
@@ -27,16 +29,31 @@ namespace ops {
 namespace helpers {
     template <typename T>
     static Nd4jLong listDiffCount_(NDArray* values, NDArray* keep) {
-        Nd4jLong saved = 0L;
-        for (Nd4jLong e = 0; e < values->lengthOf(); e++) {
-            auto v = values->e<double>(e);
-            ExtraArguments extras({v, 0.0, 10.0});
-            auto idx = keep->indexReduceNumber(indexreduce::FirstIndex, &extras);
-            auto index = idx.e<Nd4jLong>(0);
-            if (index < 0)
-                saved++;
-        }
-        return saved;
+        std::unique_ptr<NDArray> tempX(values->ordering() == 'c' && values->ews() == 1 ? nullptr : new NDArray(values->dup('c')));
+        std::unique_ptr<NDArray> tempY(keep->ordering() == 'c' && keep->ews() == 1 ? nullptr : new NDArray(keep->dup('c')));
+        auto xArr = tempX ? tempX.get() : values;
+        auto y = tempY ? tempY.get() : keep;
+
+        // dup() results are synced back to host if they were computed on device
+        NDArray::preparePrimaryUse({}, {xArr, y});
+        auto x = xArr->bufferAsT<T>();
+
+        ParallelHashTable<T> table(y->bufferAsT<T>(), y->lengthOf());
+
+        auto func = PRAGMA_REDUCE_LONG {
+            int64_t saved = 0;
+            for (auto e = start; e < stop; e++)
+                if (!table.contains(x[e]))
+                    saved++;
+
+            return saved;
+        };
+
+        auto numSaved = samediff::Threads::parallel_long(func, LAMBDA_AL { return _old + _new; }, 0, values->lengthOf());
+
+        NDArray::registerPrimaryUse({}, {xArr, y});
+
+        return numSaved;
     }
 
     Nd4jLong listDiffCount(sd::LaunchContext * context, NDArray* values, NDArray* keep) {
@@ -53,22 +70,28 @@ namespace helpers {
 
     template <typename T>
     static int listDiffFunctor_(NDArray* values, NDArray* keep, NDArray* output1, NDArray* output2) {
+        std::unique_ptr<NDArray> tempX(values->ordering() == 'c' && values->ews() == 1 ? nullptr : new NDArray(values->dup('c')));
+        std::unique_ptr<NDArray> tempY(keep->ordering() == 'c' && keep->ews() == 1 ? nullptr : new NDArray(keep->dup('c')));
+        auto xArr = tempX ? tempX.get() : values;
+        auto y = tempY ? tempY.get() : keep;
 
-        std::vector<T> saved;
-        std::vector<Nd4jLong> indices;
+        // dup() results are synced back to host if they were computed on device
+        NDArray::preparePrimaryUse({}, {xArr, y});
+        auto x = xArr->bufferAsT<T>();
 
-        for (Nd4jLong e = 0; e < values->lengthOf(); e++) {
-            auto v = values->e<double>(e);
-            ExtraArguments extras({v, 0.0, 10.0});
-            NDArray idxScalar = keep->indexReduceNumber(indexreduce::FirstIndex, &extras);
-            Nd4jLong idx = idxScalar.e<Nd4jLong>(0);
+        // keep is hashed once, then values are filtered in parallel with order preserved
+        ParallelHashTable<T> table(y->bufferAsT<T>(), y->lengthOf());
 
-            if (idx < 0) {
-                saved.emplace_back(v);
-                indices.emplace_back(e);
-            }
-        }
+        std::vector<T> saved(values->lengthOf());
+        std::vector<Nd4jLong> indices(values->lengthOf());
+
+        auto numSaved = ParallelCompaction::apply(values->lengthOf(), [&](Nd4jLong e) -> bool { return !table.contains(x[e]); },
+                                                  [&](Nd4jLong e, Nd4jLong position) { saved[position] = x[e]; indices[position] = e; });
 
+        NDArray::registerPrimaryUse({}, {xArr, y});
+
+        saved.resize(numSaved);
+        indices.resize(numSaved);
 
         if (saved.size() == 0) {
 //            if (sd::ops::conditionHelper(__FILE__, __LINE__, false, 0, "ListDiff: search returned no results") != 0)
@@ -88,9 +111,9 @@ namespace helpers {
                 throw std::invalid_argument("Op validation failed");
             }
             memcpy(z0->buffer(), saved.data(), saved.size() * sizeof(T));
-            for (int e = 0; e < indices.size(); e++) {
-                z1->p(e, indices[e]);
-            }
+
+            auto tmp = NDArray(indices.data(), 'c', {(Nd4jLong) indices.size()}, sd::DataType::INT64, z1->getContext());
+            z1->assign(tmp);
         }
         return Status::OK();
     }
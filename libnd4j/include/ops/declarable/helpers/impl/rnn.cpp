@@ -21,7 +21,9 @@
 // function nnCell implements an Elman RNN cell: output = activation(Wx*x + bx  +  Wh*ht  + bh)
 
 #include<ops/declarable/helpers/rnn.h>
-#include <helpers/BlasHelper.h>
+#include <helpers/MmulHelper.h>
+#include <array/ResultSet.h>
+#include <algorithm>
 
 
 namespace sd    {
@@ -46,7 +48,7 @@ void rnnCell(sd::LaunchContext * context, const NDArray* xt, const NDArray* Wx,
 }
 
 //////////////////////////////////////////////////////////////////////////
-void rnnTimeLoop(sd::LaunchContext * context, const NDArray* x, const NDArray* Wx, const NDArray* Wh, const NDArray* b, const NDArray* h0, const NDArray* maxTimeStep, NDArray* h, NDArray* hFinal) {
+void rnnTimeLoop(sd::LaunchContext * context, const NDArray* x, const NDArray* Wx, const NDArray* Wh, const NDArray* b, const NDArray* h0, const NDArray* maxTimeStep, NDArray* h, NDArray* hFinal, const bool forward) {
 
     // x   input [time x bS x iS]
 	// Wx  input-to-hidden  weights, [iS  x nU]
@@ -58,35 +60,89 @@ void rnnTimeLoop(sd::LaunchContext * context, const NDArray* x, const NDArray* W
 
     const int time = x->sizeAt(0);
     const int bS   = x->sizeAt(1);
+    const int iS   = x->sizeAt(2);
+    const int nU   = Wh->sizeAt(0);
+
+    std::vector<int> maxSteps(bS, time);
+    if(maxTimeStep)
+        for (int e = 0; e < bS; ++e)
+            maxSteps[e] = maxTimeStep->e<int>(e);
+
+    const bool masked = time > 0 && *std::min_element(maxSteps.begin(), maxSteps.end()) < time;
+
+    if(time == 0 || *std::max_element(maxSteps.begin(), maxSteps.end()) == 0) {
+        if(h0)
+            hFinal->assign(h0);
+        else
+            *hFinal = 0.;
+        if(masked)
+            h->nullify();
+        return;
+    }
+
+    // input projections of all time steps are done by one gemm before time loop, both biases are folded into them
+    NDArray xProj('c', {time, bS, nU}, h->dataType(), context);
+    NDArray xProj2d = xProj.reshape('c', {time * bS, nU}, false);
+    NDArray x2d     = x->reshape('c', {time * bS, iS});                                 // view unless x is strided
+    MmulHelper::mmul(&x2d, Wx, &xProj2d);                                               // [time*bS x iS] × [iS x nU] = [time*bS x nU]
+    xProj2d += (*b)({{0, nU}}) + (*b)({{nU, 2*nU}});
+
+    if(!masked) {
+
+        // every sequence has full length, so each step is computed right in h
+        auto xProjSet = xProj.allTensorsAlongDimension({1,2});      // sub-arrays with shape [bS x nU]
+        auto hSet     = h->allTensorsAlongDimension({1,2});         // sub-arrays with shape [bS x nU]
+
+        const NDArray* hPrev = h0;
+
+        for (int t = 0; t < time; ++t) {
+
+            const int s = forward ? t : time - 1 - t;
+            auto ht = hSet.at(s);
+
+            if(hPrev) {
+                MmulHelper::mmul(hPrev, Wh, ht);                    // [bS x nU] × [nU x nU] = [bS x nU]
+                *ht += *xProjSet.at(s);
+            }
+            else
+                ht->assign(xProjSet.at(s));
+
+            ht->applyTransform(transform::Tanh, *ht);
+            hPrev = ht;
+        }
+
+        hFinal->assign(hPrev);
+        return;
+    }
 
-    // at first time step
+    // sequences of zero length keep initial state, the rest get their final state from the step pass at their last valid step
     if(h0)
         hFinal->assign(h0);
     else
-        *hFinal = 0.;
+        hFinal->nullify();
 
-    BlasHelper::getInstance();          // to avoid memory leak in pragma parallel loops
-    // loop through batch of inputs
-    for (int e = 0; e < bS; ++e) {
-        // loop through time steps
-        for (int t = 0; t < time; ++t) {
+    auto seqLengths = maxTimeStep->cast(sd::DataType::INT32);
 
-            int maxStep = maxTimeStep ? maxTimeStep->e<int>(e) : time;
+    // steps are computed for whole batch in double buffered scratch, step pass writes each valid row straight to its
+    // position in h, zeroes padded positions of h and zeroes scratch rows of sequences which are over
+    NDArray hStep0('c', {bS, nU}, h->dataType(), context);
+    NDArray hStep1('c', {bS, nU}, h->dataType(), context);
+    NDArray* hStep[2] = {&hStep0, &hStep1};
 
-            auto xt   = (*x)({t,t+1, e,e+1, 0,0}, true);
-            auto ht   = (*h)({t,t+1, e,e+1, 0,0}, true);
-            auto hPrev = (*hFinal)({e,e+1, 0,0}, true);                       // previous state
+    const NDArray* hPrev = h0;
 
-            if(t >= maxStep) {
-                ht = 0.;
-                if(maxStep != 0)
-                    hPrev.assign((*h)({maxStep-1,maxStep, e,e+1, 0,0}));
-            }
-            else {
-                helpers::rnnCell(context, &xt, Wx, Wh, b, &hPrev, &ht);
-                hPrev.assign(ht);
-            }
-        }
+    for (int t = 0; t < time; ++t) {
+
+        NDArray* ht = hStep[t % 2];
+
+        if(hPrev)
+            MmulHelper::mmul(hPrev, Wh, ht);                        // [bS x nU] × [nU x nU] = [bS x nU]
+        else
+            ht->nullify();
+
+        rnnMaskedStep(context, &xProj, &seqLengths, t, forward, ht, h, hFinal);
+
+        hPrev = ht;
     }
 }
 
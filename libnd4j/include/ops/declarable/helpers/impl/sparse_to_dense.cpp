@@ -22,31 +22,40 @@
 #include <ops/declarable/helpers/sparse_to_dense.h>
 #include <helpers/StringUtils.h>
 #include <helpers/ShapeUtils.h>
+#include <helpers/CooScatter.h>
+#include <memory>
 
 namespace sd {
     namespace ops {
         namespace helpers {
-            template <typename X, typename I>
-            static void fill_(const void *vvalues, const void *vindices, void *voutput, const Nd4jLong *zShapeInfo, uint8_t rank, uint64_t length) {
-                auto values = reinterpret_cast<const X*>(vvalues);
-                auto indices = reinterpret_cast<const I*>(vindices);
-                auto output = reinterpret_cast<X*>(voutput);
-
-                int coords[MAX_RANK];
-                uint64_t pos = 0;
-                for (uint64_t e = 0L; e < length; e++) {
-                    // indices come in blocks
-                    for (uint8_t p = 0; p < rank; p++) {
-                        coords[p] = indices[pos++];
-                    }
-
-                    // fill output at given coords with sparse value
-                    output[shape::getOffset(zShapeInfo, coords)] = values[e];
+            template <typename X>
+            static void fill_(const NDArray &values, const CooScatter &coo, NDArray &output, const int duplicates) {
+                auto v = values.bufferAsT<X>();
+                auto z = output.bufferAsT<X>();
+                auto zShapeInfo = output.shapeInfo();
+
+                // single value is broadcast over all coordinates
+                const bool scalar = values.lengthOf() == 1;
+                const bool plain = output.ordering() == 'c' && output.ews() == 1;
+
+                if (duplicates == 1) {
+                    // sum: every touched element is zeroed first, so default value doesn't leak into the sum
+                    coo.forEach([&](Nd4jLong row, Nd4jLong index) {
+                        z[plain ? index : shape::getIndexOffset(index, zShapeInfo)] = static_cast<X>(0);
+                    });
+
+                    coo.forEach([&](Nd4jLong row, Nd4jLong index) {
+                        z[plain ? index : shape::getIndexOffset(index, zShapeInfo)] += v[scalar ? 0 : row];
+                    });
+                } else {
+                    // last: rows are visited in original order, so the last duplicate wins
+                    coo.forEach([&](Nd4jLong row, Nd4jLong index) {
+                        z[plain ? index : shape::getIndexOffset(index, zShapeInfo)] = v[scalar ? 0 : row];
+                    });
                 }
-
             }
 
-            void compat_sparse_to_dense(const NDArray &values, const NDArray &indices, NDArray *def, NDArray &output) {
+            void compat_sparse_to_dense(const NDArray &values, const NDArray &indices, NDArray *def, NDArray &output, const int duplicates) {
                 // make sure host buffer is updated
                 values.syncToHost();
                 indices.syncToHost();
@@ -113,8 +122,17 @@ namespace sd {
                         output.syncToHost();
                     }
 
+                    CooScatter coo(indices, output.getShapeAsVector());
+                    if (coo.numInvalid() > 0)
+                        throw std::invalid_argument("compat_sparse_to_dense: some of indices are out of output bounds");
+
+                    if (values.lengthOf() != 1 && values.lengthOf() != coo.numRows())
+                        throw std::invalid_argument("compat_sparse_to_dense: number of values must be 1 or equal to number of indices");
+
+                    std::unique_ptr<NDArray> temp(values.ews() == 1 && values.ordering() == 'c' ? nullptr : new NDArray(values.dup('c')));
+
                     // write out values
-                    BUILD_DOUBLE_SELECTOR(values.dataType(), indices.dataType(), fill_, (values.buffer(), indices.buffer(), output.buffer(), output.shapeInfo(), rank, values.lengthOf()), LIBND4J_TYPES, INDEXING_TYPES);
+                    BUILD_SINGLE_SELECTOR(values.dataType(), fill_, (temp ? *temp : values, coo, output, duplicates), LIBND4J_TYPES);
                 }
                 // copy back to device, if there's any
                 output.syncToDevice();
@@ -22,6 +22,8 @@
 #include <graph/Status.h>
 #include <execution/Threads.h>
 #include <graph/Variable.h>
+#include <helpers/ParallelHashTable.h>
+#include <memory>
 
 namespace sd {
 namespace ops {
@@ -29,18 +31,17 @@ namespace helpers {
 
     template <typename T>
     static Nd4jLong uniqueCount_(NDArray* input) {
-        Nd4jLong count = 0;
+        // hash table needs plain host buffer, dup() result is synced back to host if it was computed on device
+        std::unique_ptr<NDArray> temp(input->ordering() == 'c' && input->ews() == 1 ? nullptr : new NDArray(input->dup('c')));
+        auto x = temp ? temp.get() : input;
 
-        std::vector<T> values;
+        NDArray::preparePrimaryUse({}, {x});
 
-        for (Nd4jLong e = 0; e < input->lengthOf(); e++) {
-            T v = input->e<T>(e);
-            if (std::find(values.begin(), values.end(), v) == values.end()) {
-                values.push_back(v);
-                count++;
-            }
-        }
-        return count;
+        ParallelHashTable<T> table(x->bufferAsT<T>(), x->lengthOf());
+
+        NDArray::registerPrimaryUse({}, {x});
+
+        return table.size();
     }
 
     Nd4jLong uniqueCount(sd::LaunchContext * context, NDArray* input) {
@@ -51,38 +52,43 @@ namespace helpers {
 
     template <typename T>
     static Nd4jStatus uniqueFunctor_(NDArray* input, NDArray* values, NDArray* indices, NDArray* counts) {
-    
-        std::vector<T> valuesVector;
-        MAP_IMPL<T, int> indicesMap;
-        MAP_IMPL<T, int> countsMap;
-
-        for (Nd4jLong e = 0; e < input->lengthOf(); e++) {
-            T v = input->e<T>(e);
-            if (std::find(valuesVector.begin(), valuesVector.end(), v) == valuesVector.end()) {
-                valuesVector.push_back(v);
-                indicesMap[v] = e;
-                countsMap[v] = 1;
-            }
-            else {
-                countsMap[v]++;
-            }
-        }
+        std::unique_ptr<NDArray> temp(input->ordering() == 'c' && input->ews() == 1 ? nullptr : new NDArray(input->dup('c')));
+        auto x = temp ? temp.get() : input;
+
+        NDArray::preparePrimaryUse({}, {x});
+
+        auto buffer = x->bufferAsT<T>();
+        const auto length = x->lengthOf();
+
+        ParallelHashTable<T> table(buffer, length);
+
+        const auto &firsts = table.firstIndices();
+        const auto numDistinct = table.size();
 
         auto func = PRAGMA_THREADS_FOR {
-            for (auto e = start; e < stop; e++) {
-                values->p(e, static_cast<T>(valuesVector[e]));
-                if (counts != nullptr)
-                    counts->p(e, countsMap[valuesVector[e]]);
-            }
+            for (auto e = start; e < stop; e++)
+                values->p(e, buffer[firsts[e]]);
         };
-        samediff::Threads::parallel_for(func, 0, values->lengthOf());
+        samediff::Threads::parallel_for(func, 0, numDistinct);
 
-        for (Nd4jLong e = 0; e < indices->lengthOf(); e++) {
-            auto posI = std::find(valuesVector.begin(), valuesVector.end(), input->e<T>(e));
-            auto dist = std::distance(valuesVector.begin(), posI);
-            indices->p(e, Nd4jLong(dist));//indicesMap[(*input)(e)];
+        if (counts != nullptr) {
+            auto tmp = NDArray(const_cast<Nd4jLong*>(table.counts().data()), 'c', {numDistinct}, sd::DataType::INT64, counts->getContext());
+            counts->assign(tmp);
         }
 
+        // position of every element's value among distinct values
+        std::vector<Nd4jLong> ids(length);
+        auto lookup = PRAGMA_THREADS_FOR {
+            for (auto e = start; e < stop; e++)
+                ids[e] = table.rankOf(buffer[e]);
+        };
+        samediff::Threads::parallel_for(lookup, 0, length);
+
+        auto tmp = NDArray(ids.data(), 'c', {length}, sd::DataType::INT64, indices->getContext());
+        indices->assign(tmp);
+
+        NDArray::registerPrimaryUse({}, {x});
+
         return Status::OK();
     }
 
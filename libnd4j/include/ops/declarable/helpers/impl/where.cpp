@@ -19,43 +19,48 @@
 //
 
 #include <ops/declarable/helpers/where.h>
-#include <array/NDArrayList.h>
+#include <helpers/ParallelCompaction.h>
+#include <memory>
 
 namespace sd {
     namespace ops {
         namespace helpers {
             template <typename T>
             static void __where(NDArray &condition, NDArray& output, memory::Workspace *workspace) {
-                NDArrayList list(0, true);
-                int cnt = 0;
+                auto cShapeInfo = condition.shapeInfo();
+                const int rank = condition.rankOf();
 
-                int idx[MAX_RANK];
+                // coordinates are written straight into output when it's a plain c-ordered matrix
+                std::unique_ptr<NDArray> tempZ(output.ordering() == 'c' && output.ews() == 1 ? nullptr : new NDArray('c', output.getShapeAsVector(), output.dataType(), output.getContext()));
+                auto target = tempZ ? tempZ.get() : &output;
 
-                for (Nd4jLong e = 0; e < condition.lengthOf(); e++) {
+                NDArray::preparePrimaryUse({target}, {&condition});
 
-                    shape::index2coordsCPU(0, e, condition.shapeInfo(), idx);
+                auto c = condition.bufferAsT<bool>();
+                auto z = target->bufferAsT<T>();
 
-                    auto offset = shape::getOffset(condition.shapeInfo(), idx);
+                ParallelCompaction::apply(condition.lengthOf(), [&](Nd4jLong e) -> bool { return c[shape::getIndexOffset(e, cShapeInfo)]; },
+                                          [&](Nd4jLong e, Nd4jLong position) {
+                                              Nd4jLong idx[MAX_RANK];
+                                              shape::index2coords(e, cShapeInfo, idx);
 
-                    if (condition.e<bool>(offset)) {
-                        auto array = NDArrayFactory::create_('c', {1, condition.rankOf()}, output.dataType(), output.getContext());
-                        for (int f = 0; f < condition.rankOf(); f++)
-                            array->p(f, (T) idx[f]);
+                                              for (int f = 0; f < rank; f++)
+                                                  z[position * rank + f] = static_cast<T>(idx[f]);
+                                          });
 
-                        list.write(cnt++, array);
-                    }
-                }
+                NDArray::registerPrimaryUse({target}, {&condition});
 
-                auto s = list.stack();
-                output.assign(s);
-                delete s;
+                if (tempZ)
+                    output.assign(target);
             }
             BUILD_SINGLE_TEMPLATE(template void __where,(NDArray &condition, NDArray& output, memory::Workspace *workspace), LIBND4J_TYPES);
 
             void _where(sd::LaunchContext * context, NDArray &condition, NDArray& output, memory::Workspace *workspace) {
-                condition.syncToHost();
-                BUILD_SINGLE_SELECTOR(output.dataType(), __where, (condition, output, workspace), LIBND4J_TYPES);
-                output.syncToDevice();
+                // non-bool condition is cast first: non-zero values are true, same as NDArray::e<bool>() used by shape function
+                std::unique_ptr<NDArray> tempCond(condition.dataType() == sd::DataType::BOOL ? nullptr : new NDArray(condition.cast(sd::DataType::BOOL)));
+                auto cond = tempCond ? tempCond.get() : &condition;
+
+                BUILD_SINGLE_SELECTOR(output.dataType(), __where, (*cond, output, workspace), LIBND4J_TYPES);
             }
         }
     }
@@ -30,7 +30,14 @@ namespace helpers {
 
 	void rnnCell(sd::LaunchContext * context, const NDArray* xt, const NDArray* Wx, const NDArray* Wh, const NDArray* b, const NDArray* ht_1, NDArray* ht);
 
-	void rnnTimeLoop(sd::LaunchContext * context, const NDArray* x, const NDArray* Wx, const NDArray* Wh, const NDArray* b, const NDArray* h0, const NDArray* maxTimeStep, NDArray* h, NDArray* hFinal);
+	// single pass over masked time step following hPrev × Wh gemm: on input hStep [bS x nU] holds hPrev × Wh, on output cell outputs for
+	// sequences with t < seqLengths[e] and zeros for the rest; each valid row is also written to its step of h [time x bS x nU], and to hFinal
+	// at the last valid step, padded step t of h is zeroed; xProj [time x bS x nU] is x × Wx + b, seqLengths is INT32 vector [bS]
+	void rnnMaskedStep(sd::LaunchContext * context, const NDArray* xProj, const NDArray* seqLengths, const int t, const bool forward, NDArray* hStep, NDArray* h, NDArray* hFinal);
+
+	// forward = false runs over time steps in reverse order within each sequence length, the same as applying
+	// reverse_sequence to x and to the result, but without copies
+	void rnnTimeLoop(sd::LaunchContext * context, const NDArray* x, const NDArray* Wx, const NDArray* Wh, const NDArray* b, const NDArray* h0, const NDArray* maxTimeStep, NDArray* h, NDArray* hFinal, const bool forward = true);
 
 }
 }
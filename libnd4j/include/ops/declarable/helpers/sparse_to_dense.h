@@ -26,7 +26,11 @@
 namespace sd {
     namespace ops {
         namespace helpers {
-            void compat_sparse_to_dense(const NDArray &values, const NDArray &indices, NDArray *def, NDArray &output);
+            /**
+             * Writes sparse values into dense output at given coordinates, in parallel
+             * @param duplicates - policy for repeated coordinates: 0 - last value wins, 1 - values are summed up
+             */
+            void compat_sparse_to_dense(const NDArray &values, const NDArray &indices, NDArray *def, NDArray &output, const int duplicates = 0);
         }
     }
 }
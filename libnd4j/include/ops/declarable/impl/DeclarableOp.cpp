@@ -27,6 +27,11 @@
 #include <ops/declarable/OpRegistrator.h>
 #include <exceptions/datatype_exception.h>
 #include <helpers/StringUtils.h>
+#include <helpers/HardwareCounters.h>
+#include <graph/profiling/OpCost.h>
+#include <helpers/SamplingProfiler.h>
+#include <helpers/MixedPrecision.h>
+#include <helpers/FiniteGuard.h>
 #include <cstdarg>
 
 namespace sd {
@@ -149,6 +154,50 @@ namespace sd {
             return z;
         }
 
+        Nd4jLong sd::ops::DeclarableOp::inplaceSavings(Context &ctx) {
+            auto vs = ctx.getVariableSpace();
+            if (vs == nullptr)
+                return -1;
+
+            ShapeList inSha;
+            std::vector<NDArray*> arrays;
+            for (auto p: *ctx.inputs()) {
+                auto var = ctx.variable(p);
+                if (var->variableType() != VariableType::NDARRAY || !var->hasNDArray())
+                    return -1;
+
+                arrays.emplace_back(var->getNDArray());
+                inSha.push_back(var->getNDArray()->shapeInfo());
+            }
+
+            auto outSha = this->calculateOutputShape(&inSha, ctx);
+
+            Nd4jLong bytes = outSha->size() <= arrays.size() ? 0 : -1;
+            for (int e = 0; e < outSha->size() && bytes >= 0; e++) {
+                auto array = arrays[e];
+
+                if (array->isView() || !shape::equalsTypesAndShapesSoft(outSha->at(e), array->shapeInfo())) {
+                    bytes = -1;
+                    break;
+                }
+
+                // input might be an in-place result of external variable, so buffers are compared
+                for (auto v: *vs->getExternalVariables())
+                    if (v->hasNDArray() && v->getNDArray()->getDataBuffer() == array->getDataBuffer())
+                        bytes = -1;
+
+                for (auto v: *vs->getPlaceholders())
+                    if (v->hasNDArray() && v->getNDArray()->getDataBuffer() == array->getDataBuffer())
+                        bytes = -1;
+
+                if (bytes >= 0)
+                    bytes += array->lengthOf() * array->sizeOfT();
+            }
+
+            delete outSha;
+            return bytes;
+        }
+
         int sd::ops::DeclarableOp::prepareOutputs(Context &ctx) {
             auto workspace = ctx.getWorkspace();
             GraphProfile *prof = nullptr;
@@ -165,6 +214,15 @@ namespace sd {
                 }
             }
 
+            // in-place execution planned by InplacePlanner is verified against actual arrays first
+            if (ctx.isInplace() && ctx.isInplacePlanned() && !fp) {
+                auto saved = inplaceSavings(ctx);
+                if (saved < 0)
+                    ctx.markInplace(false);
+                else if (prof != nullptr)
+                    prof->addToInplace(saved);
+            }
+
             if (ctx.isInplace()) {
                 if (Environment::getInstance().isProfiling() && node != nullptr) {
                     if (fp) {
@@ -278,6 +336,11 @@ namespace sd {
                 auto outSha = this->calculateOutputShape(&inSha, ctx);
                 results = outSha->size();
 
+                // ops returning views of their inputs push non-empty outputs by themselves, so only empty ones are created here
+                const bool views = !fp && ctx.isOutputViews() && _descriptor->allowsOutputViews();
+                if (views)
+                    canUseFastPath = false;
+
                 // optionally saving shapeTime
                 if (Environment::getInstance().isProfiling() && node != nullptr) {
                     shapeEnd = std::chrono::system_clock::now();
@@ -298,6 +361,10 @@ namespace sd {
                         // we need to check, if Z is really needed
                         std::pair<int, int> pair(ctx.nodeId(), cnt++);
 
+                        // views left from previous run will be replaced as well
+                        if (views && !shape::isEmpty(out) && shape::length(out) > 0 && !DataTypeUtils::isS(ArrayOptions::dataType(out)))
+                            continue;
+
                         if (!ctx.isValueAvailable(pair.second)) {
                             if (Environment::getInstance().isDebugAndVerbose())
                                 shape::printShapeInfoLinear("Going to create variable with shape", out);
@@ -592,9 +659,44 @@ namespace sd {
             return ND4J_STATUS_OK;
         }
 
+        void DeclarableOp::collectArrays(Context &block, int numOutputs, std::vector<NDArray*> &inputs, std::vector<NDArray*> &outputs) {
+            if (block.isFastPath()) {
+                inputs = block.fastpath_in();
+                outputs = block.isInplace() ? block.fastpath_in() : block.fastpath_out();
+                return;
+            }
+
+            auto vs = block.getVariableSpace();
+            for (int e = 0; e < (int) block.width(); e++) {
+                auto var = block.variable(e);
+                if (var != nullptr && var->variableType() == VariableType::NDARRAY)
+                    inputs.emplace_back(var->getNDArray());
+            }
+
+            for (int e = 0; e < numOutputs; e++) {
+                if (vs == nullptr || !vs->hasVariable(block.nodeId(), e))
+                    break;
+
+                auto var = vs->getVariable(block.nodeId(), e);
+                if (var->variableType() == VariableType::NDARRAY)
+                    outputs.emplace_back(var->getNDArray());
+            }
+        }
+
         Nd4jStatus sd::ops::DeclarableOp::execute(Context* block) {
             nd4j_debug("Executing op: [%s]\n", this->getOpName()->c_str());
 
+            // in NaN guard mode kernels report non-finite outputs via marker.
+            // ops executed from within other ops don't own the flag, so the outer node gets the blame
+            std::atomic<bool> nonFinite{false};
+            const bool guarded = FiniteGuard::isEnabled() && !FiniteGuard::isArmed();
+
+            // samples taken until we leave this method will be attributed to this op
+            ScopedOpMarker marker(this->getOpName()->c_str(), this->getOpHash(), block->nodeId(), -1, guarded ? &nonFinite : nullptr);
+
+            // kernels check accumulation mode of the calling thread, so Context setting is propagated here
+            MixedPrecisionScope precision(block->isFp32Accumulation() || MixedPrecision::isFp32Accumulation());
+
             std::chrono::time_point<std::chrono::system_clock> timeEnter, timeStart, timeEnd;
             Nd4jLong prepTime, outerTime;
 
@@ -615,7 +717,11 @@ namespace sd {
             // this method will allocate output NDArrays for this op
             auto numOutputs = this->prepareOutputs(*block);
 
+            CounterValues countersBefore;
             if (Environment::getInstance().isProfiling()) {
+                if (HardwareCounters::getInstance().isEnabled())
+                    countersBefore = HardwareCounters::getInstance().threadValues();
+
                 timeStart = std::chrono::system_clock::now();
                 prepTime = std::chrono::duration_cast<std::chrono::nanoseconds>(timeStart - timeEnter).count();
             }
@@ -640,11 +746,22 @@ namespace sd {
             if (!hasHelper)
                 status = this->validateAndExecute(*block);
 
+            if (guarded && status == Status::OK() && nonFinite.load()) {
+                auto message = "Op [" + *this->getOpName() + "] produced NaN/Inf values at node " + std::to_string(block->nodeId());
+                sd::LaunchContext::defaultContext()->errorReference()->setErrorCode(ND4J_STATUS_BAD_OUTPUT);
+                sd::LaunchContext::defaultContext()->errorReference()->setErrorMessage(message);
+                status = Status::CODE(ND4J_STATUS_BAD_OUTPUT, message.c_str());
+            }
+
             // optionally saving execution time
+            CounterValues counters;
             if (Environment::getInstance().isProfiling()) {
                 timeEnd = std::chrono::system_clock::now();
                 outerTime = std::chrono::duration_cast<std::chrono::nanoseconds>(timeEnd - timeStart).count();
                 block->setInnerTime(outerTime);
+
+                if (HardwareCounters::getInstance().isEnabled())
+                    counters = HardwareCounters::getInstance().threadValues() - countersBefore;
             }
 
             if (Environment::getInstance().isProfiling() && block->getVariableSpace() != nullptr) {
@@ -657,6 +774,15 @@ namespace sd {
                         p->nodeById(block->nodeId())->setPreparationTime(prepTime);
                         p->nodeById(block->nodeId())->setExecutionTime(outerTime);
                         p->nodeById(block->nodeId())->setTotalSize(memoryUsed);
+
+                        // roofline inputs: estimated flops and bytes moved, plus hardware counters if any
+                        std::vector<NDArray*> inputs, outputs;
+                        collectArrays(*block, numOutputs, inputs, outputs);
+
+                        auto node = p->nodeById(block->nodeId());
+                        node->setFlops(OpCost::flops(*this->getOpName(), inputs, outputs, *block->getIArguments()));
+                        node->setBytesMoved(OpCost::bytes(inputs, outputs));
+                        node->setCounters(counters);
                     }
                 }
             }
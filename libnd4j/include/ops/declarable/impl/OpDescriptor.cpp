@@ -146,6 +146,10 @@ namespace sd {
             return _allowsInplace;
         }
 
+        bool OpDescriptor::allowsOutputViews() {
+            return _outputViews;
+        }
+
         int OpDescriptor::getOpNum() {
             return _opNum;
         }
@@ -201,6 +205,11 @@ namespace sd {
             return this;
         }
 
+        OpDescriptor* OpDescriptor::allowOutputViews(const bool reallyAllow) {
+            _outputViews = reallyAllow;
+            return this;
+        }
+
         OpDescriptor* OpDescriptor::setAllowedInputTypes(int index, const std::vector<sd::DataType> &dtype) {
             _inputTypes[index] = dtype;
             return this;
@@ -336,7 +336,10 @@ PLATFORM_CHECK(conv2d, ENGINE_CUDA) {
     const bool badWeightsType = weights->dataType() != DataType::DOUBLE && weights->dataType() != DataType::FLOAT32 && weights->dataType() != DataType::HALF;
     const bool badBiasType    = bias == nullptr ? false : (bias->dataType() != DataType::DOUBLE && bias->dataType() != DataType::FLOAT32 && bias->dataType() != DataType::HALF);
 
-    return paddingMode != 2 && !badInputType && !badWeightsType && !badBiasType;
+    // fused activation isn't supported here
+    const bool fusedActivation = block.getIArguments()->size() > 11 && INT_ARG(11) != 0;
+
+    return paddingMode != 2 && !badInputType && !badWeightsType && !badBiasType && !fusedActivation;
 }
 
 //////////////////////////////////////////////////////////////////////////
@@ -38,7 +38,7 @@ namespace platforms {
 static void conv2dMKLDNN(const NDArray *input, const NDArray *weights,
                           const NDArray *bias, NDArray *output,
                           const int kH, const int kW, const int sH, const int sW, const int pH, const int pW, const int dH, const int dW,
-                          const int paddingMode, const int isNCHW, const int wFormat) {
+                          const int paddingMode, const int isNCHW, const int wFormat, const int activation, const double cutoff) {
 
     // mkl support weights in [oC, iC, kH, kW] format only
 
@@ -94,7 +94,11 @@ static void conv2dMKLDNN(const NDArray *input, const NDArray *weights,
 
     // operation primitive description
     dnnl::convolution_forward::desc op_desc(dnnl::prop_kind::forward_inference, dnnl::algorithm::convolution_auto, x_mkl_md, w_mkl_md, b_mkl_md, z_mkl_md, strides, dilation, padding, padding_r);
-    dnnl::convolution_forward::primitive_desc op_prim_desc(op_desc, engine);
+    // fused activation is applied by primitive to output right after convolution
+    dnnl::primitive_attr attr;
+    mkldnnUtils::setActivationPostOp(attr, activation, cutoff);
+
+    dnnl::convolution_forward::primitive_desc op_prim_desc(op_desc, attr, engine);
 
     // arguments (memory buffers) necessary for calculations
     std::unordered_map<int, dnnl::memory> args;
@@ -493,6 +497,8 @@ PLATFORM_IMPL(conv2d, ENGINE_CPU) {
     int paddingMode = INT_ARG(8);                                               // 0-VALID, 1-SAME
     bool isNCHW    = block.getIArguments()->size() > 9 ? !INT_ARG(9) : 1;       // INT_ARG(9): 0-NCHW,  1-NHWC
     int wFormat = block.getIArguments()->size() > 10 ? INT_ARG(10) : 0;         // 0 - [kH, kW, iC, oC], 1 - [oC, iC, kH, kW], 2 - [oC, kH, kW, iC]
+    int activation = block.getIArguments()->size() > 11 ? INT_ARG(11) : 0;      // fused activation, see GemmEpilogue::Activation
+    double cutoff = block.numT() > 0 ? T_ARG(0) : 0.;                           // RELU cutoff
 
     int kH = INT_ARG(0) > 0 ? INT_ARG(0) : static_cast<int>(weights->sizeAt(0)); // filter(kernel) height
     int kW = INT_ARG(1) > 0 ? INT_ARG(1) : static_cast<int>(weights->sizeAt(1)); // filter(kernel) width
@@ -508,7 +514,7 @@ PLATFORM_IMPL(conv2d, ENGINE_CPU) {
     if (bias)
         REQUIRE_TRUE(bias->rankOf() <= 2 && oC == bias->lengthOf(), 0, "CONV2D MKLDNN OP: wrong shape of array with biases, expected rank, length: <=2, %i, but got %i, %i instead !", oC, bias->rankOf(), bias->lengthOf());
 
-    conv2dMKLDNN(input, weights, bias, output, kH, kW, sH, sW, pH, pW, dH, dW, paddingMode, isNCHW, wFormat);
+    conv2dMKLDNN(input, weights, bias, output, kH, kW, sH, sW, pH, pW, dH, dW, paddingMode, isNCHW, wFormat, activation, cutoff);
 
     return Status::OK();
 }
@@ -518,6 +524,11 @@ PLATFORM_CHECK(conv2d, ENGINE_CPU) {
     auto input = INPUT_VARIABLE(0);
     auto weights = INPUT_VARIABLE(1);
 
+    // fused activation should be expressible as oneDNN post-op
+    dnnl::primitive_attr attr;
+    if(!mkldnnUtils::setActivationPostOp(attr, block.getIArguments()->size() > 11 ? INT_ARG(11) : 0, block.numT() > 0 ? T_ARG(0) : 0.))
+        return false;
+
     // conv2d is only available for float32 dtype
     return block.isUseMKLDNN() && input->dataType() == sd::DataType::FLOAT32 &&
            weights->dataType() == sd::DataType::FLOAT32;
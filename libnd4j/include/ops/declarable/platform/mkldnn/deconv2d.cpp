@@ -34,7 +34,7 @@ namespace platforms {
 //////////////////////////////////////////////////////////////////////////
 static void deconv2dMKLDNN(const NDArray* input, const NDArray* weights, const NDArray* bias, NDArray* output,
                             const int kH, const int kW, const int sH, const int sW, const int pH, const int pW, const int dH, const int dW,
-                            const int paddingMode, const bool isNCHW, const int wFormat) {
+                            const int paddingMode, const bool isNCHW, const int wFormat, const int activation, const double cutoff) {
 
     // mkl supports weights format [oC, iC, kH, kW] only
 
@@ -118,7 +118,11 @@ static void deconv2dMKLDNN(const NDArray* input, const NDArray* weights, const N
     // operation primitive description
     dnnl::deconvolution_forward::desc op_desc(dnnl::prop_kind::forward_inference, dnnl::algorithm::deconvolution_direct,
                                                 x_mkl_md, w_mkl_md, b_mkl_md, z_mkl_md, strides, dilation, padding, padding_r);
-    dnnl::deconvolution_forward::primitive_desc op_prim_desc(op_desc, engine);
+    // fused activation is applied by primitive to output right after convolution
+    dnnl::primitive_attr attr;
+    mkldnnUtils::setActivationPostOp(attr, activation, cutoff);
+
+    dnnl::deconvolution_forward::primitive_desc op_prim_desc(op_desc, attr, engine);
 
     // arguments (memory buffers) necessary for calculations
     std::unordered_map<int, dnnl::memory> args;
@@ -325,6 +329,8 @@ PLATFORM_IMPL(deconv2d, ENGINE_CPU) {
     int paddingMode = INT_ARG(8);                                               // 0-VALID, 1-SAME
     int isNCHW     = block.getIArguments()->size() > 9 ? !INT_ARG(9) : 1;       // INT_ARG(9): 0-NCHW,  1-NHWC
     int wFormat = block.getIArguments()->size() > 10 ? INT_ARG(10) : 0;         // 0 - [kH, kW, oC, iC], 1 - [iC, oC, kH, kW], 2 - [iC, kH, kW, oC]
+    int activation = block.getIArguments()->size() > 11 ? INT_ARG(11) : 0;      // fused activation, see GemmEpilogue::Activation
+    double cutoff = block.numT() > 0 ? T_ARG(0) : 0.;                           // RELU cutoff
 
     int bS, iC, iH, iW, oC, oH, oW;                             // batch size, input channels, input height/width, output channels, output height/width;
     int indIOioC, indIiH, indWoC, indWiC, indWkH, indOoH;       // corresponding indexes
@@ -340,7 +346,7 @@ PLATFORM_IMPL(deconv2d, ENGINE_CPU) {
         ConvolutionUtils::calcPadding2D(pH, pW, iH, iW, oH, oW, kH, kW, sH, sW, dH, dW);
     }
 
-    deconv2dMKLDNN(input, weights, bias, output, kH, kW, sH, sW, pH, pW, dH, dW, paddingMode, isNCHW, wFormat);
+    deconv2dMKLDNN(input, weights, bias, output, kH, kW, sH, sW, pH, pW, dH, dW, paddingMode, isNCHW, wFormat, activation, cutoff);
 
     return Status::OK();
 }
@@ -361,6 +367,11 @@ PLATFORM_CHECK(deconv2d, ENGINE_CPU) {
     const DataType zType = output->dataType();
     const DataType bType = bias != nullptr ? bias->dataType() : zType;
 
+    // fused activation should be expressible as oneDNN post-op
+    dnnl::primitive_attr attr;
+    if(!mkldnnUtils::setActivationPostOp(attr, block.getIArguments()->size() > 11 ? INT_ARG(11) : 0, block.numT() > 0 ? T_ARG(0) : 0.))
+        return false;
+
     return block.isUseMKLDNN() && (dH <= 1 && dW <= 1 && !paddingMode) &&
           (
             (xType==DataType::FLOAT32 && wType==DataType::FLOAT32 && bType==DataType::FLOAT32 && zType==DataType::FLOAT32) ||
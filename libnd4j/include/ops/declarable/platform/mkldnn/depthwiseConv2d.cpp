@@ -35,7 +35,7 @@ namespace platforms {
 //////////////////////////////////////////////////////////////////////////
 static void depthwiseConv2dMKLDNN(const NDArray* input, const NDArray* weights, const NDArray* bias, NDArray* output,
                                   const int kH, const int kW, const int sH, const int sW, const int pH, const int pW, const int dH, const int dW,
-                                  const int paddingMode, const bool isNCHW, const int wFormat) {
+                                  const int paddingMode, const bool isNCHW, const int wFormat, const int activation, const double cutoff) {
 
     // mkl supports only following case: mC = 1, oC = iC
 
@@ -136,7 +136,11 @@ static void depthwiseConv2dMKLDNN(const NDArray* input, const NDArray* weights,
     // operation primitive description
     dnnl::convolution_forward::desc op_desc(dnnl::prop_kind::forward_inference, dnnl::algorithm::convolution_auto,
                                             x_mkl_md, w_mkl_md, b_mkl_md, z_mkl_md, strides, dilation, padding, padding_r);
-    dnnl::convolution_forward::primitive_desc op_prim_desc(op_desc, engine);
+    // fused activation is applied by primitive to output right after convolution
+    dnnl::primitive_attr attr;
+    mkldnnUtils::setActivationPostOp(attr, activation, cutoff);
+
+    dnnl::convolution_forward::primitive_desc op_prim_desc(op_desc, attr, engine);
 
     // arguments (memory buffers) necessary for calculations
     std::unordered_map<int, dnnl::memory> args;
@@ -361,6 +365,8 @@ PLATFORM_IMPL(depthwise_conv2d, ENGINE_CPU) {
     int paddingMode = INT_ARG(8);                                               // 0-VALID, 1-SAME
     int isNCHW     = block.getIArguments()->size() > 9 ? !INT_ARG(9) : 1;       // INT_ARG(9): 0-NCHW,  1-NHWC
     int wFormat = block.getIArguments()->size() > 10 ? INT_ARG(10) : 0;         // 0 - [kH, kW, iC, mC], 1 - [mC, iC, kH, kW], 2 - [mC, kH, kW, iC]
+    int activation = block.getIArguments()->size() > 11 ? INT_ARG(11) : 0;      // fused activation, see GemmEpilogue::Activation
+    double cutoff = block.numT() > 0 ? T_ARG(0) : 0.;                           // RELU cutoff
 
     int bS, iC, iH, iW, mC, oC, oH, oW;                     // batch size, input channels, input height/width, channels multiplier(oC = iC*mC), output channels, output height/width
     int indIOioC, indIiH, indWmC, indWiC, indWkH, indOoH;   // corresponding indexes
@@ -375,7 +381,7 @@ PLATFORM_IMPL(depthwise_conv2d, ENGINE_CPU) {
     if (bias)
         REQUIRE_TRUE(bias->rankOf() <= 2 && oC == bias->lengthOf(), 0, "CUSTOM DEPTHWISECONV2D MKL OP: wrong shape of array with biases, expected rank, length: <=2, %i, but got %i, %i instead !", oC, bias->rankOf(), bias->lengthOf());
 
-    depthwiseConv2dMKLDNN(input, weights, bias, output, kH, kW, sH, sW, pH, pW, dH, dW, paddingMode, isNCHW, wFormat);
+    depthwiseConv2dMKLDNN(input, weights, bias, output, kH, kW, sH, sW, pH, pW, dH, dW, paddingMode, isNCHW, wFormat, activation, cutoff);
 
     return Status::OK();
 }
@@ -396,6 +402,11 @@ PLATFORM_CHECK(depthwise_conv2d, ENGINE_CPU) {
 
     const int mC = weights->sizeAt(3);
 
+    // fused activation should be expressible as oneDNN post-op
+    dnnl::primitive_attr attr;
+    if(!mkldnnUtils::setActivationPostOp(attr, block.getIArguments()->size() > 11 ? INT_ARG(11) : 0, block.numT() > 0 ? T_ARG(0) : 0.))
+        return false;
+
     return block.isUseMKLDNN() && mC == 1 &&
           (
             (xType==DataType::FLOAT32 && wType==DataType::FLOAT32 && bType==DataType::FLOAT32 && zType==DataType::FLOAT32) ||
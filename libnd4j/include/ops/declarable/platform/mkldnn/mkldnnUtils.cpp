@@ -352,6 +352,42 @@ dnnl::engine& getEngine(void *ptr) {
     return *eng;
 }
 
+//////////////////////////////////////////////////////////////////////////
+bool setActivationPostOp(dnnl::primitive_attr& attr, const int activation, const double cutoff) {
+
+    dnnl::algorithm algorithm;
+    float alpha = 0.f;
+
+    switch (activation) {
+        case GemmEpilogue::NONE:
+            return true;
+        case GemmEpilogue::RELU:
+            if (cutoff != 0.)
+                return false;
+            algorithm = dnnl::algorithm::eltwise_relu;
+            break;
+        case GemmEpilogue::GELU:
+            // x * sigmoid(1.702 * x), same approximation as transform::GELU
+            algorithm = dnnl::algorithm::eltwise_swish;
+            alpha = 1.702f;
+            break;
+        case GemmEpilogue::TANH:
+            algorithm = dnnl::algorithm::eltwise_tanh;
+            break;
+        case GemmEpilogue::SIGMOID:
+            algorithm = dnnl::algorithm::eltwise_logistic;
+            break;
+        default:
+            return false;
+    }
+
+    dnnl::post_ops po;
+    po.append_eltwise(1.f, algorithm, alpha, 0.f);
+    attr.set_post_ops(po);
+
+    return true;
+}
+
 
 /*
 //////////////////////////////////////////////////////////////////////////
@@ -28,6 +28,7 @@
 #include <dnnl.hpp>
 #include <helpers/MKLDNNStream.h>
 #include <graph/Context.h>
+#include <helpers/GemmEpilogue.h>
 #include <ops/declarable/PlatformHelper.h>
 #include <system/platform_boilerplate.h>
 
@@ -117,6 +118,12 @@ namespace sd {
 
         dnnl::engine& getEngine(void* ptr);
 
+        /**
+        * This function appends fused activation (see GemmEpilogue::Activation) to primitive attributes as eltwise post-op
+        * @return false if activation can't be expressed by oneDNN eltwise, e.g. RELU with non-zero cutoff
+        */
+        bool setActivationPostOp(dnnl::primitive_attr& attr, const int activation, const double cutoff);
+
         /**
         * This function creates memory dimentions
         * @param const pointer to array
@@ -23,6 +23,7 @@
 #include <ops/declarable/OpRegistrator.h>
 #include <system/platform_boilerplate.h>
 #include <helpers/MKLDNNStream.h>
+#include <helpers/GemmEpilogue.h>
 #include "mkldnnUtils.h"
 
 using namespace dnnl;
@@ -32,7 +33,7 @@ namespace sd {
         namespace platforms {
 
             //////////////////////////////////////////////////////////////////////
-            static void xwPlusBiasMKLDNN(const NDArray* x, const NDArray* weights, const NDArray* bias, NDArray* z, const bool bShouldTransp) {
+            static void xwPlusBiasMKLDNN(const NDArray* x, const NDArray* weights, const NDArray* bias, NDArray* z, const bool bShouldTransp, const bool relu) {
 
                 // mkl works with following
                 // [M,K]     x [N,K]^T  + [N]   = [M,N]
@@ -105,7 +106,15 @@ namespace sd {
                 // operation primitive description
                 dnnl::inner_product_forward::desc op_desc(dnnl::prop_kind::forward_inference, x_mkl_md, weights_mkl_md, bias_mkl_md, z_mkl_md);
 
-                dnnl::inner_product_forward::primitive_desc op_prim_desc(op_desc, engine);
+                // fused relu is applied by inner product itself, as post-op
+                dnnl::primitive_attr attr;
+                if (relu) {
+                    dnnl::post_ops po;
+                    po.append_eltwise(1.f, dnnl::algorithm::eltwise_relu, 0.f, 0.f);
+                    attr.set_post_ops(po);
+                }
+
+                dnnl::inner_product_forward::primitive_desc op_prim_desc(op_desc, attr, engine);
 
                 // arguments (memory buffers) necessary for calculations
                 std::unordered_map<int, dnnl::memory> args;
@@ -284,8 +293,10 @@ namespace sd {
                 REQUIRE_TRUE(1 == b->rankOf() && b->lengthOf() == z->sizeAt(-1), 0, "xw_plus_b MKL: Input bias vector should be 1D and have proper dimension 1x%i."
                     " But got rank %i, and got length %i instead %i.", z->sizeAt(-1), b->rankOf(), b->lengthOf(), z->sizeAt(-1));
 
+                const bool relu = block.getIArguments()->size() > 1 && INT_ARG(1) == GemmEpilogue::RELU;
+
                 // mkldnnInerPorductss
-                xwPlusBiasMKLDNN(x, w, b, z, bShouldTransp);
+                xwPlusBiasMKLDNN(x, w, b, z, bShouldTransp, relu);
 
                 return Status::OK();
             }
@@ -302,6 +313,11 @@ namespace sd {
                 const DataType bType = b->dataType();
                 const DataType zType = z->dataType();
 
+                // among fused activations only plain relu (zero cutoff) has mkldnn post-op, the rest is handled by generic implementation
+                if (block.getIArguments()->size() > 1 && INT_ARG(1) != GemmEpilogue::NONE &&
+                    (INT_ARG(1) != GemmEpilogue::RELU || (block.numT() > 0 && T_ARG(0) != 0.0)))
+                    return false;
+
                 /*
                 Source    Weights   Destination         Bias
                 f32 	    f32 	f32 	            f32
@@ -29,6 +29,7 @@
 #include <ops/declarable/CustomOperations.h>
 #include <types/types.h>
 #include <helpers/Loops.h>
+#include <helpers/MixedPrecision.h>
 
 namespace sd {
 /**
@@ -348,6 +349,23 @@ void SpecialMethods<T>::splitCpuGeneric(const NDArray& input, const std::vector<
 }
 
 
+    // N-way reductions process output by tiles: accumulator tile stays in L1 while all inputs are added into it,
+    // instead of walking over all inputs for every single element. Half types are accumulated in FLOAT32
+    static const Nd4jLong ACCUMULATION_TILE = 2048;
+
+    template <typename T>
+    static FORCEINLINE void accumulateTile(T **x, int n, Nd4jLong first, Nd4jLong width, typename AccumulatorType<T>::type *acc) {
+        typedef typename AccumulatorType<T>::type A;
+
+        for (int ar = 0; ar < n; ar++) {
+            auto xa = x[ar] + first;
+
+            PRAGMA_OMP_SIMD
+            for (Nd4jLong i = 0; i < width; i++)
+                acc[i] += static_cast<A>(xa[i]);
+        }
+    }
+
 /**
  * This kernel accumulates X arrays, and stores result into Z
  *
@@ -359,18 +377,29 @@ void SpecialMethods<T>::splitCpuGeneric(const NDArray& input, const std::vector<
  */
     template<typename T>
     void SpecialMethods<T>::accumulateGeneric(void **vx, void *vz, Nd4jLong const* zShapeInfo, int n, const Nd4jLong length) {
+        typedef typename AccumulatorType<T>::type A;
+
         auto z = reinterpret_cast<T *>(vz);
         auto x = reinterpret_cast<T **>(vx);
 
         auto func = PRAGMA_THREADS_FOR {
-            for (auto i = start; i < stop; i++) {
-                for (auto ar = 0L; ar < n; ar++) {
-                    z[i] += x[ar][i];
-                }
+            A acc[ACCUMULATION_TILE];
+
+            for (auto tile = start; tile < stop; tile++) {
+                auto first = tile * ACCUMULATION_TILE;
+                auto width = sd::math::nd4j_min<Nd4jLong>(ACCUMULATION_TILE, length - first);
+
+                for (Nd4jLong i = 0; i < width; i++)
+                    acc[i] = static_cast<A>(z[first + i]);
+
+                accumulateTile<T>(x, n, first, width, acc);
+
+                for (Nd4jLong i = 0; i < width; i++)
+                    z[first + i] = static_cast<T>(acc[i]);
             }
         };
 
-        samediff::Threads::parallel_for(func, 0, length);
+        samediff::Threads::parallel_for(func, 0, (length + ACCUMULATION_TILE - 1) / ACCUMULATION_TILE);
     }
 
 
@@ -386,52 +415,36 @@ void SpecialMethods<T>::splitCpuGeneric(const NDArray& input, const std::vector<
  */
     template<typename T>
     void SpecialMethods<T>::averageGeneric(void **vx, void *vz, Nd4jLong const* zShapeInfo, int n, const Nd4jLong length, bool propagate) {
-        auto z = reinterpret_cast<T *>(vz);
+        typedef typename AccumulatorType<T>::type A;
+
         auto x = reinterpret_cast<T **>(vx);
 
-        if (z == nullptr) {
-            //code branch for absent Z
-            z = x[0];
+        // if Z is absent, result goes to the first input
+        auto z = vz == nullptr ? x[0] : reinterpret_cast<T *>(vz);
 
-            PRAGMA_OMP_SIMD
-            for (uint64_t i = 0; i < length; i++) {
-                z[i] /= static_cast<T>(n);
-            }
+        auto func = PRAGMA_THREADS_FOR {
+            A acc[ACCUMULATION_TILE];
 
-            auto func = PRAGMA_THREADS_FOR {
-                for (auto i = start; i < stop; i++) {
-                    for (Nd4jLong ar = 1; ar < n; ar++) {
-                        z[i] += x[ar][i] / static_cast<T>(n);
-                    }
-                }
-            };
-            samediff::Threads::parallel_for(func, 0, length);
+            for (auto tile = start; tile < stop; tile++) {
+                auto first = tile * ACCUMULATION_TILE;
+                auto width = sd::math::nd4j_min<Nd4jLong>(ACCUMULATION_TILE, length - first);
 
-            // instead of doing element-wise propagation, we just issue memcpy to propagate data
-            for (Nd4jLong ar = 1; ar < n; ar++) {
-                memcpy(x[ar], z, length * sizeof(T));
-            }
-        } else {
-            // code branch for existing Z
+                for (Nd4jLong i = 0; i < width; i++)
+                    acc[i] = static_cast<A>(0);
 
-            // memset before propagation
-            memset(z, 0, length * sizeof(T));
+                accumulateTile<T>(x, n, first, width, acc);
 
-            // aggregation step
-            auto func = PRAGMA_THREADS_FOR {
-                for (auto i = start; i < stop; i++) {
-                    for (Nd4jLong ar = 0; ar < n; ar++) {
-                        z[i] += x[ar][i] / static_cast<T>(n);
-                    }
-                }
-            };
-            samediff::Threads::parallel_for(func, 0, length);
+                for (Nd4jLong i = 0; i < width; i++)
+                    z[first + i] = static_cast<T>(acc[i] / static_cast<A>(n));
 
-            // instead of doing element-wise propagation, we just issue memcpy to propagate data
-            for (Nd4jLong ar = 0; ar < n; ar++) {
-                memcpy(x[ar], z, length * sizeof(T));
+                // result is propagated to inputs while tile is still in cache
+                for (int ar = 0; ar < n; ar++)
+                    if (x[ar] != z)
+                        memcpy(x[ar] + first, z + first, width * sizeof(T));
             }
-        }
+        };
+
+        samediff::Threads::parallel_for(func, 0, (length + ACCUMULATION_TILE - 1) / ACCUMULATION_TILE);
     }
 
     template <typename T>
@@ -566,6 +579,12 @@ PRAGMA_OMP_SINGLE_ARGS(nowait)
     }
 
 
+    static FORCEINLINE int countBits(uint32_t v) {
+        v = v - ((v >> 1) & 0x55555555);
+        v = (v & 0x33333333) + ((v >> 2) & 0x33333333);
+        return static_cast<int>((((v + (v >> 4)) & 0x0F0F0F0F) * 0x01010101) >> 24);
+    }
+
     template<typename T>
     void SpecialMethods<T>::decodeBitmapGeneric(const void *dx, Nd4jLong N, void *vz, Nd4jLong const* zShapeInfo) {
         auto dz = reinterpret_cast<T *>(vz);
@@ -576,26 +595,40 @@ PRAGMA_OMP_SINGLE_ARGS(nowait)
         fb.i_ = x[2];
         float threshold = fb.f_;
 
-        auto pPos = -1;
+        const T t(threshold);
+        const T thalf(threshold / 2);
+        const T zero(0.0f);
+
+        if (x[3] == BITMAP_RLE_ENCODING) {
+            decodeBitmapRle(x, N, dz, threshold);
+            return;
+        }
 
         auto func = PRAGMA_THREADS_FOR {
             for (auto e = start; e < stop; e++) {
                 const auto v = x[e];
-                for (int bitId = 0; bitId < 16; bitId++) {
-                    bool hasBit = (v & 1 << (bitId)) != 0;
-                    bool hasSign = (v & 1 << (bitId + 16)) != 0;
-                    auto cPos = (e - 4) * 16 + bitId;
-
-                    if (hasBit) {
-                        if (hasSign)
-                            dz[cPos] -= static_cast<T>(threshold);
-                        else
-                            dz[cPos] += static_cast<T>(threshold);
-                    } else if (hasSign) {
-                        dz[cPos] -= static_cast<T>(threshold / 2);
+
+                // sparse updates leave most of words empty
+                if (v == 0)
+                    continue;
+
+                auto z = dz + (e - 4) * 16;
+
+                if ((e - 4) * 16 + 16 <= N) {
+                    PRAGMA_OMP_SIMD
+                    for (int bitId = 0; bitId < 16; bitId++) {
+                        const bool hasBit = (v >> bitId) & 1;
+                        const bool hasSign = (v >> (bitId + 16)) & 1;
+
+                        z[bitId] += hasBit ? (hasSign ? -t : t) : (hasSign ? -thalf : zero);
                     }
+                } else {
+                    for (int bitId = 0; bitId < N - (e - 4) * 16; bitId++) {
+                        const bool hasBit = (v >> bitId) & 1;
+                        const bool hasSign = (v >> (bitId + 16)) & 1;
 
-                    pPos = cPos;
+                        z[bitId] += hasBit ? (hasSign ? -t : t) : (hasSign ? -thalf : zero);
+                    }
                 }
             }
         };
@@ -604,57 +637,149 @@ PRAGMA_OMP_SINGLE_ARGS(nowait)
     }
 
     template<typename T>
-    Nd4jLong SpecialMethods<T>::encodeBitmapGeneric(void *vx, Nd4jLong const* xShapeInfo, Nd4jLong N, int *dz, float threshold) {
+    Nd4jLong SpecialMethods<T>::encodeBitmapGeneric(void *vx, Nd4jLong const* xShapeInfo, Nd4jLong N, int *dz, float threshold, bool rle) {
         auto dx = reinterpret_cast<T *>(vx);
         const T two(2.0f);
         const T zero(0.0f);
         const T t(threshold);
         const T thalf = t / two;
 
-        //auto func = PRAGMA_REDUCE_LONG {
-            Nd4jLong retVal = 0L;
+        // each thread packs whole 16-element groups: all lanes are compared first, and then folded into bits,
+        // so there are no branches within the group and residuals are updated with selects only
+        auto func = PRAGMA_REDUCE_LONG {
+            int64_t cnt = 0;
+
+            for (auto g = start; g < stop; g++) {
+                auto x = dx + g * 16;
+                int width = sd::math::nd4j_min<Nd4jLong>(16, N - g * 16);
 
-            PRAGMA_OMP_PARALLEL_FOR_REDUCTION(+:retVal)
-            for (auto x = 0; x < N; x += 16) {
-                int byte = 0;
-                int byteId = x / 16 + 4;
+                uint32_t bits = 0;
+                uint32_t signs = 0;
 
-                for (int f = 0; f < 16; f++) {
-                    auto e = x + f;
+                if (width == 16) {
+                    PRAGMA_OMP_SIMD_ARGS(reduction(|:bits,signs))
+                    for (int f = 0; f < 16; f++) {
+                        const T val = x[f];
+                        const T abs = sd::math::nd4j_abs<T>(val);
 
-                    if (e >= N)
-                        continue;
+                        const bool hit = abs >= t;
+                        const bool half = !hit && abs >= thalf && val < zero;
 
-                    T val = dx[e];
-                    T abs = sd::math::nd4j_abs<T>(val);
+                        bits |= static_cast<uint32_t>(hit) << f;
+                        signs |= static_cast<uint32_t>((hit && val < zero) || half) << f;
 
-                    int bitId = e % 16;
+                        x[f] = val + (hit ? (val < zero ? t : -t) : (half ? thalf : zero));
+                    }
+                } else {
+                    for (int f = 0; f < width; f++) {
+                        const T val = x[f];
+                        const T abs = sd::math::nd4j_abs<T>(val);
 
-                    if (abs >= t) {
-                        byte |= 1 << (bitId);
-                        retVal++;
+                        const bool hit = abs >= t;
+                        const bool half = !hit && abs >= thalf && val < zero;
 
-                        if (val < zero) {
-                            byte |= 1 << (bitId + 16);
-                            dx[e] += t;
-                        } else {
-                            dx[e] -= t;
-                        }
-                    } else if (abs >= thalf && val < zero) {
-                        byte |= 1 << (bitId + 16);
-                        dx[e] += thalf;
+                        bits |= static_cast<uint32_t>(hit) << f;
+                        signs |= static_cast<uint32_t>((hit && val < zero) || half) << f;
 
-                        retVal++;
+                        x[f] = val + (hit ? (val < zero ? t : -t) : (half ? thalf : zero));
                     }
                 }
 
-                dz[byteId] = byte;
+                // sign bit without value bit means -threshold/2
+                cnt += countBits(bits) + countBits(signs & ~bits);
+                dz[g + 4] = static_cast<int>(bits | (signs << 16));
             }
 
-            return retVal;
-        //};
+            return cnt;
+        };
+
+        auto retVal = samediff::Threads::parallel_long(func, LAMBDA_AL { return _old + _new; }, 0, (N + 15) / 16);
 
-        //return samediff::Threads::parallel_long(func, LAMBDA_SUML, 0, N, 16);
+        // very sparse bitmap is cheaper to send as list of positions, same pass gives the count needed to decide
+        if (rle)
+            encodeBitmapRle(dz, N, retVal);
+
+        return retVal;
+    }
+
+    template<typename T>
+    bool SpecialMethods<T>::encodeBitmapRle(int *dz, Nd4jLong N, Nd4jLong count) {
+        // every position takes at least one byte, while bitmap takes 4 bytes per 16 elements
+        if (count >= N / 16)
+            return false;
+
+        auto words = (N + 15) / 16;
+        auto capacity = static_cast<size_t>(N / 16) * 4;
+
+        std::vector<uint8_t> payload;
+        payload.reserve(static_cast<size_t>(count) * 2);
+
+        Nd4jLong last = -1;
+        for (Nd4jLong w = 0; w < words; w++) {
+            auto word = static_cast<uint32_t>(dz[w + 4]);
+            if (word == 0)
+                continue;
+
+            for (int bitId = 0; bitId < 16; bitId++) {
+                uint32_t code = ((word >> bitId) & 1) | (((word >> (bitId + 16)) & 1) << 1);
+                if (code == 0)
+                    continue;
+
+                auto position = w * 16 + bitId;
+
+                // varint of zeros run length, 2 lower bits keep the value code
+                auto value = (static_cast<uint64_t>(position - last - 1) << 2) | code;
+                while (value >= 0x80) {
+                    payload.emplace_back(static_cast<uint8_t>(value | 0x80));
+                    value >>= 7;
+                }
+                payload.emplace_back(static_cast<uint8_t>(value));
+
+                last = position;
+            }
+
+            if (payload.size() > capacity)
+                return false;
+        }
+
+        dz[3] = BITMAP_RLE_ENCODING;
+        dz[4] = static_cast<int>(payload.size());
+        if (!payload.empty())
+            memcpy(dz + 5, payload.data(), payload.size());
+
+        return true;
+    }
+
+    template<typename T>
+    void SpecialMethods<T>::decodeBitmapRle(const int *dx, Nd4jLong N, T *dz, float threshold) {
+        const T t(threshold);
+        const T thalf(threshold / 2);
+
+        auto payload = reinterpret_cast<const uint8_t*>(dx + 5);
+        auto length = static_cast<Nd4jLong>(dx[4]);
+
+        Nd4jLong position = -1;
+        for (Nd4jLong e = 0; e < length; ) {
+            uint64_t value = 0;
+            int shift = 0;
+            uint8_t byte;
+            do {
+                byte = payload[e++];
+                value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+                shift += 7;
+            } while ((byte & 0x80) != 0 && e < length);
+
+            position += static_cast<Nd4jLong>(value >> 2) + 1;
+            if (position >= N)
+                break;
+
+            switch (value & 3) {
+                case 1: dz[position] += t; break;
+                case 3: dz[position] -= t; break;
+                case 2: dz[position] -= thalf; break;
+                default: break;
+            }
+        }
     }
 }
 
@@ -30,6 +30,11 @@
 #include <system/pointercast.h>
 #include <vector>
 
+// values of flag at index 3 of encoded bitmap header
+#define BITMAP_ENCODING 1
+// native only: produced by encode_bitmap with rle argument on CPU, not exposed to ThresholdCompression consumers
+#define BITMAP_RLE_ENCODING 2
+
 namespace sd {
     class NDArray;
 
@@ -67,7 +72,16 @@ namespace sd {
         static void sortTadGeneric(void *x, const Nd4jLong *xShapeInfo, int *dimension, int dimensionLength, const Nd4jLong *tadShapeInfo, const Nd4jLong *tadOffsets, bool descending);
 
         static void decodeBitmapGeneric(const void *dx, Nd4jLong N, void *dz, const Nd4jLong *zShapeInfo);
-        static Nd4jLong encodeBitmapGeneric(void *dx, const Nd4jLong *zShapeInfo, Nd4jLong N, int *dz, float threshold);
+        static Nd4jLong encodeBitmapGeneric(void *dx, const Nd4jLong *zShapeInfo, Nd4jLong N, int *dz, float threshold, bool rle = false);
+
+        /**
+         * These methods convert encoded bitmap into list of non-zero positions: varint of zeros run length,
+         * shifted left by 2, with value code in 2 lower bits (1: +threshold, 3: -threshold, 2: -threshold/2).
+         * Payload length in bytes is kept at dz[4], and payload starts at dz[5].
+         * Conversion happens only if list fits into the bitmap buffer: flag at dz[3] is changed to BITMAP_RLE_ENCODING then.
+         */
+        static bool encodeBitmapRle(int *dz, Nd4jLong N, Nd4jLong count);
+        static void decodeBitmapRle(const int *dx, Nd4jLong N, T *dz, float threshold);
 
     };
 
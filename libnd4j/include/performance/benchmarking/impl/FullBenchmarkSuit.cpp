@@ -1819,6 +1819,76 @@ namespace sd {
     }
 
 
+    static std::string nanGuardBenchmark() {
+        std::string output;
+        BenchmarkHelper helper(wIterations, rIterations);
+        IntPowerParameters length("length", 2, 10, pairwisePowLimit, 4);      //2^10 to 2^26 in steps of 4
+        IntPowerParameters rowcol("rowcol", 2, 4, gemmRegularUpperPow, 3);
+
+        ParametersBatch batch({&length});
+        ParametersBatch gemmBatch({&rowcol});
+
+        auto generatorTransform = PARAMETRIC_D() {
+            auto ctx = new Context(1);
+            ctx->setInputArray(0, NDArrayFactory::create_<float>('c', {p.getIntParam("length")}), true);
+            ctx->setOutputArray(0, NDArrayFactory::create_<float>('c', {p.getIntParam("length")}), true);
+            return ctx;
+        };
+
+        auto generatorPairwise = PARAMETRIC_D() {
+            auto ctx = new Context(1);
+            ctx->setInputArray(0, NDArrayFactory::create_<float>('c', {p.getIntParam("length")}), true);
+            ctx->setInputArray(1, NDArrayFactory::create_<float>('c', {p.getIntParam("length")}), true);
+            ctx->setOutputArray(0, NDArrayFactory::create_<float>('c', {p.getIntParam("length")}), true);
+            return ctx;
+        };
+
+        auto generatorReduce = PARAMETRIC_D() {
+            auto ctx = new Context(1);
+            int rows = p.getIntParam("length") / 64;
+            ctx->setInputArray(0, NDArrayFactory::create_<float>('c', {rows, 64}), true);
+            ctx->setOutputArray(0, NDArrayFactory::create_<float>('c', {rows}), true);
+
+            Nd4jLong dimArg[] = {1};
+            ctx->setIArguments(dimArg, 1);
+            return ctx;
+        };
+
+        auto generatorGemm = PARAMETRIC_D() {
+            auto ctx = new Context(1);
+            int n = p.getIntParam("rowcol");
+            ctx->setInputArray(0, NDArrayFactory::create_<float>('c', {n, n}), true);
+            ctx->setInputArray(1, NDArrayFactory::create_<float>('c', {n, n}), true);
+            ctx->setOutputArray(0, NDArrayFactory::create_<float>('c', {n, n}), true);
+            return ctx;
+        };
+
+        sd::ops::tanh opTanh;
+        sd::ops::add opAdd;
+        sd::ops::reduce_sum opSum;
+        sd::ops::matmul opMatmul;
+
+        DeclarableBenchmark dbTanh(opTanh, "tanh");
+        DeclarableBenchmark dbAdd(opAdd, "add");
+        DeclarableBenchmark dbSum(opSum, "reduce_sum");
+        DeclarableBenchmark dbMatmul(opMatmul, "matmul");
+
+        // same ops with NaN guard disabled and enabled: difference should stay within noise
+        auto guardWas = Environment::getInstance().isNanGuard();
+        for (auto guard : {false, true}) {
+            Environment::getInstance().setNanGuard(guard);
+            std::string suffix = guard ? " - NaN guard on" : " - NaN guard off";
+
+            output += helper.runOperationSuit(&dbTanh, generatorTransform, batch, ("Tanh" + suffix).c_str());
+            output += helper.runOperationSuit(&dbAdd, generatorPairwise, batch, ("Pairwise Add" + suffix).c_str());
+            output += helper.runOperationSuit(&dbSum, generatorReduce, batch, ("Sum Along Dimension" + suffix).c_str());
+            output += helper.runOperationSuit(&dbMatmul, generatorGemm, gemmBatch, ("Gemm" + suffix).c_str());
+        }
+        Environment::getInstance().setNanGuard(guardWas);
+
+        return output;
+    }
+
     std::string FullBenchmarkSuit::runSuit() {
         std::string result;
 
@@ -1911,6 +1981,9 @@ namespace sd {
         nd4j_printf("Running FullBenchmarkSuite.maxPool3DBenchmark\n", "");
         result += maxPool3DBenchmark();
         start = done(start);
+        nd4j_printf("Running FullBenchmarkSuite.nanGuardBenchmark\n", "");
+        result += nanGuardBenchmark();
+        start = done(start);
 //        nd4j_printf("Running FullBenchmarkSuite.layerNormBenchmark\n", "");
 //        result += layerNormBenchmark();
 //        start = done(start);
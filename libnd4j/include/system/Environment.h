@@ -42,6 +42,8 @@ namespace sd{
         std::atomic<bool> _precBoost;
         std::atomic<bool> _useMKLDNN{true};
         std::atomic<bool> _allowHelpers{true};
+        std::atomic<bool> _fp32Accumulation{false};
+        std::atomic<bool> _nanGuard{false};
 
         std::atomic<int> _maxThreads;
         std::atomic<int> _maxMasterThreads;
@@ -51,6 +53,9 @@ namespace sd{
         std::atomic<int64_t> _maxTotalSpecialMemory{-1};
         std::atomic<int64_t> _maxDeviceMemory{-1};
 
+        // 256MB by default
+        std::atomic<int64_t> _convolutionBufferLimit{268435456L};
+
         bool _blasFallback = false;
 
 #ifdef __ND4J_EXPERIMENTAL__
@@ -100,6 +105,13 @@ namespace sd{
         int maxMasterThreads();
         void setMaxMasterThreads(int max);
 
+        /**
+         * Caps maxMasterThreads() for calling thread only, 0 removes the cap.
+         * Used to split master threads between independent tasks running concurrently
+         */
+        int localMaxMasterThreads();
+        void setLocalMaxMasterThreads(int max);
+
         /*
          * Legacy memory limits API, still used in new API as simplified version
          */
@@ -111,6 +123,12 @@ namespace sd{
         uint64_t maxSpecialMemory();
         ////////////////////////
 
+        /**
+         * Max size of temporary columns buffer of 3D convolutions, in bytes. Larger problems are processed in chunks
+         */
+        Nd4jLong convolutionBufferLimit();
+        void setConvolutionBufferLimit(Nd4jLong numBytes);
+
         /*
          * Methods for memory limits/counters
          */
@@ -133,6 +151,24 @@ namespace sd{
         bool precisionBoostAllowed();
         void allowPrecisionBoost(bool reallyAllow);
 
+        /**
+         * If enabled, HALF/BFLOAT16 reductions, gemm fallbacks and softmax accumulate in FLOAT32, and round result only once
+         */
+        bool isFp32Accumulation();
+        void setFp32Accumulation(bool reallyEnable);
+
+        /**
+         * If enabled, ops fail with error if their kernels produced NaN or Inf values
+         */
+        bool isNanGuard();
+        void setNanGuard(bool reallyEnable);
+
+        /**
+         * If enabled, profiled ops record hardware counters (Linux perf events). Stays disabled if counters aren't available
+         */
+        bool isHardwareCounters();
+        void setHardwareCounters(bool reallyEnable);
+
         bool isExperimentalBuild();
 
         bool isCPU();
@@ -81,6 +81,10 @@
         (sd::DataType::FLOAT32, float), \
         (sd::DataType::DOUBLE, double)
 
+#define HALF_TYPES \
+        (sd::DataType::BFLOAT16, bfloat16) ,\
+        (sd::DataType::HALF, float16)
+
 #define INDEXING_TYPES \
         (sd::DataType::INT32, int32_t), \
         (sd::DataType::INT64, Nd4jLong)
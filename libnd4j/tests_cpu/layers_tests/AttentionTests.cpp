@@ -216,3 +216,90 @@ TEST_F(AttentionTests, basic_multi_head_dot_product_bp_attention_with_mask) {
     delete result;
 }
  */
+
+TEST_F(AttentionTests, fused_multi_head_dot_product_attention_1) {
+    // self attention: queries, keys and values are the same array
+    auto input = NDArrayFactory::create<float>('c', {3, 4, 5});
+    auto Wq = NDArrayFactory::create<float>('c', {2, 3, 4});
+    auto Wk = NDArrayFactory::create<float>('c', {2, 3, 4});
+    auto Wv = NDArrayFactory::create<float>('c', {2, 2, 4});
+    auto Wo = NDArrayFactory::create<float>('c', {2 * 2, 6});
+    auto mask = NDArrayFactory::create<float>('c', {3, 5}, {1, 1, 1, 1, 1,  1, 1, 1, 0, 0,  1, 0, 1, 0, 1});
+
+    input.linspace(-1, 0.03);
+    Wq.linspace(0.3, -0.02);
+    Wk.linspace(-0.2, 0.015);
+    Wv.linspace(0.1, 0.01);
+    Wo.linspace(-0.5, 0.04);
+
+    sd::ops::multi_head_dot_product_attention op;
+    auto exp = op.evaluate({&input, &input, &input, &Wq, &Wk, &Wv, &Wo, &mask}, {1, 0});
+    ASSERT_EQ(Status::OK(), exp.status());
+
+    sd::ops::fused_multi_head_dot_product_attention fused;
+    auto result = fused.evaluate({&input, &input, &input, &Wq, &Wk, &Wv, &Wo, &mask}, {1});
+    ASSERT_EQ(Status::OK(), result.status());
+
+    ASSERT_TRUE(exp.at(0)->isSameShape(result.at(0)));
+    ASSERT_TRUE(exp.at(0)->equalsTo(result.at(0), 1e-5));
+}
+
+TEST_F(AttentionTests, fused_multi_head_dot_product_attention_2) {
+    // keys and values share one array
+    auto queries = NDArrayFactory::create<double>('c', {2, 4, 3});
+    auto keys = NDArrayFactory::create<double>('c', {2, 5, 6});
+    auto Wq = NDArrayFactory::create<double>('c', {3, 2, 4});
+    auto Wk = NDArrayFactory::create<double>('c', {3, 2, 5});
+    auto Wv = NDArrayFactory::create<double>('c', {3, 4, 5});
+    auto Wo = NDArrayFactory::create<double>('c', {3 * 4, 2});
+
+    queries.linspace(0.5, -0.05);
+    keys.linspace(-0.4, 0.02);
+    Wq.linspace(0.1, 0.01);
+    Wk.linspace(-0.3, 0.02);
+    Wv.linspace(0.2, -0.005);
+    Wo.linspace(-0.1, 0.03);
+
+    for (int normalization : {0, 1}) {
+        sd::ops::multi_head_dot_product_attention op;
+        auto exp = op.evaluate({&queries, &keys, &keys, &Wq, &Wk, &Wv, &Wo}, {normalization, 0});
+        ASSERT_EQ(Status::OK(), exp.status());
+
+        sd::ops::fused_multi_head_dot_product_attention fused;
+        auto result = fused.evaluate({&queries, &keys, &keys, &Wq, &Wk, &Wv, &Wo}, {normalization});
+        ASSERT_EQ(Status::OK(), result.status());
+
+        ASSERT_TRUE(exp.at(0)->isSameShape(result.at(0)));
+        ASSERT_TRUE(exp.at(0)->equalsTo(result.at(0)));
+    }
+}
+
+TEST_F(AttentionTests, fused_multi_head_dot_product_attention_3) {
+    auto queries = NDArrayFactory::create<float>('c', {10, 4, 2});
+    auto keys = NDArrayFactory::create<float>('c', {10, 4, 5});
+    auto values = NDArrayFactory::create<float>('c', {10, 3, 5});
+
+    auto Wq = NDArrayFactory::create<float>('c', {2, 3, 4});
+    auto Wk = NDArrayFactory::create<float>('c', {2, 3, 4});
+    auto Wv = NDArrayFactory::create<float>('c', {2, 3, 3});
+    auto Wo = NDArrayFactory::create<float>('c', {2 * 3, 7});
+
+    queries.linspace(0.1, 0.01);
+    keys.linspace(-0.5, 0.005);
+    values.linspace(1., -0.01);
+    Wq.linspace(-0.2, 0.02);
+    Wk.linspace(0.2, -0.01);
+    Wv.linspace(0.05, 0.01);
+    Wo.linspace(0.3, -0.01);
+
+    sd::ops::multi_head_dot_product_attention op;
+    auto exp = op.evaluate({&queries, &keys, &values, &Wq, &Wk, &Wv, &Wo}, {1, 0});
+    ASSERT_EQ(Status::OK(), exp.status());
+
+    sd::ops::fused_multi_head_dot_product_attention fused;
+    auto result = fused.evaluate({&queries, &keys, &values, &Wq, &Wk, &Wv, &Wo}, {1});
+    ASSERT_EQ(Status::OK(), result.status());
+
+    ASSERT_TRUE(exp.at(0)->isSameShape(result.at(0)));
+    ASSERT_TRUE(exp.at(0)->equalsTo(result.at(0), 1e-5));
+}
@@ -0,0 +1,221 @@
+/*******************************************************************************
+ * Copyright (c) 2020 Konduit K.K.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#include "testlayers.h"
+#include <array/NDArray.h>
+#include <ops/declarable/CustomOperations.h>
+#include <ops/declarable/helpers/convolutions.h>
+#include <execution/LaunchContext.h>
+#include <memory/Workspace.h>
+
+using namespace sd;
+
+class ConvolutionChunkingTests : public testing::Test {
+public:
+    Nd4jLong _limitWas;
+
+    ConvolutionChunkingTests() {
+        _limitWas = Environment::getInstance().convolutionBufferLimit();
+    }
+
+    ~ConvolutionChunkingTests() {
+        Environment::getInstance().setConvolutionBufferLimit(_limitWas);
+        LaunchContext::defaultContext()->setWorkspace(nullptr);
+    }
+};
+
+//////////////////////////////////////////////////////////////////////
+TEST_F(ConvolutionChunkingTests, conv3d_chunked_1) {
+    int bS=2, iD=7,iH=5,iW=6,  iC=3,oC=4,  kD=3,kH=2,kW=3,  sD=2,sH=1,sW=1,  pD=1,pH=0,pW=1,  dD=1,dH=1,dW=1;
+    int paddingMode = 0;             // VALID
+    int dataFormat  = 0;             // NCDHW
+
+    auto input   = NDArrayFactory::create<float>('c', {bS, iC, iD, iH, iW});
+    auto weights = NDArrayFactory::create<float>('c', {kD, kH, kW, iC, oC});
+    input.linspace(-1., 0.01);
+    weights.linspace(0.3, -0.005);
+
+    sd::ops::conv3dnew op;
+    auto expected = op.evaluate({&input, &weights}, {}, {kD,kH,kW,  sD,sH,sW,  pD,pH,pW,  dD,dH,dW, paddingMode, dataFormat});
+    ASSERT_EQ(Status::OK(), expected.status());
+
+    // single plane, single batch item, whole depth per chunk
+    for (Nd4jLong limit : {512L, 10368L, 20736L}) {
+        Environment::getInstance().setConvolutionBufferLimit(limit);
+
+        auto results = op.evaluate({&input, &weights}, {}, {kD,kH,kW,  sD,sH,sW,  pD,pH,pW,  dD,dH,dW, paddingMode, dataFormat});
+        ASSERT_EQ(Status::OK(), results.status());
+        ASSERT_TRUE(expected.at(0)->isSameShape(results.at(0)));
+        ASSERT_TRUE(expected.at(0)->equalsTo(results.at(0), 1e-4));
+    }
+}
+
+//////////////////////////////////////////////////////////////////////
+TEST_F(ConvolutionChunkingTests, conv3d_chunked_2) {
+    int bS=3, iD=6,iH=4,iW=4,  iC=6,oC=3,  kD=2,kH=3,kW=2,  sD=1,sH=2,sW=1,  pD=0,pH=1,pW=0,  dD=2,dH=1,dW=1;
+    int paddingMode = 0;             // VALID
+    int dataFormat  = 1;             // NDHWC
+    int wFormat     = 2;             // [oC, kD, kH, kW, iC]
+
+    auto input   = NDArrayFactory::create<float>('c', {bS, iD, iH, iW, iC});
+    auto weights = NDArrayFactory::create<float>('c', {oC, kD, kH, kW, iC});
+    auto bias    = NDArrayFactory::create<float>('c', {oC}, {0.5f, -1.f, 2.f});
+    input.linspace(0.5, -0.01);
+    weights.linspace(-0.2, 0.01);
+
+    sd::ops::conv3dnew op;
+    auto expected = op.evaluate({&input, &weights, &bias}, {}, {kD,kH,kW,  sD,sH,sW,  pD,pH,pW,  dD,dH,dW, paddingMode, dataFormat, wFormat});
+    ASSERT_EQ(Status::OK(), expected.status());
+
+    Environment::getInstance().setConvolutionBufferLimit(1024);
+
+    auto results = op.evaluate({&input, &weights, &bias}, {}, {kD,kH,kW,  sD,sH,sW,  pD,pH,pW,  dD,dH,dW, paddingMode, dataFormat, wFormat});
+    ASSERT_EQ(Status::OK(), results.status());
+    ASSERT_TRUE(expected.at(0)->isSameShape(results.at(0)));
+    ASSERT_TRUE(expected.at(0)->equalsTo(results.at(0), 1e-4));
+}
+
+//////////////////////////////////////////////////////////////////////
+TEST_F(ConvolutionChunkingTests, conv3d_bp_chunked_1) {
+    int bS=2, iD=5,iH=4,iW=5,  iC=3,oC=2,  kD=3,kH=2,kW=2,  sD=1,sH=1,sW=2,  pD=1,pH=1,pW=0,  dD=1,dH=1,dW=1;
+    int paddingMode = 0;             // VALID
+    int dataFormat  = 1;             // NDHWC
+    int wFormat     = 1;             // [oC, iC, kD, kH, kW]
+    int oD=5, oH=5, oW=2;
+
+    auto input   = NDArrayFactory::create<float>('c', {bS, iD, iH, iW, iC});
+    auto weights = NDArrayFactory::create<float>('c', {oC, iC, kD, kH, kW});
+    auto bias    = NDArrayFactory::create<float>('c', {oC}, {1.f, 2.f});
+    auto gradO   = NDArrayFactory::create<float>('c', {bS, oD, oH, oW, oC});
+    input.linspace(-0.5, 0.02);
+    weights.linspace(0.1, 0.01);
+    gradO.linspace(0.3, -0.01);
+
+    sd::ops::conv3dnew_bp op;
+    auto expected = op.evaluate({&input, &weights, &bias, &gradO}, {}, {kD,kH,kW,  sD,sH,sW,  pD,pH,pW,  dD,dH,dW, paddingMode, dataFormat, wFormat});
+    ASSERT_EQ(Status::OK(), expected.status());
+
+    for (Nd4jLong limit : {256L, 4096L}) {
+        Environment::getInstance().setConvolutionBufferLimit(limit);
+
+        auto results = op.evaluate({&input, &weights, &bias, &gradO}, {}, {kD,kH,kW,  sD,sH,sW,  pD,pH,pW,  dD,dH,dW, paddingMode, dataFormat, wFormat});
+        ASSERT_EQ(Status::OK(), results.status());
+
+        for (int e = 0; e < 3; e++) {
+            ASSERT_TRUE(expected.at(e)->isSameShape(results.at(e)));
+            ASSERT_TRUE(expected.at(e)->equalsTo(results.at(e), 1e-4));
+        }
+    }
+}
+
+//////////////////////////////////////////////////////////////////////
+TEST_F(ConvolutionChunkingTests, deconv3d_chunked_1) {
+    int bS=2, iD=3,iH=4,iW=3,  iC=3,oC=2,  kD=2,kH=3,kW=2,  sD=2,sH=1,sW=2,  pD=0,pH=1,pW=0,  dD=1,dH=1,dW=1;
+    int paddingMode = 0;             // VALID
+    int dataFormat  = 0;             // NCDHW
+
+    auto input   = NDArrayFactory::create<float>('c', {bS, iC, iD, iH, iW});
+    auto weights = NDArrayFactory::create<float>('c', {kD, kH, kW, oC, iC});
+    input.linspace(0.2, 0.03);
+    weights.linspace(-0.4, 0.02);
+
+    sd::ops::deconv3d op;
+    auto expected = op.evaluate({&input, &weights}, {}, {kD,kH,kW,  sD,sH,sW,  pD,pH,pW,  dD,dH,dW, paddingMode, dataFormat});
+    ASSERT_EQ(Status::OK(), expected.status());
+
+    for (Nd4jLong limit : {128L, 4000L}) {
+        Environment::getInstance().setConvolutionBufferLimit(limit);
+
+        auto results = op.evaluate({&input, &weights}, {}, {kD,kH,kW,  sD,sH,sW,  pD,pH,pW,  dD,dH,dW, paddingMode, dataFormat});
+        ASSERT_EQ(Status::OK(), results.status());
+        ASSERT_TRUE(expected.at(0)->isSameShape(results.at(0)));
+        ASSERT_TRUE(expected.at(0)->equalsTo(results.at(0), 1e-4));
+    }
+}
+
+//////////////////////////////////////////////////////////////////////
+TEST_F(ConvolutionChunkingTests, conv3d_direct_1) {
+    int bS=2, iD=4,iH=5,iW=4,  iC=2,oC=5,  kD=2,kH=2,kW=3,  sD=1,sH=2,sW=1,  pD=1,pH=0,pW=1,  dD=1,dH=1,dW=2;
+    int paddingMode = 0;             // VALID
+    int wFormat     = 1;             // [oC, iC, kD, kH, kW]
+
+    auto input   = NDArrayFactory::create<float>('c', {bS, iD, iH, iW, iC});
+    auto weights = NDArrayFactory::create<float>('c', {oC, iC, kD, kH, kW});
+    input.linspace(-1., 0.02);
+    weights.linspace(0.5, -0.01);
+
+    auto output = NDArrayFactory::create<float>('c', {bS, 5, 2, 2, oC});
+    ASSERT_TRUE(ops::ConvolutionUtils::conv3dDirectApplicable(&input, &weights, &output, kD, kH, kW, 0));
+
+    // NCDHW goes through columns, NDHWC through direct kernel
+    auto inputNCDHW = input.permute({0,4,1,2,3}).dup('c');
+
+    sd::ops::conv3dnew op;
+    auto expected = op.evaluate({&inputNCDHW, &weights}, {}, {kD,kH,kW,  sD,sH,sW,  pD,pH,pW,  dD,dH,dW, paddingMode, 0, wFormat});
+    ASSERT_EQ(Status::OK(), expected.status());
+
+    auto status = op.execute({&input, &weights}, {&output}, {}, {kD,kH,kW,  sD,sH,sW,  pD,pH,pW,  dD,dH,dW, paddingMode, 1, wFormat}, {});
+    ASSERT_EQ(Status::OK(), status);
+
+    ASSERT_TRUE(expected.at(0)->permute({0,2,3,4,1}).equalsTo(output, 1e-4));
+}
+
+//////////////////////////////////////////////////////////////////////
+TEST_F(ConvolutionChunkingTests, conv3d_chunked_memory_1) {
+    int bS=2, iD=8,iH=8,iW=8,  iC=4,oC=2,  kD=3,kH=3,kW=3,  sD=1,sH=1,sW=1,  pD=0,pH=0,pW=0,  dD=1,dH=1,dW=1;
+    int oD=6, oH=6, oW=6;
+
+    auto input    = NDArrayFactory::create<float>('c', {bS, iC, iD, iH, iW});
+    auto weights  = NDArrayFactory::create<float>('c', {kD, kH, kW, iC, oC});
+    auto expected = NDArrayFactory::create<float>('c', {bS, oC, oD, oH, oW});
+    auto output   = NDArrayFactory::create<float>('c', {bS, oC, oD, oH, oW});
+    input.linspace(0.1, 0.001);
+    weights.linspace(-0.1, 0.003);
+
+    const Nd4jLong planeBytes   = (Nd4jLong) iC * kD * kH * kW * oH * oW * sizeof(float);
+    const Nd4jLong columnsBytes = bS * oD * planeBytes;
+    const Nd4jLong limit        = planeBytes + 1024;
+
+    // mkl-dnn implementation doesn't use columns at all
+#ifndef HAVE_MKLDNN
+    sd::ops::conv3dnew op;
+    Nd4jLong fullUsage, chunkedUsage;
+    {
+        memory::Workspace ws(1024 * 1024);
+        LaunchContext::defaultContext()->setWorkspace(&ws);
+
+        ASSERT_EQ(Status::OK(), op.execute({&input, &weights}, {&expected}, {}, {kD,kH,kW,  sD,sH,sW,  pD,pH,pW,  dD,dH,dW, 0, 0}, {}));
+
+        LaunchContext::defaultContext()->setWorkspace(nullptr);
+        fullUsage = ws.getUsedSize() + ws.getSpilledSize();
+    }
+    {
+        Environment::getInstance().setConvolutionBufferLimit(limit);
+
+        memory::Workspace ws(1024 * 1024);
+        LaunchContext::defaultContext()->setWorkspace(&ws);
+
+        ASSERT_EQ(Status::OK(), op.execute({&input, &weights}, {&output}, {}, {kD,kH,kW,  sD,sH,sW,  pD,pH,pW,  dD,dH,dW, 0, 0}, {}));
+
+        LaunchContext::defaultContext()->setWorkspace(nullptr);
+        chunkedUsage = ws.getUsedSize() + ws.getSpilledSize();
+    }
+
+    ASSERT_TRUE(fullUsage >= columnsBytes);
+    ASSERT_TRUE(chunkedUsage < 2 * limit);
+    ASSERT_TRUE(expected.equalsTo(output, 1e-4));
+#endif
+}
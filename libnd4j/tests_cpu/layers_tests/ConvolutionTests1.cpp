@@ -2823,6 +2823,66 @@ TEST_F(ConvolutionTests1, deconv2d_test10) {
     ASSERT_TRUE(expOutput.equalsTo(output));
 }
 
+//////////////////////////////////////////////////////////////////////
+// deconv2d is the gradient of conv2d wrt its input
+TEST_F(ConvolutionTests1, deconv2d_test11) {
+
+    int bS=2, iH=3,iW=4,  iC=3,oC=4,  kH=3,kW=2,  sH=2,sW=3,  pH=1,pW=0,  dH=2,dW=1;
+    int       oH=7,oW=11;
+    int paddingMode = 0;             // 1-SAME, 0-VALID;
+    int dataFormat  = 1;             // 1-NHWC, 0-NCHW
+    int wFormat     = 1;             // 0-[kH, kW, oC, iC], [iC, oC, kH, kW], [iC, kH, kW, oC]
+
+    NDArray input('c', {bS, iH, iW, iC}, sd::DataType::FLOAT32);
+    NDArray weights('c', {iC, oC, kH, kW}, sd::DataType::FLOAT32);
+    NDArray convInput('c', {bS, oH, oW, oC}, sd::DataType::FLOAT32);
+    input.linspace(-2., 0.1);
+    weights.linspace(0.5, -0.05);
+
+    sd::ops::conv2d_bp convBP;
+    auto expected = convBP.evaluate({&convInput, &weights, &input}, {kH,kW,  sH,sW,  pH,pW,  dH,dW, paddingMode, dataFormat, wFormat});
+    ASSERT_EQ(Status::OK(), expected.status());
+
+    sd::ops::deconv2d op;
+    auto results = op.evaluate({&input, &weights}, {kH,kW,  sH,sW,  pH,pW,  dH,dW, paddingMode, dataFormat, wFormat});
+    ASSERT_EQ(Status::OK(), results.status());
+
+    ASSERT_TRUE(expected.at(0)->isSameShape(results.at(0)));
+    ASSERT_TRUE(expected.at(0)->equalsTo(results.at(0)));
+}
+
+//////////////////////////////////////////////////////////////////////
+// stride exceeds kernel, so some output pixels get bias only
+TEST_F(ConvolutionTests1, deconv2d_test12) {
+
+    int bS=1, iH=3,iW=2,  iC=2,oC=3,  kH=2,kW=2,  sH=3,sW=3,  pH=0,pW=0,  dH=1,dW=1;
+    int       oH=8,oW=5;
+    int paddingMode = 0;             // 1-SAME, 0-VALID;
+    int dataFormat  = 0;             // 1-NHWC, 0-NCHW
+    int wFormat     = 0;             // 0-[kH, kW, oC, iC], [iC, oC, kH, kW], [iC, kH, kW, oC]
+
+    NDArray input('c', {bS, iC, iH, iW}, sd::DataType::FLOAT32);
+    NDArray weights('c', {kH, kW, oC, iC}, sd::DataType::FLOAT32);
+    NDArray bias('c', {oC}, {1., -2., 3.}, sd::DataType::FLOAT32);
+    NDArray convInput('c', {bS, oC, oH, oW}, sd::DataType::FLOAT32);
+    input.linspace(1., 0.5);
+    weights.linspace(-1., 0.2);
+
+    sd::ops::conv2d_bp convBP;
+    auto gradI = convBP.evaluate({&convInput, &weights, &input}, {kH,kW,  sH,sW,  pH,pW,  dH,dW, paddingMode, dataFormat, wFormat});
+    ASSERT_EQ(Status::OK(), gradI.status());
+
+    auto expected = *gradI.at(0) + bias.reshape('c', {1, oC, 1, 1});
+
+    sd::ops::deconv2d op;
+    auto results = op.evaluate({&input, &weights, &bias}, {kH,kW,  sH,sW,  pH,pW,  dH,dW, paddingMode, dataFormat, wFormat});
+    ASSERT_EQ(Status::OK(), results.status());
+
+    ASSERT_TRUE(expected.isSameShape(results.at(0)));
+    ASSERT_TRUE(expected.equalsTo(results.at(0)));
+    ASSERT_NEAR(1.f, results.at(0)->e<float>(0, 0, 2, 0), 1e-5);
+}
+
 //////////////////////////////////////////////////////////////////////
 TYPED_TEST(TypedConvolutionTests1, deconv2d_tf_test1) {
 
@@ -2854,4 +2854,93 @@ TEST_F(ConvolutionTests2, depthwise_conv2d_bp_test7) {
     ASSERT_TRUE(expGradW.equalsTo(gradW));
 }
 
+//////////////////////////////////////////////////////////////////////
+TEST_F(ConvolutionTests2, conv2d_fused_activation_1) {
+
+    int bS=2, iH=5,iW=4,  iC=3,oC=4,  kH=3,kW=2,  sH=1,sW=1,  pH=0,pW=0,  dH=1,dW=1;
+    int paddingMode = 1;             // 1-SAME, 0-VALID;
+    int dataFormat  = 1;             // 1-NHWC, 0-NCHW
+    int wFormat     = 0;             // 0-[kH, kW, iC, oC], 1-[oC, iC, kH, kW], 2-[oC, kH, kW, iC]
+
+    NDArray input('c', {bS, iH, iW, iC}, sd::DataType::FLOAT32);
+    NDArray weights('c', {kH, kW, iC, oC}, sd::DataType::FLOAT32);
+    NDArray bias('c', {oC}, {-0.3, 0.1, -0.2, 0.4}, sd::DataType::FLOAT32);
+
+    input.linspace(-1., 0.02);
+    weights.linspace(0.1, -0.01);
+
+    sd::ops::conv2d op;
+    auto plain = op.evaluate({&input, &weights, &bias}, {kH,kW,  sH,sW,  pH,pW,  dH,dW, paddingMode, dataFormat, wFormat});
+    ASSERT_EQ(Status::OK(), plain.status());
+
+    // fused RELU with cutoff
+    auto fused = op.evaluate({&input, &weights, &bias}, {0.1}, {kH,kW,  sH,sW,  pH,pW,  dH,dW, paddingMode, dataFormat, wFormat, GemmEpilogue::RELU});
+    ASSERT_EQ(Status::OK(), fused.status());
+
+    NDArray exp = plain.at(0)->dup();
+    exp.applyScalar(scalar::RELU, 0.1, exp);
+
+    ASSERT_TRUE(exp.isSameShape(fused.at(0)));
+    ASSERT_TRUE(exp.equalsTo(fused.at(0)));
+}
+
+//////////////////////////////////////////////////////////////////////
+TEST_F(ConvolutionTests2, depthwise_conv2d_fused_activation_1) {
+
+    int bS=2, iH=4,iW=4,  iC=2,mC=2,  kH=2,kW=2,  sH=1,sW=1,  pH=0,pW=0,  dH=1,dW=1;
+    int oC=iC*mC;
+    int paddingMode = 0;             // 1-SAME, 0-VALID;
+    int dataFormat  = 0;             // 1-NHWC, 0-NCHW
+    int wFormat     = 1;             // 0-[kH, kW, iC, mC], 1-[mC, iC, kH, kW], 2-[mC, kH, kW, iC]
+
+    NDArray input('c', {bS, iC, iH, iW}, sd::DataType::FLOAT32);
+    NDArray weights('c', {mC, iC, kH, kW}, sd::DataType::FLOAT32);
+    NDArray bias('c', {oC}, {0.1, -0.1, 0.2, -0.2}, sd::DataType::FLOAT32);
+
+    input.linspace(-0.5, 0.03);
+    weights.linspace(-0.2, 0.05);
+
+    sd::ops::depthwise_conv2d op;
+    auto plain = op.evaluate({&input, &weights, &bias}, {kH,kW,  sH,sW,  pH,pW,  dH,dW, paddingMode, dataFormat, wFormat});
+    ASSERT_EQ(Status::OK(), plain.status());
+
+    auto fused = op.evaluate({&input, &weights, &bias}, {}, {kH,kW,  sH,sW,  pH,pW,  dH,dW, paddingMode, dataFormat, wFormat, GemmEpilogue::SIGMOID});
+    ASSERT_EQ(Status::OK(), fused.status());
+
+    NDArray exp = plain.at(0)->dup();
+    exp.applyTransform(transform::Sigmoid, exp);
+
+    ASSERT_TRUE(exp.isSameShape(fused.at(0)));
+    ASSERT_TRUE(exp.equalsTo(fused.at(0)));
+}
+
+//////////////////////////////////////////////////////////////////////
+TEST_F(ConvolutionTests2, deconv2d_fused_activation_1) {
+
+    int bS=2, iH=3,iW=3,  iC=2,oC=3,  kH=2,kW=2,  sH=2,sW=2,  pH=0,pW=0,  dH=1,dW=1;
+    int paddingMode = 0;             // 1-SAME, 0-VALID;
+    int dataFormat  = 1;             // 1-NHWC, 0-NCHW
+    int wFormat     = 0;             // 0-[kH, kW, oC, iC], 1-[iC, oC, kH, kW], 2-[iC, kH, kW, oC]
+
+    NDArray input('c', {bS, iH, iW, iC}, sd::DataType::FLOAT32);
+    NDArray weights('c', {kH, kW, oC, iC}, sd::DataType::FLOAT32);
+    NDArray bias('c', {oC}, {0.5, -0.5, 0.}, sd::DataType::FLOAT32);
+
+    input.linspace(-1., 0.05);
+    weights.linspace(0.3, -0.02);
+
+    sd::ops::deconv2d op;
+    auto plain = op.evaluate({&input, &weights, &bias}, {kH,kW,  sH,sW,  pH,pW,  dH,dW, paddingMode, dataFormat, wFormat});
+    ASSERT_EQ(Status::OK(), plain.status());
+
+    auto fused = op.evaluate({&input, &weights, &bias}, {}, {kH,kW,  sH,sW,  pH,pW,  dH,dW, paddingMode, dataFormat, wFormat, GemmEpilogue::TANH});
+    ASSERT_EQ(Status::OK(), fused.status());
+
+    NDArray exp = plain.at(0)->dup();
+    exp.applyTransform(transform::Tanh, exp);
+
+    ASSERT_TRUE(exp.isSameShape(fused.at(0)));
+    ASSERT_TRUE(exp.equalsTo(fused.at(0)));
+}
+
 #endif //LIBND4J_CONVOLUTIONTESTS2_H
\ No newline at end of file
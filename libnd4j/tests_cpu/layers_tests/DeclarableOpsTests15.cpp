@@ -1958,6 +1958,38 @@ TEST_F(DeclarableOpsTests15, gru_1) {
     ASSERT_TRUE(expH.equalsTo(h));
 }
 
+//////////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests15, gru_bp_1) {
+
+    const int sL = 3;
+    const int bS = 2;
+    const int nIn = 4;
+    const int nOut = 3;
+
+    NDArray x('c', {sL, bS, nIn}, sd::DataType::DOUBLE);
+    NDArray hI('c', {bS, nOut}, {-0.3,-0.2,-0.1,0.1,0.2,0.3}, sd::DataType::DOUBLE);
+    NDArray Wx('c', {nIn, 3*nOut}, sd::DataType::DOUBLE);
+    NDArray Wh('c', {nOut, 3*nOut}, sd::DataType::DOUBLE);
+    NDArray b('c', {3*nOut}, sd::DataType::DOUBLE);
+
+    NDArray dLdh('c', {sL, bS, nOut}, sd::DataType::DOUBLE);
+
+    x.linspace(-1,0.08);
+    Wx.linspace(0.5,-0.03);
+    Wh.linspace(-0.4,0.1);
+    b.linspace(0.2,-0.05);
+
+    const OpArgsHolder argsHolderFF({&x, &hI, &Wx, &Wh, &b}, {}, {});
+    const OpArgsHolder argsHolderBP({&x, &hI, &Wx, &Wh, &b, &dLdh}, {}, {});
+
+    sd::ops::gru opFF;
+    sd::ops::gru_bp opBP;
+
+    const bool isGradCorrect = GradCheck::checkGrad(opFF, opBP, argsHolderFF, argsHolderBP);
+
+    ASSERT_TRUE(isGradCorrect);
+}
+
 //////////////////////////////////////////////////////////////////////
 TEST_F(DeclarableOpsTests15, sqrtm_1) {
 
@@ -87,4 +87,67 @@ TEST_F(DeclarableOpsTests17, test_compat_string_split_1) {
     ASSERT_EQ(exp0, *z0);
     ASSERT_EQ(exp1, *z1);
 
-}
\ No newline at end of file
+}
+
+//////////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests17, test_sparse_to_dense_3) {
+    // unsorted indices: value e goes to (37 * e) % 20000, so values e and e + 20000 share a position,
+    // and linear positions from 20000 on are never hit and keep default value
+    const int numValues = 30000;
+    auto values = NDArrayFactory::create<float>('c', {numValues});
+    auto indices = NDArrayFactory::create<Nd4jLong>('c', {numValues, 2});
+    auto shape = NDArrayFactory::create<Nd4jLong>({100, 300});
+    auto def = NDArrayFactory::create<float>(-1.f);
+
+    auto expLast = NDArrayFactory::create<float>('c', {100, 300});
+    auto expSum = NDArrayFactory::create<float>('c', {100, 300});
+    expLast.assign(-1.f);
+    expSum.assign(-1.f);
+
+    std::vector<bool> touched(30000, false);
+    for (int e = 0; e < numValues; e++) {
+        const int linear = (e * 37) % 20000;
+        values.p(e, (float) (e % 100));
+        indices.p(e, 0, linear / 300);
+        indices.p(e, 1, linear % 300);
+
+        // sum policy: default value isn't part of the sum for touched positions
+        expLast.p(linear, (float) (e % 100));
+        expSum.p(linear, (touched[linear] ? expSum.e<float>(linear) : 0.f) + (float) (e % 100));
+        touched[linear] = true;
+    }
+
+    sd::ops::compat_sparse_to_dense op;
+    auto resultLast = op.evaluate({&indices, &shape, &values, &def});
+    ASSERT_EQ(Status::OK(), resultLast.status());
+    ASSERT_EQ(expLast, *resultLast.at(0));
+
+    auto resultSum = op.evaluate({&indices, &shape, &values, &def}, {}, {1});
+    ASSERT_EQ(Status::OK(), resultSum.status());
+    ASSERT_EQ(expSum, *resultSum.at(0));
+    ASSERT_EQ(-1.f, resultSum.at(0)->e<float>(99, 299));
+}
+
+//////////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests17, test_scatter_nd_add_duplicates_1) {
+    const int numRows = 30000;
+    auto input = NDArrayFactory::create<float>('c', {5000, 4});
+    auto indices = NDArrayFactory::create<int>('c', {numRows, 1});
+    auto updates = NDArrayFactory::create<float>('c', {numRows, 4});
+    input.assign(1.f);
+
+    auto exp = input.dup();
+    for (int e = 0; e < numRows; e++) {
+        const int row = (e * 7) % 5000;
+        indices.p(e, row);
+        for (int j = 0; j < 4; j++) {
+            updates.p(e, j, (float) j);
+            exp.p(row, j, exp.e<float>(row, j) + (float) j);
+        }
+    }
+
+    sd::ops::scatter_nd_add op;
+    auto result = op.evaluate({&input, &indices, &updates});
+    ASSERT_EQ(Status::OK(), result.status());
+    ASSERT_EQ(exp, *result.at(0));
+}
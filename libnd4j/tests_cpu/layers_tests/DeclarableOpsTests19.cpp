@@ -26,6 +26,9 @@
 #include <helpers/GradCheck.h>
 #include <array>
 #include <helpers/RandomLauncher.h>
+#include <ops/declarable/helpers/compression.h>
+#include <ops/specials.h>
+#include <helpers/ParallelHashTable.h>
 
 
 using namespace sd;
@@ -421,3 +424,214 @@ TEST_F(DeclarableOpsTests19, test_squeeze_1) {
     ASSERT_EQ(Status::OK(), status);
 }
 
+
+TEST_F(DeclarableOpsTests19, test_bitmap_encode_rle_1) {
+    // list of positions is built on host only
+    if (!Environment::getInstance().isCPU())
+        return;
+
+    auto initial = NDArrayFactory::create<float>('c', {1000});
+    initial.p(3, 1e-3f);
+    initial.p(17, 6e-4f);
+    initial.p(500, -1.5e-3f);
+    initial.p(999, -6e-4f);
+
+    auto residual = initial.like();
+    residual.p(17, 6e-4f);
+    residual.p(500, -5e-4f);
+    residual.p(999, -1e-4f);
+
+    auto exp = initial.like();
+    exp.p(3, 1e-3f);
+    exp.p(500, -1e-3f);
+    exp.p(999, -5e-4f);
+
+    sd::ops::encode_bitmap enc;
+    auto enc_result = enc.evaluate({&initial}, {1e-3f}, {}, {true});
+    ASSERT_EQ(Status::OK(), enc_result.status());
+
+    auto encoded = enc_result.at(1);
+    ASSERT_EQ(3, enc_result.at(2)->e<int>(0));
+    ASSERT_TRUE(residual.equalsTo(initial));
+
+    // 3 positions with gaps 3, 496 and 498 take 1 + 2 + 2 bytes
+    ASSERT_EQ(BITMAP_RLE_ENCODING, encoded->e<int>(3));
+    ASSERT_EQ(5, encoded->e<int>(4));
+
+    auto z = initial.like();
+    sd::ops::decode_bitmap dec;
+    ASSERT_EQ(Status::OK(), dec.execute({&z, encoded}, {&z}));
+    ASSERT_TRUE(exp.equalsTo(z));
+}
+
+TEST_F(DeclarableOpsTests19, test_bitmap_encode_rle_2) {
+    if (!Environment::getInstance().isCPU())
+        return;
+
+    // dense bitmap is kept as is
+    auto initial = NDArrayFactory::create<float>('c', {1000});
+    initial.linspace(-1.0, 0.002);
+    auto copy = initial.dup();
+
+    sd::ops::encode_bitmap enc;
+    auto plain = enc.evaluate({&copy}, {0.5f});
+    auto result = enc.evaluate({&initial}, {0.5f}, {}, {true});
+
+    ASSERT_EQ(BITMAP_ENCODING, result.at(1)->e<int>(3));
+    ASSERT_EQ(*plain.at(1), *result.at(1));
+    ASSERT_EQ(*plain.at(2), *result.at(2));
+}
+
+TEST_F(DeclarableOpsTests19, test_bitmap_encode_rle_3) {
+    // CUDA rejects rle instead of silently producing plain bitmap
+    if (Environment::getInstance().isCPU())
+        return;
+
+    auto x = NDArrayFactory::create<float>('c', {1000});
+    auto encoded = NDArrayFactory::create<int>('c', {1000 / 16 + 5});
+
+    ASSERT_ANY_THROW(sd::ops::helpers::encodeBitmap(x.getContext(), &x, &encoded, 1e-3f, true));
+}
+
+TEST_F(DeclarableOpsTests19, test_sign_mask_1) {
+    auto x = NDArrayFactory::create<float>('c', {11}, {-1.f, 2.f, 0.f, 3.f, -4.f, 5.f, 6.f, -0.f, 7.f, -8.f, 9.f});
+    auto positive = NDArrayFactory::create<float>('c', {11}, {0.f, 1.f, 0.f, 1.f, 0.f, 1.f, 1.f, 0.f, 1.f, 0.f, 1.f});
+    auto negative = NDArrayFactory::create<float>('c', {11}, {-1.f, 0.f, 0.f, 0.f, -1.f, 0.f, 0.f, 0.f, 0.f, -1.f, 0.f});
+
+    auto mask = NDArrayFactory::create<uint8_t>('c', {2});
+    auto z = NDArrayFactory::create<float>('c', {11});
+
+    sd::ops::helpers::encodeSignMask(x.getContext(), &x, &mask, false);
+    ASSERT_EQ(2 + 8 + 32 + 64, mask.e<int>(0));
+
+    sd::ops::helpers::decodeSignMask(x.getContext(), &mask, &z, false);
+    ASSERT_EQ(positive, z);
+
+    sd::ops::helpers::encodeSignMask(x.getContext(), &x, &mask, true);
+    sd::ops::helpers::decodeSignMask(x.getContext(), &mask, &z, true);
+    ASSERT_EQ(negative, z);
+}
+
+TEST_F(DeclarableOpsTests19, test_quantize_blocks_1) {
+    // 2.5 blocks of 256, each with own range
+    auto x = NDArrayFactory::create<float>('c', {640});
+    for (int e = 0; e < 640; e++)
+        x.p(e, (e / 256 + 1) * std::sin(0.1f * e));
+
+    auto q = NDArrayFactory::create<int8_t>('c', {640});
+    auto scales = NDArrayFactory::create<float>('c', {3});
+    auto z = NDArrayFactory::create<float>('c', {640});
+
+    sd::ops::helpers::quantizeBlocks(x.getContext(), &x, &q, &scales, 256);
+    sd::ops::helpers::dequantizeBlocks(x.getContext(), &q, &scales, &z, 256);
+
+    // rounding error is at most half of the block scale
+    for (int e = 0; e < 640; e++) {
+        ASSERT_TRUE(scales.e<float>(e / 256) <= (e / 256 + 1) / 127.f + 1e-6f);
+        ASSERT_NEAR(x.e<float>(e), z.e<float>(e), scales.e<float>(e / 256) * 0.5f + 1e-6f);
+    }
+}
+
+TEST_F(DeclarableOpsTests19, test_parallel_hash_table_1) {
+    const Nd4jLong length = 100000;
+    std::vector<float> keys(length);
+    for (Nd4jLong e = 0; e < length; e++)
+        keys[e] = static_cast<float>((length - 1 - e) % 1000);
+
+    sd::ParallelHashTable<float> table(keys.data(), length);
+
+    ASSERT_EQ(1000, table.size());
+    for (Nd4jLong e = 0; e < 1000; e++) {
+        ASSERT_EQ(e, table.firstIndices()[e]);
+        ASSERT_EQ(100, table.counts()[e]);
+        ASSERT_EQ(e, table.rankOf(static_cast<float>(999 - e)));
+    }
+
+    ASSERT_FALSE(table.contains(1000.f));
+    ASSERT_EQ(-1, table.rankOf(-1.f));
+}
+
+TEST_F(DeclarableOpsTests19, test_unique_with_counts_large_1) {
+    const int length = 20000;
+    auto x = NDArrayFactory::create<int>('c', {length});
+    for (int e = 0; e < length; e++)
+        x.p(e, (e * 7) % 3000);
+
+    sd::ops::unique_with_counts op;
+    auto result = op.evaluate({&x});
+    ASSERT_EQ(Status::OK(), result.status());
+
+    auto v = result.at(0);
+    auto i = result.at(1);
+    auto c = result.at(2);
+
+    ASSERT_EQ(3000, v->lengthOf());
+    for (int e = 0; e < 3000; e++) {
+        // 7 and 3000 are coprime, so the first 3000 elements are all distinct
+        ASSERT_EQ((e * 7) % 3000, v->e<int>(e));
+        ASSERT_EQ(e < 2000 ? 7 : 6, c->e<int>(e));
+    }
+
+    for (int e = 0; e < length; e++)
+        ASSERT_EQ(e % 3000, i->e<int>(e));
+}
+
+TEST_F(DeclarableOpsTests19, test_listdiff_large_1) {
+    const int length = 20000;
+    auto x = NDArrayFactory::create<int>('c', {length});
+    auto y = NDArrayFactory::create<int>('c', {length / 2});
+    x.linspace(0);
+    y.linspace(0, 2);
+
+    sd::ops::listdiff op;
+    auto result = op.evaluate({&x, &y});
+    ASSERT_EQ(Status::OK(), result.status());
+
+    auto z0 = result.at(0);
+    auto z1 = result.at(1);
+
+    ASSERT_EQ(length / 2, z0->lengthOf());
+    for (int e = 0; e < length / 2; e++) {
+        ASSERT_EQ(2 * e + 1, z0->e<int>(e));
+        ASSERT_EQ(2 * e + 1, z1->e<int>(e));
+    }
+}
+
+TEST_F(DeclarableOpsTests19, test_where_large_1) {
+    auto x = NDArrayFactory::create<bool>('c', {100, 300});
+    for (int e = 0; e < x.lengthOf(); e++)
+        x.p(e, e % 3 == 0);
+
+    sd::ops::Where op;
+    auto result = op.evaluate({&x});
+    ASSERT_EQ(Status::OK(), result.status());
+
+    auto z = result.at(0);
+    ASSERT_EQ(10000, z->sizeAt(0));
+    ASSERT_EQ(2, z->sizeAt(1));
+
+    for (int e = 0; e < 10000; e++) {
+        ASSERT_EQ((e * 3) / 300, z->e<Nd4jLong>(e, 0));
+        ASSERT_EQ((e * 3) % 300, z->e<Nd4jLong>(e, 1));
+    }
+}
+
+TEST_F(DeclarableOpsTests19, test_where_non_bool_1) {
+    // non-bool condition: non-zero values are true
+    auto x = NDArrayFactory::create<float>('c', {2, 3}, {0.f, 1.5f, 0.f, -2.f, 0.f, 0.25f});
+    auto e = NDArrayFactory::create<Nd4jLong>('c', {3, 2}, {0, 1,  1, 0,  1, 2});
+
+    sd::ops::Where op;
+    auto result = op.evaluate({&x});
+    ASSERT_EQ(Status::OK(), result.status());
+    ASSERT_EQ(e, *result.at(0));
+
+    // strided view goes through same path
+    auto v = NDArrayFactory::create<int>('c', {2, 6}, {0, 9, 1, 9, 0, 9,  1, 9, 0, 9, 1, 9});
+    auto sub = v({0,2,1, 0,6,2}, true, true);
+    auto expSub = NDArrayFactory::create<Nd4jLong>('c', {3, 2}, {0, 1,  1, 0,  1, 2});
+
+    result = op.evaluate({&sub});
+    ASSERT_EQ(Status::OK(), result.status());
+    ASSERT_EQ(expSub, *result.at(0));
+}
@@ -2558,6 +2558,27 @@ TEST_F(DeclarableOpsTests5, XWPlusB_7) {
     ASSERT_TRUE(exp.equalsTo(output));
 }
 ////////////////////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests5, XWPlusB_8) {
+
+    auto x = NDArrayFactory::create<float>('c', { 3, 2 }, { 1.f, -2.f,  3.f, 4.f,  -5.f,  6.f });
+    auto y = NDArrayFactory::create<float>('c', { 2, 2 }, { 1.f, 2.f, 3.f, -1.f });
+
+    auto b = NDArrayFactory::create<float>('c', { 2 }, { -1.f, 0.5f });
+
+    auto exp = NDArrayFactory::create<float>('c', { 3, 2 }, { 0.f, 4.5f, 14.f, 2.5f, 12.f, 0.f });
+
+    // fused RELU activation
+    sd::ops::xw_plus_b op;
+    auto result = op.evaluate({ &x, &y, &b }, {}, { 0, 1 });
+
+    ASSERT_EQ(ND4J_STATUS_OK, result.status());
+
+    auto output = result.at(0);
+
+    ASSERT_TRUE(exp.isSameShape(output));
+    ASSERT_TRUE(exp.equalsTo(output));
+}
+////////////////////////////////////////////////////////////////////////////////
 TEST_F(DeclarableOpsTests5, StopGradient_1) {
 
     auto x = NDArrayFactory::create<double>('c', {2,3}, { 1.f, 11.f,  3.f, 14.f,  5.f,  6.f});
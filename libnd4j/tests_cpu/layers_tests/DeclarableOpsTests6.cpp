@@ -1877,6 +1877,57 @@ TEST_F(DeclarableOpsTests6, ReluLayer_1) {
 
 }
 
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests6, ReluLayer_2) {
+    auto x = NDArrayFactory::create<double>('c', {2, 3}, {1.0, -2.0, 3.0, 0.5, 1.0, -1.0});
+    auto w = NDArrayFactory::create<double>('c', {3, 2}, {0.5, -1.0, 0.25, 0.5, 1.0, 0.0});
+    auto b = NDArrayFactory::create<double>({0.5, 1.0});
+
+    // x × w + b = {3.5, -1.0, 0.0, 1.0}, values below cutoff are clamped to it, same as scalar RELU
+    auto exp = NDArrayFactory::create<double>('c', {2, 2}, {3.5, 0.5, 0.5, 1.0});
+
+    sd::ops::relu_layer op;
+    auto result = op.evaluate({&x, &w, &b}, {0.5});
+
+    ASSERT_EQ(ND4J_STATUS_OK, result.status());
+
+    auto z = result.at(0);
+
+    ASSERT_TRUE(exp.isSameShape(z));
+    ASSERT_TRUE(exp.equalsTo(z));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests6, ReluLayer_3) {
+    // mixed input types: output takes x type, weights and bias are cast to it
+    auto x = NDArrayFactory::create<float>('c', {2, 3}, {1.f, -2.f, 3.f, 0.5f, 1.f, -1.f});
+    auto w = NDArrayFactory::create<double>('c', {3, 2}, {0.5, -1.0, 0.25, 0.5, 1.0, 0.0});
+    auto b = NDArrayFactory::create<double>({0.5, 1.0});
+
+    auto exp = NDArrayFactory::create<float>('c', {2, 2}, {3.5f, 0.f, 0.f, 1.f});
+
+    sd::ops::relu_layer op;
+    auto result = op.evaluate({&x, &w, &b});
+
+    ASSERT_EQ(ND4J_STATUS_OK, result.status());
+
+    auto z = result.at(0);
+
+    ASSERT_EQ(sd::DataType::FLOAT32, z->dataType());
+    ASSERT_TRUE(exp.isSameShape(z));
+    ASSERT_TRUE(exp.equalsTo(z));
+
+    // integer x goes the same way
+    auto xi = NDArrayFactory::create<int>('c', {2, 3}, {1, -2, 3, 2, 1, -1});
+    auto wf = NDArrayFactory::create<float>('c', {3, 2}, {0.5f, -1.f, 0.25f, 0.5f, 1.f, 0.f});
+    auto bf = NDArrayFactory::create<float>({0.5f, 1.0f});
+    auto zf = NDArrayFactory::create<float>('c', {2, 2});
+    auto expf = NDArrayFactory::create<float>('c', {2, 2}, {3.5f, 0.f, 0.75f, 0.f});
+
+    ASSERT_EQ(ND4J_STATUS_OK, op.execute({&xi, &wf, &bf}, {&zf}));
+    ASSERT_TRUE(expf.equalsTo(zf));
+}
+
 TEST_F(DeclarableOpsTests6, Test_Reduce3_Edge) {
     auto x = NDArrayFactory::create<double>('c', {3, 4, 5});
     auto y = NDArrayFactory::create<double>('c', {3, 4, 5});
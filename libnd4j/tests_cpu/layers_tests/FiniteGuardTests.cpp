@@ -0,0 +1,206 @@
+/*******************************************************************************
+ * Copyright (c) 2020 Konduit K.K.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#include "testlayers.h"
+#include <array/NDArray.h>
+#include <ops/declarable/CustomOperations.h>
+#include <helpers/FiniteGuard.h>
+#include <execution/LaunchContext.h>
+#include <limits>
+#include <thread>
+#include <helpers/SamplingProfiler.h>
+
+using namespace sd;
+
+class FiniteGuardTests : public testing::Test {
+public:
+    bool _guardWas;
+
+    FiniteGuardTests() {
+        _guardWas = Environment::getInstance().isNanGuard();
+        Environment::getInstance().setNanGuard(true);
+        LaunchContext::defaultContext()->errorReference()->setErrorCode(0);
+    }
+
+    ~FiniteGuardTests() {
+        Environment::getInstance().setNanGuard(_guardWas);
+        LaunchContext::defaultContext()->errorReference()->setErrorCode(0);
+    }
+};
+
+TEST_F(FiniteGuardTests, test_is_non_finite_1) {
+    ASSERT_FALSE(FiniteGuard::isNonFinite<float>(1.5f));
+    ASSERT_FALSE(FiniteGuard::isNonFinite<float>(std::numeric_limits<float>::max()));
+    ASSERT_TRUE(FiniteGuard::isNonFinite<float>(std::numeric_limits<float>::infinity()));
+    ASSERT_TRUE(FiniteGuard::isNonFinite<float>(-std::numeric_limits<float>::infinity()));
+    ASSERT_TRUE(FiniteGuard::isNonFinite<double>(std::numeric_limits<double>::quiet_NaN()));
+    ASSERT_TRUE(FiniteGuard::isNonFinite<float16>(static_cast<float16>(std::numeric_limits<float>::infinity())));
+    ASSERT_TRUE(FiniteGuard::isNonFinite<bfloat16>(static_cast<bfloat16>(std::numeric_limits<float>::quiet_NaN())));
+    ASSERT_FALSE(FiniteGuard::isNonFinite<int>(std::numeric_limits<int>::max()));
+
+}
+
+TEST_F(FiniteGuardTests, test_scan_1) {
+    auto x = NDArrayFactory::create<float>('c', {6, 8});
+    x.linspace(1.f);
+    x.p(13, std::numeric_limits<float>::infinity());
+
+    auto buffer = x.bufferAsT<float>();
+
+    ASSERT_TRUE(FiniteGuard::scan<float>(buffer, 48, 1));
+    ASSERT_FALSE(FiniteGuard::scan<float>(buffer, 13, 1));
+    ASSERT_FALSE(FiniteGuard::scan<float>(buffer + 14, 34, 1));
+
+    // strided scan only looks at every ews-th value
+    ASSERT_FALSE(FiniteGuard::scan<float>(buffer, 24, 2));
+    ASSERT_TRUE(FiniteGuard::scan<float>(buffer + 1, 24, 2));
+
+    ASSERT_TRUE(FiniteGuard::scan<float>(buffer, x.shapeInfo()));
+
+    // column 5 of c-ordered array: values 5, 13, 21...
+    auto column = x({0,0, 5,6}, true);
+    ASSERT_TRUE(FiniteGuard::scan<float>(column.bufferAsT<float>(), column.shapeInfo()));
+    ASSERT_TRUE(FiniteGuard::scan<float>(column.bufferAsT<float>(), column.shapeInfo(), 1, 2));
+    ASSERT_FALSE(FiniteGuard::scan<float>(column.bufferAsT<float>(), column.shapeInfo(), 2, 6));
+
+    auto other = x({0,0, 4,5}, true);
+    ASSERT_FALSE(FiniteGuard::scan<float>(other.bufferAsT<float>(), other.shapeInfo()));
+}
+
+TEST_F(FiniteGuardTests, test_pairwise_1) {
+    auto x = NDArrayFactory::create<float>('c', {4, 5});
+    auto y = NDArrayFactory::create<float>('c', {4, 5});
+    auto z = NDArrayFactory::create<float>('c', {4, 5});
+    x.linspace(1.f);
+    y.assign(2.f);
+    y.p(7, 0.f);
+
+    sd::ops::divide op;
+    ASSERT_EQ(ND4J_STATUS_BAD_OUTPUT, op.execute({&x, &y}, {&z}));
+    ASSERT_EQ(ND4J_STATUS_BAD_OUTPUT, LaunchContext::defaultContext()->errorReference()->errorCode());
+
+    std::string message(LaunchContext::defaultContext()->errorReference()->errorMessage());
+    ASSERT_NE(std::string::npos, message.find("divide"));
+
+    // output is written anyway
+    ASSERT_NEAR(0.5f, z.e<float>(0), 1e-5f);
+
+    Environment::getInstance().setNanGuard(false);
+    ASSERT_EQ(Status::OK(), op.execute({&x, &y}, {&z}));
+}
+
+TEST_F(FiniteGuardTests, test_transform_1) {
+    auto x = NDArrayFactory::create<float>('c', {3, 4});
+    auto z = NDArrayFactory::create<float>('c', {3, 4});
+    x.linspace(-1.f, 0.2f);
+
+    sd::ops::tanh op;
+    ASSERT_EQ(Status::OK(), op.execute({&x}, {&z}));
+
+    x.p(5, std::numeric_limits<float>::quiet_NaN());
+    ASSERT_EQ(ND4J_STATUS_BAD_OUTPUT, op.execute({&x}, {&z}));
+}
+
+TEST_F(FiniteGuardTests, test_transform_2) {
+    // output spans several blocks, non-finite value sits in the last one
+    const Nd4jLong length = 5 * FiniteGuard::blockSize + 17;
+    auto x = NDArrayFactory::create<float>('c', {length});
+    auto z = NDArrayFactory::create<float>('c', {length});
+    x.assign(0.5f);
+
+    sd::ops::tanh op;
+    ASSERT_EQ(Status::OK(), op.execute({&x}, {&z}));
+
+    x.p(length - 1, std::numeric_limits<float>::quiet_NaN());
+    ASSERT_EQ(ND4J_STATUS_BAD_OUTPUT, op.execute({&x}, {&z}));
+
+    // strided output is scanned with its own stride
+    auto v = NDArrayFactory::create<float>('c', {length, 2});
+    auto zv = v({0,0, 1,2}, true);
+    ASSERT_EQ(ND4J_STATUS_BAD_OUTPUT, op.execute({&x}, {&zv}));
+}
+
+TEST_F(FiniteGuardTests, test_reduce_1) {
+    auto x = NDArrayFactory::create<float>('c', {16, 64});
+    x.assign(1.f);
+
+    sd::ops::reduce_sum op;
+    auto result = op.evaluate({&x}, {}, {1});
+    ASSERT_EQ(Status::OK(), result.status());
+
+    x.p(100, std::numeric_limits<float>::infinity());
+    result = op.evaluate({&x}, {}, {1});
+    ASSERT_EQ(ND4J_STATUS_BAD_OUTPUT, result.status());
+
+    // full array reduction goes through different kernel
+    result = op.evaluate({&x}, {}, {});
+    ASSERT_EQ(ND4J_STATUS_BAD_OUTPUT, result.status());
+}
+
+TEST_F(FiniteGuardTests, test_gemm_1) {
+    auto a = NDArrayFactory::create<float>('c', {8, 16});
+    auto b = NDArrayFactory::create<float>('c', {16, 4});
+    auto c = NDArrayFactory::create<float>('c', {8, 4});
+    a.linspace(0.1f, 0.1f);
+    b.assign(std::numeric_limits<float>::max());
+
+    sd::ops::matmul op;
+    ASSERT_EQ(ND4J_STATUS_BAD_OUTPUT, op.execute({&a, &b}, {&c}));
+
+    b.assign(1.f);
+    ASSERT_EQ(Status::OK(), op.execute({&a, &b}, {&c}));
+}
+
+TEST_F(FiniteGuardTests, test_broadcast_1) {
+    auto x = NDArrayFactory::create<float>('c', {4, 5});
+    auto y = NDArrayFactory::create<float>('c', {5}, {1.f, 2.f, 0.f, 4.f, 5.f});
+    auto z = NDArrayFactory::create<float>('c', {4, 5});
+    x.linspace(1.f);
+
+    sd::ops::realdiv op;
+    ASSERT_EQ(ND4J_STATUS_BAD_OUTPUT, op.execute({&x, &y}, {&z}));
+
+    y.p(2, 3.f);
+    ASSERT_EQ(Status::OK(), op.execute({&x, &y}, {&z}));
+
+    // along dimension, through tad loops
+    auto w = NDArrayFactory::create<float>('c', {4}, {1.f, 2.f, 0.f, 4.f});
+    x.applyBroadcast(broadcast::Divide, {0}, w, z);
+    ASSERT_TRUE(FiniteGuard::isNonFinite<float>(z.e<float>(2, 0)));
+}
+
+TEST_F(FiniteGuardTests, test_region_1) {
+    std::atomic<bool> nonFinite{false};
+    ScopedOpMarker marker("test", 0L, -1, -1, &nonFinite);
+
+    FiniteGuard::Region region;
+
+    // threads that aren't ThreadPool workers see no marker, until they enter region
+    std::thread outside([&] {
+        ASSERT_FALSE(FiniteGuard::isArmed());
+        FiniteGuard::report();
+    });
+    outside.join();
+    ASSERT_FALSE(nonFinite.load());
+
+    std::thread inside([&] {
+        FiniteGuard::Scope scope(region);
+        ASSERT_TRUE(FiniteGuard::isArmed());
+        FiniteGuard::report();
+    });
+    inside.join();
+    ASSERT_TRUE(nonFinite.load());
+}
@@ -25,6 +25,21 @@
 #include <graph/Node.h>
 #include <graph/Graph.h>
 #include <graph/GraphUtils.h>
+#include <graph/profiling/GraphProfile.h>
+#include <graph/profiling/OpCost.h>
+#include <helpers/HardwareCounters.h>
+#include <thread>
+#include <graph/AutoMixedPrecision.h>
+#include <graph/GemmFusion.h>
+#include <graph/ConvFusion.h>
+#include <graph/StreamingSession.h>
+#include <graph/OutputAliasing.h>
+#include <graph/InplacePlanner.h>
+#include <graph/Rematerialization.h>
+#include <graph/ActivationCompression.h>
+#include <graph/GraphExecutioner.h>
+#include <graph/FlatUtils.h>
+#include <helpers/RandomLauncher.h>
 #include <array/NDArray.h>
 #include <ops/declarable/DeclarableOp.h>
 #include <ops/declarable/generic/parity_ops.cpp>
@@ -1636,3 +1651,986 @@ TEST_F(GraphTests, Test_Minifier_3) {
     //ASSERT_EQ(0, unlink("libnd4j_mini3.hpp"));
 
 }
+
+TEST_F(GraphTests, Test_Profile_HotSpots_1) {
+    GraphProfile profile;
+    profile.nodeById(1, "fast")->setExecutionTime(10L);
+    profile.nodeById(2, "slow")->setExecutionTime(1000L);
+    profile.nodeById(3, "medium")->setExecutionTime(100L);
+
+    auto top = profile.hotSpots(2);
+    ASSERT_EQ(2, top.size());
+    ASSERT_EQ(2, top[0]->id());
+    ASSERT_EQ(3, top[1]->id());
+
+    // negative limit means all nodes
+    ASSERT_EQ(3, profile.hotSpots(-1).size());
+
+    GraphProfile other;
+    other.nodeById(2, "slow")->setExecutionTime(3000L);
+    profile.merge(&other);
+
+    ASSERT_EQ(2000L, profile.nodeById(2)->getAverageExecutionTime());
+}
+
+TEST_F(GraphTests, Test_OpCost_1) {
+    auto x = NDArrayFactory::create<float>('c', {4, 3});
+    auto y = NDArrayFactory::create<float>('c', {3, 5});
+    auto z = NDArrayFactory::create<float>('c', {4, 5});
+
+    // 2 * M * N * K
+    ASSERT_EQ(2 * 4 * 5 * 3, OpCost::flops("matmul", {&x, &y}, {&z}, {}));
+    ASSERT_EQ(0, OpCost::flops("reshape", {&x}, {&z}, {}));
+    // elementwise ops are estimated by their largest side
+    ASSERT_EQ(40, OpCost::flops("add", {&z, &z}, {&z}, {}));
+
+    ASSERT_EQ((12 + 15 + 20) * 4, OpCost::bytes({&x, &y}, {&z}));
+}
+
+TEST_F(GraphTests, Test_HardwareCounters_1) {
+    auto &counters = HardwareCounters::getInstance();
+    counters.setEnabled(true);
+
+    // in containers counters are usually unavailable, and that's fine as long as nothing breaks
+    ASSERT_EQ(counters.isAvailable(), counters.isEnabled());
+
+    auto before = counters.threadValues();
+    auto x = NDArrayFactory::create<float>('c', {128, 128});
+    x.assign(1.0f);
+    auto diff = counters.threadValues() - before;
+
+    ASSERT_EQ(counters.isAvailable(), diff.hasValues());
+    if (diff.cycles >= 0)
+        ASSERT_TRUE(diff.cycles > 0);
+
+    counters.setEnabled(false);
+    ASSERT_FALSE(counters.threadValues().hasValues());
+}
+
+TEST_F(GraphTests, Test_HardwareCounters_2) {
+    auto &counters = HardwareCounters::getInstance();
+    counters.setEnabled(true);
+    if (!counters.isEnabled())
+        return;
+
+    auto attached = counters.attachedThreads();
+
+    // counters of the thread are closed once it exits
+    std::thread thread([&]() {
+        ASSERT_NE(nullptr, counters.currentThread());
+        ASSERT_EQ(attached + 1, counters.attachedThreads());
+        ASSERT_TRUE(counters.threadValues().hasValues());
+    });
+
+    thread.join();
+    ASSERT_EQ(attached, counters.attachedThreads());
+
+    counters.setEnabled(false);
+}
+
+TEST_F(GraphTests, Test_AutoMixedPrecision_1) {
+    Graph graph;
+
+    auto x = NDArrayFactory::create_<float>('c', {4, 3}, {0.1f, 0.2f, 0.3f, 0.4f, 0.5f, 0.6f, 0.7f, 0.8f, 0.9f, 1.0f, 1.1f, 1.2f});
+    auto w = NDArrayFactory::create_<float>('c', {3, 5});
+    auto b = NDArrayFactory::create_<float>('c', {5}, {0.1f, -0.2f, 0.3f, -0.4f, 0.5f});
+    w->linspace(-0.7, 0.1);
+
+    graph.getVariableSpace()->putVariable(-1, x);
+    graph.getVariableSpace()->putVariable(-2, w);
+    graph.getVariableSpace()->putVariable(-3, b);
+
+    sd::ops::matmul mmul;
+    sd::ops::biasadd bias;
+    sd::ops::softmax softmax;
+
+    graph.addNode(new Node(&mmul, 1, {-1, -2}, {2}));
+    graph.addNode(new Node(&bias, 2, {1, -3}, {3}));
+    graph.addNode(new Node(&softmax, 3, {2}, {}));
+    graph.buildGraph();
+
+    auto reference = graph.clone();
+
+    AutoMixedPrecision amp(sd::DataType::BFLOAT16);
+    ASSERT_EQ(2, amp.apply(&graph));
+
+    // softmax is the output, so the only cast brings biasadd result back to fp32
+    ASSERT_EQ(1, amp.insertedCasts());
+    ASSERT_EQ(3, amp.convertedConstants());
+    ASSERT_EQ(sd::DataType::BFLOAT16, graph.getVariableSpace()->getVariable(-2)->getNDArray()->dataType());
+    ASSERT_EQ(4, graph.totalNodes());
+
+    auto castId = graph.nodeById(3)->input()->at(0).first;
+    ASSERT_NE(2, castId);
+    ASSERT_EQ(2, graph.nodeById(castId)->input()->at(0).first);
+
+    auto errors = AutoMixedPrecision::compare(reference, &graph);
+    ASSERT_EQ(1, errors.size());
+    ASSERT_EQ(3, errors[0].id);
+    ASSERT_EQ(20, errors[0].length);
+    ASSERT_TRUE(errors[0].maxAbsError < 1e-2);
+
+    auto z = graph.getVariableSpace()->getVariable(3)->getNDArray();
+    ASSERT_EQ(sd::DataType::FLOAT32, z->dataType());
+
+    delete reference;
+}
+
+TEST_F(GraphTests, Test_AutoMixedPrecision_2) {
+    Graph graph;
+
+    auto x = NDArrayFactory::create_<float>('c', {2, 2}, {1.f, 2.f, 3.f, 4.f});
+    auto w = NDArrayFactory::create_<float>('c', {2, 2}, {0.5f, 0.25f, -1.f, 2.f});
+
+    graph.getVariableSpace()->putVariable(-1, x);
+    graph.getVariableSpace()->putVariable(-2, w);
+
+    sd::ops::matmul mmul;
+    sd::ops::reduce_sum sum;
+    sd::ops::cast cast;
+
+    // -1 is consumed by both low precision matmul and fp32 reduction, so fp32 copy has to stay
+    graph.addNode(new Node(&mmul, 1, {-1, -2}, {2}));
+    graph.addNode(new Node(&cast, 2, {1}, {}, {}, 0.0f, {}, {(int) sd::DataType::DOUBLE}));
+    graph.addNode(new Node(&sum, 3, {-1}, {}));
+    graph.buildGraph();
+
+    AutoMixedPrecision amp(sd::DataType::HALF);
+    ASSERT_EQ(1, amp.apply(&graph));
+
+    // existing cast consumes fp16 matmul output directly
+    ASSERT_EQ(0, amp.insertedCasts());
+    ASSERT_EQ(1, graph.nodeById(2)->input()->at(0).first);
+    ASSERT_EQ(sd::DataType::FLOAT32, graph.getVariableSpace()->getVariable(-1)->getNDArray()->dataType());
+    ASSERT_EQ(sd::DataType::HALF, graph.getVariableSpace()->getVariable(-2)->getNDArray()->dataType());
+
+    auto copyId = graph.nodeById(1)->input()->at(0).first;
+    ASSERT_TRUE(copyId < -2);
+    ASSERT_EQ(sd::DataType::HALF, graph.getVariableSpace()->getVariable(copyId)->getNDArray()->dataType());
+
+    ASSERT_EQ(Status::OK(), GraphExecutioner::execute(&graph));
+
+    auto z = graph.getVariableSpace()->getVariable(2)->getNDArray();
+    auto exp = NDArrayFactory::create<double>('c', {2, 2}, {-1.5, 4.25, -2.5, 8.75});
+    ASSERT_EQ(sd::DataType::DOUBLE, z->dataType());
+    ASSERT_TRUE(exp.equalsTo(z));
+}
+
+TEST_F(GraphTests, Test_OutputViews_1) {
+    Graph graph;
+
+    auto x = NDArrayFactory::create_<float>('c', {4, 3});
+    x->linspace(1);
+
+    graph.getVariableSpace()->putVariable(-1, x);
+
+    sd::ops::split split;
+    sd::ops::unstack unstack;
+    sd::ops::add add;
+
+    graph.addNode(new Node(&split, 1, {-1}, {}, {}, 0.0f, {}, {2, 0}));
+    graph.addNode(new Node(&unstack, 2, {-1}, {}, {}, 0.0f, {}, {1}));
+
+    auto sum = new Node(&add, 3, {});
+    sum->pickInput(1, 0);
+    sum->pickInput(1, 1);
+    graph.addNode(sum);
+
+    // outputs of the Graph are never views, so unstack needs a consumer
+    auto sum2 = new Node(&add, 4, {});
+    sum2->pickInput(2, 2);
+    sum2->pickInput(2, 3);
+    graph.addNode(sum2);
+
+    graph.getExecutorConfiguration()->_outputViews = true;
+    ASSERT_EQ(Status::OK(), GraphExecutioner::execute(&graph));
+
+    ASSERT_EQ(2, OutputAliasing::apply(&graph));
+
+    auto vs = graph.getVariableSpace();
+    auto s1 = vs->getVariable(1, 1)->getNDArray();
+    auto u2 = vs->getVariable(2, 2)->getNDArray();
+
+    ASSERT_EQ(x->getDataBuffer().get(), s1->getDataBuffer().get());
+    ASSERT_EQ(x->getDataBuffer().get(), u2->getDataBuffer().get());
+
+    auto expS = NDArrayFactory::create<float>('c', {2, 3}, {7.f, 8.f, 9.f, 10.f, 11.f, 12.f});
+    auto expU = NDArrayFactory::create<float>('c', {4}, {3.f, 6.f, 9.f, 12.f});
+    auto expZ = NDArrayFactory::create<float>('c', {2, 3}, {8.f, 10.f, 12.f, 14.f, 16.f, 18.f});
+
+    ASSERT_TRUE(expS.isSameShape(s1));
+    ASSERT_TRUE(expS.equalsTo(s1));
+    ASSERT_TRUE(expU.isSameShape(u2));
+    ASSERT_TRUE(expU.equalsTo(u2));
+    ASSERT_TRUE(expZ.equalsTo(vs->getVariable(3)->getNDArray()));
+
+    // views are refreshed on every run
+    x->assign(2.f);
+    ASSERT_EQ(Status::OK(), GraphExecutioner::execute(&graph));
+    ASSERT_NEAR(4.f, vs->getVariable(3)->getNDArray()->e<float>(5), 1e-5);
+}
+
+TEST_F(GraphTests, Test_OutputViews_2) {
+    Graph graph;
+
+    auto x = NDArrayFactory::create_<float>('c', {4, 3});
+    x->linspace(1);
+
+    graph.getVariableSpace()->putVariable(-1, x);
+
+    sd::ops::strided_slice stridedSlice;
+    sd::ops::slice slice;
+
+    // every second row
+    graph.addNode(new Node(&stridedSlice, 1, {-1}, {}, {}, 0.0f, {}, {0, 0, 0, 0, 0,  1, 0,  4, 3,  2, 1}));
+    graph.addNode(new Node(&slice, 2, {-1}, {}, {}, 0.0f, {}, {1, 1,  2, 2}));
+
+    // graph outputs: these are never views
+    graph.addNode(new Node(&slice, 3, {1}, {}, {}, 0.0f, {}, {0, 0,  2, 3}));
+    graph.addNode(new Node(&stridedSlice, 4, {2}, {}, {}, 0.0f, {}, {0, 0, 0, 0, 0,  0, 0,  2, 2,  1, 1}));
+
+    graph.getExecutorConfiguration()->_outputViews = true;
+    ASSERT_EQ(Status::OK(), GraphExecutioner::execute(&graph));
+
+    auto vs = graph.getVariableSpace();
+    auto z1 = vs->getVariable(1)->getNDArray();
+    auto z2 = vs->getVariable(2)->getNDArray();
+
+    ASSERT_EQ(x->getDataBuffer().get(), z1->getDataBuffer().get());
+    ASSERT_EQ(x->getDataBuffer().get(), z2->getDataBuffer().get());
+
+    auto exp1 = NDArrayFactory::create<float>('c', {2, 3}, {4.f, 5.f, 6.f, 10.f, 11.f, 12.f});
+    auto exp2 = NDArrayFactory::create<float>('c', {2, 2}, {5.f, 6.f, 8.f, 9.f});
+
+    ASSERT_TRUE(exp1.isSameShape(z1));
+    ASSERT_TRUE(exp1.equalsTo(z1));
+    ASSERT_TRUE(exp2.isSameShape(z2));
+    ASSERT_TRUE(exp2.equalsTo(z2));
+
+    auto z3 = vs->getVariable(3)->getNDArray();
+    auto z4 = vs->getVariable(4)->getNDArray();
+    ASSERT_NE(x->getDataBuffer().get(), z3->getDataBuffer().get());
+    ASSERT_NE(x->getDataBuffer().get(), z4->getDataBuffer().get());
+    ASSERT_TRUE(exp1.equalsTo(z3));
+    ASSERT_TRUE(exp2.equalsTo(z4));
+
+    // strided view exported via FlatUtils must get shape of its compacted data
+    flatbuffers::FlatBufferBuilder builder(1024);
+    builder.Finish(FlatUtils::toFlatArray(builder, *z1));
+
+    auto restored = FlatUtils::fromFlatArray(GetFlatArray(builder.GetBufferPointer()));
+    ASSERT_TRUE(exp1.isSameShape(restored));
+    ASSERT_TRUE(exp1.equalsTo(restored));
+
+    delete restored;
+}
+
+TEST_F(GraphTests, Test_OutputViews_3) {
+    Graph graph;
+
+    auto x = NDArrayFactory::create_<float>('c', {4, 3});
+    auto y = NDArrayFactory::create_<float>('c', {1, 3});
+    x->linspace(1);
+    y->assign(1.f);
+
+    graph.getVariableSpace()->putVariable(-1, x);
+    graph.getVariableSpace()->putVariable(-2, y);
+
+    sd::ops::split split;
+    sd::ops::slice slice;
+    sd::ops::add add;
+
+    graph.addNode(new Node(&split, 1, {-1}, {}, {}, 0.0f, {}, {2, 0}));
+
+    auto first = new Node(&slice, 2, {}, {}, {}, 0.0f, {}, {0, 0,  1, 3});
+    first->pickInput(1, 1);
+    graph.addNode(first);
+
+    // in-place add modifies slice output, which would modify split output and input in turn
+    auto sum = new Node(&add, 3, {2, -2});
+    sum->markInplace(true);
+    graph.addNode(sum);
+
+    ASSERT_EQ(0, OutputAliasing::apply(&graph));
+
+    graph.getExecutorConfiguration()->_outputViews = true;
+    ASSERT_EQ(Status::OK(), GraphExecutioner::execute(&graph));
+
+    auto exp = NDArrayFactory::create<float>('c', {1, 3}, {8.f, 9.f, 10.f});
+    ASSERT_TRUE(exp.equalsTo(graph.getVariableSpace()->getVariable(3)->getNDArray()));
+
+    ASSERT_NEAR(7.f, x->e<float>(6), 1e-5);
+    ASSERT_NE(x->getDataBuffer().get(), graph.getVariableSpace()->getVariable(1, 1)->getNDArray()->getDataBuffer().get());
+}
+
+TEST_F(GraphTests, Test_OutputViews_4) {
+    // slices without indices to take view of: rank-0 input, and scalar taken from a vector
+    Graph graph;
+
+    auto x = NDArrayFactory::create_<float>(5.f);
+    auto y = NDArrayFactory::create_<float>('c', {3}, {1.f, 2.f, 3.f});
+
+    auto vs = graph.getVariableSpace();
+    vs->putVariable(-1, x);
+    vs->putVariable(-2, y);
+    vs->putVariable(-3, NDArrayFactory::create_<int>('c', {1}, {0}));
+    vs->putVariable(-4, NDArrayFactory::create_<int>('c', {1}, {1}));
+    vs->putVariable(-5, NDArrayFactory::create_<int>('c', {1}, {1}));
+
+    sd::ops::strided_slice stridedSlice;
+    sd::ops::add add;
+
+    graph.addNode(new Node(&stridedSlice, 1, {-1, -3, -4, -5}, {}, {}, 0.0f, {}, {0, 0, 0, 0, 0}));
+    graph.addNode(new Node(&stridedSlice, 2, {-2}, {}, {}, 0.0f, {}, {0, 0, 0, 0, 1,  1, 2, 1}));
+    graph.addNode(new Node(&add, 3, {1, 1}));
+    graph.addNode(new Node(&add, 4, {2, 2}));
+    graph.buildGraph();
+
+    auto reference = graph.clone();
+
+    graph.getExecutorConfiguration()->_outputViews = true;
+    ASSERT_EQ(2, OutputAliasing::apply(&graph));
+
+    ASSERT_EQ(Status::OK(), GraphExecutioner::execute(&graph));
+    ASSERT_EQ(Status::OK(), GraphExecutioner::execute(reference));
+
+    for (int e = 1; e <= 4; e++) {
+        auto z = vs->getVariable(e)->getNDArray();
+        auto exp = reference->getVariableSpace()->getVariable(e)->getNDArray();
+
+        ASSERT_EQ(exp->isEmpty(), z->isEmpty());
+        ASSERT_TRUE(exp->isSameShape(z));
+        ASSERT_TRUE(exp->equalsTo(z));
+    }
+
+    ASSERT_NEAR(2.f, vs->getVariable(2)->getNDArray()->e<float>(0), 1e-5f);
+    ASSERT_NE(y->getDataBuffer().get(), vs->getVariable(2)->getNDArray()->getDataBuffer().get());
+
+    delete reference;
+}
+
+TEST_F(GraphTests, Test_InplacePlanner_1) {
+    Graph graph;
+
+    auto x = NDArrayFactory::create_<float>('c', {2, 3}, {-1.f, -0.5f, 0.f, 0.5f, 1.f, 1.5f});
+    auto y = NDArrayFactory::create_<float>('c', {2, 3}, {0.1f, 0.2f, 0.3f, 0.4f, 0.5f, 0.6f});
+
+    graph.getVariableSpace()->putVariable(-1, x);
+    graph.getVariableSpace()->putVariable(-2, y);
+
+    sd::ops::add add;
+    sd::ops::sigmoid sigmoid;
+
+    // variables are never overwritten
+    graph.addNode(new Node(&add, 1, {-1, -2}));
+    // node 1 output has 2 uses
+    graph.addNode(new Node(&sigmoid, 2, {1}));
+    // last uses of nodes 2 and 3 outputs
+    graph.addNode(new Node(&sigmoid, 3, {2}));
+    graph.addNode(new Node(&add, 4, {3, 1}));
+    graph.buildGraph();
+
+    auto reference = graph.clone();
+
+    ASSERT_EQ(2, InplacePlanner::apply(&graph));
+    ASSERT_FALSE(graph.nodeById(1)->isInplace());
+    ASSERT_FALSE(graph.nodeById(2)->isInplace());
+    ASSERT_TRUE(graph.nodeById(3)->isInplace());
+    ASSERT_TRUE(graph.nodeById(4)->isInplace());
+
+    FlowPath flowPath;
+    graph.getVariableSpace()->setFlowPath(&flowPath);
+    graph.getExecutorConfiguration()->_inplacePlanning = true;
+
+    auto profiling = Environment::getInstance().isProfiling();
+    Environment::getInstance().setProfiling(true);
+    auto status = GraphExecutioner::execute(&graph);
+    Environment::getInstance().setProfiling(profiling);
+
+    ASSERT_EQ(Status::OK(), status);
+    ASSERT_EQ(Status::OK(), GraphExecutioner::execute(reference));
+
+    auto z = graph.getVariableSpace()->getVariable(4)->getNDArray();
+    auto exp = reference->getVariableSpace()->getVariable(4)->getNDArray();
+
+    ASSERT_TRUE(exp->isSameShape(z));
+    ASSERT_TRUE(exp->equalsTo(z));
+    ASSERT_EQ(graph.getVariableSpace()->getVariable(2)->getNDArray()->getDataBuffer(), z->getDataBuffer());
+
+    // nodes 3 and 4 didn't allocate their [2, 3] float outputs
+    ASSERT_EQ(48, flowPath.profile()->inplaceBytes());
+
+    graph.getVariableSpace()->setFlowPath(nullptr);
+    delete reference;
+}
+
+TEST_F(GraphTests, Test_InplacePlanner_2) {
+    Graph graph;
+
+    auto x = NDArrayFactory::create_<float>('c', {1, 3}, {-1.f, 0.f, 1.f});
+    auto y = NDArrayFactory::create_<float>('c', {2, 3}, {1.f, 2.f, 3.f, 4.f, 5.f, 6.f});
+
+    graph.getVariableSpace()->putVariable(-1, x);
+    graph.getVariableSpace()->putVariable(-2, y);
+
+    sd::ops::add add;
+    sd::ops::sigmoid sigmoid;
+    sd::ops::tanh tanh;
+
+    // explicitly in-place, so output of node 1 is x itself
+    auto first = new Node(&sigmoid, 1, {-1});
+    first->markInplace(true);
+    graph.addNode(first);
+
+    graph.addNode(new Node(&tanh, 2, {1}));
+
+    // broadcast: output is bigger than node 2 output
+    graph.addNode(new Node(&add, 3, {2, -2}));
+
+    graph.getExecutorConfiguration()->_inplacePlanning = true;
+    ASSERT_EQ(2, InplacePlanner::apply(&graph));
+    ASSERT_EQ(Status::OK(), GraphExecutioner::execute(&graph));
+
+    // both planned nodes fell back to regular execution at runtime
+    auto s = NDArrayFactory::create<float>('c', {1, 3}, {0.26894142f, 0.5f, 0.73105858f});
+    ASSERT_TRUE(s.equalsTo(x));
+
+    auto t = s.transform(transform::Tanh);
+    auto exp = t + *y;
+
+    auto z = graph.getVariableSpace()->getVariable(3)->getNDArray();
+    ASSERT_TRUE(exp.isSameShape(z));
+    ASSERT_TRUE(exp.equalsTo(z));
+}
+
+// sigmoid chain of 9 nodes, and its backward pass: node 10 + i is sigmoid_bp of node i
+static void buildCheckpointGraph(Graph &graph, sd::ops::DeclarableOp *fwd, sd::ops::DeclarableOp *bwd) {
+    auto x = NDArrayFactory::create_<float>('c', {2, 3}, {-1.f, -0.5f, 0.f, 0.5f, 1.f, 1.5f});
+    graph.getVariableSpace()->putVariable(-1, x);
+
+    for (int e = 1; e <= 9; e++)
+        graph.addNode(new Node(fwd, e, {e == 1 ? -1 : e - 1}));
+
+    graph.addNode(new Node(bwd, 19, {8, 9}));
+    for (int e = 8; e >= 1; e--)
+        graph.addNode(new Node(bwd, 10 + e, {e == 1 ? -1 : e - 1, 11 + e}));
+
+    graph.buildGraph();
+}
+
+TEST_F(GraphTests, Test_Rematerialization_1) {
+    Graph graph;
+    sd::ops::sigmoid sigmoid;
+    sd::ops::sigmoid_bp sigmoid_bp;
+
+    buildCheckpointGraph(graph, &sigmoid, &sigmoid_bp);
+    auto reference = graph.clone();
+
+    FlowPath flowPath;
+    graph.getVariableSpace()->setFlowPath(&flowPath);
+    graph.getExecutorConfiguration()->_rematerialization = true;
+
+    ASSERT_EQ(Status::OK(), GraphExecutioner::execute(&graph));
+    ASSERT_EQ(Status::OK(), GraphExecutioner::execute(reference));
+
+    auto z = graph.getVariableSpace()->getVariable(11)->getNDArray();
+    auto exp = reference->getVariableSpace()->getVariable(11)->getNDArray();
+    ASSERT_TRUE(exp->isSameShape(z));
+    ASSERT_TRUE(exp->equalsTo(z));
+
+    // sqrt(9) segments: only nodes 3, 6 and 9 keep their outputs
+    for (int e = 1; e <= 9; e++)
+        ASSERT_EQ(e % 3 == 0, graph.getVariableSpace()->getVariable(e)->hasNDArray());
+
+    // 6 forward outputs released twice: after forward use, and after backward use
+    ASSERT_EQ(6, flowPath.profile()->recomputedNodes());
+    ASSERT_EQ(12 * 24, flowPath.profile()->rematerializedBytes());
+
+    graph.getVariableSpace()->setFlowPath(nullptr);
+    delete reference;
+}
+
+TEST_F(GraphTests, Test_Rematerialization_2) {
+    Graph graph;
+    sd::ops::sigmoid sigmoid;
+    sd::ops::sigmoid_bp sigmoid_bp;
+
+    buildCheckpointGraph(graph, &sigmoid, &sigmoid_bp);
+    auto reference = graph.clone();
+
+    FlowPath flowPath;
+    graph.getVariableSpace()->setFlowPath(&flowPath);
+    graph.getExecutorConfiguration()->_rematerialization = true;
+
+    // every second [2, 3] float output becomes checkpoint
+    graph.getExecutorConfiguration()->_rematerializationBudget = 24;
+
+    ASSERT_EQ(Status::OK(), GraphExecutioner::execute(reference));
+
+    // released arrays are allocated again by next execution
+    for (int r = 1; r <= 2; r++) {
+        ASSERT_EQ(Status::OK(), GraphExecutioner::execute(&graph));
+
+        auto z = graph.getVariableSpace()->getVariable(11)->getNDArray();
+        auto exp = reference->getVariableSpace()->getVariable(11)->getNDArray();
+        ASSERT_TRUE(exp->equalsTo(z));
+
+        for (int e = 1; e <= 9; e++)
+            ASSERT_EQ(e % 2 == 0, graph.getVariableSpace()->getVariable(e)->hasNDArray());
+
+        ASSERT_EQ(r * 5, flowPath.profile()->recomputedNodes());
+        ASSERT_EQ(r * 10 * 24, flowPath.profile()->rematerializedBytes());
+    }
+
+    graph.getVariableSpace()->setFlowPath(nullptr);
+    delete reference;
+}
+
+TEST_F(GraphTests, Test_ActivationCompression_1) {
+    sd::ops::tanh tanh;
+    sd::ops::relu relu;
+    sd::ops::sigmoid sigmoid;
+    sd::ops::tanh_bp tanh_bp;
+    sd::ops::relu_bp relu_bp;
+    sd::ops::sigmoid_bp sigmoid_bp;
+
+    // node 1 is needed by relu_bp only, so 1-bit mask is kept for it. nodes 2 and 3 are stored in given type
+    std::vector<std::pair<ActivationCompressionMode, Nd4jLong>> modes = {{ACTIVATION_COMPRESSION_MASKS, 23}, {ACTIVATION_COMPRESSION_BFLOAT16, 23 + 2 * 12}, {ACTIVATION_COMPRESSION_INT8, 23 + 2 * 14}};
+
+    for (auto &mode: modes) {
+        Graph graph;
+        auto x = NDArrayFactory::create_<float>('c', {2, 3}, {-1.f, -0.5f, 0.f, 0.5f, 1.f, 1.5f});
+        graph.getVariableSpace()->putVariable(-1, x);
+
+        graph.addNode(new Node(&tanh, 1, {-1}));
+        graph.addNode(new Node(&relu, 2, {1}, {}, {}, 0.0f, {0.0}));
+        graph.addNode(new Node(&sigmoid, 3, {2}));
+        graph.addNode(new Node(&sigmoid_bp, 4, {2, 3}));
+        graph.addNode(new Node(&relu_bp, 5, {1, 4}));
+        graph.addNode(new Node(&tanh_bp, 6, {-1, 5}));
+        graph.buildGraph();
+
+        auto reference = graph.clone();
+
+        FlowPath flowPath;
+        graph.getVariableSpace()->setFlowPath(&flowPath);
+        graph.getExecutorConfiguration()->_activationCompression = mode.first;
+
+        ASSERT_EQ(Status::OK(), GraphExecutioner::execute(&graph));
+        ASSERT_EQ(Status::OK(), GraphExecutioner::execute(reference));
+
+        auto z = graph.getVariableSpace()->getVariable(6)->getNDArray();
+        auto exp = reference->getVariableSpace()->getVariable(6)->getNDArray();
+
+        // masks are lossless
+        ASSERT_TRUE(exp->isSameShape(z));
+        ASSERT_TRUE(exp->equalsTo(z, mode.first == ACTIVATION_COMPRESSION_MASKS ? 1e-5 : 1e-2));
+
+        ASSERT_EQ(mode.second, flowPath.profile()->compressedBytes());
+
+        // decompressed arrays are released after backward use
+        ASSERT_FALSE(graph.getVariableSpace()->getVariable(1)->hasNDArray());
+        ASSERT_EQ(mode.first == ACTIVATION_COMPRESSION_MASKS, graph.getVariableSpace()->getVariable(2)->hasNDArray());
+
+        graph.getVariableSpace()->setFlowPath(nullptr);
+        delete reference;
+    }
+}
+
+TEST_F(GraphTests, Test_ActivationCompression_2) {
+    // accuracy of weight gradients of 2-layer perceptron: relu(x * w1) -> tanh(h * w2), with given gradient at output
+    sd::ops::matmul matmul;
+    sd::ops::relu relu;
+    sd::ops::tanh tanh;
+    sd::ops::tanh_bp tanh_bp;
+    sd::ops::matmul_bp matmul_bp;
+    sd::ops::relu_bp relu_bp;
+
+    // relative errors: masks are lossless, casts keep 8 (bfloat16) or 11 (half) bits of mantissa, INT8 keeps 7 bits per block
+    std::vector<std::pair<ActivationCompressionMode, double>> modes = {{ACTIVATION_COMPRESSION_MASKS, 1e-6}, {ACTIVATION_COMPRESSION_HALF, 2e-3}, {ACTIVATION_COMPRESSION_BFLOAT16, 1e-2}, {ACTIVATION_COMPRESSION_INT8, 2e-2}};
+
+    for (auto &mode: modes) {
+        Graph graph;
+
+        auto x = NDArrayFactory::create_<float>('c', {32, 64});
+        auto w1 = NDArrayFactory::create_<float>('c', {64, 128});
+        auto w2 = NDArrayFactory::create_<float>('c', {128, 10});
+        auto eps = NDArrayFactory::create_<float>('c', {32, 10});
+
+        RandomGenerator rng(119, 5);
+        RandomLauncher::fillUniform(LaunchContext::defaultContext(), rng, x, -1.0, 1.0);
+        RandomLauncher::fillUniform(LaunchContext::defaultContext(), rng, w1, -0.2, 0.2);
+        RandomLauncher::fillUniform(LaunchContext::defaultContext(), rng, w2, -0.2, 0.2);
+        RandomLauncher::fillUniform(LaunchContext::defaultContext(), rng, eps, -1.0, 1.0);
+
+        graph.getVariableSpace()->putVariable(-1, x);
+        graph.getVariableSpace()->putVariable(-2, w1);
+        graph.getVariableSpace()->putVariable(-3, w2);
+        graph.getVariableSpace()->putVariable(-4, eps);
+
+        graph.addNode(new Node(&matmul, 1, {-1, -2}));
+        graph.addNode(new Node(&relu, 2, {1}, {}, {}, 0.0f, {0.0}));
+        graph.addNode(new Node(&matmul, 3, {2, -3}));
+        graph.addNode(new Node(&tanh, 4, {3}));
+        graph.addNode(new Node(&tanh_bp, 5, {3, -4}));
+        graph.addNode(new Node(&matmul_bp, 6, {2, -3, 5}));
+        graph.addNode(new Node(&relu_bp, 7, {1, 6}));
+        graph.addNode(new Node(&matmul_bp, 8, {-1, -2, 7}));
+        graph.buildGraph();
+
+        auto reference = graph.clone();
+
+        FlowPath flowPath;
+        graph.getVariableSpace()->setFlowPath(&flowPath);
+        graph.getExecutorConfiguration()->_activationCompression = mode.first;
+
+        ASSERT_EQ(Status::OK(), GraphExecutioner::execute(&graph));
+        ASSERT_EQ(Status::OK(), GraphExecutioner::execute(reference));
+        ASSERT_TRUE(flowPath.profile()->compressedBytes() > 0);
+
+        // dL/dw1 and dL/dw2
+        for (auto &p: std::vector<std::pair<int, int>>{{8, 1}, {6, 1}}) {
+            auto z = graph.getVariableSpace()->getVariable(p.first, p.second)->getNDArray();
+            auto exp = reference->getVariableSpace()->getVariable(p.first, p.second)->getNDArray();
+            ASSERT_TRUE(exp->isSameShape(z));
+
+            auto error = (*z - *exp).reduceNumber(reduce::Norm2).e<double>(0) / exp->reduceNumber(reduce::Norm2).e<double>(0);
+            ASSERT_LE(error, mode.second);
+        }
+
+        graph.getVariableSpace()->setFlowPath(nullptr);
+        delete reference;
+    }
+}
+
+TEST_F(GraphTests, Test_GemmFusion_1) {
+    Graph graph;
+
+    auto x = NDArrayFactory::create_<float>('c', {4, 3}, {0.1f, -0.2f, 0.3f, -0.4f, 0.5f, -0.6f, 0.7f, -0.8f, 0.9f, -1.0f, 1.1f, -1.2f});
+    auto w = NDArrayFactory::create_<float>('c', {3, 5});
+    auto b = NDArrayFactory::create_<float>('c', {5}, {0.1f, -0.2f, 0.3f, -0.4f, 0.5f});
+    w->linspace(-0.7, 0.1);
+
+    graph.getVariableSpace()->putVariable(-1, x);
+    graph.getVariableSpace()->putVariable(-2, w);
+    graph.getVariableSpace()->putVariable(-3, b);
+
+    sd::ops::matmul mmul;
+    sd::ops::biasadd bias;
+    sd::ops::relu relu;
+
+    graph.addNode(new Node(&mmul, 1, {-1, -2}, {2}));
+    graph.addNode(new Node(&bias, 2, {1, -3}, {3}));
+    graph.addNode(new Node(&relu, 3, {2}, {}, {}, 0.0f, {0.0}));
+    graph.buildGraph();
+
+    auto reference = graph.clone();
+
+    GemmFusion fusion;
+    ASSERT_EQ(1, fusion.apply(&graph));
+    ASSERT_EQ(1, fusion.fusedActivations());
+    ASSERT_EQ(1, graph.totalNodes());
+    ASSERT_EQ(3, graph.nodeById(3)->input()->size());
+
+    ASSERT_EQ(Status::OK(), GraphExecutioner::execute(reference));
+    ASSERT_EQ(Status::OK(), GraphExecutioner::execute(&graph));
+
+    auto exp = reference->getVariableSpace()->getVariable(3)->getNDArray();
+    auto z = graph.getVariableSpace()->getVariable(3)->getNDArray();
+    ASSERT_TRUE(exp->equalsTo(z));
+
+    delete reference;
+}
+
+TEST_F(GraphTests, Test_GemmFusion_2) {
+    Graph graph;
+
+    auto x = NDArrayFactory::create_<float>('c', {2, 2}, {1.f, 2.f, 3.f, 4.f});
+    auto w = NDArrayFactory::create_<float>('c', {2, 2}, {0.5f, 0.25f, -1.f, 2.f});
+    auto b = NDArrayFactory::create_<float>('c', {2}, {0.1f, -0.2f});
+
+    graph.getVariableSpace()->putVariable(-1, x);
+    graph.getVariableSpace()->putVariable(-2, w);
+    graph.getVariableSpace()->putVariable(-3, b);
+
+    sd::ops::matmul mmul;
+    sd::ops::biasadd bias;
+    sd::ops::tanh tanh;
+    sd::ops::add add;
+
+    // matmul result has second consumer, so chain can't be fused
+    graph.addNode(new Node(&mmul, 1, {-1, -2}, {2, 4}));
+    graph.addNode(new Node(&bias, 2, {1, -3}, {3}));
+    graph.addNode(new Node(&tanh, 3, {2}, {4}));
+    graph.addNode(new Node(&add, 4, {1, 3}, {}));
+    graph.buildGraph();
+
+    GemmFusion fusion;
+    ASSERT_EQ(0, fusion.apply(&graph));
+    ASSERT_EQ(4, graph.totalNodes());
+}
+
+TEST_F(GraphTests, Test_ConvFusion_1) {
+    Graph graph;
+
+    // NCHW input, [kH, kW, iC, oC] weights
+    auto x = NDArrayFactory::create_<float>('c', {2, 3, 5, 5});
+    auto w = NDArrayFactory::create_<float>('c', {3, 3, 3, 4});
+    auto b = NDArrayFactory::create_<float>('c', {4}, {0.1f, -0.2f, 0.3f, -0.4f});
+    auto mean = NDArrayFactory::create_<float>('c', {4}, {0.05f, -0.1f, 0.2f, 0.f});
+    auto variance = NDArrayFactory::create_<float>('c', {4}, {0.5f, 1.f, 1.5f, 2.f});
+    auto gamma = NDArrayFactory::create_<float>('c', {4}, {1.2f, 0.8f, -0.5f, 1.f});
+    auto beta = NDArrayFactory::create_<float>('c', {4}, {0.f, 0.1f, -0.1f, 0.2f});
+    x->linspace(-1., 0.01);
+    w->linspace(0.2, -0.004);
+
+    graph.getVariableSpace()->putVariable(-1, x);
+    graph.getVariableSpace()->putVariable(-2, w);
+    graph.getVariableSpace()->putVariable(-3, b);
+    graph.getVariableSpace()->putVariable(-4, mean);
+    graph.getVariableSpace()->putVariable(-5, variance);
+    graph.getVariableSpace()->putVariable(-6, gamma);
+    graph.getVariableSpace()->putVariable(-7, beta);
+
+    sd::ops::conv2d conv;
+    sd::ops::batchnorm bn;
+    sd::ops::relu relu;
+
+    graph.addNode(new Node(&conv, 1, {-1, -2, -3}, {2}, {}, 0.0f, {}, {3, 3, 1, 1, 0, 0, 1, 1, 1, 0, 0}));
+    graph.addNode(new Node(&bn, 2, {1, -4, -5, -6, -7}, {3}, {}, 0.0f, {1e-3}, {1, 1, 1}));
+    graph.addNode(new Node(&relu, 3, {2}, {}, {}, 0.0f, {0.0}));
+    graph.buildGraph();
+
+    auto reference = graph.clone();
+
+    ConvFusion fusion;
+    ASSERT_EQ(1, fusion.apply(&graph));
+    ASSERT_EQ(1, fusion.foldedBatchNorms());
+    ASSERT_EQ(1, fusion.fusedActivations());
+    ASSERT_EQ(1, graph.totalNodes());
+    ASSERT_EQ(3, graph.nodeById(3)->input()->size());
+
+    ASSERT_EQ(Status::OK(), GraphExecutioner::execute(reference));
+    ASSERT_EQ(Status::OK(), GraphExecutioner::execute(&graph));
+
+    auto exp = reference->getVariableSpace()->getVariable(3)->getNDArray();
+    auto z = graph.getVariableSpace()->getVariable(3)->getNDArray();
+    ASSERT_TRUE(exp->isSameShape(z));
+    ASSERT_TRUE(exp->equalsTo(z, 1e-4));
+
+    delete reference;
+}
+
+TEST_F(GraphTests, Test_ConvFusion_2) {
+    Graph graph;
+
+    auto x = NDArrayFactory::create_<float>('c', {1, 4, 4, 2});
+    auto w = NDArrayFactory::create_<float>('c', {2, 2, 2, 2});
+    auto mean = NDArrayFactory::create_<float>('c', {4}, {0.f, 0.1f, 0.2f, 0.3f});
+    auto variance = NDArrayFactory::create_<float>('c', {4}, {1.f, 1.f, 1.f, 1.f});
+    x->linspace(0.1, 0.1);
+    w->linspace(-0.3, 0.05);
+
+    graph.getVariableSpace()->putVariable(-1, x);
+    graph.getVariableSpace()->putVariable(-2, w);
+    graph.getVariableSpace()->putVariable(-3, mean);
+    graph.getVariableSpace()->putVariable(-4, variance);
+
+    sd::ops::depthwise_conv2d conv;
+    sd::ops::batchnorm bn;
+    sd::ops::tanh tanh;
+    sd::ops::add add;
+
+    // batchnorm output has second consumer, so activation stays separate while normalization is folded
+    graph.addNode(new Node(&conv, 1, {-1, -2}, {2}, {}, 0.0f, {}, {2, 2, 1, 1, 0, 0, 1, 1, 0, 1, 0}));
+    graph.addNode(new Node(&bn, 2, {1, -3, -4}, {3, 4}, {}, 0.0f, {1e-5}, {0, 0}));
+    graph.addNode(new Node(&tanh, 3, {2}, {4}));
+    graph.addNode(new Node(&add, 4, {2, 3}, {}));
+    graph.buildGraph();
+
+    auto reference = graph.clone();
+
+    ConvFusion fusion;
+    ASSERT_EQ(1, fusion.apply(&graph));
+    ASSERT_EQ(1, fusion.foldedBatchNorms());
+    ASSERT_EQ(0, fusion.fusedActivations());
+    ASSERT_EQ(3, graph.totalNodes());
+
+    ASSERT_EQ(Status::OK(), GraphExecutioner::execute(reference));
+    ASSERT_EQ(Status::OK(), GraphExecutioner::execute(&graph));
+
+    auto exp = reference->getVariableSpace()->getVariable(4)->getNDArray();
+    auto z = graph.getVariableSpace()->getVariable(4)->getNDArray();
+    ASSERT_TRUE(exp->equalsTo(z, 1e-4));
+
+    delete reference;
+}
+
+TEST_F(GraphTests, Test_StreamingSession_1) {
+    const int sL = 6, bS = 2, nIn = 3, nOut = 4;
+
+    NDArray x('c', {sL, bS, nIn}, sd::DataType::FLOAT32);
+    x.linspace(-0.5, 0.05);
+
+    auto Wx = NDArrayFactory::create_<float>('c', {nIn, 4 * nOut});
+    auto Wr = NDArrayFactory::create_<float>('c', {nOut, 4 * nOut});
+    auto b  = NDArrayFactory::create_<float>('c', {4 * nOut});
+    auto hI = NDArrayFactory::create_<float>('c', {bS, nOut});
+    auto cI = NDArrayFactory::create_<float>('c', {bS, nOut});
+    Wx->linspace(-0.1, 0.01);
+    Wr->linspace(0.2, -0.005);
+    b->assign(0.1);
+    hI->assign(0.3);
+    cI->assign(-0.2);
+
+    std::vector<double>   tArgs = {0.};
+    std::vector<Nd4jLong> iArgs = {0, 0, 2, 0, 0};
+    std::vector<bool>     bArgs = {true, false, true, true, false, true, true, true};
+
+    // whole sequence at once
+    sd::ops::lstmLayer op;
+    auto exp = op.evaluate({&x, Wx, Wr, b, hI, cI}, tArgs, iArgs, bArgs);
+    ASSERT_EQ(Status::OK(), exp.status());
+
+    Graph graph;
+    graph.getVariableSpace()->putVariable(-1, NDArrayFactory::create_<float>('c', {1, bS, nIn}));
+    graph.getVariableSpace()->putVariable(-2, Wx);
+    graph.getVariableSpace()->putVariable(-3, Wr);
+    graph.getVariableSpace()->putVariable(-4, b);
+    graph.getVariableSpace()->putVariable(-5, hI);
+    graph.getVariableSpace()->putVariable(-6, cI);
+
+    auto node = new Node(&op, 1, {-1, -2, -3, -4, -5, -6}, {}, {}, 0.0f, {0.}, {0, 0, 2, 0, 0});
+    *node->getContextPrototype()->getBArguments() = bArgs;
+    graph.addNode(node);
+    graph.buildGraph();
+
+    StreamingSession session(&graph);
+    session.bindState(-5, {1, 1});
+    session.bindState(-6, {1, 2});
+
+    // chunks of different length, outputs are reallocated once length changes
+    std::vector<NDArray> chunks;
+    chunks.reserve(4);
+    int start = 0;
+    for (int len : {1, 2, 2, 1}) {
+        chunks.emplace_back(x({start, start + len, 0, 0, 0, 0}).dup());
+        ASSERT_EQ(Status::OK(), session.execute({{-1, &chunks.back()}}));
+
+        auto h = graph.getVariableSpace()->getVariable(1, 0)->getNDArray();
+        auto expChunk = (*exp.at(0))({start, start + len, 0, 0, 0, 0});
+        ASSERT_TRUE(expChunk.isSameShape(h));
+        ASSERT_TRUE(expChunk.equalsTo(h, 1e-5));
+
+        start += len;
+    }
+
+    ASSERT_EQ(4, session.chunks());
+    ASSERT_TRUE(exp.at(1)->equalsTo(session.state(-5), 1e-5));
+    ASSERT_TRUE(exp.at(2)->equalsTo(session.state(-6), 1e-5));
+    ASSERT_TRUE(graph.getVariableSpace()->getVariable(-5)->isPersistent());
+
+    // new stream starts from initial states again
+    session.reset();
+    ASSERT_EQ(Status::OK(), session.execute({{-1, &x}}));
+    ASSERT_TRUE(exp.at(0)->equalsTo(graph.getVariableSpace()->getVariable(1, 0)->getNDArray(), 1e-5));
+}
+
+TEST_F(GraphTests, Test_StreamingSession_2) {
+    const int sL = 6, bS = 2, nIn = 3, nOut = 2;
+
+    NDArray x('c', {sL, bS, nIn}, sd::DataType::DOUBLE);
+    x.linspace(0.1, 0.1);
+
+    auto hI = NDArrayFactory::create_<double>('c', {bS, nOut});
+    auto Wx = NDArrayFactory::create_<double>('c', {nIn, 3 * nOut});
+    auto Wh = NDArrayFactory::create_<double>('c', {nOut, 3 * nOut});
+    auto b  = NDArrayFactory::create_<double>('c', {3 * nOut});
+    hI->assign(0.5);
+    Wx->linspace(-0.3, 0.05);
+    Wh->linspace(0.1, 0.02);
+    b->assign(-0.1);
+
+    sd::ops::gru op;
+    auto exp = op.evaluate({&x, hI, Wx, Wh, b});
+    ASSERT_EQ(Status::OK(), exp.status());
+
+    Graph graph;
+    graph.getVariableSpace()->putVariable(-1, NDArrayFactory::create_<double>('c', {3, bS, nIn}));
+    graph.getVariableSpace()->putVariable(-2, hI);
+    graph.getVariableSpace()->putVariable(-3, Wx);
+    graph.getVariableSpace()->putVariable(-4, Wh);
+    graph.getVariableSpace()->putVariable(-5, b);
+
+    graph.addNode(new Node(&op, 1, {-1, -2, -3, -4, -5}, {}));
+    graph.buildGraph();
+
+    // gru returns whole sequence only, so state is taken from its last step
+    StreamingSession session(&graph);
+    session.bindStateToLastStep(-2, {1, 0}, 0);
+
+    auto first = x({0, 3, 0, 0, 0, 0}).dup();
+    auto second = x({3, 6, 0, 0, 0, 0}).dup();
+
+    ASSERT_EQ(Status::OK(), session.execute({{-1, &first}}));
+    ASSERT_EQ(Status::OK(), session.execute({{-1, &second}}));
+
+    auto expLast = (*exp.at(0))({sL - 1, sL, 0, 0, 0, 0});
+    ASSERT_TRUE(expLast.equalsTo(session.state(-2)));
+
+    auto expSecond = (*exp.at(0))({3, 6, 0, 0, 0, 0});
+    ASSERT_TRUE(expSecond.equalsTo(graph.getVariableSpace()->getVariable(1, 0)->getNDArray()));
+
+    session.reset();
+    ASSERT_EQ(0.5, session.state(-2)->e<double>(0));
+
+    // state variables can't be fed directly
+    ASSERT_ANY_THROW(session.execute({{-2, hI}}));
+}
+
+TEST_F(GraphTests, Test_StreamingSession_3) {
+    // single sequence and single unit: last step of gru output has only unit dims besides time
+    const int sL = 5, bS = 1, nIn = 2, nOut = 1;
+
+    NDArray x('c', {sL, bS, nIn}, sd::DataType::DOUBLE);
+    x.linspace(-0.2, 0.1);
+
+    auto hI = NDArrayFactory::create_<double>('c', {bS, nOut});
+    auto Wx = NDArrayFactory::create_<double>('c', {nIn, 3 * nOut});
+    auto Wh = NDArrayFactory::create_<double>('c', {nOut, 3 * nOut});
+    auto b  = NDArrayFactory::create_<double>('c', {3 * nOut});
+    hI->assign(0.25);
+    Wx->linspace(-0.3, 0.1);
+    Wh->linspace(0.2, 0.05);
+    b->assign(0.05);
+
+    sd::ops::gru op;
+    auto exp = op.evaluate({&x, hI, Wx, Wh, b});
+    ASSERT_EQ(Status::OK(), exp.status());
+
+    Graph graph;
+    graph.getVariableSpace()->putVariable(-1, NDArrayFactory::create_<double>('c', {2, bS, nIn}));
+    graph.getVariableSpace()->putVariable(-2, hI);
+    graph.getVariableSpace()->putVariable(-3, Wx);
+    graph.getVariableSpace()->putVariable(-4, Wh);
+    graph.getVariableSpace()->putVariable(-5, b);
+
+    graph.addNode(new Node(&op, 1, {-1, -2, -3, -4, -5}, {}));
+    graph.buildGraph();
+
+    StreamingSession session(&graph);
+    session.bindStateToLastStep(-2, {1, 0}, 0);
+
+    auto first = x({0, 2, 0, 0, 0, 0}).dup();
+    auto second = x({2, 5, 0, 0, 0, 0}).dup();
+
+    ASSERT_EQ(Status::OK(), session.execute({{-1, &first}}));
+    ASSERT_EQ(Status::OK(), session.execute({{-1, &second}}));
+
+    auto state = session.state(-2);
+    ASSERT_TRUE(state->isSameShape({bS, nOut}));
+    ASSERT_NEAR(exp.at(0)->e<double>(sL - 1), state->e<double>(0), 1e-8);
+
+    auto expSecond = (*exp.at(0))({2, 5, 0, 0, 0, 0}, true);
+    ASSERT_TRUE(expSecond.equalsTo(graph.getVariableSpace()->getVariable(1, 0)->getNDArray()));
+}
@@ -2147,6 +2147,62 @@ TEST_F(HelpersTests1, mmulMxV_7) {
     ASSERT_TRUE(y.equalsTo(&exp));
 }
 
+//////////////////////////////////////////////////////////////////////
+TEST_F(HelpersTests1, mmulFused_1) {
+
+    auto a = NDArrayFactory::create<float>('c', {37, 19});
+    auto b = NDArrayFactory::create<float>('c', {19, 23});
+    auto bias = NDArrayFactory::create<float>('c', {23});
+    auto residual = NDArrayFactory::create<float>('c', {37, 23});
+    a.linspace(-1.f, 0.003f);
+    b.linspace(0.5f, -0.002f);
+    bias.linspace(-0.3f, 0.03f);
+    residual.linspace(1.f, -0.001f);
+
+    for (auto activation : {GemmEpilogue::NONE, GemmEpilogue::RELU, GemmEpilogue::GELU, GemmEpilogue::TANH, GemmEpilogue::SIGMOID}) {
+        GemmEpilogue epilogue(&bias, activation, 0.1, &residual);
+
+        auto exp = NDArrayFactory::create<float>('c', {37, 23});
+        auto plain = MmulHelper::mmul(&a, &b);
+        MmulHelper::applyEpilogue(*plain, exp, epilogue);
+        delete plain;
+
+        auto c = NDArrayFactory::create<float>('c', {37, 23});
+        MmulHelper::mmulFused(&a, &b, &c, epilogue);
+
+        ASSERT_TRUE(exp.equalsTo(c, 1e-4));
+    }
+}
+
+//////////////////////////////////////////////////////////////////////
+TEST_F(HelpersTests1, mmulFused_2) {
+
+    // half inputs with float output go through typed work tile
+    auto a = NDArrayFactory::create<float16>('c', {16, 8});
+    auto b = NDArrayFactory::create<float16>('c', {8, 12});
+    auto bias = NDArrayFactory::create<float>('c', {12});
+    a.linspace(-0.5, 0.01);
+    b.linspace(0.25, -0.005);
+    bias.linspace(-0.1f, 0.02f);
+
+    GemmEpilogue epilogue(&bias, GemmEpilogue::RELU);
+
+    auto plain = MmulHelper::mmul(&a, &b);
+    auto exp = NDArrayFactory::create<float>('c', {16, 12});
+    MmulHelper::applyEpilogue(plain->cast(sd::DataType::FLOAT32), exp, epilogue);
+    delete plain;
+
+    auto c = NDArrayFactory::create<float>('c', {16, 12});
+    MmulHelper::mmulFused(&a, &b, &c, epilogue);
+
+    ASSERT_TRUE(exp.equalsTo(c, 1e-2));
+
+    auto h = MmulHelper::mmulFused(&a, &b, nullptr, epilogue);
+    ASSERT_EQ(sd::DataType::HALF, h->dataType());
+    ASSERT_TRUE(exp.equalsTo(h->cast(sd::DataType::FLOAT32), 1e-2));
+    delete h;
+}
+
 //////////////////////////////////////////////////////////////////////
 TEST_F(HelpersTests1, softmaxDerivative_1) {
 
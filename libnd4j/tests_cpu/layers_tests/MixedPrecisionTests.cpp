@@ -0,0 +1,217 @@
+/*******************************************************************************
+ * Copyright (c) 2020 Konduit K.K.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#include "testlayers.h"
+#include <array/NDArray.h>
+#include <ops/declarable/CustomOperations.h>
+#include <helpers/MixedPrecision.h>
+#include <helpers/MmulHelper.h>
+
+using namespace sd;
+
+class MixedPrecisionTests : public testing::Test {
+public:
+
+};
+
+TEST_F(MixedPrecisionTests, test_mode_scope_1) {
+    auto initial = MixedPrecision::isFp32Accumulation();
+
+    {
+        MixedPrecisionScope outer(true);
+        ASSERT_TRUE(MixedPrecision::upcast(sd::DataType::HALF));
+        ASSERT_TRUE(MixedPrecision::upcast(sd::DataType::BFLOAT16));
+        ASSERT_FALSE(MixedPrecision::upcast(sd::DataType::FLOAT32));
+
+        {
+            MixedPrecisionScope inner(false);
+            ASSERT_FALSE(MixedPrecision::upcast(sd::DataType::HALF));
+        }
+
+        ASSERT_TRUE(MixedPrecision::isFp32Accumulation());
+    }
+
+    ASSERT_EQ(initial, MixedPrecision::isFp32Accumulation());
+}
+
+TEST_F(MixedPrecisionTests, test_reduce_sum_1) {
+    // 16 bit accumulator can't go beyond 2048 when adding ones
+    auto x = NDArrayFactory::create<float16>('c', {8192});
+    x.assign(1.f);
+
+    MixedPrecisionScope scope(true);
+
+    sd::ops::reduce_sum op;
+    auto result = op.evaluate({&x}, {}, {});
+    ASSERT_EQ(Status::OK(), result.status());
+    ASSERT_NEAR(8192.f, result.at(0)->e<float>(0), 1e-5f);
+
+    auto z = x.reduceAlongDimension(reduce::ASum, {});
+    ASSERT_NEAR(8192.f, z.e<float>(0), 1e-5f);
+}
+
+TEST_F(MixedPrecisionTests, test_reduce_sum_2) {
+    auto x = NDArrayFactory::create<bfloat16>('c', {4, 4096});
+    x.assign(1.f);
+
+    Context ctx(1);
+    ctx.setInputArray(0, &x);
+    ctx.setIArguments({1});
+    ctx.setFp32Accumulation(true);
+
+    auto z = NDArrayFactory::create<bfloat16>('c', {4});
+    ctx.setOutputArray(0, &z);
+
+    sd::ops::reduce_sum op;
+    ASSERT_EQ(Status::OK(), op.execute(&ctx));
+
+    for (int e = 0; e < 4; e++)
+        ASSERT_NEAR(4096.f, z.e<float>(e), 1e-5f);
+}
+
+TEST_F(MixedPrecisionTests, test_reduce_mean_1) {
+    auto x = NDArrayFactory::create<float16>('c', {3, 50000});
+    x.assign(0.1f);
+
+    MixedPrecisionScope scope(true);
+
+    auto z = x.reduceAlongDimension(reduce::Mean, {1});
+    for (int e = 0; e < 3; e++)
+        ASSERT_NEAR(0.1f, z.e<float>(e), 1e-3f);
+
+    auto s = x.reduceNumber(reduce::Mean);
+    ASSERT_NEAR(0.1f, s.e<float>(0), 1e-3f);
+}
+
+TEST_F(MixedPrecisionTests, test_mmul_1) {
+    auto x = NDArrayFactory::create<float16>('c', {2, 8192});
+    auto y = NDArrayFactory::create<float16>('c', {8192, 3});
+    x.assign(0.5f);
+    y.assign(1.f);
+
+    MixedPrecisionScope scope(true);
+
+    auto z = MmulHelper::mmul(&x, &y);
+    for (int e = 0; e < z->lengthOf(); e++)
+        ASSERT_NEAR(4096.f, z->e<float>(e), 1e-5f);
+
+    delete z;
+}
+
+TEST_F(MixedPrecisionTests, test_softmax_1) {
+    auto x = NDArrayFactory::create<float16>('c', {2, 8192});
+    x.assign(0.25f);
+
+    MixedPrecisionScope scope(true);
+
+    sd::ops::softmax op;
+    auto result = op.evaluate({&x}, {}, {1});
+    ASSERT_EQ(Status::OK(), result.status());
+
+    auto sum = result.at(0)->reduceAlongDimension(reduce::Sum, {1});
+    for (int e = 0; e < 2; e++)
+        ASSERT_NEAR(1.f, sum.e<float>(e), 1e-3f);
+}
+
+TEST_F(MixedPrecisionTests, test_reduce_norm_p_1) {
+    // sum of squares saturates at 2048 with 16 bit accumulator
+    auto x = NDArrayFactory::create<float16>('c', {8192});
+    x.assign(1.f);
+
+    float16 p = 2.f;
+
+    MixedPrecisionScope scope(true);
+
+    auto z = x.reduceNumber(reduce::NormP, &p);
+    ASSERT_NEAR(90.50967f, z.e<float>(0), 0.07f);
+}
+
+TEST_F(MixedPrecisionTests, test_transform_1) {
+    auto x = NDArrayFactory::create<float16>('c', {4, 300});
+    x.linspace(-3.f, 0.02f);
+
+    auto xf = x.cast(sd::DataType::FLOAT32);
+    auto zf = xf.ulike();
+    xf.applyTransform(transform::SigmoidDerivative, zf);
+    auto sf = xf.ulike();
+    xf.applyTransform(transform::Sqrt, sf);
+
+    MixedPrecisionScope scope(true);
+
+    // op is evaluated in float32 and result is rounded once, so it must match float32 result rounded to half
+    auto z = x.ulike();
+    x.applyTransform(transform::SigmoidDerivative, z);
+    auto s = x.ulike();
+    x.applyTransform(transform::Sqrt, s);
+
+    for (int e = 0; e < x.lengthOf(); e++) {
+        ASSERT_EQ(static_cast<float>(static_cast<float16>(zf.e<float>(e))), z.e<float>(e));
+
+        if (x.e<float>(e) >= 0.f)
+            ASSERT_EQ(static_cast<float>(static_cast<float16>(sf.e<float>(e))), s.e<float>(e));
+    }
+}
+
+TEST_F(MixedPrecisionTests, test_transform_2) {
+    auto x = NDArrayFactory::create<bfloat16>('c', {6, 40});
+    x.linspace(0.01f, 0.05f);
+
+    // strided input and output, so values are converted in place rather than in c ordered buffer
+    auto xv = x({0,0,0, 0,40,2}, true, true);
+    auto out = NDArrayFactory::create<bfloat16>('f', {6, 40});
+    auto zv = out({0,0,0, 0,40,2}, true, true);
+
+    auto xf = xv.cast(sd::DataType::FLOAT32);
+    auto zf = xf.ulike();
+    xf.applyTransform(transform::Tanh, zf);
+
+    MixedPrecisionScope scope(true);
+    xv.applyTransform(transform::Tanh, zv);
+
+    for (int e = 0; e < xv.lengthOf(); e++)
+        ASSERT_EQ(static_cast<float>(static_cast<bfloat16>(zf.e<float>(e))), zv.e<float>(e));
+}
+
+TEST_F(MixedPrecisionTests, test_batchnorm_1) {
+    NDArray input   ('c', {2,4}, sd::DataType::HALF);
+    NDArray mean    ('c', {4}, {1.05f, 1.15f, 1.2f, 1.3f}, sd::DataType::HALF);
+    NDArray variance('c', {4}, {0.5f, 0.7f, 0.9f,  1.1f},  sd::DataType::HALF);
+    NDArray gamma   ('c', {4}, {-1.2f, 1.3f, -1.4f, 1.5f}, sd::DataType::HALF);
+    NDArray beta    ('c', {4}, {10.f, 20.f, -10.f, -20.f}, sd::DataType::HALF);
+
+    input.linspace(0.1, 0.1);
+
+    // float32 result for the same (already rounded to half) inputs
+    auto inputF    = input.cast(sd::DataType::FLOAT32);
+    auto meanF     = mean.cast(sd::DataType::FLOAT32);
+    auto varianceF = variance.cast(sd::DataType::FLOAT32);
+    auto gammaF    = gamma.cast(sd::DataType::FLOAT32);
+    auto betaF     = beta.cast(sd::DataType::FLOAT32);
+
+    sd::ops::batchnorm op;
+    auto expected = op.evaluate({&inputF, &meanF, &varianceF, &gammaF, &betaF}, {1e-5}, {1,1});
+    ASSERT_EQ(Status::OK(), expected.status());
+
+    MixedPrecisionScope scope(true);
+
+    auto result = op.evaluate({&input, &mean, &variance, &gamma, &beta}, {1e-5}, {1,1});
+    ASSERT_EQ(Status::OK(), result.status());
+
+    // within one half ulp of float32 result, values are in [16, 32) range at most
+    auto z = result.at(0);
+    for (int e = 0; e < z->lengthOf(); e++)
+        ASSERT_NEAR(expected.at(0)->e<float>(e), z->e<float>(e), 0.016f);
+}
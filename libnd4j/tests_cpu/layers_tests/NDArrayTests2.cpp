@@ -905,6 +905,50 @@ TEST_F(NDArrayTest2, debugInfoTest_2) {
     ASSERT_EQ(exp, info);
 }
 
+TEST_F(NDArrayTest2, debugInfoTest_3) {
+    auto x = NDArrayFactory::create<float>('c', {5}, {1.f, std::numeric_limits<float>::quiet_NaN(), std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity(), 0.f});
+    auto y = NDArrayFactory::create<float16>('c', {2, 2}, {1.f, 2.f, 3.f, 4.f});
+    auto z = NDArrayFactory::create<float>('c', {100000});
+    z.linspace(1.0);
+
+    // this view has no ews, so it's inspected through offsets
+    auto w = NDArrayFactory::create<int>('c', {3, 3}, {-1, 2, -3, 4, -5, 6, -7, 8, -9});
+    auto wv = w({0,2, 0,2});
+
+    DebugInfo info[4];
+    DebugHelper::retrieveDebugStatistics(info, {&x, &y, &z, &wv});
+
+    ASSERT_EQ(1, info[0]._nanCount);
+    ASSERT_EQ(2, info[0]._infCount);
+    ASSERT_EQ(1, info[0]._zeroCount);
+    ASSERT_EQ(2, info[0]._positiveCount);
+    ASSERT_EQ(1, info[0]._negativeCount);
+
+    ASSERT_NEAR(1.0, info[1]._minValue, 1e-6);
+    ASSERT_NEAR(4.0, info[1]._maxValue, 1e-6);
+    ASSERT_NEAR(2.5, info[1]._meanValue, 1e-6);
+    ASSERT_NEAR(1.118034, info[1]._stdDevValue, 1e-6);
+
+    ASSERT_NEAR(1.0, info[2]._minValue, 1e-6);
+    ASSERT_NEAR(100000.0, info[2]._maxValue, 1e-6);
+    ASSERT_NEAR(50000.5, info[2]._meanValue, 1e-6);
+    ASSERT_NEAR(28867.513458, info[2]._stdDevValue, 1e-4);
+    ASSERT_EQ(100000, info[2]._positiveCount);
+
+    ASSERT_EQ(DebugHelper::debugStatistics(&wv), info[3]);
+    ASSERT_NEAR(0.0, info[3]._meanValue, 1e-6);
+    ASSERT_NEAR(-5.0, info[3]._minValue, 1e-6);
+    ASSERT_EQ(2, info[3]._negativeCount);
+
+    // every 100th element only
+    DebugInfo sampled;
+    DebugHelper::retrieveDebugStatistics(&sampled, &z, 1000);
+    ASSERT_EQ(1000, sampled._positiveCount);
+    ASSERT_NEAR(1.0, sampled._minValue, 1e-6);
+    ASSERT_NEAR(99901.0, sampled._maxValue, 1e-6);
+    ASSERT_NEAR(49951.0, sampled._meanValue, 1e-6);
+}
+
 //////////////////////////////////////////////////////////////////////
 TEST_F(NDArrayTest2, test_subarray_ews_1) {
 
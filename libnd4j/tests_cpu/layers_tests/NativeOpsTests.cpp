@@ -33,6 +33,9 @@
 #include <helpers/ConstantTadHelper.h>
 #include <loops/type_conversions.h>
 #include <ops/declarable/CustomOperations.h>
+#include <helpers/SamplingProfiler.h>
+#include <helpers/StreamingAccumulator.h>
+#include <thread>
 using namespace sd;
 using namespace sd::ops;
 
@@ -1204,6 +1207,169 @@ TEST_F(NativeOpsTests, AccumulateTest_1) {
     ASSERT_TRUE(z.equalsTo(exp));
 }
 
+TEST_F(NativeOpsTests, AccumulateTest_2) {
+#ifdef __CUDABLAS__
+    return;
+#endif
+    // 2048 + 1 is 2048 in HALF, so this only holds with FLOAT32 accumulation
+    auto x = NDArrayFactory::create<float16>('c', {5000});
+    auto z = NDArrayFactory::create<float16>('c', {5000});
+    auto exp = NDArrayFactory::create<float16>('c', {5000});
+    x.assign(1.f);
+    z.assign(2048.f);
+    exp.assign(2064.f);
+
+    std::vector<Nd4jPointer> xList(16, x.buffer());
+    std::vector<Nd4jPointer> dxList(16, x.specialBuffer());
+    ::accumulate(nullptr,
+                     xList.data(), x.shapeInfo(),
+                     dxList.data(), x.specialShapeInfo(),
+                     z.buffer(), z.shapeInfo(),
+                     z.specialBuffer(), z.specialShapeInfo(),
+                     16,
+                     x.lengthOf());
+
+    ASSERT_EQ(exp, z);
+}
+
+TEST_F(NativeOpsTests, AverageTest_2) {
+#ifdef __CUDABLAS__
+    return;
+#endif
+    auto x0 = NDArrayFactory::create<float>('c', {5000});
+    auto x1 = NDArrayFactory::create<float>('c', {5000});
+    auto x2 = NDArrayFactory::create<float>('c', {5000});
+    auto z = NDArrayFactory::create<float>('c', {5000});
+    auto exp = NDArrayFactory::create<float>('c', {5000});
+    x0.assign(1.f);
+    x1.assign(2.f);
+    x2.assign(6.f);
+    exp.assign(3.f);
+
+    Nd4jPointer xList[] = {x0.buffer(), x1.buffer(), x2.buffer()};
+    Nd4jPointer dxList[] = {x0.specialBuffer(), x1.specialBuffer(), x2.specialBuffer()};
+    ::average(nullptr,
+                  xList, x0.shapeInfo(),
+                  dxList, x0.specialShapeInfo(),
+                  z.buffer(), z.shapeInfo(),
+                  z.specialBuffer(), z.specialShapeInfo(),
+                  3,
+                  x0.lengthOf(),
+                  true);
+
+    ASSERT_EQ(exp, z);
+    ASSERT_EQ(exp, x0);
+    ASSERT_EQ(exp, x2);
+}
+
+TEST_F(NativeOpsTests, StreamingAccumulator_1) {
+    auto x = NDArrayFactory::create<bfloat16>('c', {3, 10000});
+    auto sum = NDArrayFactory::create<bfloat16>('c', {3, 10000});
+    auto avg = NDArrayFactory::create<bfloat16>('c', {3, 10000});
+    auto expSum = NDArrayFactory::create<bfloat16>('c', {3, 10000});
+    auto expAvg = NDArrayFactory::create<bfloat16>('c', {3, 10000});
+    x.assign(1.f);
+    expSum.assign(1000.f);
+    expAvg.assign(1.f);
+
+    StreamingAccumulator accumulator(sd::DataType::BFLOAT16, x.lengthOf());
+
+    std::vector<std::thread> producers;
+    for (int t = 0; t < 4; t++)
+        producers.emplace_back([&] {
+            for (int e = 0; e < 250; e++)
+                accumulator.add(x);
+        });
+
+    for (auto &p : producers)
+        p.join();
+
+    accumulator.sum(sum);
+    accumulator.average(avg);
+
+    ASSERT_EQ(1000, accumulator.count());
+    ASSERT_EQ(expSum, sum);
+    ASSERT_EQ(expAvg, avg);
+
+    accumulator.reset();
+    accumulator.sum(sum);
+
+    ASSERT_EQ(0, accumulator.count());
+    ASSERT_NEAR(0.f, sum.reduceNumber(reduce::AMax).e<float>(0), 1e-5f);
+}
+
+TEST_F(NativeOpsTests, StreamingAccumulator_2) {
+    auto x = NDArrayFactory::create<float>('c', {4, 3}, {1.f, 2.f, 3.f, 4.f, 5.f, 6.f, 7.f, 8.f, 9.f, 10.f, 11.f, 12.f});
+    auto y = x.dup('f');
+    auto z = NDArrayFactory::create<float>('f', {4, 3});
+
+    // both inputs and output are matched by logical index, not by buffer offset
+    StreamingAccumulator accumulator(sd::DataType::FLOAT32, x.lengthOf());
+    accumulator.add(x);
+    accumulator.add(y);
+    accumulator.average(z);
+
+    ASSERT_EQ(x, z);
+
+    ASSERT_ANY_THROW(StreamingAccumulator(sd::DataType::INT32, 12));
+    ASSERT_ANY_THROW(accumulator.add(NDArrayFactory::create<double>('c', {4, 3})));
+}
+
+TEST_F(NativeOpsTests, StreamingAccumulator_3) {
+    auto x = NDArrayFactory::create<double>('c', {2, 3}, {1., 2., 3., 4., 5., 6.});
+    auto y = NDArrayFactory::create<double>('c', {2, 3}, {3., 4., 5., 6., 7., 8.});
+    auto z = NDArrayFactory::create<double>('c', {2, 3});
+    auto expSum = NDArrayFactory::create<double>('c', {2, 3}, {4., 6., 8., 10., 12., 14.});
+    auto expAvg = NDArrayFactory::create<double>('c', {2, 3}, {2., 3., 4., 5., 6., 7.});
+
+    auto accumulator = ::createStreamingAccumulator(sd::DataType::DOUBLE, x.lengthOf());
+    ASSERT_TRUE(accumulator != nullptr);
+
+    ::streamingAccumulatorAdd(accumulator, x.buffer(), x.shapeInfo());
+    ::streamingAccumulatorAdd(accumulator, y.buffer(), y.shapeInfo());
+    ASSERT_EQ(2, ::streamingAccumulatorCount(accumulator));
+
+    ::streamingAccumulatorStore(accumulator, z.buffer(), z.shapeInfo(), false);
+    ASSERT_EQ(expSum, z);
+
+    ::streamingAccumulatorStore(accumulator, z.buffer(), z.shapeInfo(), true);
+    ASSERT_EQ(expAvg, z);
+
+    ::streamingAccumulatorReset(accumulator);
+    ASSERT_EQ(0, ::streamingAccumulatorCount(accumulator));
+
+    ::deleteStreamingAccumulator(accumulator);
+}
+
+TEST_F(NativeOpsTests, StreamingAccumulator_4) {
+    auto x = NDArrayFactory::create<float>('c', {3, StreamingAccumulator::TILE});
+    auto avg = NDArrayFactory::create<float>('c', {3, StreamingAccumulator::TILE});
+    x.assign(1.f);
+
+    StreamingAccumulator accumulator(sd::DataType::FLOAT32, x.lengthOf());
+    accumulator.add(x);
+
+    // average taken while producers are running is still exact per tile
+    std::vector<std::thread> producers;
+    for (int t = 0; t < 2; t++)
+        producers.emplace_back([&] {
+            for (int e = 0; e < 100; e++)
+                accumulator.add(x);
+        });
+
+    bool exact = true;
+    for (int e = 0; e < 20; e++) {
+        accumulator.average(avg);
+        exact &= x.equalsTo(avg);
+    }
+
+    for (auto &p : producers)
+        p.join();
+
+    ASSERT_TRUE(exact);
+    ASSERT_EQ(201, accumulator.count());
+}
+
 TEST_F(NativeOpsTests, P2PTest_1) {
     ::enableP2P(true);
     ::checkP2P();
@@ -1602,6 +1768,91 @@ TEST_F(NativeOpsTests, interop_databuffer_tests_1) {
     ::deleteDataBuffer(idb);
 }
 
+TEST_F(NativeOpsTests, SamplingProfiler_1) {
+    ASSERT_TRUE(SamplingProfiler::currentMarker() == nullptr);
+
+    {
+        ScopedOpMarker outer("outer_op", 1L, 7, -1);
+        ASSERT_EQ(7, SamplingProfiler::currentMarker()->nodeId);
+
+        {
+            ScopedOpMarker inner("execTransformSame", 0L, -1, 3);
+            ASSERT_EQ(3, SamplingProfiler::currentMarker()->opNum);
+            ASSERT_EQ(7, SamplingProfiler::currentMarker()->parent->nodeId);
+        }
+
+        ASSERT_EQ(7, SamplingProfiler::currentMarker()->nodeId);
+    }
+
+    ASSERT_TRUE(SamplingProfiler::currentMarker() == nullptr);
+}
+
+// returns count of given stack in folded output, or 0 if it's absent
+static Nd4jLong foldedCount(const std::string& folded, const std::string& stack) {
+    auto pos = folded.find(stack + " ");
+    if (pos == std::string::npos)
+        return 0L;
+
+    return std::stoll(folded.substr(pos + stack.length() + 1));
+}
+
+TEST_F(NativeOpsTests, SamplingProfiler_2) {
+    // timer is set slow, and samples are taken explicitly. timer might still add some, so counts are lower bounds
+    if (!::startSamplingProfiler(1))
+        return;
+
+    ::resetSamplingProfiler();
+
+    auto &profiler = SamplingProfiler::getInstance();
+    {
+        ScopedOpMarker outer("outer_op", 1L, 7, -1);
+        ScopedOpMarker inner("execTransformSame", 0L, -1, 3);
+
+        for (int e = 0; e < 5; e++)
+            profiler.sample();
+    }
+
+    ::stopSamplingProfiler();
+
+    // stopped profiler ignores samples
+    profiler.sample();
+
+    auto folded = ::dumpSamplingProfile();
+    std::string result(folded);
+    ::deleteCharArray((Nd4jPointer) folded);
+
+    ASSERT_LE(5, foldedCount(result, "outer_op [node 7];execTransformSame [op 3]"));
+    ASSERT_LE(5, profiler.totalSamples());
+
+    ::resetSamplingProfiler();
+    ASSERT_EQ(0, profiler.totalSamples());
+}
+
+TEST_F(NativeOpsTests, SamplingProfiler_3) {
+    if (!::startSamplingProfiler(1))
+        return;
+
+    ::resetSamplingProfiler();
+
+    auto &profiler = SamplingProfiler::getInstance();
+
+    // buffer of the thread is released when it exits, but its samples are kept
+    std::thread worker([&profiler] () {
+        ScopedOpMarker marker("worker_op", 1L, -1, 5);
+
+        for (int e = 0; e < 3; e++)
+            profiler.sample();
+    });
+    worker.join();
+
+    ::stopSamplingProfiler();
+
+    ASSERT_LE(3, foldedCount(profiler.foldedStacks(), "worker_op [op 5]"));
+
+    ::resetSamplingProfiler();
+    ASSERT_EQ(0, profiler.totalSamples());
+}
+
 //Uncomment when needed only - massive calculations
 //TEST_F(NativeOpsTests, BenchmarkTests_1) {
 //
@@ -472,3 +472,72 @@ TEST_F(NlpTests, test_cbow_hs_batch_1) {
     ASSERT_EQ(exp2, row_s1_6);
    
 }
+
+TEST_F(NlpTests, beam_search_step_1) {
+    // logits are shifted log probabilities, so log-softmax has to restore them
+    auto logits = NDArrayFactory::create<float>('c', {1, 2, 3}, {0.5f, 0.3f, 0.2f, 0.1f, 0.6f, 0.3f});
+    logits.applyTransform(transform::Log, logits);
+    logits += 3.f;
+
+    auto scores   = NDArrayFactory::create<float>('c', {1, 2}, {-1.f, -0.5f});
+    auto finished = NDArrayFactory::create<bool>('c', {1, 2}, {false, true});
+    auto lengths  = NDArrayFactory::create<int>('c', {1, 2}, {2, 3});
+
+    auto expScores   = NDArrayFactory::create<float>('c', {1, 2}, {-0.5f, -1.f + std::log(0.5f)});
+    auto expTokens   = NDArrayFactory::create<int>('c', {1, 2}, {2, 0});
+    auto expParents  = NDArrayFactory::create<int>('c', {1, 2}, {1, 0});
+    auto expFinished = NDArrayFactory::create<bool>('c', {1, 2}, {true, false});
+    auto expLengths  = NDArrayFactory::create<int>('c', {1, 2}, {3, 3});
+
+    sd::ops::beam_search_step op;
+    auto result = op.evaluate({&logits, &scores, &finished, &lengths}, {}, {2});
+    ASSERT_EQ(Status::OK(), result.status());
+
+    ASSERT_TRUE(expScores.equalsTo(result.at(0), 1e-5));
+    ASSERT_EQ(expTokens, *result.at(1));
+    ASSERT_EQ(expParents, *result.at(2));
+    ASSERT_EQ(expFinished, *result.at(3));
+    ASSERT_EQ(expLengths, *result.at(4));
+}
+
+TEST_F(NlpTests, beam_search_step_2) {
+    // second batch item has every live token masked out, so only finished beam survives with its score
+    auto logits = NDArrayFactory::create<float>('c', {2, 2, 3}, {0.5f, 0.3f, 0.2f, 0.1f, 0.6f, 0.3f, 0.f, 0.f, 0.f, 0.2f, 0.2f, 0.6f});
+    logits.applyTransform(transform::Log, logits);
+
+    auto scores   = NDArrayFactory::create<float>('c', {2, 2}, {-1.f, -1.5f, -1.f, -2.f});
+    auto finished = NDArrayFactory::create<bool>('c', {2, 2}, {false, true, false, true});
+    auto lengths  = NDArrayFactory::create<int>('c', {2, 2}, {1, 1, 4, 4});
+
+    sd::ops::beam_search_step op;
+
+    // without length penalty finished beam wins: -1.5 > -1 + log(0.5)
+    auto result = op.evaluate({&logits, &scores, &finished, &lengths}, {0.}, {2});
+    ASSERT_EQ(Status::OK(), result.status());
+    ASSERT_EQ(NDArrayFactory::create<int>('c', {2, 2}, {1, 0, 1, 0}), *result.at(2));
+    ASSERT_EQ(NDArrayFactory::create<int>('c', {2, 2}, {2, 0, 2, 0}), *result.at(1));
+    ASSERT_EQ(-DataTypeUtils::infOrMax<float>(), result.at(0)->e<float>(1, 1));
+
+    // live beam is one token longer, so it's penalized less: (-1 + log(0.5)) / (7/6) > -1.5
+    result = op.evaluate({&logits, &scores, &finished, &lengths}, {1.}, {2});
+    ASSERT_EQ(Status::OK(), result.status());
+    ASSERT_EQ(NDArrayFactory::create<int>('c', {2, 2}, {0, 1, 1, 0}), *result.at(2));
+    ASSERT_EQ(NDArrayFactory::create<int>('c', {2, 2}, {0, 2, 2, 0}), *result.at(1));
+    ASSERT_EQ(NDArrayFactory::create<int>('c', {2, 2}, {2, 1, 4, 5}), *result.at(4));
+    ASSERT_NEAR(-1.f + std::log(0.5f), result.at(0)->e<float>(0, 0), 1e-5);
+}
+
+TEST_F(NlpTests, beam_search_backtrace_1) {
+    auto tokens  = NDArrayFactory::create<int>('c', {3, 2, 2}, {4, 5, 4, 5,  6, 7, 6, 7,  8, 9, 8, 9});
+    auto parents = NDArrayFactory::create<int>('c', {3, 2, 2}, {0, 0, 0, 0,  1, 0, 1, 1,  1, 1, 0, 0});
+
+    auto exp = NDArrayFactory::create<int>('c', {2, 2, 3}, {4, 7, 8,  4, 7, 9,  5, 6, 8,  5, 6, 9});
+
+    sd::ops::beam_search_backtrace op;
+    auto result = op.evaluate({&tokens, &parents});
+    ASSERT_EQ(Status::OK(), result.status());
+    ASSERT_EQ(exp, *result.at(0));
+
+    parents.p(1, 0, 1, 2);
+    ASSERT_ANY_THROW(op.evaluate({&tokens, &parents}));
+}
@@ -44,6 +44,9 @@
 
 #include <ops/declarable/helpers/legacy_helpers.h>
 #include <execution/ThreadPool.h>
+#include <helpers/MixedPrecision.h>
+#include <graph/GraphExecutioner.h>
+#include <graph/StreamingSession.h>
 
 using namespace sd;
 using namespace sd::graph;
@@ -141,4 +144,160 @@ TEST_F(PerformanceTests, test_maxpooling2d_1) {
     nd4j_printf("Execution time: %lld; Min: %lld; Max: %lld;\n", valuesX[valuesX.size() / 2], valuesX[0], valuesX[valuesX.size() - 1]);
 }
 
-#endif
\ No newline at end of file
+TEST_F(PerformanceTests, test_fp32_accumulation_1) {
+    // accuracy and effective bandwidth of 16 bit reductions, with and without fp32 accumulation
+    auto x = NDArrayFactory::create<float16>('c', {64, 65536});
+    auto xd = NDArrayFactory::create<double>('c', {64, 65536});
+    xd.linspace(0.0, 1e-6);
+    x.assign(xd);
+
+    auto exp = xd.reduceAlongDimension(reduce::Sum, {1});
+
+    for (auto fp32: {false, true}) {
+        MixedPrecisionScope scope(fp32);
+
+        std::vector<Nd4jLong> values;
+        NDArray z;
+        for (int e = 0; e < numIterations; e++) {
+            auto timeStart = std::chrono::system_clock::now();
+
+            z = x.reduceAlongDimension(reduce::Sum, {1});
+
+            auto timeEnd = std::chrono::system_clock::now();
+            values.emplace_back(std::chrono::duration_cast<std::chrono::nanoseconds>(timeEnd - timeStart).count());
+        }
+
+        std::sort(values.begin(), values.end());
+
+        auto diff = exp - z.cast(sd::DataType::DOUBLE);
+        auto error = diff.reduceNumber(reduce::AMax).e<double>(0);
+        auto median = values[values.size() / 2];
+
+        nd4j_printf("FP32 accumulation: %s; Median time: %lld us; Bandwidth: %.2f GB/s; Max abs error: %f;\n", fp32 ? "ON" : "OFF", median / 1000, (double) x.lengthOf() * sizeof(float16) / median, error);
+    }
+}
+
+TEST_F(PerformanceTests, test_streaming_lstm_1) {
+    // per-chunk latency of streaming lstmLayer inference: resident states vs states copied in and out on every call
+    const int bS = 1, nIn = 80, nOut = 256;
+    std::vector<bool> bArgs = {true, false, true, true, false, true, true, true};
+
+    sd::ops::lstmLayer op;
+
+    auto buildGraph = [&](Graph &graph, int chunk) {
+        auto Wx = NDArrayFactory::create_<float>('c', {nIn, 4 * nOut});
+        auto Wr = NDArrayFactory::create_<float>('c', {nOut, 4 * nOut});
+        Wx->linspace(-0.01, 1e-5);
+        Wr->linspace(0.01, -1e-5);
+
+        graph.getVariableSpace()->putVariable(-1, NDArrayFactory::create_<float>('c', {chunk, bS, nIn}));
+        graph.getVariableSpace()->putVariable(-2, Wx);
+        graph.getVariableSpace()->putVariable(-3, Wr);
+        graph.getVariableSpace()->putVariable(-4, NDArrayFactory::create_<float>('c', {4 * nOut}));
+        graph.getVariableSpace()->putVariable(-5, NDArrayFactory::create_<float>('c', {bS, nOut}));
+        graph.getVariableSpace()->putVariable(-6, NDArrayFactory::create_<float>('c', {bS, nOut}));
+
+        auto node = new Node(&op, 1, {-1, -2, -3, -4, -5, -6}, {}, {}, 0.0f, {0.}, {0, 0, 2, 0, 0});
+        *node->getContextPrototype()->getBArguments() = bArgs;
+        graph.addNode(node);
+        graph.buildGraph();
+    };
+
+    for (int chunk : {1, 2, 4, 8, 16, 32}) {
+        auto x = NDArrayFactory::create<float>('c', {chunk, bS, nIn});
+        x.linspace(-1.0, 1e-3);
+
+        std::vector<Nd4jLong> streamed, copied;
+
+        {
+            Graph graph;
+            buildGraph(graph, chunk);
+
+            StreamingSession session(&graph);
+            session.bindState(-5, {1, 1});
+            session.bindState(-6, {1, 2});
+
+            for (int e = 0; e < numIterations + 10; e++) {
+                auto timeStart = std::chrono::system_clock::now();
+
+                session.execute({{-1, &x}});
+
+                auto timeEnd = std::chrono::system_clock::now();
+                if (e >= 10)
+                    streamed.emplace_back(std::chrono::duration_cast<std::chrono::nanoseconds>(timeEnd - timeStart).count());
+            }
+        }
+
+        {
+            Graph graph;
+            buildGraph(graph, chunk);
+            auto vs = graph.getVariableSpace();
+            vs->getVariable(-1)->getNDArray()->assign(x);
+
+            for (int e = 0; e < numIterations + 10; e++) {
+                auto timeStart = std::chrono::system_clock::now();
+
+                GraphExecutioner::execute(&graph);
+                vs->getVariable(-5)->getNDArray()->assign(vs->getVariable(1, 1)->getNDArray());
+                vs->getVariable(-6)->getNDArray()->assign(vs->getVariable(1, 2)->getNDArray());
+
+                auto timeEnd = std::chrono::system_clock::now();
+                if (e >= 10)
+                    copied.emplace_back(std::chrono::duration_cast<std::chrono::nanoseconds>(timeEnd - timeStart).count());
+            }
+        }
+
+        std::sort(streamed.begin(), streamed.end());
+        std::sort(copied.begin(), copied.end());
+
+        auto p50 = streamed[streamed.size() / 2];
+        auto p99 = streamed[streamed.size() * 99 / 100];
+
+        nd4j_printf("Chunk: %i; Streaming p50: %lld us; p99: %lld us; per step: %lld us; Copied states p50: %lld us;\n", chunk, p50 / 1000, p99 / 1000, p50 / 1000 / chunk, copied[copied.size() / 2] / 1000);
+    }
+}
+
+TEST_F(PerformanceTests, test_gemm_epilogue_1) {
+    // xw_plus_b + relu: one gemm followed by single fused epilogue pass vs gemm followed by separate bias and relu passes
+    for (auto shape : std::vector<std::array<Nd4jLong, 3>>{{64, 1024, 1024}, {1024, 1024, 1024}, {4096, 512, 512}, {4096, 1024, 4096}}) {
+        auto x = NDArrayFactory::create<float>('c', {shape[0], shape[1]});
+        auto w = NDArrayFactory::create<float>('c', {shape[1], shape[2]});
+        auto b = NDArrayFactory::create<float>('c', {shape[2]});
+        auto z = NDArrayFactory::create<float>('c', {shape[0], shape[2]});
+        x.linspace(-1.0, 1e-6);
+        w.linspace(1.0, -1e-6);
+        b.linspace(0.0, 0.01);
+
+        const int iterations = shape[0] * shape[1] * shape[2] > 1000000000L ? 10 : numIterations;
+        std::vector<Nd4jLong> fused, separate;
+
+        for (int e = 0; e < iterations + 1; e++) {
+            auto timeStart = std::chrono::system_clock::now();
+
+            MmulHelper::mmulFused(&x, &w, &z, GemmEpilogue(&b, GemmEpilogue::RELU, 0.1));
+
+            auto timeEnd = std::chrono::system_clock::now();
+            if (e > 0)
+                fused.emplace_back(std::chrono::duration_cast<std::chrono::nanoseconds>(timeEnd - timeStart).count());
+        }
+
+        for (int e = 0; e < iterations + 1; e++) {
+            auto timeStart = std::chrono::system_clock::now();
+
+            MmulHelper::mmul(&x, &w, &z);
+            z.addiRowVector(b);
+            z.applyScalar(scalar::RELU, 0.1, z);
+
+            auto timeEnd = std::chrono::system_clock::now();
+            if (e > 0)
+                separate.emplace_back(std::chrono::duration_cast<std::chrono::nanoseconds>(timeEnd - timeStart).count());
+        }
+
+        std::sort(fused.begin(), fused.end());
+        std::sort(separate.begin(), separate.end());
+
+        nd4j_printf("M: %lld; K: %lld; N: %lld; Fused: %lld us; Separate passes: %lld us;\n", shape[0], shape[1], shape[2], fused[fused.size() / 2] / 1000, separate[separate.size() / 2] / 1000);
+    }
+}
+
+#endif
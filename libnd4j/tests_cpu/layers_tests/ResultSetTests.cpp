@@ -22,6 +22,7 @@
 #include <graph/Graph.h>
 #include <graph/Node.h>
 #include <ops/declarable/CustomOperations.h>
+#include <array/TadView.h>
 
 using namespace sd;
 using namespace sd::graph;
@@ -46,4 +47,44 @@ TEST_F(ResultSetTests, basic_test_1) {
 
     for (int e = 0; e < tensors.size(); e++)
         ASSERT_EQ(5, tensors.at(e)->lengthOf());
-}
\ No newline at end of file
+}
+TEST_F(ResultSetTests, tad_view_1) {
+    auto x = NDArrayFactory::create<float>('c', {3, 4, 5});
+    x.linspace(1);
+
+    // TadView must address the same elements as materialized TADs, including strided ones
+    for (auto dims : std::vector<std::vector<int>>({{2}, {1}, {0}, {1, 2}, {0, 2}})) {
+        auto tensors = x.allTensorsAlongDimension(dims);
+        TadView<const float> view(x, dims);
+
+        ASSERT_EQ(tensors.size(), view.size());
+
+        for (int t = 0; t < tensors.size(); t++) {
+            ASSERT_EQ(tensors.at(t)->lengthOf(), view.tadLength());
+
+            for (Nd4jLong e = 0; e < view.tadLength(); e++)
+                ASSERT_EQ(tensors.at(t)->e<float>(e), view(t, e));
+
+            ASSERT_EQ(*tensors.at(t), view.array(t));
+        }
+    }
+}
+
+TEST_F(ResultSetTests, tad_view_2) {
+    auto x = NDArrayFactory::create<float>('c', {2, 3, 4});
+    auto exp = NDArrayFactory::create<float>('c', {2, 3, 4});
+    exp.linspace(1);
+
+    TadView<float> view(x, {1, 2});
+
+    auto func = PRAGMA_THREADS_FOR {
+        for (auto t = start; t < stop; t++)
+            for (Nd4jLong i = 0; i < 3; i++)
+                for (Nd4jLong j = 0; j < 4; j++)
+                    view(t, i, j) = static_cast<float>(t * 12 + i * 4 + j + 1);
+    };
+
+    samediff::Threads::parallel_tad(func, 0, view.size());
+
+    ASSERT_EQ(exp, x);
+}
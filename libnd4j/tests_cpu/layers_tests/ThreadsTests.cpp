@@ -230,6 +230,38 @@ TEST_F(ThreadsTests, crash_test_1) {
   }
 }
 
+TEST_F(ThreadsTests, parallel_tasks_1) {
+    const int total = Environment::getInstance().maxMasterThreads();
+    std::atomic<int> shares{0};
+    std::atomic<int> calls{0};
+
+    auto task = [&] {
+        shares += Environment::getInstance().maxMasterThreads();
+        calls++;
+    };
+
+    samediff::Threads::parallel_tasks({task, task});
+
+    ASSERT_EQ(2, calls.load());
+
+    // master threads are split between tasks, and caller keeps its own limit
+    if (Environment::getInstance().isCPU() && total >= 2)
+        ASSERT_EQ(total, shares.load());
+
+    ASSERT_EQ(total, Environment::getInstance().maxMasterThreads());
+}
+
+TEST_F(ThreadsTests, parallel_tasks_2) {
+    std::atomic<int> calls{0};
+
+    ASSERT_ANY_THROW(samediff::Threads::parallel_tasks({
+        [&] { calls++; },
+        [&] { throw std::runtime_error("task failed"); }
+    }));
+
+    ASSERT_EQ(1, calls.load());
+}
+
 /*
 TEST_F(ThreadsTests, basic_test_1) {
     if (!Environment::getInstance().isCPU())